@@ -17,27 +17,59 @@ $ErrorActionPreference = "Stop"
 $commonSources = @(
     "src/main.cpp",
     "src/core/Engine.cpp",
+    "src/core/FileWatcher.cpp",
     "src/core/FPSCamera.cpp",
     "src/core/SceneSerializer.cpp",
+    "src/core/SaveGame.cpp",
     "src/renderer/Renderer.cpp",
+    "src/renderer/ShaderLibrary.cpp",
     "src/renderer/Camera.cpp",
     "src/renderer/Material.cpp",
     "src/renderer/MaterialComponent.cpp",
+    "src/renderer/MeshRenderer.cpp",
+    "src/renderer/MeshletCulling.cpp",
+    "src/renderer/OcclusionCulling.cpp",
+    "src/renderer/Impostor.cpp",
+    "src/renderer/DynamicResolution.cpp",
+    "src/renderer/PostProcessing.cpp",
     "src/physics/Physics.cpp",
+    "src/physics/ForceField.cpp",
     "src/assets/Assets.cpp",
+    "src/assets/TextureCooker.cpp",
+    "src/assets/MappedFile.cpp",
+    "src/assets/TextureStreaming.cpp",
+    "src/assets/GLTFLoader.cpp",
+    "src/assets/FBXLoader.cpp",
+    "src/assets/Meshlet.cpp",
+    "src/assets/MeshRegistry.cpp",
+    "src/geometry/Primitives.cpp",
+    "src/geometry/MeshBuilder.cpp",
+    "src/shapes/ShapeLibrary.cpp",
     "src/ai/AIManager.cpp",
+    "src/ai/BehaviorTree.cpp",
     "src/ai/ImageTo3DManager.cpp",
     "src/scripting/ScriptEngine.cpp",
+    "src/scripting/VMHeap.cpp",
+    "src/scripting/VMCompiler.cpp",
+    "src/scripting/ScriptVM.cpp",
+    "src/scripting/ScriptScheduler.cpp",
+    "src/scripting/ScriptProfiler.cpp",
+    "src/scripting/ScriptDebugger.cpp",
     "src/scripting/NodeGraph.cpp",
     "src/scripting/NativeScript.cpp",
     "src/editor/CLIEditor.cpp",
+    "src/editor/BatchRunner.cpp",
+    "src/editor2d/DialogueBank.cpp",
     "src/editor/OrbitCamera.cpp",
     "src/terrain/Terrain.cpp",
     "src/effects/ParticleSystem.cpp",
     "src/animation/Animation.cpp",
+    "src/animation/AnimStateMachine.cpp",
     "src/animation/SkeletalAnimation.cpp",
     "src/future/Placeholders.cpp",
-    "src/scripting/physics/ForceController.cpp"
+    "src/scripting/physics/ForceController.cpp",
+    "src/scripting/physics/BehaviorAnalyzer.cpp",
+    "src/vehicle/RaycastVehicle.cpp"
 )
 
 if ($CliOnly) {
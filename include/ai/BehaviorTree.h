@@ -0,0 +1,443 @@
+// ============================================================================
+// GameVoid Engine — Behavior Trees & Utility AI
+// ============================================================================
+// A behavior tree decides what an agent does next.  Trees are authored in
+// code (BehaviorTreeDesc) or JSON, compiled once into an immutable array of
+// nodes, and shared by every agent that runs them.  An agent (BTAgent)
+// keeps only a blackboard and a few words of state per node.
+//
+//   {
+//     "name": "guard",
+//     "blackboard": { "health": { "type": "float", "default": 100 },
+//                     "target": "object", "alert": "bool" },
+//     "root": { "type": "selector", "children": [
+//       { "type": "check", "key": "health", "op": "<", "value": 30, "abort": "lower",
+//         "child": { "type": "action", "name": "flee" } },
+//       { "type": "utility", "children": [
+//         { "type": "action", "name": "attack",
+//           "utility": [ { "key": "alert", "curve": "linear" } ] },
+//         { "type": "action", "name": "patrol", "weight": 0.3 } ] } ] }
+//   }
+//
+// Nodes:
+//   composites   sequence, selector, parallel (success / failure counts),
+//                utility (runs the best-scoring child; see below)
+//   decorators   inverter, force_success, force_failure, repeat, retry,
+//                cooldown, time_limit, check (with a child)
+//   leaves       action, condition (native), script (GVScript function),
+//                check (blackboard test), wait, set (blackboard write)
+//
+// Ticking.  Each tick walks from the root down the running path; composites
+// resume the child that was running.  Repeat and retry run one iteration
+// per tick.  A finished root starts over on the next tick.
+//
+// Event-driven re-evaluation.  Blackboard writes that change a value mark
+// the key.  On the next tick:
+//   • a check with abort "self" (or "both") that guards a running child is
+//     re-tested, and aborts the child if it no longer holds;
+//   • a check with abort "lower" (or "both") that is a direct child of a
+//     selector is re-tested while a later child runs; if it now holds, the
+//     running child is aborted and the selector resumes at the check;
+//   • a running utility selector re-scores its children (every tick if any
+//     child uses a native scorer) and switches if another child beats the
+//     running one by more than its hysteresis.
+// Other checks are tested when reached, never re-tested while running.
+// An agent whose last tick ran no native or script leaf sleeps until one
+// of its keys changes or a timer (wait, cooldown, time_limit) falls due,
+// so idle agents cost nothing.  Native actions may sleep too (BTContext).
+//
+// Utility.  A child's score is weight × its native scorer (if any) × each
+// consideration: a blackboard value mapped to 0..1 by (value-min)/(max-min)
+// and then through a curve (linear, power, logistic, step), optionally
+// inverted.  Children scoring 0 are skipped; failures fall through to the
+// next best, as in a selector.
+//
+// Threads.  BTAgent::UpdateBatch splits agents across worker threads.
+// Native leaves registered as thread-safe run there; agents whose tree has
+// a script leaf or a main-thread native are ticked afterwards on the
+// calling thread.
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include "core/Math.h"
+#include "core/Component.h"
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace gv {
+
+class GameObject;
+class ScriptEngine;
+class BTAgent;
+
+enum class BTStatus : u8 { Success, Failure, Running };
+
+enum class BTNodeType : u8 {
+    Sequence, Selector, Parallel, Utility,
+    Inverter, ForceSuccess, ForceFailure, Repeat, Retry, Cooldown, TimeLimit,
+    Check, Action, Condition, Script, Wait, Set
+};
+
+enum class BTValueType : u8 { Bool, Int, Float, Object, Vector };
+
+/// Set / NotSet test non-zero (objects: id != 0; vectors: non-zero length).
+enum class BTCompare : u8 { Equal, NotEqual, Less, LessEqual, Greater, GreaterEqual, Set, NotSet };
+
+enum class BTAbort : u8 { None, Self, LowerPriority, Both };
+
+enum class BTCurve : u8 { Linear, Power, Logistic, Step };
+
+/// One blackboard slot.  Which member is meaningful depends on the key type.
+struct BTValue {
+    union {
+        bool b;
+        i32  i;
+        f32  f;
+        u32  id;                         // Object: a GameObject id, 0 = none
+    };
+    Vec3 v;                              // Vector
+
+    BTValue() : i(0) {}
+};
+
+// ============================================================================
+// Authoring
+// ============================================================================
+struct BTConsideration {
+    std::string key;
+    BTCurve curve = BTCurve::Linear;
+    f32  min = 0.0f, max = 1.0f;         // maps the value to 0..1
+    f32  exponent = 2.0f;                // Power
+    f32  steepness = 10.0f;              // Logistic
+    f32  midpoint = 0.5f;                // Logistic centre, Step threshold
+    bool invert = false;
+};
+
+struct BTArg {
+    std::string name;
+    f32         number = 0.0f;
+    std::string text;
+};
+
+struct BTNodeDesc {
+    BTNodeType  type = BTNodeType::Sequence;
+    std::string label;                   // shows in errors and tools
+    std::vector<BTNodeDesc> children;    // decorators: exactly one; check: zero or one
+
+    std::string name;                    // action / condition native, script function
+    std::vector<BTArg> args;             // read with BTContext::GetArg
+
+    f32 seconds = 0.0f;                  // wait, cooldown, time_limit
+    i32 count = 0;                       // repeat / retry (0 = forever); parallel: successes needed (0 = all)
+    i32 failures = 1;                    // parallel: failures that fail it
+    f32 hysteresis = 0.1f;               // utility: margin needed to switch
+
+    std::string key;                     // check, set
+    BTCompare   op = BTCompare::Set;
+    f32         value = 0.0f;            // compared / written (bool: non-zero)
+    BTAbort     abort = BTAbort::None;
+
+    std::vector<BTConsideration> utility;   // as a utility child
+    std::string scorer;                  // native scorer, as a utility child
+    f32         weight = 1.0f;
+
+    // ── Builders ───────────────────────────────────────────────────────────
+    static BTNodeDesc Composite(BTNodeType type, std::vector<BTNodeDesc> children);
+    static BTNodeDesc Sequence(std::vector<BTNodeDesc> children) { return Composite(BTNodeType::Sequence, std::move(children)); }
+    static BTNodeDesc Selector(std::vector<BTNodeDesc> children) { return Composite(BTNodeType::Selector, std::move(children)); }
+    static BTNodeDesc Parallel(std::vector<BTNodeDesc> children, i32 successes = 0, i32 failures = 1);
+    static BTNodeDesc Utility(std::vector<BTNodeDesc> children, f32 hysteresis = 0.1f);
+    static BTNodeDesc Decorate(BTNodeType type, BTNodeDesc child, f32 seconds = 0.0f, i32 count = 0);
+    static BTNodeDesc Check(const std::string& key, BTCompare op, f32 value = 0.0f, BTAbort abort = BTAbort::None);
+    static BTNodeDesc Guard(const std::string& key, BTCompare op, f32 value, BTAbort abort, BTNodeDesc child);
+    static BTNodeDesc Action(const std::string& name, std::vector<BTArg> args = {});
+    static BTNodeDesc Condition(const std::string& name);
+    static BTNodeDesc Script(const std::string& function);
+    static BTNodeDesc Wait(f32 seconds);
+    static BTNodeDesc Set(const std::string& key, f32 value);
+
+    /// Make this a utility child scored by `considerations` (and `weight`).
+    BTNodeDesc& Scored(std::vector<BTConsideration> considerations, f32 w = 1.0f) {
+        utility = std::move(considerations);
+        weight = w;
+        return *this;
+    }
+};
+
+struct BehaviorTreeDesc {
+    struct Key {
+        std::string name;
+        BTValueType type = BTValueType::Float;
+        BTValue     defaultValue;
+    };
+
+    std::string name = "tree";
+    std::vector<Key> blackboard;         // at most 64 keys
+    BTNodeDesc root;
+
+    Key& AddKey(const std::string& keyName, BTValueType type, f32 defaultValue = 0.0f);
+
+    /// Parse the JSON form shown at the top of this file.
+    static bool FromJson(const std::string& json, BehaviorTreeDesc& out, std::string& error);
+};
+
+// ============================================================================
+// BTContext — what native leaves see
+// ============================================================================
+class BTContext {
+public:
+    BTAgent& agent;
+    u32      node;                       // index in the compiled tree
+    f32      dt;                         // seconds since the agent's previous tick
+
+    BTContext(BTAgent& a, u32 n, f32 delta) : agent(a), node(n), dt(delta) {}
+
+    f32 GetArg(std::string_view name, f32 fallback = 0.0f) const;
+    const std::string& GetText(std::string_view name) const;
+
+    /// From a Running action: don't tick this agent again for `seconds`
+    /// (or until one of its blackboard keys changes).
+    void SleepFor(f32 seconds);
+    /// From a Running action: wait for a blackboard change or Wake().
+    void SleepUntilChanged();
+
+private:
+    friend class BTAgent;
+    bool m_Slept = false;
+    f64  m_WakeAt = 0.0;
+};
+
+// ============================================================================
+// BTRegistry — native leaves, scorers and the script engine trees bind to
+// ============================================================================
+class BTRegistry {
+public:
+    using ActionFn    = std::function<BTStatus(BTContext&)>;
+    using AbortFn     = std::function<void(BTContext&)>;
+    using ConditionFn = std::function<bool(BTContext&)>;
+    using ScorerFn    = std::function<f32(BTContext&)>;
+
+    static BTRegistry& Global();
+
+    /// `threadSafe`: may run on UpdateBatch's worker threads.  `onAbort`
+    /// runs when a running action is interrupted.
+    void RegisterAction(const std::string& name, ActionFn fn, AbortFn onAbort = nullptr, bool threadSafe = true);
+    void RegisterCondition(const std::string& name, ConditionFn fn, bool threadSafe = true);
+    void RegisterScorer(const std::string& name, ScorerFn fn, bool threadSafe = true);
+
+    /// Enable script leaves and give scripts bb_get(key) / bb_set(key, v)
+    /// for the agent being ticked.  A script leaf returns "success",
+    /// "failure", "running", true/false, or nothing (success).
+    void BindScriptEngine(ScriptEngine& engine);
+    ScriptEngine* GetScriptEngine() const { return m_Scripts; }
+
+private:
+    friend class BehaviorTree;
+    struct Action    { ActionFn fn; AbortFn onAbort; bool threadSafe = true; };
+    struct Condition { ConditionFn fn; bool threadSafe = true; };
+    struct Scorer    { ScorerFn fn; bool threadSafe = true; };
+
+    std::unordered_map<std::string, Action>    m_Actions;
+    std::unordered_map<std::string, Condition> m_Conditions;
+    std::unordered_map<std::string, Scorer>    m_Scorers;
+    ScriptEngine* m_Scripts = nullptr;
+};
+
+// ============================================================================
+// BehaviorTree — compiled and immutable
+// ============================================================================
+class BehaviorTree {
+public:
+    static constexpr u32 kNone = ~0u;
+    static constexpr u32 kMaxKeys = 64;
+
+    /// Resolve names against `registry` and flatten.  nullptr (with
+    /// `error`) on unknown keys, leaves or scorers, or malformed nodes.
+    static Shared<const BehaviorTree> Compile(const BehaviorTreeDesc& desc, std::string& error,
+                                              const BTRegistry& registry = BTRegistry::Global());
+    static Shared<const BehaviorTree> LoadJson(const std::string& json, std::string& error,
+                                               const BTRegistry& registry = BTRegistry::Global());
+    static Shared<const BehaviorTree> LoadFile(const std::string& path, std::string& error,
+                                               const BTRegistry& registry = BTRegistry::Global());
+
+    const std::string& GetName() const { return m_Name; }
+    u32  GetNodeCount() const  { return static_cast<u32>(m_Nodes.size()); }
+    BTNodeType GetNodeType(u32 node) const { return m_Nodes[node].type; }
+    const std::string& GetNodeLabel(u32 node) const { return m_Labels[node]; }
+    u32  GetStateWords() const { return m_Words; }
+    bool NeedsMainThread() const { return m_MainThread; }
+
+    u32 GetKeyCount() const { return static_cast<u32>(m_Keys.size()); }
+    u32 FindKey(std::string_view keyName) const;
+    const std::string& GetKeyName(u32 key) const { return m_Keys[key].name; }
+    BTValueType GetKeyType(u32 key) const { return m_Keys[key].type; }
+
+private:
+    friend class BTAgent;
+    friend class BTContext;
+
+    struct Node {
+        BTNodeType type = BTNodeType::Sequence;
+        BTCompare  op = BTCompare::Set;
+        BTAbort    abort = BTAbort::None;
+        u8  nativeScored = 0;            // utility: a child has a native scorer
+        u16 childCount = 0;
+        u32 firstChild = 0;              // into m_Children
+        u32 end = 0;                     // one past this subtree (pre-order)
+        u32 slot = 0;                    // state word; composites use more after it
+        u32 timer = kNone;               // into the agent's timers
+        u32 key = kNone;
+        u32 leaf = kNone;                // into m_Actions / m_Conditions / m_ScriptNames
+        u32 scorer = kNone;
+        u32 firstConsideration = 0;
+        u16 considerationCount = 0;
+        u16 argCount = 0;
+        u32 firstArg = 0;
+        i32 count = 0;
+        i32 failures = 1;
+        f32 value = 0.0f;                // seconds, threshold, written value, hysteresis
+        f32 weight = 1.0f;
+        u64 observed = 0;                // blackboard keys whose changes re-evaluate it
+    };
+    struct Consideration {
+        u32 key = 0;
+        BTCurve curve = BTCurve::Linear;
+        bool invert = false;
+        f32 min = 0.0f, scale = 1.0f;    // (value - min) * scale
+        f32 exponent = 2.0f, steepness = 10.0f, midpoint = 0.5f;
+    };
+
+    std::string m_Name;
+    std::vector<Node>          m_Nodes;  // pre-order; 0 is the root
+    std::vector<u32>           m_Children;
+    std::vector<Consideration> m_Considerations;
+    std::vector<BTArg>         m_Args;
+    std::vector<std::string>   m_Labels;
+    std::vector<BTRegistry::Action>    m_Actions;
+    std::vector<BTRegistry::Condition> m_Conditions;
+    std::vector<BTRegistry::Scorer>    m_Scorers;
+    std::vector<std::string>   m_ScriptNames;
+    ScriptEngine* m_Scripts = nullptr;
+    bool m_MainThread = false;
+    u32  m_Words = 0;
+    u32  m_Timers = 0;
+
+    std::vector<BehaviorTreeDesc::Key> m_Keys;
+    std::unordered_map<std::string, u32> m_KeyIndex;
+};
+
+// ============================================================================
+// BTAgent — one running instance
+// ============================================================================
+class BTAgent {
+public:
+    BTAgent() = default;
+    explicit BTAgent(Shared<const BehaviorTree> tree, GameObject* owner = nullptr);
+
+    void SetTree(Shared<const BehaviorTree> tree);
+    const Shared<const BehaviorTree>& GetTree() const { return m_Tree; }
+    bool IsValid() const { return m_Tree != nullptr; }
+    void SetOwner(GameObject* owner) { m_Owner = owner; }
+    GameObject* GetOwner() const     { return m_Owner; }
+    /// Abort what's running and restore the blackboard defaults.
+    void Reset();
+
+    // ── Blackboard (by BehaviorTree::FindKey index; names for setup) ───────
+    u32  FindKey(std::string_view name) const { return m_Tree ? m_Tree->FindKey(name) : BehaviorTree::kNone; }
+    void SetBool(u32 key, bool value);
+    void SetInt(u32 key, i32 value);
+    void SetFloat(u32 key, f32 value);
+    void SetObject(u32 key, u32 id);
+    void SetVector(u32 key, const Vec3& value);
+    bool GetBool(u32 key) const   { return key < m_Values.size() && m_Values[key].b; }
+    i32  GetInt(u32 key) const    { return key < m_Values.size() ? m_Values[key].i : 0; }
+    f32  GetFloat(u32 key) const  { return key < m_Values.size() ? m_Values[key].f : 0.0f; }
+    u32  GetObject(u32 key) const { return key < m_Values.size() ? m_Values[key].id : 0; }
+    Vec3 GetVector(u32 key) const { return key < m_Values.size() ? m_Values[key].v : Vec3(); }
+    /// Any key type as a number (bool 0/1; vectors: length).
+    f32  GetNumber(u32 key) const;
+    /// Write a number into any non-vector key, converting to its type.
+    void SetNumber(u32 key, f32 value);
+
+    void SetBool(std::string_view key, bool value)  { SetBool(FindKey(key), value); }
+    void SetInt(std::string_view key, i32 value)    { SetInt(FindKey(key), value); }
+    void SetFloat(std::string_view key, f32 value)  { SetFloat(FindKey(key), value); }
+    void SetObject(std::string_view key, u32 id)    { SetObject(FindKey(key), id); }
+    void SetVector(std::string_view key, const Vec3& value) { SetVector(FindKey(key), value); }
+    bool GetBool(std::string_view key) const  { return GetBool(FindKey(key)); }
+    i32  GetInt(std::string_view key) const   { return GetInt(FindKey(key)); }
+    f32  GetFloat(std::string_view key) const { return GetFloat(FindKey(key)); }
+    u32  GetObject(std::string_view key) const { return GetObject(FindKey(key)); }
+    Vec3 GetVector(std::string_view key) const { return GetVector(FindKey(key)); }
+
+    // ── Stepping ───────────────────────────────────────────────────────────
+    /// Advance the agent's clock and tick if anything is due.
+    void Update(f32 dt);
+    /// Tick now, due or not.
+    void Tick();
+    /// Make the next Update tick.
+    void Wake() { m_WakeAt = m_Now; }
+    static void UpdateBatch(BTAgent* agents, size_t count, f32 dt, u32 threads = 0);
+    static void UpdateBatch(BTAgent* const* agents, size_t count, f32 dt, u32 threads = 0);
+
+    // ── Queries ────────────────────────────────────────────────────────────
+    BTStatus GetLastStatus() const { return m_LastStatus; }
+    u64  GetTickCount() const  { return m_Ticks; }
+    f64  GetTime() const       { return m_Now; }
+    bool IsSleeping() const    { return m_Dirty == 0 && m_Now < m_WakeAt; }
+    bool IsNodeRunning(u32 node) const;
+
+private:
+    friend class BTContext;
+
+    BTStatus Exec(u32 node);
+    BTStatus ExecChildren(u32 node, const BehaviorTree::Node& n);
+    BTStatus ExecParallel(u32 node, const BehaviorTree::Node& n);
+    BTStatus ExecUtility(u32 node, const BehaviorTree::Node& n);
+    BTStatus RunScript(u32 node, const BehaviorTree::Node& n);
+    bool     Test(const BehaviorTree::Node& n) const;
+    f32      Score(u32 node);
+    void     Abort(u32 node);
+    void     Mark(u32 key, bool changed);
+    void     WakeAt(f64 time) { if (time < m_NextWake) m_NextWake = time; }
+    u32      Child(const BehaviorTree::Node& n, u32 index) const { return m_Tree->m_Children[n.firstChild + index]; }
+
+    Shared<const BehaviorTree> m_Tree;
+    GameObject*          m_Owner = nullptr;
+    std::vector<BTValue> m_Values;
+    std::vector<u32>     m_Words;        // per node: bit 0 = running, the rest node-specific
+    std::vector<f64>     m_Timers;
+    u64  m_Dirty = 0;                    // keys changed since the last tick
+    u64  m_Changed = 0;                  // keys changed before this tick (read while ticking)
+    f64  m_Now = 0.0;
+    f64  m_LastTick = 0.0;
+    f64  m_WakeAt = 0.0;
+    f64  m_NextWake = 0.0;               // gathered during a tick
+    u64  m_Ticks = 0;
+    BTStatus m_LastStatus = BTStatus::Running;
+};
+
+// ============================================================================
+// BehaviorTreeComponent — runs an agent on a GameObject
+// ============================================================================
+class BehaviorTreeComponent : public Component {
+public:
+    std::string GetTypeName() const override { return "BehaviorTree"; }
+    GV_SNAPSHOT_COMPONENT(BehaviorTreeComponent)
+
+    void SetTree(Shared<const BehaviorTree> tree) { m_Agent.SetTree(std::move(tree)); m_Agent.SetOwner(GetOwner()); }
+    BTAgent& GetAgent() { return m_Agent; }
+    const BTAgent& GetAgent() const { return m_Agent; }
+
+    void OnAttach() override { m_Agent.SetOwner(GetOwner()); }
+    void OnUpdate(f32 dt) override { m_Agent.Update(dt); }
+
+private:
+    BTAgent m_Agent;
+};
+
+} // namespace gv
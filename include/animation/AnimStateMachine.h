@@ -0,0 +1,312 @@
+// ============================================================================
+// GameVoid Engine — Animation State Machines
+// ============================================================================
+// One runtime for both sprite (AnimStateMachine2D) and transform (Animator)
+// animation.  A machine owns typed parameters and plays one state at a time;
+// transitions between states fire on their own once their conditions hold,
+// so gameplay code only sets parameters:
+//
+//   AnimGraphDesc desc;
+//   desc.AddParameter("speed", AnimParamType::Float);
+//   desc.AddParameter("jump", AnimParamType::Trigger);
+//   desc.AddState("Idle", 1.0f);
+//   desc.AddState("Run", 0.6f);
+//   desc.AddState("Jump", 0.5f, false).events.push_back({ 0.0f, "jump_sfx" });
+//   desc.AddTransition("Idle", "Run", 0.1f).When("speed", AnimCondition::Greater, 0.1f);
+//   desc.AddTransition("Run", "Idle", 0.1f).When("speed", AnimCondition::Less, 0.1f);
+//   desc.AddAnyTransition("Jump").When("jump", AnimCondition::If);
+//   desc.AddTransition("Jump", "Idle", 0.2f).AfterExitTime(1.0f);
+//   Shared<const AnimGraph> graph = AnimGraph::Compile(desc, error);
+//
+// AnimGraph is the compiled, immutable form: states, transitions, conditions
+// and events are flat arrays addressed by index, and names are only looked
+// up while setting things up.  Many machines share one graph.
+//
+// Update order, each step (deterministic for a given dt sequence):
+//   1. Advance the current state (and, mid-transition, the next state) by
+//      dt × speed / length.  Events whose time is crossed are recorded,
+//      at most once per event per step.
+//   2. Finish the running transition once its duration has elapsed.
+//   3. Take at most one transition, the first that is ready in this order:
+//        • any-state transitions (never to the current or next state unless
+//          canTransitionToSelf) — these interrupt every transition and
+//          fade from whichever of its two states weighs more
+//        • idle: the current state's transitions
+//        • mid-transition: the transitions its `interrupt` rule names — the
+//          source's (the fade restarts from the source) and/or the
+//          destination's (the destination becomes the source)
+//      Ready = every condition holds and, if it has one, the exit time has
+//      been reached.  An exit time below 1 on a looping state is reached
+//      from that point to the end of every loop; otherwise once the
+//      normalized time reaches it.  Triggers a transition tests are reset
+//      when it fires.  A zero-duration transition switches at once.
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace gv {
+
+enum class AnimParamType : u8 { Float, Int, Bool, Trigger };
+
+/// Float: Greater / Less.  Int: all four comparisons.  Bool: If / IfNot.
+/// Trigger: If.
+enum class AnimCondition : u8 { Greater, Less, Equals, NotEquals, If, IfNot };
+
+/// Which transitions may interrupt a transition in progress (besides
+/// any-state transitions, which always can).
+enum class AnimInterrupt : u8 { None, Source, Destination, SourceThenDestination, DestinationThenSource };
+
+// ============================================================================
+// AnimGraphDesc — the authoring form, names everywhere
+// ============================================================================
+struct AnimGraphDesc {
+    struct Parameter {
+        std::string   name;
+        AnimParamType type = AnimParamType::Float;
+        f32           defaultValue = 0.0f;
+    };
+    struct Event {
+        f32         time = 0.0f;            // normalized, 0..1
+        std::string name;
+    };
+    struct State {
+        std::string name;
+        std::string clip;                   // what the host plays; defaults to the name
+        f32  length = 1.0f;                 // seconds at speed 1
+        f32  speed  = 1.0f;
+        bool loop   = true;
+        std::vector<Event> events;
+    };
+    struct Condition {
+        std::string   parameter;
+        AnimCondition op = AnimCondition::If;
+        f32           threshold = 0.0f;
+    };
+    struct Transition {
+        std::string from;                   // empty = any state
+        std::string to;
+        std::vector<Condition> conditions;
+        bool  hasExitTime = false;
+        f32   exitTime = 1.0f;              // normalized time of `from`
+        f32   duration = 0.0f;              // cross-fade, seconds
+        f32   offset   = 0.0f;              // normalized start time in `to`
+        AnimInterrupt interrupt = AnimInterrupt::None;
+        bool  canTransitionToSelf = false;  // any-state transitions only
+
+        Transition& When(const std::string& parameter, AnimCondition op, f32 threshold = 0.0f) {
+            conditions.push_back({ parameter, op, threshold });
+            return *this;
+        }
+        Transition& AfterExitTime(f32 time) { hasExitTime = true; exitTime = time; return *this; }
+        Transition& InterruptedBy(AnimInterrupt source) { interrupt = source; return *this; }
+    };
+
+    std::vector<Parameter>  parameters;
+    std::vector<State>      states;
+    std::vector<Transition> transitions;    // evaluated in this order
+    std::string defaultState;               // empty = the first state
+
+    Parameter& AddParameter(const std::string& name, AnimParamType type, f32 defaultValue = 0.0f) {
+        parameters.push_back({ name, type, defaultValue });
+        return parameters.back();
+    }
+    State& AddState(const std::string& name, f32 length = 1.0f, bool loop = true) {
+        states.push_back({ name, name, length, 1.0f, loop, {} });
+        return states.back();
+    }
+    Transition& AddTransition(const std::string& from, const std::string& to, f32 duration = 0.0f) {
+        transitions.emplace_back();
+        transitions.back().from = from;
+        transitions.back().to = to;
+        transitions.back().duration = duration;
+        return transitions.back();
+    }
+    Transition& AddAnyTransition(const std::string& to, f32 duration = 0.0f) {
+        return AddTransition("", to, duration);
+    }
+};
+
+// ============================================================================
+// AnimGraph — compiled, shared by every machine that runs it
+// ============================================================================
+class AnimGraph {
+public:
+    static constexpr u32 kNone = ~0u;
+
+    /// Validate and flatten.  Returns nullptr and sets `error` on unknown
+    /// names, duplicate names, conditions that don't suit their parameter's
+    /// type, or transitions that could never wait (no condition, no exit
+    /// time).
+    static Shared<const AnimGraph> Compile(const AnimGraphDesc& desc, std::string& error);
+
+    u32 GetStateCount() const      { return static_cast<u32>(m_States.size()); }
+    u32 GetParameterCount() const  { return static_cast<u32>(m_ParamTypes.size()); }
+    u32 GetTransitionCount() const { return static_cast<u32>(m_Transitions.size()); }
+    u32 GetEventCount() const      { return static_cast<u32>(m_EventNames.size()); }
+    u32 GetDefaultState() const    { return m_DefaultState; }
+
+    u32 FindState(std::string_view name) const;
+    u32 FindParameter(std::string_view name) const;
+    u32 FindEvent(std::string_view name) const;
+
+    const std::string& GetStateName(u32 state) const     { return m_StateNames[state]; }
+    const std::string& GetStateClip(u32 state) const     { return m_StateClips[state]; }
+    f32                GetStateLength(u32 state) const   { return m_States[state].length; }
+    bool               IsStateLooping(u32 state) const   { return m_States[state].loop != 0; }
+    const std::string& GetParameterName(u32 param) const { return m_ParamNames[param]; }
+    AnimParamType      GetParameterType(u32 param) const { return m_ParamTypes[param]; }
+    f32                GetParameterDefault(u32 param) const { return m_Defaults[param]; }
+    const std::string& GetEventName(u32 event) const     { return m_EventNames[event]; }
+
+private:
+    friend class AnimStateMachine;
+
+    struct State {
+        f32 length = 1.0f;
+        f32 rate = 1.0f;                    // normalized time per second: speed / length
+        u32 firstTransition = 0;
+        u32 firstEvent = 0;
+        u16 transitionCount = 0;
+        u16 eventCount = 0;
+        u8  loop = 1;
+    };
+    struct Transition {
+        u32 target = 0;
+        u32 firstCondition = 0;
+        u16 conditionCount = 0;
+        AnimInterrupt interrupt = AnimInterrupt::None;
+        u8  hasExitTime = 0;
+        u8  toSelf = 0;
+        f32 exitTime = 1.0f;
+        f32 duration = 0.0f;
+        f32 offset = 0.0f;
+    };
+    struct Condition {
+        u32 param = 0;
+        AnimCondition op = AnimCondition::If;
+        u8  consume = 0;                    // trigger: reset when the transition fires
+        f32 threshold = 0.0f;
+    };
+    struct Event {
+        f32 time = 0.0f;
+        u32 id = 0;
+    };
+
+    std::vector<State>      m_States;
+    std::vector<Transition> m_Transitions;  // any-state ones first, then per state
+    std::vector<Condition>  m_Conditions;
+    std::vector<Event>      m_Events;       // per state, sorted by time
+    u32 m_AnyCount = 0;
+    u32 m_DefaultState = 0;
+
+    std::vector<AnimParamType> m_ParamTypes;
+    std::vector<f32>           m_Defaults;
+
+    std::vector<std::string> m_StateNames, m_StateClips, m_ParamNames, m_EventNames;
+    std::unordered_map<std::string, u32> m_StateIndex, m_ParamIndex, m_EventIndex;
+};
+
+// ============================================================================
+// AnimStateMachine — one running instance
+// ============================================================================
+class AnimStateMachine {
+public:
+    static constexpr u32 kNone = AnimGraph::kNone;
+
+    struct EventHit {
+        u32 event = 0;                      // AnimGraph event index
+        u32 state = 0;                      // the state it belongs to
+    };
+
+    AnimStateMachine() = default;
+    explicit AnimStateMachine(Shared<const AnimGraph> graph) { SetGraph(std::move(graph)); }
+
+    /// Start running `graph` from its default state with default parameters.
+    void SetGraph(Shared<const AnimGraph> graph);
+    const Shared<const AnimGraph>& GetGraph() const { return m_Graph; }
+    bool IsValid() const { return m_Graph != nullptr; }
+    /// Back to the default state and parameter values.
+    void Reset();
+
+    // ── Parameters (by AnimGraph::FindParameter index; names for setup) ────
+    void SetFloat(u32 param, f32 value)  { if (param < m_Params.size()) m_Params[param] = value; }
+    void SetInt(u32 param, i32 value)    { SetFloat(param, static_cast<f32>(value)); }
+    void SetBool(u32 param, bool value)  { SetFloat(param, value ? 1.0f : 0.0f); }
+    void SetTrigger(u32 param)           { SetFloat(param, 1.0f); }
+    void ResetTrigger(u32 param)         { SetFloat(param, 0.0f); }
+    f32  GetFloat(u32 param) const { return param < m_Params.size() ? m_Params[param] : 0.0f; }
+    i32  GetInt(u32 param) const   { return static_cast<i32>(GetFloat(param)); }
+    bool GetBool(u32 param) const  { return GetFloat(param) != 0.0f; }
+
+    void SetFloat(std::string_view name, f32 value) { SetFloat(Param(name), value); }
+    void SetInt(std::string_view name, i32 value)   { SetInt(Param(name), value); }
+    void SetBool(std::string_view name, bool value) { SetBool(Param(name), value); }
+    void SetTrigger(std::string_view name)          { SetTrigger(Param(name)); }
+    f32  GetFloat(std::string_view name) const      { return GetFloat(Param(name)); }
+    i32  GetInt(std::string_view name) const        { return GetInt(Param(name)); }
+    bool GetBool(std::string_view name) const       { return GetBool(Param(name)); }
+
+    // ── Stepping ───────────────────────────────────────────────────────────
+    void Update(f32 dt);
+    /// Update `count` machines.  threads: 0 = pick (small batches stay on
+    /// the calling thread).  Events are collected per machine, not
+    /// dispatched, so this is safe to split across threads.
+    static void UpdateBatch(AnimStateMachine* machines, size_t count, f32 dt, u32 threads = 0);
+    static void UpdateBatch(AnimStateMachine* const* machines, size_t count, f32 dt, u32 threads = 0);
+
+    /// Jump to `state` now, cancelling any transition.
+    void Play(u32 state, f32 normalizedTime = 0.0f);
+    /// Fade to `state` over `duration` seconds (an unconditional transition).
+    void CrossFade(u32 state, f32 duration, f32 normalizedTime = 0.0f);
+
+    // ── Queries ────────────────────────────────────────────────────────────
+    u32  GetState() const { return m_State; }
+    /// Loops completed plus the position in the current loop.
+    f32  GetNormalizedTime() const { return static_cast<f32>(m_Clock.loops) + m_Clock.time; }
+    /// Position within the clip, 0..1 (held at 1 once a one-shot ends).
+    f32  GetClipTime() const { return ClipTime(m_State, m_Clock); }
+
+    bool IsInTransition() const { return m_Next != kNone; }
+    u32  GetNextState() const { return m_Next; }
+    f32  GetNextClipTime() const { return m_Next != kNone ? ClipTime(m_Next, m_NextClock) : 0.0f; }
+    /// Weight of the next state in the fade, 0..1.
+    f32  GetBlendWeight() const;
+
+    /// Events crossed during the last Update.
+    const std::vector<EventHit>& GetEvents() const { return m_Events; }
+
+private:
+    struct Clock {
+        f32 time = 0.0f;                    // looping: 0..1; one-shot: unbounded
+        u32 loops = 0;
+        bool fresh = true;                  // entered this step: events at `time` fire
+    };
+
+    u32  Param(std::string_view name) const { return m_Graph ? m_Graph->FindParameter(name) : kNone; }
+    f32  ClipTime(u32 state, const Clock& clock) const;
+    void Advance(u32 state, Clock& clock, f32 dt);
+    bool ExitReached(u32 state, const Clock& before, const Clock& after, f32 exitTime) const;
+    bool Ready(u32 transition, u32 state, const Clock& before, const Clock& after) const;
+    u32  FindTransition(u32 first, u32 count, u32 state, const Clock& before, const Clock& after) const;
+    u32  FindAny() const;
+    void Begin(u32 transition, u32 from, const Clock& fromClock);
+    void Enter(u32 state, f32 normalizedTime, Clock& clock);
+
+    Shared<const AnimGraph> m_Graph;
+    std::vector<f32> m_Params;
+    u32   m_State = kNone;
+    Clock m_Clock, m_ClockBefore;
+    u32   m_Next = kNone;                   // destination while fading
+    Clock m_NextClock, m_NextClockBefore;
+    f32   m_Fade = 0.0f;                    // seconds elapsed in the fade
+    f32   m_FadeDuration = 0.0f;
+    u8    m_Interrupt = 0;                  // AnimInterrupt of the running fade
+    std::vector<EventHit> m_Events;
+};
+
+} // namespace gv
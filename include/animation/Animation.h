@@ -3,12 +3,15 @@
 // ============================================================================
 // Keyframe-based animation with clips, blend states, and a timeline.
 // Supports transform animation (position, rotation, scale) on GameObjects.
+// An Animator can also be driven by a state machine (AnimStateMachine.h):
+// each state plays the clip its graph names.
 // ============================================================================
 #pragma once
 
 #include "core/Types.h"
 #include "core/Math.h"
 #include "core/Component.h"
+#include "animation/AnimStateMachine.h"
 #include <vector>
 #include <string>
 #include <map>
@@ -102,7 +105,25 @@ public:
 
     const std::string& GetCurrentClipName() const { return m_CurrentClip; }
 
+    // ── State machine ──────────────────────────────────────────────────────
+    /// Drive playback from a graph instead of Play/CrossFade.  States with a
+    /// length of 0 take their clip's duration.  False (with `error`) if the
+    /// graph doesn't compile.
+    bool SetStateMachine(AnimGraphDesc desc, std::string* error = nullptr);
+    /// Run an already-compiled graph (lengths are taken as given).
+    void SetStateMachine(Shared<const AnimGraph> graph);
+    void ClearStateMachine();
+    bool HasStateMachine() const { return m_Machine.IsValid(); }
+    /// Set parameters and read state/events here.
+    AnimStateMachine& GetStateMachine() { return m_Machine; }
+    const AnimStateMachine& GetStateMachine() const { return m_Machine; }
+    /// Called after each update for every animation event crossed.
+    void SetEventCallback(std::function<void(const std::string&)> callback) { m_OnEvent = std::move(callback); }
+
 private:
+    /// Clip pointers per state, so updates don't look clips up by name.
+    void ResolveStateClips();
+
     std::map<std::string, AnimationClip> m_Clips;
     std::string m_CurrentClip;
     f32 m_Time     = 0.0f;
@@ -113,6 +134,11 @@ private:
     // Blending
     BlendState m_Blend;
     bool m_Blending = false;
+
+    // State machine
+    AnimStateMachine m_Machine;
+    std::vector<const AnimationClip*> m_StateClips;
+    std::function<void(const std::string&)> m_OnEvent;
 };
 
 // ── Animation Library ──────────────────────────────────────────────────────
@@ -18,6 +18,7 @@ namespace gv {
 
 // Forward declarations
 class GameObject;
+class SkinnedMesh;
 
 // ── Bone ───────────────────────────────────────────────────────────────────
 /// Represents a single bone in a skeletal hierarchy.
@@ -167,6 +168,10 @@ public:
     /// Per-vertex bone weights (same count as mesh vertices).
     std::vector<VertexWeight> vertexWeights;
 
+    /// Skinned geometry (bone ids index `skeleton`).  Drawn as a cube
+    /// placeholder when unset.
+    Shared<SkinnedMesh> mesh;
+
     /// Mesh path (loaded model).
     std::string meshPath;
 
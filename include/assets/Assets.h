@@ -7,10 +7,18 @@
 
 #include "core/Types.h"
 #include "core/Math.h"
+#include "assets/Meshlet.h"
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace gv {
 
+class TextureStreamer;
+class TextureStreamBackend;
+struct TextureStreamSettings;
+class MeshRegistry;
+
 // ============================================================================
 // Texture
 // ============================================================================
@@ -20,9 +28,23 @@ public:
     Texture() = default;
     explicit Texture(const std::string& path) : m_Path(path) {}
 
-    /// Load the image file and upload to GPU memory (placeholder).
+    /// Load the image file and upload to GPU memory.  ".gvtx" files are
+    /// uploaded as-is; other RGB/RGBA images are cooked to the texture cache
+    /// on first load (see SetCookOnLoad) and uploaded from there afterwards.
     bool Load(const std::string& path);
 
+    /// Like Load(), but register the cooked texture with `streamer`, which
+    /// uploads only the mip tail now and the rest as the texture is seen.
+    /// Falls back to Load() for images that can't be cooked.
+    bool LoadStreamed(TextureStreamer& streamer, const std::string& path);
+
+    /// First-load cooking of source images (default on).
+    static void SetCookOnLoad(bool enabled);
+    static bool GetCookOnLoad();
+    /// Directory for cooked copies of source images (default "texture_cache").
+    static void SetCookCacheDir(const std::string& dir);
+    static const std::string& GetCookCacheDir();
+
     /// Bind to a given texture unit for rendering.
     void Bind(u32 unit = 0) const;
     void Unbind() const;
@@ -31,13 +53,19 @@ public:
     u32 GetWidth()  const { return m_Width; }
     u32 GetHeight() const { return m_Height; }
     const std::string& GetPath() const { return m_Path; }
+    /// True if the texture's mips are managed by a TextureStreamer.
+    bool IsStreamed() const { return m_Streamed; }
 
 private:
+    /// Upload every level of a .gvtx container.
+    bool LoadCooked(const std::string& path);
+
     std::string m_Path;
     u32 m_TextureID = 0;
     u32 m_Width  = 0;
     u32 m_Height = 0;
     u32 m_Channels = 0;
+    bool m_Streamed = false;
 };
 
 // ============================================================================
@@ -63,11 +91,62 @@ struct SkinnedVertex {
     f32  boneWeights[4] = { 0, 0, 0, 0 };
 };
 
+/// GPU buffer names behind one Mesh (all 0 = not uploaded).
+struct MeshBuffers {
+    u32 vao = 0, vbo = 0, ebo = 0;
+};
+
+/// Creates and frees the buffers behind a Mesh.  The default backend uploads
+/// through GL when a context is current and does nothing otherwise.
+class MeshBufferBackend {
+public:
+    virtual ~MeshBufferBackend() = default;
+    /// Upload vertices and indices.  Returns zeroed buffers on failure.
+    virtual MeshBuffers Upload(const std::vector<Vertex>& vertices, const std::vector<u32>& indices) = 0;
+    virtual void Release(const MeshBuffers& buffers) = 0;
+};
+
+/// Backend that hands out buffer names without a GL context and counts
+/// what is alive.  Used for headless runs and for checking that meshes are
+/// shared and freed.
+class NullMeshBufferBackend : public MeshBufferBackend {
+public:
+    MeshBuffers Upload(const std::vector<Vertex>& vertices, const std::vector<u32>& indices) override {
+        MeshBuffers b;
+        b.vao = ++m_Next; b.vbo = ++m_Next; b.ebo = ++m_Next;
+        m_Live[b.vao] = static_cast<u64>(vertices.size()) * sizeof(Vertex) +
+                        static_cast<u64>(indices.size()) * sizeof(u32);
+        ++m_Uploads;
+        return b;
+    }
+    void Release(const MeshBuffers& buffers) override {
+        if (m_Live.erase(buffers.vao)) ++m_Releases;
+    }
+
+    /// Meshes whose buffers currently exist.
+    u32 GetLiveMeshes() const { return static_cast<u32>(m_Live.size()); }
+    u64 GetLiveBytes() const {
+        u64 total = 0;
+        for (const auto& kv : m_Live) total += kv.second;
+        return total;
+    }
+    u64 GetUploads()  const { return m_Uploads; }
+    u64 GetReleases() const { return m_Releases; }
+
+private:
+    u32                             m_Next = 0;
+    u64                             m_Uploads = 0, m_Releases = 0;
+    std::unordered_map<u32, u64>    m_Live;   // vao -> bytes
+};
+
 /// A mesh is a collection of vertices and indices uploaded to the GPU.
 class Mesh {
 public:
     Mesh() = default;
     explicit Mesh(const std::string& name) : m_Name(name) {}
+    ~Mesh();
+    Mesh(const Mesh&) = delete;             // owns GL buffers
+    Mesh& operator=(const Mesh&) = delete;
 
     /// Load from a file (OBJ, FBX, glTF) via an asset importer.
     bool LoadFromFile(const std::string& path);
@@ -83,33 +162,57 @@ public:
     u32 GetIndexCount()  const { return static_cast<u32>(m_Indices.size()); }
     const std::string& GetName() const { return m_Name; }
 
-    /// Compute axis-aligned bounding box. Returns min and max corners.
-    void GetBounds(Vec3& outMin, Vec3& outMax) const {
-        if (m_Vertices.empty()) { outMin = outMax = Vec3(0,0,0); return; }
-        outMin = outMax = m_Vertices[0].position;
-        for (auto& v : m_Vertices) {
-            if (v.position.x < outMin.x) outMin.x = v.position.x;
-            if (v.position.y < outMin.y) outMin.y = v.position.y;
-            if (v.position.z < outMin.z) outMin.z = v.position.z;
-            if (v.position.x > outMax.x) outMax.x = v.position.x;
-            if (v.position.y > outMax.y) outMax.y = v.position.y;
-            if (v.position.z > outMax.z) outMax.z = v.position.z;
-        }
+    const std::vector<Vertex>& GetVertices() const { return m_Vertices; }
+    const std::vector<u32>&    GetIndices()  const { return m_Indices; }
+
+    /// Axis-aligned bounding box (computed once by Build()).
+    void GetBounds(Vec3& outMin, Vec3& outMax) const { outMin = m_BoundsMin; outMax = m_BoundsMax; }
+
+    /// Vertex + index data in bytes (also the size of the GPU buffers).
+    u64 GetMemoryBytes() const {
+        return static_cast<u64>(m_Vertices.size()) * sizeof(Vertex) +
+               static_cast<u64>(m_Indices.size()) * sizeof(u32);
     }
+    /// True once Build() has created GPU buffers.
+    bool IsUploaded() const { return m_Buffers.vao != 0; }
+    u32  GetVAO() const     { return m_Buffers.vao; }
+    /// Delete the GPU buffers; CPU data is kept.
+    void ReleaseGPU();
+
+    /// Backend used by Build() from now on (null = GL).  Each mesh frees its
+    /// buffers through the backend that created them, which must outlive it.
+    static void SetBufferBackend(MeshBufferBackend* backend);
+    static MeshBufferBackend& GetBufferBackend();
+
+    // ── Meshlets ───────────────────────────────────────────────────────────
+    /// Meshlets for per-cluster culling.  Build() creates them for meshes of
+    /// at least GetMeshletMinTriangles() triangles and then stores the index
+    /// buffer in meshlet order; smaller meshes have none.
+    const MeshletData& GetMeshlets() const { return m_Meshlets; }
+    bool HasMeshlets() const { return !m_Meshlets.Empty(); }
+
+    static void SetBuildMeshlets(bool enabled);
+    static bool GetBuildMeshlets();
+    static void SetMeshletMinTriangles(u32 count);
+    static u32  GetMeshletMinTriangles();
 
     // ── Built-in primitives (placeholder factories) ────────────────────────
     static Shared<Mesh> CreateCube();
     static Shared<Mesh> CreateSphere(u32 segments = 32, u32 rings = 16);
     static Shared<Mesh> CreatePlane(f32 width = 10.0f, f32 depth = 10.0f);
     static Shared<Mesh> CreateQuad();    // unit quad for 2D / sprites
+    static Shared<Mesh> CreateTriangle();
 
 private:
     std::string         m_Name;
     std::vector<Vertex> m_Vertices;
     std::vector<u32>    m_Indices;
+    Vec3                m_BoundsMin { 0, 0, 0 }, m_BoundsMax { 0, 0, 0 };
+    MeshletData         m_Meshlets;
 
-    // GPU handles (OpenGL)
-    u32 m_VAO = 0, m_VBO = 0, m_EBO = 0;
+    // GPU handles and the backend that created them
+    MeshBuffers        m_Buffers;
+    MeshBufferBackend* m_Backend = nullptr;
 
     /// Internal OBJ file parser.
     bool LoadOBJ(const std::string& path);
@@ -154,16 +257,15 @@ private:
 };
 
 // ============================================================================
-// Minimal glTF 2.0 Loader
+// glTF 2.0 — flattened geometry
 // ============================================================================
-/// Loads meshes and skeletal data from .gltf / .glb files.
-/// Provides a simplified interface — no external dependencies (Assimp-free).
+/// All triangle primitives of a .gltf / .glb file's default scene as one
+/// vertex/index list.  For the node hierarchy, skins, animations and
+/// materials use GLTFDocument / ImportGLTFScene (assets/GLTFLoader.h).
 struct GLTFLoadResult {
     std::vector<SkinnedVertex> vertices;
     std::vector<u32>           indices;
-    bool                       hasBones = false;
-    // Bone data (names, hierarchy, inverse bind matrices) can be extracted
-    // into a Skeleton object externally.
+    bool                       hasBones = false;   // boneIDs hold skin joint indices
 };
 
 /// Load geometry from a glTF/glb file. Returns true on success.
@@ -206,7 +308,17 @@ private:
 /// Central cache so the same texture / mesh is not loaded twice.
 class AssetManager {
 public:
-    AssetManager() = default;
+    AssetManager();
+    ~AssetManager();
+
+    /// Stream cooked textures loaded from now on (GL backend).  Textures
+    /// already loaded stay fully resident.
+    void EnableTextureStreaming(const TextureStreamSettings& settings);
+    /// Same with an explicit backend (e.g. RecordingTextureStreamBackend).
+    void EnableTextureStreaming(Unique<TextureStreamBackend> backend,
+                                const TextureStreamSettings& settings);
+    /// Null unless streaming is enabled.
+    TextureStreamer* GetTextureStreamer() { return m_Streamer.get(); }
 
     /// Load (or retrieve from cache) a texture.
     Shared<Texture> LoadTexture(const std::string& path);
@@ -220,6 +332,9 @@ public:
     /// Retrieve a previously created material by name.
     Shared<Material> GetMaterial(const std::string& name) const;
 
+    /// Shared meshes for primitives and generated shapes (see MeshRegistry.h).
+    MeshRegistry& GetMeshRegistry();
+
     /// Release all cached resources.
     void Clear();
 
@@ -227,6 +342,9 @@ private:
     std::unordered_map<std::string, Shared<Texture>>  m_Textures;
     std::unordered_map<std::string, Shared<Mesh>>     m_Meshes;
     std::unordered_map<std::string, Shared<Material>> m_Materials;
+    Unique<MeshRegistry>                              m_MeshRegistry;
+    Unique<TextureStreamBackend>                      m_StreamBackend;
+    Unique<TextureStreamer>                           m_Streamer;   // destroyed before the backend
 };
 
 // ============================================================================
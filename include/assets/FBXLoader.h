@@ -0,0 +1,136 @@
+// ============================================================================
+// GameVoid Engine — Binary FBX Loader
+// ============================================================================
+// Reads "Kaydara FBX Binary" files (7.x, 32- and 64-bit record headers):
+//   • The file is memory-mapped and parsed into a tree of node records whose
+//     properties point into the mapping; arrays are only decoded when asked
+//     for, and zlib-compressed arrays are inflated by a built-in decoder
+//     (no external zlib)
+//   • Geometry: polygons fan-triangulated, per-polygon-vertex normals and UVs
+//     (every mapping/reference mode), per-polygon material slots
+//   • Materials: diffuse / emissive colour, opacity, diffuse texture file
+//   • Skin clusters → one Skeleton (bind offsets from Transform /
+//     TransformLink) with up to four weights per vertex
+//   • Animation stacks → SkeletalAnimClip per stack from the bones' curves
+//
+// Model transforms use Lcl Translation / Rotation / Scaling with
+// PreRotation / PostRotation and the rotation order; pivots and offsets are
+// ignored (exporters rarely write them for game assets).
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include "core/Math.h"
+#include "assets/Assets.h"
+#include "assets/MappedFile.h"
+#include "animation/SkeletalAnimation.h"
+#include <string>
+#include <vector>
+
+namespace gv {
+
+// ── zlib ───────────────────────────────────────────────────────────────────
+/// Inflate a zlib stream (RFC 1950/1951) into exactly `dstSize` bytes.
+/// Returns false on corrupt data, a size mismatch or a bad Adler-32.
+bool InflateZlib(const u8* src, size_t srcSize, u8* dst, size_t dstSize);
+
+// ── Node records ───────────────────────────────────────────────────────────
+struct FBXProperty {
+    char      type  = 0;        // Y C I F D L | f d l i b (arrays) | S R
+    i64       i     = 0;        // Y C I L
+    f64       d     = 0.0;      // F D
+    const u8* data  = nullptr;  // arrays, strings, raw: into the mapping
+    u32       bytes = 0;        // stored byte size of `data`
+    u32       count = 0;        // array element count
+    u32       encoding = 0;     // arrays: 0 = raw, 1 = zlib
+
+    bool        IsArray() const { return type == 'f' || type == 'd' || type == 'l' || type == 'i' || type == 'b'; }
+    bool        IsString() const { return type == 'S'; }
+    f64         AsNumber() const { return (type == 'F' || type == 'D') ? d : static_cast<f64>(i); }
+    std::string AsString() const {
+        return type == 'S' || type == 'R' ? std::string(reinterpret_cast<const char*>(data), bytes) : std::string();
+    }
+    /// Decode an array property (inflating if needed), converting elements
+    /// to T.  Scalars yield a one-element vector.
+    template <typename T> bool ToVector(std::vector<T>& out) const;
+};
+
+struct FBXNode {
+    std::string              name;
+    std::vector<FBXProperty> props;
+    std::vector<FBXNode>     children;
+
+    const FBXNode* Find(const char* childName) const {
+        for (auto& c : children) if (c.name == childName) return &c;
+        return nullptr;
+    }
+};
+
+// ── Extracted scene ────────────────────────────────────────────────────────
+struct FBXSubMesh {
+    i32 material = -1;          // index into FBXScene::materials (-1 = none)
+    u32 firstIndex = 0;
+    u32 indexCount = 0;
+};
+
+struct FBXMesh {
+    std::string                name;
+    std::vector<SkinnedVertex> vertices;    // one per polygon vertex
+    std::vector<u32>           indices;     // grouped by sub-mesh
+    std::vector<FBXSubMesh>    subMeshes;
+    Mat4                       worldTransform = Mat4::Identity();
+    bool                       skinned = false;   // boneIDs index FBXScene::skeleton
+};
+
+struct FBXMaterial {
+    std::string name;
+    Vec3        diffuse  { 0.8f, 0.8f, 0.8f };
+    Vec3        emissive { 0, 0, 0 };
+    f32         opacity  = 1.0f;
+    std::string diffuseTexture;             // file name as stored (RelativeFilename, else FileName)
+};
+
+struct FBXScene {
+    u32                           version = 0;
+    std::vector<FBXMesh>          meshes;
+    std::vector<FBXMaterial>      materials;
+    Shared<Skeleton>              skeleton;  // null if no mesh is skinned
+    std::vector<SkeletalAnimClip> animations;
+};
+
+// ============================================================================
+// FBXDocument
+// ============================================================================
+class FBXDocument {
+public:
+    /// Map and parse a binary FBX file.
+    bool Load(const std::string& path);
+    /// Parse an in-memory file (`data` must outlive the document).
+    bool Parse(const u8* data, size_t size);
+
+    static bool IsBinaryFBX(const u8* data, size_t size);
+
+    u32                         GetVersion() const { return m_Version; }
+    const std::vector<FBXNode>& GetRoots()   const { return m_Roots; }
+    const FBXNode*              FindRoot(const char* name) const;
+    const std::string&          GetError()   const { return m_Error; }
+
+    /// Geometry, materials, skin and animation.
+    bool Extract(FBXScene& out) const;
+
+private:
+    bool ParseNodeList(size_t& offset, size_t end, std::vector<FBXNode>& out, int depth);
+    bool Fail(const std::string& msg);
+
+    MappedFile           m_File;
+    const u8*            m_Data = nullptr;
+    size_t               m_Size = 0;
+    u32                  m_Version = 0;
+    std::vector<FBXNode> m_Roots;
+    std::string          m_Error;
+};
+
+/// Load `path` and extract its scene.
+bool LoadFBXBinary(const std::string& path, FBXScene& out);
+
+} // namespace gv
@@ -0,0 +1,271 @@
+// ============================================================================
+// GameVoid Engine — glTF 2.0 Loader
+// ============================================================================
+// Reads .gltf (JSON + external/embedded buffers) and .glb files:
+//   • JSON is read with a single-pass pull parser straight into the document
+//     tables — no intermediate DOM, unknown members are skipped in place
+//   • .glb files and external .bin buffers are memory-mapped; "data:" URIs
+//     are base64-decoded once
+//   • Accessors decode directly into Vertex / SkinnedVertex arrays: any
+//     component type (KHR_mesh_quantization), normalized integers, strided
+//     buffer views, matrix column padding and sparse substitution
+//   • Every primitive of every mesh; triangle strips/fans become lists
+//   • Scene import creates one GameObject per node (hierarchy preserved),
+//     with skins as Skeleton + SkinnedMeshRenderer, animations as
+//     SkeletalAnimator / Animator clips, and morph targets baked at their
+//     default weights
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include "core/Math.h"
+#include "assets/MappedFile.h"
+#include <string>
+#include <vector>
+
+namespace gv {
+
+class Scene;
+class GameObject;
+class AssetManager;
+struct SkinnedVertex;
+
+// ── Document tables (glTF 2.0 schema, indices are -1 when absent) ──────────
+struct GLTFBuffer {
+    const u8* data = nullptr;   // into the mapping, the GLB BIN chunk or decoded storage
+    size_t    size = 0;
+};
+
+struct GLTFBufferView {
+    i32    buffer = -1;
+    size_t offset = 0;
+    size_t length = 0;
+    u32    stride = 0;          // 0 = tightly packed
+};
+
+struct GLTFAccessor {
+    enum ComponentType : u32 {
+        Byte = 5120, UnsignedByte = 5121, Short = 5122,
+        UnsignedShort = 5123, UnsignedInt = 5125, Float = 5126
+    };
+
+    i32    bufferView    = -1;  // -1 = all zeros (sparse may still fill it)
+    size_t offset        = 0;
+    u32    componentType = Float;
+    bool   normalized    = false;
+    u32    count         = 0;
+    u32    components    = 1;   // SCALAR 1, VEC2 2, VEC3 3, VEC4 4, MAT2 4, MAT3 9, MAT4 16
+    u32    rows          = 1;   // matrix column height (1 for non-matrix types)
+    std::vector<f32> min, max;
+
+    struct Sparse {
+        u32    count = 0;
+        i32    indicesView = -1;
+        size_t indicesOffset = 0;
+        u32    indicesComponentType = UnsignedInt;
+        i32    valuesView = -1;
+        size_t valuesOffset = 0;
+    } sparse;
+};
+
+struct GLTFMorphTarget {
+    i32 position = -1, normal = -1, tangent = -1;
+};
+
+struct GLTFPrimitive {
+    enum Mode : u32 { Points = 0, Lines, LineLoop, LineStrip, Triangles, TriangleStrip, TriangleFan };
+
+    i32 position = -1, normal = -1, tangent = -1, texcoord0 = -1;
+    i32 color0 = -1, joints0 = -1, weights0 = -1;
+    i32 indices  = -1;
+    i32 material = -1;
+    u32 mode     = Triangles;
+    std::vector<GLTFMorphTarget> targets;
+};
+
+struct GLTFMesh {
+    std::string                name;
+    std::vector<GLTFPrimitive> primitives;
+    std::vector<f32>           weights;     // default morph weights
+};
+
+struct GLTFNode {
+    std::string      name;
+    i32              parent = -1;           // derived from `children`
+    std::vector<i32> children;
+    i32              mesh = -1;
+    i32              skin = -1;
+    Vec3             translation { 0, 0, 0 };
+    Quaternion       rotation;
+    Vec3             scale { 1, 1, 1 };     // `matrix` is decomposed into these
+    std::vector<f32> weights;               // overrides the mesh's morph weights
+};
+
+struct GLTFSkin {
+    std::string      name;
+    i32              inverseBindMatrices = -1;
+    i32              skeleton = -1;
+    std::vector<i32> joints;
+};
+
+struct GLTFAnimationSampler {
+    enum Interpolation { Linear, Step, CubicSpline };
+    i32           input  = -1;              // key times (seconds)
+    i32           output = -1;              // values (3 per key for CubicSpline)
+    Interpolation interpolation = Linear;
+};
+
+struct GLTFAnimationChannel {
+    enum Path { Translation, Rotation, Scale, Weights };
+    i32  sampler = -1;
+    i32  node    = -1;
+    Path path    = Translation;
+};
+
+struct GLTFAnimation {
+    std::string                       name;
+    std::vector<GLTFAnimationSampler> samplers;
+    std::vector<GLTFAnimationChannel> channels;
+};
+
+struct GLTFMaterial {
+    std::string name;
+    Vec4  baseColor { 1, 1, 1, 1 };
+    f32   metallic  = 1.0f;
+    f32   roughness = 1.0f;
+    Vec3  emissive  { 0, 0, 0 };
+    i32   baseColorTexture = -1;            // index into textures
+    i32   normalTexture    = -1;
+    bool  doubleSided = false;
+    bool  alphaBlend  = false;
+};
+
+struct GLTFImage {
+    std::string uri;                        // empty if embedded in a buffer view
+    i32         bufferView = -1;
+    std::string mimeType;
+};
+
+struct GLTFTexture {
+    i32 source = -1;                        // index into images
+};
+
+struct GLTFSceneDesc {
+    std::string      name;
+    std::vector<i32> nodes;
+};
+
+// ── Accessor view ──────────────────────────────────────────────────────────
+/// Strided, typed view of an accessor's dense data (sparse substitution is
+/// applied by GLTFDocument::ReadFloats / ReadUInts, not here).
+struct GLTFAccessorView {
+    const u8* base   = nullptr;             // null = dense part is all zeros
+    size_t    stride = 0;
+    u32       count  = 0;
+    u32       components = 1;
+    u32       componentType = GLTFAccessor::Float;
+    bool      normalized = false;
+    u32       componentOffset[16] = {};     // byte offset of each component within an element
+
+    f32 Float(u32 i, u32 c) const;
+    u32 UInt(u32 i, u32 c) const;
+};
+
+// ============================================================================
+// GLTFDocument
+// ============================================================================
+class GLTFDocument {
+public:
+    GLTFDocument() = default;
+    GLTFDocument(const GLTFDocument&) = delete;
+    GLTFDocument& operator=(const GLTFDocument&) = delete;
+
+    /// Load a .gltf or .glb file.  External buffers are mapped relative to
+    /// the file's directory.
+    bool Load(const std::string& path);
+    /// Parse an in-memory .gltf (JSON) or .glb.  `data` must outlive the
+    /// document; `baseDir` resolves relative buffer URIs.
+    bool Parse(const u8* data, size_t size, const std::string& baseDir = "");
+
+    const std::string& GetError() const { return m_Error; }
+    const std::string& GetBaseDir() const { return m_BaseDir; }
+
+    // ── Accessors ──────────────────────────────────────────────────────────
+    /// Dense view of `accessor`.  Returns false if the index or its byte
+    /// range is invalid.
+    bool GetView(i32 accessor, GLTFAccessorView& out) const;
+
+    /// Decode `accessor` into `dst`: element i lands at dst + i*dstStride
+    /// bytes, first min(components, dstComponents) components as f32.
+    /// Normalized integers map to [0,1] / [-1,1]; others convert by value.
+    bool ReadFloats(i32 accessor, f32* dst, u32 dstComponents, size_t dstStride) const;
+    /// Same for integer data (indices, joint ids).
+    bool ReadUInts(i32 accessor, u32* dst, u32 dstComponents, size_t dstStride) const;
+
+    const GLTFAccessor* GetAccessor(i32 i) const {
+        return (i >= 0 && i < static_cast<i32>(accessors.size())) ? &accessors[i] : nullptr;
+    }
+
+    // ── Geometry ───────────────────────────────────────────────────────────
+    /// Decode one triangle-mode primitive into skinned vertices (boneIDs are
+    /// skin joint indices) and a triangle list.  Morph targets are applied
+    /// with `morphWeights` (may be null).  Missing normals become flat
+    /// normals, missing tangents are generated from the UVs.
+    bool ReadPrimitive(const GLTFPrimitive& prim, std::vector<SkinnedVertex>& vertices,
+                       std::vector<u32>& indices, const std::vector<f32>* morphWeights = nullptr) const;
+
+    /// Node transforms (local TRS, and world by walking parents).
+    Mat4 GetLocalMatrix(i32 node) const;
+    Mat4 GetWorldMatrix(i32 node) const;
+
+    /// Scene to instantiate (`scene` property, else 0, else -1).
+    i32 GetDefaultScene() const;
+
+    // ── Tables ─────────────────────────────────────────────────────────────
+    std::vector<GLTFBuffer>      buffers;
+    std::vector<GLTFBufferView>  bufferViews;
+    std::vector<GLTFAccessor>    accessors;
+    std::vector<GLTFMesh>        meshes;
+    std::vector<GLTFNode>        nodes;
+    std::vector<GLTFSkin>        skins;
+    std::vector<GLTFAnimation>   animations;
+    std::vector<GLTFMaterial>    materials;
+    std::vector<GLTFImage>       images;
+    std::vector<GLTFTexture>     textures;
+    std::vector<GLTFSceneDesc>   scenes;
+    i32                          scene = -1;
+
+private:
+    bool ParseJSON(const char* json, size_t size, const u8* glbBin, size_t glbBinSize);
+    bool ResolveBuffers(const std::vector<std::string>& uris, const std::vector<size_t>& sizes,
+                        const u8* glbBin, size_t glbBinSize);
+    bool Fail(const std::string& msg);
+
+    MappedFile                     m_File;
+    std::vector<Unique<MappedFile>> m_ExternalFiles;
+    std::vector<std::vector<u8>>   m_DecodedBuffers;
+    std::string                    m_BaseDir;
+    std::string                    m_Error;
+};
+
+// ============================================================================
+// Scene import
+// ============================================================================
+struct GLTFImportResult {
+    GameObject*              root = nullptr;   // named after the file; parent of the scene roots
+    std::vector<GameObject*> nodeObjects;      // per glTF node (null if not in the scene)
+    u32 meshObjects     = 0;
+    u32 skinnedObjects  = 0;
+    u32 animationClips  = 0;
+};
+
+/// Instantiate the document's default scene into `scene`.  `assets`
+/// (optional) loads referenced image files for materials.
+bool ImportGLTFScene(const GLTFDocument& doc, Scene& scene, const std::string& rootName,
+                     GLTFImportResult& result, AssetManager* assets = nullptr);
+
+/// Load `path` and instantiate it (see above).
+bool ImportGLTFScene(const std::string& path, Scene& scene, GLTFImportResult& result,
+                     AssetManager* assets = nullptr);
+
+} // namespace gv
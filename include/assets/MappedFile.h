@@ -0,0 +1,47 @@
+// ============================================================================
+// GameVoid Engine — Memory-Mapped File
+// ============================================================================
+// Read-only view of a whole file via mmap / MapViewOfFile.  Loaders that
+// parse binary containers in place (cooked textures, mesh blobs) use it to
+// avoid copying file contents into heap buffers.
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include <string>
+
+namespace gv {
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept { *this = static_cast<MappedFile&&>(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /// Map `path` read-only.  Returns false if the file can't be opened.
+    /// Empty files open successfully with a null Data().
+    bool Open(const std::string& path);
+    void Close();
+
+    bool        IsOpen() const { return m_Open; }
+    const u8*   Data()   const { return m_Data; }
+    size_t      Size()   const { return m_Size; }
+    const std::string& GetPath() const { return m_Path; }
+
+private:
+    std::string m_Path;
+    const u8*   m_Data = nullptr;
+    size_t      m_Size = 0;
+    bool        m_Open = false;
+#ifdef _WIN32
+    void*       m_File    = nullptr;   // HANDLE
+    void*       m_Mapping = nullptr;   // HANDLE
+#else
+    int         m_Fd = -1;
+#endif
+};
+
+} // namespace gv
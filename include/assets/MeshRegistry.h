@@ -0,0 +1,145 @@
+// ============================================================================
+// GameVoid Engine — Shared Mesh Registry
+// ============================================================================
+// One Mesh (one set of GPU buffers) per distinct generated shape:
+//   • Generated meshes are keyed by generator name + exact parameter bits,
+//     so Generate("box", &Primitives::Box, 0.5f, 0.5f, 0.5f, 0) builds once
+//     and every later call with the same arguments shares that mesh
+//   • Arbitrary MeshData (MeshBuilder output, CSG results, …) is keyed by a
+//     hash of its content; identical geometry shares one mesh whatever its
+//     name
+//   • Meshes are handed out as Shared<Mesh>: the buffers live while any
+//     MeshRenderer holds them.  Entries nobody else references stay cached
+//     up to a byte budget and are evicted least-recently-used first
+// Without a GL context meshes are built CPU-side only, so the registry
+// works (and is counted the same way) in headless runs.
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include "assets/Assets.h"
+#include "geometry/Primitives.h"
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+namespace gv {
+
+enum class PrimitiveType : int;   // renderer/MeshRenderer.h
+class MeshBuilder;
+
+struct MeshRegistryStats {
+    u32 entries    = 0;   // meshes held by the registry
+    u32 referenced = 0;   // of which also held elsewhere
+    u64 hits       = 0;   // acquisitions served from the registry
+    u64 misses     = 0;   // acquisitions that built a mesh
+    u64 evictions  = 0;
+    u64 cpuBytes   = 0;   // vertex + index data of all entries
+    u64 gpuBytes   = 0;   // buffer memory of entries uploaded to the GPU
+    u64 cachedBytes = 0;  // cpuBytes of unreferenced entries
+};
+
+class MeshRegistry {
+public:
+    using Generator = std::function<MeshData()>;
+
+    MeshRegistry() = default;
+    MeshRegistry(const MeshRegistry&) = delete;
+    MeshRegistry& operator=(const MeshRegistry&) = delete;
+
+    // ── Acquisition ────────────────────────────────────────────────────────
+    /// The mesh for `key`, built from `generate` on first use.
+    Shared<Mesh> Acquire(const std::string& key, const Generator& generate);
+
+    /// Call `fn(params...)` through the registry.  The key is `name` plus
+    /// the bit patterns of the arguments after conversion to fn's parameter
+    /// types, so 0.5 and 0.5f are the same key.  Works with any
+    /// MeshData(*)(…) factory — Primitives::*, Shapes::*.
+    template <typename... Params, typename... Args>
+    Shared<Mesh> Generate(const std::string& name, MeshData (*fn)(Params...), Args&&... args) {
+        static_assert(sizeof...(Params) == sizeof...(Args),
+                      "MeshRegistry::Generate: pass every parameter (defaults can't be seen through a pointer)");
+        return GenerateWith(name, fn, static_cast<std::decay_t<Params>>(args)...);
+    }
+
+    /// A mesh with exactly this content, shared with any earlier identical
+    /// data.
+    Shared<Mesh> AcquireData(const MeshData& data);
+
+    /// MeshBuilder output, shared like AcquireData().
+    Shared<Mesh> AcquireBuilt(const MeshBuilder& builder, const std::string& name = "Mesh");
+
+    /// Mesh::CreateCube / CreateSphere / CreatePlane / CreateQuad /
+    /// CreateTriangle, shared.
+    Shared<Mesh> Cube();
+    Shared<Mesh> Sphere(u32 segments = 32, u32 rings = 16);
+    Shared<Mesh> Plane(f32 width = 10.0f, f32 depth = 10.0f);
+    Shared<Mesh> Quad();
+    Shared<Mesh> Triangle();
+    /// The unit mesh the renderer draws for a MeshRenderer primitive (null
+    /// for PrimitiveType::None).
+    Shared<Mesh> Primitive(PrimitiveType type);
+
+    // ── Inspection ─────────────────────────────────────────────────────────
+    bool Contains(const std::string& key) const { return m_Entries.count(key) != 0; }
+    /// References held outside the registry (0 = cached only, -1 = absent).
+    i32 GetRefCount(const std::string& key) const;
+    MeshRegistryStats GetStats() const;
+
+    /// Key Generate() uses for these (already converted) arguments.
+    template <typename... Params>
+    static std::string MakeKey(const std::string& name, const Params&... params) {
+        static_assert((std::is_trivially_copyable<Params>::value && ...),
+                      "MeshRegistry keys are built from plain-data parameters");
+        std::string key = name;
+        key += '(';
+        int dummy[] = { 0, (AppendKeyPart(key, &params, sizeof(Params)), 0)... };
+        (void)dummy;
+        key += ')';
+        return key;
+    }
+
+    // ── Eviction ───────────────────────────────────────────────────────────
+    /// Bytes of unreferenced meshes kept for reuse (default 32 MB; 0 drops
+    /// them as soon as eviction runs).  Checked after each new mesh.
+    void SetCacheBudget(u64 bytes) { m_CacheBudget = bytes; }
+    u64  GetCacheBudget() const    { return m_CacheBudget; }
+    /// Drop every entry nobody else references.  Returns the count dropped.
+    u32 EvictUnreferenced();
+    /// Drop unreferenced entries, least recently acquired first, until the
+    /// cached bytes fit the budget.
+    u32 Trim();
+    /// Forget everything.  Meshes still held elsewhere stay alive there.
+    void Clear();
+
+    /// MeshData → Mesh vertices, with per-vertex tangents from the UVs.
+    static void ConvertVertices(const MeshData& data, std::vector<Vertex>& out);
+    /// FNV-1a over positions, normals, UVs and indices (the name is ignored).
+    static u64 HashContent(const MeshData& data);
+
+private:
+    struct Entry {
+        Shared<Mesh> mesh;
+        u64 contentHash = 0;    // AcquireData entries only
+        u64 lastUse = 0;
+    };
+
+    template <typename Fn, typename... Params>
+    Shared<Mesh> GenerateWith(const std::string& name, Fn fn, const Params&... params) {
+        return Acquire(MakeKey(name, params...), [&]() { return fn(params...); });
+    }
+
+    static void AppendKeyPart(std::string& key, const void* bytes, size_t size);
+    static Shared<Mesh> BuildMesh(const MeshData& data);
+    Shared<Mesh> AcquireMesh(const std::string& key, const std::function<Shared<Mesh>()>& build);
+    Shared<Mesh> Insert(const std::string& key, Shared<Mesh> mesh, u64 contentHash);
+    Shared<Mesh> Hit(Entry& entry);
+
+    std::unordered_map<std::string, Entry> m_Entries;
+    u64 m_Clock = 0;
+    u64 m_CacheBudget = 32ull * 1024 * 1024;
+    u64 m_Hits = 0, m_Misses = 0, m_Evictions = 0;
+};
+
+} // namespace gv
@@ -0,0 +1,73 @@
+// ============================================================================
+// GameVoid Engine — Meshlets
+// ============================================================================
+// Splits a triangle list into small clusters ("meshlets") that can be culled
+// individually:
+//   • Greedy growth from a seed triangle, preferring neighbours that add no
+//     new vertices, then ones close to the cluster and facing the same way;
+//     when a cluster runs out of neighbours it continues with the nearest
+//     free triangle (uniform grid), so disconnected pieces still share
+//     clusters
+//   • Default limits of 64 vertices / 124 triangles
+//   • Per-meshlet bounding sphere and normal cone (apex + axis + cutoff) for
+//     frustum and backface rejection
+//   • The index buffer is rewritten meshlet by meshlet, so every meshlet is
+//     one contiguous index range and a visible set can be drawn with a single
+//     multi-draw call
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include "core/Math.h"
+#include <vector>
+
+namespace gv {
+
+struct MeshletBuildSettings {
+    u32 maxVertices  = 64;      // clamped to 255 (local indices are u8)
+    u32 maxTriangles = 124;     // clamped to 512
+    f32 coneWeight   = 0.5f;    // 0 = pure locality, higher = tighter normal cones
+};
+
+struct Meshlet {
+    u32  vertexOffset  = 0;     // into MeshletData::vertices
+    u32  vertexCount   = 0;
+    u32  triangleOffset = 0;    // into MeshletData::triangles (in triangles, 3 bytes each)
+    u32  triangleCount = 0;
+    u32  firstIndex    = 0;     // into the reordered index buffer (= triangleOffset * 3)
+    u32  indexCount    = 0;
+
+    Vec3 center { 0, 0, 0 };    // bounding sphere (mesh space)
+    f32  radius = 0.0f;
+    Vec3 coneApex { 0, 0, 0 };  // normal cone; see MeshletBackfacing()
+    Vec3 coneAxis { 0, 0, 1 };
+    f32  coneCutoff = 1.0f;     // >= 1 means the cone is too wide to ever cull
+};
+
+struct MeshletData {
+    std::vector<Meshlet> meshlets;
+    std::vector<u32>     vertices;    // meshlet-local vertex → mesh vertex index
+    std::vector<u8>      triangles;   // 3 meshlet-local vertex indices per triangle
+
+    bool Empty() const { return meshlets.empty(); }
+    void Clear() { meshlets.clear(); vertices.clear(); triangles.clear(); }
+};
+
+/// Partition a triangle list.  `positions` points at the first vertex's
+/// position (three floats), `positionStride` is the byte distance between
+/// vertices.  `outIndices` receives the index buffer in meshlet order (it
+/// must not alias `indices`).  Triangles with out-of-range indices are
+/// dropped.
+void BuildMeshlets(const std::vector<u32>& indices, const f32* positions, size_t vertexCount,
+                   size_t positionStride, MeshletData& out, std::vector<u32>& outIndices,
+                   const MeshletBuildSettings& settings = MeshletBuildSettings());
+
+/// True if every triangle of `m` faces away from `viewPos` (mesh space).
+inline bool MeshletBackfacing(const Meshlet& m, const Vec3& viewPos) {
+    if (m.coneCutoff >= 1.0f) return false;
+    Vec3 d = m.coneApex - viewPos;
+    f32 len = d.Length();
+    return len > 1e-8f && d.Dot(m.coneAxis) >= m.coneCutoff * len;
+}
+
+} // namespace gv
@@ -0,0 +1,167 @@
+// ============================================================================
+// GameVoid Engine — Texture Cooker
+// ============================================================================
+// Turns source images into GPU-ready data once, so the runtime never decodes
+// PNG/JPG or builds mips on load:
+//   • Mip chains filtered in linear light (sRGB textures) or with
+//     renormalised vectors (normal maps), box or Kaiser filter
+//   • Block compression: BC1 (RGB), BC3 (RGBA), BC4 (R), BC5 (RG normals),
+//     BC7 (mode 6, RGBA) — encoded on worker threads
+//   • CPU decoders for every format, plus PSNR, so cooking can be verified
+//     without a GPU
+//   • ".gvtx" container: header, level table and 16-byte-aligned level data
+//     that CookedTextureView maps straight from disk
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include "assets/MappedFile.h"
+#include <string>
+#include <vector>
+
+namespace gv {
+
+enum class TextureFormat : u32 {
+    RGBA8 = 0,
+    BC1   = 1,   // RGB, 4 bpp
+    BC3   = 2,   // RGBA (BC1 colour + BC4 alpha), 8 bpp
+    BC4   = 3,   // single channel, 4 bpp
+    BC5   = 4,   // two channels (normal-map XY), 8 bpp
+    BC7   = 5,   // RGBA, 8 bpp (encoder emits mode 6)
+};
+
+const char* TextureFormatName(TextureFormat fmt);
+bool        IsBlockCompressed(TextureFormat fmt);
+
+enum class MipFilter { Box, Kaiser };
+
+/// Uncompressed 8-bit RGBA image, rows top to bottom.
+struct ImageRGBA8 {
+    u32             width  = 0;
+    u32             height = 0;
+    std::vector<u8> pixels;   // width * height * 4
+
+    ImageRGBA8() = default;
+    ImageRGBA8(u32 w, u32 h) : width(w), height(h), pixels(static_cast<size_t>(w) * h * 4, 0) {}
+    u8*       At(u32 x, u32 y)       { return &pixels[(static_cast<size_t>(y) * width + x) * 4]; }
+    const u8* At(u32 x, u32 y) const { return &pixels[(static_cast<size_t>(y) * width + x) * 4]; }
+};
+
+struct TextureCookSettings {
+    /// RGBA8 = no compression.  Use PickFormat() for the usual choice.
+    TextureFormat format       = TextureFormat::BC7;
+    bool          srgb         = true;    // colour data; mips are filtered in linear light
+    bool          normalMap    = false;   // renormalise mips; implies !srgb
+    bool          generateMips = true;
+    MipFilter     filter       = MipFilter::Kaiser;
+    bool          wrap         = true;    // filter taps wrap (tiling textures) or clamp
+    u32           threads      = 0;       // 0 = hardware concurrency
+};
+
+/// One cooked mip level.
+struct CookedLevel {
+    u32             width  = 0;
+    u32             height = 0;
+    std::vector<u8> data;
+};
+
+struct CookedTexture {
+    TextureFormat            format = TextureFormat::RGBA8;
+    u32                      width  = 0;
+    u32                      height = 0;
+    u32                      flags  = 0;   // see kFlag*
+    std::vector<CookedLevel> levels;
+
+    static constexpr u32 kFlagSRGB      = 1u << 0;
+    static constexpr u32 kFlagNormalMap = 1u << 1;
+    static constexpr u32 kFlagHasAlpha  = 1u << 2;
+
+    bool Save(const std::string& path) const;
+};
+
+/// Zero-copy view of a .gvtx file.  Level pointers point into the mapping
+/// and stay valid while the view is open.
+class CookedTextureView {
+public:
+    struct Level {
+        u32       width  = 0;
+        u32       height = 0;
+        const u8* data   = nullptr;
+        size_t    size   = 0;
+    };
+
+    bool Open(const std::string& path);
+    /// Parse an in-memory container (no mapping; `data` must outlive the view).
+    bool Parse(const u8* data, size_t size);
+    void Close();
+
+    bool          IsOpen()        const { return !m_Levels.empty(); }
+    TextureFormat GetFormat()     const { return m_Format; }
+    u32           GetWidth()      const { return m_Width; }
+    u32           GetHeight()     const { return m_Height; }
+    u32           GetFlags()      const { return m_Flags; }
+    u32           GetLevelCount() const { return static_cast<u32>(m_Levels.size()); }
+    const Level&  GetLevel(u32 i) const { return m_Levels[i]; }
+
+private:
+    MappedFile         m_File;
+    TextureFormat      m_Format = TextureFormat::RGBA8;
+    u32                m_Width = 0, m_Height = 0, m_Flags = 0;
+    std::vector<Level> m_Levels;
+};
+
+class TextureCooker {
+public:
+    // ── Mips ───────────────────────────────────────────────────────────────
+    /// Full chain down to 1x1, level 0 = `base`.
+    static std::vector<ImageRGBA8> BuildMipChain(const ImageRGBA8& base,
+                                                 const TextureCookSettings& settings);
+
+    /// One level: half size (rounded down, min 1).
+    static ImageRGBA8 Downsample(const ImageRGBA8& src, const TextureCookSettings& settings);
+
+    // ── Block compression ──────────────────────────────────────────────────
+    static size_t EncodedSize(u32 width, u32 height, TextureFormat fmt);
+
+    /// Encode one level.  Partial edge blocks replicate the last row/column.
+    static std::vector<u8> Encode(const ImageRGBA8& image, TextureFormat fmt, u32 threads = 0);
+
+    /// Decode one level to RGBA8.  BC4 decodes to grey (R=G=B), BC5 to RG
+    /// with B reconstructed as a unit normal's Z.
+    static bool Decode(const u8* data, size_t size, u32 width, u32 height,
+                       TextureFormat fmt, ImageRGBA8& out);
+
+    /// Single-block codecs (16 RGBA texels in, 8 or 16 bytes out).
+    static void EncodeBlockBC1(const u8 rgba[64], u8 out[8]);
+    static void EncodeBlockBC3(const u8 rgba[64], u8 out[16]);
+    static void EncodeBlockBC4(const u8 values[16], u8 out[8]);
+    static void EncodeBlockBC5(const u8 rgba[64], u8 out[16]);
+    static void EncodeBlockBC7(const u8 rgba[64], u8 out[16]);
+    static void DecodeBlockBC1(const u8 in[8], u8 rgba[64], bool forceFourColour = false);
+    static void DecodeBlockBC4(const u8 in[8], u8 values[16]);
+    static bool DecodeBlockBC7(const u8 in[16], u8 rgba[64]);
+
+    // ── Whole textures ─────────────────────────────────────────────────────
+    /// Mips + encode.
+    static bool Cook(const ImageRGBA8& image, const TextureCookSettings& settings, CookedTexture& out);
+
+    /// Decode an image file, cook it and write a .gvtx.  Needs the image
+    /// decoder (window builds).  `flipY` matches Texture::Load's convention.
+    static bool CookFile(const std::string& srcPath, const std::string& dstPath,
+                         const TextureCookSettings& settings, bool flipY = true);
+
+    /// Usual compressed format for an image: BC7 for normal maps (the PBR
+    /// shader reads .xyz, so BC5's two channels would need a shader change),
+    /// BC1 if fully opaque, otherwise BC3 (BC7 when `highQuality`).
+    static TextureFormat PickFormat(const ImageRGBA8& image, bool normalMap, bool highQuality = false);
+
+    /// Filename heuristic for normal maps ("_n", "_nrm", "_normal", ...).
+    static bool LooksLikeNormalMap(const std::string& path);
+
+    // ── Quality ────────────────────────────────────────────────────────────
+    /// PSNR in dB over the channels in `channelMask` (bit 0 = R ... bit 3 = A).
+    /// Identical images return +infinity.
+    static f64 PSNR(const ImageRGBA8& a, const ImageRGBA8& b, u32 channelMask = 0x7);
+};
+
+} // namespace gv
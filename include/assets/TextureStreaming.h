@@ -0,0 +1,246 @@
+// ============================================================================
+// GameVoid Engine — Texture Streaming
+// ============================================================================
+// Keeps cooked (.gvtx) textures partially resident:
+//   • Each frame the renderer reports how large each textured object appears
+//     on screen; that picks the finest mip the texture actually needs.
+//   • The small mip tail (≤ tailSize) is uploaded at registration and never
+//     evicted, so a texture always has something to sample — the finest
+//     resident level is the fallback while higher mips load.
+//   • Higher mips are read from the mapped container on a worker thread and
+//     uploaded on the main thread, a few megabytes per frame.
+//   • Resident bytes stay under a fixed budget: least-recently-seen textures
+//     give their top mips back first.
+//
+// All GPU work goes through TextureStreamBackend.  The residency heuristics
+// and budget accounting are plain CPU code and run the same against
+// RecordingTextureStreamBackend (no GL) as against the GL backend.
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include "core/Math.h"
+#include "assets/TextureCooker.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace gv {
+
+// ============================================================================
+// Backend
+// ============================================================================
+/// One level handed to the backend.  `data` may be null for synthetic
+/// textures (no source file).
+struct StreamLevelData {
+    u32       width  = 0;
+    u32       height = 0;
+    const u8* data   = nullptr;
+    size_t    size   = 0;
+};
+
+class TextureStreamBackend {
+public:
+    virtual ~TextureStreamBackend() = default;
+    /// Allocate a texture name.  Returns 0 on failure.
+    virtual u32  Create() = 0;
+    /// Replace the texture's storage with `levels` (levels[0] becomes GL
+    /// level 0).  The name stays the same, so materials holding it keep
+    /// working across residency changes.
+    virtual void Upload(u32 handle, TextureFormat fmt, const std::vector<StreamLevelData>& levels) = 0;
+    virtual void Destroy(u32 handle) = 0;
+};
+
+/// GL implementation (compressed upload, CPU decode when the driver lacks
+/// the format).  Returns null in builds without GL.
+Unique<TextureStreamBackend> CreateGLTextureStreamBackend();
+
+/// Upload `levels` into GL texture `texture` as levels 0..n-1 and set its
+/// mip range and filtering.  Returns false if the driver rejected the
+/// compressed format and the levels were decoded to RGBA8 instead.
+bool UploadTextureLevels(u32 texture, TextureFormat fmt, const std::vector<StreamLevelData>& levels);
+
+/// Backend that only records what it was asked to do.  Used for headless
+/// runs and for checking the streamer's accounting.
+class RecordingTextureStreamBackend : public TextureStreamBackend {
+public:
+    struct Op {
+        enum Type { Create, Upload, Destroy } type;
+        u32    handle;
+        u32    levelCount;   // Upload: number of levels, level 0 = finest
+        u32    topWidth;     // Upload: width of level 0
+        size_t bytes;        // Upload: sum of level sizes
+    };
+
+    u32 Create() override {
+        u32 h = ++m_Next;
+        m_Ops.push_back({ Op::Create, h, 0, 0, 0 });
+        m_Bytes[h] = 0;
+        return h;
+    }
+    void Upload(u32 handle, TextureFormat, const std::vector<StreamLevelData>& levels) override {
+        size_t bytes = 0;
+        for (auto& l : levels) bytes += l.size;
+        m_Ops.push_back({ Op::Upload, handle, static_cast<u32>(levels.size()),
+                          levels.empty() ? 0u : levels[0].width, bytes });
+        m_Bytes[handle] = bytes;
+    }
+    void Destroy(u32 handle) override {
+        m_Ops.push_back({ Op::Destroy, handle, 0, 0, 0 });
+        m_Bytes.erase(handle);
+    }
+
+    const std::vector<Op>& GetOps() const { return m_Ops; }
+    void   ClearOps() { m_Ops.clear(); }
+    /// Bytes currently allocated across all textures (what VRAM would hold).
+    size_t GetAllocatedBytes() const {
+        size_t total = 0;
+        for (auto& kv : m_Bytes) total += kv.second;
+        return total;
+    }
+
+private:
+    u32                                m_Next = 0;
+    std::vector<Op>                    m_Ops;
+    std::unordered_map<u32, size_t>    m_Bytes;
+};
+
+// ============================================================================
+// Streamer
+// ============================================================================
+struct TextureStreamSettings {
+    size_t budgetBytes      = 256ull * 1024 * 1024;
+    u32    tailSize         = 64;      // levels this size or smaller are always resident
+    size_t uploadBytesPerFrame = 16ull * 1024 * 1024;   // at least one load is applied per frame
+    f32    lodBias          = 0.0f;    // + = coarser
+    u32    workerThreads    = 1;       // 0 = load inline (completes on the next Update)
+};
+
+struct TextureStreamStats {
+    u32    textures        = 0;
+    size_t residentBytes   = 0;        // includes the always-resident tails
+    size_t pendingBytes    = 0;        // reserved by loads in flight
+    size_t budgetBytes     = 0;
+    u32    loadsInFlight   = 0;
+    u64    loadsIssued     = 0;
+    u64    loadsApplied    = 0;
+    u64    evictions       = 0;
+    u64    deferred        = 0;        // requests trimmed or skipped for budget
+    size_t uploadedBytesLastFrame = 0;
+};
+
+class TextureStreamer {
+public:
+    explicit TextureStreamer(TextureStreamBackend* backend,
+                             const TextureStreamSettings& settings = {});
+    ~TextureStreamer();
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    // ── Registration ───────────────────────────────────────────────────────
+    /// Map a .gvtx file and upload its mip tail.  Returns the texture handle
+    /// (a GL name with the GL backend), or 0 on failure.
+    u32 Register(const std::string& cookedPath);
+    /// Texture with no source data — only sizes.  For headless runs.
+    u32 RegisterSynthetic(const std::string& name, TextureFormat fmt, u32 width, u32 height);
+    void Unregister(u32 handle);
+    /// Unregister everything.  Queued loads are dropped; loads a worker is
+    /// already reading are waited for, so none lands afterwards.
+    void Clear();
+
+    bool IsStreamed(u32 handle) const { return m_Textures.count(handle) != 0; }
+
+    // ── Per-frame ──────────────────────────────────────────────────────────
+    /// Report that `handle` covers about `screenPixels` pixels across this
+    /// frame.  Several requests for one texture keep the largest.
+    void Request(u32 handle, f32 screenPixels);
+
+    /// Resolve this frame's requests: apply finished loads, evict, issue
+    /// new loads.  Call once per frame after all Request() calls.
+    void Update();
+
+    // ── Heuristics (pure) ──────────────────────────────────────────────────
+    /// Projected diameter in pixels of a bounding sphere.
+    static f32 ProjectedSize(const Vec3& centre, f32 radius, const Vec3& cameraPos,
+                             f32 fovYDegrees, f32 viewportHeight);
+    /// Finest mip needed to draw a `texWidth`×`texHeight` texture across
+    /// `screenPixels` pixels, clamped to [0, coarsest].
+    static u32 DesiredLevel(u32 texWidth, u32 texHeight, f32 screenPixels, f32 lodBias, u32 coarsest);
+
+    // ── Queries ────────────────────────────────────────────────────────────
+    u32  GetResidentLevel(u32 handle) const;   // finest resident mip (0 = full res)
+    u32  GetWantedLevel(u32 handle) const;
+    u32  GetLevelCount(u32 handle) const;
+    u32  GetWidth(u32 handle) const;
+    u32  GetHeight(u32 handle) const;
+    bool IsLoading(u32 handle) const;
+    TextureStreamStats GetStats() const;
+
+    void SetBudget(size_t bytes) { m_Settings.budgetBytes = bytes; }
+    const TextureStreamSettings& GetSettings() const { return m_Settings; }
+
+private:
+    struct LevelInfo { u32 width, height; size_t bytes; };
+
+    struct Entry {
+        u32                            handle = 0;
+        std::string                    name;
+        Shared<CookedTextureView>      view;     // null for synthetic textures
+        TextureFormat                  format = TextureFormat::RGBA8;
+        std::vector<LevelInfo>         levels;
+        u32                            tailLevel = 0;   // levels [tailLevel, end) are never evicted
+        u32                            resident  = 0;   // finest resident level
+        u32                            wanted    = 0;
+        f32                            requested = 0.0f;  // largest screen size this frame
+        u64                            lastSeen  = 0;
+        bool                           loading   = false;
+        u32                            loadTarget = 0;
+        size_t                         reserved  = 0;
+        u64                            generation = 0;
+    };
+
+    struct Job {
+        u32                       handle;
+        u64                       generation;
+        u32                       first, last;   // levels [first, last) to stage
+        Shared<CookedTextureView> view;
+        std::vector<std::vector<u8>> staged;
+    };
+
+    u32    Add(Entry&& e);
+    size_t Bytes(const Entry& e, u32 first, u32 last) const;
+    /// Re-upload levels [level, end), taking levels from `staged` (which
+    /// starts at `stagedFirst`) where present and from the mapping otherwise.
+    /// Updates residency and accounting.
+    void   ApplyResidency(Entry& e, u32 level, u32 stagedFirst, const std::vector<std::vector<u8>>* staged);
+    bool   EvictOne(u32 exceptHandle);
+    void   Issue(Entry& e, u32 target);
+    void   ApplyCompleted();
+    static void Stage(Job& job);
+    void   WorkerLoop();
+
+    TextureStreamBackend*            m_Backend;
+    TextureStreamSettings            m_Settings;
+    std::unordered_map<u32, Entry>   m_Textures;
+    u64                              m_Frame = 0;
+    u64                              m_NextGeneration = 1;
+    size_t                           m_ResidentBytes = 0;
+    size_t                           m_PendingBytes = 0;
+    TextureStreamStats               m_Stats;
+
+    // Worker
+    std::vector<std::thread>         m_Workers;
+    std::mutex                       m_Mutex;
+    std::condition_variable          m_CV;
+    std::condition_variable          m_Idle;      // signalled when a worker finishes a job
+    std::deque<Job>                  m_Jobs;
+    std::deque<Job>                  m_Done;
+    u32                              m_Staging = 0;   // jobs a worker is staging right now
+    bool                             m_Stop = false;
+};
+
+} // namespace gv
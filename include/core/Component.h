@@ -14,6 +14,8 @@ namespace gv {
 
 // Forward declaration — defined in GameObject.h
 class GameObject;
+class SaveWriter;
+class SaveReader;
 
 class Component {
 public:
@@ -26,11 +28,33 @@ public:
     virtual void OnRender()  {}           // Called during the render pass
     virtual void OnStart()   {}           // Called on the first frame
 
+    /// Called on the other components of the owner after one is added or
+    /// removed, so pointers cached to siblings can be refreshed.
+    virtual void OnComponentAdded(Component* /*added*/)     {}
+    virtual void OnComponentRemoved(Component* /*removed*/) {}
+
     // ── Identification ─────────────────────────────────────────────────────
     /// Each derived class should return a unique type name for serialisation
     /// and editor display.  Override in subclasses.
     virtual std::string GetTypeName() const { return "Component"; }
 
+    // ── Play-mode snapshot ─────────────────────────────────────────────────
+    /// Copy of the runtime state play mode may change, or nullptr if there is
+    /// nothing to restore.  Implement with GV_SNAPSHOT_COMPONENT(Type).
+    virtual Unique<Component> SaveState() const { return nullptr; }
+    virtual void LoadState(const Component& /*saved*/) {}
+
+    /// False for data-only components whose OnUpdate() never changes the
+    /// owner; objects made only of these are skipped by play-mode snapshots.
+    virtual bool UpdatesOwner() const { return true; }
+
+    // ── Save games ─────────────────────────────────────────────────────────
+    /// State kept in save games.  Only called for types registered with
+    /// SaveRegistry::RegisterComponent (see core/SaveGame.h); ReadSave gets
+    /// data already migrated to the registered version.
+    virtual void WriteSave(SaveWriter& /*out*/) const {}
+    virtual void ReadSave(SaveReader& /*in*/) {}
+
     // ── Owner ──────────────────────────────────────────────────────────────
     void        SetOwner(GameObject* owner) { m_Owner = owner; }
     GameObject* GetOwner() const            { return m_Owner; }
@@ -45,3 +69,12 @@ protected:
 };
 
 } // namespace gv
+
+/// Gives a copyable component play-mode snapshot support by value copy.
+#define GV_SNAPSHOT_COMPONENT(Type)                                              \
+    ::gv::Unique<::gv::Component> SaveState() const override {                   \
+        return ::gv::MakeUnique<Type>(*this);                                    \
+    }                                                                            \
+    void LoadState(const ::gv::Component& saved) override {                      \
+        *this = static_cast<const Type&>(saved);                                 \
+    }
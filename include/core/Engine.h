@@ -34,7 +34,10 @@ struct EngineConfig {
     bool enablePhysics   = true;
     bool enableScripting = true;
     bool enableAI        = true;
+    bool enableTextureStreaming = true;   // cooked textures stream their mips
+    u32  textureBudgetMB = 256;           // streaming VRAM budget
     std::string geminiAPIKey;       // optional – set via editor or config file
+    std::string scriptDebugAddress; // --script-debug-listen: script debugger server
 };
 
 /// The root object that boots every subsystem and runs the main loop.
@@ -0,0 +1,71 @@
+// ============================================================================
+// GameVoid Engine — File Watcher
+// ============================================================================
+// Reports files that changed on disk, once their writes have settled:
+//   • Linux: inotify on each watched file's directory, so editors that save
+//     by writing a temp file and renaming it over the original are seen
+//   • Elsewhere (or if inotify is unavailable): polls last-write time and
+//     size every PollInterval seconds
+//   • Debounce: a file is reported only after no change was seen for
+//     Debounce seconds, so a burst of writes yields one report
+// Time is whatever the caller passes to Poll(), so a simulated clock gives
+// deterministic results.
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace gv {
+
+class FileWatcher {
+public:
+    FileWatcher();
+    ~FileWatcher();
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /// Start watching a file (it need not exist yet).  Paths are compared
+    /// after normalisation, so "a/./b.gvs" and "a/b.gvs" are one file.
+    void Watch(const std::string& path);
+    void Unwatch(const std::string& path);
+    bool IsWatching(const std::string& path) const;
+    void Clear();
+
+    /// Files whose changes settled by `now` (seconds, any monotonic clock).
+    std::vector<std::string> Poll(f64 now);
+
+    void SetDebounce(f64 seconds)     { m_Debounce = seconds; }
+    void SetPollInterval(f64 seconds) { m_PollInterval = seconds; }
+    /// Use stat polling even where inotify is available.
+    void ForcePolling(bool force);
+    bool UsingInotify() const { return m_InotifyFD >= 0; }
+
+    static std::string Normalise(const std::string& path);
+
+private:
+    struct Entry {
+        i64  stamp = -1;        // last-write time, -1 if missing
+        i64  size  = -1;
+        bool dirty = false;
+        f64  lastChange = 0;
+    };
+
+    void ScanStamps(f64 now);
+    void ReadInotify(f64 now);
+    void AddDirWatch(const std::string& dir);
+    void RemoveUnusedDirWatches();
+
+    std::unordered_map<std::string, Entry> m_Files;
+    std::unordered_map<int, std::string>   m_DirByWD;    // inotify watch → directory
+    std::unordered_map<std::string, int>   m_WDByDir;
+    int  m_InotifyFD = -1;
+    bool m_ForcePolling = false;
+    f64  m_Debounce = 0.1;
+    f64  m_PollInterval = 0.5;
+    f64  m_LastScan = -1e300;
+};
+
+} // namespace gv
@@ -53,6 +53,7 @@ typedef unsigned short GLushort;
 typedef void           GLvoid;
 typedef ptrdiff_t      GLsizeiptr;
 typedef ptrdiff_t      GLintptr;
+typedef unsigned long long GLuint64;
 
 // ── GL constants ───────────────────────────────────────────────────────────
 #define GL_FALSE                    0
@@ -105,6 +106,11 @@ typedef ptrdiff_t      GLintptr;
 #define GL_LINK_STATUS              0x8B82
 #define GL_INFO_LOG_LENGTH          0x8B84
 
+// Program binaries (GL 4.1 / ARB_get_program_binary)
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH           0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS      0x87FE
+
 // Buffer targets
 #define GL_ARRAY_BUFFER             0x8892
 #define GL_ELEMENT_ARRAY_BUFFER     0x8893
@@ -163,6 +169,15 @@ typedef ptrdiff_t      GLintptr;
 #define GL_RGBA                     0x1908
 #define GL_RGB8                     0x8051
 #define GL_RGBA8                    0x8058
+#define GL_TEXTURE_BASE_LEVEL       0x813C
+#define GL_TEXTURE_MAX_LEVEL        0x813D
+
+// Block-compressed texture formats (cooked .gvtx textures)
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT   0x83F0
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT  0x83F3
+#define GL_COMPRESSED_RED_RGTC1           0x8DBB
+#define GL_COMPRESSED_RG_RGTC2            0x8DBD
+#define GL_COMPRESSED_RGBA_BPTC_UNORM     0x8E8C
 
 // Framebuffer
 #define GL_FRAMEBUFFER              0x8D40
@@ -193,6 +208,11 @@ typedef ptrdiff_t      GLintptr;
 #define GL_CLAMP_TO_BORDER          0x812D
 #define GL_TEXTURE_BORDER_COLOR     0x1004
 
+// Timer queries (GPU frame timing)
+#define GL_TIME_ELAPSED             0x88BF
+#define GL_QUERY_RESULT             0x8866
+#define GL_QUERY_RESULT_AVAILABLE   0x8867
+
 // Shadow mapping
 #define GL_DEPTH_COMPONENT          0x1902
 #define GL_DEPTH_COMPONENT16        0x81A5
@@ -353,6 +373,30 @@ typedef void   (APIENTRY *PFN_glVertexAttribIPointer)(GLuint index, GLint size,
 // Multiple render targets (deferred rendering)
 typedef void   (APIENTRY *PFN_glDrawBuffers)(GLsizei n, const GLenum* bufs);
 
+// Program binaries (optional — ShaderLibrary's on-disk cache)
+typedef void   (APIENTRY *PFN_glGetProgramBinary)(GLuint program, GLsizei bufSize, GLsizei* length,
+                                                   GLenum* binaryFormat, void* binary);
+typedef void   (APIENTRY *PFN_glProgramBinary)(GLuint program, GLenum binaryFormat,
+                                                const void* binary, GLsizei length);
+typedef void   (APIENTRY *PFN_glProgramParameteri)(GLuint program, GLenum pname, GLint value);
+
+// Compressed texture upload (cooked textures)
+typedef void   (APIENTRY *PFN_glCompressedTexImage2D)(GLenum target, GLint level, GLenum internalformat,
+                                                       GLsizei width, GLsizei height, GLint border,
+                                                       GLsizei imageSize, const void* data);
+
+// Multi-draw (meshlet ranges in one call)
+typedef void   (APIENTRY *PFN_glMultiDrawElements)(GLenum mode, const GLsizei* count, GLenum type,
+                                                    const void* const* indices, GLsizei drawcount);
+
+// Timer queries (optional — dynamic resolution's GPU frame time)
+typedef void   (APIENTRY *PFN_glGenQueries)(GLsizei n, GLuint* ids);
+typedef void   (APIENTRY *PFN_glDeleteQueries)(GLsizei n, const GLuint* ids);
+typedef void   (APIENTRY *PFN_glBeginQuery)(GLenum target, GLuint id);
+typedef void   (APIENTRY *PFN_glEndQuery)(GLenum target);
+typedef void   (APIENTRY *PFN_glGetQueryObjectiv)(GLuint id, GLenum pname, GLint* params);
+typedef void   (APIENTRY *PFN_glGetQueryObjectui64v)(GLuint id, GLenum pname, GLuint64* params);
+
 // ── Extern function pointers ───────────────────────────────────────────────
 
 // Shaders
@@ -432,6 +476,25 @@ extern PFN_glVertexAttribIPointer     glVertexAttribIPointer;
 // MRT draw buffers
 extern PFN_glDrawBuffers              glDrawBuffers;
 
+// Program binaries (may be null on drivers without GL 4.1 / ARB_get_program_binary)
+extern PFN_glGetProgramBinary         glGetProgramBinary;
+extern PFN_glProgramBinary            glProgramBinary;
+extern PFN_glProgramParameteri        glProgramParameteri;
+
+// Compressed texture upload (null if unavailable; cooked textures decode on the CPU)
+extern PFN_glCompressedTexImage2D     glCompressedTexImage2D;
+
+// Multi-draw (null if unavailable; meshlet ranges are then drawn one by one)
+extern PFN_glMultiDrawElements        glMultiDrawElements;
+
+// Timer queries (null if unavailable; dynamic resolution then uses CPU frame time)
+extern PFN_glGenQueries               glGenQueries;
+extern PFN_glDeleteQueries            glDeleteQueries;
+extern PFN_glBeginQuery               glBeginQuery;
+extern PFN_glEndQuery                 glEndQuery;
+extern PFN_glGetQueryObjectiv         glGetQueryObjectiv;
+extern PFN_glGetQueryObjectui64v      glGetQueryObjectui64v;
+
 // ── Loader ─────────────────────────────────────────────────────────────────
 /// Load all GL 2.0+ / 3.3 function pointers.
 /// Must be called AFTER a valid OpenGL context is made current
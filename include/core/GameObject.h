@@ -13,6 +13,19 @@
 
 namespace gv {
 
+class GameObject;
+
+/// Told about component changes so play mode can undo them (PlaySnapshot).
+class ComponentJournal {
+public:
+    virtual ~ComponentJournal() = default;
+    /// `added` has just been attached to `obj`.
+    virtual void OnComponentAdded(GameObject* obj, Component* added) = 0;
+    /// `removed` has just been detached from `obj`, where it sat at `index`.
+    /// The journal may keep it alive to put back later.
+    virtual void OnComponentRemoved(GameObject* obj, Unique<Component> removed, size_t index) = 0;
+};
+
 class GameObject {
 public:
     /// Construct a named game object at the origin.
@@ -38,9 +51,8 @@ public:
         static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
         auto comp = MakeUnique<T>(std::forward<Args>(args)...);
         T* raw = comp.get();
-        raw->SetOwner(this);
-        raw->OnAttach();
-        m_Components.push_back(std::move(comp));
+        Attach(std::move(comp), m_Components.size());
+        if (m_Journal) m_Journal->OnComponentAdded(this, raw);
         return raw;
     }
 
@@ -59,8 +71,9 @@ public:
     bool RemoveComponent() {
         for (auto it = m_Components.begin(); it != m_Components.end(); ++it) {
             if (dynamic_cast<T*>(it->get())) {
-                (*it)->OnDetach();
-                m_Components.erase(it);
+                const size_t index = static_cast<size_t>(it - m_Components.begin());
+                Unique<Component> removed = Detach(it);
+                if (m_Journal) m_Journal->OnComponentRemoved(this, std::move(removed), index);
                 return true;
             }
         }
@@ -115,7 +128,55 @@ public:
     bool IsActive() const        { return m_Active; }
     void SetActive(bool active)  { m_Active = active; }
 
+    // ── Play-mode snapshot bookkeeping (see PlaySnapshot) ──────────────────
+    u32  GetSnapshotEpoch() const  { return m_SnapshotEpoch; }
+    void SetSnapshotEpoch(u32 e)   { m_SnapshotEpoch = e; }
+
+    /// Where AddComponent / RemoveComponent report to (set by the owning
+    /// scene; nullptr for none).
+    void SetComponentJournal(ComponentJournal* journal) { m_Journal = journal; }
+
+    /// Put back a component removed during play at its old `index`.  Not
+    /// reported to the journal.
+    void RestoreComponent(Unique<Component> comp, size_t index) {
+        Attach(std::move(comp), std::min(index, m_Components.size()));
+    }
+
+    /// Detach and destroy `comp` (one added during play).  Not reported to
+    /// the journal.  Returns false if it is not attached here.
+    bool DiscardComponent(Component* comp) {
+        auto it = std::find_if(m_Components.begin(), m_Components.end(),
+            [comp](const Unique<Component>& c) { return c.get() == comp; });
+        if (it == m_Components.end()) return false;
+        Detach(it);
+        return true;
+    }
+
+    /// True if any enabled component's OnUpdate() may change this object.
+    bool HasUpdateLogic() const {
+        for (auto& c : m_Components)
+            if (c->IsEnabled() && c->UpdatesOwner()) return true;
+        return false;
+    }
+
 private:
+    void Attach(Unique<Component> comp, size_t index) {
+        Component* raw = comp.get();
+        raw->SetOwner(this);
+        raw->OnAttach();
+        m_Components.insert(m_Components.begin() + static_cast<std::ptrdiff_t>(index), std::move(comp));
+        for (auto& c : m_Components)
+            if (c.get() != raw) c->OnComponentAdded(raw);
+    }
+
+    Unique<Component> Detach(std::vector<Unique<Component>>::iterator it) {
+        (*it)->OnDetach();
+        Unique<Component> removed = std::move(*it);
+        m_Components.erase(it);
+        for (auto& c : m_Components) c->OnComponentRemoved(removed.get());
+        return removed;
+    }
+
     std::string                     m_Name;
     u32                             m_ID = 0;
     Transform                       m_Transform;
@@ -123,6 +184,8 @@ private:
     GameObject*                     m_Parent = nullptr;
     std::vector<Shared<GameObject>> m_Children;
     bool                            m_Active = true;
+    u32                             m_SnapshotEpoch = 0;
+    ComponentJournal*               m_Journal = nullptr;
 };
 
 } // namespace gv
@@ -0,0 +1,210 @@
+// ============================================================================
+// GameVoid Engine — Play-Mode Snapshot (copy-on-write journal)
+// ============================================================================
+// Lets the editor enter play mode without copying the scene and leave it by
+// undoing only what changed.
+//
+//   Begin()    O(1)  — bumps an epoch; nothing is copied.
+//   Touch(obj)       — called by simulation code *before* it mutates an
+//                      object.  The first touch in an epoch saves the
+//                      object's Transform, name, active flag and every component
+//                      that implements SaveState(); later touches are a
+//                      single integer compare.
+//   OnCreated / OnDestroyed — record structural changes.
+//   OnComponentAdded / OnComponentRemoved — the same for components; the
+//                      scene points its objects' ComponentJournal here.
+//   End()      O(touched) — reinserts destroyed objects and components,
+//                      removes created ones and writes the saved state back.
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include "core/GameObject.h"
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+
+namespace gv {
+
+class PlaySnapshot : public ComponentJournal {
+public:
+    bool IsRecording() const { return m_Recording; }
+
+    /// Start recording.  `nextID` is the owning scene's ID counter, restored
+    /// by End() so objects spawned during play don't shift later IDs.
+    void Begin(u32 nextID) {
+        m_Epoch     = NextEpoch();
+        m_Recording = true;
+        m_NextID    = nextID;
+    }
+
+    /// Save `obj`'s state the first time it is touched this epoch.
+    void Touch(GameObject* obj) {
+        if (!m_Recording || !obj || obj->GetSnapshotEpoch() == m_Epoch) return;
+        obj->SetSnapshotEpoch(m_Epoch);
+
+        Record rec;
+        rec.object    = obj;
+        rec.transform = obj->GetTransform();
+        rec.name      = obj->GetName();
+        rec.active    = obj->IsActive();
+        for (auto& c : obj->GetComponents())
+            if (auto saved = c->SaveState())
+                rec.components.push_back({ c.get(), std::move(saved) });
+        m_Touched.push_back(std::move(rec));
+    }
+
+    /// An object spawned during play — removed again by End().
+    void OnCreated(GameObject* obj) {
+        if (!m_Recording) return;
+        obj->SetSnapshotEpoch(m_Epoch);    // nothing to restore
+        m_Created.insert(obj);
+    }
+
+    /// An object removed from the scene's list at `index` during play.  The
+    /// snapshot keeps it alive so End() can put it back.
+    void OnDestroyed(const Shared<GameObject>& obj, size_t index) {
+        if (!m_Recording) return;
+        m_Destroyed.push_back({ obj, index });
+    }
+
+    /// A component attached during play — discarded again by End().
+    void OnComponentAdded(GameObject* obj, Component* added) override {
+        if (!m_Recording || m_Created.count(obj)) return;
+        m_AddedComponents.push_back({ obj, added });
+    }
+
+    /// A component detached during play.  The snapshot keeps it alive so
+    /// End() can put it back with the state it had when play began.
+    void OnComponentRemoved(GameObject* obj, Unique<Component> removed, size_t index) override {
+        if (!m_Recording || m_Created.count(obj)) return;
+        auto added = std::find_if(m_AddedComponents.begin(), m_AddedComponents.end(),
+            [&](const AddedComponent& a) { return a.component == removed.get(); });
+        if (added != m_AddedComponents.end()) {     // came and went during play
+            m_AddedComponents.erase(added);
+            return;
+        }
+        // Untouched so far means unchanged so far: save it as it is now.
+        if (obj->GetSnapshotEpoch() != m_Epoch) {
+            Touch(obj);
+            if (auto saved = removed->SaveState())
+                m_Touched.back().components.push_back({ removed.get(), std::move(saved) });
+        }
+        m_RemovedComponents.push_back({ obj, std::move(removed), index });
+    }
+
+    /// Undo play mode on `objects` (the scene's list).  `onRestored` runs for
+    /// each reinserted object, `onRemoved` for each spawned object before it
+    /// is dropped; `onComponentRestored` / `onComponentRemoved` likewise for
+    /// components on objects that stay.  Returns the scene ID counter saved
+    /// by Begin().
+    template <typename RestoredFn, typename RemovedFn,
+              typename ComponentRestoredFn, typename ComponentRemovedFn>
+    u32 End(std::vector<Shared<GameObject>>& objects,
+            RestoredFn&& onRestored, RemovedFn&& onRemoved,
+            ComponentRestoredFn&& onComponentRestored, ComponentRemovedFn&& onComponentRemoved) {
+        m_Recording = false;
+
+        // Components first, newest first so indices line up.
+        for (auto it = m_AddedComponents.rbegin(); it != m_AddedComponents.rend(); ++it) {
+            const auto& live = it->object->GetComponents();
+            bool attached = std::any_of(live.begin(), live.end(),
+                [&](const Unique<Component>& c) { return c.get() == it->component; });
+            if (!attached) continue;
+            onComponentRemoved(it->component);
+            it->object->DiscardComponent(it->component);
+        }
+        for (auto it = m_RemovedComponents.rbegin(); it != m_RemovedComponents.rend(); ++it) {
+            Component* comp = it->component.get();
+            it->object->RestoreComponent(std::move(it->component), it->index);
+            onComponentRestored(comp);
+        }
+
+        // Structural changes, newest first so indices line up.
+        for (auto it = m_Destroyed.rbegin(); it != m_Destroyed.rend(); ++it) {
+            if (m_Created.count(it->object.get())) continue;
+            size_t at = std::min(it->index, objects.size());
+            objects.insert(objects.begin() + static_cast<std::ptrdiff_t>(at), it->object);
+            onRestored(it->object.get());
+        }
+        if (!m_Created.empty()) {
+            objects.erase(std::remove_if(objects.begin(), objects.end(),
+                [&](const Shared<GameObject>& o) {
+                    if (!m_Created.count(o.get())) return false;
+                    onRemoved(o.get());
+                    return true;
+                }), objects.end());
+        }
+
+        // Saved state.
+        for (auto& rec : m_Touched) {
+            if (m_Created.count(rec.object)) continue;
+            rec.object->GetTransform() = rec.transform;
+            rec.object->SetName(rec.name);
+            rec.object->SetActive(rec.active);
+            const auto& live = rec.object->GetComponents();
+            for (auto& sc : rec.components) {
+                bool attached = std::any_of(live.begin(), live.end(),
+                    [&](const Unique<Component>& c) { return c.get() == sc.component; });
+                if (attached) sc.component->LoadState(*sc.saved);
+            }
+        }
+
+        u32 nextID = m_NextID;
+        m_Touched.clear();
+        m_Created.clear();
+        m_Destroyed.clear();
+        m_AddedComponents.clear();
+        m_RemovedComponents.clear();
+        return nextID;
+    }
+
+    size_t GetTouchedCount()   const { return m_Touched.size(); }
+    size_t GetCreatedCount()   const { return m_Created.size(); }
+    size_t GetDestroyedCount() const { return m_Destroyed.size(); }
+    size_t GetComponentChangeCount() const { return m_AddedComponents.size() + m_RemovedComponents.size(); }
+
+private:
+    struct SavedComponent {
+        Component*        component;
+        Unique<Component> saved;
+    };
+    struct Record {
+        GameObject*                 object = nullptr;
+        Transform                   transform;
+        std::string                 name;
+        bool                        active = true;
+        std::vector<SavedComponent> components;
+    };
+    struct Removed {
+        Shared<GameObject> object;
+        size_t             index;
+    };
+    struct AddedComponent {
+        GameObject* object;
+        Component*  component;
+    };
+    struct RemovedComponent {
+        GameObject*       object;
+        Unique<Component> component;
+        size_t            index;
+    };
+
+    // Epochs are global so an object moved between scenes never matches a
+    // stale stamp.
+    static u32 NextEpoch() {
+        static u32 s_Epoch = 0;
+        return ++s_Epoch;
+    }
+
+    bool                            m_Recording = false;
+    u32                             m_Epoch     = 0;
+    u32                             m_NextID    = 1;
+    std::vector<Record>             m_Touched;
+    std::unordered_set<GameObject*> m_Created;
+    std::vector<Removed>            m_Destroyed;
+    std::vector<AddedComponent>     m_AddedComponents;
+    std::vector<RemovedComponent>   m_RemovedComponents;
+};
+
+} // namespace gv
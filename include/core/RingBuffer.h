@@ -0,0 +1,78 @@
+// ============================================================================
+// GameVoid Engine — Fixed-Capacity Ring Buffer
+// ============================================================================
+// O(1) push with no reallocation once sized.  Storage is mirrored (each sample
+// is written twice, `capacity` apart) so the most recent N samples are always
+// one contiguous, oldest-first block that can be handed to plotting or
+// statistics code without copying.
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include <vector>
+
+namespace gv {
+
+/// Non-owning, read-only view over a contiguous array.
+template <typename T>
+struct ArrayView {
+    const T* data = nullptr;
+    size_t   size = 0;
+
+    const T* begin() const { return data; }
+    const T* end()   const { return data + size; }
+    bool     empty() const { return size == 0; }
+    const T& operator[](size_t i) const { return data[i]; }
+    const T& front() const { return data[0]; }
+    const T& back()  const { return data[size - 1]; }
+};
+
+template <typename T>
+class RingBuffer {
+public:
+    RingBuffer() = default;
+    explicit RingBuffer(size_t capacity) { SetCapacity(capacity); }
+
+    /// Resize the buffer.  Existing samples are discarded.
+    void SetCapacity(size_t capacity) {
+        m_Capacity = capacity;
+        m_Storage.assign(capacity * 2, T{});
+        m_Head = 0;
+        m_Count = 0;
+    }
+
+    /// Append a sample, overwriting the oldest one when full.
+    void Push(const T& value) {
+        if (m_Capacity == 0) return;
+        m_Storage[m_Head] = value;
+        m_Storage[m_Head + m_Capacity] = value;
+        m_Head = (m_Head + 1) % m_Capacity;
+        if (m_Count < m_Capacity) ++m_Count;
+    }
+
+    /// Sample that Push() is about to overwrite (valid only when Full()).
+    const T& Oldest() const { return View().front(); }
+    const T& Newest() const { return View().back(); }
+
+    /// Oldest-first contiguous view of the stored samples.
+    ArrayView<T> View() const {
+        size_t start = (m_Count < m_Capacity) ? 0 : m_Head;
+        return { m_Storage.data() + start, m_Count };
+    }
+
+    const T& operator[](size_t i) const { return View()[i]; }
+
+    void   Clear()          { m_Head = 0; m_Count = 0; }
+    size_t Size()     const { return m_Count; }
+    size_t Capacity() const { return m_Capacity; }
+    bool   Empty()    const { return m_Count == 0; }
+    bool   Full()     const { return m_Count == m_Capacity && m_Capacity > 0; }
+
+private:
+    std::vector<T> m_Storage;
+    size_t m_Capacity = 0;
+    size_t m_Head  = 0;   // next write slot in [0, capacity)
+    size_t m_Count = 0;
+};
+
+} // namespace gv
@@ -0,0 +1,333 @@
+// ============================================================================
+// GameVoid Engine — Save Games
+// ============================================================================
+// Runtime save/load of game state, separate from the editor's scene JSON.
+//
+// A save is a tree of chunks.  Each chunk is { type, version, size, data }:
+//   "SCNE"            scene name and ID counter
+//   "OBJT" per object  id, parent, name, active flag, transform, then one
+//                      nested chunk per saved component
+//   registered types   components and free-standing sections (quest flags,
+//                      inventory, …), typed by a hash of their registered name
+// Unknown chunks are skipped, so an older build can still read the rest.
+//
+// Saving is opt-in per component type:
+//     SaveRegistry::Global().RegisterComponent<Health>("Health", 3);
+// saves every Health through its WriteSave / ReadSave overrides.  When the
+// layout changes, bump the version and register a migration for the old
+// one; loading runs the chain (1 → 2 → 3) before ReadSave sees the data:
+//     registry.AddMigration("Health", 2, [](SaveReader& in, SaveWriter& out) {
+//         out.WriteF32(in.ReadF32());   // hp
+//         out.WriteF32(100.0f);         // new in v3: max hp
+//         return true;
+//     });
+//
+// Files (".gvsave"): a fixed header, an uncompressed metadata block (title,
+// timestamps, BC1 thumbnail) so slot lists don't touch the payload, then
+// the LZ-compressed chunk payload with a CRC.  They are written to a
+// temporary file and renamed over the old one, so a crash mid-write leaves
+// the previous save intact.  SaveSlots captures on the calling thread and
+// compresses and writes on a background thread.
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include "core/Math.h"
+#include "core/GameObject.h"
+#include "assets/TextureCooker.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace gv {
+
+class Scene;
+
+// ============================================================================
+// SaveWriter / SaveReader — little-endian byte streams with nested chunks
+// ============================================================================
+class SaveWriter {
+public:
+    void WriteU8(u8 v)     { Put(&v, 1); }
+    void WriteBool(bool v) { WriteU8(v ? 1 : 0); }
+    void WriteU32(u32 v)   { Put(&v, 4); }
+    void WriteI32(i32 v)   { Put(&v, 4); }
+    void WriteU64(u64 v)   { Put(&v, 8); }
+    void WriteF32(f32 v)   { Put(&v, 4); }
+    void WriteF64(f64 v)   { Put(&v, 8); }
+    void WriteVec3(const Vec3& v)       { WriteF32(v.x); WriteF32(v.y); WriteF32(v.z); }
+    void WriteQuat(const Quaternion& q) { WriteF32(q.x); WriteF32(q.y); WriteF32(q.z); WriteF32(q.w); }
+    void WriteString(std::string_view s) { WriteU32(static_cast<u32>(s.size())); Put(s.data(), s.size()); }
+    void WriteBytes(const void* data, size_t size) { Put(data, size); }
+
+    /// Start a chunk; everything written until EndChunk is its data.
+    size_t BeginChunk(u32 type, u32 version);
+    void   EndChunk(size_t chunk);
+
+    const std::vector<u8>& GetData() const { return m_Data; }
+    std::vector<u8> Take() { return std::move(m_Data); }
+    size_t GetSize() const { return m_Data.size(); }
+
+private:
+    void Put(const void* data, size_t size) {
+        const u8* p = static_cast<const u8*>(data);
+        m_Data.insert(m_Data.end(), p, p + size);
+    }
+    std::vector<u8> m_Data;
+};
+
+/// Reads past the end return zeros and clear IsOK(), so a truncated or
+/// corrupt chunk can't read outside its data.
+class SaveReader {
+public:
+    struct Chunk {
+        u32 type = 0;
+        u32 version = 0;
+        const u8* data = nullptr;
+        u32 size = 0;
+    };
+
+    SaveReader() = default;
+    SaveReader(const u8* data, size_t size) : m_Data(data), m_Size(size) {}
+    explicit SaveReader(const std::vector<u8>& data) : m_Data(data.data()), m_Size(data.size()) {}
+    explicit SaveReader(const Chunk& chunk) : m_Data(chunk.data), m_Size(chunk.size) {}
+
+    u8   ReadU8()   { u8 v = 0;  Get(&v, 1); return v; }
+    bool ReadBool() { return ReadU8() != 0; }
+    u32  ReadU32()  { u32 v = 0; Get(&v, 4); return v; }
+    i32  ReadI32()  { i32 v = 0; Get(&v, 4); return v; }
+    u64  ReadU64()  { u64 v = 0; Get(&v, 8); return v; }
+    f32  ReadF32()  { f32 v = 0; Get(&v, 4); return v; }
+    f64  ReadF64()  { f64 v = 0; Get(&v, 8); return v; }
+    Vec3 ReadVec3() { Vec3 v; v.x = ReadF32(); v.y = ReadF32(); v.z = ReadF32(); return v; }
+    Quaternion ReadQuat() { Quaternion q; q.x = ReadF32(); q.y = ReadF32(); q.z = ReadF32(); q.w = ReadF32(); return q; }
+    std::string ReadString();
+    bool ReadBytes(void* out, size_t size) { return Get(out, size); }
+
+    /// The next chunk at this level; false at the end or on a bad header.
+    bool NextChunk(Chunk& out);
+
+    bool   IsOK() const      { return m_OK; }
+    bool   AtEnd() const     { return m_Pos >= m_Size; }
+    size_t Remaining() const { return m_Size - m_Pos; }
+
+private:
+    bool Get(void* out, size_t size);
+
+    const u8* m_Data = nullptr;
+    size_t    m_Size = 0;
+    size_t    m_Pos = 0;
+    bool      m_OK = true;
+};
+
+// ============================================================================
+// SaveRegistry — which component types and sections are saved, and how
+// old versions are upgraded
+// ============================================================================
+class SaveRegistry {
+public:
+    using Migration = std::function<bool(SaveReader& in, SaveWriter& out)>;
+
+    static SaveRegistry& Global();
+
+    /// Save components of exactly type T (not subclasses) through their
+    /// WriteSave / ReadSave.  `version` (>= 1) is the current layout.
+    template <typename T>
+    void RegisterComponent(const std::string& name, u32 version) {
+        RegisterComponent<T>(name, version,
+            [](const T& c, SaveWriter& out) { c.WriteSave(out); },
+            [](T& c, SaveReader& in) { c.ReadSave(in); });
+    }
+
+    /// Same with outside functions, for types that don't override the hooks.
+    template <typename T>
+    void RegisterComponent(const std::string& name, u32 version,
+                           std::function<void(const T&, SaveWriter&)> save,
+                           std::function<void(T&, SaveReader&)> load) {
+        static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
+        Entry* e = Add(name, version, std::type_index(typeid(T)));
+        if (!e) return;
+        e->create = [](GameObject& obj) -> Component* { return obj.AddComponent<T>(); };
+        e->save = [save](const Component& c, SaveWriter& out) { save(static_cast<const T&>(c), out); };
+        e->load = [load](Component& c, SaveReader& in) { load(static_cast<T&>(c), in); };
+    }
+
+    /// Game state that doesn't live on an object.
+    void RegisterSection(const std::string& name, u32 version,
+                         std::function<void(SaveWriter&)> save, std::function<void(SaveReader&)> load);
+
+    /// Upgrade `name`'s data from `fromVersion` to `fromVersion + 1`.
+    void AddMigration(const std::string& name, u32 fromVersion, Migration migration);
+
+    /// Chunk type of a registered name (FNV-1a).
+    static u32 TypeHash(std::string_view name);
+
+private:
+    friend class SaveGame;
+
+    struct Entry {
+        std::string     name;
+        u32             hash = 0;
+        u32             version = 1;
+        std::type_index type = std::type_index(typeid(void));   // void = section
+        std::function<Component*(GameObject&)>             create;
+        std::function<void(const Component&, SaveWriter&)> save;
+        std::function<void(Component&, SaveReader&)>       load;
+        std::function<void(SaveWriter&)>                   saveSection;
+        std::function<void(SaveReader&)>                   loadSection;
+        std::unordered_map<u32, Migration>                 migrations;   // by from-version
+    };
+
+    Entry* Add(const std::string& name, u32 version, std::type_index type);
+    const Entry* Find(u32 hash) const;
+    const Entry* Find(const Component& c) const;
+    /// Bring `data` from `version` up to the entry's version.
+    bool Migrate(const Entry& e, u32 version, std::vector<u8>& data, std::string& error) const;
+
+    std::vector<Entry>                        m_Entries;
+    std::unordered_map<u32, size_t>           m_ByHash;
+    std::unordered_map<std::type_index, size_t> m_ByType;
+};
+
+// ============================================================================
+// Metadata and thumbnails
+// ============================================================================
+struct SaveThumbnail {
+    u32 width = 0, height = 0;
+    std::vector<u8> bc1;                 // TextureFormat::BC1 blocks
+
+    /// Box-filter `image` down to at most `maxSize` on its longer side and
+    /// BC1-encode it.
+    static SaveThumbnail FromImage(const ImageRGBA8& image, u32 maxSize = 256);
+    bool Decode(ImageRGBA8& out) const;
+    bool IsEmpty() const { return bc1.empty(); }
+
+    /// The current GL viewport, rows top to bottom.  False without GL.
+    static bool CaptureFramebuffer(ImageRGBA8& out);
+};
+
+struct SaveMetadata {
+    std::string title;
+    std::string sceneName;
+    u64 timestamp = 0;                   // Unix seconds; 0 = filled in when written
+    f64 playTime = 0.0;                  // seconds
+    u32 gameVersion = 0;
+    std::vector<std::pair<std::string, std::string>> extra;
+    SaveThumbnail thumbnail;
+};
+
+// ============================================================================
+// SaveGame — scenes to payloads, payloads to files
+// ============================================================================
+class SaveGame {
+public:
+    /// Objects (id, parent, name, active, transform), their registered
+    /// components and every registered section.
+    static std::vector<u8> Capture(const Scene& scene, const SaveRegistry& registry = SaveRegistry::Global());
+
+    /// Make `scene` match `payload`: saved objects are updated, or created
+    /// with their saved IDs; objects the save doesn't have are destroyed.
+    /// Saved components are loaded into the object's component of that
+    /// type, added if missing.  Chunks that can't be read (unknown type,
+    /// newer version, missing migration) are skipped with a warning.
+    /// False only if the payload itself is malformed.
+    static bool Restore(Scene& scene, const std::vector<u8>& payload, std::string& error,
+                        const SaveRegistry& registry = SaveRegistry::Global());
+
+    /// Write atomically (temporary file + rename).
+    static bool WriteFile(const std::string& path, const SaveMetadata& meta, const std::vector<u8>& payload,
+                          std::string& error, bool compress = true);
+    /// `payload` may be null to read only the metadata.
+    static bool ReadFile(const std::string& path, SaveMetadata* meta, std::vector<u8>* payload, std::string& error);
+
+    /// LZ77 byte compression used for payloads.
+    static std::vector<u8> Compress(const u8* data, size_t size);
+    static bool Decompress(const u8* data, size_t size, size_t rawSize, std::vector<u8>& out);
+};
+
+// ============================================================================
+// SaveSlots — named saves in a directory, written in the background
+// ============================================================================
+struct SaveSlotInfo {
+    std::string  slot;
+    SaveMetadata meta;
+};
+
+struct SaveResult {
+    u32         ticket = 0;
+    std::string slot;
+    bool        ok = false;
+    std::string error;
+    size_t      rawBytes = 0;
+    size_t      fileBytes = 0;
+};
+
+class SaveSlots {
+public:
+    /// Slots are "<directory>/<slot>.gvsave".  Slot names may use letters,
+    /// digits, '_' and '-'.
+    explicit SaveSlots(const std::string& directory,
+                       const SaveRegistry& registry = SaveRegistry::Global());
+    /// Finishes queued writes.
+    ~SaveSlots();
+    SaveSlots(const SaveSlots&) = delete;
+    SaveSlots& operator=(const SaveSlots&) = delete;
+
+    /// Capture `scene` now; compress and write on the worker.  Returns a
+    /// ticket (0 if the slot name is invalid).
+    u32  SaveAsync(const std::string& slot, const Scene& scene, SaveMetadata meta);
+    bool Save(const std::string& slot, const Scene& scene, SaveMetadata meta, std::string& error);
+    /// Waits for queued writes to `slot` first.
+    bool Load(const std::string& slot, Scene& scene, std::string& error, SaveMetadata* meta = nullptr);
+
+    /// Slots with readable metadata, newest first.
+    std::vector<SaveSlotInfo> List() const;
+    bool Exists(const std::string& slot) const;
+    bool Delete(const std::string& slot);
+    std::string GetPath(const std::string& slot) const;
+    static bool IsValidSlotName(const std::string& slot);
+
+    /// Finished background writes since the last call (not those made by Save).
+    std::vector<SaveResult> PollCompleted();
+    /// Block until every queued write is done.
+    void Flush();
+    bool IsBusy() const;
+
+private:
+    struct Job {
+        u32             ticket = 0;
+        std::string     slot;
+        SaveMetadata    meta;
+        std::vector<u8> payload;
+    };
+
+    /// `waited` results go to Save, not PollCompleted.
+    u32  Queue(const std::string& slot, std::vector<u8> payload, SaveMetadata meta, bool waited);
+    void WorkerLoop();
+
+    std::string         m_Directory;
+    const SaveRegistry& m_Registry;
+    u32                 m_NextTicket = 1;
+
+    mutable std::mutex      m_Mutex;
+    std::condition_variable m_CV;        // jobs queued / stopping
+    std::condition_variable m_IdleCV;    // a job finished
+    std::deque<Job>         m_Jobs;
+    std::vector<SaveResult> m_Done;
+    std::unordered_set<u32> m_Waited;    // tickets a Save call is blocked on
+    std::unordered_set<std::string> m_Writing;   // slots on the worker now
+    bool                    m_Stop = false;
+    std::thread             m_Worker;
+};
+
+} // namespace gv
@@ -9,6 +9,7 @@
 
 #include "core/Types.h"
 #include "core/GameObject.h"
+#include "core/PlaySnapshot.h"
 #include "renderer/Camera.h"
 #include "physics/Physics.h"
 #include <string>
@@ -21,18 +22,39 @@ public:
     explicit Scene(const std::string& name = "Untitled Scene")
         : m_Name(name) {}
 
-    ~Scene() = default;
+    ~Scene() {
+        for (auto& o : m_Objects) o->SetComponentJournal(nullptr);
+    }
 
     // ── Object management ──────────────────────────────────────────────────
     /// Create a new empty GameObject in the scene and return a raw pointer.
     GameObject* CreateGameObject(const std::string& name = "GameObject") {
         auto obj = MakeShared<GameObject>(name);
         obj->SetID(m_NextID++);
+        obj->SetComponentJournal(&m_Snapshot);
         m_Objects.push_back(obj);
+        m_Snapshot.OnCreated(obj.get());
         GV_LOG_INFO("Scene '" + m_Name + "' — created object '" + name + "' (id=" + std::to_string(obj->GetID()) + ")");
         return obj.get();
     }
 
+    /// Create an object with a given ID (save-game loading).  Returns
+    /// nullptr if the ID is 0 or taken.  Later IDs continue above it.
+    GameObject* CreateGameObjectWithID(u32 id, const std::string& name) {
+        if (id == 0 || FindByID(id)) return nullptr;
+        auto obj = MakeShared<GameObject>(name);
+        obj->SetID(id);
+        m_NextID = std::max(m_NextID, id + 1);
+        obj->SetComponentJournal(&m_Snapshot);
+        m_Objects.push_back(obj);
+        m_Snapshot.OnCreated(obj.get());
+        return obj.get();
+    }
+
+    /// Next ID CreateGameObject will hand out.
+    u32  GetNextID() const  { return m_NextID; }
+    void SetNextID(u32 id)  { m_NextID = id; }
+
     /// Find an object by name (returns first match or nullptr).
     GameObject* FindByName(const std::string& name) const {
         for (auto& o : m_Objects)
@@ -52,8 +74,25 @@ public:
         m_PendingDestroy.push_back(obj);
     }
 
+    /// Remove objects queued by DestroyGameObject now instead of at the end
+    /// of the next Update.
+    void FlushDestroyQueue() {
+        for (auto* obj : m_PendingDestroy) {
+            auto it = std::find_if(m_Objects.begin(), m_Objects.end(),
+                [obj](const Shared<GameObject>& o) { return o.get() == obj; });
+            if (it == m_Objects.end()) continue;
+            DetachObject(obj);
+            m_Snapshot.OnDestroyed(*it, static_cast<size_t>(it - m_Objects.begin()));
+            m_Objects.erase(it);
+        }
+        m_PendingDestroy.clear();
+    }
+
     /// Set the physics world reference for automatic body unregistration.
-    void SetPhysicsWorld(PhysicsWorld* pw) { m_Physics = pw; }
+    void SetPhysicsWorld(PhysicsWorld* pw) {
+        m_Physics = pw;
+        if (m_Physics) m_Physics->SetPlaySnapshot(&m_Snapshot);
+    }
 
     /// Get all objects (read-only).
     const std::vector<Shared<GameObject>>& GetAllObjects() const { return m_Objects; }
@@ -71,11 +110,56 @@ public:
 
     /// Called every frame.
     void Update(f32 dt) {
-        for (auto& o : m_Objects)
-            if (o->IsActive()) o->Update(dt);
+        bool recording = m_Snapshot.IsRecording();
+        for (auto& o : m_Objects) {
+            if (!o->IsActive()) continue;
+            if (recording && o->HasUpdateLogic()) m_Snapshot.Touch(o.get());
+            o->Update(dt);
+        }
         FlushDestroyQueue();
     }
 
+    // ── Play mode ──────────────────────────────────────────────────────────
+    /// Enter play mode.  O(1): objects are saved copy-on-write the first time
+    /// scripts, physics or controllers touch them.
+    void BeginPlay() {
+        if (m_Snapshot.IsRecording()) return;
+        m_Snapshot.Begin(m_NextID);
+    }
+
+    /// Leave play mode, undoing spawns, destroys, component changes and every
+    /// touched object.
+    void StopPlay() {
+        if (!m_Snapshot.IsRecording()) return;
+        m_PendingDestroy.clear();
+        m_NextID = m_Snapshot.End(m_Objects,
+            [this](GameObject* obj) {
+                obj->SetComponentJournal(&m_Snapshot);
+                for (auto& comp : obj->GetComponents()) comp->OnAttach();
+                if (m_Physics)
+                    if (auto* rb = obj->GetComponent<RigidBody>()) m_Physics->RegisterBody(rb);
+            },
+            [this](GameObject* obj) { DetachObject(obj); },
+            [this](Component* comp) {
+                // Registered once, whether or not it was unregistered when removed.
+                if (auto* rb = dynamic_cast<RigidBody*>(comp); rb && m_Physics) {
+                    m_Physics->UnregisterBody(rb);
+                    m_Physics->RegisterBody(rb);
+                }
+            },
+            [this](Component* comp) {
+                if (auto* rb = dynamic_cast<RigidBody*>(comp); rb && m_Physics) m_Physics->UnregisterBody(rb);
+            });
+    }
+
+    bool IsPlaying() const { return m_Snapshot.IsRecording(); }
+
+    /// Record `obj` before mutating it from outside the scene's own update
+    /// (e.g. engine-driven controllers).  No-op outside play mode.
+    void TouchForPlay(GameObject* obj) { m_Snapshot.Touch(obj); }
+
+    const PlaySnapshot& GetPlaySnapshot() const { return m_Snapshot; }
+
     /// Called every frame during the render pass.
     void Render() {
         for (auto& o : m_Objects)
@@ -96,27 +180,22 @@ public:
     }
 
 private:
-    void FlushDestroyQueue() {
-        for (auto* obj : m_PendingDestroy) {
-            // Nullify active camera if it belongs to this object
-            if (m_ActiveCamera && m_ActiveCamera->GetOwner() == obj) {
-                m_ActiveCamera = nullptr;
-            }
-            // Unregister physics body before destruction
-            if (m_Physics) {
-                auto* rb = obj->GetComponent<RigidBody>();
-                if (rb) m_Physics->UnregisterBody(rb);
-            }
-            // Call OnDetach on all components before destruction
-            for (auto& comp : obj->GetComponents()) {
-                comp->OnDetach();
-            }
-            m_Objects.erase(
-                std::remove_if(m_Objects.begin(), m_Objects.end(),
-                    [obj](const Shared<GameObject>& o) { return o.get() == obj; }),
-                m_Objects.end());
+    /// Release everything an object holds outside the scene list.
+    void DetachObject(GameObject* obj) {
+        // Nullify active camera if it belongs to this object
+        if (m_ActiveCamera && m_ActiveCamera->GetOwner() == obj) {
+            m_ActiveCamera = nullptr;
         }
-        m_PendingDestroy.clear();
+        // Unregister physics body before destruction
+        if (m_Physics) {
+            auto* rb = obj->GetComponent<RigidBody>();
+            if (rb) m_Physics->UnregisterBody(rb);
+        }
+        // Call OnDetach on all components before destruction
+        for (auto& comp : obj->GetComponents()) {
+            comp->OnDetach();
+        }
+        obj->SetComponentJournal(nullptr);
     }
 
     std::string                     m_Name;
@@ -124,6 +203,7 @@ private:
     std::vector<GameObject*>        m_PendingDestroy;
     Camera*                         m_ActiveCamera = nullptr;
     PhysicsWorld*                   m_Physics = nullptr;
+    PlaySnapshot                    m_Snapshot;
     u32                             m_NextID = 1;
     bool                            m_Started = false;
 };
@@ -107,6 +107,7 @@ private:
 // ============================================================================
 class SceneSerializer {
     friend class PrefabLibrary;
+    friend struct BehaviorTreeDesc;
 public:
     /// Serialize a scene to a JSON file.
     static bool SaveScene(const Scene& scene, const std::string& path);
@@ -0,0 +1,93 @@
+// ============================================================================
+// GameVoid Engine — Headless Batch Runner
+// ============================================================================
+// Runs scene files for a fixed number of frames with no window or GL context.
+// Build servers use it to regression-test content:
+//   • Load a scene (SceneSerializer JSON) and step physics + scripts at a
+//     fixed dt for N frames
+//   • Optionally run CLIEditor commands on the loaded scene first
+//   • Write per-frame transforms / metrics to a CSV or binary trace
+//   • Check user invariants ("Ball.y > -5", "*.speed < 50") every frame and
+//     exit nonzero on the first violation
+//   • Spread many scenes across worker processes
+//
+//   GameVoid --batch [options] scene.gvs [more.gvs ...]
+//   GameVoidBatch    [options] scene.gvs [more.gvs ...]
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include <string>
+#include <vector>
+
+namespace gv {
+
+class GameObject;
+
+enum class BatchTraceFormat { None, CSV, Binary };
+
+/// One invariant of the form  <object|*>.<field> <op> <value>.
+/// Fields: x y z vx vy vz speed angspeed.  Ops: < <= > >= == !=.
+struct BatchInvariant {
+    std::string text;                // original expression, for reports
+    std::string object;              // object name, or "*" for every object
+    std::string field;
+    std::string op;
+    f32         value = 0.0f;
+
+    /// Parse an expression.  Returns false (and leaves `out` untouched) on error.
+    static bool Parse(const std::string& expr, BatchInvariant& out);
+
+    /// Evaluate against one object.  Objects without a RigidBody report zero
+    /// velocity.
+    bool Check(GameObject* obj) const;
+};
+
+/// Everything needed to run one scene.
+struct BatchJob {
+    std::string                 scenePath;
+    u32                         frames   = 600;
+    f32                         dt       = 1.0f / 60.0f;
+    std::string                 tracePath;                 // empty = no trace
+    BatchTraceFormat            traceFormat = BatchTraceFormat::None;
+    std::vector<BatchInvariant> invariants;
+    std::vector<std::string>    commands;                  // CLIEditor commands run after load
+    std::string                 forceFieldsPath;           // optional ForceFieldLibrary file
+    bool                        enableScripting = true;
+    std::string                 logPath;                   // worker-process output; empty = derived
+};
+
+struct BatchResult {
+    std::string              scenePath;
+    bool                     passed      = false;
+    i32                      exitCode    = 0;   // 0 pass, 1 invariant failed, 2 load/setup error
+    u32                      framesRun   = 0;
+    f64                      wallMs      = 0.0;
+    std::vector<std::string> failures;
+};
+
+class BatchRunner {
+public:
+    /// Simulate one scene in-process.
+    static BatchResult RunJob(const BatchJob& job);
+
+    /// Run every job in its own worker process, `workers` at a time.
+    /// `exePath` is the executable to re-launch (normally argv[0]).
+    /// Returns the worst exit code of all jobs.
+    static i32 RunParallel(const std::vector<BatchJob>& jobs, u32 workers,
+                           const std::string& exePath);
+
+    /// Command-line entry point.  Parses the batch flags in argv (the
+    /// "--batch" switch itself is ignored) and returns the process exit code.
+    static i32 Main(int argc, char* argv[]);
+
+    static void PrintUsage();
+
+    /// Shell command that runs `job` in a worker process with its output in
+    /// `logPath`.  dt is written with enough digits to parse back bit-exact,
+    /// so worker runs step exactly like in-process runs.
+    static std::string BuildWorkerCommand(const BatchJob& job, const std::string& exePath,
+                                          const std::string& logPath);
+};
+
+} // namespace gv
@@ -71,6 +71,9 @@ private:
     void CmdRename(const std::vector<std::string>& args);
     void CmdSave(const std::vector<std::string>& args);
     void CmdLoad(const std::vector<std::string>& args);
+    void CmdCook(const std::vector<std::string>& args);
+    void CmdProfile(const std::vector<std::string>& args);
+    void CmdDialogue(const std::vector<std::string>& args);
 
     /// Tokenise a raw input line into command + arguments.
     static std::vector<std::string> Tokenise(const std::string& input);
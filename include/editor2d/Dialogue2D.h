@@ -8,6 +8,8 @@
 //   - DialogueTree     : a collection of nodes forming a conversation graph
 //   - DialogueRunner2D : component that attaches to an NPC and drives the
 //                         conversation state machine
+//   - DialogueBank     : the compiled form for large scripts — see
+//                         DialogueBank.h
 //
 // How it works:
 //   1. Build a DialogueTree (in code or loaded from data) with nodes.
@@ -23,13 +25,17 @@
 // Supports:
 //   - Linear dialogue (just next→next→next)
 //   - Branching choices (RPG-style dialogue trees)
-//   - Conditions / flags (simple string-based flag map)
+//   - Conditions / flags (flags live in DialogueVariables::Global(), which
+//     compiled banks read and write too)
 //   - OnEnter / OnExit callbacks per node (trigger events, give items, etc.)
+//   - Compiled banks: StartDialogue(bank) runs a DialogueBank, with
+//     expression conditions and actions
 // ============================================================================
 #pragma once
 
 #include "core/Types.h"
 #include "core/Component.h"
+#include "editor2d/DialogueBank.h"
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -116,6 +122,12 @@ public:
     /// Begin a conversation.  Pass a tree (owned externally).
     void StartDialogue(DialogueTree* tree);
 
+    /// Begin a conversation from a compiled bank at `node` (default: the
+    /// bank's start).  Conditions and actions use `vars`, or the global
+    /// store when null.
+    void StartDialogue(Shared<DialogueBank> bank, u32 node = DialogueBank::kNone,
+                       DialogueVariables* vars = nullptr);
+
     /// End the conversation early.
     void EndDialogue();
 
@@ -132,9 +144,19 @@ public:
     bool IsActive()   const { return m_Active; }
     bool IsFinished() const { return m_Finished; }
 
-    /// Get the current node (or nullptr if not active).
+    /// Get the current node (or nullptr if not active, or running a bank).
     const DialogueNode* GetCurrentNode() const;
 
+    /// Speaker of the current line (trees and banks).
+    const std::string& GetSpeaker() const { return m_Speaker; }
+
+    /// Texts of the available choices (trees and banks).
+    std::vector<std::string_view> GetChoiceTexts() const;
+
+    /// The bank being run and its current node index (kNone otherwise).
+    const DialogueBank* GetBank() const { return m_Bank.get(); }
+    u32 GetBankNode() const { return m_BankNode; }
+
     /// Get the visible portion of text (typewriter effect).
     const std::string& GetVisibleText() const { return m_VisibleText; }
 
@@ -144,11 +166,12 @@ public:
     /// Skip the typewriter and show full text immediately.
     void SkipReveal();
 
-    /// Get the available choices (filtered by flags).
+    /// Get the available choices (filtered by flags).  Trees only.
     std::vector<const DialogueChoice*> GetAvailableChoices() const;
 
     // ── Flags (shared across all runners) ──────────────────────────────────
-    /// Global flag map — set flags to gate choices.
+    /// Global flags — set flags to gate choices.  A flag is a variable in
+    /// DialogueVariables::Global() (set = 1), so bank conditions see it.
     static void SetFlag(const std::string& flag, bool value = true);
     static bool HasFlag(const std::string& flag);
     static void ClearAllFlags();
@@ -156,6 +179,12 @@ public:
 private:
     DialogueTree*  m_Tree       = nullptr;
     std::string    m_CurrentID;
+    std::string    m_Speaker;
+
+    // Compiled bank
+    Shared<DialogueBank> m_Bank;
+    DialogueVariables*   m_Vars     = nullptr;
+    u32                  m_BankNode = DialogueBank::kNone;
     bool           m_Active     = false;
     bool           m_Finished   = false;
 
@@ -169,10 +198,11 @@ private:
     // Auto-advance
     f32            m_AutoTimer  = 0.0f;
 
-    // Global flags
-    static std::unordered_map<std::string, bool> s_Flags;
-
     void EnterNode(const std::string& nodeID);
+    void EnterBankNode(u32 node);
+    void StartReveal(const std::string& text);
+    /// Bank choices available now.
+    std::vector<u32> BankChoices() const;
 };
 
 } // namespace gv
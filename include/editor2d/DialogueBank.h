@@ -0,0 +1,240 @@
+// ============================================================================
+// GameVoid Engine — Compiled Dialogue Banks
+// ============================================================================
+// DialogueTree keeps every id, speaker and link as a std::string and finds
+// nodes by hashing them — fine for a few NPC lines, not for a 40k-line
+// script.  A dialogue bank is the cooked form:
+//   • Nodes, choices and links are fixed-size records addressed by index
+//   • Speakers, lines and choice texts live in one string table; every
+//     entry carries a hash of its source text, so a translation keyed by
+//     that hash replaces it without recompiling (LoadTranslation)
+//   • Conditions ("gold >= 10 and not met_king") and node actions
+//     ("gold = gold - 10") are compiled to a small stack bytecode over
+//     numbered variables.  A bank binds its variable names to a
+//     DialogueVariables store once and then runs without string lookups
+//   • ".gvdb" files are memory-mapped and read in place; DialogueLibrary
+//     opens a bank the first time someone asks for it
+//
+// Script source (".gvdlg"), one statement per line:
+//   # comment
+//   :: shop_greet                       start a node (the first is the start)
+//   Old Man: Looking to buy?            speaker: text  (": text" = narration;
+//                                       further text lines continue it)
+//   ~ visits += 1; met = true           actions, run on entering the node
+//   * [gold >= 10] Buy the map -> buy   choice: [condition] text -> target
+//   * Leave -> END                      END (or nothing after ->) ends
+//   -> farewell if visits > 3           links for Advance(): the first whose
+//   -> END                              condition holds is taken
+// Expressions: numbers, true/false, variables (letters, digits, '_', '.'),
+// + - * / %, comparisons, and/or/not (also && || !), parentheses.  Unset
+// variables read as 0; true is 1.
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include "assets/MappedFile.h"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace gv {
+
+class DialogueTree;
+
+// ════════════════════════════════════════════════════════════════════════════
+// DialogueVariables — the numbered store conditions read and actions write
+// ════════════════════════════════════════════════════════════════════════════
+class DialogueVariables {
+public:
+    static constexpr u32 kInvalid = ~0u;
+
+    DialogueVariables();
+
+    /// The store runners use unless given another.  It also backs
+    /// DialogueRunner2D::SetFlag / HasFlag.
+    static DialogueVariables& Global();
+
+    /// Index of `name`, adding it (value 0) if new.  Indices never change.
+    u32  Intern(const std::string& name);
+    u32  Find(const std::string& name) const;
+
+    f64  Get(u32 index) const { return index < m_Values.size() ? m_Values[index] : 0.0; }
+    void Set(u32 index, f64 value) { if (index < m_Values.size()) m_Values[index] = value; }
+    f64  Get(const std::string& name) const { return Get(Find(name)); }
+    void Set(const std::string& name, f64 value) { Set(Intern(name), value); }
+
+    /// Zero every value; names and indices stay.
+    void Reset();
+    u32  GetCount() const { return static_cast<u32>(m_Values.size()); }
+    const std::string& GetName(u32 index) const { return m_Names[index]; }
+    /// Distinguishes stores, so banks know when to re-bind.
+    u32  GetId() const { return m_Id; }
+
+private:
+    u32 m_Id;
+    std::vector<f64>         m_Values;
+    std::vector<std::string> m_Names;
+    std::unordered_map<std::string, u32> m_Index;
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// DialogueBank — read-only view of a compiled bank
+// ════════════════════════════════════════════════════════════════════════════
+class DialogueBank {
+public:
+    static constexpr u32 kNone = ~0u;   // no node (end), string or condition
+
+    struct Node {
+        u32 speaker = kNone;            // string index
+        u32 text = kNone;               // string index
+        u32 actions = kNone;            // code offset
+        u32 firstChoice = 0;
+        u32 firstLink = 0;
+        u16 choiceCount = 0;
+        u16 linkCount = 0;
+    };
+    struct Choice {
+        u32 text = kNone;
+        u32 target = kNone;             // node index; kNone ends the dialogue
+        u32 condition = kNone;          // code offset; kNone = always
+    };
+    struct Link {
+        u32 target = kNone;
+        u32 condition = kNone;
+    };
+
+    DialogueBank() = default;
+    DialogueBank(const DialogueBank&) = delete;
+    DialogueBank& operator=(const DialogueBank&) = delete;
+
+    /// Map a .gvdb file.  The bank is named after the file's stem.
+    bool Open(const std::string& path);
+    /// Use an in-memory bank (e.g. straight from DialogueCompiler).
+    bool Load(std::vector<u8> bytes, const std::string& name = "memory");
+    void Close();
+    bool IsOpen() const { return m_Data != nullptr; }
+    const std::string& GetName() const { return m_Name; }
+
+    // ── Graph ──────────────────────────────────────────────────────────────
+    u32    GetNodeCount() const   { return m_NodeCount; }
+    u32    GetStartNode() const   { return m_Start; }
+    Node   GetNode(u32 node) const;
+    Choice GetChoice(u32 choice) const;
+    Link   GetLink(u32 link) const;
+    std::string_view GetNodeName(u32 node) const;
+    /// Node index by name (binary search), or kNone.
+    u32    FindNode(std::string_view name) const;
+
+    // ── Strings ────────────────────────────────────────────────────────────
+    u32 GetStringCount() const { return m_StringCount; }
+    /// Translated text if a translation provides it, else the source text.
+    std::string_view GetString(u32 index) const;
+    std::string_view GetSourceString(u32 index) const;
+    /// Hash of the source text: the key translations use.
+    u32 GetStringKey(u32 index) const;
+    /// Read "key<TAB>text" lines (key in hex; \n \t \\ escaped).  Keys the
+    /// bank doesn't use are ignored.  Returns the number applied.
+    u32  LoadTranslation(const std::string& path);
+    void ClearTranslation();
+    /// Write every source string in the translation format.
+    bool ExportStrings(const std::string& path) const;
+
+    // ── Variables and evaluation ───────────────────────────────────────────
+    u32 GetVariableCount() const { return m_VarCount; }
+    std::string_view GetVariableName(u32 var) const;
+
+    /// Run a condition; kNone is true.
+    bool Test(u32 code, DialogueVariables& vars) const;
+    /// Run a node's actions (kNone does nothing).
+    void Run(u32 code, DialogueVariables& vars) const;
+    /// The choices of `node` whose conditions hold, in order.
+    void GetAvailableChoices(u32 node, DialogueVariables& vars, std::vector<u32>& out) const;
+    /// Where Advance() goes from `node`: the first link whose condition
+    /// holds, or kNone to end.
+    u32  GetNextNode(u32 node, DialogueVariables& vars) const;
+
+private:
+    bool Parse();
+    /// Bank variable → store index, built once per store.
+    const std::vector<u32>& Bind(DialogueVariables& vars) const;
+    f64  Execute(u32 code, DialogueVariables& vars) const;
+    std::string_view Chars(u32 offset, u32 length) const;
+
+    std::string     m_Name;
+    MappedFile      m_File;
+    std::vector<u8> m_Bytes;
+    const u8* m_Data = nullptr;
+    size_t    m_Size = 0;
+
+    u32 m_NodeCount = 0, m_ChoiceCount = 0, m_LinkCount = 0, m_StringCount = 0;
+    u32 m_VarCount = 0, m_CodeSize = 0, m_CharBytes = 0, m_Start = kNone;
+    const u8* m_Nodes = nullptr;
+    const u8* m_Choices = nullptr;
+    const u8* m_Links = nullptr;
+    const u8* m_Strings = nullptr;
+    const u8* m_Names = nullptr;
+    const u8* m_Order = nullptr;
+    const u8* m_Code = nullptr;
+    const u8* m_Chars = nullptr;
+
+    std::vector<std::string> m_Translation;     // per string; used where m_Translated
+    std::vector<u8>          m_Translated;
+
+    mutable u32              m_BoundStore = 0;
+    mutable std::vector<u32> m_Slots;
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// DialogueCompiler — source or trees → bank bytes
+// ════════════════════════════════════════════════════════════════════════════
+class DialogueCompiler {
+public:
+    /// Compile ".gvdlg" source (see the top of this file).  On failure
+    /// `error` reads "<name>:<line>: <message>".
+    static bool CompileSource(const std::string& source, const std::string& name,
+                              std::vector<u8>& out, std::string& error);
+
+    /// Cook an in-code tree: nextNodeID becomes a link, requiredFlag a
+    /// condition and setFlag an action.  onEnter/onExit callbacks can't be
+    /// stored and are skipped.
+    static bool CompileTree(const DialogueTree& tree, std::vector<u8>& out, std::string& error);
+
+    /// Read a .gvdlg file, compile it and write a .gvdb.
+    static bool CompileFile(const std::string& srcPath, const std::string& dstPath, std::string& error);
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// DialogueLibrary — banks by name, opened on first use
+// ════════════════════════════════════════════════════════════════════════════
+class DialogueLibrary {
+public:
+    void Register(const std::string& name, const std::string& path);
+    /// Register every .gvdb in `directory` under its file stem.
+    u32  RegisterDirectory(const std::string& directory);
+
+    /// The bank, opening it on first use; nullptr if unknown or unreadable.
+    Shared<DialogueBank> Get(const std::string& name);
+    bool IsLoaded(const std::string& name) const;
+    void Unload(const std::string& name);
+    /// Close banks nothing else holds.  Returns how many were closed.
+    u32  UnloadUnused();
+    u32  GetLoadedCount() const;
+
+    /// Translate banks from "<bank>.<language>.tsv" next to each .gvdb
+    /// ("" = source text).  Applies to open banks and later loads.
+    void SetLanguage(const std::string& language);
+    const std::string& GetLanguage() const { return m_Language; }
+
+private:
+    struct Entry {
+        std::string path;
+        Shared<DialogueBank> bank;
+    };
+    void Translate(Entry& entry) const;
+
+    std::unordered_map<std::string, Entry> m_Entries;
+    std::string m_Language;
+};
+
+} // namespace gv
@@ -12,6 +12,7 @@
 #include "core/Types.h"
 #include "core/Math.h"
 #include "core/Component.h"
+#include "animation/AnimStateMachine.h"
 #include <string>
 #include <vector>
 #include <functional>
@@ -59,6 +60,8 @@ struct SortLayer {
 class SpriteComponent : public Component {
 public:
     std::string GetTypeName() const override { return "Sprite"; }
+    bool UpdatesOwner() const override { return false; }
+    GV_SNAPSHOT_COMPONENT(SpriteComponent)
 
     // ── Visual properties ──────────────────────────────────────────────────
     u32  textureID     = 0;            // GL texture handle (0 = white/colored)
@@ -100,7 +103,19 @@ public:
                 if (!animLooping) animPlaying = false;
             }
         }
-        // Update UVs based on current frame
+        UpdateFrameUVs();
+    }
+
+    /// Show frame `frame` of the sheet (used when a state machine drives
+    /// the animation instead of UpdateAnimation).
+    void SetFrame(i32 frame) {
+        currentFrame = frame < 0 ? 0 : (frame >= frameCount ? frameCount - 1 : frame);
+        UpdateFrameUVs();
+    }
+
+    // Update UVs based on current frame
+    void UpdateFrameUVs() {
+        if (columns < 1 || frameCount < 1) return;
         i32 rows = (frameCount + columns - 1) / columns;
         i32 col = currentFrame % columns;
         i32 row = currentFrame / columns;
@@ -117,6 +132,8 @@ public:
 class RigidBody2D : public Component {
 public:
     std::string GetTypeName() const override { return "RigidBody2D"; }
+    bool UpdatesOwner() const override { return false; }
+    GV_SNAPSHOT_COMPONENT(RigidBody2D)
 
     BodyType2D bodyType   = BodyType2D::Dynamic;
     f32  mass             = 1.0f;
@@ -136,6 +153,7 @@ public:
 class Collider2D : public Component {
 public:
     std::string GetTypeName() const override { return "Collider2D"; }
+    bool UpdatesOwner() const override { return false; }
 
     ColliderShape2D shape = ColliderShape2D::Box;
     Vec2 offset  { 0, 0 };   // offset from transform origin
@@ -151,6 +169,7 @@ public:
 class TileMapComponent : public Component {
 public:
     std::string GetTypeName() const override { return "TileMap"; }
+    bool UpdatesOwner() const override { return false; }
 
     i32  mapWidth  = 16;
     i32  mapHeight = 16;
@@ -185,6 +204,7 @@ public:
 class Label2D : public Component {
 public:
     std::string GetTypeName() const override { return "Label2D"; }
+    bool UpdatesOwner() const override { return false; }
 
     std::string text      = "Hello";
     f32  fontSize         = 16.0f;
@@ -198,6 +218,7 @@ public:
 class ParticleEmitter2D : public Component {
 public:
     std::string GetTypeName() const override { return "ParticleEmitter2D"; }
+    bool UpdatesOwner() const override { return false; }
 
     f32  emitRate     = 20.0f;     // particles per second
     f32  lifetime     = 2.0f;      // particle lifetime in seconds
@@ -232,6 +253,7 @@ using Collision2DCallback = std::function<void(const Collision2DInfo&)>;
 class CollisionListener2D : public Component {
 public:
     std::string GetTypeName() const override { return "CollisionListener2D"; }
+    bool UpdatesOwner() const override { return false; }
 
     // User sets these callbacks
     Collision2DCallback onCollisionEnter;
@@ -252,6 +274,12 @@ public:
 class PlatformerController2D : public Component {
 public:
     std::string GetTypeName() const override { return "PlatformerController2D"; }
+    bool UpdatesOwner() const override { return false; }
+    Unique<Component> SaveState() const override { return MakeUnique<PlatformerController2D>(*this); }
+    void LoadState(const Component& saved) override {
+        *this = static_cast<const PlatformerController2D&>(saved);
+        inputX = 0.0f; inputJump = false; inputJumpHeld = false;   // never carry input out of play
+    }
 
     // ── Movement tuning ────────────────────────────────────────────────────
     f32  moveSpeed          = 8.0f;    // horizontal movement speed
@@ -383,6 +411,8 @@ public:
 class Camera2DFollow : public Component {
 public:
     std::string GetTypeName() const override { return "Camera2DFollow"; }
+    bool UpdatesOwner() const override { return false; }
+    GV_SNAPSHOT_COMPONENT(Camera2DFollow)
 
     u32  targetObjectID  = 0;          // ID of the object to follow
     Vec2 offset          { 0, 2.0f };  // camera offset from target
@@ -410,6 +440,7 @@ public:
 class AudioSource2D : public Component {
 public:
     std::string GetTypeName() const override { return "AudioSource2D"; }
+    bool UpdatesOwner() const override { return false; }
 
     std::string clipPath;            // file path to .wav/.mp3/.ogg
     f32  volume        = 1.0f;       // 0..1
@@ -434,26 +465,88 @@ struct AnimState2D {
     i32  endFrame   = 0;
     f32  frameRate  = 12.0f;
     bool loop       = true;
+    std::vector<AnimGraphDesc::Event> events;   // e.g. { 0.5f, "footstep" }
+
+    i32 GetFrameCount() const { return endFrame >= startFrame ? endFrame - startFrame + 1 : 1; }
 };
 
 // ============================================================================
 // AnimStateMachine2D — manages multiple animation states for a sprite
 // ============================================================================
+// Without transitions, gameplay code picks the state with SetState().  Add
+// parameters and transitions and call Build(): the compiled machine then
+// switches states by itself and Scene2D steps every machine in one batch,
+// showing frame startFrame + n of the sprite's sheet (so the sprite's
+// frameCount / columns describe the whole sheet).
 class AnimStateMachine2D : public Component {
 public:
     std::string GetTypeName() const override { return "AnimStateMachine2D"; }
+    bool UpdatesOwner() const override { return false; }
+    GV_SNAPSHOT_COMPONENT(AnimStateMachine2D)
 
     std::vector<AnimState2D> states;
     std::string currentStateName = "Idle";
     i32  currentStateIdx = 0;
 
+    // ── Transition graph (used once built) ─────────────────────────────────
+    std::vector<AnimGraphDesc::Parameter>  parameters;
+    std::vector<AnimGraphDesc::Transition> transitions;
+    AnimStateMachine machine;
+
     void AddState(const std::string& name, i32 startFrame, i32 endFrame,
                   f32 fps = 12.0f, bool loop = true) {
-        states.push_back({ name, startFrame, endFrame, fps, loop });
+        states.push_back({ name, startFrame, endFrame, fps, loop, {} });
+    }
+
+    void AddParameter(const std::string& name, AnimParamType type, f32 defaultValue = 0.0f) {
+        parameters.push_back({ name, type, defaultValue });
+    }
+
+    AnimGraphDesc::Transition& AddTransition(const std::string& from, const std::string& to,
+                                             f32 duration = 0.0f) {
+        transitions.emplace_back();
+        transitions.back().from = from;
+        transitions.back().to = to;
+        transitions.back().duration = duration;
+        return transitions.back();
+    }
+
+    AnimGraphDesc::Transition& AddAnyTransition(const std::string& to, f32 duration = 0.0f) {
+        return AddTransition("", to, duration);
+    }
+
+    /// Compile states, parameters and transitions; the machine starts in
+    /// currentStateName if it names a state.  A state lasts its frame count
+    /// over its frame rate.
+    bool Build(std::string* error = nullptr) {
+        AnimGraphDesc desc;
+        desc.parameters = parameters;
+        desc.transitions = transitions;
+        for (const auto& st : states) {
+            auto& s = desc.AddState(st.name, static_cast<f32>(st.GetFrameCount()) /
+                                             (st.frameRate > 0.0f ? st.frameRate : 1.0f), st.loop);
+            s.events = st.events;
+        }
+        std::string message;
+        Shared<const AnimGraph> graph = AnimGraph::Compile(desc, message);
+        if (!graph) {
+            if (error) *error = message;
+            return false;
+        }
+        machine.SetGraph(std::move(graph));
+        u32 start = machine.GetGraph()->FindState(currentStateName);
+        if (start != AnimStateMachine::kNone) machine.Play(start);
+        SyncState();
+        return true;
     }
 
     void SetState(const std::string& name) {
         if (name == currentStateName) return;
+        if (machine.IsValid()) {
+            u32 id = machine.GetGraph()->FindState(name);
+            if (id != AnimStateMachine::kNone) { machine.Play(id); SyncState(); }
+            return;
+        }
         for (i32 i = 0; i < static_cast<i32>(states.size()); i++) {
             if (states[i].name == name) {
                 currentStateName = name;
@@ -463,6 +556,25 @@ public:
         }
     }
 
+    /// Mirror the machine's state into currentStateIdx / currentStateName.
+    void SyncState() {
+        if (!machine.IsValid()) return;
+        i32 idx = static_cast<i32>(machine.GetState());
+        if (idx == currentStateIdx && currentStateName == machine.GetGraph()->GetStateName(machine.GetState())) return;
+        currentStateIdx = idx;
+        currentStateName = machine.GetGraph()->GetStateName(machine.GetState());
+    }
+
+    /// Sheet frame for the machine's current state and time.
+    i32 GetFrame() const {
+        if (!machine.IsValid() || currentStateIdx < 0 || currentStateIdx >= static_cast<i32>(states.size()))
+            return 0;
+        const AnimState2D& st = states[currentStateIdx];
+        i32 frames = st.GetFrameCount();
+        i32 frame = static_cast<i32>(machine.GetClipTime() * static_cast<f32>(frames));
+        return st.startFrame + (frame < frames ? frame : frames - 1);
+    }
+
     AnimState2D* GetCurrentState() {
         if (currentStateIdx >= 0 && currentStateIdx < static_cast<i32>(states.size()))
             return &states[currentStateIdx];
@@ -476,6 +588,8 @@ public:
 class Collectible2D : public Component {
 public:
     std::string GetTypeName() const override { return "Collectible2D"; }
+    bool UpdatesOwner() const override { return false; }
+    GV_SNAPSHOT_COMPONENT(Collectible2D)
 
     enum class Type { Coin, PowerUp, Health, Key, Star, Custom };
     Type type           = Type::Coin;
@@ -501,6 +615,7 @@ public:
 class Hazard2D : public Component {
 public:
     std::string GetTypeName() const override { return "Hazard2D"; }
+    bool UpdatesOwner() const override { return false; }
 
     enum class Type { Spike, Lava, Enemy, Projectile, Pit, Custom };
     Type type        = Type::Spike;
@@ -518,6 +633,8 @@ public:
 class GameState2D : public Component {
 public:
     std::string GetTypeName() const override { return "GameState2D"; }
+    bool UpdatesOwner() const override { return false; }
+    GV_SNAPSHOT_COMPONENT(GameState2D)
 
     i32  score       = 0;
     i32  lives       = 3;
@@ -543,6 +660,8 @@ public:
 class CarController2D : public Component {
 public:
     std::string GetTypeName() const override { return "CarController2D"; }
+    bool UpdatesOwner() const override { return false; }
+    GV_SNAPSHOT_COMPONENT(CarController2D)
 
     // ── Movement & physics ─────────────────────────────────────────────────
     f32  maxSpeed           = 15.0f;   // top speed
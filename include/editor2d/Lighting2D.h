@@ -34,6 +34,7 @@ class GameObject;
 class AmbientLight2D : public Component {
 public:
     std::string GetTypeName() const override { return "AmbientLight2D"; }
+    bool UpdatesOwner() const override { return false; }
 
     Vec4 color      { 0.15f, 0.15f, 0.2f, 1.0f };  // dark blue-ish default
     f32  intensity  = 0.3f;                           // 0 = pitch black, 1 = full bright
@@ -45,6 +46,7 @@ public:
 class PointLight2D : public Component {
 public:
     std::string GetTypeName() const override { return "PointLight2D"; }
+    bool UpdatesOwner() const override { return false; }
 
     // ── Appearance ─────────────────────────────────────────────────────────
     Vec4 color       { 1.0f, 0.9f, 0.7f, 1.0f };    // warm yellow default
@@ -72,6 +74,7 @@ public:
 class SpotLight2D : public Component {
 public:
     std::string GetTypeName() const override { return "SpotLight2D"; }
+    bool UpdatesOwner() const override { return false; }
 
     Vec4 color         { 1, 1, 1, 1 };
     f32  intensity     = 1.0f;
@@ -19,6 +19,7 @@
 
 #include "core/Types.h"
 #include "core/GameObject.h"
+#include "core/PlaySnapshot.h"
 #include "editor2d/Editor2DTypes.h"
 #include <string>
 #include <vector>
@@ -33,13 +34,17 @@ public:
     explicit Scene2D(const std::string& name = "Untitled 2D Scene")
         : m_Name(name) {}
 
-    ~Scene2D() = default;
+    ~Scene2D() {
+        for (auto& o : m_Objects) o->SetComponentJournal(nullptr);
+    }
 
     // ── Object management ──────────────────────────────────────────────────
     GameObject* CreateGameObject(const std::string& name = "Sprite") {
         auto obj = MakeShared<GameObject>(name);
         obj->SetID(m_NextID++);
+        obj->SetComponentJournal(&m_Snapshot);
         m_Objects.push_back(obj);
+        m_Snapshot.OnCreated(obj.get());
         return obj.get();
     }
 
@@ -66,15 +71,36 @@ public:
         // Cap delta time to avoid spiral of death
         if (dt > 0.05f) dt = 0.05f;
 
+        // Step compiled animation state machines in one batch
+        m_AnimBatch.clear();
+        for (auto& o : m_Objects) {
+            if (!o->IsActive()) continue;
+            auto* asm2d = o->GetComponent<AnimStateMachine2D>();
+            if (!asm2d || !asm2d->machine.IsValid()) continue;
+            m_Snapshot.Touch(o.get());
+            m_AnimBatch.push_back(&asm2d->machine);
+        }
+        AnimStateMachine::UpdateBatch(m_AnimBatch.data(), m_AnimBatch.size(), dt);
+
         // Update sprite animations
         for (auto& o : m_Objects) {
             if (!o->IsActive()) continue;
             auto* spr = o->GetComponent<SpriteComponent>();
+            auto* asm2d = o->GetComponent<AnimStateMachine2D>();
+            auto* coll = o->GetComponent<Collectible2D>();
+            if (m_Snapshot.IsRecording() &&
+                ((spr && spr->animPlaying) || asm2d || (coll && !coll->collected) ||
+                 o->HasUpdateLogic()))
+                m_Snapshot.Touch(o.get());
+
             if (spr) spr->UpdateAnimation(dt);
 
             // Update animation state machine → sprite
-            auto* asm2d = o->GetComponent<AnimStateMachine2D>();
-            if (asm2d && spr) {
+            if (asm2d && spr && asm2d->machine.IsValid()) {
+                asm2d->SyncState();
+                spr->animPlaying = false;
+                spr->SetFrame(asm2d->GetFrame());
+            } else if (asm2d && spr) {
                 auto* state = asm2d->GetCurrentState();
                 if (state) {
                     spr->frameRate = state->frameRate;
@@ -88,7 +114,6 @@ public:
             }
 
             // Update collectible bob
-            auto* coll = o->GetComponent<Collectible2D>();
             if (coll && !coll->collected) {
                 coll->UpdateBob(dt);
             }
@@ -108,52 +133,26 @@ public:
     // ── Play mode ──────────────────────────────────────────────────────────
     bool IsPlaying() const { return m_Playing; }
 
+    /// Enter play mode.  O(1): state is saved lazily, per object, the first
+    /// time the simulation touches it (see PlaySnapshot).
     void BeginPlay() {
         if (m_Playing) return;
-        // Snapshot positions/velocities so we can restore on stop
-        m_Snapshot.clear();
-        for (auto& o : m_Objects) {
-            ObjectSnapshot snap;
-            snap.id = o->GetID();
-            snap.position = o->GetTransform().position;
-            snap.scale = o->GetTransform().scale;
-            snap.rotation = o->GetTransform().rotation;
-            auto* rb = o->GetComponent<RigidBody2D>();
-            if (rb) { snap.velocity = rb->velocity; snap.angularVel = rb->angularVel; }
-            auto* pc = o->GetComponent<PlatformerController2D>();
-            if (pc) { snap.isGrounded = pc->isGrounded; snap.isDead = pc->isDead; }
-            auto* coll = o->GetComponent<Collectible2D>();
-            if (coll) { snap.collected = coll->collected; }
-            auto* gs = o->GetComponent<GameState2D>();
-            if (gs) { snap.score = gs->score; snap.lives = gs->lives; snap.coins = gs->coins; snap.gameOver = gs->gameOver; }
-            m_Snapshot.push_back(snap);
-        }
+        m_Snapshot.Begin(m_NextID);
         m_Playing = true;
     }
 
+    /// Leave play mode, restoring only the objects play mode changed.
     void StopPlay() {
         if (!m_Playing) return;
         m_Playing = false;
-        // Restore from snapshot
-        for (auto& snap : m_Snapshot) {
-            auto* obj = FindByID(snap.id);
-            if (!obj) continue;
-            obj->GetTransform().position = snap.position;
-            obj->GetTransform().scale = snap.scale;
-            obj->GetTransform().rotation = snap.rotation;
-            auto* rb = obj->GetComponent<RigidBody2D>();
-            if (rb) { rb->velocity = snap.velocity; rb->angularVel = snap.angularVel; }
-            auto* pc = obj->GetComponent<PlatformerController2D>();
-            if (pc) { pc->isGrounded = snap.isGrounded; pc->isDead = snap.isDead;
-                       pc->inputX = 0; pc->inputJump = false; pc->inputJumpHeld = false; }
-            auto* coll = obj->GetComponent<Collectible2D>();
-            if (coll) { coll->collected = snap.collected; }
-            auto* gs = obj->GetComponent<GameState2D>();
-            if (gs) { gs->score = snap.score; gs->lives = snap.lives; gs->coins = snap.coins; gs->gameOver = snap.gameOver; }
-        }
-        m_Snapshot.clear();
+        m_PendingDestroy.clear();
+        m_NextID = m_Snapshot.End(m_Objects,
+            [this](GameObject* obj) { obj->SetComponentJournal(&m_Snapshot); }, [](GameObject*) {},
+            [](Component*) {}, [](Component*) {});
     }
 
+    const PlaySnapshot& GetPlaySnapshot() const { return m_Snapshot; }
+
     // ── Sorting layers ─────────────────────────────────────────────────────
     std::vector<SortLayer>& GetSortLayers() { return m_SortLayers; }
     const std::vector<SortLayer>& GetSortLayers() const { return m_SortLayers; }
@@ -301,6 +300,7 @@ private:
             if (!o->IsActive()) continue;
             auto* rb = o->GetComponent<RigidBody2D>();
             if (!rb || rb->bodyType == BodyType2D::Static) continue;
+            m_Snapshot.Touch(o.get());
 
             // Apply gravity (skip kinematic)
             if (rb->bodyType == BodyType2D::Dynamic) {
@@ -326,7 +326,7 @@ private:
         // 2. Reset ground flags for platformer controllers
         for (auto& o : m_Objects) {
             auto* pc = o->GetComponent<PlatformerController2D>();
-            if (pc) pc->isGrounded = false;
+            if (pc) { m_Snapshot.Touch(o.get()); pc->isGrounded = false; }
         }
 
         // 3. Collision detection & resolution (multiple iterations)
@@ -512,6 +512,7 @@ private:
             auto* carCtrl = o->GetComponent<CarController2D>();
             auto* rb = o->GetComponent<RigidBody2D>();
             if (carCtrl && rb) {
+                m_Snapshot.Touch(o.get());
                 carCtrl->UpdateController(dt, rb);
             }
         }
@@ -523,12 +524,14 @@ private:
         auto* coll = item->GetComponent<Collectible2D>();
         if (!pc || !coll || coll->collected) return;
 
+        m_Snapshot.Touch(item);
         coll->collected = true;
 
         // Find game state and update score
         for (auto& o : m_Objects) {
             auto* gs = o->GetComponent<GameState2D>();
             if (gs) {
+                m_Snapshot.Touch(o.get());
                 gs->AddScore(coll->scoreValue);
                 if (coll->type == Collectible2D::Type::Coin) gs->AddCoin();
                 break;
@@ -545,6 +548,7 @@ private:
         auto* pc = victim->GetComponent<PlatformerController2D>();
         auto* haz = hazardObj->GetComponent<Hazard2D>();
         if (!pc || !haz || pc->isDead) return;
+        m_Snapshot.Touch(victim);
 
         // Apply knockback
         auto* rb = victim->GetComponent<RigidBody2D>();
@@ -559,6 +563,7 @@ private:
         for (auto& o : m_Objects) {
             auto* gs = o->GetComponent<GameState2D>();
             if (gs) {
+                m_Snapshot.Touch(o.get());
                 gs->Die();
                 if (gs->gameOver) pc->isDead = true;
                 break;
@@ -583,7 +588,7 @@ private:
             // Award points
             for (auto& o : m_Objects) {
                 auto* gs = o->GetComponent<GameState2D>();
-                if (gs) { gs->AddScore(200); break; }
+                if (gs) { m_Snapshot.Touch(o.get()); gs->AddScore(200); break; }
             }
             return;
         }
@@ -597,7 +602,7 @@ private:
             DestroyGameObject(a);
             for (auto& o : m_Objects) {
                 auto* gs = o->GetComponent<GameState2D>();
-                if (gs) { gs->AddScore(200); break; }
+                if (gs) { m_Snapshot.Touch(o.get()); gs->AddScore(200); break; }
             }
         }
     }
@@ -612,6 +617,7 @@ private:
 
             auto* target = FindByID(cam->targetObjectID);
             if (!target) continue;
+            m_Snapshot.Touch(o.get());
 
             hasCameraFollow = true;
             Vec2 targetPos(target->GetTransform().position.x + cam->offset.x,
@@ -652,10 +658,12 @@ private:
 
     void FlushDestroyQueue() {
         for (auto* obj : m_PendingDestroy) {
-            m_Objects.erase(
-                std::remove_if(m_Objects.begin(), m_Objects.end(),
-                    [obj](const Shared<GameObject>& o) { return o.get() == obj; }),
-                m_Objects.end());
+            auto it = std::find_if(m_Objects.begin(), m_Objects.end(),
+                [obj](const Shared<GameObject>& o) { return o.get() == obj; });
+            if (it == m_Objects.end()) continue;
+            obj->SetComponentJournal(nullptr);
+            m_Snapshot.OnDestroyed(*it, static_cast<size_t>(it - m_Objects.begin()));
+            m_Objects.erase(it);
         }
         m_PendingDestroy.clear();
     }
@@ -667,20 +675,11 @@ private:
     u32 m_NextID = 1;
     bool m_Playing = false;
 
-    // Snapshot for restoring scene state on stop
-    struct ObjectSnapshot {
-        u32 id = 0;
-        Vec3 position, scale;
-        Quaternion rotation;
-        Vec2 velocity{0,0};
-        f32 angularVel = 0;
-        bool isGrounded = false;
-        bool isDead = false;
-        bool collected = false;
-        i32 score = 0, lives = 3, coins = 0;
-        bool gameOver = false;
-    };
-    std::vector<ObjectSnapshot> m_Snapshot;
+    // Copy-on-write journal for restoring scene state on stop
+    PlaySnapshot m_Snapshot;
+
+    // Machines stepped this frame (kept to reuse its storage)
+    std::vector<AnimStateMachine*> m_AnimBatch;
 };
 
 } // namespace gv
@@ -3,8 +3,6 @@
 // ============================================================================
 // Stub classes for systems that will be fleshed out later:
 //   • AnimationSystem     — skeletal & keyframe animation
-//   • ShaderLibrary       — shader hot-reload & cache
-//   • PostProcessing      — fullscreen effects pipeline
 //   • AudioEngine         — sound playback & spatial audio
 //   • NetworkManager      — multiplayer / replication
 //   • InputManager        — keyboard, mouse, gamepad abstraction
@@ -24,45 +22,9 @@ namespace gv {
 
 // Animation System — see animation/Animation.h for full implementation
 
-// ============================================================================
-// Shader Library (placeholder)
-// ============================================================================
-class ShaderLibrary {
-public:
-    /// Load a shader from files and cache it under the given name.
-    bool Load(const std::string& name, const std::string& vertPath, const std::string& fragPath);
-
-    /// Retrieve a cached shader.
-    // Shader* Get(const std::string& name);
-
-    /// Reload all shaders from disk (hot-reload support).
-    void ReloadAll();
-
-private:
-    // std::unordered_map<std::string, Unique<Shader>> m_Shaders;
-};
+// Shader Library — see renderer/ShaderLibrary.h for full implementation
 
-// ============================================================================
-// Post-Processing Pipeline (placeholder)
-// ============================================================================
-class PostProcessing {
-public:
-    void Init(u32 width, u32 height);
-    void Resize(u32 width, u32 height);
-
-    /// Add a named post-process effect (bloom, SSAO, tone-mapping, …).
-    void AddEffect(const std::string& effectName);
-    void RemoveEffect(const std::string& effectName);
-
-    /// Run the full chain on the current framebuffer.
-    void Apply();
-
-private:
-    std::vector<std::string> m_Effects;
-    u32 m_FBO = 0;      // framebuffer object
-    u32 m_ColorTex = 0;  // colour attachment
-    u32 m_DepthRBO = 0; // depth renderbuffer
-};
+// Post-Processing — see renderer/PostProcessing.h for full implementation
 
 // ============================================================================
 // Audio Engine (miniaudio-backed)
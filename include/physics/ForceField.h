@@ -0,0 +1,101 @@
+// ============================================================================
+// GameVoid Engine — Force Fields
+// ============================================================================
+// Data-driven force volumes (directional, radial, vortex, drag, buoyancy and
+// wind noise) evaluated by PhysicsWorld during each fixed step.  Fields are
+// plain descriptors so they can be authored in an INI-style file and loaded
+// with ForceFieldLibrary::LoadFromFile().
+//
+// Evaluation is batched: dynamic bodies are copied into structure-of-arrays
+// lanes sorted by a uniform grid, and each field walks only the contiguous
+// lane ranges of the cells it overlaps with branch-free, auto-vectorisable
+// loops.
+// ============================================================================
+#pragma once
+
+#include "core/Math.h"
+#include "core/Types.h"
+#include <string>
+#include <vector>
+
+namespace gv {
+
+enum class ForceFieldType  { Directional, Radial, Vortex, Drag, Buoyancy, WindNoise };
+enum class ForceFieldShape { Infinite, Sphere, Box };
+
+/// One force volume.  Only the fields relevant to `type` are read.
+struct ForceField {
+    std::string     name;
+    ForceFieldType  type  = ForceFieldType::Directional;
+    ForceFieldShape shape = ForceFieldShape::Sphere;
+    bool            enabled = true;
+
+    // Volume
+    Vec3 center      { 0, 0, 0 };
+    f32  radius      = 5.0f;          // Sphere
+    Vec3 halfExtents { 5, 5, 5 };     // Box (axis-aligned)
+    bool linearFalloff = false;       // Sphere only: strength fades to 0 at the rim
+
+    // Common
+    f32  strength          = 10.0f;   // N (or m/s² when massIndependent)
+    bool massIndependent   = false;   // treat strength as an acceleration
+    Vec3 direction         { 0, 1, 0 };  // Directional / WindNoise; Vortex axis
+
+    // Vortex
+    f32  inwardStrength    = 0.0f;    // pull toward the axis
+
+    // Drag / Buoyancy
+    f32  linearDrag        = 0.5f;    // N per m/s
+    f32  quadraticDrag     = 0.0f;    // N per (m/s)²
+
+    // Buoyancy
+    f32  fluidDensity      = 1000.0f; // kg/m³
+    f32  surfaceHeight     = 0.0f;    // world Y of the fluid surface
+
+    // WindNoise
+    f32  turbulence        = 0.5f;    // noise amplitude as a fraction of strength
+    f32  noiseFrequency    = 0.25f;   // 1/m
+    f32  noiseSpeed        = 1.0f;    // scroll rate of the noise field (1/s)
+
+    /// World-space bounds (infinite fields return a huge box).
+    void GetBounds(Vec3& outMin, Vec3& outMax) const;
+};
+
+/// Structure-of-arrays view of the bodies a field pass runs over.
+struct ForceFieldLanes {
+    std::vector<f32> px, py, pz;       // position
+    std::vector<f32> vx, vy, vz;       // velocity
+    std::vector<f32> mass;
+    std::vector<f32> halfHeight;       // vertical half-size (buoyancy)
+    std::vector<f32> volume;           // displaced volume when fully submerged
+    std::vector<f32> fx, fy, fz;       // accumulated force (output)
+
+    size_t Size() const { return px.size(); }
+    void   Resize(size_t n);
+};
+
+/// Evaluate one field over lanes [begin, end) and accumulate into fx/fy/fz.
+void EvaluateForceField(const ForceField& field, ForceFieldLanes& lanes,
+                        size_t begin, size_t end, f32 time, f32 gravityMagnitude);
+
+// ============================================================================
+// ForceFieldLibrary — INI-style loading / saving
+// ============================================================================
+//   [field]
+//   name=river
+//   type=directional | radial | vortex | drag | buoyancy | wind
+//   shape=infinite | sphere | box
+//   center=0 0 0
+//   radius=5
+//   halfExtents=10 2 40
+//   strength=12
+//   direction=1 0 0
+//   ...any other ForceField member by name
+class ForceFieldLibrary {
+public:
+    static std::vector<ForceField> LoadFromFile(const std::string& path);
+    static std::vector<ForceField> ParseString(const std::string& text);
+    static bool SaveToFile(const std::string& path, const std::vector<ForceField>& fields);
+};
+
+} // namespace gv
@@ -11,11 +11,14 @@
 #include "core/Component.h"
 #include "core/Math.h"
 #include "core/Types.h"
+#include "physics/ForceField.h"
 #include <vector>
 #include <string>
 
 namespace gv {
 
+class PlaySnapshot;
+
 // ─── Collider shapes ───────────────────────────────────────────────────────
 enum class ColliderType { Box, Sphere, Capsule, Mesh };
 
@@ -37,6 +40,7 @@ public:
     bool isTrigger = false;     // Trigger colliders generate events but no physics response
 
     std::string GetTypeName() const override { return "Collider"; }
+    bool UpdatesOwner() const override { return false; }
 };
 
 // ─── Rigid Body ────────────────────────────────────────────────────────────
@@ -77,6 +81,8 @@ public:
     Vec3 GetInverseInertiaTensor(const Collider* collider, const Vec3& scale) const;
 
     std::string GetTypeName() const override { return "RigidBody"; }
+    bool UpdatesOwner() const override { return false; }
+    GV_SNAPSHOT_COMPONENT(RigidBody)
 
     void OnUpdate(f32 /*dt*/) override {
         // Integration is handled centrally by PhysicsWorld; this callback
@@ -106,6 +112,7 @@ public:
     Vec3 gravity        { 0, -9.81f, 0 };
     f32  fixedTimeStep  = 1.0f / 60.0f;   // 60 Hz physics tick
     i32  maxSubSteps    = 8;
+    f32  forceFieldCellSize = 4.0f;   // broadphase cell for force-field evaluation (m)
 
     // ── Lifecycle ──────────────────────────────────────────────────────────
     /// Initialise internal structures.
@@ -119,8 +126,21 @@ public:
 
     // ── Queries ────────────────────────────────────────────────────────────
     /// Cast a ray and return the first hit (placeholder API).
+    /// `ignore` lets a body cast from inside its own collider (e.g. wheel rays).
     bool Raycast(const Vec3& origin, const Vec3& direction, f32 maxDistance,
-                 CollisionInfo& outHit) const;
+                 CollisionInfo& outHit, const RigidBody* ignore = nullptr) const;
+
+    // ── Force fields ───────────────────────────────────────────────────────
+    /// Add a force volume; it is applied to every dynamic body inside it each
+    /// fixed step.  Returns the field's index.
+    u32  AddForceField(const ForceField& field);
+    /// Remove all fields with the given name.  Returns true if any were removed.
+    bool RemoveForceField(const std::string& name);
+    void ClearForceFields() { m_ForceFields.clear(); }
+    /// Append the fields described in an INI-style file (see ForceFieldLibrary).
+    bool LoadForceFields(const std::string& path);
+    std::vector<ForceField>&       GetForceFields()       { return m_ForceFields; }
+    const std::vector<ForceField>& GetForceFields() const { return m_ForceFields; }
 
     // ── Collision results from last step ───────────────────────────────────
     const std::vector<CollisionInfo>& GetCollisions() const { return m_Collisions; }
@@ -129,6 +149,10 @@ public:
     void RegisterBody(RigidBody* body);
     void UnregisterBody(RigidBody* body);
 
+    /// Play-mode journal notified before a body's owner is first moved
+    /// (set by Scene::SetPhysicsWorld; null = no recording).
+    void SetPlaySnapshot(PlaySnapshot* snapshot) { m_PlaySnapshot = snapshot; }
+
     // ── Collision geometry tests ────────────────────────────────────────
     /// Test two axis-aligned bounding boxes for overlap.
     static bool TestAABB(const Vec3& minA, const Vec3& maxA,
@@ -151,10 +175,25 @@ private:
     void IntegrateBodies(f32 dt);
     void DetectCollisions();
     void ResolveCollisions();
+    void ApplyForceFields();
+    void ResolveBodyColliders();
 
     std::vector<RigidBody*>    m_Bodies;
     std::vector<CollisionInfo> m_Collisions;
+    std::vector<Collider*>     m_BodyColliders;   // parallel to m_Bodies, refreshed each step
     f32                        m_Accumulator = 0.0f;
+    f32                        m_SimTime     = 0.0f;
+    PlaySnapshot*              m_PlaySnapshot = nullptr;
+
+    // Force-field batch state (reused between steps to avoid reallocation)
+    std::vector<ForceField>    m_ForceFields;
+    ForceFieldLanes            m_FieldLanes;
+    struct FieldBody { RigidBody* body; Collider* collider; };
+    std::vector<FieldBody>     m_FieldBodies;     // lane index → body
+    std::vector<FieldBody>     m_FieldSorted;
+    std::vector<u32>           m_FieldCursor;
+    std::vector<u32>           m_FieldCellOf;     // gather index → cell
+    std::vector<u32>           m_FieldCellStart;  // cell → first lane (size cells+1)
 };
 
 } // namespace gv
@@ -19,6 +19,7 @@ public:
     ~Camera() override = default;
 
     std::string GetTypeName() const override { return "Camera"; }
+    bool UpdatesOwner() const override { return false; }
 
     // ── Projection parameters ──────────────────────────────────────────────
     ProjectionType projectionType = ProjectionType::Perspective;
@@ -0,0 +1,86 @@
+// ============================================================================
+// GameVoid Engine — Dynamic Resolution Governor
+// ============================================================================
+// Holds the frame inside a time budget by scaling the internal render
+// resolution:
+//   • Measured frame times (GPU when available, else CPU) are smoothed with
+//     an exponential moving average
+//   • Cost is assumed to follow pixel count (scale²), so the error is the
+//     relative scale change that would hit the budget: sqrt(target/time) - 1
+//   • A PID in velocity form turns the error into a scale change; the error
+//     is taken against the scale still waiting to be applied, so the
+//     integral doesn't wind up while a change is pending
+//   • The applied scale moves in fixed steps, never above the desired
+//     scale, with a cooldown between changes so targets aren't reallocated
+//     every frame; a frame far over budget skips the cooldown
+// Pure CPU logic — feed it timings, read back the scale.
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+
+namespace gv {
+
+struct DynamicResolutionSettings {
+    f32 targetMs       = 16.6f;  // frame budget
+    f32 minScale       = 0.5f;   // per-axis render scale bounds
+    f32 maxScale       = 1.0f;
+    f32 kp             = 0.2f;
+    f32 ki             = 0.1f;
+    f32 kd             = 0.05f;
+    f32 smoothing      = 0.2f;   // EMA weight of the newest sample
+    f32 deadband       = 0.03f;  // relative headroom treated as on target
+    f32 step           = 0.05f;  // applied scale changes in these increments
+    u32 cooldownFrames = 20;     // frames between applied changes
+    f32 panicRatio     = 1.5f;   // a frame this far over budget drops at once
+};
+
+class DynamicResolution {
+public:
+    DynamicResolution() = default;
+    explicit DynamicResolution(const DynamicResolutionSettings& settings) { Configure(settings); }
+
+    /// Apply new settings; the current scale is clamped into the new bounds.
+    void Configure(const DynamicResolutionSettings& settings);
+    const DynamicResolutionSettings& GetSettings() const { return m_Settings; }
+
+    /// Back to the maximum scale with the controller state cleared.
+    void Reset();
+
+    /// Feed one frame's timings in milliseconds.  `gpuMs` <= 0 means no GPU
+    /// measurement was available and `cpuMs` is used instead; non-positive
+    /// or non-finite samples are ignored.  Returns true when GetScale()
+    /// changed.
+    bool Update(f32 cpuMs, f32 gpuMs);
+
+    /// Applied per-axis scale (a multiple of `step` below maxScale).
+    f32 GetScale() const        { return m_Scale; }
+    /// Continuous controller output the applied scale is heading towards.
+    f32 GetDesiredScale() const { return m_Desired; }
+    /// Smoothed frame time, rescaled to the applied scale.
+    f32 GetFilteredMs() const   { return m_Filtered; }
+    /// Number of applied scale changes since the last Reset().
+    u32 GetChangeCount() const  { return m_Changes; }
+
+    /// Render-target size for an output size at the current scale.
+    u32 GetRenderWidth(u32 outputWidth) const   { return ScaledSize(outputWidth, m_Scale); }
+    u32 GetRenderHeight(u32 outputHeight) const { return ScaledSize(outputHeight, m_Scale); }
+    /// size * scale rounded to the nearest pixel, at least 1.
+    static u32 ScaledSize(u32 size, f32 scale);
+
+private:
+    f32 Quantise(f32 scale) const;
+    f32 Clamp(f32 scale) const;
+
+    DynamicResolutionSettings m_Settings;
+    f32  m_Scale    = 1.0f;
+    f32  m_Desired  = 1.0f;
+    f32  m_Filtered = 0.0f;
+    f32  m_Error1   = 0.0f;   // previous two errors (velocity-form PID)
+    f32  m_Error2   = 0.0f;
+    bool m_HaveSample = false;
+    u32  m_SinceChange = 0;
+    u32  m_Changes  = 0;
+};
+
+} // namespace gv
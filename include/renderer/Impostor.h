@@ -0,0 +1,111 @@
+// ============================================================================
+// GameVoid Engine — Billboard Impostors
+// ============================================================================
+// Far-away meshes are drawn as a single camera-facing quad textured from an
+// atlas of pre-rendered views:
+//   • Views are laid out on an N x N grid in octahedral space (whole sphere)
+//     or hemi-octahedral space (upper half only — trees, buildings), so
+//     neighbouring cells are neighbouring view directions
+//   • Each cell stores albedo + coverage, object-space normal and depth
+//     (0 = nearest to the viewer, 1 = farthest) over the mesh's bounding
+//     sphere, so the impostor can be relit and depth-corrected
+//   • At draw time the four cells around the view direction are blended
+// The baker rasterizes on the CPU, so atlases can be built headlessly; the
+// OpenGL renderer has a faster offscreen path producing the same layout.
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include "core/Math.h"
+#include <vector>
+
+namespace gv {
+
+class Mesh;
+
+// ── View-direction mapping ─────────────────────────────────────────────────
+// Directions point from the object towards the viewer, y up.  UVs are in
+// [0, 1]^2.
+
+/// Whole sphere: upper hemisphere in the central diamond, lower hemisphere
+/// folded into the corners.
+Vec2 OctahedralEncode(const Vec3& dir);
+Vec3 OctahedralDecode(const Vec2& uv);
+/// Upper hemisphere only, rotated to fill the square; directions below the
+/// horizon are clamped onto it.
+Vec2 HemiOctahedralEncode(const Vec3& dir);
+Vec3 HemiOctahedralDecode(const Vec2& uv);
+
+/// The basis an impostor cell is rendered with: `right` and `up` span the
+/// image plane for a viewer in direction `dir` (up follows +Y, or -Z when
+/// looking straight down).
+void ImpostorBasis(const Vec3& dir, Vec3& right, Vec3& up);
+
+struct ImpostorSettings {
+    u32  framesPerSide = 8;      // grid of views (N x N)
+    u32  frameSize     = 64;     // pixels per view
+    bool hemisphere    = true;   // hemi-octahedral (ground-bound objects)
+    u32  supersample   = 2;      // software baker: samples per pixel per axis
+    u32  dilation      = 4;      // pixels of colour bleed around silhouettes
+};
+
+/// Cell centres sit on a grid that includes the borders (i / (N - 1)), so
+/// the horizon and the poles are captured exactly.
+Vec3 ImpostorFrameDirection(const ImpostorSettings& settings, u32 x, u32 y);
+
+/// The four cells around a view direction and their bilinear weights.
+struct ImpostorFrameBlend {
+    u32 x[4] = { 0, 0, 0, 0 };
+    u32 y[4] = { 0, 0, 0, 0 };
+    f32 weight[4] = { 1, 0, 0, 0 };
+};
+ImpostorFrameBlend ImpostorFramesForDirection(const ImpostorSettings& settings, const Vec3& dir);
+
+// ── Atlas ──────────────────────────────────────────────────────────────────
+struct ImpostorAtlas {
+    ImpostorSettings settings;
+    Vec3 center { 0, 0, 0 };      // bounding sphere, mesh space
+    f32  radius = 0.0f;
+    u32  width = 0, height = 0;   // framesPerSide * frameSize; rows bottom-up
+    std::vector<u8> albedo;       // RGBA8, A = coverage
+    std::vector<u8> normal;       // RGBA8, RGB = normal * 0.5 + 0.5, A = coverage
+    std::vector<u8> depth;        // R8
+
+    u32 albedoTexture = 0, normalTexture = 0, depthTexture = 0;
+
+    ImpostorAtlas() = default;
+    ~ImpostorAtlas() { Release(); }
+    ImpostorAtlas(const ImpostorAtlas&) = delete;
+    ImpostorAtlas& operator=(const ImpostorAtlas&) = delete;
+
+    bool Empty() const { return albedo.empty(); }
+    /// Create / refresh the GL textures from the CPU data (needs a current GL
+    /// context; no-op in builds without GLFW).
+    void Upload();
+    void Release();
+};
+
+/// What to bake: a mesh with a flat colour, optionally multiplied by an
+/// RGBA8 albedo image sampled with the mesh's UVs.
+struct ImpostorSource {
+    const Mesh* mesh = nullptr;
+    Vec4        color { 1, 1, 1, 1 };
+    const u8*   albedoPixels = nullptr;
+    u32         albedoWidth = 0, albedoHeight = 0;
+};
+
+/// Size the atlas and fit the bounding sphere (no pixels).
+bool PrepareImpostorAtlas(const ImpostorSource& source, const ImpostorSettings& settings, ImpostorAtlas& out);
+/// CPU rasterizer.  Works without a GL context.
+bool BakeImpostorSoftware(const ImpostorSource& source, const ImpostorSettings& settings, ImpostorAtlas& out);
+/// Box-filter supersampled views into a prepared atlas.  The inputs are
+/// RGBA8 images (width * supersample) on a side, laid out like the atlas;
+/// normal.a != 0 marks covered samples and depth is read from red.
+/// Shared by the software and GPU bakers.
+void ResolveImpostorSamples(ImpostorAtlas& atlas, const u8* albedo, const u8* normal, const u8* depth,
+                            u32 supersample);
+/// Bleed colour, normal and depth into uncovered texels of each cell so
+/// filtering at the silhouette doesn't pull in black.  Coverage is kept.
+void DilateImpostorAtlas(ImpostorAtlas& atlas);
+
+} // namespace gv
@@ -21,6 +21,7 @@ public:
     f32  intensity = 0.15f;
 
     std::string GetTypeName() const override { return "AmbientLight"; }
+    bool UpdatesOwner() const override { return false; }
 };
 
 // ─── Directional Light ─────────────────────────────────────────────────────
@@ -31,6 +32,7 @@ public:
     f32  intensity = 1.0f;
 
     std::string GetTypeName() const override { return "DirectionalLight"; }
+    bool UpdatesOwner() const override { return false; }
 };
 
 // ─── Point Light ───────────────────────────────────────────────────────────
@@ -47,6 +49,7 @@ public:
     f32 range     = 50.0f;          // soft cut-off distance
 
     std::string GetTypeName() const override { return "PointLight"; }
+    bool UpdatesOwner() const override { return false; }
 };
 
 // ─── Spot Light (placeholder for future) ───────────────────────────────────
@@ -59,6 +62,7 @@ public:
     f32  outerCutoff = 17.5f;       // degrees
 
     std::string GetTypeName() const override { return "SpotLight"; }
+    bool UpdatesOwner() const override { return false; }
 };
 
 } // namespace gv
@@ -28,6 +28,7 @@ public:
     ~MaterialComponent() override = default;
 
     std::string GetTypeName() const override { return "Material"; }
+    bool UpdatesOwner() const override { return false; }
 
     // ── PBR properties (editable in Inspector) ─────────────────────────────
     Vec4 albedo     { 0.8f, 0.8f, 0.8f, 1.0f };  // base colour + alpha
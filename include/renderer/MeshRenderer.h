@@ -16,7 +16,10 @@ namespace gv {
 // Forward declarations (defined in Assets module)
 class Mesh;
 class Material;
+class MeshRegistry;
+struct MeshData;
 class IRenderer;
+struct ImpostorAtlas;
 
 // ── Built-in primitive shapes ──────────────────────────────────────────────
 /// Identifies which built-in mesh the renderer should draw.
@@ -39,6 +42,7 @@ public:
     ~MeshRenderer() override = default;
 
     std::string GetTypeName() const override { return "MeshRenderer"; }
+    bool UpdatesOwner() const override { return false; }
 
     // ── Built-in primitive (quick setup, no Mesh asset needed) ─────────────
     PrimitiveType primitiveType = PrimitiveType::None;
@@ -62,6 +66,25 @@ public:
         return primitiveType;
     }
 
+    // ── Impostor LOD (optional) ────────────────────────────────────────────
+    /// Beyond `impostorDistance` the object is drawn as a billboard from the
+    /// baked atlas.  Over the `impostorFade` metres before that, mesh and
+    /// impostor are dithered against each other so the switch doesn't pop.
+    /// 0 disables the tier.  The atlas comes from OpenGLRenderer::BakeImpostor
+    /// and is not saved with the scene; the distances are.
+    f32 impostorDistance = 0.0f;
+    f32 impostorFade     = 5.0f;
+    void SetImpostor(Shared<ImpostorAtlas> atlas)  { m_Impostor = std::move(atlas); }
+    Shared<ImpostorAtlas> GetImpostor() const      { return m_Impostor; }
+
+    /// 0 = mesh only, 1 = impostor only, in between = cross-fade.
+    f32 GetImpostorBlend(f32 distance) const {
+        if (!m_Impostor || impostorDistance <= 0.0f) return 0.0f;
+        f32 fade = impostorFade > 1e-4f ? impostorFade : 1e-4f;
+        f32 t = (distance - (impostorDistance - fade)) / fade;
+        return t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+    }
+
     // ── Asset-based data (used when primitiveType == None) ─────────────────
     void SetMesh(Shared<Mesh> mesh)         { m_Mesh = std::move(mesh); }
     void SetMaterial(Shared<Material> mat)   { m_Material = std::move(mat); }
@@ -69,6 +92,26 @@ public:
     Shared<Mesh>     GetMesh()     const { return m_Mesh; }
     Shared<Material> GetMaterial() const { return m_Material; }
 
+    // ── Shared meshes ──────────────────────────────────────────────────────
+    /// Draw `type` with the registry's shared mesh for it, so every object
+    /// showing the same primitive uses one set of GPU buffers.
+    void SetPrimitive(PrimitiveType type, MeshRegistry& registry);
+    /// Draw generated geometry (Primitives, ShapeLibrary or MeshBuilder
+    /// output).  Identical data from any object shares one mesh.
+    void SetMeshData(const MeshData& data, MeshRegistry& registry);
+    /// Drop this object's reference.  The registry frees the buffers once
+    /// nothing uses them and its cache budget is exceeded.
+    void ReleaseMesh() { m_Mesh.reset(); }
+
+    // ── Occlusion ──────────────────────────────────────────────────────────
+    /// Rasterized into the renderer's software depth buffer to hide what is
+    /// behind it.  Uses the occluder mesh if set, else the mesh if it is
+    /// small enough, else the built-in cube / plane.  An occluder mesh is a
+    /// low-poly stand-in and must lie inside the visible geometry.
+    bool occluder = false;
+    void SetOccluderMesh(Shared<Mesh> mesh) { m_OccluderMesh = std::move(mesh); }
+    Shared<Mesh> GetOccluderMesh() const    { return m_OccluderMesh; }
+
     void OnRender() override {
         // The actual draw call is issued by the Renderer which queries the
         // MeshRenderer for mesh/material data.  This callback is a hook for
@@ -78,6 +121,8 @@ public:
 private:
     Shared<Mesh>     m_Mesh;
     Shared<Material> m_Material;
+    Shared<Mesh>     m_OccluderMesh;
+    Shared<ImpostorAtlas> m_Impostor;
 };
 
 /// Component for 2D sprite rendering (quad with texture).
@@ -87,6 +132,7 @@ public:
     ~SpriteRenderer() override = default;
 
     std::string GetTypeName() const override { return "SpriteRenderer"; }
+    bool UpdatesOwner() const override { return false; }
 
     // Sprite-specific data
     std::string texturePath;        // path to the sprite texture
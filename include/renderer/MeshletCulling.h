@@ -0,0 +1,66 @@
+// ============================================================================
+// GameVoid Engine — Meshlet Culling
+// ============================================================================
+// CPU culling of a mesh's meshlets for one draw:
+//   • Frustum: each meshlet's bounding sphere, transformed to world space
+//   • Backface: the meshlet's normal cone against the camera position
+//     (skipped for non-uniform or mirroring model matrices, where the
+//     mesh-space cone no longer bounds the world-space normals)
+//   • Occlusion (optional): a caller-supplied sphere test, e.g. a HiZ buffer
+// Survivors are emitted as index ranges, with adjacent meshlets merged, in
+// the count/offset arrays glMultiDrawElements takes.
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include "core/Math.h"
+#include "assets/Meshlet.h"
+#include "renderer/Frustum.h"
+#include <functional>
+#include <vector>
+
+namespace gv {
+
+struct MeshletCullSettings {
+    bool frustum  = true;
+    bool backface = true;
+    /// Returns true if a world-space sphere is hidden.  Unset = no occlusion test.
+    std::function<bool(const Vec3& center, f32 radius)> occlusion;
+};
+
+struct MeshletCullStats {
+    u32 tested          = 0;
+    u32 frustumCulled   = 0;
+    u32 backfaceCulled  = 0;
+    u32 occlusionCulled = 0;
+    u32 visible         = 0;
+    u32 ranges          = 0;   // draw ranges after merging
+    u64 indicesDrawn    = 0;
+
+    void Reset() { *this = MeshletCullStats(); }
+    void Add(const MeshletCullStats& o) {
+        tested += o.tested; frustumCulled += o.frustumCulled; backfaceCulled += o.backfaceCulled;
+        occlusionCulled += o.occlusionCulled; visible += o.visible; ranges += o.ranges;
+        indicesDrawn += o.indicesDrawn;
+    }
+};
+
+/// Compacted visible index ranges (u32 indices) of one mesh.
+struct MeshletDrawList {
+    std::vector<i32>         counts;    // index count per range
+    std::vector<const void*> offsets;   // byte offset into the element buffer per range
+    std::vector<u32>         firstIndex;   // same ranges, in indices
+
+    void Clear() { counts.clear(); offsets.clear(); firstIndex.clear(); }
+    bool Empty() const { return counts.empty(); }
+};
+
+/// Cull `meshlets` (mesh space) drawn with `model`.  `frustum` and `cameraPos`
+/// are in world space.  Clears and fills `out`; returns the visible meshlet
+/// count.  `stats` (optional) is added to, not reset.
+u32 CullMeshlets(const MeshletData& meshlets, const Mat4& model, const Frustum& frustum,
+                 const Vec3& cameraPos, MeshletDrawList& out,
+                 const MeshletCullSettings& settings = MeshletCullSettings(),
+                 MeshletCullStats* stats = nullptr);
+
+} // namespace gv
@@ -0,0 +1,138 @@
+// ============================================================================
+// GameVoid Engine — Software Occlusion Culling
+// ============================================================================
+// A small CPU depth buffer (256x128 by default) that low-poly occluders are
+// rasterized into each frame, and that object bounds are tested against:
+//   • Occluders are transformed four lanes at a time (SSE2 where available,
+//     scalar otherwise), near-clipped, back-face culled and rasterized with
+//     edge functions, four pixels per step
+//   • Silhouette edges only cover pixels lying wholly inside them, so a slit
+//     between two occluders stays open however thin it is; edges shared by
+//     two front faces use pixel centres and leave no cracks.  Front faces
+//     under a pixel and a half thick, like the sides of a box seen almost
+//     edge-on, are dropped so the edges beside them count as outlines
+//   • Each pixel stores the farthest depth the occluder could have anywhere
+//     inside it, so the buffer never claims more than the occluders cover
+//   • Rows are split into bands rasterized on separate threads
+//   • A max-depth mip chain (HiZ) lets an occludee's screen rectangle be
+//     tested with at most a 4x4 block of texels
+// An occludee is hidden when its nearest depth lies behind every texel its
+// rectangle touches.  Boxes that cross the near plane are always visible.
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include "core/Math.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace gv {
+
+struct OcclusionSettings {
+    u32 width   = 256;
+    u32 height  = 128;
+    u32 threads = 0;                   // raster bands; 0 = up to 4 by core count
+    u32 maxOccluderTriangles = 4096;   // larger meshes are not used as occluders
+};
+
+struct OcclusionStats {
+    u32 occluders            = 0;
+    u32 trianglesIn          = 0;
+    u32 trianglesRasterized  = 0;   // after clipping and back-face culling
+    u32 tested               = 0;
+    u32 occluded             = 0;
+    f32 rasterMs             = 0.0f;   // transform + raster + HiZ
+
+    f32 CulledRatio() const { return tested ? static_cast<f32>(occluded) / static_cast<f32>(tested) : 0.0f; }
+};
+
+class OcclusionBuffer {
+public:
+    OcclusionBuffer() { Configure(OcclusionSettings()); }
+    explicit OcclusionBuffer(const OcclusionSettings& settings) { Configure(settings); }
+
+    /// Change resolution / threading.  Width is rounded up to a multiple of 4.
+    void Configure(const OcclusionSettings& settings);
+    const OcclusionSettings& GetSettings() const { return m_Settings; }
+
+    /// Start a frame: forget the previous occluders and reset the stats.
+    void BeginFrame(const Mat4& viewProj);
+
+    /// Queue a triangle mesh (counter-clockwise front faces).  The position
+    /// and index arrays are read by Rasterize() and must stay valid until
+    /// then.  Occluders must lie inside the geometry they stand in for.
+    /// Returns false if the mesh is over maxOccluderTriangles.
+    bool AddOccluder(const f32* positions, size_t positionStride, size_t vertexCount,
+                     const u32* indices, size_t indexCount, const Mat4& model);
+    /// Queue a solid box (e.g. a wall or a built-in cube).
+    void AddOccluderBox(const Vec3& boxMin, const Vec3& boxMax, const Mat4& model);
+
+    bool HasOccluders() const { return !m_Occluders.empty(); }
+
+    /// Transform, rasterize and build the HiZ chain.  Safe to run on a worker
+    /// thread while the caller does unrelated work; the tests below must not
+    /// run until it returns.
+    void Rasterize();
+
+    /// True if the box (in `model` space) is hidden behind the occluders.
+    bool IsBoxOccluded(const Vec3& boxMin, const Vec3& boxMax, const Mat4& model);
+    /// True if the world-space sphere is hidden.
+    bool IsSphereOccluded(const Vec3& center, f32 radius);
+
+    const OcclusionStats& GetStats() const { return m_Stats; }
+
+    /// Depth of one mip level (0 = full resolution), bottom row first,
+    /// values in [0, 1] with 1 = nothing rasterized.
+    const std::vector<f32>& GetDepth(u32 level = 0) const { return m_HiZ[level]; }
+    u32 GetLevelCount() const { return static_cast<u32>(m_HiZ.size()); }
+    /// Level sizes halve rounding up, so texel x of level L covers x >> L.
+    u32 GetLevelWidth(u32 level) const  { return m_LevelW[level]; }
+    u32 GetLevelHeight(u32 level) const { return m_LevelH[level]; }
+
+    /// Screen-space triangle ready for rasterization (internal).
+    struct ScreenTri {
+        f32 x[3], y[3];
+        f32 zx, zy, zc;          // depth plane, already pushed to the pixel's far corner
+        f32 zMax;
+        i32 minX, maxX, minY, maxY;
+        u8  silhouette;          // bit k: edge k (vertex k → k+1) is an outline edge
+    };
+
+private:
+    struct Occluder {
+        const f32* positions = nullptr;
+        size_t     stride = 0;
+        size_t     vertexCount = 0;
+        const u32* indices = nullptr;
+        size_t     indexCount = 0;
+        Mat4       model;
+        Vec3       boxMin, boxMax;
+        bool       box = false;
+    };
+
+    /// Per-thread scratch for setup.
+    struct SetupScratch {
+        std::vector<Vec4> clip;
+        std::vector<u8>   front;       // per triangle
+        std::vector<i32>  neighbour;   // per triangle edge; -1 = open edge
+        std::vector<std::pair<u64, u32>> edges;   // (vertex pair, triangle edge)
+    };
+
+    void SetupOccluders(size_t first, size_t last, std::vector<ScreenTri>& out, SetupScratch& scratch) const;
+    void EmitTriangle(const Vec4& a, const Vec4& b, const Vec4& c, u8 silhouette, std::vector<ScreenTri>& out) const;
+    void RasterBand(i32 y0, i32 y1);
+    void BuildHiZ();
+    bool IsRectOccluded(f32 xMin, f32 yMin, f32 xMax, f32 yMax, f32 zMin);
+
+    OcclusionSettings m_Settings;
+    u32  m_Width = 0, m_Height = 0;
+    Mat4 m_ViewProj = Mat4::Identity();
+    std::vector<Occluder>               m_Occluders;
+    std::vector<std::vector<ScreenTri>> m_Bins;     // one list per setup thread
+    std::vector<std::vector<f32>>       m_HiZ;      // [0] is the depth buffer
+    std::vector<u32>                    m_LevelW, m_LevelH;
+    OcclusionStats m_Stats;
+};
+
+} // namespace gv
@@ -0,0 +1,100 @@
+// ============================================================================
+// GameVoid Engine — Post-Processing Effect Chain
+// ============================================================================
+// Runs an ordered list of full-screen effects over a texture:
+//   • An effect is a GLSL 330 fragment shader reading the previous result
+//     from `u_Source` (unit 0) at `vTexCoord`, with `u_TexelSize` set to
+//     1 / target size; an optional callback sets any other uniforms
+//   • Effects run by ascending order, insertion order breaking ties, and
+//     can be enabled / disabled individually
+//   • Two colour targets are ping-ponged, so a chain of any length needs
+//     only two textures
+// Without a GL context the chain still keeps its effects and their order;
+// Apply() then returns its input unchanged.
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace gv {
+
+/// Passed to an effect's setup callback with its program already bound.
+struct PostEffectContext {
+    u32 program = 0;
+    u32 source  = 0;            // input texture, bound to unit 0
+    u32 width = 0, height = 0;  // target size
+};
+using PostEffectSetup = std::function<void(const PostEffectContext&)>;
+
+class PostProcessing {
+public:
+    PostProcessing() = default;
+    ~PostProcessing() { Shutdown(); }
+    PostProcessing(const PostProcessing&) = delete;
+    PostProcessing& operator=(const PostProcessing&) = delete;
+
+    /// Create the ping-pong targets (RGBA8, or RGBA16F with `hdr`) and
+    /// compile any effects added so far.  Needs a current GL context.
+    void Init(u32 width, u32 height, bool hdr = false);
+    /// Reallocate the targets; effects are kept.
+    void Resize(u32 width, u32 height);
+    /// Release targets and programs; effects stay registered.
+    void Shutdown();
+
+    /// Add an effect, or replace the one with the same name.  Returns false
+    /// if the shader fails to compile (the effect is kept but skipped).
+    bool AddEffect(const std::string& name, const std::string& fragmentSrc,
+                   i32 order = 0, PostEffectSetup setup = {});
+    void RemoveEffect(const std::string& name);
+    bool HasEffect(const std::string& name) const;
+
+    void SetEffectEnabled(const std::string& name, bool enabled);
+    bool IsEffectEnabled(const std::string& name) const;
+    void SetEffectOrder(const std::string& name, i32 order);
+
+    /// Names of the effects Apply() would run, in the order it runs them.
+    std::vector<std::string> GetActiveEffects() const;
+
+    /// Run the enabled effects over `source`.  Returns the texture holding
+    /// the result — `source` itself when nothing ran.  Framebuffer binding,
+    /// viewport and depth-test state are restored afterwards.
+    u32 Apply(u32 source);
+
+    u32  GetWidth()  const { return m_Width; }
+    u32  GetHeight() const { return m_Height; }
+    bool IsInitialised() const { return m_Initialised; }
+
+private:
+    struct Effect {
+        std::string     name;
+        std::string     fragmentSrc;
+        i32             order = 0;
+        u32             sequence = 0;   // insertion index, breaks order ties
+        bool            enabled = true;
+        PostEffectSetup setup;
+        u32             program = 0;
+        bool            failed = false;
+    };
+
+    Effect*       Find(const std::string& name);
+    const Effect* Find(const std::string& name) const;
+    void Sort();
+    bool Compile(Effect& effect);
+    void CreateTargets();
+    void DestroyTargets();
+
+    std::vector<Effect> m_Effects;   // kept sorted by (order, sequence)
+    u32  m_NextSequence = 0;
+    u32  m_Width = 0, m_Height = 0;
+    bool m_HDR = false;
+    bool m_Initialised = false;
+
+    u32 m_FBO[2]      = { 0, 0 };
+    u32 m_ColorTex[2] = { 0, 0 };
+    u32 m_QuadVAO = 0, m_QuadVBO = 0;
+};
+
+} // namespace gv
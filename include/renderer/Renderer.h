@@ -9,6 +9,12 @@
 
 #include "core/Types.h"
 #include "core/Math.h"
+#include "renderer/ShaderLibrary.h"
+#include "renderer/MeshletCulling.h"
+#include "renderer/OcclusionCulling.h"
+#include "renderer/Impostor.h"
+#include "renderer/DynamicResolution.h"
+#include "renderer/PostProcessing.h"
 #include <string>
 #include <vector>
 
@@ -23,6 +29,10 @@ class Camera;
 class Scene;
 class Window;
 class Mesh;
+class MeshRegistry;
+class TextureStreamer;
+class MaterialComponent;
+class MeshRenderer;
 
 /// Gizmo modes (shared between editor and renderer).
 enum class GizmoMode { Translate, Rotate, Scale };
@@ -95,6 +105,9 @@ public:
 
     /// Provide the Window that owns the GL context (call before Init).
     void SetWindow(Window* window) { m_Window = window; }
+    /// Registry the built-in triangle / cube / plane are acquired from (call
+    /// before Init).  Without one the renderer builds private copies.
+    void SetMeshRegistry(MeshRegistry* registry) { m_MeshRegistry = registry; }
 
     bool Init(u32 width, u32 height, const std::string& title) override;
     void Shutdown() override;
@@ -126,11 +139,60 @@ public:
     void SetBloomIntensity(f32 i)      { m_BloomIntensity = i; }
     void SetExposure(f32 e)            { m_Exposure = e; }
     f32  GetExposure() const           { return m_Exposure; }
+    /// Effects run on the tone-mapped image at render resolution, before
+    /// the upscale.  FXAA is the built-in "fxaa" effect (order 100).
+    PostProcessing& GetPostProcessing() { return m_PostChain; }
+
+    // ── Dynamic resolution ─────────────────────────────────────────────────
+    /// The scene, G-buffer, SSAO, bloom and post targets are rendered at the
+    /// window size times the render scale and upscaled to the window at the
+    /// end of RenderPostProcessing.  With the governor enabled the scale
+    /// follows the measured frame time (GPU timer queries when available,
+    /// else the CPU frame interval — which can't see past v-sync, so that
+    /// fallback only ever scales down from a missed budget).
+    void SetRenderScale(f32 scale);    // fixed scale while the governor is off
+    f32  GetRenderScale() const        { return m_RenderScale; }
+    u32  GetRenderWidth() const        { return m_RenderWidth; }
+    u32  GetRenderHeight() const       { return m_RenderHeight; }
+    void SetDynamicResolutionEnabled(bool e);
+    bool IsDynamicResolutionEnabled() const   { return m_DynResEnabled; }
+    DynamicResolution& GetDynamicResolution() { return m_DynRes; }
+    /// Unsharp-mask strength of the upscale when the scale is below 1.
+    void SetUpscaleSharpness(f32 s)    { m_UpscaleSharpness = s; }
+    f32  GetUpscaleSharpness() const   { return m_UpscaleSharpness; }
+    /// Last measured frame times in ms (GPU is 0 without timer queries).
+    f32  GetGpuFrameMs() const         { return m_GpuFrameMs; }
+    f32  GetCpuFrameMs() const         { return m_CpuFrameMs; }
 
     // ── Shadow mapping ─────────────────────────────────────────────────────
     void SetShadowsEnabled(bool e)     { m_ShadowsEnabled = e; }
     bool IsShadowsEnabled() const      { return m_ShadowsEnabled; }
 
+    // ── Meshlet culling ────────────────────────────────────────────────────
+    /// Meshes with meshlets are culled per meshlet and drawn as compacted
+    /// index ranges; others are drawn whole.
+    void SetMeshletCullingEnabled(bool e)      { m_MeshletCulling = e; }
+    bool IsMeshletCullingEnabled() const       { return m_MeshletCulling; }
+    MeshletCullSettings& GetMeshletCullSettings() { return m_MeshletCullSettings; }
+    /// Totals for the last RenderScene call.
+    const MeshletCullStats& GetMeshletStats() const { return m_MeshletStats; }
+
+    // ── Occlusion culling ──────────────────────────────────────────────────
+    /// MeshRenderers flagged as occluders are rasterized into a small CPU
+    /// depth buffer each frame; objects and meshlets behind them are skipped.
+    void SetOcclusionCullingEnabled(bool e)    { m_OcclusionCulling = e; }
+    bool IsOcclusionCullingEnabled() const     { return m_OcclusionCulling; }
+    OcclusionBuffer& GetOcclusionBuffer()      { return m_Occlusion; }
+    /// Counts and raster time for the last RenderScene call.
+    const OcclusionStats& GetOcclusionStats() const { return m_Occlusion.GetStats(); }
+
+    // ── Impostors ──────────────────────────────────────────────────────────
+    /// Bake an impostor atlas and upload it.  Renders the views offscreen
+    /// when a GL context is available, otherwise uses the CPU baker.
+    bool BakeImpostor(const ImpostorSource& source, const ImpostorSettings& settings, ImpostorAtlas& out);
+    /// Objects drawn as impostors (including cross-fades) by the last RenderScene call.
+    u32 GetImpostorsDrawn() const { return m_ImpostorsDrawn; }
+
 #ifdef GV_HAS_GLFW
     /// Draw the built-in demo triangle (call from Engine game loop).
     void RenderDemo(f32 dt);
@@ -146,6 +208,7 @@ private:
     bool m_Initialised = false;
     bool m_LightingEnabled = true;
     Window* m_Window = nullptr;
+    MeshRegistry* m_MeshRegistry = nullptr;
 
     // ── Post-processing settings ───────────────────────────────────────────
     bool m_BloomEnabled       = false;
@@ -154,10 +217,37 @@ private:
     f32  m_BloomThreshold     = 1.0f;
     f32  m_BloomIntensity     = 0.3f;
     f32  m_Exposure           = 1.0f;
+    PostProcessing m_PostChain;
+
+    // ── Dynamic resolution ─────────────────────────────────────────────────
+    u32  m_RenderWidth  = 0;         // internal targets
+    u32  m_RenderHeight = 0;
+    f32  m_RenderScale  = 1.0f;      // applied
+    f32  m_FixedScale   = 1.0f;      // used while the governor is off
+    bool m_DynResEnabled = false;
+    DynamicResolution m_DynRes;
+    f32  m_UpscaleSharpness = 0.25f;
+    f32  m_GpuFrameMs = 0.0f;
+    f32  m_CpuFrameMs = 0.0f;
+    /// Recompute the render size from the scale; resizes the targets when
+    /// it changed.
+    void ApplyRenderScale();
 
     // ── Shadow settings ────────────────────────────────────────────────────
     bool m_ShadowsEnabled = true;
 
+    // ── Meshlet culling ────────────────────────────────────────────────────
+    bool                m_MeshletCulling = true;
+    MeshletCullSettings m_MeshletCullSettings;
+    MeshletCullStats    m_MeshletStats;
+    MeshletDrawList     m_MeshletDrawList;   // reused per draw
+
+    // ── Occlusion culling ──────────────────────────────────────────────────
+    bool            m_OcclusionCulling = true;
+    OcclusionBuffer m_Occlusion;
+
+    u32 m_ImpostorsDrawn = 0;
+
 #ifdef GV_HAS_GLFW
     // Built-in demo triangle (proves GL context works)
     u32 m_DemoVAO    = 0;
@@ -167,14 +257,46 @@ private:
     void CleanupDemo();
 
     // ── Scene-rendering resources (PBR) ────────────────────────────────────
+    ShaderLibrary m_Shaders;  // owns the PBR / skinned / shadow programs
     u32 m_SceneShader = 0;   // PBR shader program
-    u32 m_SkinnedShader = 0; // PBR shader with GPU bone skinning
-
-    // Built-in primitives (triangle + cube + plane):
-    u32 m_TriVAO = 0, m_TriVBO = 0;
-    u32 m_CubeVAO = 0, m_CubeVBO = 0, m_CubeEBO = 0;
+    u32 m_SkinnedShader = 0; // PBR shader with GPU bone skinning (SKINNED permutation)
+    void RefreshShaderHandles();   // re-fetch program IDs after a hot reload
+    TextureStreamer* m_TextureStreamer = nullptr;
+    /// Report the material's texture slots at the object's projected size.
+    void RequestStreamedTextures(const MaterialComponent& mat, const Vec3& pos, f32 radius,
+                                 const Vec3& camPos, const Camera& camera);
+    /// Draw a loaded mesh, meshlet-culled when it has meshlets.  Returns
+    /// false if every meshlet was culled (nothing drawn).
+    bool DrawMesh(const Mesh& mesh, const Mat4& model, const Frustum& frustum, const Vec3& eye);
+    /// Queue this frame's occluders into m_Occlusion.
+    void CollectOccluders(Scene& scene);
+    /// Test a MeshRenderer's bounds against the rasterized occluders.
+    bool IsOccluded(const MeshRenderer& mr, const Mat4& model);
+
+    // ── Impostors ──────────────────────────────────────────────────────────
+    struct ImpostorDraw {
+        const ImpostorAtlas* atlas;
+        Mat4 model;
+        f32  fade;      // 1 = impostor only
+    };
+    std::vector<ImpostorDraw> m_ImpostorQueue;
+    u32 m_ImpostorShader = 0;
+    u32 m_ImpostorBakeShader = 0;
+    void InitImpostorShaders();
+    void CleanupImpostors();
+    /// Queue the object's impostor if it is in range; returns the fade the
+    /// mesh should be dithered with (1 = skip the mesh).
+    f32 QueueImpostor(const MeshRenderer& mr, const Mat4& model, const Vec3& objPos, const Vec3& eye);
+    void RenderImpostors(const Mat4& view, const Mat4& proj, const Vec3& eye, const Vec3& lightDir,
+                         const Vec3& lightColor, const Vec3& ambientColor);
+    bool BakeImpostorGPU(const ImpostorSource& source, ImpostorAtlas& out);
+
+    // Built-in primitives (triangle + cube + plane); the VAOs belong to the meshes:
+    Shared<Mesh> m_TriMesh, m_CubeMesh, m_PlaneMesh;
+    u32 m_TriVAO = 0;
+    u32 m_CubeVAO = 0;
     i32 m_CubeIndexCount = 0;
-    u32 m_PlaneVAO = 0, m_PlaneVBO = 0, m_PlaneEBO = 0;
+    u32 m_PlaneVAO = 0;
     i32 m_PlaneIndexCount = 0;
 
     // ── Shadow Mapping ─────────────────────────────────────────────────────
@@ -197,11 +319,25 @@ private:
     u32 m_BrightPassShader = 0;
     u32 m_BlurShader = 0;
     u32 m_TonemapShader = 0;
-    u32 m_FXAAShader = 0;
+    u32 m_LDR_FBO = 0;           // tone-mapped image, input to m_PostChain
+    u32 m_LDR_ColorTex = 0;
+    u32 m_UpscaleShader = 0;     // render resolution → window resolve
     u32 m_ScreenQuadVAO = 0, m_ScreenQuadVBO = 0;
     void InitPostProcessing();
     void CleanupPostProcessing();
     void InitScreenQuad();
+    void CreatePostTargets();    // HDR, bloom and LDR at render resolution
+    void DestroyPostTargets();
+    void ResizeRenderTargets();
+
+    // GPU frame time: a small ring of GL_TIME_ELAPSED queries, read back a
+    // few frames late so the CPU never waits on them.
+    static constexpr u32 kGpuTimerQueries = 4;
+    u32  m_GpuTimers[kGpuTimerQueries] = { 0, 0, 0, 0 };
+    u32  m_GpuTimerFrame = 0;    // queries issued so far
+    bool m_GpuTimerActive = false;
+    f64  m_LastFrameStartMs = 0.0;
+    void UpdateFrameTiming();    // read timers, feed the governor
 
 public:
     void BeginHDRPass();
@@ -246,6 +382,8 @@ private:
     void InitDeferredPipeline();
     void CleanupScene();
     void CleanupDeferred();
+    void CreateDeferredTargets();   // G-buffer + SSAO at render resolution
+    void DestroyDeferredTargets();
 
 public:
     // ── Additional rendering methods ───────────────────────────────────────
@@ -264,6 +402,13 @@ public:
     u32 GetSceneShader() const { return m_SceneShader; }
     u32 GetSkinnedShader() const { return m_SkinnedShader; }
 
+    /// Shader programs, permutations and hot reload.
+    ShaderLibrary& GetShaderLibrary() { return m_Shaders; }
+
+    /// Report on-screen sizes of streamed textures each RenderScene and
+    /// let the streamer update residency (null = off).
+    void SetTextureStreamer(TextureStreamer* streamer) { m_TextureStreamer = streamer; }
+
 private:
     // ── Deferred Rendering ─────────────────────────────────────────────────
     bool m_DeferredEnabled = false;
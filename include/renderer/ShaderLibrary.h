@@ -0,0 +1,187 @@
+// ============================================================================
+// GameVoid Engine — Shader Library
+// ============================================================================
+// File-based GLSL with permutations, an on-disk program-binary cache and hot
+// reload.
+//
+//   ShaderPreprocessor  — CPU only (no GL context).  Resolves #include,
+//                         #pragma once and injects permutation #defines
+//                         after #version.  Also hashes the result.
+//   ShaderLibrary       — Declares programs by name, compiles permutations
+//                         lazily, caches them in memory and as GL program
+//                         binaries on disk, and recompiles when a source
+//                         file changes.
+//
+// Sources are looked up on disk first (search paths, in order) and then in
+// the in-memory sources registered with RegisterSource(), so the renderer's
+// built-in shaders can be overridden by dropping a file of the same name
+// into a search path.
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace gv {
+
+// ─── Permutation keys ──────────────────────────────────────────────────────
+/// A permutation is a set of defines such as {"SKINNED", "SHADOWS",
+/// "MAX_LIGHTS=8"}.  Order and duplicates don't matter: the canonical form is
+/// sorted and deduplicated, so {"B","A"} and {"A","B","A"} share a program.
+struct ShaderPermutation {
+    static std::vector<std::string> Canonical(std::vector<std::string> defines);
+    static std::string              ToString(const std::vector<std::string>& canonical);
+};
+
+/// Result of preprocessing one stage.
+struct PreprocessedShader {
+    bool                     ok = false;
+    std::string              source;         // final GLSL handed to the driver
+    std::vector<std::string> files;          // every file pulled in; index = #line source number
+    std::string              error;          // "file:line: message" when !ok
+    u64                      hash = 0;       // FNV-1a of `source`
+};
+
+// ─── Preprocessor (CPU only) ───────────────────────────────────────────────
+class ShaderPreprocessor {
+public:
+    /// Directories searched for top-level sources and #include <...>.
+    void AddSearchPath(const std::string& dir);
+    const std::vector<std::string>& GetSearchPaths() const { return m_SearchPaths; }
+
+    /// Register an in-memory source under a virtual file name.  Disk files in
+    /// the search paths take precedence.
+    void RegisterSource(const std::string& name, const std::string& text);
+
+    /// Locate and read a source.  `from` is the including file (for relative
+    /// #include "..."); `resolved` receives the path used, `onDisk` whether it
+    /// came from the filesystem.
+    bool ReadSource(const std::string& name, const std::string& from,
+                    std::string& text, std::string& resolved, bool& onDisk) const;
+
+    /// Expand `path` with the given permutation defines.
+    PreprocessedShader Process(const std::string& path,
+                               const std::vector<std::string>& defines) const;
+
+    /// 64-bit FNV-1a.
+    static u64 Hash(const std::string& data, u64 seed = 0xcbf29ce484222325ull);
+    static u64 Hash(const void* data, size_t size, u64 seed = 0xcbf29ce484222325ull);
+
+    static constexpr u32 kMaxIncludeDepth = 32;
+
+private:
+    struct Context {
+        PreprocessedShader       out;
+        std::vector<std::string> stack;   // include chain, for cycle detection
+        std::vector<std::string> once;    // files that declared #pragma once
+        u32                      rootLineBase = 0;   // lines of the root consumed by #version
+    };
+    bool Expand(const std::string& text, const std::string& file, u32 depth, Context& ctx) const;
+
+    std::vector<std::string>                     m_SearchPaths;
+    std::unordered_map<std::string, std::string> m_Virtual;
+};
+
+// ─── Library ───────────────────────────────────────────────────────────────
+class ShaderLibrary {
+public:
+    ShaderLibrary() = default;
+    /// GL programs are not released here — call Clear() while the context
+    /// is still current.
+    ~ShaderLibrary() = default;
+    ShaderLibrary(const ShaderLibrary&) = delete;
+    ShaderLibrary& operator=(const ShaderLibrary&) = delete;
+
+    // ── Sources ────────────────────────────────────────────────────────────
+    void AddSearchPath(const std::string& dir) { m_Pre.AddSearchPath(dir); }
+    void RegisterSource(const std::string& name, const std::string& text) {
+        m_Pre.RegisterSource(name, text);
+    }
+    ShaderPreprocessor&       GetPreprocessor()       { return m_Pre; }
+    const ShaderPreprocessor& GetPreprocessor() const { return m_Pre; }
+
+    /// Directory for cached program binaries (created on demand).  Empty
+    /// disables the disk cache.
+    void SetBinaryCacheDir(const std::string& dir) { m_CacheDir = dir; }
+    const std::string& GetBinaryCacheDir() const  { return m_CacheDir; }
+
+    // ── Programs ───────────────────────────────────────────────────────────
+    /// Declare a program built from a vertex + fragment source.  Nothing is
+    /// compiled until the first Get().  Re-declaring a name drops its
+    /// compiled permutations.
+    bool Load(const std::string& name, const std::string& vertPath, const std::string& fragPath);
+
+    bool Has(const std::string& name) const { return m_Programs.count(name) != 0; }
+
+    /// GL program for a permutation of `name`, compiled (or loaded from the
+    /// binary cache) on first use.  Returns 0 on failure or without a GL
+    /// context.
+    u32 Get(const std::string& name, const std::vector<std::string>& defines = {});
+
+    /// Preprocess both stages of a permutation without touching GL.
+    bool Preprocess(const std::string& name, const std::vector<std::string>& defines,
+                    PreprocessedShader& vert, PreprocessedShader& frag) const;
+
+    // ── Hot reload ─────────────────────────────────────────────────────────
+    /// Minimum seconds between filesystem scans in PollChanges().
+    void SetWatchInterval(f32 seconds) { m_WatchInterval = seconds; }
+
+    /// Recompile permutations whose source files changed on disk.  A
+    /// permutation that fails to compile keeps its previous program.  Returns
+    /// how many programs were replaced (callers re-fetch handles when > 0).
+    u32 PollChanges();
+
+    /// Recompile every live permutation from source, bypassing the cache.
+    void ReloadAll();
+
+    /// Delete every GL program (call while the context is still current).
+    void Clear();
+
+    // ── Stats ──────────────────────────────────────────────────────────────
+    struct Stats {
+        u32 compiled     = 0;   // programs built from source
+        u32 binaryHits   = 0;   // programs restored from the disk cache
+        u32 binaryWrites = 0;
+        u32 reloads      = 0;
+        u32 failures     = 0;
+    };
+    const Stats& GetStats() const { return m_Stats; }
+    size_t GetPermutationCount() const { return m_Variants.size(); }
+
+private:
+    struct ProgramDesc {
+        std::string vertPath;
+        std::string fragPath;
+    };
+    struct Variant {
+        std::string              name;
+        std::vector<std::string> defines;        // canonical
+        u32                      program = 0;
+        u64                      sourceHash = 0;
+        std::vector<std::string> watched;        // disk files this variant depends on
+    };
+
+    static u64 VariantKey(const std::string& name, const std::vector<std::string>& canonical);
+
+    /// Build (or rebuild) `v`.  `useCache` allows restoring a program binary.
+    bool Build(Variant& v, bool useCache);
+
+    u32  LoadBinary(u64 hash) const;
+    void SaveBinary(u64 hash, u32 program);
+    std::string BinaryPath(u64 hash) const;
+    u64  DriverHash();
+
+    ShaderPreprocessor                         m_Pre;
+    std::unordered_map<std::string, ProgramDesc> m_Programs;
+    std::unordered_map<u64, Variant>           m_Variants;
+    std::unordered_map<std::string, i64>       m_FileTimes;   // watched file → last write stamp
+    std::string                                m_CacheDir = "shader_cache";
+    f32                                        m_WatchInterval = 0.5f;
+    f64                                        m_LastPoll = 0.0;
+    u64                                        m_DriverHash = 0;
+    Stats                                      m_Stats;
+};
+
+} // namespace gv
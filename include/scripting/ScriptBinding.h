@@ -0,0 +1,192 @@
+// ============================================================================
+// GameVoid Engine — GVScript Native Binding
+// ============================================================================
+// Builds VMNative thunks from ordinary C++ signatures, so a binding is one
+// line instead of hand-unpacked arguments:
+//
+//   engine.Bind("lerp", [](f64 a, f64 b, f64 t) { return a + (b - a) * t; });
+//   engine.Bind("is_even", [](i64 n) { return n % 2 == 0; });
+//   engine.BindMethod<GameObject>("set_active", &GameObject::SetActive);
+//
+//   • Arguments are read straight off the caller's stack slots — nothing is
+//     copied into a container first
+//   • Each argument is checked against its parameter type; a mismatch is a
+//     runtime error naming it ("lerp: argument 2: expected number, got
+//     string"), as is a wrong argument count
+//   • Parameters: arithmetic types (integers must be whole and in range),
+//     bool (any value, by truthiness), std::string, std::string_view and
+//     VMValue.  Results: the same, or void (nil)
+//   • Specialise ScriptType<T> to bind further types
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include "scripting/ScriptVM.h"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace gv {
+
+// ============================================================================
+// Type conversions
+// ============================================================================
+/// Is: can `v` be passed as a T?  Get: convert (only after Is).
+/// Push: a T result as a script value.
+template <typename T, typename = void>
+struct ScriptType;
+
+template <typename T>
+struct ScriptType<T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>>> {
+    static constexpr const char* kName = std::is_integral_v<T> ? "integer" : "number";
+    static bool Is(VMValue v) {
+        if (!v.IsNumber()) return false;
+        if constexpr (std::is_integral_v<T>) {
+            // max() rounds up to 2^digits as a double (2^63 for i64), so the
+            // upper bound is that power of two, exclusive.
+            f64 d = v.AsNumber();
+            return d == std::floor(d) &&
+                   d >= static_cast<f64>(std::numeric_limits<T>::lowest()) &&
+                   d < std::ldexp(1.0, std::numeric_limits<T>::digits);
+        }
+        return true;
+    }
+    static T Get(ScriptVM&, VMValue v) { return static_cast<T>(v.AsNumber()); }
+    static VMValue Push(ScriptVM&, T value) { return VMValue::Number(static_cast<f64>(value)); }
+};
+
+template <>
+struct ScriptType<bool> {
+    static constexpr const char* kName = "bool";
+    static bool Is(VMValue) { return true; }
+    static bool Get(ScriptVM&, VMValue v) { return v.Truthy(); }
+    static VMValue Push(ScriptVM&, bool value) { return VMValue::Bool(value); }
+};
+
+template <>
+struct ScriptType<std::string> {
+    static constexpr const char* kName = "string";
+    static bool Is(VMValue v) { return v.IsString(); }
+    static std::string Get(ScriptVM&, VMValue v) { return std::string(v.AsString()->View()); }
+    static VMValue Push(ScriptVM& vm, const std::string& value) { return vm.String(value); }
+};
+
+/// Valid for the duration of the call (the string is on the caller's stack).
+template <>
+struct ScriptType<std::string_view> {
+    static constexpr const char* kName = "string";
+    static bool Is(VMValue v) { return v.IsString(); }
+    static std::string_view Get(ScriptVM&, VMValue v) { return v.AsString()->View(); }
+    static VMValue Push(ScriptVM& vm, std::string_view value) { return vm.String(value); }
+};
+
+template <>
+struct ScriptType<VMValue> {
+    static constexpr const char* kName = "value";
+    static bool Is(VMValue) { return true; }
+    static VMValue Get(ScriptVM&, VMValue v) { return v; }
+    static VMValue Push(ScriptVM&, VMValue value) { return value; }
+};
+
+// ============================================================================
+// Signatures
+// ============================================================================
+/// Result and parameter types of a function pointer, member function
+/// pointer or (non-generic) callable.
+template <typename F>
+struct ScriptSignature : ScriptSignature<decltype(&F::operator())> {};
+
+template <typename R, typename... A>
+struct ScriptSignature<R (*)(A...)> {
+    using Result = R;
+    template <template <typename...> class T> using Apply = T<A...>;
+};
+template <typename R, typename... A>
+struct ScriptSignature<R (*)(A...) noexcept> : ScriptSignature<R (*)(A...)> {};
+template <typename C, typename R, typename... A>
+struct ScriptSignature<R (C::*)(A...)> : ScriptSignature<R (*)(A...)> { using Class = C; };
+template <typename C, typename R, typename... A>
+struct ScriptSignature<R (C::*)(A...) const> : ScriptSignature<R (*)(A...)> { using Class = C; };
+template <typename C, typename R, typename... A>
+struct ScriptSignature<R (C::*)(A...) noexcept> : ScriptSignature<R (*)(A...)> { using Class = C; };
+template <typename C, typename R, typename... A>
+struct ScriptSignature<R (C::*)(A...) const noexcept> : ScriptSignature<R (*)(A...)> { using Class = C; };
+
+namespace detail {
+
+template <typename T>
+using ScriptParam = std::remove_cv_t<std::remove_reference_t<T>>;
+
+template <typename T>
+void CheckScriptArg(ScriptArgs args, u32 index) {
+    if (!ScriptType<ScriptParam<T>>::Is(args.argv[index]))
+        throw std::runtime_error("argument " + std::to_string(index + 1) + ": expected " +
+                                 ScriptType<ScriptParam<T>>::kName + ", got " +
+                                 ScriptVM::TypeName(args.argv[index]));
+}
+
+inline void CheckScriptArgCount(ScriptArgs args, u32 expected) {
+    if (args.argc != expected)
+        throw std::runtime_error("expected " + std::to_string(expected) + " argument" +
+                                 (expected == 1 ? "" : "s") + ", got " + std::to_string(args.argc));
+}
+
+/// Checks every argument, then calls `call(converted args…)` and converts
+/// the result.
+template <typename... A>
+struct ScriptInvoker {
+    template <typename R, typename Call>
+    static VMValue Invoke(ScriptVM& vm, ScriptArgs args, Call&& call) {
+        return Invoke<R>(vm, args, std::forward<Call>(call), std::index_sequence_for<A...>{});
+    }
+
+    template <typename R, typename Call, size_t... I>
+    static VMValue Invoke(ScriptVM& vm, ScriptArgs args, Call&& call, std::index_sequence<I...>) {
+        CheckScriptArgCount(args, sizeof...(A));
+        (CheckScriptArg<A>(args, static_cast<u32>(I)), ...);
+        if constexpr (std::is_void_v<R>) {
+            call(ScriptType<ScriptParam<A>>::Get(vm, args.argv[I])...);
+            return {};
+        } else {
+            return ScriptType<ScriptParam<R>>::Push(vm, call(ScriptType<ScriptParam<A>>::Get(vm, args.argv[I])...));
+        }
+    }
+};
+
+} // namespace detail
+
+// ============================================================================
+// Thunks
+// ============================================================================
+/// A native calling a function pointer or callable with checked arguments.
+template <typename F>
+VMNative MakeScriptNative(F fn) {
+    using Sig = ScriptSignature<std::decay_t<F>>;
+    using Result = typename Sig::Result;
+    using Invoker = typename Sig::template Apply<detail::ScriptInvoker>;
+    return [fn = std::move(fn)](ScriptVM& vm, ScriptArgs args) -> VMValue {
+        return Invoker::template Invoke<Result>(vm, args, fn);
+    };
+}
+
+/// A native calling `method` on the object `receiver()` returns; a null
+/// receiver is a runtime error.
+template <typename M, typename Receiver>
+VMNative MakeScriptMethod(M method, Receiver receiver) {
+    using Sig = ScriptSignature<M>;
+    using Result = typename Sig::Result;
+    using Invoker = typename Sig::template Apply<detail::ScriptInvoker>;
+    return [method, receiver = std::move(receiver)](ScriptVM& vm, ScriptArgs args) -> VMValue {
+        auto* object = receiver();
+        if (!object) throw std::runtime_error("no object to call the method on");
+        return Invoker::template Invoke<Result>(vm, args, [object, method](auto&&... a) -> Result {
+            return (object->*method)(std::forward<decltype(a)>(a)...);
+        });
+    };
+}
+
+} // namespace gv
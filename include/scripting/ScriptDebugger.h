@@ -0,0 +1,185 @@
+// ============================================================================
+// GameVoid Engine — GVScript Remote Debugger
+// ============================================================================
+// A debugger server inside the engine and a small client to drive it:
+//
+//   GameVoid --script-debug-listen 4711        (engine: listen on loopback)
+//   GameVoid --script-debug 4711               (client, another terminal)
+//   (gvdb) break mover.gvs:12
+//   (gvdb) continue
+//   stopped at breakpoint in on_update, scripts/mover.gvs:12
+//   (gvdb) locals
+//
+// Transport: TCP on 127.0.0.1 ("4711", "localhost:4711") or, on POSIX, a
+// Unix socket ("unix:/tmp/gv.sock").  One client at a time.
+//
+// Protocol: UTF-8 lines.  The client sends one command per line; the server
+// answers with zero or more data lines and then "ok [text]" or
+// "err <message>".  Lines starting with "event " arrive at any time:
+//   event hello gvscript-debug 1
+//   event stopped <reason> <function> <chunk>:<line>   reason: breakpoint,
+//                                                      step, pause, error
+//   event error <text>                                 script errors
+//   event resumed
+// Commands (stopped = only while the script is stopped):
+//   break <chunk>:<line>    → ok <id>   (chunk may be a path suffix)
+//   delete <id> | breaks    → "bp <id> <chunk>:<line>" lines
+//   pause                   stop at the next script instruction
+//   continue | step | next | finish                    (stopped)
+//   stack                   → "frame <n> <function> <chunk>:<line>" lines
+//   locals [frame]          → "var <scope> <name> <type> <value>" lines,
+//                             scope: local, upvalue, instance   (stopped)
+//   print <name> [frame]    → "value <type> <value>"           (stopped)
+//   errors on|off           stop when a script error is raised (default on)
+//   status | detach | help
+//
+// While stopped, the engine's frame waits inside the VM; nothing else runs.
+// Time spent stopped is not charged to a sandbox's time limit.
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include "scripting/ScriptVM.h"
+#include <deque>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace gv {
+
+// ============================================================================
+// Server
+// ============================================================================
+class ScriptDebugger : public VMHook {
+public:
+    struct Breakpoint {
+        u32 id = 0;
+        std::string chunk;
+        i32 line = 0;
+    };
+
+    explicit ScriptDebugger(ScriptVM& vm);
+    ~ScriptDebugger() override;
+    ScriptDebugger(const ScriptDebugger&) = delete;
+    ScriptDebugger& operator=(const ScriptDebugger&) = delete;
+
+    // ── Connection ─────────────────────────────────────────────────────────
+    /// Listen on "<port>", "localhost:<port>", "127.0.0.1:<port>" or
+    /// "unix:<path>".  Port 0 picks a free port (see GetPort).
+    bool Listen(const std::string& address);
+    void Close();
+    bool IsListening() const { return m_Listen >= 0; }
+    bool IsAttached() const  { return m_Client >= 0; }
+    u16  GetPort() const     { return m_Port; }
+    const std::string& GetLastError() const { return m_LastError; }
+
+    /// Accept a client and run its commands.  Call once per frame, outside
+    /// script execution.
+    void Poll();
+    /// Send "event <kind> <text>" (one event per line of `text`).
+    void SendEvent(const std::string& kind, const std::string& text);
+
+    // ── Breakpoints (also settable by the host) ────────────────────────────
+    u32  AddBreakpoint(const std::string& chunk, i32 line);
+    bool RemoveBreakpoint(u32 id);
+    const std::vector<Breakpoint>& GetBreakpoints() const { return m_Breakpoints; }
+    void SetBreakOnError(bool enable) { m_BreakOnError = enable; }
+    /// Stop at the next instruction any script runs.
+    void RequestPause();
+    bool IsStopped() const { return m_Stopped != nullptr; }
+
+    // ── VMHook ─────────────────────────────────────────────────────────────
+    void OnEnter(ScriptVM& vm, const VMFiber& fiber) override;
+    void OnCall(ScriptVM& vm, const VMFiber& fiber) override;
+    void OnReturn(ScriptVM& vm, const VMFiber& fiber) override;
+    void OnStep(ScriptVM& vm, const VMFiber& fiber) override;
+    void OnError(ScriptVM& vm, const VMFiber& fiber, const std::string& message) override;
+
+private:
+    enum class StepMode : u8 { None, Into, Over, Out };
+
+    /// Where execution was at the last step: a new line starts when this
+    /// changes.
+    struct Position {
+        const VMFiber*    fiber = nullptr;
+        size_t            depth = 0;
+        const VMFunction* function = nullptr;
+        i32               line = -1;
+    };
+
+    void Accept();
+    void Disconnect();
+    bool NextCommand(std::string& line);
+    void Send(const std::string& line);
+    /// Run one command.  Returns true if it resumes execution.
+    bool Execute(const std::string& line);
+    void Stop(const VMFiber& fiber, const std::string& reason);
+    bool MatchesBreakpoint(const VMFunction* function, i32 line) const;
+    void UpdateStepInterval();
+    Position PositionOf(const VMFiber& fiber) const;
+
+    const VMCallFrame* Frame(u32 index) const;
+    i32  FrameLine(u32 index) const;
+    void ListVariables(u32 frame);
+    bool FindVariable(u32 frame, const std::string& name, VMValue& out) const;
+    std::string Describe(VMValue value) const;
+
+    ScriptVM& m_VM;
+    intptr_t m_Listen = -1;
+    intptr_t m_Client = -1;
+    u16  m_Port = 0;
+    std::string m_UnixPath;
+    std::string m_InBuffer;
+    std::string m_LastError;
+
+    std::vector<Breakpoint>  m_Breakpoints;
+    std::unordered_set<i32>  m_BreakLines;    // quick filter for OnStep
+    u32  m_NextBreakpoint = 1;
+    bool m_BreakOnError = true;
+    bool m_PauseRequested = false;
+    bool m_StopAtNextStep = false;            // finish: returned past the frame
+
+    StepMode m_StepMode = StepMode::None;
+    Position m_StepFrom;
+    Position m_Last;
+
+    const VMFiber* m_Stopped = nullptr;       // set while stopped
+    bool m_Resume = false;
+};
+
+// ============================================================================
+// Client
+// ============================================================================
+class ScriptDebugClient {
+public:
+    ScriptDebugClient() = default;
+    ~ScriptDebugClient();
+    ScriptDebugClient(const ScriptDebugClient&) = delete;
+    ScriptDebugClient& operator=(const ScriptDebugClient&) = delete;
+
+    /// Same address forms as ScriptDebugger::Listen.
+    bool Connect(const std::string& address);
+    void Disconnect();
+    bool IsConnected() const { return m_Socket >= 0; }
+    const std::string& GetLastError() const { return m_LastError; }
+
+    /// Send a command and collect its reply: data lines, then the final
+    /// "ok…" / "err…" line.  Events that arrive meanwhile are queued.
+    bool Command(const std::string& command, std::vector<std::string>& reply, f64 timeoutMs = 5000.0);
+    /// Next event (without the "event " prefix).  False on timeout or
+    /// disconnect; a negative timeout waits forever.
+    bool WaitEvent(std::string& event, f64 timeoutMs);
+
+    /// Interactive shell: GameVoid --script-debug [address]
+    static int Main(int argc, char* argv[]);
+
+private:
+    bool ReadLine(std::string& line, f64 timeoutMs);
+
+    intptr_t m_Socket = -1;
+    std::string m_InBuffer;
+    std::deque<std::string> m_Events;
+    std::string m_LastError;
+};
+
+} // namespace gv
@@ -5,18 +5,42 @@
 // scripts to GameObjects without recompiling C++.
 //
 // The engine includes a built-in mini scripting language ("GVScript") with:
-//   - Variables (numbers, strings, booleans)
+//   - Values: numbers, strings, booleans, nil, arrays [a, b], maps { k: v }
+//     and closures (func (x) { return x * 2; })
 //   - Functions: print(), set_position(), get_position(), spawn(), destroy()
-//   - Control flow: if/else, while, for
+//   - Control flow: if/else, while, for, return
+//   - Coroutines: start_coroutine(fn), yield, wait(seconds), wait_until(cond),
+//     wait_event(name) — see ScriptScheduler.h
 //   - Math: sin, cos, sqrt, abs, random
+//   - Containers: len, push, pop, remove, keys, has, type
 //   - Engine bindings: access to scene and game objects
 //
-// Scripts can be loaded from .gvs files or written inline.
+// Scripts are compiled to bytecode and run on ScriptVM (see ScriptVM.h):
+// 8-byte NaN-boxed values, interned strings, and an incremental collector
+// that Update() advances within a per-frame time budget.
+//
+// Scripts can be loaded from .gvs files or written inline.  Each
+// ScriptComponent runs its script as an instance: the script's top-level
+// vars and functions belong to that object alone.  With hot reload on, an
+// edited .gvs file is recompiled and swapped into every live instance on the
+// next frame, keeping instance state (see EnableHotReload).  Each instance
+// can be sandboxed — instruction, time, recursion and memory limits plus a
+// set of permitted natives — so a runaway script is stopped without taking
+// the frame down with it (see ScriptSandbox).  GetProfiler() times scripts
+// per function and line; StartDebugServer() lets the --script-debug client
+// set breakpoints, step and inspect variables (see ScriptDebugger.h).
 // ============================================================================
 #pragma once
 
 #include "core/Component.h"
+#include "core/FileWatcher.h"
+#include "core/GameObject.h"
 #include "core/Types.h"
+#include "scripting/ScriptBinding.h"
+#include "scripting/ScriptDebugger.h"
+#include "scripting/ScriptProfiler.h"
+#include "scripting/ScriptScheduler.h"
+#include "scripting/ScriptVM.h"
 #include <string>
 #include <unordered_map>
 #include <functional>
@@ -30,8 +54,10 @@ class GameObject;
 class ScriptEngine;
 
 // ============================================================================
-// Script Value — variant type for script variables
+// Script Value — host-side copy of a script value
 // ============================================================================
+/// Owns its string, so it stays valid across collections.  Containers and
+/// closures convert to Nil; use the VMNative / VMValue API for those.
 struct ScriptValue {
     enum Type { Nil, Number, String, Bool };
     Type type = Nil;
@@ -50,6 +76,23 @@ struct ScriptValue {
     bool IsNil() const { return type == Nil; }
 };
 
+// ============================================================================
+// Script Sandbox
+// ============================================================================
+/// What one script instance may do in each call into it (on_update, a
+/// coroutine resume, …).  A script that breaches a limit or calls a native
+/// outside its capabilities is terminated: its coroutines stop, its
+/// ScriptComponent is disabled and the signal "script_terminated" is
+/// emitted (data: "path: reason").  Plain runtime errors are only reported,
+/// as before.  `limits` starts at the VMLimits defaults; a trusted script
+/// opts out with VMLimits::Unlimited().
+struct ScriptSandbox {
+    VMLimits limits;
+    /// Capability groups (see ScriptEngine::DefineCapability) or native
+    /// names the script may call.  Empty = every native.
+    std::vector<std::string> capabilities;
+};
+
 // ============================================================================
 // Script Component
 // ============================================================================
@@ -76,6 +119,9 @@ public:
     void SetEngine(ScriptEngine* engine) { m_Engine = engine; }
     ScriptEngine* GetEngine() const      { return m_Engine; }
 
+    /// The engine instance running this component's script (0 before start).
+    u32 GetInstance() const { return m_Instance; }
+
     // ── Lifecycle (called by ScriptEngine) ─────────────────────────────────
     void OnStart() override;
     void OnUpdate(f32 dt) override;
@@ -85,6 +131,7 @@ private:
     std::string m_ScriptPath;
     std::string m_Source;
     bool m_Loaded = false;
+    u32  m_Instance = 0;
     ScriptEngine* m_Engine = nullptr;
 };
 
@@ -95,8 +142,10 @@ private:
 /// script callbacks.
 class ScriptEngine {
 public:
-    ScriptEngine() = default;
-    ~ScriptEngine() = default;
+    ScriptEngine();
+    ~ScriptEngine();
+    ScriptEngine(const ScriptEngine&) = delete;
+    ScriptEngine& operator=(const ScriptEngine&) = delete;
 
     // ── Lifecycle ──────────────────────────────────────────────────────────
     /// Initialise the scripting engine and register built-in functions.
@@ -105,6 +154,15 @@ public:
     /// Shut down and free resources.
     void Shutdown();
 
+    /// Per-frame housekeeping: applies settled script edits (hot reload),
+    /// resumes due coroutines, then advances the garbage collector for at
+    /// most the GC frame budget.
+    void Update(f32 dt);
+
+    /// Milliseconds per frame the collector may use (default 0.5).
+    void SetGCFrameBudget(f64 ms) { m_GCFrameBudgetMs = ms; }
+    f64  GetGCFrameBudget() const { return m_GCFrameBudgetMs; }
+
     // ── Script execution ───────────────────────────────────────────────────
     /// Load and execute a script file.
     bool LoadFile(const std::string& path);
@@ -118,11 +176,75 @@ public:
     /// Call a named function with a float argument (e.g. "on_update").
     bool CallFunction(const std::string& funcName, f32 arg);
 
+    // ── Instances ──────────────────────────────────────────────────────────
+    /// Run a script as a new instance bound to `self`.  Its top-level vars
+    /// and functions live in the instance; built-ins and globals are shared.
+    /// The file is compiled once however many instances use it.  With an
+    /// empty `path`, `source` is compiled instead.  Returns 0 on failure.
+    u32  CreateInstance(const std::string& path, const std::string& source, GameObject* self);
+    void DestroyInstance(u32 id);
+    /// Call a function the instance defines.  False if it doesn't define
+    /// one or the call fails.
+    bool CallInstance(u32 id, const std::string& funcName);
+    /// As above with one number argument, also exposed as the global `dt`.
+    bool CallInstance(u32 id, const std::string& funcName, f32 arg);
+    ScriptValue GetInstanceVariable(u32 id, const std::string& name) const;
+    u32  GetInstanceCount() const { return static_cast<u32>(m_Instances.size()); }
+
+    // ── Sandboxing ─────────────────────────────────────────────────────────
+    /// Sandbox for instances created from now on (default: the VMLimits
+    /// defaults, all natives).
+    void SetDefaultSandbox(const ScriptSandbox& sandbox) { m_DefaultSandbox = sandbox; }
+    const ScriptSandbox& GetDefaultSandbox() const       { return m_DefaultSandbox; }
+    bool SetInstanceSandbox(u32 id, const ScriptSandbox& sandbox);
+    /// Name a group of natives for ScriptSandbox::capabilities.  Built-in
+    /// groups: core, coroutines, scene, input, self, events.
+    void DefineCapability(const std::string& name, std::vector<std::string> natives);
+    /// True once the instance was stopped for breaching its sandbox.
+    bool IsInstanceTerminated(u32 id) const;
+
     // ── Engine bindings ────────────────────────────────────────────────────
-    /// Expose a C++ function to scripts.
+    /// Expose a C++ function to scripts.  Arguments and result are copied
+    /// through ScriptValue; prefer RegisterNative on hot paths.
     using NativeFunc = std::function<ScriptValue(const std::vector<ScriptValue>&)>;
     void RegisterFunction(const std::string& name, NativeFunc func);
 
+    /// Expose a C++ function that reads arguments straight off the VM stack.
+    void RegisterNative(const std::string& name, VMNative func) { m_VM.RegisterNative(name, std::move(func)); }
+
+    /// Expose a function pointer or lambda; arguments are type-checked and
+    /// converted from its signature (see ScriptBinding.h).
+    template <typename F>
+    void Bind(const std::string& name, F func) { m_VM.RegisterNative(name, MakeScriptNative(std::move(func))); }
+
+    /// Expose a method of T, called on the script's `self` object (T =
+    /// GameObject) or on self's first component of type T.
+    template <typename T, typename M>
+    void BindMethod(const std::string& name, M method) {
+        m_VM.RegisterNative(name, MakeScriptMethod(method, [this]() -> T* {
+            if constexpr (std::is_same_v<T, GameObject>) return m_SelfObject;
+            else return m_SelfObject ? m_SelfObject->GetComponent<T>() : nullptr;
+        }));
+    }
+
+    /// The underlying virtual machine.
+    ScriptVM& GetVM() { return m_VM; }
+
+    /// Coroutines started by scripts (or by StartCoroutine).
+    ScriptScheduler& GetScheduler() { return m_Scheduler; }
+
+    // ── Tooling ────────────────────────────────────────────────────────────
+    ScriptProfiler& GetProfiler() { return m_Profiler; }
+    ScriptDebugger& GetDebugger() { return m_Debugger; }
+    /// Listen for a debugger client (see ScriptDebugger::Listen for the
+    /// address forms).  Update() serves it between frames; script errors
+    /// are forwarded to it as events.
+    bool StartDebugServer(const std::string& address);
+
+    /// Run a script function as a coroutine with `self` bound to `self`.
+    /// Returns 0 if the function doesn't exist.
+    u32 StartCoroutine(const std::string& funcName, GameObject* self = nullptr);
+
     /// Expose the Scene API so scripts can spawn/query objects.
     void BindSceneAPI(Scene& scene);
 
@@ -140,8 +262,27 @@ public:
     void SetVariable(const std::string& name, ScriptValue val);
     ScriptValue GetVariable(const std::string& name) const;
 
+    ScriptValue ToScriptValue(VMValue value) const;
+    VMValue     FromScriptValue(const ScriptValue& value);
+
     // ── Hot-reload ─────────────────────────────────────────────────────────
+    /// Watch every script file instances were created from.  When one
+    /// changes, Update() recompiles it and re-runs it in each instance:
+    ///   • vars keep their current value if the new version still declares
+    ///     them with the same type (or initialises them to nil)
+    ///   • functions, new vars and changed types take the new definition;
+    ///     names the new version dropped are removed
+    ///   • running coroutines finish the frame they are in with the old
+    ///     code; calls they make from then on reach the new functions
+    /// The swap is all-or-nothing: a compile error, or a runtime error in
+    /// any instance's top-level code, keeps the old version everywhere.
+    /// Outcomes are emitted as the signals "script_reloaded" and
+    /// "script_reload_failed" (data: "path: error").
     void EnableHotReload(bool enable);
+    bool IsHotReloadEnabled() const { return m_HotReload; }
+    FileWatcher& GetFileWatcher() { return m_Watcher; }
+    /// Reload a script file now.  False if it fails (old version kept).
+    bool ReloadScript(const std::string& path);
 
     /// Get the last error message from script execution.
     const std::string& GetLastError() const { return m_LastError; }
@@ -149,47 +290,61 @@ public:
     bool IsInitialised() const { return m_Initialised; }
 
 private:
-    // ── Internal interpreter ───────────────────────────────────────────────
-    struct Token {
-        enum Kind {
-            Eof, Number, Str, Ident, LParen, RParen, LBrace, RBrace,
-            Comma, Semicolon, Assign, Plus, Minus, Star, Slash, Percent,
-            Eq, Neq, Lt, Gt, Lte, Gte, And, Or, Not, Dot,
-            If, Else, While, For, Func, Return, Var, True_, False_
-        };
-        Kind kind = Eof;
-        std::string text;
-        f64 numVal = 0;
-        i32 line = 0;
+    struct ScriptModule {
+        std::string path;           // normalised; empty for inline source
+        VMFunction* chunk = nullptr;    // nullptr until it first compiles
+        u64 sourceHash = 0;
+        u32 instances = 0;
+    };
+    struct ScriptInstance {
+        ScriptModule* module = nullptr;
+        VMMap*        env = nullptr;
+        GameObject*   self = nullptr;
+        ScriptSandbox sandbox;
+        Shared<std::vector<bool>> allowed;  // native mask, nullptr = all
+        u32  allowedFor = 0;                // native count the mask was built for
+        bool terminated = false;
     };
 
-    std::vector<Token> Tokenize(const std::string& source);
-    ScriptValue ExecuteTokens(const std::vector<Token>& tokens, size_t& pos);
-    ScriptValue ExecuteBlock(const std::vector<Token>& tokens, size_t& pos);
-    ScriptValue ExecuteStatement(const std::vector<Token>& tokens, size_t& pos);
-    ScriptValue ExecuteExpression(const std::vector<Token>& tokens, size_t& pos);
-    ScriptValue ExecuteComparison(const std::vector<Token>& tokens, size_t& pos);
-    ScriptValue ExecuteAddSub(const std::vector<Token>& tokens, size_t& pos);
-    ScriptValue ExecuteMulDiv(const std::vector<Token>& tokens, size_t& pos);
-    ScriptValue ExecuteUnary(const std::vector<Token>& tokens, size_t& pos);
-    ScriptValue ExecutePrimary(const std::vector<Token>& tokens, size_t& pos);
-    ScriptValue CallNative(const std::string& name, const std::vector<ScriptValue>& args);
-
+    void RegisterBuiltins();
+    bool Report(const std::string& context);
+    ScriptModule* LoadModule(const std::string& path, const std::string& source);
+    bool ReloadModule(ScriptModule& module, const std::string& source);
+    bool ReloadFailed(const ScriptModule& module, const std::string& error);
+    void MarkInstances(VMHeap& heap);
+    void ClearInstances();
+    void EnterSandbox(u32 id);
+    void LeaveSandbox();
+    bool InstanceFailed(u32 id, const std::string& context);
+    void Terminate(u32 id, const std::string& reason);
+
+    ScriptVM m_VM;
+    ScriptScheduler m_Scheduler{ m_VM };
+    ScriptProfiler  m_Profiler{ m_VM };
+    ScriptDebugger  m_Debugger{ m_VM };
+    u32  m_SignalListener = 0;
+    u32  m_RootMarker = 0;
+    std::unordered_map<std::string, Unique<ScriptModule>> m_Modules;   // path or "inline:<hash>"
+    std::unordered_map<u32, ScriptInstance> m_Instances;
+    std::unordered_map<GameObject*, u32>    m_InstanceBySelf;    // for coroutine resumes
+    u32  m_NextInstance = 1;
+    std::unordered_map<std::string, std::vector<std::string>> m_Capabilities;
+    ScriptSandbox m_DefaultSandbox;
+    VMLimits m_HostLimits;          // restored when no instance runs
+    u32  m_Sandboxed = 0;           // instance whose sandbox is applied
+    Shared<std::vector<bool>> m_ActiveMask;
+    FileWatcher m_Watcher;
+    f64  m_Clock = 0;               // seconds of Update(), for the watcher
     bool m_Initialised = false;
     bool m_HotReload   = false;
+    f64  m_GCFrameBudgetMs = 0.5;
     std::string m_LastError;
-    std::unordered_map<std::string, ScriptValue> m_Variables;
-    std::unordered_map<std::string, NativeFunc> m_NativeFunctions;
     Scene* m_BoundScene = nullptr;
     GameObject* m_SelfObject = nullptr;
 
-    // User-defined script functions
-    struct ScriptFunc {
-        std::string name;
-        std::vector<std::string> params;
-        std::vector<Token> body;
-    };
-    std::unordered_map<std::string, ScriptFunc> m_ScriptFunctions;
+    /// Natives that change an object go through this first so Stop()
+    /// restores it after a play session.  Returns `obj`.
+    GameObject* TouchForPlay(GameObject* obj);
 };
 
 } // namespace gv
@@ -0,0 +1,131 @@
+// ============================================================================
+// GameVoid Engine — GVScript Profiler
+// ============================================================================
+// Finds the script functions and lines that eat the frame:
+//
+//   engine.GetProfiler().Start();                 // or Start(Mode::Sample)
+//   …run some frames…
+//   engine.GetProfiler().Stop();
+//   std::cout << engine.GetProfiler().Report();
+//   engine.GetProfiler().WriteFoldedStacks("scripts.folded");
+//
+//   • Instrument: every call, return and line change is timed — exact
+//     call counts and line hits, at several times the normal run cost
+//   • Sample: every millisecond (SetSampleInterval) of script time, the
+//     running stack is charged with the time since the last sample —
+//     cheap enough to leave on during play
+//   • Time is script time only; a native's time counts against the line
+//     that called it
+//   • The folded-stack export ("a;b;c 1234", microseconds) feeds
+//     flamegraph.pl, speedscope or inferno
+// Functions the profiler has seen are kept alive until Reset(), so results
+// survive hot reload.
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include "scripting/ScriptVM.h"
+#include <chrono>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace gv {
+
+class ScriptProfiler : public VMHook {
+public:
+    enum class Mode : u8 { Instrument, Sample };
+
+    struct LineStats {
+        u64 hits = 0;           // times execution entered the line (instrument)
+        u64 samples = 0;        // (sample)
+        u64 selfNs = 0;
+    };
+
+    struct FunctionStats {
+        std::string name;       // "<chunk>" for top-level and anonymous code
+        std::string chunk;
+        i32 line = 0;           // first line
+        u64 calls = 0;          // (instrument)
+        u64 samples = 0;        // (sample)
+        u64 selfNs = 0;
+        u64 totalNs = 0;        // with callees; recursion counted once
+        std::map<i32, LineStats> lines;
+    };
+
+    explicit ScriptProfiler(ScriptVM& vm);
+    ~ScriptProfiler() override;
+    ScriptProfiler(const ScriptProfiler&) = delete;
+    ScriptProfiler& operator=(const ScriptProfiler&) = delete;
+
+    // ── Control ────────────────────────────────────────────────────────────
+    /// Start collecting (results add to any already collected).
+    void Start(Mode mode = Mode::Instrument);
+    void Stop();
+    void Reset();
+    bool IsRunning() const { return m_Running; }
+    Mode GetMode() const   { return m_Mode; }
+    /// Script time between samples in Sample mode (default 1 ms).
+    void SetSampleInterval(f64 ms) { m_SampleNs = static_cast<i64>(ms * 1e6); }
+
+    // ── Results ────────────────────────────────────────────────────────────
+    /// Per-function totals, most self time first.
+    std::vector<FunctionStats> GetFunctions() const;
+    /// Table of the `count` most expensive functions and their hottest lines.
+    std::string Report(u32 count = 20) const;
+    /// Call stacks in folded form, one per line, weighted in microseconds.
+    std::string FoldedStacks() const;
+    bool WriteFoldedStacks(const std::string& path) const;
+
+    // ── VMHook ─────────────────────────────────────────────────────────────
+    void OnEnter(ScriptVM& vm, const VMFiber& fiber) override;
+    void OnLeave(ScriptVM& vm, const VMFiber& fiber) override;
+    void OnCall(ScriptVM& vm, const VMFiber& fiber) override;
+    void OnReturn(ScriptVM& vm, const VMFiber& fiber) override;
+    void OnStep(ScriptVM& vm, const VMFiber& fiber) override;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /// One call path: the root (node 0) has no function.
+    struct Node {
+        VMFunction* function = nullptr;
+        u32 parent = 0;
+        u64 calls = 0;
+        u64 samples = 0;
+        u64 selfNs = 0;
+        std::unordered_map<VMFunction*, u32> children;
+    };
+    /// Where the running script is: a call path and a line in its function.
+    struct Location {
+        u32 node = 0;
+        i32 line = 0;
+        LineStats* stats = nullptr;
+    };
+
+    u32  NodeFor(const VMFiber& fiber);
+    Location LocationOf(const VMFiber& fiber);
+    LineStats* Line(VMFunction* function, i32 line);
+    void Charge(const Location& at, i64 ns, bool sample);
+    void Flush(Clock::time_point now);
+    static i32 CurrentLine(const VMFiber& fiber);
+    static std::string Label(const VMFunction* function);
+
+    ScriptVM& m_VM;
+    u32  m_RootMarker = 0;
+    Mode m_Mode = Mode::Instrument;
+    bool m_Running = false;
+    i64  m_SampleNs = 1000000;
+
+    std::vector<Node> m_Nodes;
+    std::unordered_map<VMFunction*, std::unordered_map<i32, LineStats>> m_Lines;
+
+    // Fibers being run, innermost last (a native can call back into script).
+    std::vector<const VMFiber*> m_Active;
+    Location m_Here;                    // instrument: where time is going now
+    Clock::time_point m_Last;           // instrument: last event; sample: entry
+    i64  m_Pending = 0;                 // sample: script time not yet charged
+};
+
+} // namespace gv
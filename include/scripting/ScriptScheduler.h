@@ -0,0 +1,207 @@
+// ============================================================================
+// GameVoid Engine — GVScript Coroutine Scheduler
+// ============================================================================
+// Runs script functions as coroutines that can pause mid-function:
+//
+//   func patrol() {
+//       while true {
+//           set_position(0, 0, 0);  wait(2);
+//           set_position(5, 0, 0);  wait_event("alarm");
+//           wait_until(get_position_x() > 4);
+//       }
+//   }
+//   start_coroutine(patrol);
+//
+//   • Each coroutine owns a VMFiber — its frames live on the heap, so a
+//     suspended coroutine costs a small stack and nothing per frame
+//   • Sleepers sit in a hierarchical timer wheel (4 levels × 64 slots);
+//     advancing the clock touches only the slots it passes and the timers
+//     that expire, never every sleeper
+//   • The clock is simulated: it advances only by Update(dt), so the same
+//     dt sequence always wakes coroutines at the same ticks, in the same
+//     order (expiry tick, then the order the waits were made)
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include "scripting/ScriptVM.h"
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace gv {
+
+// ============================================================================
+// Timer Wheel
+// ============================================================================
+/// Hierarchical timing wheel over integer ticks.  Timers are intrusive list
+/// nodes addressed by handle, so Add and Cancel are O(1); Advance costs one
+/// step per tick passed plus the timers it moves or fires.
+class TimerWheel {
+public:
+    static constexpr u32 kInvalid = 0xFFFFFFFFu;
+
+    struct Expired {
+        u64 expiry;
+        u64 payload;
+    };
+
+    /// Schedule `payload` to fire at tick `expiry` (clamped to now + 1).
+    u32  Add(u64 expiry, u64 payload);
+    void Cancel(u32 handle);
+
+    /// Move the clock to `tick`, appending fired timers to `out`.
+    void Advance(u64 tick, std::vector<Expired>& out);
+
+    u64  GetNow() const   { return m_Now; }
+    u32  GetCount() const { return m_Count; }
+    /// Drop every timer and restart the clock at `now`.
+    void Clear(u64 now = 0);
+
+private:
+    static constexpr u32 kLevels   = 4;
+    static constexpr u32 kSlotBits = 6;
+    static constexpr u32 kSlots    = 1u << kSlotBits;
+    static constexpr u32 kSlotMask = kSlots - 1;
+
+    struct Node {
+        u64 expiry  = 0;
+        u64 payload = 0;
+        u32 prev = kInvalid, next = kInvalid;
+        u32 list = kInvalid;            // level * kSlots + slot, or kInvalid if free
+    };
+    struct List {
+        u32 head = kInvalid, tail = kInvalid;
+    };
+
+    void Link(u32 handle);
+    void Unlink(u32 handle);
+    void Cascade(u32 level);
+
+    std::vector<Node> m_Nodes;
+    std::vector<u32>  m_FreeNodes;
+    List m_Lists[kLevels * kSlots];
+    u64  m_Now = 0;
+    u32  m_Count = 0;
+};
+
+// ============================================================================
+// Script Scheduler
+// ============================================================================
+class ScriptScheduler {
+public:
+    /// 0 is never a valid id.  Ids are exact in a script number.
+    using CoroutineID = u32;
+
+    struct Stats {
+        u32 live = 0;           // started and not yet finished
+        u32 sleeping = 0;       // in the timer wheel
+        u32 waitingEvent = 0;
+        u32 ready = 0;          // run on the next Update
+        u64 resumes = 0;
+    };
+
+    explicit ScriptScheduler(ScriptVM& vm);
+    ~ScriptScheduler();
+    ScriptScheduler(const ScriptScheduler&) = delete;
+    ScriptScheduler& operator=(const ScriptScheduler&) = delete;
+
+    /// Register yield-aware natives: wait, wait_event, start_coroutine,
+    /// stop_coroutine, coroutine_running, sim_time.
+    void RegisterNatives();
+
+    // ── Control ────────────────────────────────────────────────────────────
+    /// Queue `callee(args…)` (a closure or a script function name); it first
+    /// runs on the next Update.  `context` is handed to the resume hook.
+    /// Returns 0 (see ScriptVM::GetLastError) if `callee` isn't callable.
+    CoroutineID Start(VMValue callee, ScriptArgs args = {}, void* context = nullptr);
+    bool Stop(CoroutineID id);
+    /// Stop every coroutine started with `context` (e.g. a destroyed object).
+    void StopContext(void* context);
+    void StopAll();
+    bool IsRunning(CoroutineID id) const;
+
+    /// Wake coroutines waiting in wait_event(name); `data` is what the
+    /// wait returns.  They resume on the next Update.
+    void Signal(std::string_view name, VMValue data = {});
+
+    /// Advance the simulated clock by `dt` seconds, then resume every
+    /// coroutine that is due, in a deterministic order.
+    void Update(f64 dt);
+
+    // ── Clock ──────────────────────────────────────────────────────────────
+    /// Timer resolution in ticks per second (default 1000).  Only takes
+    /// effect while nothing sleeps.
+    void SetTickRate(f64 ticksPerSecond);
+    f64  GetTickRate() const { return m_TickRate; }
+    f64  GetTime() const     { return m_Time; }
+
+    // ── Hooks ──────────────────────────────────────────────────────────────
+    /// Called before each resume with the coroutine's context.
+    void SetResumeHook(std::function<void(void* context)> hook) { m_ResumeHook = std::move(hook); }
+    /// Called when a coroutine fails; it is stopped afterwards.
+    void SetErrorHandler(std::function<void(CoroutineID, const std::string&)> fn) { m_OnError = std::move(fn); }
+    /// Context for coroutines started from script outside any coroutine
+    /// (inside one, they inherit its context).
+    void SetContextSource(std::function<void*()> source) { m_ContextSource = std::move(source); }
+
+    Stats GetStats() const;
+
+private:
+    enum class State : u8 { Free, Ready, Sleeping, WaitingEvent, Running };
+    enum class Wait : u8 { None, Sleep, Event };
+
+    struct Coroutine {
+        VMFiber  fiber;
+        State    state = State::Free;
+        u32      generation = 1;
+        void*    context = nullptr;
+        u32      timer = TimerWheel::kInvalid;
+        VMString* event = nullptr;
+        VMValue  resumeValue;
+        bool     stopRequested = false;
+    };
+    struct Waiter {
+        CoroutineID id;
+        u64 order;
+    };
+
+    static u32 IndexOf(CoroutineID id) { return (id & 0xFFFFFu) - 1; }
+    CoroutineID MakeID(u32 index) const {
+        return ((m_Coroutines[index]->generation & 0xFFFu) << 20) | (index + 1);
+    }
+    Coroutine* Find(CoroutineID id) const;
+    void Release(u32 index);
+    void MakeReady(u32 index, VMValue value);
+    void MarkRoots(VMHeap& heap);
+    void ResumeOne(CoroutineID id);
+
+    ScriptVM& m_VM;
+    u32 m_RootMarker = 0;
+    std::vector<Unique<Coroutine>> m_Coroutines;   // stable: upvalues point into fibers
+    std::vector<u32>               m_FreeList;
+    std::vector<CoroutineID>       m_Ready, m_Running;
+    std::unordered_map<VMString*, std::vector<Waiter>> m_EventWaiters;
+    TimerWheel                     m_Wheel;
+    std::vector<TimerWheel::Expired> m_Expired;
+
+    f64 m_Time = 0;                 // seconds
+    f64 m_Ticks = 0;                // the same clock in ticks
+    f64 m_TickRate = 1000.0;
+    u64 m_Order = 0;                // sequence of waits, for tie-breaking
+    u64 m_Resumes = 0;
+    u32 m_Live = 0;
+
+    // Set by wait natives while the current coroutine runs.
+    u32  m_Current = TimerWheel::kInvalid;
+    Wait m_PendingWait = Wait::None;
+    u64  m_PendingTick = 0;
+    VMString* m_PendingEvent = nullptr;
+
+    std::function<void(void*)> m_ResumeHook;
+    std::function<void*()>     m_ContextSource;
+    std::function<void(CoroutineID, const std::string&)> m_OnError;
+};
+
+} // namespace gv
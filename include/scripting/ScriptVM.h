@@ -0,0 +1,281 @@
+// ============================================================================
+// GameVoid Engine — GVScript Virtual Machine
+// ============================================================================
+// Executes VMCompiler bytecode over VMValues:
+//   • One value stack per fiber; call frames index into it, so calls never
+//     copy arguments — natives receive a ScriptArgs view of the caller's
+//     stack slots
+//   • Globals, the script function table and native functions are keyed by
+//     interned name, so lookups hash a pointer, not a string
+//   • The collector only runs at safepoints (calls, loop back-edges and
+//     allocating instructions) where every live value is on a stack or in a
+//     root table
+//   • Runaway code is stopped by per-call limits (VMLimits): instructions,
+//     wall-clock time, call depth and memory, checked cooperatively — the
+//     instruction countdown costs nothing extra until a slice runs out
+//   • Natives can be restricted to an allowed set (capabilities)
+//   • Tools (ScriptProfiler, ScriptDebugger) observe execution through
+//     VMHooks; step events ride on the same countdown, so with no hook
+//     installed the loop does no extra work
+//   • Coroutines are fibers of their own: a suspended coroutine is just its
+//     heap-allocated stack and frames, resumed where it left off
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include "scripting/VMCompiler.h"
+#include "scripting/VMHeap.h"
+#include <chrono>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace gv {
+
+class ScriptVM;
+
+/// Arguments of a native call: a view of the caller's stack, valid for the
+/// duration of the call.  Out-of-range indices read as nil.
+struct ScriptArgs {
+    const VMValue* argv = nullptr;
+    u32 argc = 0;
+
+    u32  Count() const { return argc; }
+    bool Empty() const { return argc == 0; }
+    VMValue operator[](u32 i) const { return i < argc ? argv[i] : VMValue(); }
+    f64 Number(u32 i, f64 fallback = 0.0) const { return i < argc ? argv[i].ToNumber() : fallback; }
+};
+
+using VMNative = std::function<VMValue(ScriptVM& vm, ScriptArgs args)>;
+
+struct VMCallFrame {
+    VMClosure* closure = nullptr;
+    u32 pc   = 0;
+    u32 base = 0;       // stack index of slot 0 (the callee)
+};
+
+/// A stack of call frames and the values they use.
+struct VMFiber {
+    std::vector<VMValue>     stack;
+    u32                      top = 0;
+    std::vector<VMCallFrame> frames;
+    VMUpvalue*               openUpvalues = nullptr;
+    bool                     growable = true;
+    bool                     started  = false;  // resumed at least once
+};
+
+enum class VMResumeResult { Finished, Suspended, Error };
+
+/// Limits for one host call (Execute, Call, Resume…) and the calls nested
+/// in it.  The defaults stop a runaway script with the instruction budget,
+/// which trips at the same point on every machine; the wall-clock limit is
+/// off unless set.  0 turns one limit off and Unlimited() turns them all
+/// off, for trusted code only.
+struct VMLimits {
+    u64 instructions = 10000000;
+    f64 timeMs = 0;             // wall clock, checked every 1024 instructions
+    u32 callDepth = 200;        // script frames (the VM maximum is 256)
+    u64 memoryBytes = 64ull << 20;  // strings and containers allocated
+    u32 stringLength = 0;       // longest string a script may build
+    u32 collectionSize = 0;     // most elements in one array or map
+
+    static VMLimits Unlimited() {
+        VMLimits l;
+        l.instructions = 0;
+        l.timeMs       = 0;
+        l.callDepth    = 0;
+        l.memoryBytes  = 0;
+        return l;
+    }
+};
+
+/// Why the last call failed.
+enum class VMFault : u8 { None, Error, Instructions, Time, CallDepth, Memory, Capability };
+
+/// Observes execution for tools (profiler, debugger).  Events arrive on the
+/// thread running the script, with `fiber` already reflecting the change; a
+/// hook may block (a debugger stopped at a breakpoint) but must not run
+/// script code or allocate script values.
+class VMHook {
+public:
+    virtual ~VMHook() = default;
+    /// The VM starts / stops running `fiber` (a call from the host, or a
+    /// coroutine resume; stops also cover suspends and errors).
+    virtual void OnEnter(ScriptVM&, const VMFiber&) {}
+    virtual void OnLeave(ScriptVM&, const VMFiber&) {}
+    /// A script frame was pushed / popped.
+    virtual void OnCall(ScriptVM&, const VMFiber&) {}
+    virtual void OnReturn(ScriptVM&, const VMFiber&) {}
+    /// The top frame is about to execute the instruction at its pc.  Sent
+    /// every ScriptVM::GetStepInterval() instructions.
+    virtual void OnStep(ScriptVM&, const VMFiber&) {}
+    /// A runtime error, before the fiber's frames unwind.
+    virtual void OnError(ScriptVM&, const VMFiber&, const std::string& /*message*/) {}
+};
+
+class ScriptVM {
+public:
+    ScriptVM();
+    ~ScriptVM();
+    ScriptVM(const ScriptVM&) = delete;
+    ScriptVM& operator=(const ScriptVM&) = delete;
+
+    VMHeap& GetHeap() { return m_Heap; }
+    const VMHeap& GetHeap() const { return m_Heap; }
+
+    // ── Code ───────────────────────────────────────────────────────────────
+    /// Compile and run a chunk.  Functions it declares join the function
+    /// table.  Returns false (see GetLastError) on compile or runtime error.
+    /// With an `env`, the chunk's top-level vars and functions go into that
+    /// map instead (an instance: code in it sees its own names first).
+    bool Execute(const std::string& source, const std::string& chunkName = "script", VMMap* env = nullptr);
+    /// Compile without running.  The result must be rooted (AddRootMarker)
+    /// if it is kept past the next safepoint.  nullptr on error.
+    VMFunction* Compile(const std::string& source, const std::string& chunkName);
+    /// Run a compiled chunk, optionally into an instance env.
+    bool RunChunk(VMFunction* function, VMMap* env = nullptr);
+
+    // ── Calls ──────────────────────────────────────────────────────────────
+    bool HasFunction(std::string_view name) const;
+    VMClosure* FindFunction(std::string_view name) const;
+    /// Call a script function by name.  False if it doesn't exist or fails.
+    bool CallFunction(std::string_view name, ScriptArgs args = {}, VMValue* result = nullptr);
+    /// Call a closure (or the native / function a string names).
+    bool Call(VMValue callee, ScriptArgs args = {}, VMValue* result = nullptr);
+
+    // ── Coroutines ─────────────────────────────────────────────────────────
+    /// Reset `fiber` so its next Resume calls `callee(args…)` (a closure or
+    /// the name of a script function).
+    bool PrepareFiber(VMFiber& fiber, VMValue callee, ScriptArgs args = {});
+    /// Run a prepared or suspended fiber until it returns, suspends or
+    /// fails.  `resumeValue` becomes the result of the call it suspended in.
+    VMResumeResult Resume(VMFiber& fiber, VMValue resumeValue = {}, VMValue* result = nullptr);
+    /// Drop a fiber's frames, closing upvalues that still point into it.
+    void ResetFiber(VMFiber& fiber);
+    /// True while a native called directly by a running coroutine executes;
+    /// only then may it RequestSuspend().
+    bool CanSuspend() const { return m_Running && m_HostDepth == m_RunningDepth; }
+    /// Suspend the running coroutine once the current native returns.
+    void RequestSuspend() { m_SuspendRequested = true; }
+    /// Extra roots (the fibers of suspended coroutines, instance envs, …).
+    u32  AddRootMarker(VMHeap::RootMarker marker);
+    void RemoveRootMarker(u32 id);
+    static void MarkFiber(VMHeap& heap, const VMFiber& fiber);
+
+    // ── Natives ────────────────────────────────────────────────────────────
+    void RegisterNative(std::string_view name, VMNative fn);
+    bool HasNative(std::string_view name) const;
+
+    // ── Globals ────────────────────────────────────────────────────────────
+    void    SetGlobal(std::string_view name, VMValue value);
+    VMValue GetGlobal(std::string_view name) const;
+    bool    HasGlobal(std::string_view name) const;
+
+    // ── Values ─────────────────────────────────────────────────────────────
+    VMValue String(std::string_view text) { return VMValue::Object(m_Heap.Intern(text)); }
+    /// Printable text: numbers as iostreams formats them, containers
+    /// expanded a few levels deep.
+    std::string ToString(VMValue value) const;
+    static const char* TypeName(VMValue value);
+    /// Equality as the `==` operator sees it.
+    static bool Equal(VMValue a, VMValue b);
+
+    // ── Errors and limits ──────────────────────────────────────────────────
+    const std::string& GetLastError() const { return m_LastError; }
+    void SetLastError(std::string error)    { m_LastError = std::move(error); }
+    VMFault GetLastFault() const            { return m_Fault; }
+    /// Limits for the next outermost host call; a call in progress keeps
+    /// the limits it started with.  Breaching one is a runtime error.
+    void SetLimits(const VMLimits& limits) { m_Limits = limits; }
+    const VMLimits& GetLimits() const      { return m_Limits; }
+    /// Instructions a single host call may run (0 = unlimited).  Default
+    /// 50 million.
+    void SetInstructionLimit(u64 limit) { m_Limits.instructions = limit; }
+    u64  GetInstructionLimit() const    { return m_Limits.instructions; }
+    /// Instructions run since construction.
+    u64  GetInstructionCount() const    { return m_InstructionCount; }
+    /// True while script code (or a native it called) runs.
+    bool IsRunning() const { return m_HostDepth > 0; }
+
+    // ── Capabilities ───────────────────────────────────────────────────────
+    /// Natives script code may call, indexed by NativeIndex (nullptr = all;
+    /// natives past the end of the mask are denied).  The mask must stay
+    /// alive while set.
+    void SetAllowedNatives(const std::vector<bool>* mask) { m_AllowedNatives = mask; }
+    const std::vector<bool>* GetAllowedNatives() const    { return m_AllowedNatives; }
+    /// Slot of a native, or -1.
+    i32  NativeIndex(std::string_view name) const;
+    u32  GetNativeCount() const { return static_cast<u32>(m_Natives.size()); }
+
+    // ── Hooks ──────────────────────────────────────────────────────────────
+    /// Install a hook.  `stepInterval` asks for OnStep every N instructions
+    /// (0 = none, 1 = every instruction); hooks share the smallest interval
+    /// any of them asked for.  Time spent in OnStep is not charged to the
+    /// time limit.
+    void AddHook(VMHook* hook, u32 stepInterval = 0);
+    void RemoveHook(VMHook* hook);
+    void SetStepInterval(VMHook* hook, u32 stepInterval);
+    u32  GetStepInterval() const { return m_StepInterval; }
+
+    // ── Collection ─────────────────────────────────────────────────────────
+    /// Advance the collector for at most `budgetMs` (a cycle in progress
+    /// continues; a new one starts only if the heap is over its threshold).
+    void CollectGarbage(f64 budgetMs);
+    void FullCollect() { m_Heap.FullCollect(); }
+
+    /// Drop globals and script functions; natives stay registered.
+    void ClearScriptState();
+
+private:
+    struct Native {
+        std::string name;
+        VMNative    fn;
+    };
+
+    bool Invoke(VMValue callee, ScriptArgs args, VMValue* result);
+    bool InvokeNested(VMValue callee, ScriptArgs args, VMValue* result);
+    bool Run(VMFiber& fiber, size_t stopDepth);
+    bool CallClosure(VMFiber& fiber, VMClosure* closure, u32 argc);
+    bool CallNativeAt(VMFiber& fiber, u32 index, u32 argc);
+    bool RuntimeError(VMFiber& fiber, size_t stopDepth, const std::string& message);
+    void BeginLimits();
+    void EndLimits();
+    bool RefillBudget();
+    bool Fault(VMFault fault, std::string message);
+    void UpdateStepInterval();
+    void Step(const VMFiber& fiber);
+    VMUpvalue* CaptureUpvalue(VMFiber& fiber, u32 slot);
+    void CloseUpvalues(VMFiber& fiber, u32 fromSlot);
+    bool Concat(VMValue a, VMValue b, VMValue& out);
+    void MarkRoots(VMHeap& heap);
+    void AppendString(std::string& out, VMValue value, int depth) const;
+
+    VMHeap m_Heap;
+    VMFiber m_Main;
+    std::unordered_map<VMString*, VMValue>    m_Globals;
+    std::unordered_map<VMString*, VMClosure*> m_Functions;
+    std::unordered_map<VMString*, u32>        m_NativeIndex;
+    std::vector<Native>                       m_Natives;
+    std::string m_LastError;
+    VMLimits m_Limits;
+    VMLimits m_Active;          // limits of the outermost call in progress
+    VMFault  m_Fault = VMFault::None;
+    const std::vector<bool>* m_AllowedNatives = nullptr;
+    u64 m_InstructionCount = 0;
+    u64 m_Budget = 0;           // instructions left in the current slice
+    u64 m_Reserve = 0;          // instructions left after this slice
+    u64 m_CallInstructions = 0; // budget the outermost call started with
+    std::chrono::steady_clock::time_point m_Deadline;
+    u32 m_HostDepth = 0;        // nested host calls (natives calling back in)
+    VMFiber* m_Running = nullptr;   // coroutine being resumed
+    u32 m_RunningDepth = 0;         // host depth of that Resume
+    bool m_SuspendRequested = false;
+    std::vector<std::pair<u32, VMHeap::RootMarker>> m_ExtraRoots;
+    u32 m_NextRootMarker = 0;
+    std::vector<std::pair<VMHook*, u32>> m_Hooks;     // hook, step interval
+    u32 m_StepInterval = 0;
+};
+
+} // namespace gv
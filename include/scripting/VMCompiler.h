@@ -0,0 +1,100 @@
+// ============================================================================
+// GameVoid Engine — GVScript Tokenizer and Bytecode Compiler
+// ============================================================================
+// Turns GVScript source into VMFunction bytecode in a single pass:
+//   • Stack bytecode; the stack depth of every function is tracked at
+//     compile time so a call reserves exactly what it needs
+//   • Function parameters and `var`s declared inside functions are locals
+//     (stack slots); captured locals become upvalues, so anonymous
+//     `func (…) { … }` expressions are real closures
+//   • `var` at the top level of a chunk declares a global, as before, and
+//     `func name(…)` adds to the engine's function table
+//   • Array `[a, b]` and map `{ key: v }` literals, indexing `a[i]` and
+//     field access `m.key`
+//   • `yield` suspends a coroutine until the next frame; `wait_until(c)`
+//     compiles to a loop that yields until `c` holds
+//   • Calls to natives registered before compilation are bound to the
+//     native's slot, so they skip the by-name lookup at run time
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include "scripting/VMHeap.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace gv {
+
+struct ScriptToken {
+    enum Kind {
+        Eof, Number, Str, Ident, LParen, RParen, LBrace, RBrace, LBracket, RBracket,
+        Comma, Semicolon, Colon, Assign, Plus, Minus, Star, Slash, Percent,
+        Eq, Neq, Lt, Gt, Lte, Gte, And, Or, Not, Dot,
+        If, Else, While, For, Func, Return, Var, True_, False_, Nil_, Yield, WaitUntil
+    };
+    Kind kind = Eof;
+    std::string text;
+    f64 numVal = 0;
+    i32 line = 0;
+};
+
+/// Split source into tokens; always ends with an Eof token.
+std::vector<ScriptToken> TokenizeScript(const std::string& source);
+
+enum class VMOp : u8 {
+    Const,          // u16 constant          → value
+    Nil, True, False,
+    Pop,
+    GetLocal,       // u8 slot
+    SetLocal,       // u8 slot  (value stays on the stack)
+    GetUpvalue,     // u8 index
+    SetUpvalue,     // u8 index
+    GetGlobal,      // u16 name
+    SetGlobal,      // u16 name
+    DefineGlobal,   // u16 name  (pops)
+    DefineFunc,     // u16 name  (pops a closure into the function table)
+    GetIndex,       // obj key        → value
+    SetIndex,       // obj key value  → value
+    GetField,       // u16 name: obj → value
+    SetField,       // u16 name: obj value → value
+    Add, Sub, Mul, Div, Mod, Neg, Not,
+    Eq, Neq, Lt, Gt, Lte, Gte,
+    ToBool,
+    Jump,           // u16 forward offset
+    JumpIfFalse,    // u16 forward offset (condition stays on the stack)
+    Loop,           // u16 backward offset
+    Call,           // u8 argc: callee args… → result
+    CallNamed,      // u16 name, u8 argc: slot args… → result (natives first, then functions)
+    CallNative,     // u16 native index, u8 argc: slot args… → result
+    Closure,        // u16 function, then (isLocal u8, index u8) per upvalue
+    CloseUpvalue,   // close the top slot and pop it
+    Return,
+    Array,          // u16 count
+    Map,            // u16 pair count
+    Yield,          // suspend the coroutine → resume value
+};
+
+/// Readable listing of a function and its nested functions (debugging).
+std::string DisassembleFunction(const VMFunction* function);
+
+class VMCompiler {
+public:
+    /// Native name → slot in the VM's native table.
+    using NativeTable = std::unordered_map<VMString*, u32>;
+
+    explicit VMCompiler(VMHeap& heap, const NativeTable* natives = nullptr)
+        : m_Heap(heap), m_Natives(natives) {}
+
+    /// Compile a chunk into a parameterless function.  Returns nullptr and
+    /// fills `error` ("chunk:line: message") on failure.  The collector is
+    /// paused for the duration; the result must be rooted by the caller
+    /// before the next safepoint.
+    VMFunction* Compile(const std::string& source, const std::string& chunkName, std::string& error);
+
+private:
+    VMHeap& m_Heap;
+    const NativeTable* m_Natives;
+};
+
+} // namespace gv
@@ -0,0 +1,376 @@
+// ============================================================================
+// GameVoid Engine — GVScript Values and Garbage-Collected Heap
+// ============================================================================
+// Runtime data model of the script VM:
+//   • VMValue is 8 bytes: a double, or a NaN-boxed nil / bool / object
+//     pointer.  Copying a value never allocates
+//   • Strings are interned — one VMString per distinct text — so equality
+//     and table lookups compare pointers
+//   • Arrays, maps, functions, closures and upvalues live on a heap
+//     reclaimed by an incremental tri-colour mark-sweep collector.  Work is
+//     done in bounded steps (at VM safepoints and from a per-frame budget),
+//     never in one long pause; a write barrier keeps stores into already
+//     scanned objects safe while marking is in progress
+// Containers are mutated through the heap (ArrayPush, MapSet, …) so the
+// barrier and the byte accounting can't be forgotten.
+// ============================================================================
+#pragma once
+
+#include "core/Types.h"
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace gv {
+
+struct VMObject;
+struct VMString;
+struct VMArray;
+struct VMMap;
+struct VMFunction;
+struct VMClosure;
+struct VMUpvalue;
+
+static_assert(sizeof(void*) == 8, "VMValue stores object pointers in 48 bits");
+
+// ============================================================================
+// VMValue
+// ============================================================================
+class VMValue {
+public:
+    VMValue() : m_Bits(kNil) {}
+
+    static VMValue Nil()            { return VMValue(); }
+    static VMValue Bool(bool b)     { return FromBits(b ? kTrue : kFalse); }
+    static VMValue Number(f64 n) {
+        if (n != n) return FromBits(kCanonicalNaN);   // keep NaNs out of tag space
+        u64 bits;
+        std::memcpy(&bits, &n, sizeof(bits));
+        return FromBits(bits);
+    }
+    static VMValue Object(const VMObject* obj) {
+        return FromBits(kSign | kQNaN | static_cast<u64>(reinterpret_cast<uintptr_t>(obj)));
+    }
+    static VMValue FromBits(u64 bits) { VMValue v; v.m_Bits = bits; return v; }
+
+    bool IsNil() const     { return m_Bits == kNil; }
+    bool IsBool() const    { return (m_Bits | 1) == kTrue; }
+    bool IsNumber() const  { return (m_Bits & kQNaN) != kQNaN; }
+    bool IsObject() const  { return (m_Bits & (kSign | kQNaN)) == (kSign | kQNaN); }
+    inline bool IsString() const;
+    inline bool IsArray() const;
+    inline bool IsMap() const;
+    inline bool IsClosure() const;
+
+    f64 AsNumber() const { f64 n; std::memcpy(&n, &m_Bits, sizeof(n)); return n; }
+    bool AsBool() const  { return m_Bits == kTrue; }
+    VMObject*  AsObject() const  { return reinterpret_cast<VMObject*>(static_cast<uintptr_t>(m_Bits & ~(kSign | kQNaN))); }
+    VMString*  AsString() const  { return reinterpret_cast<VMString*>(AsObject()); }
+    VMArray*   AsArray() const   { return reinterpret_cast<VMArray*>(AsObject()); }
+    VMMap*     AsMap() const     { return reinterpret_cast<VMMap*>(AsObject()); }
+    VMClosure* AsClosure() const { return reinterpret_cast<VMClosure*>(AsObject()); }
+
+    /// nil and false are false; numbers are true unless 0; strings unless
+    /// empty; every other object is true.
+    inline bool Truthy() const;
+    /// Numbers as-is, booleans as 1 / 0, everything else 0.
+    f64 ToNumber() const {
+        if (IsNumber()) return AsNumber();
+        if (IsBool())   return AsBool() ? 1.0 : 0.0;
+        return 0.0;
+    }
+
+    u64 Bits() const { return m_Bits; }
+    bool operator==(const VMValue& o) const { return m_Bits == o.m_Bits; }
+    bool operator!=(const VMValue& o) const { return m_Bits != o.m_Bits; }
+
+private:
+    static constexpr u64 kSign         = 0x8000000000000000ull;
+    static constexpr u64 kQNaN         = 0x7ffc000000000000ull;
+    static constexpr u64 kCanonicalNaN = 0x7ff8000000000000ull;
+    static constexpr u64 kNil          = kQNaN | 1;
+    static constexpr u64 kFalse        = kQNaN | 2;
+    static constexpr u64 kTrue         = kQNaN | 3;
+
+    u64 m_Bits;
+};
+static_assert(sizeof(VMValue) == 8, "VMValue must stay one machine word");
+
+// ============================================================================
+// Heap objects
+// ============================================================================
+enum class VMObjectType : u8 { String, Array, Map, Function, Closure, Upvalue };
+
+struct VMObject {
+    VMObjectType type;
+    u8           color = 0;         // GC colour, managed by VMHeap
+    u32          bytes = 0;         // size last accounted to the heap
+    VMObject*    next  = nullptr;   // all-objects list
+    explicit VMObject(VMObjectType t) : type(t) {}
+};
+
+/// Interned, immutable; the characters follow the header in one block.
+struct VMString : VMObject {
+    u32 hash   = 0;
+    u32 length = 0;
+    VMString() : VMObject(VMObjectType::String) {}
+    const char* Chars() const { return reinterpret_cast<const char*>(this + 1); }
+    std::string_view View() const { return std::string_view(Chars(), length); }
+};
+
+struct VMArray : VMObject {
+    std::vector<VMValue> items;
+    VMArray() : VMObject(VMObjectType::Array) {}
+};
+
+/// Insertion-ordered hash map.  Keys are compared by value bits, which for
+/// interned strings is string equality.
+struct VMMap : VMObject {
+    std::vector<VMValue> keys;
+    std::vector<VMValue> values;
+    std::unordered_map<u64, u32> index;   // key bits → slot
+    VMMap() : VMObject(VMObjectType::Map) {}
+
+    /// -0 and 0 are the same key.
+    static VMValue NormalKey(VMValue key) {
+        return (key.IsNumber() && key.AsNumber() == 0.0) ? VMValue::Number(0.0) : key;
+    }
+    const VMValue* Find(VMValue key) const {
+        auto it = index.find(NormalKey(key).Bits());
+        return it != index.end() ? &values[it->second] : nullptr;
+    }
+    u32 Size() const { return static_cast<u32>(keys.size()); }
+};
+
+/// Compiled function body (prototype).  Nested functions are constants.
+/// Debug info: a named local, live in slot `slot` for code in [startPc, endPc).
+struct VMLocalName {
+    std::string name;
+    u8  slot = 0;
+    u32 startPc = 0;
+    u32 endPc = 0;
+};
+
+struct VMFunction : VMObject {
+    VMString* name  = nullptr;
+    VMString* chunk = nullptr;      // source name for error messages
+    u8  arity = 0;
+    u8  upvalueCount = 0;
+    u32 maxStack = 0;               // slots needed above the frame base
+    std::vector<u8>      code;
+    std::vector<i32>     lines;     // source line per code byte
+    std::vector<VMValue> constants;
+    std::vector<VMLocalName> localNames;    // for debuggers
+    std::vector<std::string> upvalueNames;
+    VMFunction() : VMObject(VMObjectType::Function) {}
+};
+
+/// A captured variable.  Open while the variable is still on the stack
+/// (`stack` + `slot`), closed (holding the value itself) afterwards.
+struct VMUpvalue : VMObject {
+    std::vector<VMValue>* stack = nullptr;
+    u32        slot = 0;
+    VMValue    closed;
+    VMUpvalue* nextOpen = nullptr;
+    VMUpvalue() : VMObject(VMObjectType::Upvalue) {}
+
+    bool IsOpen() const { return stack != nullptr; }
+    VMValue Get() const { return stack ? (*stack)[slot] : closed; }
+};
+
+struct VMClosure : VMObject {
+    VMFunction* function = nullptr;
+    std::vector<VMUpvalue*> upvalues;
+    VMMap* env = nullptr;       // instance variables it sees first (nullptr = globals only)
+    VMClosure() : VMObject(VMObjectType::Closure) {}
+};
+
+inline bool VMValue::IsString() const  { return IsObject() && AsObject()->type == VMObjectType::String; }
+inline bool VMValue::IsArray() const   { return IsObject() && AsObject()->type == VMObjectType::Array; }
+inline bool VMValue::IsMap() const     { return IsObject() && AsObject()->type == VMObjectType::Map; }
+inline bool VMValue::IsClosure() const { return IsObject() && AsObject()->type == VMObjectType::Closure; }
+
+inline bool VMValue::Truthy() const {
+    if (IsNumber()) return AsNumber() != 0.0;
+    if (IsBool())   return AsBool();
+    if (IsNil())    return false;
+    if (IsString()) return AsString()->length != 0;
+    return true;
+}
+
+// ============================================================================
+// VMHeap
+// ============================================================================
+struct VMHeapStats {
+    u64 bytesAllocated = 0;     // live estimate: objects + container storage
+    u64 objectCount    = 0;
+    u64 stringCount    = 0;     // entries in the intern table
+    u64 allocations    = 0;     // objects ever allocated
+    u64 bytesRequested = 0;     // bytes ever allocated, including container growth
+    u64 freed          = 0;     // objects ever freed
+    u64 cycles         = 0;     // completed collections
+    u64 steps          = 0;     // incremental steps taken
+};
+
+enum class VMGCPhase : u8 { Idle, Mark, Sweep };
+
+class VMHeap {
+public:
+    /// Called at the start and at the end (atomically) of marking; must
+    /// MarkValue / MarkObject every root.
+    using RootMarker = std::function<void(VMHeap&)>;
+
+    VMHeap();
+    ~VMHeap();
+    VMHeap(const VMHeap&) = delete;
+    VMHeap& operator=(const VMHeap&) = delete;
+
+    void SetRootMarker(RootMarker marker) { m_RootMarker = std::move(marker); }
+
+    // ── Allocation ─────────────────────────────────────────────────────────
+    /// The one string object with this text.
+    VMString*   Intern(std::string_view text);
+    /// The interned string with this text, or nullptr (never allocates).
+    VMString*   FindString(std::string_view text) const;
+    VMArray*    NewArray(u32 reserve = 0);
+    VMMap*      NewMap();
+    VMFunction* NewFunction();
+    VMClosure*  NewClosure(VMFunction* function);
+    VMUpvalue*  NewUpvalue(std::vector<VMValue>* stack, u32 slot);
+
+    // ── Mutation (barrier + accounting) ────────────────────────────────────
+    void ArrayPush(VMArray* array, VMValue value);
+    void ArraySet(VMArray* array, u32 index, VMValue value) {
+        array->items[index] = value;
+        Barrier(array, value);
+    }
+    void ArrayResize(VMArray* array, u32 size);
+    void MapSet(VMMap* map, VMValue key, VMValue value);
+    bool MapRemove(VMMap* map, VMValue key);
+    void CloseUpvalue(VMUpvalue* upvalue);
+    void SetUpvalue(VMUpvalue* upvalue, VMValue value);
+    /// Store `value` into `container` — re-queues the container if it was
+    /// already scanned and the value hasn't been reached yet.
+    void Barrier(VMObject* container, VMValue value) {
+        if (m_Phase == VMGCPhase::Mark && container->color == kBlack &&
+            value.IsObject() && value.AsObject()->color == m_White)
+            Regray(container);
+    }
+    /// Re-measure an object whose storage changed outside the helpers
+    /// above (e.g. a function filled in by the compiler).
+    void Reaccount(VMObject* obj);
+
+    // ── Quotas ─────────────────────────────────────────────────────────────
+    /// Limit allocations from now on (0 = no limit): total bytes, the
+    /// longest string and the most elements in one array or map.  A breach
+    /// isn't refused — the heap can't fail mid-instruction — but recorded,
+    /// and the VM stops the script at its next safepoint.
+    void SetQuota(u64 bytes, u32 maxStringLength, u32 maxContainerSize);
+    void ClearQuota();
+    bool OverQuota() const { return m_Stats.bytesRequested > m_QuotaCeiling; }
+    /// What was breached (valid while OverQuota()).
+    std::string QuotaBreach() const;
+
+    // ── Marking (for root markers) ─────────────────────────────────────────
+    void MarkValue(VMValue value) { if (value.IsObject()) MarkObject(value.AsObject()); }
+    void MarkObject(VMObject* obj);
+
+    /// Keep a value alive across allocations in native code; pairs with
+    /// PopRoot (or use VMTempRoot).
+    void PushRoot(VMValue value) { m_TempRoots.push_back(value); }
+    void PopRoot() { m_TempRoots.pop_back(); }
+
+    // ── Collection ─────────────────────────────────────────────────────────
+    /// Run up to `work` units (≈ objects visited) of the current cycle,
+    /// starting one if the heap is over its threshold or `force` is set.
+    /// Returns true when a cycle completed during this call.
+    bool Step(u32 work, bool force = false);
+    /// Finish the current cycle (if any) and run one complete cycle.
+    void FullCollect();
+    /// Cheap check for the VM: pays allocation debt with collector work.
+    void SafePoint() { if (m_Debt >= kStepDebt && m_Pause == 0) PayDebt(); }
+    bool WantsStep() const { return m_Phase != VMGCPhase::Idle || m_Stats.bytesAllocated >= m_Threshold; }
+
+    /// Nestable; while paused no collector work runs (e.g. during compile).
+    void Pause()  { ++m_Pause; }
+    void Resume() { if (m_Pause) --m_Pause; }
+
+    /// Heap size that starts the next cycle is live-after-collection times
+    /// this (default 2), but never below `minThreshold` bytes.
+    void SetGrowthFactor(f32 factor) { m_GrowthFactor = factor > 1.1f ? factor : 1.1f; }
+    void SetMinThreshold(u64 bytes)  { m_MinThreshold = bytes; }
+
+    VMGCPhase GetPhase() const { return m_Phase; }
+    VMHeapStats GetStats() const;
+    u64 GetBytesAllocated() const { return m_Stats.bytesAllocated; }
+
+    /// Free everything.  Only for teardown: no value may be used afterwards.
+    void Reset();
+
+private:
+    static constexpr u8  kGray  = 2;
+    static constexpr u8  kBlack = 3;
+    static constexpr u64 kStepDebt = 16 * 1024;
+
+    template <typename T> T* Track(T* obj);
+    void Free(VMObject* obj);
+    void CheckSize(u64 size, u32 limit, const char* what) {
+        if (limit && size > limit && !m_SizeBreach) { m_SizeBreach = what; m_QuotaCeiling = 0; }
+    }
+    void Regray(VMObject* obj);
+    void Traverse(VMObject* obj);
+    void BeginCycle();
+    void Atomic();
+    void PayDebt();
+    /// Bytes charged for an object, by its static type (Track) or its
+    /// runtime tag (Reaccount, Free).
+    static size_t SizeOf(const VMString* s);
+    static size_t SizeOf(const VMArray* a);
+    static size_t SizeOf(const VMMap* m);
+    static size_t SizeOf(const VMFunction* f);
+    static size_t SizeOf(const VMClosure* c);
+    static size_t SizeOf(const VMUpvalue* u);
+    static size_t ObjectBytes(const VMObject* obj);
+
+    // Intern table: open addressing, power-of-two capacity.
+    VMString** FindSlot(std::string_view text, u32 hash);
+    void GrowStrings();
+    void PurgeDeadStrings();
+
+    VMObject*   m_Objects = nullptr;
+    VMObject**  m_SweepCursor = nullptr;
+    std::vector<VMObject*> m_Gray;
+    std::vector<VMValue>   m_TempRoots;
+    std::vector<VMString*> m_Strings;         // nullptr = empty, kTombstone = deleted
+    u32         m_StringCount = 0, m_StringUsed = 0;   // live / live + tombstones
+    RootMarker  m_RootMarker;
+
+    VMGCPhase   m_Phase = VMGCPhase::Idle;
+    u8          m_White = 0;                  // current white (0 or 1)
+    u32         m_Pause = 0;
+    u64         m_Debt = 0;
+    u64         m_Threshold = 1024 * 1024;
+    u64         m_MinThreshold = 1024 * 1024;
+    u64         m_QuotaCeiling = ~0ull;       // bytesRequested allowed; 0 after a size breach
+    u64         m_QuotaBytes = 0;
+    u32         m_StringLimit = 0, m_ContainerLimit = 0;
+    const char* m_SizeBreach = nullptr;
+    f32         m_GrowthFactor = 2.0f;
+    VMHeapStats m_Stats;
+};
+
+/// RAII temporary root.
+class VMTempRoot {
+public:
+    VMTempRoot(VMHeap& heap, VMValue value) : m_Heap(heap) { heap.PushRoot(value); }
+    ~VMTempRoot() { m_Heap.PopRoot(); }
+    VMTempRoot(const VMTempRoot&) = delete;
+    VMTempRoot& operator=(const VMTempRoot&) = delete;
+private:
+    VMHeap& m_Heap;
+};
+
+} // namespace gv
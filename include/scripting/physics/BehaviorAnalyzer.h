@@ -5,11 +5,14 @@
 // and computes metrics like kinetic energy, momentum, and impact force.
 //
 // Used to understand physics interaction and debug object behavior.
+// Analyzers are updated in one batched pass by BehaviorAnalysisSystem after
+// the physics step; histories live in fixed-capacity ring buffers.
 // ============================================================================
 #pragma once
 
 #include "core/Math.h"
 #include "core/Component.h"
+#include "core/RingBuffer.h"
 #include <string>
 #include <vector>
 
@@ -35,14 +38,61 @@ struct BehaviorMetric {
     bool isActive = false;
 };
 
+class RigidBody;
+class RigidBody2D;
+
+// ── Rolling statistics over a history window ───────────────────────────────
+/// Window statistics for one traced channel.  Mean and variance are kept
+/// incrementally as samples enter and leave the ring buffer; percentile and
+/// oscillation are evaluated on demand over the contiguous history view.
+struct RollingStats {
+    f64 sum   = 0.0;
+    f64 sumSq = 0.0;
+    size_t count = 0;
+
+    void Add(f32 v)    { sum += v; sumSq += f64(v) * v; ++count; }
+    void Remove(f32 v) { sum -= v; sumSq -= f64(v) * v; if (count) --count; }
+    void Reset()       { sum = sumSq = 0.0; count = 0; }
+
+    f32 Mean() const     { return count ? f32(sum / f64(count)) : 0.0f; }
+    f32 Variance() const {
+        if (count < 2) return 0.0f;
+        f64 m = sum / f64(count);
+        f64 v = sumSq / f64(count) - m * m;
+        return v > 0.0 ? f32(v) : 0.0f;
+    }
+    f32 StdDev() const   { return std::sqrt(Variance()); }
+};
+
+/// Result of zero-crossing oscillation analysis (no FFT).
+struct OscillationInfo {
+    bool oscillating = false;
+    f32  frequency   = 0.0f;   // Hz, from mean-crossing rate
+    f32  amplitude   = 0.0f;   // half of the mean peak-to-peak swing
+    i32  crossings   = 0;      // hysteresis-filtered mean crossings in the window
+};
+
+/// Traced channels, in export column order.
+enum class BehaviorChannel : i32 { Velocity = 0, Energy, Momentum, Count };
+
 // ============================================================================
 // BehaviorAnalyzer — Tracks and analyzes physics object behavior
 // ============================================================================
 class BehaviorAnalyzer : public Component {
 public:
+    ~BehaviorAnalyzer() override;
     std::string GetTypeName() const override { return "BehaviorAnalyzer"; }
 
     // ── Lifecycle ──────────────────────────────────────────────────────────
+    void OnAttach() override;
+    void OnDetach() override;
+    void OnComponentAdded(Component* added) override;
+    void OnComponentRemoved(Component* removed) override;
+
+    /// Analyze this object for one frame.  Normally called by
+    /// BehaviorAnalysisSystem::Analyze(); safe to call directly.  Reads the
+    /// owner's RigidBody / RigidBody2D found on attach (refreshed when one
+    /// is added or removed).
     void Update(f32 dt);
     void OnDestroy();
 
@@ -60,9 +110,29 @@ public:
     f32 GetImpactForce() const { return m_ImpactForce; }
     f32 GetNetForceMagnitude() const { return m_NetForceMagnitude; }
 
-    // ── History tracking ──────────────────────────────────────────────────
-    const std::vector<f32>& GetVelocityHistory() const { return m_VelocityHistory; }
-    const std::vector<f32>& GetEnergyHistory() const { return m_EnergyHistory; }
+    // ── History tracking (oldest-first, contiguous) ───────────────────────
+    ArrayView<f32> GetVelocityHistory() const { return m_History[0].View(); }
+    ArrayView<f32> GetEnergyHistory() const   { return m_History[1].View(); }
+    ArrayView<f32> GetMomentumHistory() const { return m_History[2].View(); }
+    ArrayView<f32> GetHistory(BehaviorChannel ch) const { return m_History[static_cast<i32>(ch)].View(); }
+
+    // ── Rolling statistics over the history window ────────────────────────
+    f32 GetMean(BehaviorChannel ch) const     { return m_Stats[static_cast<i32>(ch)].Mean(); }
+    f32 GetVariance(BehaviorChannel ch) const { return m_Stats[static_cast<i32>(ch)].Variance(); }
+    /// p in [0, 100]; nearest-rank over the current window.  The window is
+    /// sorted into a reused buffer at most once per recorded frame.
+    f32 GetPercentile(BehaviorChannel ch, f32 p) const;
+    /// Mean-crossing oscillation detection.  `minAmplitude` is the hysteresis
+    /// band a swing must clear; `minCycles` full cycles are required.
+    OscillationInfo DetectOscillation(BehaviorChannel ch, f32 minAmplitude = 0.05f,
+                                      i32 minCycles = 2) const;
+
+    // ── Trace export ──────────────────────────────────────────────────────
+    /// CSV with a header row: frame,time,velocity,energy,momentum
+    bool ExportCSV(const std::string& path) const;
+    /// Little-endian binary: "GVBT", u32 version, u32 samples, u32 channels,
+    /// f32 sampleDt, then each channel as `samples` consecutive f32 values.
+    bool ExportBinary(const std::string& path) const;
 
     // ── Behavior flags ─────────────────────────────────────────────────────
     bool isMoving = false;
@@ -84,7 +154,11 @@ public:
 
 private:
     PhysicsBehaviorState m_BehaviorState = PhysicsBehaviorState::Idle;
-    
+
+    // The analyzed body
+    const RigidBody*   m_Body   = nullptr;
+    const RigidBody2D* m_Body2D = nullptr;
+
     // Current metrics
     f32 m_VelocityMagnitude = 0.0f;
     f32 m_AccelerationMagnitude = 0.0f;
@@ -99,18 +173,54 @@ private:
     Vec3 m_PreviousVelocity { 0, 0, 0 };
     Vec3 m_PreviousAngularVel { 0, 0, 0 };
 
-    // History buffers (for graphing)
-    std::vector<f32> m_VelocityHistory;
-    std::vector<f32> m_EnergyHistory;
-    std::vector<f32> m_MomentumHistory;
+    // History ring buffers (for graphing) and their window statistics
+    static constexpr i32 kChannelCount = static_cast<i32>(BehaviorChannel::Count);
+    RingBuffer<f32> m_History[kChannelCount];
+    RollingStats    m_Stats[kChannelCount];
+    f32 m_SampleDt     = 0.0f;   // smoothed frame time, used for export / frequency
+    u64 m_FramesRecorded = 0;
+
+    // Sorted copies of the windows for GetPercentile, valid for one frame
+    mutable std::vector<f32> m_Sorted[kChannelCount];
+    mutable u64              m_SortedFrame[kChannelCount] = {};
 
     // Internal metrics map
     std::vector<BehaviorMetric> m_Metrics;
 
-    void UpdateMetrics(f32 dt);
+    void BindBody();
+    void UpdateMetrics(f32 dt, const RigidBody* body, const RigidBody2D* body2D);
     void UpdateBehaviorState();
-    void RecordToHistory();
-    void ComputeAcceleration();
+    void RecordToHistory(f32 dt);
+    void ComputeAcceleration(const Vec3& currentVel, f32 dt);
+};
+
+// ============================================================================
+// BehaviorAnalysisSystem — batched update of every live analyzer
+// ============================================================================
+/// Analyzers register themselves on attach.  The engine calls Analyze() once
+/// after each physics step, walking a flat array instead of visiting every
+/// GameObject and looking components up by type.
+class BehaviorAnalysisSystem {
+public:
+    static BehaviorAnalysisSystem& Instance() {
+        static BehaviorAnalysisSystem s_Instance;
+        return s_Instance;
+    }
+
+    void Register(BehaviorAnalyzer* analyzer);
+    void Unregister(BehaviorAnalyzer* analyzer);
+
+    /// Run one analysis pass over all enabled analyzers.
+    void Analyze(f32 dt);
+
+    /// Combined long-format CSV: object,frame,velocity,energy,momentum
+    bool ExportCSV(const std::string& path) const;
+
+    size_t GetAnalyzerCount() const { return m_Analyzers.size(); }
+    void   Clear() { m_Analyzers.clear(); }
+
+private:
+    std::vector<BehaviorAnalyzer*> m_Analyzers;
 };
 
 } // namespace gv
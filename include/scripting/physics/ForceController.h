@@ -16,9 +16,13 @@
 #include "core/Component.h"
 #include "core/Math.h"
 #include <string>
+#include <vector>
 
 namespace gv {
 
+class RigidBody;
+class RigidBody2D;
+
 // ── Force direction types ──────────────────────────────────────────────────
 enum class ForceDirection {
     Forward,   // +Z / +X (2D)
@@ -48,6 +52,10 @@ public:
     // ── Lifecycle ──────────────────────────────────────────────────────────
     void OnCreate();
     void OnDestroy();
+    void OnAttach() override { BindBody(); }
+    void OnDetach() override { m_Body = nullptr; m_Body2D = nullptr; }
+    void OnComponentAdded(Component* added) override;
+    void OnComponentRemoved(Component* removed) override;
     void Update(f32 dt);
 
     // ── Force application ──────────────────────────────────────────────────
@@ -88,11 +96,16 @@ public:
     // ── Input binding (keyboard to forces) ─────────────────────────────────
     /// Bind a key to apply a force in a direction
     /// e.g., BindKeyToForce("W", ForceDirection::Up, 100.0f)
-    void BindKeyToForce(const std::string& keyName, ForceDirection dir, f32 magnitude);
+    /// Key names are ImGui key names ("W", "Space", "UpArrow", ...) and are
+    /// resolved to a key code once here.  Returns false for unknown names.
+    bool BindKeyToForce(const std::string& keyName, ForceDirection dir, f32 magnitude);
 
     /// Bind a key to apply a moment in a direction
     /// e.g., BindKeyToMoment("Q", MomentDirection::Roll, 50.0f)
-    void BindKeyToMoment(const std::string& keyName, MomentDirection dir, f32 magnitude);
+    bool BindKeyToMoment(const std::string& keyName, MomentDirection dir, f32 magnitude);
+
+    /// Look up an ImGui key code by name (-1 if unknown).
+    static i32 ResolveKeyCode(const std::string& keyName);
 
     // ── Force limits ───────────────────────────────────────────────────────
     /// Maximum velocity (clamped)
@@ -134,13 +147,22 @@ private:
     f32 m_MaxVelocity = 100.0f;
     f32 m_MaxAngularVelocity = 360.0f;
 
-    // Input tracking
-    std::vector<std::pair<std::string, std::pair<ForceDirection, f32>>> m_KeyForceBindings;
-    std::vector<std::pair<std::string, std::pair<MomentDirection, f32>>> m_KeyMomentBindings;
+    // Input tracking (key codes resolved at bind time)
+    struct KeyForceBinding  { i32 key; ForceDirection  dir; f32 magnitude; };
+    struct KeyMomentBinding { i32 key; MomentDirection dir; f32 magnitude; };
+    std::vector<KeyForceBinding>  m_KeyForceBindings;
+    std::vector<KeyMomentBinding> m_KeyMomentBindings;
+
+    // The owner's body, found on attach and refreshed when a sibling
+    // component is added or removed.
+    RigidBody*   m_Body   = nullptr;
+    RigidBody2D* m_Body2D = nullptr;
+    f32          m_Dt     = 1.0f / 60.0f;   // last Update() step
 
     // Internal helpers
     Vec3 GetForceDirectionVector(ForceDirection dir) const;
     Vec3 GetMomentDirectionVector(MomentDirection dir) const;
+    void BindBody();
     void ProcessInputBindings();
     void ApplyDamping(f32 dt);
     void ClampVelocities();
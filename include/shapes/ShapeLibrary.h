@@ -2,6 +2,7 @@
 #include "geometry/Primitives.h"
 #include "geometry/MeshBuilder.h"
 #include "core/Math.h"
+#include "core/Types.h"
 #include <string>
 #include <vector>
 
@@ -12,6 +13,11 @@
 //  Dimensions are in metres unless noted.
 // ─────────────────────────────────────────────────────────────────────────────
 
+namespace gv {
+
+class Mesh;
+class MeshRegistry;
+
 namespace Shapes {
 
     // ── Architectural ─────────────────────────────────────────────────────────
@@ -62,4 +68,12 @@ namespace Shapes {
     MeshData Hill(float radius, float height, int segs = 16);
     MeshData Canyon(float length, float width, float depth, int segs = 20);
 
+    // ── Shared meshes ─────────────────────────────────────────────────────────
+    /// The named shape with its default parameters ("Chair", "Table", "Tree",
+    /// "CarWheel", …) from the registry, built and uploaded on first use.
+    /// Null for names without an all-default overload.  Other parameters go
+    /// through registry.Generate("Shapes::Gear", &Shapes::Gear, …).
+    Shared<Mesh> Acquire(MeshRegistry& registry, const std::string& name);
+
 } // namespace Shapes
+} // namespace gv
@@ -2,83 +2,168 @@
 #include "core/Component.h"
 #include "core/Math.h"
 #include "core/GameObject.h"
+#include "core/Scene.h"
 #include "physics/Physics.h"
+#include "vehicle/RaycastVehicle.h"
 #include <cmath>
 #include <string>
+#include <vector>
 
 namespace gv {
 
-// CarController3D can run on any dynamic body.
+// CarController3D can run on any dynamic body.  Driving is simulated by a
+// RaycastVehicle (suspension, tyres, drivetrain); this component maps the
+// editor's forward/turn axes onto throttle, brake, reverse and steering.
 class CarController3D : public ::gv::Component {
 public:
-    // Tuning
-    float maxSpeed       = 20.0f;   // m/s forward top speed
+    // Tuning.  The arcade-era fields now act as limits on the vehicle model:
+    // the stick never drives it past them.
+    float maxSpeed       = 20.0f;   // m/s forward top speed (throttle cut)
     float reverseSpeed   =  8.0f;   // m/s reverse top speed
-    float acceleration   = 15.0f;   // m/s^2 throttle ramp
-    float brakingPower   = 25.0f;   // m/s^2 brake/reverse deceleration
+    float acceleration   = 15.0f;   // m/s^2 most the throttle may accelerate
+    float brakingPower   = 25.0f;   // m/s^2 most the brakes may decelerate
     float turnSpeed      = 90.0f;   // deg/s yaw rate at full steering
-    float drag           =  2.5f;   // natural speed decay (no input)
-    float angularDamp    =  0.95f;  // applied each frame to RB angular velocity
+    float drag           =  2.5f;   // m/s^2 coasting deceleration (no input)
+    float angularDamp    =  0.95f;  // RigidBody angular drag, applied with the mass
+    float chassisMass    = 1200.0f; // kg (vehicle defaults assume ~1.2 t)
 
     // Per-frame input (set by editor or gameplay code)
-    float inputForward = 0.0f;   // -1 = reverse,  0 = neutral,  +1 = accelerate
-    float inputTurn    = 0.0f;   // -1 = left,      0 = straight, +1 = right
+    float inputForward   = 0.0f;   // -1 = brake / reverse,  0 = coast,  +1 = accelerate
+    float inputTurn      = 0.0f;   // -1 = left,  0 = straight,  +1 = right
+    bool  inputHandbrake = false;
 
-    // Runtime state
-    float currentSpeed = 0.0f;   // signed: positive = forward
+    // Runtime state (read-only telemetry)
+    float currentSpeed = 0.0f;   // signed: positive = forward (m/s)
     float heading      = 0.0f;   // yaw in degrees (world Y axis)
 
     std::string GetTypeName() const override { return "CarController3D"; }
+    bool UpdatesOwner() const override { return false; }   // driven by the engine loop
+    GV_SNAPSHOT_COMPONENT(CarController3D)
 
-    // Called every physics step with the car's single RigidBody.
-    void UpdateController(float dt, ::gv::RigidBody* rb) {
+    CarController3D() : m_Vehicle(VehicleConfig::MakeDefaultCar()) {}
+
+    RaycastVehicle&       GetVehicle()       { return m_Vehicle; }
+    const RaycastVehicle& GetVehicle() const { return m_Vehicle; }
+
+    // Bind a visual wheel object to vehicle wheel `index`.  `baseRotation` is
+    // the object's authored rest orientation relative to the chassis.  The
+    // object is kept by ID, so destroying it just unbinds the visual.
+    void BindWheelVisual(size_t index, const ::gv::GameObject* obj, const ::gv::Quaternion& baseRotation) {
+        if (m_WheelVisuals.size() <= index) m_WheelVisuals.resize(index + 1);
+        m_WheelVisuals[index] = { obj ? obj->GetID() : 0u, baseRotation };
+    }
+    void ClearWheelVisuals() { m_WheelVisuals.clear(); }
+
+    void OnAttach() override { ApplyBodyTuning(); }
+
+    /// Reset the drivetrain to rest and re-apply chassisMass / angularDamp.
+    void ResetVehicle() {
+        m_Vehicle.Reset();
+        m_Reverse = false;
+        m_TuningApplied = false;
+        ApplyBodyTuning();
+    }
+
+    // Called every physics step with the car's single RigidBody.  Wheel
+    // visuals are moved when `scene` is given.
+    void UpdateController(float dt, ::gv::RigidBody* rb, const ::gv::PhysicsWorld* physics = nullptr,
+                          ::gv::Scene* scene = nullptr) {
         if (!rb) return;
+        if (!m_TuningApplied) ApplyBodyTuning(rb);   // body added after the controller
 
-        // Acceleration / braking
+        // Forward on the stick accelerates, or brakes while rolling backwards;
+        // back on the stick brakes while rolling forwards, otherwise reverses.
+        ::gv::VehicleInput in;
+        float speed = m_Vehicle.GetForwardSpeed();
         if (inputForward > 0.01f) {
-            currentSpeed += acceleration * inputForward * dt;
+            if (m_Vehicle.GetGear() < 0 && speed < -0.5f) in.brake = inputForward;
+            else { in.throttle = inputForward; m_Reverse = false; }
         } else if (inputForward < -0.01f) {
-            // Braking or reversing
-            if (currentSpeed > 0.1f)
-                currentSpeed -= brakingPower * dt;          // braking forward motion
-            else
-                currentSpeed += acceleration * inputForward * dt; // reversing
-        } else {
-            // Drag
-            float dir = (currentSpeed >= 0.0f) ? 1.0f : -1.0f;
-            currentSpeed -= dir * drag * dt;
-            if (dir * currentSpeed < 0.0f) currentSpeed = 0.0f;
+            if (m_Vehicle.GetGear() > 0 && speed > 0.5f) in.brake = -inputForward;
+            else { in.throttle = -inputForward; m_Reverse = true; }
+        } else if (std::fabs(speed) > 0.1f) {
+            in.brake = std::min(1.0f, drag / std::max(brakingPower, 0.1f));
         }
+        in.reverse   = m_Reverse;
+        in.steer     = inputTurn;
+        in.handbrake = inputHandbrake;
+        ApplyLimits(dt, speed, rb, in);
 
-        // Clamp speed
-        float maxFwd = maxSpeed;
-        float maxRev = -reverseSpeed;
-        if (currentSpeed > maxFwd) currentSpeed = maxFwd;
-        if (currentSpeed < maxRev) currentSpeed = maxRev;
+        m_Vehicle.Step(dt, rb, in, physics);
 
-        // Steering (only effective when moving)
-        float speedRatio = std::abs(currentSpeed) / std::max(maxSpeed, 1.0f);
-        float effectiveTurn = turnSpeed * inputTurn * speedRatio;
-        heading += effectiveTurn * dt;
+        currentSpeed = m_Vehicle.GetForwardSpeed();
+        if (GetOwner()) {
+            ::gv::Vec3 fwd = GetOwner()->GetTransform().rotation.RotateVec3(::gv::Vec3(0, 0, 1));
+            heading = std::atan2(fwd.x, fwd.z) * (180.0f / 3.14159265f);
+        }
+        if (scene) SyncWheelVisuals(*scene);
+    }
 
-        // Drive heading direction
-        float rad = heading * (3.14159265f / 180.0f);
-        ::gv::Vec3 fwd(std::sin(rad), 0.0f, std::cos(rad));
-        ::gv::Vec3 newVel = fwd * currentSpeed;
-        newVel.y = rb->velocity.y;  // preserve gravity / fall velocity
-        rb->velocity = newVel;
+    // Place bound wheel objects at their suspension position with steer + spin.
+    void SyncWheelVisuals(::gv::Scene& scene) {
+        if (!GetOwner()) return;
+        const auto& t      = GetOwner()->GetTransform();
+        const auto& states = m_Vehicle.GetWheelStates();
+        for (size_t i = 0; i < m_WheelVisuals.size() && i < states.size(); ++i) {
+            auto& wv = m_WheelVisuals[i];
+            ::gv::GameObject* wheel = wv.objectID ? scene.FindByID(wv.objectID) : nullptr;
+            if (!wheel) { wv.objectID = 0; continue; }
+            scene.TouchForPlay(wheel);
+            ::gv::Vec3 c = m_Vehicle.GetWheelCenter(i, t.position, t.rotation);
+            ::gv::Quaternion steer = ::gv::Quaternion::FromAxisAngle(::gv::Vec3::Up(), states[i].steerAngle);
+            ::gv::Quaternion spin  = ::gv::Quaternion::FromAxisAngle(::gv::Vec3::Right(), states[i].spinAngle);
+            auto& wt = wheel->GetTransform();
+            wt.position = c;
+            wt.rotation = (t.rotation * steer * spin * wv.baseRotation).Normalized();
+        }
+    }
 
-        // Suppress any spin torques accumulated from physics collisions
-        rb->angularVelocity = rb->angularVelocity * angularDamp;
+private:
+    struct WheelVisual {
+        ::gv::u32        objectID = 0;
+        ::gv::Quaternion baseRotation{};
+    };
 
-        // Sync transform yaw so the mesh faces the right direction
-        if (GetOwner()) {
-            auto& t = GetOwner()->GetTransform();
-            // ::gv::Vec3 euler = t.GetEulerDeg(); // Removed: Transform has no GetEulerDeg
-            // Instead, just set yaw directly (pitch/roll = 0)
-            t.SetEulerDeg(0.0f, heading, 0.0f);
-        }
+    // chassisMass / angularDamp go onto the body once, not every step, so
+    // later edits to the RigidBody stick.
+    void ApplyBodyTuning(::gv::RigidBody* rb = nullptr) {
+        if (!rb && GetOwner()) rb = GetOwner()->GetComponent<::gv::RigidBody>();
+        if (!rb) return;
+        rb->mass        = chassisMass;
+        rb->angularDrag = angularDamp;
+        m_TuningApplied = true;
     }
+
+    // Scale the inputs so the car stays inside maxSpeed / reverseSpeed,
+    // acceleration / brakingPower and turnSpeed.  The gains adapt from the
+    // last step's measured response.
+    void ApplyLimits(float dt, float speed, const ::gv::RigidBody* rb, ::gv::VehicleInput& in) {
+        float accel = dt > 0.0f ? std::fabs(speed - m_PrevSpeed) / dt : 0.0f;
+        float yawRate = std::fabs(rb->angularVelocity.y) * (180.0f / 3.14159265f);
+        m_PrevSpeed = speed;
+        auto adapt = [](float& gain, float measured, float limit) {
+            if (measured > limit && measured > 1e-3f) gain = std::max(0.05f, gain * limit / measured);
+            else                                      gain = std::min(1.0f, gain + 0.05f);
+        };
+        if (in.throttle > 0.0f) adapt(m_ThrottleGain, accel, acceleration);
+        if (in.brake > 0.0f)    adapt(m_BrakeGain, accel, brakingPower);
+        adapt(m_SteerGain, yawRate, turnSpeed);
+
+        float top = m_Reverse ? reverseSpeed : maxSpeed;
+        if (std::fabs(speed) >= top) in.throttle = 0.0f;
+        in.throttle *= m_ThrottleGain;
+        in.brake    *= m_BrakeGain;
+        in.steer    *= m_SteerGain;
+    }
+
+    ::gv::RaycastVehicle     m_Vehicle;
+    std::vector<WheelVisual> m_WheelVisuals;
+    bool                     m_Reverse = false;
+    bool                     m_TuningApplied = false;
+    float                    m_PrevSpeed = 0.0f;
+    float                    m_ThrottleGain = 1.0f;
+    float                    m_BrakeGain = 1.0f;
+    float                    m_SteerGain = 1.0f;
 };
 
 } // namespace gv
@@ -0,0 +1,197 @@
+#pragma once
+#include "core/Math.h"
+#include "core/Types.h"
+#include <array>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace gv {
+
+class RigidBody;
+class Collider;
+class PhysicsWorld;
+
+// RaycastVehicle — wheel/suspension/drivetrain model for a single chassis body.
+// Each wheel casts a ray down its strut; suspension springs, tyre friction and
+// drivetrain torque are turned into velocity changes on the chassis RigidBody.
+// The model is pure CPU code (no scene / renderer dependency) so it can be
+// stepped headlessly with any ground query.
+
+// ─── Ground query ──────────────────────────────────────────────────────────
+struct VehicleRayHit {
+    Vec3 point;
+    Vec3 normal   { 0, 1, 0 };
+    f32  distance = 0.0f;
+    f32  friction = 1.0f;      // surface grip multiplier (asphalt = 1, ice ~ 0.1)
+};
+
+// Returns true and fills `out` if the ray hits ground within maxDistance.
+using VehicleGroundQuery =
+    std::function<bool(const Vec3& origin, const Vec3& dir, f32 maxDistance, VehicleRayHit& out)>;
+
+// ─── Tuning ────────────────────────────────────────────────────────────────
+struct VehicleWheelConfig {
+    std::string name;
+    Vec3 hardpoint;                  // strut top, chassis-local (unscaled) space
+    f32  radius            = 0.35f;
+    f32  restLength        = 0.30f;  // suspension travel from hardpoint
+    f32  springStiffness   = 35000.0f;  // N/m
+    f32  damperCompression = 3000.0f;   // N/(m/s)
+    f32  damperRebound     = 3500.0f;   // N/(m/s)
+    f32  inertia           = 1.5f;      // kg·m²
+    f32  maxBrakeTorque    = 2500.0f;   // N·m
+    i32  axle              = 0;         // 0 = front, 1 = rear (diff / anti-roll grouping)
+    bool steerable         = false;
+    bool handbrake         = false;
+};
+
+// Simplified Pacejka "magic formula": F = D·sin(C·atan(Bx − E(Bx − atan Bx)))
+struct VehicleTireModel {
+    f32 longB = 10.0f, longC = 1.9f, longE = 0.97f;
+    f32 latB  =  8.0f, latC  = 1.3f, latE  = -0.5f;
+    f32 peakFriction      = 1.0f;    // D = peakFriction · load
+    f32 rollingResistance = 0.015f;  // fraction of load
+    f32 lowSpeedThreshold = 2.0f;    // m/s — slip denominators never drop below this
+
+    static f32 MagicFormula(f32 x, f32 B, f32 C, f32 E) {
+        f32 bx = B * x;
+        return std::sin(C * std::atan(bx - E * (bx - std::atan(bx))));
+    }
+};
+
+struct VehicleEngineConfig {
+    std::vector<Vec2> torqueCurve {      // (rpm, N·m), ascending rpm
+        { 1000.0f, 180.0f }, { 2500.0f, 260.0f }, { 4200.0f, 300.0f },
+        { 6000.0f, 270.0f }, { 7000.0f, 210.0f } };
+    f32 idleRPM           = 900.0f;
+    f32 redlineRPM        = 6800.0f;
+    f32 engineBrakeTorque = 60.0f;   // N·m at the crank when off-throttle
+
+    f32 SampleTorque(f32 rpm) const;
+};
+
+struct VehicleGearboxConfig {
+    std::vector<f32> forwardRatios { 3.60f, 2.20f, 1.50f, 1.10f, 0.90f, 0.75f };
+    f32  reverseRatio  = 3.40f;
+    f32  finalDrive    = 3.90f;
+    f32  efficiency    = 0.85f;
+    f32  shiftUpRPM    = 6200.0f;
+    f32  shiftDownRPM  = 2600.0f;
+    f32  shiftTime     = 0.25f;   // seconds of no drive torque while shifting
+    bool automatic     = true;
+};
+
+enum class DifferentialType { Open, Locked, LimitedSlip };
+
+struct VehicleDifferentialConfig {
+    DifferentialType type = DifferentialType::Open;
+    f32 frontTorqueShare  = 0.0f;    // 0 = RWD, 1 = FWD, 0.4 = 40/60 AWD
+    f32 limitedSlipBias   = 150.0f;  // N·m transferred per rad/s of wheel speed difference
+    f32 maxBiasRatio      = 0.6f;    // LSD may move at most this fraction of axle torque
+};
+
+struct VehicleConfig {
+    std::vector<VehicleWheelConfig> wheels;
+    VehicleTireModel           tire;
+    VehicleEngineConfig        engine;
+    VehicleGearboxConfig       gearbox;
+    VehicleDifferentialConfig  differential;
+    f32 antiRollFront    = 8000.0f;  // N/m of left/right compression difference
+    f32 antiRollRear     = 5000.0f;
+    f32 maxSteerAngle    = 35.0f;    // degrees
+    f32 steerSpeed       = 180.0f;   // degrees/s steering rack rate
+    f32 steerSpeedFactor = 0.03f;    // steering lock reduction per m/s
+    f32 aeroDrag         = 0.40f;    // F = aeroDrag · |v| · v
+
+    // Four-wheel layout matching VehicleBlueprint wheel offsets.
+    static VehicleConfig MakeDefaultCar(f32 halfTrack = 0.95f, f32 halfBase = 1.4f,
+                                        f32 hardpointY = -0.25f, f32 wheelRadius = 0.35f);
+};
+
+// ─── Runtime state ─────────────────────────────────────────────────────────
+struct VehicleWheelState {
+    bool grounded        = false;
+    f32  compression     = 0.0f;   // metres (0 = fully extended)
+    f32  prevCompression = 0.0f;
+    f32  suspensionForce = 0.0f;   // N along the strut
+    f32  angularVelocity = 0.0f;   // rad/s (positive = rolling forward)
+    f32  spinAngle       = 0.0f;   // radians, wrapped
+    f32  steerAngle      = 0.0f;   // radians
+    f32  slipRatio       = 0.0f;
+    f32  slipAngle       = 0.0f;   // radians
+    f32  longForce       = 0.0f;   // N
+    f32  latForce        = 0.0f;   // N
+    f32  driveTorque     = 0.0f;   // N·m reaching this wheel
+    Vec3 contactPoint;
+    Vec3 contactNormal   { 0, 1, 0 };
+};
+
+struct VehicleInput {
+    f32  throttle  = 0.0f;   // 0..1
+    f32  brake     = 0.0f;   // 0..1
+    f32  steer     = 0.0f;   // -1 = left, +1 = right
+    bool handbrake = false;
+    i32  gearRequest = 0;    // manual gearbox: +1 shift up, -1 shift down
+    bool reverse   = false;  // select reverse (automatic) when stopped
+};
+
+class RaycastVehicle {
+public:
+    /// Wheels beyond this are dropped by SetConfig (per-step scratch is fixed-size).
+    static constexpr size_t kMaxWheels = 8;
+
+    RaycastVehicle() = default;
+    explicit RaycastVehicle(const VehicleConfig& config) { SetConfig(config); }
+
+    void SetConfig(const VehicleConfig& config);
+    const VehicleConfig& GetConfig() const { return m_Config; }
+    VehicleConfig&       GetConfig()       { return m_Config; }
+
+    /// Ground used by wheel rays.  When unset, Step() falls back to the
+    /// physics world's bodies plus the implicit Y = 0 floor.
+    void SetGroundQuery(VehicleGroundQuery query) { m_GroundQuery = std::move(query); }
+
+    /// Infinite plane through `point` — handy for flat or sloped test tracks.
+    static VehicleGroundQuery MakePlaneGround(const Vec3& point, const Vec3& normal, f32 friction = 1.0f);
+
+    /// Advance the vehicle by dt.  Applies the resulting forces to `chassis`
+    /// as velocity changes; the PhysicsWorld step then integrates the pose.
+    void Step(f32 dt, RigidBody* chassis, const VehicleInput& input,
+              const PhysicsWorld* physics = nullptr);
+
+    /// Reset wheels, gearbox and engine to rest.
+    void Reset();
+
+    // ── Telemetry ──────────────────────────────────────────────────────────
+    const std::vector<VehicleWheelState>& GetWheelStates() const { return m_Wheels; }
+    f32 GetEngineRPM()    const { return m_EngineRPM; }
+    i32 GetGear()         const { return m_Gear; }       // -1 = reverse, 1..N forward
+    f32 GetForwardSpeed() const { return m_ForwardSpeed; }
+    bool IsShifting()     const { return m_ShiftTimer > 0.0f; }
+
+    /// World-space wheel centre for visuals (after suspension travel).
+    Vec3 GetWheelCenter(size_t i, const Vec3& chassisPos, const Quaternion& chassisRot) const;
+
+private:
+    bool CastWheel(const Vec3& origin, const Vec3& dir, f32 maxDist, VehicleRayHit& hit,
+                   const RigidBody* chassis, const PhysicsWorld* physics) const;
+    void UpdateGearbox(f32 dt, const VehicleInput& input);
+    f32  GearRatio() const;
+    void DistributeDriveTorque(f32 wheelTorque);
+
+    // Per-step tyre contact frame (scratch, rebuilt every Step).
+    struct ContactFrame { Vec3 lf, lr; f32 vLong = 0, vLat = 0, mu = 0, load = 0; };
+
+    VehicleConfig                  m_Config;
+    std::vector<VehicleWheelState> m_Wheels;
+    VehicleGroundQuery             m_GroundQuery;
+    std::array<f32, kMaxWheels>          m_SurfaceGrip{};
+    std::array<ContactFrame, kMaxWheels> m_Frames{};
+    f32 m_EngineRPM    = 0.0f;
+    f32 m_ForwardSpeed = 0.0f;
+    f32 m_ShiftTimer   = 0.0f;
+    i32 m_Gear         = 1;
+};
+
+} // namespace gv
@@ -47,11 +47,15 @@ public:
     static GameObject* Spawn(Scene* scene, const VehicleBlueprint& blueprint,
                               class PhysicsWorld* physics = nullptr);
 
-    // Attach visual wheels as child objects and record them for spin updates
-    static void AttachWheels(GameObject* carRoot, const VehicleBlueprint& blueprint);
-
-    // Call each frame during play to spin wheel meshes based on car speed
-    static void UpdateWheelSpin(GameObject* carRoot, float speed, float dt);
+    // Configure the root's CarController3D wheels from the blueprint's wheel
+    // parts and bind the spawned wheel objects (same order) as visuals.
+    static void AttachWheels(Scene* scene, GameObject* carRoot, const VehicleBlueprint& blueprint,
+                             const std::vector<GameObject*>& wheelObjects);
+
+    // Re-sync wheel meshes to suspension travel, steer and spin.  The car
+    // controller already does this after each UpdateController call that
+    // is given the scene.
+    static void UpdateWheelSpin(Scene* scene, GameObject* carRoot);
 };
 
 } // namespace gv
@@ -0,0 +1,1056 @@
+// ============================================================================
+// GameVoid Engine — Behavior Tree Implementation
+// ============================================================================
+#include "ai/BehaviorTree.h"
+#include "core/SceneSerializer.h"
+#include "scripting/ScriptEngine.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+namespace gv {
+
+namespace {
+
+constexpr f64 kNever = std::numeric_limits<f64>::infinity();
+constexpr u32 kMaxDepth = 128;
+
+// Below this many agents a batch isn't worth starting threads for.
+constexpr size_t kMinBatchPerThread = 1024;
+
+// The agent a script leaf is running for; bb_get / bb_set act on it.
+// Script leaves only run on the main thread.
+BTAgent* s_ScriptAgent = nullptr;
+
+const char* TypeName(BTNodeType type) {
+    switch (type) {
+    case BTNodeType::Sequence:     return "sequence";
+    case BTNodeType::Selector:     return "selector";
+    case BTNodeType::Parallel:     return "parallel";
+    case BTNodeType::Utility:      return "utility";
+    case BTNodeType::Inverter:     return "inverter";
+    case BTNodeType::ForceSuccess: return "force_success";
+    case BTNodeType::ForceFailure: return "force_failure";
+    case BTNodeType::Repeat:       return "repeat";
+    case BTNodeType::Retry:        return "retry";
+    case BTNodeType::Cooldown:     return "cooldown";
+    case BTNodeType::TimeLimit:    return "time_limit";
+    case BTNodeType::Check:        return "check";
+    case BTNodeType::Action:       return "action";
+    case BTNodeType::Condition:    return "condition";
+    case BTNodeType::Script:       return "script";
+    case BTNodeType::Wait:         return "wait";
+    case BTNodeType::Set:          return "set";
+    }
+    return "?";
+}
+
+bool IsComposite(BTNodeType type) {
+    return type == BTNodeType::Sequence || type == BTNodeType::Selector ||
+           type == BTNodeType::Parallel || type == BTNodeType::Utility;
+}
+
+bool IsDecorator(BTNodeType type) {
+    return type >= BTNodeType::Inverter && type <= BTNodeType::TimeLimit;
+}
+
+// Words after the node's own: parallel keeps success and failure masks,
+// utility a mask of children that already failed.
+u32 MaskWords(u32 children) { return (children + 31) / 32; }
+
+template <typename Work>
+void ForEachSplit(size_t count, u32 threads, const Work& work) {
+    if (threads == 0) threads = std::min(4u, std::max(1u, std::thread::hardware_concurrency()));
+    threads = static_cast<u32>(std::min<size_t>(threads, std::max<size_t>(1, count / kMinBatchPerThread)));
+    if (threads <= 1) { work(0, count); return; }
+
+    std::vector<std::thread> pool;
+    size_t per = (count + threads - 1) / threads;
+    for (u32 i = 1; i < threads; ++i) {
+        size_t first = std::min(count, i * per), last = std::min(count, first + per);
+        pool.emplace_back([&work, first, last] { work(first, last); });
+    }
+    work(0, std::min(count, per));
+    for (auto& th : pool) th.join();
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Authoring
+// ============================================================================
+BTNodeDesc BTNodeDesc::Composite(BTNodeType type, std::vector<BTNodeDesc> children) {
+    BTNodeDesc d;
+    d.type = type;
+    d.children = std::move(children);
+    return d;
+}
+
+BTNodeDesc BTNodeDesc::Parallel(std::vector<BTNodeDesc> children, i32 successes, i32 failures) {
+    BTNodeDesc d = Composite(BTNodeType::Parallel, std::move(children));
+    d.count = successes;
+    d.failures = failures;
+    return d;
+}
+
+BTNodeDesc BTNodeDesc::Utility(std::vector<BTNodeDesc> children, f32 hysteresis) {
+    BTNodeDesc d = Composite(BTNodeType::Utility, std::move(children));
+    d.hysteresis = hysteresis;
+    return d;
+}
+
+BTNodeDesc BTNodeDesc::Decorate(BTNodeType type, BTNodeDesc child, f32 seconds, i32 count) {
+    BTNodeDesc d;
+    d.type = type;
+    d.seconds = seconds;
+    d.count = count;
+    d.children.push_back(std::move(child));
+    return d;
+}
+
+BTNodeDesc BTNodeDesc::Check(const std::string& key, BTCompare op, f32 value, BTAbort abort) {
+    BTNodeDesc d;
+    d.type = BTNodeType::Check;
+    d.key = key;
+    d.op = op;
+    d.value = value;
+    d.abort = abort;
+    return d;
+}
+
+BTNodeDesc BTNodeDesc::Guard(const std::string& key, BTCompare op, f32 value, BTAbort abort, BTNodeDesc child) {
+    BTNodeDesc d = Check(key, op, value, abort);
+    d.children.push_back(std::move(child));
+    return d;
+}
+
+BTNodeDesc BTNodeDesc::Action(const std::string& name, std::vector<BTArg> args) {
+    BTNodeDesc d;
+    d.type = BTNodeType::Action;
+    d.name = name;
+    d.args = std::move(args);
+    return d;
+}
+
+BTNodeDesc BTNodeDesc::Condition(const std::string& name) {
+    BTNodeDesc d;
+    d.type = BTNodeType::Condition;
+    d.name = name;
+    return d;
+}
+
+BTNodeDesc BTNodeDesc::Script(const std::string& function) {
+    BTNodeDesc d;
+    d.type = BTNodeType::Script;
+    d.name = function;
+    return d;
+}
+
+BTNodeDesc BTNodeDesc::Wait(f32 seconds) {
+    BTNodeDesc d;
+    d.type = BTNodeType::Wait;
+    d.seconds = seconds;
+    return d;
+}
+
+BTNodeDesc BTNodeDesc::Set(const std::string& key, f32 value) {
+    BTNodeDesc d;
+    d.type = BTNodeType::Set;
+    d.key = key;
+    d.value = value;
+    return d;
+}
+
+BehaviorTreeDesc::Key& BehaviorTreeDesc::AddKey(const std::string& keyName, BTValueType type, f32 defaultValue) {
+    Key k;
+    k.name = keyName;
+    k.type = type;
+    switch (type) {
+    case BTValueType::Bool:   k.defaultValue.b = defaultValue != 0.0f; break;
+    case BTValueType::Int:    k.defaultValue.i = static_cast<i32>(defaultValue); break;
+    case BTValueType::Float:  k.defaultValue.f = defaultValue; break;
+    case BTValueType::Object: k.defaultValue.id = static_cast<u32>(defaultValue); break;
+    case BTValueType::Vector: break;
+    }
+    blackboard.push_back(k);
+    return blackboard.back();
+}
+
+// ── JSON ───────────────────────────────────────────────────────────────────
+bool BehaviorTreeDesc::FromJson(const std::string& json, BehaviorTreeDesc& out, std::string& error) {
+    using Json = SceneSerializer::JsonValue;
+
+    Json root;
+    try {
+        size_t pos = 0;
+        root = SceneSerializer::ParseJson(json, pos);
+    } catch (const std::exception&) {
+        error = "malformed number in behavior tree JSON";
+        return false;
+    }
+    if (root.type != Json::Object) { error = "behavior tree JSON must be an object"; return false; }
+
+    out = BehaviorTreeDesc();
+    if (root["name"].type == Json::String) out.name = root["name"].AsStr();
+
+    // ── Blackboard ─────────────────────────────────────────────────────────
+    const Json& bb = root["blackboard"];
+    if (bb.type != Json::Null && bb.type != Json::Object) { error = "'blackboard' must be an object"; return false; }
+    for (const auto& [keyName, spec] : bb.objVal) {
+        const Json& typeValue = spec.type == Json::Object ? spec["type"] : spec;
+        const std::string& t = typeValue.AsStr();
+        BTValueType type;
+        if      (t == "bool")   type = BTValueType::Bool;
+        else if (t == "int")    type = BTValueType::Int;
+        else if (t == "float")  type = BTValueType::Float;
+        else if (t == "object") type = BTValueType::Object;
+        else if (t == "vector") type = BTValueType::Vector;
+        else { error = "blackboard key '" + keyName + "': unknown type '" + t + "'"; return false; }
+
+        const Json& def = spec["default"];
+        f32 number = def.type == Json::Bool ? (def.AsBool() ? 1.0f : 0.0f) : def.AsFloat();
+        Key& key = out.AddKey(keyName, type, number);
+        if (type == BTValueType::Vector && def.type == Json::Array)
+            key.defaultValue.v = SceneSerializer::ParseVec3(def);
+    }
+
+    // ── Nodes ──────────────────────────────────────────────────────────────
+    static const std::unordered_map<std::string, BTNodeType> kTypes = {
+        {"sequence", BTNodeType::Sequence}, {"selector", BTNodeType::Selector},
+        {"parallel", BTNodeType::Parallel}, {"utility", BTNodeType::Utility},
+        {"inverter", BTNodeType::Inverter}, {"force_success", BTNodeType::ForceSuccess},
+        {"force_failure", BTNodeType::ForceFailure}, {"repeat", BTNodeType::Repeat},
+        {"retry", BTNodeType::Retry}, {"cooldown", BTNodeType::Cooldown},
+        {"time_limit", BTNodeType::TimeLimit}, {"check", BTNodeType::Check},
+        {"action", BTNodeType::Action}, {"condition", BTNodeType::Condition},
+        {"script", BTNodeType::Script}, {"wait", BTNodeType::Wait}, {"set", BTNodeType::Set},
+    };
+    static const std::unordered_map<std::string, BTCompare> kOps = {
+        {"==", BTCompare::Equal}, {"!=", BTCompare::NotEqual}, {"<", BTCompare::Less},
+        {"<=", BTCompare::LessEqual}, {">", BTCompare::Greater}, {">=", BTCompare::GreaterEqual},
+        {"set", BTCompare::Set}, {"not_set", BTCompare::NotSet},
+    };
+    static const std::unordered_map<std::string, BTAbort> kAborts = {
+        {"none", BTAbort::None}, {"self", BTAbort::Self}, {"lower", BTAbort::LowerPriority}, {"both", BTAbort::Both},
+    };
+    static const std::unordered_map<std::string, BTCurve> kCurves = {
+        {"linear", BTCurve::Linear}, {"power", BTCurve::Power}, {"logistic", BTCurve::Logistic}, {"step", BTCurve::Step},
+    };
+
+    std::function<bool(const Json&, BTNodeDesc&, const std::string&, u32)> read;
+    read = [&](const Json& j, BTNodeDesc& d, const std::string& path, u32 depth) -> bool {
+        auto fail = [&](const std::string& message) { error = path + ": " + message; return false; };
+        if (depth > kMaxDepth) return fail("nested too deeply");
+        if (j.type != Json::Object) return fail("a node must be an object");
+
+        auto type = kTypes.find(j["type"].AsStr());
+        if (type == kTypes.end()) return fail("unknown node type '" + j["type"].AsStr() + "'");
+        d.type = type->second;
+        d.label = j["label"].AsStr();
+        d.name = j.Has("function") ? j["function"].AsStr() : j["name"].AsStr();
+        d.key = j["key"].AsStr();
+
+        if (j.Has("seconds")) d.seconds = j["seconds"].AsFloat();
+        if (j.Has("count"))   d.count = static_cast<i32>(j["count"].AsNum());
+        if (d.type == BTNodeType::Parallel && j.Has("success")) d.count = static_cast<i32>(j["success"].AsNum());
+        if (j.Has("failure")) d.failures = static_cast<i32>(j["failure"].AsNum());
+        if (j.Has("hysteresis")) d.hysteresis = j["hysteresis"].AsFloat();
+        if (j.Has("weight"))  d.weight = j["weight"].AsFloat();
+        d.scorer = j["scorer"].AsStr();
+
+        const Json& value = j["value"];
+        d.value = value.type == Json::Bool ? (value.AsBool() ? 1.0f : 0.0f) : value.AsFloat();
+        if (j.Has("op")) {
+            auto op = kOps.find(j["op"].AsStr());
+            if (op == kOps.end()) return fail("unknown op '" + j["op"].AsStr() + "'");
+            d.op = op->second;
+        } else if (j.Has("value")) {
+            d.op = BTCompare::Equal;
+        }
+        if (j.Has("abort")) {
+            auto abort = kAborts.find(j["abort"].AsStr());
+            if (abort == kAborts.end()) return fail("unknown abort '" + j["abort"].AsStr() + "'");
+            d.abort = abort->second;
+        }
+
+        for (const auto& [argName, arg] : j["args"].objVal) {
+            BTArg a;
+            a.name = argName;
+            if (arg.type == Json::String) a.text = arg.AsStr();
+            else a.number = arg.type == Json::Bool ? (arg.AsBool() ? 1.0f : 0.0f) : arg.AsFloat();
+            d.args.push_back(std::move(a));
+        }
+
+        const Json& utility = j["utility"];
+        for (size_t i = 0; i < utility.arrVal.size(); ++i) {
+            const Json& c = utility.arrVal[i];
+            BTConsideration con;
+            con.key = c["key"].AsStr();
+            if (c.Has("curve")) {
+                auto curve = kCurves.find(c["curve"].AsStr());
+                if (curve == kCurves.end()) return fail("unknown curve '" + c["curve"].AsStr() + "'");
+                con.curve = curve->second;
+            }
+            if (c.Has("min"))       con.min = c["min"].AsFloat();
+            if (c.Has("max"))       con.max = c["max"].AsFloat();
+            if (c.Has("exponent"))  con.exponent = c["exponent"].AsFloat();
+            if (c.Has("steepness")) con.steepness = c["steepness"].AsFloat();
+            if (c.Has("midpoint"))  con.midpoint = c["midpoint"].AsFloat();
+            con.invert = c["invert"].AsBool();
+            d.utility.push_back(std::move(con));
+        }
+
+        if (j.Has("child")) {
+            d.children.emplace_back();
+            if (!read(j["child"], d.children.back(), path + ".child", depth + 1)) return false;
+        }
+        const Json& children = j["children"];
+        for (size_t i = 0; i < children.arrVal.size(); ++i) {
+            d.children.emplace_back();
+            if (!read(children.arrVal[i], d.children.back(),
+                      path + ".children[" + std::to_string(i) + "]", depth + 1)) return false;
+        }
+        return true;
+    };
+
+    if (!root.Has("root")) { error = "missing 'root'"; return false; }
+    return read(root["root"], out.root, "root", 0);
+}
+
+// ============================================================================
+// BTContext
+// ============================================================================
+f32 BTContext::GetArg(std::string_view name, f32 fallback) const {
+    const BehaviorTree& t = *agent.m_Tree;
+    const auto& n = t.m_Nodes[node];
+    for (u32 i = 0; i < n.argCount; ++i)
+        if (t.m_Args[n.firstArg + i].name == name) return t.m_Args[n.firstArg + i].number;
+    return fallback;
+}
+
+const std::string& BTContext::GetText(std::string_view name) const {
+    static const std::string kEmpty;
+    const BehaviorTree& t = *agent.m_Tree;
+    const auto& n = t.m_Nodes[node];
+    for (u32 i = 0; i < n.argCount; ++i)
+        if (t.m_Args[n.firstArg + i].name == name) return t.m_Args[n.firstArg + i].text;
+    return kEmpty;
+}
+
+void BTContext::SleepFor(f32 seconds) {
+    m_Slept = true;
+    m_WakeAt = agent.m_Now + std::max(0.0f, seconds);
+}
+
+void BTContext::SleepUntilChanged() {
+    m_Slept = true;
+    m_WakeAt = kNever;
+}
+
+// ============================================================================
+// BTRegistry
+// ============================================================================
+BTRegistry& BTRegistry::Global() {
+    static BTRegistry registry;
+    return registry;
+}
+
+void BTRegistry::RegisterAction(const std::string& name, ActionFn fn, AbortFn onAbort, bool threadSafe) {
+    m_Actions[name] = Action{std::move(fn), std::move(onAbort), threadSafe};
+}
+
+void BTRegistry::RegisterCondition(const std::string& name, ConditionFn fn, bool threadSafe) {
+    m_Conditions[name] = Condition{std::move(fn), threadSafe};
+}
+
+void BTRegistry::RegisterScorer(const std::string& name, ScorerFn fn, bool threadSafe) {
+    m_Scorers[name] = Scorer{std::move(fn), threadSafe};
+}
+
+void BTRegistry::BindScriptEngine(ScriptEngine& engine) {
+    m_Scripts = &engine;
+
+    engine.RegisterFunction("bb_get", [](const std::vector<ScriptValue>& args) -> ScriptValue {
+        if (!s_ScriptAgent || args.empty()) return ScriptValue();
+        u32 key = s_ScriptAgent->FindKey(args[0].AsString());
+        if (key == BehaviorTree::kNone) return ScriptValue();
+        if (s_ScriptAgent->GetTree()->GetKeyType(key) == BTValueType::Bool)
+            return ScriptValue(s_ScriptAgent->GetBool(key));
+        return ScriptValue(static_cast<f64>(s_ScriptAgent->GetNumber(key)));
+    });
+    engine.RegisterFunction("bb_set", [](const std::vector<ScriptValue>& args) -> ScriptValue {
+        if (!s_ScriptAgent || args.size() < 2) return ScriptValue();
+        u32 key = s_ScriptAgent->FindKey(args[0].AsString());
+        if (key == BehaviorTree::kNone) return ScriptValue(false);
+        if (args[1].type == ScriptValue::Bool) s_ScriptAgent->SetNumber(key, args[1].boolVal ? 1.0f : 0.0f);
+        else s_ScriptAgent->SetNumber(key, static_cast<f32>(args[1].AsNumber()));
+        return ScriptValue(true);
+    });
+}
+
+// ============================================================================
+// BehaviorTree — compile
+// ============================================================================
+Shared<const BehaviorTree> BehaviorTree::Compile(const BehaviorTreeDesc& desc, std::string& error,
+                                                 const BTRegistry& registry) {
+    auto tree = MakeShared<BehaviorTree>();
+    BehaviorTree& t = *tree;
+    t.m_Name = desc.name;
+
+    // ── Blackboard ─────────────────────────────────────────────────────────
+    if (desc.blackboard.size() > kMaxKeys) {
+        error = t.m_Name + ": more than " + std::to_string(kMaxKeys) + " blackboard keys";
+        return nullptr;
+    }
+    for (const auto& key : desc.blackboard) {
+        if (key.name.empty() || !t.m_KeyIndex.emplace(key.name, static_cast<u32>(t.m_Keys.size())).second) {
+            error = t.m_Name + ": blackboard key '" + key.name + "' is empty or repeated";
+            return nullptr;
+        }
+        t.m_Keys.push_back(key);
+    }
+
+    // ── Nodes, flattened in pre-order ──────────────────────────────────────
+    std::unordered_map<std::string, u32> actions, conditions, scorers, scripts;
+
+    std::function<bool(const BTNodeDesc&, BTNodeType, u32)> add;
+    add = [&](const BTNodeDesc& d, BTNodeType parent, u32 depth) -> bool {
+        auto fail = [&](const std::string& message) {
+            error = t.m_Name + ": " + TypeName(d.type);
+            if (!d.label.empty())     error += " '" + d.label + "'";
+            else if (!d.name.empty()) error += " '" + d.name + "'";
+            error += ": " + message;
+            return false;
+        };
+        auto key = [&](const std::string& keyName, u32& out) {
+            out = t.FindKey(keyName);
+            return out != kNone || fail("unknown blackboard key '" + keyName + "'");
+        };
+        auto bind = [&](std::unordered_map<std::string, u32>& seen, auto& table, const auto& source, u32& out) {
+            auto [it, added] = seen.emplace(d.name, static_cast<u32>(table.size()));
+            if (added) {
+                table.push_back(source);
+                if (!source.threadSafe) t.m_MainThread = true;
+            }
+            out = it->second;
+        };
+        if (depth > kMaxDepth) return fail("tree is nested too deeply");
+
+        const size_t children = d.children.size();
+        if (IsComposite(d.type) && (children == 0 || children > 0xFFFF))
+            return fail("needs between 1 and 65535 children");
+        if (IsDecorator(d.type) && children != 1) return fail("needs exactly one child");
+        if (d.type == BTNodeType::Check && children > 1) return fail("takes at most one child");
+        if (!IsComposite(d.type) && !IsDecorator(d.type) && d.type != BTNodeType::Check && children != 0)
+            return fail("can't have children");
+
+        const u32 index = static_cast<u32>(t.m_Nodes.size());
+        t.m_Nodes.emplace_back();
+        t.m_Labels.push_back(!d.label.empty() ? d.label : !d.name.empty() ? d.name : TypeName(d.type));
+
+        Node n;
+        n.type = d.type;
+        n.childCount = static_cast<u16>(children);
+        n.slot = t.m_Words++;
+
+        switch (d.type) {
+        case BTNodeType::Parallel:
+            if (d.count < 0 || d.count > static_cast<i32>(children)) return fail("success count out of range");
+            if (d.failures < 1) return fail("failure count must be at least 1");
+            n.count = d.count;
+            n.failures = d.failures;
+            t.m_Words += 2 * MaskWords(static_cast<u32>(children));
+            break;
+        case BTNodeType::Utility:
+            n.value = std::max(0.0f, d.hysteresis);
+            t.m_Words += MaskWords(static_cast<u32>(children));
+            break;
+        case BTNodeType::Repeat:
+        case BTNodeType::Retry:
+            if (d.count < 0) return fail("count can't be negative");
+            n.count = d.count;
+            break;
+        case BTNodeType::Cooldown:
+        case BTNodeType::TimeLimit:
+        case BTNodeType::Wait:
+            if (!(d.seconds >= 0.0f) || !std::isfinite(d.seconds)) return fail("seconds must be finite and >= 0");
+            n.value = d.seconds;
+            n.timer = t.m_Timers++;
+            break;
+        case BTNodeType::Check:
+            if (!key(d.key, n.key)) return false;
+            n.op = d.op;
+            n.value = d.value;
+            n.abort = d.abort;
+            n.observed = 1ull << n.key;
+            if ((d.abort == BTAbort::Self || d.abort == BTAbort::Both) && children == 0)
+                return fail("abort 'self' needs a child to abort");
+            if ((d.abort == BTAbort::LowerPriority || d.abort == BTAbort::Both) && parent != BTNodeType::Selector)
+                return fail("abort 'lower' needs the check to be a direct child of a selector");
+            break;
+        case BTNodeType::Set:
+            if (!key(d.key, n.key)) return false;
+            if (t.m_Keys[n.key].type == BTValueType::Vector) return fail("can't set a vector key");
+            n.value = d.value;
+            break;
+        case BTNodeType::Action: {
+            auto it = registry.m_Actions.find(d.name);
+            if (it == registry.m_Actions.end()) return fail("no such action registered");
+            bind(actions, t.m_Actions, it->second, n.leaf);
+            break;
+        }
+        case BTNodeType::Condition: {
+            auto it = registry.m_Conditions.find(d.name);
+            if (it == registry.m_Conditions.end()) return fail("no such condition registered");
+            bind(conditions, t.m_Conditions, it->second, n.leaf);
+            break;
+        }
+        case BTNodeType::Script: {
+            if (d.name.empty()) return fail("needs a function name");
+            if (!registry.m_Scripts) return fail("script leaves need BTRegistry::BindScriptEngine");
+            t.m_Scripts = registry.m_Scripts;
+            t.m_MainThread = true;
+            auto [it, added] = scripts.emplace(d.name, static_cast<u32>(t.m_ScriptNames.size()));
+            if (added) t.m_ScriptNames.push_back(d.name);
+            n.leaf = it->second;
+            break;
+        }
+        default:
+            break;
+        }
+
+        // ── Arguments and utility scoring ─────────────────────────────────
+        n.firstArg = static_cast<u32>(t.m_Args.size());
+        n.argCount = static_cast<u16>(std::min<size_t>(d.args.size(), 0xFFFF));
+        t.m_Args.insert(t.m_Args.end(), d.args.begin(), d.args.begin() + n.argCount);
+
+        if ((!d.utility.empty() || !d.scorer.empty()) && parent != BTNodeType::Utility)
+            return fail("utility scoring only applies to children of a utility node");
+        if (!(d.weight >= 0.0f)) return fail("weight can't be negative");
+        n.weight = d.weight;
+        n.firstConsideration = static_cast<u32>(t.m_Considerations.size());
+        n.considerationCount = static_cast<u16>(std::min<size_t>(d.utility.size(), 0xFFFF));
+        for (u32 i = 0; i < n.considerationCount; ++i) {
+            const BTConsideration& c = d.utility[i];
+            Consideration con;
+            if (!key(c.key, con.key)) return false;
+            if (c.max == c.min) return fail("consideration '" + c.key + "' has min == max");
+            con.curve = c.curve;
+            con.invert = c.invert;
+            con.min = c.min;
+            con.scale = 1.0f / (c.max - c.min);
+            con.exponent = c.exponent;
+            con.steepness = c.steepness;
+            con.midpoint = c.midpoint;
+            t.m_Considerations.push_back(con);
+            n.observed |= 1ull << con.key;
+        }
+        if (!d.scorer.empty()) {
+            auto it = registry.m_Scorers.find(d.scorer);
+            if (it == registry.m_Scorers.end()) return fail("no such scorer '" + d.scorer + "'");
+            auto [at, added] = scorers.emplace(d.scorer, static_cast<u32>(t.m_Scorers.size()));
+            if (added) {
+                t.m_Scorers.push_back(it->second);
+                if (!it->second.threadSafe) t.m_MainThread = true;
+            }
+            n.scorer = at->second;
+        }
+
+        // ── Children ───────────────────────────────────────────────────────
+        std::vector<u32> kids;
+        kids.reserve(children);
+        for (const auto& child : d.children) {
+            kids.push_back(static_cast<u32>(t.m_Nodes.size()));
+            if (!add(child, d.type, depth + 1)) return false;
+        }
+        if (d.type == BTNodeType::Utility) {
+            // Re-scored when any key its children consider changes.
+            n.observed = 0;
+            for (u32 kid : kids) {
+                n.observed |= t.m_Nodes[kid].observed;
+                if (t.m_Nodes[kid].scorer != kNone) n.nativeScored = 1;
+            }
+        }
+        n.firstChild = static_cast<u32>(t.m_Children.size());
+        t.m_Children.insert(t.m_Children.end(), kids.begin(), kids.end());
+        n.end = static_cast<u32>(t.m_Nodes.size());
+        t.m_Nodes[index] = n;
+        return true;
+    };
+
+    if (!add(desc.root, BTNodeType::Sequence, 0)) return nullptr;
+    return tree;
+}
+
+Shared<const BehaviorTree> BehaviorTree::LoadJson(const std::string& json, std::string& error,
+                                                  const BTRegistry& registry) {
+    BehaviorTreeDesc desc;
+    if (!BehaviorTreeDesc::FromJson(json, desc, error)) return nullptr;
+    return Compile(desc, error, registry);
+}
+
+Shared<const BehaviorTree> BehaviorTree::LoadFile(const std::string& path, std::string& error,
+                                                  const BTRegistry& registry) {
+    std::ifstream f(path);
+    if (!f.is_open()) { error = "can't open " + path; return nullptr; }
+    std::stringstream ss;
+    ss << f.rdbuf();
+
+    BehaviorTreeDesc desc;
+    if (!BehaviorTreeDesc::FromJson(ss.str(), desc, error)) { error = path + ": " + error; return nullptr; }
+    return Compile(desc, error, registry);
+}
+
+u32 BehaviorTree::FindKey(std::string_view keyName) const {
+    auto it = m_KeyIndex.find(std::string(keyName));
+    return it != m_KeyIndex.end() ? it->second : kNone;
+}
+
+// ============================================================================
+// BTAgent — blackboard
+// ============================================================================
+BTAgent::BTAgent(Shared<const BehaviorTree> tree, GameObject* owner) : m_Owner(owner) {
+    SetTree(std::move(tree));
+}
+
+void BTAgent::SetTree(Shared<const BehaviorTree> tree) {
+    if (m_Tree) Abort(0);
+    m_Tree = std::move(tree);
+    m_Words.assign(m_Tree ? m_Tree->m_Words : 0, 0);
+    m_Timers.assign(m_Tree ? m_Tree->m_Timers : 0, 0.0);
+    m_Values.clear();
+    if (m_Tree)
+        for (const auto& key : m_Tree->m_Keys) m_Values.push_back(key.defaultValue);
+    m_Dirty = 0;
+    m_LastStatus = BTStatus::Running;
+    m_WakeAt = m_Now;
+}
+
+void BTAgent::Reset() {
+    SetTree(m_Tree);
+}
+
+void BTAgent::Mark(u32 key, bool changed) {
+    if (changed) m_Dirty |= 1ull << key;
+}
+
+void BTAgent::SetBool(u32 key, bool value) {
+    if (key >= m_Values.size()) return;
+    if (m_Tree->m_Keys[key].type != BTValueType::Bool) { SetNumber(key, value ? 1.0f : 0.0f); return; }
+    Mark(key, m_Values[key].b != value);
+    m_Values[key].b = value;
+}
+
+void BTAgent::SetInt(u32 key, i32 value) {
+    if (key >= m_Values.size()) return;
+    if (m_Tree->m_Keys[key].type != BTValueType::Int) { SetNumber(key, static_cast<f32>(value)); return; }
+    Mark(key, m_Values[key].i != value);
+    m_Values[key].i = value;
+}
+
+void BTAgent::SetFloat(u32 key, f32 value) {
+    if (key >= m_Values.size()) return;
+    if (m_Tree->m_Keys[key].type != BTValueType::Float) { SetNumber(key, value); return; }
+    Mark(key, m_Values[key].f != value);
+    m_Values[key].f = value;
+}
+
+void BTAgent::SetObject(u32 key, u32 id) {
+    if (key >= m_Values.size() || m_Tree->m_Keys[key].type != BTValueType::Object) return;
+    Mark(key, m_Values[key].id != id);
+    m_Values[key].id = id;
+}
+
+void BTAgent::SetVector(u32 key, const Vec3& value) {
+    if (key >= m_Values.size() || m_Tree->m_Keys[key].type != BTValueType::Vector) return;
+    const Vec3& v = m_Values[key].v;
+    Mark(key, v.x != value.x || v.y != value.y || v.z != value.z);
+    m_Values[key].v = value;
+}
+
+f32 BTAgent::GetNumber(u32 key) const {
+    if (key >= m_Values.size()) return 0.0f;
+    const BTValue& s = m_Values[key];
+    switch (m_Tree->m_Keys[key].type) {
+    case BTValueType::Bool:   return s.b ? 1.0f : 0.0f;
+    case BTValueType::Int:    return static_cast<f32>(s.i);
+    case BTValueType::Float:  return s.f;
+    case BTValueType::Object: return static_cast<f32>(s.id);
+    case BTValueType::Vector: return s.v.Length();
+    }
+    return 0.0f;
+}
+
+void BTAgent::SetNumber(u32 key, f32 value) {
+    if (key >= m_Values.size()) return;
+    switch (m_Tree->m_Keys[key].type) {
+    case BTValueType::Bool:   SetBool(key, value != 0.0f); break;
+    case BTValueType::Int:    SetInt(key, static_cast<i32>(value)); break;
+    case BTValueType::Float:  SetFloat(key, value); break;
+    case BTValueType::Object: SetObject(key, value > 0.0f ? static_cast<u32>(value) : 0u); break;
+    case BTValueType::Vector: break;
+    }
+}
+
+bool BTAgent::IsNodeRunning(u32 node) const {
+    return m_Tree && node < m_Tree->m_Nodes.size() && (m_Words[m_Tree->m_Nodes[node].slot] & 1u);
+}
+
+// ============================================================================
+// BTAgent — ticking
+// ============================================================================
+void BTAgent::Update(f32 dt) {
+    if (!m_Tree) return;
+    m_Now += dt;
+    if (m_Dirty == 0 && m_Now < m_WakeAt) return;
+    Tick();
+}
+
+void BTAgent::Tick() {
+    if (!m_Tree) return;
+    m_Changed = m_Dirty;
+    m_Dirty = 0;
+    m_NextWake = kNever;
+    const bool resumed = (m_Words[m_Tree->m_Nodes[0].slot] & 1u) != 0;
+
+    m_LastStatus = Exec(0);
+    // A run that finished mid-tree may reach leaves when it starts over.
+    if (resumed && m_LastStatus != BTStatus::Running) WakeAt(m_Now);
+
+    m_LastTick = m_Now;
+    m_WakeAt = m_NextWake;
+    m_Changed = 0;
+    ++m_Ticks;
+}
+
+bool BTAgent::Test(const BehaviorTree::Node& n) const {
+    const f32 x = GetNumber(n.key);
+    switch (n.op) {
+    case BTCompare::Equal:        return x == n.value;
+    case BTCompare::NotEqual:     return x != n.value;
+    case BTCompare::Less:         return x <  n.value;
+    case BTCompare::LessEqual:    return x <= n.value;
+    case BTCompare::Greater:      return x >  n.value;
+    case BTCompare::GreaterEqual: return x >= n.value;
+    case BTCompare::Set:          return x != 0.0f;
+    case BTCompare::NotSet:       return x == 0.0f;
+    }
+    return false;
+}
+
+f32 BTAgent::Score(u32 node) {
+    const BehaviorTree& t = *m_Tree;
+    const auto& n = t.m_Nodes[node];
+    f32 score = n.weight;
+    if (n.scorer != BehaviorTree::kNone) {
+        BTContext ctx(*this, node, static_cast<f32>(m_Now - m_LastTick));
+        score *= t.m_Scorers[n.scorer].fn(ctx);
+    }
+    for (u32 i = 0; i < n.considerationCount && score > 0.0f; ++i) {
+        const auto& c = t.m_Considerations[n.firstConsideration + i];
+        const f32 x = std::clamp((GetNumber(c.key) - c.min) * c.scale, 0.0f, 1.0f);
+        f32 y = x;
+        switch (c.curve) {
+        case BTCurve::Linear:   break;
+        case BTCurve::Power:    y = std::pow(x, c.exponent); break;
+        case BTCurve::Logistic: y = 1.0f / (1.0f + std::exp(-c.steepness * (x - c.midpoint))); break;
+        case BTCurve::Step:     y = x >= c.midpoint ? 1.0f : 0.0f; break;
+        }
+        score *= c.invert ? 1.0f - y : y;
+    }
+    return score > 0.0f ? score : 0.0f;   // also turns NaN into 0
+}
+
+void BTAgent::Abort(u32 node) {
+    const BehaviorTree& t = *m_Tree;
+    const auto& top = t.m_Nodes[node];
+    for (u32 i = node; i < top.end; ++i) {
+        const auto& n = t.m_Nodes[i];
+        if (n.type != BTNodeType::Action || !(m_Words[n.slot] & 1u)) continue;
+        const auto& onAbort = t.m_Actions[n.leaf].onAbort;
+        if (!onAbort) continue;
+        BTContext ctx(*this, i, static_cast<f32>(m_Now - m_LastTick));
+        onAbort(ctx);
+    }
+    // A subtree's words are contiguous.  Cooldown timers outlive aborts;
+    // the other timers are only read while their node runs.
+    const u32 last = top.end < t.m_Nodes.size() ? t.m_Nodes[top.end].slot : t.m_Words;
+    std::fill(m_Words.begin() + top.slot, m_Words.begin() + last, 0u);
+}
+
+BTStatus BTAgent::ExecChildren(u32 /*node*/, const BehaviorTree::Node& n) {
+    const bool selector = n.type == BTNodeType::Selector;
+    u32& w = m_Words[n.slot];
+    u32 cur = w >> 1;
+
+    // A higher-priority check that now holds takes over from the running child.
+    if (selector && (w & 1u) && m_Changed) {
+        for (u32 i = 0; i < cur; ++i) {
+            const auto& c = m_Tree->m_Nodes[Child(n, i)];
+            if (c.type != BTNodeType::Check || !(m_Changed & c.observed)) continue;
+            if (c.abort != BTAbort::LowerPriority && c.abort != BTAbort::Both) continue;
+            if (!Test(c)) continue;
+            Abort(Child(n, cur));
+            cur = i;
+            break;
+        }
+    }
+
+    for (; cur < n.childCount; ++cur) {
+        BTStatus s = Exec(Child(n, cur));
+        if (s == BTStatus::Running) { w = (cur << 1) | 1u; return s; }
+        if (s == (selector ? BTStatus::Success : BTStatus::Failure)) { w = 0; return s; }
+    }
+    w = 0;
+    return selector ? BTStatus::Failure : BTStatus::Success;
+}
+
+BTStatus BTAgent::ExecParallel(u32 /*node*/, const BehaviorTree::Node& n) {
+    const u32 words = MaskWords(n.childCount);
+    u32* succeeded = &m_Words[n.slot + 1];
+    u32* failed = succeeded + words;
+
+    u32 successes = 0, failures = 0;
+    for (u32 i = 0; i < n.childCount; ++i) {
+        const u32 bit = 1u << (i & 31);
+        u32& ok = succeeded[i >> 5];
+        u32& bad = failed[i >> 5];
+        if (!((ok | bad) & bit)) {
+            BTStatus s = Exec(Child(n, i));
+            if (s == BTStatus::Success) ok |= bit;
+            else if (s == BTStatus::Failure) bad |= bit;
+        }
+        if (ok & bit) ++successes;
+        if (bad & bit) ++failures;
+    }
+
+    const u32 needed = n.count > 0 ? static_cast<u32>(n.count) : n.childCount;
+    const bool won = successes >= needed;
+    if (won || failures >= static_cast<u32>(n.failures) || successes + failures == n.childCount) {
+        for (u32 i = 0; i < n.childCount; ++i) {
+            const u32 bit = 1u << (i & 31);
+            if (!((succeeded[i >> 5] | failed[i >> 5]) & bit)) Abort(Child(n, i));
+        }
+        std::fill(m_Words.begin() + n.slot, m_Words.begin() + n.slot + 1 + 2 * words, 0u);
+        return won ? BTStatus::Success : BTStatus::Failure;
+    }
+    m_Words[n.slot] = 1u;
+    return BTStatus::Running;
+}
+
+BTStatus BTAgent::ExecUtility(u32 /*node*/, const BehaviorTree::Node& n) {
+    u32& w = m_Words[n.slot];
+    u32* tried = &m_Words[n.slot + 1];
+    const u32 words = MaskWords(n.childCount);
+    auto finish = [&](BTStatus s) {
+        std::fill(m_Words.begin() + n.slot, m_Words.begin() + n.slot + 1 + words, 0u);
+        return s;
+    };
+
+    u32 cur = w >> 1;
+    bool resume = (w & 1u) != 0;
+    if (resume && (n.nativeScored || (m_Changed & n.observed))) {
+        // Switch only if another child clearly beats the running one.
+        u32 best = cur;
+        f32 bestScore = Score(Child(n, cur)) + n.value;
+        for (u32 i = 0; i < n.childCount; ++i) {
+            if (i == cur) continue;
+            const f32 s = Score(Child(n, i));
+            if (s > bestScore) { best = i; bestScore = s; }
+        }
+        if (best != cur) {
+            Abort(Child(n, cur));
+            std::fill(tried, tried + words, 0u);
+            cur = best;
+        }
+    }
+
+    for (;;) {
+        if (!resume) {
+            // The best-scoring child that hasn't failed yet.
+            u32 best = BehaviorTree::kNone;
+            f32 bestScore = 0.0f;
+            for (u32 i = 0; i < n.childCount; ++i) {
+                if (tried[i >> 5] & (1u << (i & 31))) continue;
+                const f32 s = Score(Child(n, i));
+                if (s > bestScore) { best = i; bestScore = s; }
+            }
+            if (best == BehaviorTree::kNone) return finish(BTStatus::Failure);
+            cur = best;
+        }
+        resume = false;
+
+        BTStatus s = Exec(Child(n, cur));
+        if (s == BTStatus::Running) {
+            w = (cur << 1) | 1u;
+            if (n.nativeScored) WakeAt(m_Now);
+            return s;
+        }
+        if (s == BTStatus::Success) return finish(s);
+        tried[cur >> 5] |= 1u << (cur & 31);
+    }
+}
+
+BTStatus BTAgent::RunScript(u32 /*node*/, const BehaviorTree::Node& n) {
+    const BehaviorTree& t = *m_Tree;
+    ScriptEngine& engine = *t.m_Scripts;
+    const std::string& function = t.m_ScriptNames[n.leaf];
+    WakeAt(m_Now);
+
+    BTAgent* previousAgent = s_ScriptAgent;
+    GameObject* previousSelf = engine.GetSelfObject();
+    s_ScriptAgent = this;
+    engine.SetSelfObject(m_Owner);
+    VMValue result;
+    const bool ok = engine.GetVM().CallFunction(function, {}, &result);
+    engine.SetSelfObject(previousSelf);
+    s_ScriptAgent = previousAgent;
+
+    if (!ok) {
+        GV_LOG_WARN("Behavior tree '" + t.m_Name + "': script leaf '" + function + "' failed: " +
+                    engine.GetVM().GetLastError());
+        return BTStatus::Failure;
+    }
+    ScriptValue v = engine.ToScriptValue(result);
+    switch (v.type) {
+    case ScriptValue::Bool:   return v.boolVal ? BTStatus::Success : BTStatus::Failure;
+    case ScriptValue::Number: return v.numberVal != 0.0 ? BTStatus::Success : BTStatus::Failure;
+    case ScriptValue::String:
+        if (v.stringVal == "running") return BTStatus::Running;
+        if (v.stringVal == "failure") return BTStatus::Failure;
+        return BTStatus::Success;
+    case ScriptValue::Nil:    return BTStatus::Success;
+    }
+    return BTStatus::Success;
+}
+
+BTStatus BTAgent::Exec(u32 node) {
+    const BehaviorTree& t = *m_Tree;
+    const auto& n = t.m_Nodes[node];
+    u32& w = m_Words[n.slot];
+    const bool running = (w & 1u) != 0;
+
+    switch (n.type) {
+    case BTNodeType::Sequence:
+    case BTNodeType::Selector: return ExecChildren(node, n);
+    case BTNodeType::Parallel: return ExecParallel(node, n);
+    case BTNodeType::Utility:  return ExecUtility(node, n);
+
+    case BTNodeType::Inverter: {
+        BTStatus s = Exec(Child(n, 0));
+        w = s == BTStatus::Running;
+        return s == BTStatus::Running ? s : s == BTStatus::Success ? BTStatus::Failure : BTStatus::Success;
+    }
+    case BTNodeType::ForceSuccess:
+    case BTNodeType::ForceFailure: {
+        BTStatus s = Exec(Child(n, 0));
+        w = s == BTStatus::Running;
+        if (s == BTStatus::Running) return s;
+        return n.type == BTNodeType::ForceSuccess ? BTStatus::Success : BTStatus::Failure;
+    }
+    case BTNodeType::Repeat:
+    case BTNodeType::Retry: {
+        // One iteration per tick; the next one starts on the following tick.
+        const BTStatus again = n.type == BTNodeType::Repeat ? BTStatus::Success : BTStatus::Failure;
+        BTStatus s = Exec(Child(n, 0));
+        if (s == BTStatus::Running) { w |= 1u; return s; }
+        if (s != again) { w = 0; return s; }
+        const u32 done = (w >> 1) + 1;
+        if (n.count > 0 && done >= static_cast<u32>(n.count)) { w = 0; return s; }
+        w = (done << 1) | 1u;
+        WakeAt(m_Now);
+        return BTStatus::Running;
+    }
+    case BTNodeType::Cooldown: {
+        f64& ready = m_Timers[n.timer];
+        if (!running && m_Now < ready) { WakeAt(ready); return BTStatus::Failure; }
+        BTStatus s = Exec(Child(n, 0));
+        w = s == BTStatus::Running;
+        if (s != BTStatus::Running) ready = m_Now + n.value;
+        return s;
+    }
+    case BTNodeType::TimeLimit: {
+        f64& deadline = m_Timers[n.timer];
+        if (!running) deadline = m_Now + n.value;
+        else if (m_Now >= deadline) { Abort(Child(n, 0)); w = 0; return BTStatus::Failure; }
+        BTStatus s = Exec(Child(n, 0));
+        w = s == BTStatus::Running;
+        if (s == BTStatus::Running) WakeAt(deadline);
+        return s;
+    }
+
+    case BTNodeType::Check: {
+        if (n.childCount == 0) return Test(n) ? BTStatus::Success : BTStatus::Failure;
+        if (!running) {
+            if (!Test(n)) return BTStatus::Failure;
+        } else if ((n.abort == BTAbort::Self || n.abort == BTAbort::Both) && (m_Changed & n.observed) && !Test(n)) {
+            Abort(Child(n, 0));
+            w = 0;
+            return BTStatus::Failure;
+        }
+        BTStatus s = Exec(Child(n, 0));
+        w = s == BTStatus::Running;
+        return s;
+    }
+    case BTNodeType::Action: {
+        BTContext ctx(*this, node, static_cast<f32>(m_Now - m_LastTick));
+        BTStatus s = t.m_Actions[n.leaf].fn(ctx);
+        WakeAt(ctx.m_Slept ? ctx.m_WakeAt : m_Now);
+        w = s == BTStatus::Running;
+        return s;
+    }
+    case BTNodeType::Condition: {
+        BTContext ctx(*this, node, static_cast<f32>(m_Now - m_LastTick));
+        const bool ok = t.m_Conditions[n.leaf].fn(ctx);
+        WakeAt(ctx.m_Slept ? ctx.m_WakeAt : m_Now);
+        return ok ? BTStatus::Success : BTStatus::Failure;
+    }
+    case BTNodeType::Script: {
+        BTStatus s = RunScript(node, n);
+        w = s == BTStatus::Running;
+        return s;
+    }
+    case BTNodeType::Wait: {
+        f64& until = m_Timers[n.timer];
+        if (!running) {
+            if (n.value <= 0.0f) return BTStatus::Success;
+            until = m_Now + n.value;
+        } else if (m_Now >= until) {
+            w = 0;
+            return BTStatus::Success;
+        }
+        w = 1u;
+        WakeAt(until);
+        return BTStatus::Running;
+    }
+    case BTNodeType::Set:
+        SetNumber(n.key, n.value);
+        return BTStatus::Success;
+    }
+    return BTStatus::Failure;
+}
+
+// ── Batches ────────────────────────────────────────────────────────────────
+void BTAgent::UpdateBatch(BTAgent* agents, size_t count, f32 dt, u32 threads) {
+    ForEachSplit(count, threads, [agents, dt](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i)
+            if (!agents[i].m_Tree || !agents[i].m_Tree->NeedsMainThread()) agents[i].Update(dt);
+    });
+    for (size_t i = 0; i < count; ++i)
+        if (agents[i].m_Tree && agents[i].m_Tree->NeedsMainThread()) agents[i].Update(dt);
+}
+
+void BTAgent::UpdateBatch(BTAgent* const* agents, size_t count, f32 dt, u32 threads) {
+    ForEachSplit(count, threads, [agents, dt](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i)
+            if (!agents[i]->m_Tree || !agents[i]->m_Tree->NeedsMainThread()) agents[i]->Update(dt);
+    });
+    for (size_t i = 0; i < count; ++i)
+        if (agents[i]->m_Tree && agents[i]->m_Tree->NeedsMainThread()) agents[i]->Update(dt);
+}
+
+} // namespace gv
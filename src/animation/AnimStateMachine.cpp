@@ -0,0 +1,437 @@
+// ============================================================================
+// GameVoid Engine — Animation State Machine Implementation
+// ============================================================================
+#include "animation/AnimStateMachine.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace gv {
+
+namespace {
+
+// Below this many machines a batch isn't worth starting threads for.
+constexpr size_t kMinBatchPerThread = 1024;
+
+u32 Lookup(const std::unordered_map<std::string, u32>& index, std::string_view name) {
+    auto it = index.find(std::string(name));
+    return it != index.end() ? it->second : AnimGraph::kNone;
+}
+
+const char* TypeName(AnimParamType type) {
+    switch (type) {
+    case AnimParamType::Float:   return "float";
+    case AnimParamType::Int:     return "int";
+    case AnimParamType::Bool:    return "bool";
+    case AnimParamType::Trigger: return "trigger";
+    }
+    return "?";
+}
+
+bool Suits(AnimParamType type, AnimCondition op) {
+    switch (type) {
+    case AnimParamType::Float:   return op == AnimCondition::Greater || op == AnimCondition::Less;
+    case AnimParamType::Int:     return op != AnimCondition::If && op != AnimCondition::IfNot;
+    case AnimParamType::Bool:    return op == AnimCondition::If || op == AnimCondition::IfNot;
+    case AnimParamType::Trigger: return op == AnimCondition::If;
+    }
+    return false;
+}
+
+/// Run `work(first, last)` over [0, count), split across up to `threads`
+/// threads (0 = pick) with at least kMinBatchPerThread items each.
+template <typename Work>
+void ForEachSplit(size_t count, u32 threads, const Work& work) {
+    if (threads == 0) threads = std::min(4u, std::max(1u, std::thread::hardware_concurrency()));
+    threads = static_cast<u32>(std::min<size_t>(threads, std::max<size_t>(1, count / kMinBatchPerThread)));
+    if (threads <= 1) { work(0, count); return; }
+
+    std::vector<std::thread> pool;
+    size_t per = (count + threads - 1) / threads;
+    for (u32 i = 1; i < threads; ++i) {
+        size_t first = std::min(count, i * per), last = std::min(count, first + per);
+        pool.emplace_back([&work, first, last] { work(first, last); });
+    }
+    work(0, std::min(count, per));
+    for (auto& th : pool) th.join();
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// AnimGraph
+// ============================================================================
+Shared<const AnimGraph> AnimGraph::Compile(const AnimGraphDesc& desc, std::string& error) {
+    auto graph = MakeShared<AnimGraph>();
+    AnimGraph& g = *graph;
+
+    // ── Parameters ─────────────────────────────────────────────────────────
+    for (const auto& p : desc.parameters) {
+        if (p.name.empty()) { error = "parameter with no name"; return nullptr; }
+        if (!g.m_ParamIndex.emplace(p.name, g.GetParameterCount()).second) {
+            error = "parameter '" + p.name + "' defined twice";
+            return nullptr;
+        }
+        g.m_ParamNames.push_back(p.name);
+        g.m_ParamTypes.push_back(p.type);
+        f32 value = p.defaultValue;
+        if (p.type == AnimParamType::Int) value = std::trunc(value);
+        if (p.type == AnimParamType::Bool || p.type == AnimParamType::Trigger) value = value != 0.0f ? 1.0f : 0.0f;
+        g.m_Defaults.push_back(value);
+    }
+
+    // ── States ─────────────────────────────────────────────────────────────
+    if (desc.states.empty()) { error = "no states"; return nullptr; }
+    for (const auto& s : desc.states) {
+        if (s.name.empty()) { error = "state with no name"; return nullptr; }
+        if (!g.m_StateIndex.emplace(s.name, g.GetStateCount()).second) {
+            error = "state '" + s.name + "' defined twice";
+            return nullptr;
+        }
+        if (!(s.length > 0.0f) || !std::isfinite(s.length)) {
+            error = "state '" + s.name + "' needs a positive length";
+            return nullptr;
+        }
+        if (!(s.speed >= 0.0f) || !std::isfinite(s.speed)) {
+            error = "state '" + s.name + "' has a negative speed";
+            return nullptr;
+        }
+        if (s.events.size() > 0xFFFF) { error = "state '" + s.name + "' has too many events"; return nullptr; }
+
+        State st;
+        st.length = s.length;
+        st.rate = s.speed / s.length;
+        st.loop = s.loop ? 1 : 0;
+        st.firstEvent = static_cast<u32>(g.m_Events.size());
+        st.eventCount = static_cast<u16>(s.events.size());
+        for (const auto& e : s.events) {
+            auto id = g.m_EventIndex.emplace(e.name, g.GetEventCount());
+            if (id.second) g.m_EventNames.push_back(e.name);
+            f32 time = std::isfinite(e.time) ? std::clamp(e.time, 0.0f, 1.0f) : 0.0f;
+            g.m_Events.push_back({ time, id.first->second });
+        }
+        std::stable_sort(g.m_Events.begin() + st.firstEvent, g.m_Events.end(),
+                         [](const Event& a, const Event& b) { return a.time < b.time; });
+        g.m_States.push_back(st);
+        g.m_StateNames.push_back(s.name);
+        g.m_StateClips.push_back(s.clip.empty() ? s.name : s.clip);
+    }
+
+    g.m_DefaultState = desc.defaultState.empty() ? 0 : g.FindState(desc.defaultState);
+    if (g.m_DefaultState == kNone) {
+        error = "default state '" + desc.defaultState + "' does not exist";
+        return nullptr;
+    }
+
+    // ── Transitions: any-state first, then grouped by source state ─────────
+    std::vector<std::vector<const AnimGraphDesc::Transition*>> bySource(desc.states.size() + 1);
+    for (const auto& t : desc.transitions) {
+        const std::string label = (t.from.empty() ? std::string("Any") : t.from) + " -> " + t.to;
+        u32 from = t.from.empty() ? g.GetStateCount() : g.FindState(t.from);
+        if (from == kNone) { error = "transition " + label + ": unknown state '" + t.from + "'"; return nullptr; }
+        if (g.FindState(t.to) == kNone) { error = "transition " + label + ": unknown state '" + t.to + "'"; return nullptr; }
+        if (t.conditions.empty() && !t.hasExitTime) {
+            error = "transition " + label + " needs a condition or an exit time";
+            return nullptr;
+        }
+        if (!(t.duration >= 0.0f) || !std::isfinite(t.duration)) {
+            error = "transition " + label + " has a negative duration";
+            return nullptr;
+        }
+        if (t.hasExitTime && (!(t.exitTime >= 0.0f) || !std::isfinite(t.exitTime))) {
+            error = "transition " + label + " has a negative exit time";
+            return nullptr;
+        }
+        if (t.conditions.size() > 0xFFFF) { error = "transition " + label + " has too many conditions"; return nullptr; }
+        for (const auto& c : t.conditions) {
+            u32 param = g.FindParameter(c.parameter);
+            if (param == kNone) {
+                error = "transition " + label + ": unknown parameter '" + c.parameter + "'";
+                return nullptr;
+            }
+            if (!Suits(g.m_ParamTypes[param], c.op)) {
+                error = "transition " + label + ": that condition can't test " +
+                        TypeName(g.m_ParamTypes[param]) + " parameter '" + c.parameter + "'";
+                return nullptr;
+            }
+        }
+        bySource[from].push_back(&t);
+    }
+
+    auto emit = [&](const AnimGraphDesc::Transition& t) {
+        Transition tr;
+        tr.target = g.FindState(t.to);
+        tr.firstCondition = static_cast<u32>(g.m_Conditions.size());
+        tr.conditionCount = static_cast<u16>(t.conditions.size());
+        tr.interrupt = t.interrupt;
+        tr.hasExitTime = t.hasExitTime ? 1 : 0;
+        tr.toSelf = t.canTransitionToSelf ? 1 : 0;
+        tr.exitTime = t.exitTime;
+        tr.duration = t.duration;
+        tr.offset = std::isfinite(t.offset) ? std::clamp(t.offset, 0.0f, 1.0f) : 0.0f;
+        for (const auto& c : t.conditions) {
+            Condition cond;
+            cond.param = g.FindParameter(c.parameter);
+            cond.op = c.op;
+            cond.consume = g.m_ParamTypes[cond.param] == AnimParamType::Trigger ? 1 : 0;
+            cond.threshold = c.threshold;
+            g.m_Conditions.push_back(cond);
+        }
+        g.m_Transitions.push_back(tr);
+    };
+
+    for (const auto* t : bySource.back()) emit(*t);
+    g.m_AnyCount = static_cast<u32>(g.m_Transitions.size());
+    for (u32 s = 0; s < g.GetStateCount(); ++s) {
+        if (bySource[s].size() > 0xFFFF) {
+            error = "state '" + g.m_StateNames[s] + "' has too many transitions";
+            return nullptr;
+        }
+        g.m_States[s].firstTransition = static_cast<u32>(g.m_Transitions.size());
+        g.m_States[s].transitionCount = static_cast<u16>(bySource[s].size());
+        for (const auto* t : bySource[s]) emit(*t);
+    }
+    return graph;
+}
+
+u32 AnimGraph::FindState(std::string_view name) const     { return Lookup(m_StateIndex, name); }
+u32 AnimGraph::FindParameter(std::string_view name) const { return Lookup(m_ParamIndex, name); }
+u32 AnimGraph::FindEvent(std::string_view name) const     { return Lookup(m_EventIndex, name); }
+
+// ============================================================================
+// AnimStateMachine — setup
+// ============================================================================
+void AnimStateMachine::SetGraph(Shared<const AnimGraph> graph) {
+    m_Graph = std::move(graph);
+    Reset();
+}
+
+void AnimStateMachine::Reset() {
+    m_Events.clear();
+    m_Next = kNone;
+    m_Fade = m_FadeDuration = 0.0f;
+    if (!m_Graph) {
+        m_Params.clear();
+        m_State = kNone;
+        return;
+    }
+    m_Params = m_Graph->m_Defaults;
+    m_State = m_Graph->m_DefaultState;
+    Enter(m_State, 0.0f, m_Clock);
+    m_ClockBefore = m_Clock;
+}
+
+void AnimStateMachine::Enter(u32 state, f32 normalizedTime, Clock& clock) {
+    clock = {};
+    clock.time = std::max(0.0f, normalizedTime);
+    if (m_Graph->m_States[state].loop && clock.time >= 1.0f) clock.time -= std::floor(clock.time);
+}
+
+void AnimStateMachine::Play(u32 state, f32 normalizedTime) {
+    if (!m_Graph || state >= m_Graph->GetStateCount()) return;
+    m_Next = kNone;
+    m_State = state;
+    Enter(state, normalizedTime, m_Clock);
+    m_ClockBefore = m_Clock;
+}
+
+void AnimStateMachine::CrossFade(u32 state, f32 duration, f32 normalizedTime) {
+    if (!m_Graph || state >= m_Graph->GetStateCount()) return;
+    if (!(duration > 0.0f)) { Play(state, normalizedTime); return; }
+    m_Next = state;
+    Enter(state, normalizedTime, m_NextClock);
+    m_NextClockBefore = m_NextClock;
+    m_Fade = 0.0f;
+    m_FadeDuration = duration;
+    m_Interrupt = static_cast<u8>(AnimInterrupt::None);
+}
+
+f32 AnimStateMachine::GetBlendWeight() const {
+    if (m_Next == kNone || !(m_FadeDuration > 0.0f)) return 0.0f;
+    return std::min(1.0f, m_Fade / m_FadeDuration);
+}
+
+f32 AnimStateMachine::ClipTime(u32 state, const Clock& clock) const {
+    if (!m_Graph || state == kNone) return 0.0f;
+    return m_Graph->m_States[state].loop ? clock.time : std::min(clock.time, 1.0f);
+}
+
+// ============================================================================
+// AnimStateMachine — stepping
+// ============================================================================
+void AnimStateMachine::Advance(u32 state, Clock& clock, f32 dt) {
+    const AnimGraph::State& s = m_Graph->m_States[state];
+    const f32  from = clock.time;
+    const bool inclusive = clock.fresh;
+    clock.fresh = false;
+
+    f32 to = from + dt * s.rate;
+    u32 wraps = 0;
+    if (s.loop && to >= 1.0f) {
+        f32 whole = std::floor(to);
+        wraps = whole < 4294967295.0f ? static_cast<u32>(whole) : ~0u;
+        to -= whole;
+        clock.loops += wraps;
+    }
+    clock.time = to;
+    if (s.eventCount == 0) return;
+
+    // Events in time order: the rest of this loop, then the part of the
+    // next one we ended in.  Each fires at most once.
+    const AnimGraph::Event* events = m_Graph->m_Events.data() + s.firstEvent;
+    auto after = [&](f32 t) { return inclusive ? t >= from : t > from; };
+    for (u16 i = 0; i < s.eventCount; ++i) {
+        f32 t = events[i].time;
+        bool hit = wraps == 0 ? after(t) && t <= to : wraps >= 2 || after(t);
+        if (hit) m_Events.push_back({ events[i].id, state });
+    }
+    if (wraps == 1)
+        for (u16 i = 0; i < s.eventCount && events[i].time <= to; ++i)
+            if (!after(events[i].time)) m_Events.push_back({ events[i].id, state });
+}
+
+bool AnimStateMachine::ExitReached(u32 state, const Clock& before, const Clock& after, f32 exitTime) const {
+    if (!m_Graph->m_States[state].loop || exitTime >= 1.0f)
+        return static_cast<f32>(after.loops) + after.time >= exitTime;
+    if (after.time >= exitTime) return true;
+    u32 wraps = after.loops - before.loops;
+    return wraps >= 2 || (wraps == 1 && before.time < exitTime);
+}
+
+bool AnimStateMachine::Ready(u32 transition, u32 state, const Clock& before, const Clock& after) const {
+    const AnimGraph::Transition& t = m_Graph->m_Transitions[transition];
+    const AnimGraph::Condition* c = m_Graph->m_Conditions.data() + t.firstCondition;
+    for (u16 i = 0; i < t.conditionCount; ++i) {
+        const f32 v = m_Params[c[i].param];
+        bool pass = false;
+        switch (c[i].op) {
+        case AnimCondition::Greater:   pass = v > c[i].threshold; break;
+        case AnimCondition::Less:      pass = v < c[i].threshold; break;
+        case AnimCondition::Equals:    pass = v == c[i].threshold; break;
+        case AnimCondition::NotEquals: pass = v != c[i].threshold; break;
+        case AnimCondition::If:        pass = v != 0.0f; break;
+        case AnimCondition::IfNot:     pass = v == 0.0f; break;
+        }
+        if (!pass) return false;
+    }
+    return !t.hasExitTime || ExitReached(state, before, after, t.exitTime);
+}
+
+u32 AnimStateMachine::FindTransition(u32 first, u32 count, u32 state, const Clock& before, const Clock& after) const {
+    for (u32 i = first; i < first + count; ++i)
+        if (Ready(i, state, before, after)) return i;
+    return kNone;
+}
+
+u32 AnimStateMachine::FindAny() const {
+    for (u32 i = 0; i < m_Graph->m_AnyCount; ++i) {
+        const AnimGraph::Transition& t = m_Graph->m_Transitions[i];
+        if (!t.toSelf && (t.target == m_State || t.target == m_Next)) continue;
+        if (Ready(i, m_State, m_ClockBefore, m_Clock)) return i;
+    }
+    return kNone;
+}
+
+void AnimStateMachine::Begin(u32 transition, u32 from, const Clock& fromClock) {
+    const AnimGraph::Transition& t = m_Graph->m_Transitions[transition];
+    const AnimGraph::Condition* c = m_Graph->m_Conditions.data() + t.firstCondition;
+    for (u16 i = 0; i < t.conditionCount; ++i)
+        if (c[i].consume) m_Params[c[i].param] = 0.0f;
+
+    m_State = from;
+    m_Clock = fromClock;
+    if (!(t.duration > 0.0f)) {
+        m_Next = kNone;
+        m_State = t.target;
+        Enter(t.target, t.offset, m_Clock);
+        return;
+    }
+    m_Next = t.target;
+    Enter(t.target, t.offset, m_NextClock);
+    m_NextClockBefore = m_NextClock;
+    m_Fade = 0.0f;
+    m_FadeDuration = t.duration;
+    m_Interrupt = static_cast<u8>(t.interrupt);
+}
+
+void AnimStateMachine::Update(f32 dt) {
+    m_Events.clear();
+    if (!m_Graph) return;
+    if (!(dt > 0.0f)) dt = 0.0f;
+
+    // 1–2. Advance, then finish a fade that has run its course.
+    m_ClockBefore = m_Clock;
+    Advance(m_State, m_Clock, dt);
+    if (m_Next != kNone) {
+        m_NextClockBefore = m_NextClock;
+        Advance(m_Next, m_NextClock, dt);
+        m_Fade += dt;
+        if (m_Fade >= m_FadeDuration) {
+            m_State = m_Next;
+            m_Clock = m_NextClock;
+            m_ClockBefore = m_NextClockBefore;
+            m_Next = kNone;
+        }
+    }
+
+    // 3. At most one transition.
+    u32 t = FindAny();
+    if (t != kNone) {
+        if (m_Next != kNone && GetBlendWeight() > 0.5f) Begin(t, m_Next, m_NextClock);
+        else Begin(t, m_State, m_Clock);
+        return;
+    }
+
+    const AnimGraph::State& cur = m_Graph->m_States[m_State];
+    if (m_Next == kNone) {
+        t = FindTransition(cur.firstTransition, cur.transitionCount, m_State, m_ClockBefore, m_Clock);
+        if (t != kNone) Begin(t, m_State, m_Clock);
+        return;
+    }
+
+    const AnimGraph::State& next = m_Graph->m_States[m_Next];
+    auto source = [&] {
+        return FindTransition(cur.firstTransition, cur.transitionCount, m_State, m_ClockBefore, m_Clock);
+    };
+    auto destination = [&] {
+        return FindTransition(next.firstTransition, next.transitionCount, m_Next, m_NextClockBefore, m_NextClock);
+    };
+    bool fromDestination = false;
+    switch (static_cast<AnimInterrupt>(m_Interrupt)) {
+    case AnimInterrupt::None:
+        break;
+    case AnimInterrupt::Source:
+        t = source();
+        break;
+    case AnimInterrupt::Destination:
+        t = destination();
+        fromDestination = true;
+        break;
+    case AnimInterrupt::SourceThenDestination:
+        t = source();
+        if (t == kNone) { t = destination(); fromDestination = true; }
+        break;
+    case AnimInterrupt::DestinationThenSource:
+        t = destination();
+        fromDestination = t != kNone;
+        if (t == kNone) t = source();
+        break;
+    }
+    if (t == kNone) return;
+    if (fromDestination) Begin(t, m_Next, m_NextClock);
+    else Begin(t, m_State, m_Clock);
+}
+
+void AnimStateMachine::UpdateBatch(AnimStateMachine* machines, size_t count, f32 dt, u32 threads) {
+    ForEachSplit(count, threads, [machines, dt](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) machines[i].Update(dt);
+    });
+}
+
+void AnimStateMachine::UpdateBatch(AnimStateMachine* const* machines, size_t count, f32 dt, u32 threads) {
+    ForEachSplit(count, threads, [machines, dt](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) machines[i]->Update(dt);
+    });
+}
+
+} // namespace gv
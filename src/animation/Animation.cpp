@@ -101,11 +101,13 @@ Keyframe AnimationClip::Sample(f32 t) const {
 // ============================================================================
 void Animator::AddClip(const AnimationClip& clip) {
     m_Clips[clip.GetName()] = clip;
+    ResolveStateClips();
 }
 
 void Animator::RemoveClip(const std::string& name) {
     m_Clips.erase(name);
-    if (m_CurrentClip == name) Stop();
+    ResolveStateClips();
+    if (m_CurrentClip == name && !m_Machine.IsValid()) Stop();
 }
 
 AnimationClip* Animator::GetClip(const std::string& name) {
@@ -143,9 +145,80 @@ void Animator::CrossFade(const std::string& toClip, f32 transitionTime) {
     m_Blending = true;
 }
 
+bool Animator::SetStateMachine(AnimGraphDesc desc, std::string* error) {
+    for (auto& state : desc.states) {
+        if (state.length > 0.0f) continue;
+        const AnimationClip* clip = GetClip(state.clip.empty() ? state.name : state.clip);
+        state.length = clip && clip->GetDuration() > 0.0f ? clip->GetDuration() : 1.0f;
+    }
+    std::string message;
+    Shared<const AnimGraph> graph = AnimGraph::Compile(desc, message);
+    if (!graph) {
+        if (error) *error = message;
+        GV_LOG_WARN("Animator — state machine: " + message);
+        return false;
+    }
+    SetStateMachine(std::move(graph));
+    return true;
+}
+
+void Animator::SetStateMachine(Shared<const AnimGraph> graph) {
+    m_Machine.SetGraph(std::move(graph));
+    ResolveStateClips();
+    m_Blending = false;
+    m_Playing = m_Machine.IsValid();
+    m_Paused = false;
+    if (m_Playing) m_CurrentClip = m_Machine.GetGraph()->GetStateClip(m_Machine.GetState());
+}
+
+void Animator::ClearStateMachine() {
+    m_Machine.SetGraph(nullptr);
+    m_StateClips.clear();
+    Stop();
+}
+
+void Animator::ResolveStateClips() {
+    m_StateClips.clear();
+    if (!m_Machine.IsValid()) return;
+    const AnimGraph& graph = *m_Machine.GetGraph();
+    m_StateClips.resize(graph.GetStateCount(), nullptr);
+    for (u32 s = 0; s < graph.GetStateCount(); ++s) {
+        auto it = m_Clips.find(graph.GetStateClip(s));
+        if (it != m_Clips.end()) m_StateClips[s] = &it->second;
+    }
+}
+
 void Animator::OnUpdate(f32 dt) {
     if (!m_Playing || m_Paused || !GetOwner()) return;
 
+    if (m_Machine.IsValid()) {
+        m_Machine.Update(dt * m_Speed);
+        const AnimGraph& graph = *m_Machine.GetGraph();
+        const u32 state = m_Machine.GetState();
+        if (graph.GetStateClip(state) != m_CurrentClip) m_CurrentClip = graph.GetStateClip(state);
+        m_Time = m_Machine.GetClipTime() * graph.GetStateLength(state);
+
+        Transform& tr = GetOwner()->GetTransform();
+        const AnimationClip* clipA = m_StateClips[state];
+        const AnimationClip* clipB = m_Machine.IsInTransition() ? m_StateClips[m_Machine.GetNextState()] : nullptr;
+        if (clipA) {
+            Keyframe k = clipA->Sample(m_Machine.GetClipTime() * clipA->GetDuration());
+            if (clipB) {
+                Keyframe kB = clipB->Sample(m_Machine.GetNextClipTime() * clipB->GetDuration());
+                f32 t = m_Machine.GetBlendWeight();
+                k.position = LerpVec3(k.position, kB.position, t);
+                k.rotation = SlerpQuat(k.rotation, kB.rotation, t);
+                k.scale    = LerpVec3(k.scale, kB.scale, t);
+            }
+            tr.position = k.position;
+            tr.rotation = k.rotation;
+            tr.scale    = k.scale;
+        }
+        if (m_OnEvent)
+            for (const auto& hit : m_Machine.GetEvents()) m_OnEvent(graph.GetEventName(hit.event));
+        return;
+    }
+
     m_Time += dt * m_Speed;
 
     Transform& tr = GetOwner()->GetTransform();
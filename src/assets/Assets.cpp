@@ -2,6 +2,11 @@
 // GameVoid Engine — Asset Manager Implementation
 // ============================================================================
 #include "assets/Assets.h"
+#include "assets/FBXLoader.h"
+#include "assets/MappedFile.h"
+#include "assets/MeshRegistry.h"
+#include "assets/TextureCooker.h"
+#include "assets/TextureStreaming.h"
 
 #ifdef GV_HAS_GLFW
 #include "core/GLDefs.h"
@@ -9,7 +14,11 @@
 #include "stb/stb_image.h"
 #endif
 
+#include <cctype>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
@@ -21,6 +30,129 @@ static void ComputeTangents(Vertex& v0, Vertex& v1, Vertex& v2);
 
 // ── Texture ────────────────────────────────────────────────────────────────
 
+static bool        s_CookOnLoad   = true;
+static std::string s_CookCacheDir = "texture_cache";
+
+void Texture::SetCookOnLoad(bool enabled)             { s_CookOnLoad = enabled; }
+bool Texture::GetCookOnLoad()                         { return s_CookOnLoad; }
+void Texture::SetCookCacheDir(const std::string& dir) { s_CookCacheDir = dir; }
+const std::string& Texture::GetCookCacheDir()         { return s_CookCacheDir; }
+
+#ifdef GV_HAS_GLFW
+static bool HasExtension(const std::string& path, const char* ext) {
+    size_t n = std::strlen(ext);
+    if (path.size() < n) return false;
+    for (size_t i = 0; i < n; ++i)
+        if (std::tolower(static_cast<unsigned char>(path[path.size() - n + i])) != ext[i]) return false;
+    return true;
+}
+
+/// Cached .gvtx for `path`, cooking it first if missing or older than the
+/// source.  Returns an empty string when cooking isn't possible.
+static std::string CookedCachePath(const std::string& path, int channels) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    auto srcTime = fs::last_write_time(path, ec);
+    if (ec) return {};
+
+    bool normalMap = TextureCooker::LooksLikeNormalMap(path);
+    u64 h = 0xcbf29ce484222325ull;   // FNV-1a of path + cook inputs
+    for (char c : path + (normalMap ? "|n" : "|c")) { h ^= static_cast<u8>(c); h *= 0x100000001b3ull; }
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.gvtx", static_cast<unsigned long long>(h));
+    std::string cached = (fs::path(s_CookCacheDir) / name).string();
+
+    auto cachedTime = fs::last_write_time(cached, ec);
+    if (!ec && cachedTime >= srcTime) return cached;
+
+    fs::create_directories(s_CookCacheDir, ec);
+    TextureCookSettings settings;
+    settings.normalMap = normalMap;
+    settings.srgb      = !normalMap;
+    // Opaque RGB sources are known up front; RGBA sources get BC3 only if
+    // some texel is actually translucent, so check after decoding.
+    if (normalMap || channels == 4) {
+        stbi_set_flip_vertically_on_load(1);
+        int w, h2, c;
+        unsigned char* data = stbi_load(path.c_str(), &w, &h2, &c, 4);
+        if (!data) return {};
+        ImageRGBA8 img(static_cast<u32>(w), static_cast<u32>(h2));
+        std::memcpy(img.pixels.data(), data, img.pixels.size());
+        stbi_image_free(data);
+        settings.format = TextureCooker::PickFormat(img, normalMap);
+        CookedTexture cooked;
+        if (!TextureCooker::Cook(img, settings, cooked) || !cooked.Save(cached)) return {};
+        GV_LOG_INFO("Texture cooked: " + path + " -> " + cached + " (" +
+                    TextureFormatName(cooked.format) + ")");
+        return cached;
+    }
+    settings.format = TextureFormat::BC1;
+    return TextureCooker::CookFile(path, cached, settings) ? cached : std::string();
+}
+
+/// The .gvtx to upload for `path`: the path itself for cooked files, the
+/// texture-cache copy for RGB/RGBA images when cooking is on, else empty.
+static std::string ResolveCookedPath(const std::string& path) {
+    if (HasExtension(path, ".gvtx")) return path;
+    if (!s_CookOnLoad) return {};
+    int w, h, channels;
+    if (!stbi_info(path.c_str(), &w, &h, &channels) || channels < 3) return {};
+    return CookedCachePath(path, channels);
+}
+#endif
+
+bool Texture::LoadCooked(const std::string& path) {
+#ifdef GV_HAS_GLFW
+    CookedTextureView view;
+    if (!view.Open(path)) {
+        GV_LOG_WARN("Texture::Load — invalid cooked texture: " + path);
+        return false;
+    }
+    TextureFormat fmt = view.GetFormat();
+    std::vector<StreamLevelData> levels;
+    for (u32 i = 0; i < view.GetLevelCount(); ++i) {
+        const auto& lv = view.GetLevel(i);
+        levels.push_back({ lv.width, lv.height, lv.data, lv.size });
+    }
+
+    glGenTextures(1, &m_TextureID);
+    bool uploaded = UploadTextureLevels(m_TextureID, fmt, levels);
+
+    m_Width    = view.GetWidth();
+    m_Height   = view.GetHeight();
+    m_Channels = fmt == TextureFormat::BC4 ? 1u : fmt == TextureFormat::BC5 ? 2u : 4u;
+    GV_LOG_INFO("Texture loaded: " + path + " (" + std::to_string(m_Width) + "x" +
+                std::to_string(m_Height) + ", " + TextureFormatName(fmt) + ", " +
+                std::to_string(levels.size()) + " mips" + (uploaded ? "" : ", CPU-decoded") + ")");
+    return true;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+bool Texture::LoadStreamed(TextureStreamer& streamer, const std::string& path) {
+    m_Path = path;
+#ifdef GV_HAS_GLFW
+    std::string cooked = ResolveCookedPath(path);
+    if (!cooked.empty()) {
+        u32 handle = streamer.Register(cooked);
+        if (handle) {
+            m_TextureID = handle;
+            m_Width     = streamer.GetWidth(handle);
+            m_Height    = streamer.GetHeight(handle);
+            m_Channels  = 4;
+            m_Streamed  = true;
+            return true;
+        }
+    }
+#else
+    (void)streamer;
+#endif
+    // Not cookable (greyscale, cooking off, no GL): load fully resident
+    return Load(path);
+}
+
 bool Texture::Load(const std::string& path) {
     m_Path = path;
 #ifdef GV_HAS_GLFW
@@ -29,6 +161,12 @@ bool Texture::Load(const std::string& path) {
         return false;
     }
 
+    std::string cooked = ResolveCookedPath(path);
+    if (!cooked.empty() && LoadCooked(cooked)) {
+        m_Path = path;
+        return true;
+    }
+
     stbi_set_flip_vertically_on_load(1);
     int w, h, channels;
     unsigned char* data = stbi_load(path.c_str(), &w, &h, &channels, 0);
@@ -121,7 +259,7 @@ bool Mesh::LoadFromFile(const std::string& path) {
             GV_LOG_WARN("Mesh::LoadFromFile — glTF/GLB load failed: " + path);
             return false;
         }
-        // Convert SkinnedVertex → Vertex
+        // Convert SkinnedVertex → Vertex (the loader fills the tangent frame)
         std::vector<Vertex> verts;
         verts.reserve(gltfResult.vertices.size());
         for (auto& sv : gltfResult.vertices) {
@@ -133,10 +271,6 @@ bool Mesh::LoadFromFile(const std::string& path) {
             v.bitangent = sv.bitangent;
             verts.push_back(v);
         }
-        // Compute tangents if not provided
-        for (size_t i = 0; i + 2 < verts.size(); i += 3) {
-            ComputeTangents(verts[i], verts[i + 1], verts[i + 2]);
-        }
         m_Name = path;
         Build(verts, gltfResult.indices);
         GV_LOG_INFO("Mesh loaded from glTF: " + path + " (" +
@@ -297,85 +431,51 @@ bool Mesh::LoadOBJ(const std::string& path) {
 // ── STL Loader (Binary + ASCII) ────────────────────────────────────────────
 
 bool Mesh::LoadSTL(const std::string& path) {
-    std::ifstream file(path, std::ios::binary);
-    if (!file.is_open()) {
+    MappedFile map;
+    if (!map.Open(path)) {
         GV_LOG_WARN("Mesh::LoadSTL — failed to open: " + path);
         return false;
     }
-
-    // Read first 80 bytes (header) + 4 bytes (triangle count) to detect binary vs ASCII
-    char header[80] = {};
-    file.read(header, 80);
-    if (!file.good()) {
+    if (map.Size() < 84) {
         GV_LOG_WARN("Mesh::LoadSTL — file too small: " + path);
         return false;
     }
 
-    // Check if it starts with "solid" (ASCII STL) — but binary files can too,
-    // so we also check if the triangle count makes sense with file size
-    bool isBinary = true;
-    {
-        u32 triCount = 0;
-        file.read(reinterpret_cast<char*>(&triCount), 4);
-        // Each triangle in binary STL = 50 bytes (normal:12 + 3 verts:36 + attrib:2)
-        file.seekg(0, std::ios::end);
-        auto fileSize = file.tellg();
-        auto expectedSize = static_cast<std::streamoff>(84 + triCount * 50);
-        if (fileSize == expectedSize && triCount > 0 && triCount < 50000000) {
-            isBinary = true;
-        } else {
-            // Check for ASCII
-            std::string h(header, 5);
-            if (h == "solid") isBinary = false;
-        }
-        file.seekg(0, std::ios::beg);
-    }
+    // Binary files can also start with "solid", so the size check decides:
+    // 80-byte header, u32 triangle count, 50 bytes per triangle
+    // (normal:12 + 3 verts:36 + attrib:2).
+    u32 triCount = 0;
+    std::memcpy(&triCount, map.Data() + 80, 4);
+    bool isBinary = (map.Size() == 84 + static_cast<u64>(triCount) * 50 && triCount > 0) ||
+                    std::memcmp(map.Data(), "solid", 5) != 0;
 
     std::vector<Vertex> vertices;
     std::vector<u32> indices;
 
     if (isBinary) {
-        // Binary STL
-        file.seekg(80, std::ios::beg);
-        u32 triCount = 0;
-        file.read(reinterpret_cast<char*>(&triCount), 4);
-
-        vertices.reserve(triCount * 3);
-        indices.reserve(triCount * 3);
-
-        for (u32 t = 0; t < triCount; ++t) {
-            float normal[3], v1[3], v2[3], v3[3];
-            u16 attrib;
-            file.read(reinterpret_cast<char*>(normal), 12);
-            file.read(reinterpret_cast<char*>(v1), 12);
-            file.read(reinterpret_cast<char*>(v2), 12);
-            file.read(reinterpret_cast<char*>(v3), 12);
-            file.read(reinterpret_cast<char*>(&attrib), 2);
-
-            if (!file.good()) break;
-
-            Vec3 n(normal[0], normal[1], normal[2]);
-            u32 base = static_cast<u32>(vertices.size());
-
-            Vertex vt0, vt1, vt2;
-            vt0.position = Vec3(v1[0], v1[1], v1[2]); vt0.normal = n;
-            vt1.position = Vec3(v2[0], v2[1], v2[2]); vt1.normal = n;
-            vt2.position = Vec3(v3[0], v3[1], v3[2]); vt2.normal = n;
-            // STL has no UV data
-            vt0.texCoord = Vec2(0, 0);
-            vt1.texCoord = Vec2(1, 0);
-            vt2.texCoord = Vec2(0, 1);
-
-            vertices.push_back(vt0);
-            vertices.push_back(vt1);
-            vertices.push_back(vt2);
-            indices.push_back(base);
-            indices.push_back(base + 1);
-            indices.push_back(base + 2);
+        // Bulk-convert straight out of the mapping.  STL is unindexed, so every
+        // triangle gets three fresh vertices with fixed placeholder UVs.
+        triCount = static_cast<u32>(std::min<u64>(triCount, (map.Size() - 84) / 50));
+        vertices.resize(static_cast<size_t>(triCount) * 3);
+        indices.resize(vertices.size());
+        const u8* rec = map.Data() + 84;
+        static const Vec2 uvs[3] = { Vec2(0, 0), Vec2(1, 0), Vec2(0, 1) };
+        for (u32 t = 0; t < triCount; ++t, rec += 50) {
+            f32 f[12];
+            std::memcpy(f, rec, sizeof(f));
+            Vertex* v = &vertices[static_cast<size_t>(t) * 3];
+            Vec3 n(f[0], f[1], f[2]);
+            for (int k = 0; k < 3; ++k) {
+                v[k].position = Vec3(f[3 + k * 3], f[4 + k * 3], f[5 + k * 3]);
+                v[k].normal = n;
+                v[k].texCoord = uvs[k];
+            }
         }
+        for (u32 i = 0; i < static_cast<u32>(indices.size()); ++i) indices[i] = i;
     } else {
         // ASCII STL
-        file.seekg(0, std::ios::beg);
+        map.Close();
+        std::ifstream file(path);
         std::string line;
         Vec3 curNormal(0, 1, 0);
 
@@ -425,199 +525,381 @@ bool Mesh::LoadSTL(const std::string& path) {
     return true;
 }
 
-// ── PLY Loader (ASCII + Binary Little-Endian) ──────────────────────────────
+// ── PLY Loader (ASCII + Binary Little/Big-Endian) ──────────────────────────
+
+namespace {
+
+enum class PlyType : u8 { None, I8, U8, I16, U16, I32, U32, F32, F64 };
+
+PlyType ParsePlyType(const std::string& t) {
+    if (t == "char"   || t == "int8")    return PlyType::I8;
+    if (t == "uchar"  || t == "uint8")   return PlyType::U8;
+    if (t == "short"  || t == "int16")   return PlyType::I16;
+    if (t == "ushort" || t == "uint16")  return PlyType::U16;
+    if (t == "int"    || t == "int32")   return PlyType::I32;
+    if (t == "uint"   || t == "uint32")  return PlyType::U32;
+    if (t == "float"  || t == "float32") return PlyType::F32;
+    if (t == "double" || t == "float64") return PlyType::F64;
+    return PlyType::None;
+}
+
+u32 PlyTypeSize(PlyType t) {
+    switch (t) {
+        case PlyType::I8:  case PlyType::U8:  return 1;
+        case PlyType::I16: case PlyType::U16: return 2;
+        case PlyType::I32: case PlyType::U32: case PlyType::F32: return 4;
+        case PlyType::F64: return 8;
+        default: return 0;
+    }
+}
+
+/// One binary value as f64 (byte-swapped for big-endian files).
+f64 ReadPlyValue(const u8* p, PlyType t, bool swap) {
+    u8 b[8];
+    u32 n = PlyTypeSize(t);
+    if (swap) for (u32 k = 0; k < n; ++k) b[k] = p[n - 1 - k];
+    else      std::memcpy(b, p, n);
+    switch (t) {
+        case PlyType::I8:  { i8 v;  std::memcpy(&v, b, 1); return v; }
+        case PlyType::U8:  return b[0];
+        case PlyType::I16: { i16 v; std::memcpy(&v, b, 2); return v; }
+        case PlyType::U16: { u16 v; std::memcpy(&v, b, 2); return v; }
+        case PlyType::I32: { i32 v; std::memcpy(&v, b, 4); return v; }
+        case PlyType::U32: { u32 v; std::memcpy(&v, b, 4); return v; }
+        case PlyType::F32: { f32 v; std::memcpy(&v, b, 4); return v; }
+        case PlyType::F64: { f64 v; std::memcpy(&v, b, 8); return v; }
+        default: return 0.0;
+    }
+}
+
+struct PlyProperty {
+    std::string name;
+    PlyType     type      = PlyType::None;   // element type for lists
+    PlyType     countType = PlyType::None;   // set for list properties
+    u32         offset    = 0;               // byte offset in fixed-size binary elements
+};
+
+struct PlyElement {
+    std::string              name;
+    u64                      count = 0;
+    std::vector<PlyProperty> props;
+    u32                      stride = 0;     // 0 if the element has list properties
+};
+
+// Vertex channels the loader understands, in Vertex field order.
+enum PlyChannel { kPlyX, kPlyY, kPlyZ, kPlyNX, kPlyNY, kPlyNZ, kPlyU, kPlyV, kPlyChannelCount };
+
+int PlyChannelOf(const std::string& n) {
+    if (n == "x")  return kPlyX;
+    if (n == "y")  return kPlyY;
+    if (n == "z")  return kPlyZ;
+    if (n == "nx") return kPlyNX;
+    if (n == "ny") return kPlyNY;
+    if (n == "nz") return kPlyNZ;
+    if (n == "s" || n == "u" || n == "texture_u") return kPlyU;
+    if (n == "t" || n == "v" || n == "texture_v") return kPlyV;
+    return -1;
+}
+
+void SetPlyChannel(Vertex& v, int channel, f32 val) {
+    switch (channel) {
+        case kPlyX:  v.position.x = val; break;
+        case kPlyY:  v.position.y = val; break;
+        case kPlyZ:  v.position.z = val; break;
+        case kPlyNX: v.normal.x = val;   break;
+        case kPlyNY: v.normal.y = val;   break;
+        case kPlyNZ: v.normal.z = val;   break;
+        case kPlyU:  v.texCoord.x = val; break;
+        case kPlyV:  v.texCoord.y = val; break;
+        default: break;
+    }
+}
+
+/// Fan-triangulate one face, dropping faces that reference missing vertices.
+void EmitPlyFace(const u32* face, u32 count, u32 vertexCount, std::vector<u32>& indices) {
+    for (u32 j = 0; j < count; ++j)
+        if (face[j] >= vertexCount) return;
+    for (u32 j = 1; j + 1 < count; ++j) {
+        indices.push_back(face[0]);
+        indices.push_back(face[j]);
+        indices.push_back(face[j + 1]);
+    }
+}
+
+} // namespace
 
 bool Mesh::LoadPLY(const std::string& path) {
-    std::ifstream file(path, std::ios::binary);
-    if (!file.is_open()) {
+    MappedFile map;
+    if (!map.Open(path) || !map.Data()) {
         GV_LOG_WARN("Mesh::LoadPLY — failed to open: " + path);
         return false;
     }
+    const char* text = reinterpret_cast<const char*>(map.Data());
+    const char* fileEnd = text + map.Size();
 
     // Parse header
-    std::string line;
-    int vertexCount = 0, faceCount = 0;
-    bool isBinary = false;
-    bool hasNormals = false;
-    bool hasUV = false;
-
-    // Track property order for vertices
-    struct PropInfo { std::string name; std::string type; };
-    std::vector<PropInfo> vertexProps;
-    bool inVertexElement = false;
-
-    while (std::getline(file, line)) {
-        // Trim \r
+    enum { Ascii, BinaryLE, BinaryBE } format = Ascii;
+    std::vector<PlyElement> elements;
+    const char* body = nullptr;
+    for (const char* p = text; p < fileEnd;) {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(fileEnd - p)));
+        if (!eol) break;
+        std::string line(p, eol);
+        p = eol + 1;
         if (!line.empty() && line.back() == '\r') line.pop_back();
-
-        if (line == "end_header") break;
+        if (line == "end_header") { body = p; break; }
 
         std::istringstream ss(line);
         std::string token;
         ss >> token;
-
         if (token == "format") {
             std::string fmt;
             ss >> fmt;
-            isBinary = (fmt == "binary_little_endian");
+            format = fmt == "binary_little_endian" ? BinaryLE : fmt == "binary_big_endian" ? BinaryBE : Ascii;
         } else if (token == "element") {
-            std::string elemName;
-            int count;
-            ss >> elemName >> count;
-            if (elemName == "vertex") {
-                vertexCount = count;
-                inVertexElement = true;
+            PlyElement e;
+            ss >> e.name >> e.count;
+            elements.push_back(e);
+        } else if (token == "property" && !elements.empty()) {
+            PlyProperty prop;
+            std::string ptype;
+            ss >> ptype;
+            if (ptype == "list") {
+                std::string ctype, etype;
+                ss >> ctype >> etype;
+                prop.countType = ParsePlyType(ctype);
+                prop.type = ParsePlyType(etype);
             } else {
-                if (elemName == "face") faceCount = count;
-                inVertexElement = false;
+                prop.type = ParsePlyType(ptype);
             }
-        } else if (token == "property" && inVertexElement) {
-            std::string ptype, pname;
-            ss >> ptype >> pname;
-            if (ptype != "list") {
-                vertexProps.push_back({pname, ptype});
-                if (pname == "nx" || pname == "ny" || pname == "nz") hasNormals = true;
-                if (pname == "s" || pname == "t" || pname == "u" || pname == "v" ||
-                    pname == "texture_u" || pname == "texture_v") hasUV = true;
+            ss >> prop.name;
+            if (prop.type == PlyType::None || (ptype == "list" && prop.countType == PlyType::None)) {
+                GV_LOG_WARN("Mesh::LoadPLY — unknown property type in: " + path);
+                return false;
             }
+            elements.back().props.push_back(prop);
         }
     }
+    if (!body || std::strncmp(text, "ply", 3) != 0) {
+        GV_LOG_WARN("Mesh::LoadPLY — malformed header: " + path);
+        return false;
+    }
+    for (auto& e : elements) {
+        u32 offset = 0;
+        bool fixed = true;
+        for (auto& prop : e.props) {
+            prop.offset = offset;
+            if (prop.countType != PlyType::None) fixed = false;
+            offset += PlyTypeSize(prop.type);
+        }
+        e.stride = fixed ? offset : 0;
+    }
 
-    if (vertexCount <= 0) {
+    const PlyElement* vertexElem = nullptr;
+    for (auto& e : elements) if (e.name == "vertex") vertexElem = &e;
+    if (!vertexElem || vertexElem->count == 0 || vertexElem->count > 0xFFFFFFFFull) {
         GV_LOG_WARN("Mesh::LoadPLY — no vertices in header: " + path);
         return false;
     }
+    const u32 vertexCount = static_cast<u32>(vertexElem->count);
 
-    // Find property indices
-    int xIdx = -1, yIdx = -1, zIdx = -1;
-    int nxIdx = -1, nyIdx = -1, nzIdx = -1;
-    int uIdx = -1, vIdx = -1;
-    for (int i = 0; i < static_cast<int>(vertexProps.size()); ++i) {
-        auto& p = vertexProps[i];
-        if (p.name == "x") xIdx = i;
-        else if (p.name == "y") yIdx = i;
-        else if (p.name == "z") zIdx = i;
-        else if (p.name == "nx") nxIdx = i;
-        else if (p.name == "ny") nyIdx = i;
-        else if (p.name == "nz") nzIdx = i;
-        else if (p.name == "s" || p.name == "u" || p.name == "texture_u") uIdx = i;
-        else if (p.name == "t" || p.name == "v" || p.name == "texture_v") vIdx = i;
+    int channelOf[64];
+    bool hasNormals = false;
+    for (size_t i = 0; i < vertexElem->props.size() && i < 64; ++i) {
+        channelOf[i] = vertexElem->props[i].countType == PlyType::None ? PlyChannelOf(vertexElem->props[i].name) : -1;
+        if (channelOf[i] >= kPlyNX && channelOf[i] <= kPlyNZ) hasNormals = true;
+    }
+    if (vertexElem->props.size() > 64) {
+        GV_LOG_WARN("Mesh::LoadPLY — too many vertex properties: " + path);
+        return false;
     }
 
-    std::vector<Vertex> vertices(vertexCount);
+    std::vector<Vertex> vertices;
     std::vector<u32> indices;
-
-    if (isBinary) {
-        // Binary little-endian: read vertex data
-        for (int vi = 0; vi < vertexCount; ++vi) {
-            for (int pi = 0; pi < static_cast<int>(vertexProps.size()); ++pi) {
-                float val = 0;
-                auto& pt = vertexProps[pi].type;
-                if (pt == "float" || pt == "float32") {
-                    file.read(reinterpret_cast<char*>(&val), 4);
-                } else if (pt == "double" || pt == "float64") {
-                    double d; file.read(reinterpret_cast<char*>(&d), 8); val = static_cast<float>(d);
-                } else if (pt == "uchar" || pt == "uint8") {
-                    u8 b; file.read(reinterpret_cast<char*>(&b), 1); val = b / 255.0f;
-                } else if (pt == "int" || pt == "int32") {
-                    i32 iv; file.read(reinterpret_cast<char*>(&iv), 4); val = static_cast<float>(iv);
-                } else if (pt == "short" || pt == "int16") {
-                    i16 sv; file.read(reinterpret_cast<char*>(&sv), 2); val = static_cast<float>(sv);
+    const size_t bodySize = static_cast<size_t>(fileEnd - body);
+
+    if (format != Ascii) {
+        const bool swap = format == BinaryBE;
+        const u8* p = reinterpret_cast<const u8*>(body);
+        const u8* end = p + bodySize;
+        bool truncated = false;
+
+        for (auto& e : elements) {
+            const bool isVertex = &e == vertexElem;
+            const bool isFace = e.name == "face";
+
+            if (isVertex) {
+                if (e.stride == 0 || static_cast<u64>(end - p) < e.count * e.stride) { truncated = true; break; }
+                vertices.resize(vertexCount);
+
+                // Channel → (offset, type); uchar values are normalized colours.
+                struct { u32 offset; PlyType type; } channels[kPlyChannelCount] = {};
+                bool allFloat = !swap;
+                for (size_t i = 0; i < e.props.size(); ++i) {
+                    int c = channelOf[i];
+                    if (c < 0) continue;
+                    channels[c] = { e.props[i].offset, e.props[i].type };
+                }
+                for (auto& m : channels) if (m.type != PlyType::None && m.type != PlyType::F32) allFloat = false;
+
+                const u8* rec = p;
+                if (allFloat) {
+                    // Common case: native float32 — straight loads from the mapping.
+                    for (u32 vi = 0; vi < vertexCount; ++vi, rec += e.stride) {
+                        Vertex& v = vertices[vi];
+                        for (int c = 0; c < kPlyChannelCount; ++c) {
+                            if (channels[c].type == PlyType::None) continue;
+                            f32 val;
+                            std::memcpy(&val, rec + channels[c].offset, 4);
+                            SetPlyChannel(v, c, val);
+                        }
+                    }
                 } else {
-                    // Skip unknown 4 bytes
-                    file.seekg(4, std::ios::cur);
+                    for (u32 vi = 0; vi < vertexCount; ++vi, rec += e.stride) {
+                        for (int c = 0; c < kPlyChannelCount; ++c) {
+                            if (channels[c].type == PlyType::None) continue;
+                            f64 val = ReadPlyValue(rec + channels[c].offset, channels[c].type, swap);
+                            if (channels[c].type == PlyType::U8) val /= 255.0;
+                            SetPlyChannel(vertices[vi], c, static_cast<f32>(val));
+                        }
+                    }
                 }
-                if (pi == xIdx) vertices[vi].position.x = val;
-                else if (pi == yIdx) vertices[vi].position.y = val;
-                else if (pi == zIdx) vertices[vi].position.z = val;
-                else if (pi == nxIdx) vertices[vi].normal.x = val;
-                else if (pi == nyIdx) vertices[vi].normal.y = val;
-                else if (pi == nzIdx) vertices[vi].normal.z = val;
-                else if (pi == uIdx)  vertices[vi].texCoord.x = val;
-                else if (pi == vIdx)  vertices[vi].texCoord.y = val;
+                p += e.count * e.stride;
+                continue;
             }
-        }
-        // Read faces
-        for (int fi = 0; fi < faceCount; ++fi) {
-            u8 count;
-            file.read(reinterpret_cast<char*>(&count), 1);
-            std::vector<u32> faceIdx(count);
-            for (u8 j = 0; j < count; ++j) {
-                i32 idx;
-                file.read(reinterpret_cast<char*>(&idx), 4);
-                faceIdx[j] = static_cast<u32>(idx);
+
+            if (e.stride != 0) {
+                // Fixed-size element we don't use: skip it in one step.
+                if (static_cast<u64>(end - p) < e.count * e.stride) { truncated = true; break; }
+                p += e.count * e.stride;
+                continue;
             }
-            // Fan triangulate
-            for (u8 j = 1; j + 1 < count; ++j) {
-                indices.push_back(faceIdx[0]);
-                indices.push_back(faceIdx[j]);
-                indices.push_back(faceIdx[j + 1]);
+
+            // Elements with lists are walked record by record.
+            const PlyProperty* indexList = nullptr;
+            if (isFace)
+                for (auto& prop : e.props)
+                    if (prop.countType != PlyType::None &&
+                        (prop.name == "vertex_indices" || prop.name == "vertex_index")) indexList = &prop;
+            if (isFace) indices.reserve(indices.size() + static_cast<size_t>(e.count) * 3);
+
+            // Fast path: a face element that is only "list uchar int|uint".
+            if (indexList && e.props.size() == 1 && !swap && indexList->countType == PlyType::U8 &&
+                (indexList->type == PlyType::I32 || indexList->type == PlyType::U32)) {
+                u32 face[256];
+                for (u64 fi = 0; fi < e.count; ++fi) {
+                    if (p >= end) { truncated = true; break; }
+                    u32 count = *p++;
+                    if (static_cast<size_t>(end - p) < count * 4u) { truncated = true; break; }
+                    std::memcpy(face, p, count * 4u);
+                    p += count * 4u;
+                    EmitPlyFace(face, count, vertexCount, indices);
+                }
+                if (truncated) break;
+                continue;
             }
-        }
-    } else {
-        // ASCII
-        for (int vi = 0; vi < vertexCount; ++vi) {
-            if (!std::getline(file, line)) break;
-            if (!line.empty() && line.back() == '\r') line.pop_back();
-            std::istringstream ss(line);
-            for (int pi = 0; pi < static_cast<int>(vertexProps.size()); ++pi) {
-                float val = 0;
-                ss >> val;
-                if (pi == xIdx) vertices[vi].position.x = val;
-                else if (pi == yIdx) vertices[vi].position.y = val;
-                else if (pi == zIdx) vertices[vi].position.z = val;
-                else if (pi == nxIdx) vertices[vi].normal.x = val;
-                else if (pi == nyIdx) vertices[vi].normal.y = val;
-                else if (pi == nzIdx) vertices[vi].normal.z = val;
-                else if (pi == uIdx)  vertices[vi].texCoord.x = val;
-                else if (pi == vIdx)  vertices[vi].texCoord.y = val;
+
+            std::vector<u32> face;
+            for (u64 fi = 0; fi < e.count && !truncated; ++fi) {
+                for (auto& prop : e.props) {
+                    if (prop.countType == PlyType::None) {
+                        u32 n = PlyTypeSize(prop.type);
+                        if (static_cast<size_t>(end - p) < n) { truncated = true; break; }
+                        p += n;
+                        continue;
+                    }
+                    u32 cn = PlyTypeSize(prop.countType);
+                    if (static_cast<size_t>(end - p) < cn) { truncated = true; break; }
+                    f64 countVal = ReadPlyValue(p, prop.countType, swap);
+                    p += cn;
+                    u64 count = countVal > 0 ? static_cast<u64>(countVal) : 0;
+                    u32 en = PlyTypeSize(prop.type);
+                    if (static_cast<u64>(end - p) < count * en) { truncated = true; break; }
+                    if (&prop == indexList) {
+                        face.resize(static_cast<size_t>(count));
+                        for (u64 j = 0; j < count; ++j) {
+                            f64 idx = ReadPlyValue(p + j * en, prop.type, swap);
+                            face[static_cast<size_t>(j)] = idx >= 0 ? static_cast<u32>(idx) : 0xFFFFFFFFu;
+                        }
+                        EmitPlyFace(face.data(), static_cast<u32>(count), vertexCount, indices);
+                    }
+                    p += count * en;
+                }
             }
+            if (truncated) break;
         }
-        for (int fi = 0; fi < faceCount; ++fi) {
-            if (!std::getline(file, line)) break;
-            if (!line.empty() && line.back() == '\r') line.pop_back();
-            std::istringstream ss(line);
-            int count;
-            ss >> count;
-            std::vector<u32> faceIdx(count);
-            for (int j = 0; j < count; ++j) {
-                int idx;
-                ss >> idx;
-                faceIdx[j] = static_cast<u32>(idx);
-            }
-            for (int j = 1; j + 1 < count; ++j) {
-                indices.push_back(faceIdx[0]);
-                indices.push_back(faceIdx[j]);
-                indices.push_back(faceIdx[j + 1]);
+        if (truncated)
+            GV_LOG_WARN("Mesh::LoadPLY — file truncated, loading what was read: " + path);
+    } else {
+        // ASCII: whitespace-separated values, one element entry after another
+        // (a list is its count followed by that many values).
+        std::string data(body, bodySize);
+        const char* cur = data.c_str();
+        auto next = [&](f64& out) {
+            char* stop = nullptr;
+            out = std::strtod(cur, &stop);
+            if (stop == cur) return false;
+            cur = stop;
+            return true;
+        };
+        bool ok = true;
+        std::vector<u32> face;
+        for (auto& e : elements) {
+            const bool isVertex = &e == vertexElem;
+            const bool isFace = e.name == "face";
+            if (isVertex) vertices.resize(vertexCount);
+            for (u64 ei = 0; ei < e.count && ok; ++ei) {
+                for (size_t pi = 0; pi < e.props.size() && ok; ++pi) {
+                    auto& prop = e.props[pi];
+                    f64 val = 0.0;
+                    if (!(ok = next(val))) break;
+                    if (prop.countType == PlyType::None) {
+                        if (isVertex && channelOf[pi] >= 0)
+                            SetPlyChannel(vertices[static_cast<size_t>(ei)], channelOf[pi], static_cast<f32>(val));
+                        continue;
+                    }
+                    u32 count = val > 0 ? static_cast<u32>(val) : 0;
+                    face.resize(count);
+                    for (u32 j = 0; j < count && ok; ++j) {
+                        f64 idx = 0.0;
+                        ok = next(idx);
+                        face[j] = idx >= 0 ? static_cast<u32>(idx) : 0xFFFFFFFFu;
+                    }
+                    if (ok && isFace && (prop.name == "vertex_indices" || prop.name == "vertex_index"))
+                        EmitPlyFace(face.data(), count, vertexCount, indices);
+                }
             }
+            if (!ok) break;
         }
+        if (!ok)
+            GV_LOG_WARN("Mesh::LoadPLY — file truncated, loading what was read: " + path);
+    }
+
+    if (vertices.empty()) {
+        GV_LOG_WARN("Mesh::LoadPLY — no vertex data in: " + path);
+        return false;
     }
 
     // If no faces, treat as point cloud → generate dummy triangles
-    if (indices.empty() && !vertices.empty()) {
-        for (u32 i = 0; i < static_cast<u32>(vertices.size()); ++i)
-            indices.push_back(i);
+    if (indices.empty()) {
+        indices.resize(vertices.size() - vertices.size() % 3);
+        for (u32 i = 0; i < static_cast<u32>(indices.size()); ++i) indices[i] = i;
     }
 
     // Compute normals if not provided
     if (!hasNormals) {
         for (size_t i = 0; i + 2 < indices.size(); i += 3) {
             u32 i0 = indices[i], i1 = indices[i+1], i2 = indices[i+2];
-            if (i0 < vertices.size() && i1 < vertices.size() && i2 < vertices.size()) {
-                Vec3 e1 = vertices[i1].position - vertices[i0].position;
-                Vec3 e2 = vertices[i2].position - vertices[i0].position;
-                Vec3 n = e1.Cross(e2).Normalized();
-                vertices[i0].normal = vertices[i1].normal = vertices[i2].normal = n;
-            }
+            Vec3 e1 = vertices[i1].position - vertices[i0].position;
+            Vec3 e2 = vertices[i2].position - vertices[i0].position;
+            Vec3 n = e1.Cross(e2).Normalized();
+            vertices[i0].normal = vertices[i1].normal = vertices[i2].normal = n;
         }
     }
 
     // Compute tangents
     for (size_t i = 0; i + 2 < indices.size(); i += 3) {
-        u32 i0 = indices[i], i1 = indices[i+1], i2 = indices[i+2];
-        if (i0 < vertices.size() && i1 < vertices.size() && i2 < vertices.size()) {
-            ComputeTangents(vertices[i0], vertices[i1], vertices[i2]);
-        }
+        ComputeTangents(vertices[indices[i]], vertices[indices[i+1]], vertices[indices[i+2]]);
     }
 
     m_Name = path;
@@ -810,24 +1092,62 @@ bool Mesh::LoadDAE(const std::string& path) {
     return true;
 }
 
-// ── FBX Loader (ASCII FBX 7.x) ────────────────────────────────────────────
+// ── FBX Loader (binary via FBXLoader, ASCII FBX 7.x here) ─────────────────
 
 bool Mesh::LoadFBX(const std::string& path) {
-    // Try to detect binary FBX (starts with "Kaydara FBX Binary")
     {
-        std::ifstream binCheck(path, std::ios::binary);
-        if (!binCheck.is_open()) {
+        MappedFile map;
+        if (!map.Open(path)) {
             GV_LOG_WARN("Mesh::LoadFBX — failed to open: " + path);
             return false;
         }
-        char magic[21] = {};
-        binCheck.read(magic, 20);
-        if (std::string(magic, 18) == "Kaydara FBX Binary") {
-            GV_LOG_WARN("Mesh::LoadFBX — binary FBX detected. For binary FBX files, "
-                        "please convert to glTF/OBJ first (e.g., via Blender export). "
-                        "ASCII FBX is supported directly. File: " + path);
-            // Attempt basic binary FBX geometry extraction
-            // Binary FBX is complex; we'll try to parse the most common case
+        if (map.Data() && FBXDocument::IsBinaryFBX(map.Data(), map.Size())) {
+            map.Close();
+            FBXScene fbx;
+            if (!LoadFBXBinary(path, fbx)) return false;
+
+            // Flatten every mesh into one, baked into world space.
+            std::vector<Vertex> vertices;
+            std::vector<u32> outIndices;
+            for (auto& m : fbx.meshes) {
+                const f32* w = m.worldTransform.m;
+                Mat4 nm = m.worldTransform.Inverse();   // normals use the inverse transpose
+                u32 base = static_cast<u32>(vertices.size());
+                for (auto& sv : m.vertices) {
+                    const Vec3& p = sv.position;
+                    const Vec3& n = sv.normal;
+                    Vertex v;
+                    v.position = Vec3(w[0] * p.x + w[4] * p.y + w[8]  * p.z + w[12],
+                                      w[1] * p.x + w[5] * p.y + w[9]  * p.z + w[13],
+                                      w[2] * p.x + w[6] * p.y + w[10] * p.z + w[14]);
+                    v.normal = Vec3(nm.m[0] * n.x + nm.m[1] * n.y + nm.m[2]  * n.z,
+                                    nm.m[4] * n.x + nm.m[5] * n.y + nm.m[6]  * n.z,
+                                    nm.m[8] * n.x + nm.m[9] * n.y + nm.m[10] * n.z).Normalized();
+                    v.texCoord = sv.texCoord;
+                    vertices.push_back(v);
+                }
+                // Mirroring transforms flip the winding; swap to keep faces front-facing.
+                f32 det = w[0] * (w[5] * w[10] - w[9] * w[6]) - w[4] * (w[1] * w[10] - w[9] * w[2]) +
+                          w[8] * (w[1] * w[6] - w[5] * w[2]);
+                for (size_t i = 0; i + 2 < m.indices.size(); i += 3) {
+                    outIndices.push_back(base + m.indices[i]);
+                    outIndices.push_back(base + m.indices[det < 0.0f ? i + 2 : i + 1]);
+                    outIndices.push_back(base + m.indices[det < 0.0f ? i + 1 : i + 2]);
+                }
+            }
+            if (outIndices.empty()) {
+                GV_LOG_WARN("Mesh::LoadFBX — no polygons extracted: " + path);
+                return false;
+            }
+            for (size_t i = 0; i + 2 < outIndices.size(); i += 3)
+                ComputeTangents(vertices[outIndices[i]], vertices[outIndices[i + 1]], vertices[outIndices[i + 2]]);
+
+            m_Name = path;
+            Build(vertices, outIndices);
+            GV_LOG_INFO("Mesh loaded from binary FBX " + std::to_string(fbx.version) + ": " + path + " (" +
+                        std::to_string(vertices.size()) + " verts, " +
+                        std::to_string(outIndices.size() / 3) + " tris)");
+            return true;
         }
     }
 
@@ -979,26 +1299,28 @@ bool Mesh::LoadFBX(const std::string& path) {
     return true;
 }
 
-void Mesh::Build(const std::vector<Vertex>& vertices, const std::vector<u32>& indices) {
-    m_Vertices = vertices;
-    m_Indices  = indices;
-#ifdef GV_HAS_GLFW
-    if (glGenVertexArrays) {
-        if (m_VAO) { glDeleteVertexArrays(1, &m_VAO); m_VAO = 0; }
-        if (m_VBO) { glDeleteBuffers(1, &m_VBO);      m_VBO = 0; }
-        if (m_EBO) { glDeleteBuffers(1, &m_EBO);      m_EBO = 0; }
+// ── Mesh buffers ───────────────────────────────────────────────────────────
+
+namespace {
 
-        glGenVertexArrays(1, &m_VAO);
-        glGenBuffers(1, &m_VBO);
-        glGenBuffers(1, &m_EBO);
-        glBindVertexArray(m_VAO);
+/// Uploads through GL; a no-op without a context (or a GL build).
+class GLMeshBufferBackend : public MeshBufferBackend {
+public:
+    MeshBuffers Upload(const std::vector<Vertex>& vertices, const std::vector<u32>& indices) override {
+        MeshBuffers b;
+#ifdef GV_HAS_GLFW
+        if (!glGenVertexArrays) return b;
+        glGenVertexArrays(1, &b.vao);
+        glGenBuffers(1, &b.vbo);
+        glGenBuffers(1, &b.ebo);
+        glBindVertexArray(b.vao);
 
-        glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+        glBindBuffer(GL_ARRAY_BUFFER, b.vbo);
         glBufferData(GL_ARRAY_BUFFER,
                      static_cast<GLsizeiptr>(vertices.size() * sizeof(Vertex)),
                      vertices.data(), GL_STATIC_DRAW);
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, b.ebo);
         glBufferData(GL_ELEMENT_ARRAY_BUFFER,
                      static_cast<GLsizeiptr>(indices.size() * sizeof(u32)),
                      indices.data(), GL_STATIC_DRAW);
@@ -1029,15 +1351,88 @@ void Mesh::Build(const std::vector<Vertex>& vertices, const std::vector<u32>& in
         glEnableVertexAttribArray(4);
 
         glBindVertexArray(0);
+#else
+        (void)vertices; (void)indices;
+#endif
+        return b;
     }
+
+    void Release(const MeshBuffers& b) override {
+#ifdef GV_HAS_GLFW
+        if (glDeleteVertexArrays && b.vao) glDeleteVertexArrays(1, &b.vao);
+        if (glDeleteBuffers && b.vbo)      glDeleteBuffers(1, &b.vbo);
+        if (glDeleteBuffers && b.ebo)      glDeleteBuffers(1, &b.ebo);
+#else
+        (void)b;
 #endif
+    }
+};
+
+GLMeshBufferBackend s_GLMeshBuffers;
+MeshBufferBackend*  s_MeshBufferBackend = nullptr;
+
+} // anonymous namespace
+
+void Mesh::SetBufferBackend(MeshBufferBackend* backend) { s_MeshBufferBackend = backend; }
+MeshBufferBackend& Mesh::GetBufferBackend() {
+    return s_MeshBufferBackend ? *s_MeshBufferBackend : static_cast<MeshBufferBackend&>(s_GLMeshBuffers);
+}
+
+static bool s_BuildMeshlets       = true;
+static u32  s_MeshletMinTriangles = 4096;
+
+void Mesh::SetBuildMeshlets(bool enabled)     { s_BuildMeshlets = enabled; }
+bool Mesh::GetBuildMeshlets()                 { return s_BuildMeshlets; }
+void Mesh::SetMeshletMinTriangles(u32 count)  { s_MeshletMinTriangles = count; }
+u32  Mesh::GetMeshletMinTriangles()           { return s_MeshletMinTriangles; }
+
+void Mesh::Build(const std::vector<Vertex>& vertices, const std::vector<u32>& indices) {
+    m_Vertices = vertices;
+    m_BoundsMin = m_BoundsMax = vertices.empty() ? Vec3(0, 0, 0) : vertices[0].position;
+    for (const auto& v : vertices) {
+        m_BoundsMin.x = std::min(m_BoundsMin.x, v.position.x); m_BoundsMax.x = std::max(m_BoundsMax.x, v.position.x);
+        m_BoundsMin.y = std::min(m_BoundsMin.y, v.position.y); m_BoundsMax.y = std::max(m_BoundsMax.y, v.position.y);
+        m_BoundsMin.z = std::min(m_BoundsMin.z, v.position.z); m_BoundsMax.z = std::max(m_BoundsMax.z, v.position.z);
+    }
+    m_Meshlets.Clear();
+    if (s_BuildMeshlets && !vertices.empty() && indices.size() / 3 >= s_MeshletMinTriangles) {
+        // Upload the index buffer in meshlet order so each meshlet is one range.
+        BuildMeshlets(indices, &vertices[0].position.x, vertices.size(), sizeof(Vertex), m_Meshlets, m_Indices);
+        // Normal cones assume counter-clockwise winding.  Meshes are drawn
+        // double-sided and some generators wind the other way, so a meshlet
+        // with a triangle wound against its vertex normals is never
+        // backface-culled.
+        for (Meshlet& m : m_Meshlets.meshlets) {
+            for (u32 i = m.firstIndex; i < m.firstIndex + m.indexCount; i += 3) {
+                const Vertex& a = vertices[m_Indices[i]];
+                const Vertex& b = vertices[m_Indices[i + 1]];
+                const Vertex& c = vertices[m_Indices[i + 2]];
+                Vec3 n = (b.position - a.position).Cross(c.position - a.position);
+                if (n.Dot(a.normal + b.normal + c.normal) < 0.0f) { m.coneCutoff = 1.0f; break; }
+            }
+        }
+    } else {
+        m_Indices = indices;
+    }
+    ReleaseGPU();
+    m_Backend = &GetBufferBackend();
+    m_Buffers = m_Backend->Upload(vertices, m_Indices);
     GV_LOG_DEBUG("Mesh '" + m_Name + "' built: " + std::to_string(vertices.size()) +
-                 " verts, " + std::to_string(indices.size()) + " indices.");
+                 " verts, " + std::to_string(m_Indices.size()) + " indices, " +
+                 std::to_string(m_Meshlets.meshlets.size()) + " meshlets.");
+}
+
+Mesh::~Mesh() { ReleaseGPU(); }
+
+void Mesh::ReleaseGPU() {
+    if (m_Backend && m_Buffers.vao) m_Backend->Release(m_Buffers);
+    m_Buffers = MeshBuffers();
+    m_Backend = nullptr;
 }
 
 void Mesh::Bind()   const {
 #ifdef GV_HAS_GLFW
-    if (m_VAO && glBindVertexArray) glBindVertexArray(m_VAO);
+    if (m_Buffers.vao && glBindVertexArray) glBindVertexArray(m_Buffers.vao);
 #endif
 }
 
@@ -1171,6 +1566,23 @@ Shared<Mesh> Mesh::CreatePlane(f32 width, f32 depth) {
     return mesh;
 }
 
+Shared<Mesh> Mesh::CreateTriangle() {
+    auto mesh = MakeShared<Mesh>("Triangle");
+    Vec3 n(0, 0, 1);
+    Vec3 t(1, 0, 0);
+    Vec3 b(0, 1, 0);
+
+    std::vector<Vertex> verts = {
+        { { 0.0f,  0.5f, 0}, n, {0.5f,1}, t, b },
+        { {-0.5f, -0.5f, 0}, n, {0,0},    t, b },
+        { { 0.5f, -0.5f, 0}, n, {1,0},    t, b },
+    };
+    std::vector<u32> indices = { 0, 1, 2 };
+    mesh->Build(verts, indices);
+    GV_LOG_DEBUG("Primitive 'Triangle' created.");
+    return mesh;
+}
+
 Shared<Mesh> Mesh::CreateQuad() {
     auto mesh = MakeShared<Mesh>("Quad");
     Vec3 n(0, 0, 1);
@@ -1240,7 +1652,8 @@ Shared<Texture> AssetManager::LoadTexture(const std::string& path) {
     if (it != m_Textures.end()) return it->second;
 
     auto tex = MakeShared<Texture>(path);
-    tex->Load(path);
+    if (m_Streamer) tex->LoadStreamed(*m_Streamer, path);
+    else            tex->Load(path);
     m_Textures[path] = tex;
     return tex;
 }
@@ -1266,10 +1679,39 @@ Shared<Material> AssetManager::GetMaterial(const std::string& name) const {
     return (it != m_Materials.end()) ? it->second : nullptr;
 }
 
+AssetManager::AssetManager() = default;
+AssetManager::~AssetManager() = default;
+
+void AssetManager::EnableTextureStreaming(const TextureStreamSettings& settings) {
+    auto backend = CreateGLTextureStreamBackend();
+    if (!backend) {
+        GV_LOG_INFO("AssetManager — texture streaming unavailable (no GL).");
+        return;
+    }
+    EnableTextureStreaming(std::move(backend), settings);
+}
+
+void AssetManager::EnableTextureStreaming(Unique<TextureStreamBackend> backend,
+                                          const TextureStreamSettings& settings) {
+    if (m_Streamer) m_Streamer->Clear();
+    m_Streamer.reset();
+    m_StreamBackend = std::move(backend);
+    m_Streamer = MakeUnique<TextureStreamer>(m_StreamBackend.get(), settings);
+    GV_LOG_INFO("AssetManager — texture streaming on (budget " +
+                std::to_string(settings.budgetBytes / (1024 * 1024)) + " MB).");
+}
+
+MeshRegistry& AssetManager::GetMeshRegistry() {
+    if (!m_MeshRegistry) m_MeshRegistry = MakeUnique<MeshRegistry>();
+    return *m_MeshRegistry;
+}
+
 void AssetManager::Clear() {
+    if (m_Streamer) m_Streamer->Clear();
     m_Textures.clear();
     m_Meshes.clear();
     m_Materials.clear();
+    if (m_MeshRegistry) m_MeshRegistry->Clear();
     GV_LOG_INFO("AssetManager — all cached resources released.");
 }
 
@@ -1432,434 +1874,4 @@ void SkinnedMesh::Unbind() const {
 #endif
 }
 
-// ============================================================================
-// glTF 2.0 / GLB Loader
-// ============================================================================
-// Supports both .gltf (JSON + .bin) and .glb (binary container) formats.
-// Parses accessors, buffer views, and mesh primitives to extract geometry.
-// ============================================================================
-
-// ── Tiny JSON helpers (no external dependency) ─────────────────────────────
-
-// Skip whitespace
-static size_t JsonSkipWS(const std::string& s, size_t p) {
-    while (p < s.size() && (s[p]==' '||s[p]=='\t'||s[p]=='\n'||s[p]=='\r')) ++p;
-    return p;
-}
-
-// Parse a JSON number at position p, return value and advance p
-static double JsonParseNumber(const std::string& s, size_t& p) {
-    p = JsonSkipWS(s, p);
-    size_t start = p;
-    if (p < s.size() && (s[p]=='-'||s[p]=='+')) ++p;
-    while (p < s.size() && (std::isdigit((unsigned char)s[p])||s[p]=='.'||s[p]=='e'||s[p]=='E'||s[p]=='+'||s[p]=='-')) ++p;
-    return std::atof(s.substr(start, p - start).c_str());
-}
-
-// Parse a JSON string at position p (p should point to opening "), advance p past closing quote
-static std::string JsonParseString(const std::string& s, size_t& p) {
-    p = JsonSkipWS(s, p);
-    if (p >= s.size() || s[p] != '"') return "";
-    ++p;
-    std::string result;
-    while (p < s.size() && s[p] != '"') {
-        if (s[p] == '\\' && p + 1 < s.size()) { result += s[p+1]; p += 2; }
-        else { result += s[p]; ++p; }
-    }
-    if (p < s.size()) ++p;  // skip closing quote
-    return result;
-}
-
-// Find the value of a key in the current JSON object scope starting at `start`
-static size_t JsonFindKey(const std::string& s, size_t start, const std::string& key) {
-    std::string needle = "\"" + key + "\"";
-    size_t p = s.find(needle, start);
-    if (p == std::string::npos) return std::string::npos;
-    p += needle.size();
-    p = JsonSkipWS(s, p);
-    if (p < s.size() && s[p] == ':') ++p;
-    return JsonSkipWS(s, p);
-}
-
-// Find matching bracket/brace end starting at p (p points to '[' or '{')
-static size_t JsonFindMatchingEnd(const std::string& s, size_t p) {
-    if (p >= s.size()) return std::string::npos;
-    char open = s[p], close = (open == '[') ? ']' : '}';
-    int depth = 1;
-    ++p;
-    bool inStr = false;
-    while (p < s.size() && depth > 0) {
-        if (s[p] == '"' && (p == 0 || s[p-1] != '\\')) inStr = !inStr;
-        if (!inStr) {
-            if (s[p] == open) ++depth;
-            if (s[p] == close) --depth;
-        }
-        ++p;
-    }
-    return p;
-}
-
-// Extract the i-th element from a JSON array (0-indexed). Returns start..end range in the string.
-static bool JsonArrayElement(const std::string& s, size_t arrayStart, int index, size_t& elemStart, size_t& elemEnd) {
-    size_t p = JsonSkipWS(s, arrayStart);
-    if (p >= s.size() || s[p] != '[') return false;
-    ++p;
-    int cur = 0;
-    while (p < s.size() && s[p] != ']') {
-        p = JsonSkipWS(s, p);
-        size_t start = p;
-        // Find end of this element
-        if (s[p] == '{' || s[p] == '[') {
-            size_t end = JsonFindMatchingEnd(s, p);
-            if (cur == index) { elemStart = start; elemEnd = end; return true; }
-            p = end;
-        } else if (s[p] == '"') {
-            ++p;
-            while (p < s.size() && s[p] != '"') { if (s[p]=='\\') ++p; ++p; }
-            if (p < s.size()) ++p;
-            if (cur == index) { elemStart = start; elemEnd = p; return true; }
-        } else {
-            while (p < s.size() && s[p] != ',' && s[p] != ']' && s[p] != '}') ++p;
-            if (cur == index) { elemStart = start; elemEnd = p; return true; }
-        }
-        p = JsonSkipWS(s, p);
-        if (p < s.size() && s[p] == ',') ++p;
-        ++cur;
-    }
-    return false;
-}
-
-// Count elements in a JSON array
-static int JsonArrayCount(const std::string& s, size_t arrayStart) {
-    int count = 0;
-    size_t es, ee;
-    while (JsonArrayElement(s, arrayStart, count, es, ee)) ++count;
-    return count;
-}
-
-// Get an integer value from key in an object substring
-static int JsonObjGetInt(const std::string& s, size_t objStart, size_t objEnd, const std::string& key, int def = -1) {
-    std::string sub = s.substr(objStart, objEnd - objStart);
-    size_t p = JsonFindKey(sub, 0, key);
-    if (p == std::string::npos) return def;
-    return static_cast<int>(JsonParseNumber(sub, p));
-}
-
-static std::string JsonObjGetString(const std::string& s, size_t objStart, size_t objEnd, const std::string& key) {
-    std::string sub = s.substr(objStart, objEnd - objStart);
-    size_t p = JsonFindKey(sub, 0, key);
-    if (p == std::string::npos) return "";
-    return JsonParseString(sub, p);
-}
-
-// ── Accessor info struct ───────────────────────────────────────────────────
-struct GltfAccessor {
-    int bufferView   = -1;
-    int byteOffset   = 0;
-    int componentType = 0;   // 5120=byte, 5121=ubyte, 5122=short, 5123=ushort, 5125=uint, 5126=float
-    int count        = 0;
-    std::string type;        // "SCALAR", "VEC2", "VEC3", "VEC4", "MAT4"
-};
-
-struct GltfBufferView {
-    int buffer     = 0;
-    int byteOffset = 0;
-    int byteLength = 0;
-    int byteStride = 0;
-};
-
-bool LoadGLTF(const std::string& path, GLTFLoadResult& result) {
-    std::string json;
-    std::vector<u8> binData;
-
-    // ── Detect .glb vs .gltf ───────────────────────────────────────────────
-    std::string ext = path.substr(path.rfind('.'));
-    for (auto& c : ext) c = static_cast<char>(std::tolower((unsigned char)c));
-
-    if (ext == ".glb") {
-        // ── GLB binary container ────────────────────────────────────────────
-        // Format: 12-byte header + chunk0 (JSON) + chunk1 (BIN)
-        std::ifstream file(path, std::ios::binary);
-        if (!file.is_open()) {
-            GV_LOG_ERROR("GLB loader — cannot open: " + path);
-            return false;
-        }
-        std::vector<u8> fileData((std::istreambuf_iterator<char>(file)),
-                                 std::istreambuf_iterator<char>());
-        file.close();
-
-        if (fileData.size() < 12) {
-            GV_LOG_ERROR("GLB loader — file too small: " + path);
-            return false;
-        }
-
-        // Header: magic(4) + version(4) + length(4)
-        u32 magic   = *reinterpret_cast<u32*>(&fileData[0]);
-        u32 version = *reinterpret_cast<u32*>(&fileData[4]);
-        // u32 totalLen = *reinterpret_cast<u32*>(&fileData[8]);
-        (void)version;
-
-        if (magic != 0x46546C67) {  // "glTF" in little-endian
-            GV_LOG_ERROR("GLB loader — invalid magic number: " + path);
-            return false;
-        }
-
-        // Parse chunks
-        size_t offset = 12;
-        while (offset + 8 <= fileData.size()) {
-            u32 chunkLen  = *reinterpret_cast<u32*>(&fileData[offset]);
-            u32 chunkType = *reinterpret_cast<u32*>(&fileData[offset + 4]);
-            offset += 8;
-
-            if (offset + chunkLen > fileData.size()) break;
-
-            if (chunkType == 0x4E4F534A) {  // "JSON"
-                json.assign(reinterpret_cast<char*>(&fileData[offset]), chunkLen);
-            } else if (chunkType == 0x004E4942) {  // "BIN\0"
-                binData.assign(fileData.begin() + offset, fileData.begin() + offset + chunkLen);
-            }
-            offset += chunkLen;
-        }
-
-        if (json.empty()) {
-            GV_LOG_ERROR("GLB loader — no JSON chunk found: " + path);
-            return false;
-        }
-        GV_LOG_INFO("GLB loader — parsed " + std::to_string(json.size()) + " bytes JSON, " +
-                    std::to_string(binData.size()) + " bytes BIN from: " + path);
-    } else {
-        // ── .gltf (JSON + external .bin) ────────────────────────────────────
-        std::ifstream file(path);
-        if (!file.is_open()) {
-            GV_LOG_ERROR("glTF loader — cannot open: " + path);
-            return false;
-        }
-        std::stringstream ss;
-        ss << file.rdbuf();
-        json = ss.str();
-        file.close();
-
-        // Find buffer URI
-        size_t buffersPos = JsonFindKey(json, 0, "buffers");
-        if (buffersPos != std::string::npos) {
-            size_t es, ee;
-            if (JsonArrayElement(json, buffersPos, 0, es, ee)) {
-                std::string uri = JsonObjGetString(json, es, ee, "uri");
-                if (!uri.empty()) {
-                    std::string dir = path;
-                    size_t sl = dir.find_last_of("/\\");
-                    dir = (sl != std::string::npos) ? dir.substr(0, sl + 1) : "";
-                    std::string binPath = dir + uri;
-
-                    std::ifstream binFile(binPath, std::ios::binary);
-                    if (binFile.is_open()) {
-                        binData.assign((std::istreambuf_iterator<char>(binFile)),
-                                        std::istreambuf_iterator<char>());
-                        binFile.close();
-                        GV_LOG_INFO("glTF loader — loaded buffer: " + binPath +
-                                    " (" + std::to_string(binData.size()) + " bytes)");
-                    } else {
-                        GV_LOG_ERROR("glTF loader — cannot open buffer: " + binPath);
-                        return false;
-                    }
-                }
-            }
-        }
-    }
-
-    if (binData.empty()) {
-        GV_LOG_ERROR("glTF loader — no binary data found: " + path);
-        return false;
-    }
-
-    // ── Parse buffer views ──────────────────────────────────────────────────
-    std::vector<GltfBufferView> bufferViews;
-    {
-        size_t bvPos = JsonFindKey(json, 0, "bufferViews");
-        if (bvPos != std::string::npos) {
-            int count = JsonArrayCount(json, bvPos);
-            for (int i = 0; i < count; ++i) {
-                size_t es, ee;
-                if (!JsonArrayElement(json, bvPos, i, es, ee)) break;
-                GltfBufferView bv;
-                bv.buffer     = JsonObjGetInt(json, es, ee, "buffer", 0);
-                bv.byteOffset = JsonObjGetInt(json, es, ee, "byteOffset", 0);
-                bv.byteLength = JsonObjGetInt(json, es, ee, "byteLength", 0);
-                bv.byteStride = JsonObjGetInt(json, es, ee, "byteStride", 0);
-                bufferViews.push_back(bv);
-            }
-        }
-    }
-
-    // ── Parse accessors ─────────────────────────────────────────────────────
-    std::vector<GltfAccessor> accessors;
-    {
-        size_t accPos = JsonFindKey(json, 0, "accessors");
-        if (accPos != std::string::npos) {
-            int count = JsonArrayCount(json, accPos);
-            for (int i = 0; i < count; ++i) {
-                size_t es, ee;
-                if (!JsonArrayElement(json, accPos, i, es, ee)) break;
-                GltfAccessor acc;
-                acc.bufferView    = JsonObjGetInt(json, es, ee, "bufferView", -1);
-                acc.byteOffset    = JsonObjGetInt(json, es, ee, "byteOffset", 0);
-                acc.componentType = JsonObjGetInt(json, es, ee, "componentType", 5126);
-                acc.count         = JsonObjGetInt(json, es, ee, "count", 0);
-                acc.type          = JsonObjGetString(json, es, ee, "type");
-                accessors.push_back(acc);
-            }
-        }
-    }
-
-    // ── Helper: read accessor data from buffer ──────────────────────────────
-    auto getAccessorData = [&](int accIdx) -> const u8* {
-        if (accIdx < 0 || accIdx >= static_cast<int>(accessors.size())) return nullptr;
-        auto& acc = accessors[accIdx];
-        if (acc.bufferView < 0 || acc.bufferView >= static_cast<int>(bufferViews.size())) return nullptr;
-        auto& bv = bufferViews[acc.bufferView];
-        size_t offset = static_cast<size_t>(bv.byteOffset) + static_cast<size_t>(acc.byteOffset);
-        if (offset >= binData.size()) return nullptr;
-        return &binData[offset];
-    };
-
-    // ── Parse meshes — extract first primitive ──────────────────────────────
-    size_t meshesPos = JsonFindKey(json, 0, "meshes");
-    if (meshesPos == std::string::npos) {
-        GV_LOG_WARN("glTF loader — no meshes found: " + path);
-        return false;
-    }
-
-    size_t meshEs, meshEe;
-    if (!JsonArrayElement(json, meshesPos, 0, meshEs, meshEe)) {
-        GV_LOG_WARN("glTF loader — empty meshes array: " + path);
-        return false;
-    }
-
-    // Find "primitives" array in the first mesh
-    size_t primPos = JsonFindKey(json, meshEs, "primitives");
-    if (primPos == std::string::npos || primPos >= meshEe) {
-        GV_LOG_WARN("glTF loader — no primitives in mesh: " + path);
-        return false;
-    }
-
-    size_t primEs, primEe;
-    if (!JsonArrayElement(json, primPos, 0, primEs, primEe)) {
-        GV_LOG_WARN("glTF loader — empty primitives: " + path);
-        return false;
-    }
-
-    // Find attribute accessors
-    size_t attrPos = JsonFindKey(json, primEs, "attributes");
-    int posAccIdx   = -1;
-    int normAccIdx  = -1;
-    int uvAccIdx    = -1;
-    int idxAccIdx   = -1;
-
-    if (attrPos != std::string::npos && attrPos < primEe) {
-        size_t attrEnd = JsonFindMatchingEnd(json, attrPos);
-        posAccIdx  = JsonObjGetInt(json, attrPos, attrEnd, "POSITION", -1);
-        normAccIdx = JsonObjGetInt(json, attrPos, attrEnd, "NORMAL", -1);
-        uvAccIdx   = JsonObjGetInt(json, attrPos, attrEnd, "TEXCOORD_0", -1);
-    }
-    idxAccIdx = JsonObjGetInt(json, primEs, primEe, "indices", -1);
-
-    // ── Read position data ──────────────────────────────────────────────────
-    if (posAccIdx < 0 || posAccIdx >= static_cast<int>(accessors.size())) {
-        GV_LOG_WARN("glTF loader — no POSITION accessor: " + path);
-        return false;
-    }
-
-    int vertexCount = accessors[posAccIdx].count;
-    result.vertices.resize(vertexCount);
-    result.hasBones = false;
-
-    const u8* posPtr = getAccessorData(posAccIdx);
-    if (posPtr) {
-        auto& bv = bufferViews[accessors[posAccIdx].bufferView];
-        int stride = (bv.byteStride > 0) ? bv.byteStride : static_cast<int>(3 * sizeof(float));
-        for (int i = 0; i < vertexCount; ++i) {
-            const float* fp = reinterpret_cast<const float*>(posPtr + i * stride);
-            result.vertices[i].position = Vec3(fp[0], fp[1], fp[2]);
-        }
-    }
-
-    // ── Read normals ────────────────────────────────────────────────────────
-    if (normAccIdx >= 0 && normAccIdx < static_cast<int>(accessors.size())) {
-        const u8* normPtr = getAccessorData(normAccIdx);
-        if (normPtr) {
-            auto& bv = bufferViews[accessors[normAccIdx].bufferView];
-            int stride = (bv.byteStride > 0) ? bv.byteStride : static_cast<int>(3 * sizeof(float));
-            for (int i = 0; i < vertexCount; ++i) {
-                const float* fp = reinterpret_cast<const float*>(normPtr + i * stride);
-                result.vertices[i].normal = Vec3(fp[0], fp[1], fp[2]);
-            }
-        }
-    } else {
-        for (int i = 0; i < vertexCount; ++i)
-            result.vertices[i].normal = Vec3(0, 1, 0);
-    }
-
-    // ── Read texcoords ──────────────────────────────────────────────────────
-    if (uvAccIdx >= 0 && uvAccIdx < static_cast<int>(accessors.size())) {
-        const u8* uvPtr = getAccessorData(uvAccIdx);
-        if (uvPtr) {
-            auto& bv = bufferViews[accessors[uvAccIdx].bufferView];
-            int stride = (bv.byteStride > 0) ? bv.byteStride : static_cast<int>(2 * sizeof(float));
-            for (int i = 0; i < vertexCount; ++i) {
-                const float* fp = reinterpret_cast<const float*>(uvPtr + i * stride);
-                result.vertices[i].texCoord = Vec2(fp[0], fp[1]);
-            }
-        }
-    }
-
-    // ── Read indices ────────────────────────────────────────────────────────
-    if (idxAccIdx >= 0 && idxAccIdx < static_cast<int>(accessors.size())) {
-        auto& idxAcc = accessors[idxAccIdx];
-        const u8* idxPtr = getAccessorData(idxAccIdx);
-        if (idxPtr) {
-            result.indices.reserve(idxAcc.count);
-            for (int i = 0; i < idxAcc.count; ++i) {
-                u32 idx = 0;
-                switch (idxAcc.componentType) {
-                    case 5121: // UNSIGNED_BYTE
-                        idx = static_cast<u32>(idxPtr[i]);
-                        break;
-                    case 5123: // UNSIGNED_SHORT
-                        idx = static_cast<u32>(reinterpret_cast<const u16*>(idxPtr)[i]);
-                        break;
-                    case 5125: // UNSIGNED_INT
-                        idx = reinterpret_cast<const u32*>(idxPtr)[i];
-                        break;
-                    default:
-                        idx = static_cast<u32>(i);
-                        break;
-                }
-                result.indices.push_back(idx);
-            }
-        }
-    } else {
-        // No indices — generate sequential
-        for (int i = 0; i < vertexCount; ++i)
-            result.indices.push_back(static_cast<u32>(i));
-    }
-
-    // Compute normals if not provided
-    if (normAccIdx < 0) {
-        for (size_t i = 0; i + 2 < result.indices.size(); i += 3) {
-            u32 i0 = result.indices[i], i1 = result.indices[i+1], i2 = result.indices[i+2];
-            if (i0 < result.vertices.size() && i1 < result.vertices.size() && i2 < result.vertices.size()) {
-                Vec3 e1 = result.vertices[i1].position - result.vertices[i0].position;
-                Vec3 e2 = result.vertices[i2].position - result.vertices[i0].position;
-                Vec3 n = e1.Cross(e2).Normalized();
-                result.vertices[i0].normal = result.vertices[i1].normal = result.vertices[i2].normal = n;
-            }
-        }
-    }
-
-    GV_LOG_INFO("glTF loader — loaded " + std::to_string(vertexCount) +
-                " vertices, " + std::to_string(result.indices.size() / 3) +
-                " triangles from: " + path);
-    return true;
-}
-
 } // namespace gv
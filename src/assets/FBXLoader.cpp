@@ -0,0 +1,918 @@
+// ============================================================================
+// GameVoid Engine — Binary FBX Loader Implementation
+// ============================================================================
+#include "assets/FBXLoader.h"
+#include "assets/Assets.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <map>
+#include <unordered_map>
+
+namespace gv {
+
+// ============================================================================
+// Inflate (RFC 1950 zlib wrapper around RFC 1951 DEFLATE)
+// ============================================================================
+namespace {
+
+class BitReader {
+public:
+    BitReader(const u8* p, size_t n) : m_P(p), m_End(p + n) {}
+
+    void Refill() {
+        while (m_Count <= 56) {
+            if (m_P < m_End) m_Buf |= static_cast<u64>(*m_P++) << m_Count;
+            else             ++m_Overrun;   // zero padding past the end
+            m_Count += 8;
+        }
+    }
+    u32 Peek(int n) { if (m_Count < n) Refill(); return static_cast<u32>(m_Buf & ((1ull << n) - 1)); }
+    void Drop(int n) { m_Buf >>= n; m_Count -= n; }
+    u32 Bits(int n) { u32 v = Peek(n); Drop(n); return v; }
+
+    /// Discard to the next byte boundary and hand back whole buffered bytes
+    /// so stored blocks can be copied straight from the input.
+    void AlignToByte() {
+        Drop(m_Count & 7);
+        size_t buffered = static_cast<size_t>(m_Count / 8);
+        size_t real = buffered > m_Overrun ? buffered - m_Overrun : 0;
+        m_P -= real;
+        m_Overrun = 0;
+        m_Buf = 0;
+        m_Count = 0;
+    }
+    const u8* Ptr() const { return m_P; }
+    size_t Remaining() const { return static_cast<size_t>(m_End - m_P); }
+    void Skip(size_t n) { m_P += n; }
+    /// True if decoding consumed bits beyond the input.
+    bool Overrun() const { return m_Overrun * 8 > static_cast<size_t>(m_Count); }
+
+private:
+    const u8* m_P;
+    const u8* m_End;
+    u64       m_Buf = 0;
+    int       m_Count = 0;
+    size_t    m_Overrun = 0;
+};
+
+/// Canonical Huffman decoder: 10-bit lookup table, bit-by-bit fallback for
+/// longer codes.
+struct Huffman {
+    static constexpr int kFastBits = 10;
+    u16 counts[16] = {};
+    u16 symbols[320] = {};
+    u16 fast[1 << kFastBits] = {};   // (length << 9) | symbol, 0 = slow path
+
+    bool Build(const u8* lengths, int n) {
+        std::memset(counts, 0, sizeof(counts));
+        std::memset(fast, 0, sizeof(fast));
+        for (int i = 0; i < n; ++i) counts[lengths[i]]++;
+        counts[0] = 0;
+        int left = 1;
+        for (int len = 1; len < 16; ++len) {
+            left = (left << 1) - counts[len];
+            if (left < 0) return false;   // over-subscribed
+        }
+        u16 offs[16] = {};
+        for (int len = 1; len < 15; ++len) offs[len + 1] = static_cast<u16>(offs[len] + counts[len]);
+        for (int i = 0; i < n; ++i)
+            if (lengths[i]) symbols[offs[lengths[i]]++] = static_cast<u16>(i);
+
+        // Fast table: codes are assigned in canonical order, stored bit-reversed.
+        int code = 0, index = 0;
+        for (int len = 1; len <= kFastBits; ++len) {
+            for (int k = 0; k < counts[len]; ++k, ++code, ++index) {
+                u32 rev = 0;
+                for (int b = 0; b < len; ++b) rev |= ((code >> b) & 1u) << (len - 1 - b);
+                for (u32 f = rev; f < (1u << kFastBits); f += (1u << len))
+                    fast[f] = static_cast<u16>((len << 9) | symbols[index]);
+            }
+            code <<= 1;
+        }
+        return true;
+    }
+
+    int Decode(BitReader& br) const {
+        u16 e = fast[br.Peek(kFastBits)];
+        if (e) { br.Drop(e >> 9); return e & 0x1FF; }
+        int code = 0, first = 0, index = 0;
+        for (int len = 1; len < 16; ++len) {
+            code |= static_cast<int>(br.Bits(1));
+            int count = counts[len];
+            if (code - count < first) return symbols[index + (code - first)];
+            index += count;
+            first += count;
+            first <<= 1;
+            code <<= 1;
+        }
+        return -1;
+    }
+};
+
+const u16 kLenBase[29]  = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                            35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+const u8  kLenExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                            3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+const u16 kDistBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                            257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                            8193, 12289, 16385, 24577 };
+const u8  kDistExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                             7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+bool InflateBlock(BitReader& br, const Huffman& lit, const Huffman& dist,
+                  u8* dst, size_t dstSize, size_t& pos) {
+    for (;;) {
+        int sym = lit.Decode(br);
+        if (sym < 0) return false;
+        if (sym < 256) {
+            if (pos >= dstSize) return false;
+            dst[pos++] = static_cast<u8>(sym);
+        } else if (sym == 256) {
+            return !br.Overrun();
+        } else {
+            sym -= 257;
+            if (sym >= 29) return false;
+            size_t len = kLenBase[sym] + br.Bits(kLenExtra[sym]);
+            int ds = dist.Decode(br);
+            if (ds < 0 || ds >= 30) return false;
+            size_t d = kDistBase[ds] + br.Bits(kDistExtra[ds]);
+            if (d > pos || len > dstSize - pos) return false;
+            u8* out = dst + pos;
+            const u8* from = out - d;
+            if (d >= len) std::memcpy(out, from, len);
+            else {
+                // Overlapping run of period d: seed one period, then keep
+                // doubling the copied span (it stays a multiple of d).
+                std::memcpy(out, from, d);
+                for (size_t k = d; k < len; k += k) std::memcpy(out + k, out, std::min(k, len - k));
+            }
+            pos += len;
+        }
+        if (br.Overrun()) return false;
+    }
+}
+
+} // namespace
+
+bool InflateZlib(const u8* src, size_t srcSize, u8* dst, size_t dstSize) {
+    if (srcSize < 6) return false;
+    u8 cmf = src[0], flg = src[1];
+    if ((cmf & 0x0F) != 8 || ((cmf << 8) | flg) % 31 != 0 || (flg & 0x20)) return false;
+
+    BitReader br(src + 2, srcSize - 2);
+    size_t pos = 0;
+    Huffman lit, dist;
+    bool last = false;
+    while (!last) {
+        last = br.Bits(1) != 0;
+        u32 type = br.Bits(2);
+        if (type == 0) {
+            br.AlignToByte();
+            if (br.Remaining() < 4) return false;
+            const u8* p = br.Ptr();
+            u32 len = p[0] | (p[1] << 8), nlen = p[2] | (p[3] << 8);
+            if ((len ^ 0xFFFF) != nlen || br.Remaining() - 4 < len || len > dstSize - pos) return false;
+            std::memcpy(dst + pos, p + 4, len);
+            pos += len;
+            br.Skip(4 + len);
+        } else if (type == 1) {
+            u8 lengths[320];
+            std::memset(lengths, 8, 144);
+            std::memset(lengths + 144, 9, 112);
+            std::memset(lengths + 256, 7, 24);
+            std::memset(lengths + 280, 8, 8);
+            lit.Build(lengths, 288);
+            std::memset(lengths, 5, 30);
+            dist.Build(lengths, 30);
+            if (!InflateBlock(br, lit, dist, dst, dstSize, pos)) return false;
+        } else if (type == 2) {
+            static const u8 order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+            int hlit = static_cast<int>(br.Bits(5)) + 257;
+            int hdist = static_cast<int>(br.Bits(5)) + 1;
+            int hclen = static_cast<int>(br.Bits(4)) + 4;
+            if (hlit > 286 || hdist > 30) return false;
+            u8 cl[19] = {};
+            for (int i = 0; i < hclen; ++i) cl[order[i]] = static_cast<u8>(br.Bits(3));
+            Huffman clh;
+            if (!clh.Build(cl, 19)) return false;
+            u8 lengths[320] = {};
+            int n = 0;
+            while (n < hlit + hdist) {
+                int sym = clh.Decode(br);
+                if (sym < 0) return false;
+                if (sym < 16) { lengths[n++] = static_cast<u8>(sym); continue; }
+                int repeat;
+                u8 value = 0;
+                if (sym == 16) {
+                    if (n == 0) return false;
+                    value = lengths[n - 1];
+                    repeat = 3 + static_cast<int>(br.Bits(2));
+                } else if (sym == 17) {
+                    repeat = 3 + static_cast<int>(br.Bits(3));
+                } else {
+                    repeat = 11 + static_cast<int>(br.Bits(7));
+                }
+                if (n + repeat > hlit + hdist) return false;
+                while (repeat--) lengths[n++] = value;
+            }
+            if (lengths[256] == 0) return false;
+            if (!lit.Build(lengths, hlit) || !dist.Build(lengths + hlit, hdist)) return false;
+            if (!InflateBlock(br, lit, dist, dst, dstSize, pos)) return false;
+        } else {
+            return false;
+        }
+        if (br.Overrun()) return false;
+    }
+    if (pos != dstSize) return false;
+
+    // Adler-32 trailer (big-endian) follows the last block on a byte boundary.
+    br.AlignToByte();
+    if (br.Remaining() < 4) return false;
+    const u8* t = br.Ptr();
+    u32 expected = (static_cast<u32>(t[0]) << 24) | (t[1] << 16) | (t[2] << 8) | t[3];
+    u32 a = 1, b = 0;
+    for (size_t i = 0; i < dstSize;) {
+        size_t chunk = std::min<size_t>(dstSize - i, 5552);
+        for (size_t k = 0; k < chunk; ++k) { a += dst[i + k]; b += a; }
+        a %= 65521; b %= 65521;
+        i += chunk;
+    }
+    return ((b << 16) | a) == expected;
+}
+
+// ============================================================================
+// Properties
+// ============================================================================
+template <typename T>
+bool FBXProperty::ToVector(std::vector<T>& out) const {
+    out.clear();
+    if (!IsArray()) {
+        if (type == 'S' || type == 'R' || type == 0) return false;
+        out.push_back(static_cast<T>(AsNumber()));
+        return true;
+    }
+    size_t elem = (type == 'd' || type == 'l') ? 8 : (type == 'b') ? 1 : 4;
+    size_t raw = static_cast<size_t>(count) * elem;
+    const u8* src = data;
+    std::vector<u8> inflated;
+    if (encoding == 1) {
+        inflated.resize(raw);
+        if (!InflateZlib(data, bytes, inflated.data(), raw)) return false;
+        src = inflated.data();
+    } else if (encoding != 0 || bytes < raw) {
+        return false;
+    }
+
+    out.resize(count);
+    auto convert = [&](auto tag) {
+        using S = decltype(tag);
+        if (std::is_same<S, T>::value) {
+            std::memcpy(out.data(), src, raw);
+        } else {
+            for (u32 k = 0; k < count; ++k) {
+                S v;
+                std::memcpy(&v, src + k * sizeof(S), sizeof(S));
+                out[k] = static_cast<T>(v);
+            }
+        }
+    };
+    switch (type) {
+        case 'f': convert(f32{}); break;
+        case 'd': convert(f64{}); break;
+        case 'i': convert(i32{}); break;
+        case 'l': convert(i64{}); break;
+        case 'b': convert(u8{});  break;
+    }
+    return true;
+}
+
+template bool FBXProperty::ToVector<f32>(std::vector<f32>&) const;
+template bool FBXProperty::ToVector<f64>(std::vector<f64>&) const;
+template bool FBXProperty::ToVector<i32>(std::vector<i32>&) const;
+template bool FBXProperty::ToVector<i64>(std::vector<i64>&) const;
+
+// ============================================================================
+// FBXDocument — parsing
+// ============================================================================
+static const char kFBXMagic[] = "Kaydara FBX Binary  ";   // followed by 0x00 0x1A 0x00
+
+bool FBXDocument::IsBinaryFBX(const u8* data, size_t size) {
+    return size >= 27 && std::memcmp(data, kFBXMagic, 20) == 0 && data[20] == 0 && data[21] == 0x1A;
+}
+
+bool FBXDocument::Fail(const std::string& msg) {
+    m_Error = msg;
+    GV_LOG_WARN("FBX loader — " + msg);
+    return false;
+}
+
+bool FBXDocument::Load(const std::string& path) {
+    if (!m_File.Open(path)) return Fail("cannot open " + path);
+    if (!Parse(m_File.Data(), m_File.Size())) {
+        m_Error += " (" + path + ")";
+        return false;
+    }
+    return true;
+}
+
+bool FBXDocument::Parse(const u8* data, size_t size) {
+    m_Roots.clear();
+    m_Error.clear();
+    m_Data = data;
+    m_Size = size;
+    if (!data || !IsBinaryFBX(data, size)) return Fail("not a binary FBX file");
+    std::memcpy(&m_Version, data + 23, 4);
+    if (m_Version < 7000 || m_Version >= 8000) return Fail("unsupported FBX version " + std::to_string(m_Version));
+    size_t offset = 27;
+    return ParseNodeList(offset, size, m_Roots, 0);
+}
+
+bool FBXDocument::ParseNodeList(size_t& offset, size_t end, std::vector<FBXNode>& out, int depth) {
+    if (depth > 64) return Fail("node nesting too deep");
+    const bool wide = m_Version >= 7500;
+    const size_t headerSize = wide ? 25 : 13;
+    auto rd = [&](size_t at, size_t n) { u64 v = 0; std::memcpy(&v, m_Data + at, n); return v; };
+
+    while (offset + headerSize <= end) {
+        u64 endOffset  = wide ? rd(offset, 8)      : rd(offset, 4);
+        u64 numProps   = wide ? rd(offset + 8, 8)  : rd(offset + 4, 4);
+        u64 propLen    = wide ? rd(offset + 16, 8) : rd(offset + 8, 4);
+        u8  nameLen    = m_Data[offset + headerSize - 1];
+        if (endOffset == 0) { offset += headerSize; return true; }   // null record ends the list
+        if (endOffset > end || endOffset < offset + headerSize + nameLen + propLen)
+            return Fail("corrupt node record at byte " + std::to_string(offset));
+
+        FBXNode node;
+        size_t p = offset + headerSize;
+        node.name.assign(reinterpret_cast<const char*>(m_Data + p), nameLen);
+        p += nameLen;
+        size_t propsEnd = p + static_cast<size_t>(propLen);
+        node.props.reserve(static_cast<size_t>(std::min<u64>(numProps, 64)));
+        for (u64 k = 0; k < numProps; ++k) {
+            if (p >= propsEnd) return Fail("property list overruns node '" + node.name + "'");
+            FBXProperty prop;
+            prop.type = static_cast<char>(m_Data[p++]);
+            auto need = [&](size_t n) { return propsEnd - p >= n; };
+            switch (prop.type) {
+                case 'Y': if (!need(2)) return Fail("truncated property"); { i16 v; std::memcpy(&v, m_Data + p, 2); prop.i = v; } p += 2; break;
+                case 'C': if (!need(1)) return Fail("truncated property"); prop.i = m_Data[p]; p += 1; break;
+                case 'I': if (!need(4)) return Fail("truncated property"); { i32 v; std::memcpy(&v, m_Data + p, 4); prop.i = v; } p += 4; break;
+                case 'L': if (!need(8)) return Fail("truncated property"); std::memcpy(&prop.i, m_Data + p, 8); p += 8; break;
+                case 'F': if (!need(4)) return Fail("truncated property"); { f32 v; std::memcpy(&v, m_Data + p, 4); prop.d = v; } p += 4; break;
+                case 'D': if (!need(8)) return Fail("truncated property"); std::memcpy(&prop.d, m_Data + p, 8); p += 8; break;
+                case 'f': case 'd': case 'l': case 'i': case 'b': {
+                    if (!need(12)) return Fail("truncated array header");
+                    std::memcpy(&prop.count, m_Data + p, 4);
+                    std::memcpy(&prop.encoding, m_Data + p + 4, 4);
+                    std::memcpy(&prop.bytes, m_Data + p + 8, 4);
+                    p += 12;
+                    if (!need(prop.bytes)) return Fail("array overruns node '" + node.name + "'");
+                    prop.data = m_Data + p;
+                    p += prop.bytes;
+                    break;
+                }
+                case 'S': case 'R': {
+                    if (!need(4)) return Fail("truncated string");
+                    std::memcpy(&prop.bytes, m_Data + p, 4);
+                    p += 4;
+                    if (!need(prop.bytes)) return Fail("string overruns node '" + node.name + "'");
+                    prop.data = m_Data + p;
+                    p += prop.bytes;
+                    break;
+                }
+                default:
+                    return Fail(std::string("unknown property type '") + prop.type + "' in node '" + node.name + "'");
+            }
+            node.props.push_back(prop);
+        }
+        p = propsEnd;
+        if (p < endOffset) {
+            if (!ParseNodeList(p, static_cast<size_t>(endOffset), node.children, depth + 1)) return false;
+        }
+        offset = static_cast<size_t>(endOffset);
+        out.push_back(std::move(node));
+    }
+    return true;   // top level may end without a null record (footer follows)
+}
+
+const FBXNode* FBXDocument::FindRoot(const char* name) const {
+    for (auto& n : m_Roots) if (n.name == name) return &n;
+    return nullptr;
+}
+
+// ============================================================================
+// FBXDocument — scene extraction
+// ============================================================================
+namespace {
+
+/// "Name\0\1Class" → "Name".
+std::string ObjectName(const FBXNode& n) {
+    if (n.props.size() < 2 || !n.props[1].IsString()) return std::string();
+    std::string s = n.props[1].AsString();
+    size_t sep = s.find(std::string("\0\1", 2));
+    return sep == std::string::npos ? s : s.substr(0, sep);
+}
+
+std::string ObjectClass(const FBXNode& n) {
+    return n.props.size() >= 3 && n.props[2].IsString() ? n.props[2].AsString() : std::string();
+}
+
+/// Properties70 entry → up to three numbers.
+bool GetP70(const FBXNode& obj, const char* name, f64 out[3]) {
+    const FBXNode* p70 = obj.Find("Properties70");
+    if (!p70) return false;
+    for (auto& p : p70->children) {
+        if (p.name != "P" || p.props.empty() || p.props[0].AsString() != name) continue;
+        int k = 0;
+        for (size_t i = 4; i < p.props.size() && k < 3; ++i)
+            if (!p.props[i].IsString()) out[k++] = p.props[i].AsNumber();
+        return k > 0;
+    }
+    return false;
+}
+
+Vec3 GetP70Vec3(const FBXNode& obj, const char* name, const Vec3& def) {
+    f64 v[3] = { def.x, def.y, def.z };
+    if (!GetP70(obj, name, v)) return def;
+    return Vec3(static_cast<f32>(v[0]), static_cast<f32>(v[1]), static_cast<f32>(v[2]));
+}
+
+/// Euler degrees → quaternion for FBX rotation order `order`
+/// (0 XYZ, 1 XZY, 2 YZX, 3 YXZ, 4 ZXY, 5 ZYX; "XYZ" applies X first).
+Quaternion EulerToQuat(const Vec3& deg, int order) {
+    const f32 k = 3.14159265f / 180.0f;
+    Quaternion qx = Quaternion::FromAxisAngle(Vec3(1, 0, 0), deg.x * k);
+    Quaternion qy = Quaternion::FromAxisAngle(Vec3(0, 1, 0), deg.y * k);
+    Quaternion qz = Quaternion::FromAxisAngle(Vec3(0, 0, 1), deg.z * k);
+    switch (order) {
+        case 1:  return (qy * qz * qx).Normalized();
+        case 2:  return (qx * qz * qy).Normalized();
+        case 3:  return (qz * qx * qy).Normalized();
+        case 4:  return (qy * qx * qz).Normalized();
+        case 5:  return (qx * qy * qz).Normalized();
+        default: return (qz * qy * qx).Normalized();
+    }
+}
+
+Quaternion Conjugate(const Quaternion& q) { return { -q.x, -q.y, -q.z, q.w }; }
+
+struct ModelTRS {
+    Vec3       t { 0, 0, 0 };
+    Vec3       r { 0, 0, 0 };   // Euler degrees
+    Vec3       s { 1, 1, 1 };
+    Quaternion pre, post;
+    int        order = 0;
+
+    Quaternion Rotation(const Vec3& euler) const { return (pre * EulerToQuat(euler, order) * Conjugate(post)).Normalized(); }
+    Mat4 Local() const { return Mat4::Translate(t) * Rotation(r).ToMat4() * Mat4::Scale(s); }
+};
+
+ModelTRS ReadModelTRS(const FBXNode& model) {
+    ModelTRS m;
+    f64 v[3] = { 0, 0, 0 };
+    if (GetP70(model, "RotationOrder", v)) m.order = static_cast<int>(v[0]);
+    m.t = GetP70Vec3(model, "Lcl Translation", m.t);
+    m.r = GetP70Vec3(model, "Lcl Rotation", m.r);
+    m.s = GetP70Vec3(model, "Lcl Scaling", m.s);
+    m.pre  = EulerToQuat(GetP70Vec3(model, "PreRotation", Vec3(0, 0, 0)), 0);
+    m.post = EulerToQuat(GetP70Vec3(model, "PostRotation", Vec3(0, 0, 0)), 0);
+    return m;
+}
+
+Mat4 MatrixFromArray(const FBXNode* n) {
+    std::vector<f64> v;
+    if (!n || n->props.empty() || !n->props[0].ToVector(v) || v.size() != 16) return Mat4::Identity();
+    Mat4 m;
+    for (int i = 0; i < 16; ++i) m.m[i] = static_cast<f32>(v[i]);   // FBX matrices are column-major too
+    return m;
+}
+
+template <typename T>
+bool ChildArray(const FBXNode& n, const char* name, std::vector<T>& out) {
+    const FBXNode* c = n.Find(name);
+    return c && !c->props.empty() && c->props[0].ToVector(out);
+}
+
+std::string ChildString(const FBXNode& n, const char* name) {
+    const FBXNode* c = n.Find(name);
+    return c && !c->props.empty() ? c->props[0].AsString() : std::string();
+}
+
+/// Per-polygon-vertex lookup for a LayerElement.
+struct LayerMapping {
+    enum Mode { None, ByPolygonVertex, ByControlPoint, ByPolygon, AllSame } mode = None;
+    std::vector<i32> index;     // IndexToDirect
+    bool Indexed() const { return !index.empty(); }
+
+    void Init(const FBXNode& layer, const char* indexName) {
+        std::string m = ChildString(layer, "MappingInformationType");
+        std::string r = ChildString(layer, "ReferenceInformationType");
+        if (m == "ByPolygonVertex") mode = ByPolygonVertex;
+        else if (m == "ByVertice" || m == "ByVertex" || m == "ByControlPoint") mode = ByControlPoint;
+        else if (m == "ByPolygon") mode = ByPolygon;
+        else if (m == "AllSame") mode = AllSame;
+        if (r == "IndexToDirect" || r == "Index") ChildArray(layer, indexName, index);
+    }
+
+    /// Element index for polygon-vertex `pv` of polygon `poly` at control point `cp`.
+    i64 Lookup(size_t pv, size_t poly, u32 cp) const {
+        size_t i = 0;
+        switch (mode) {
+            case ByPolygonVertex: i = pv; break;
+            case ByControlPoint:  i = cp; break;
+            case ByPolygon:       i = poly; break;
+            case AllSame:         i = 0; break;
+            default:              return -1;
+        }
+        if (!Indexed()) return static_cast<i64>(i);
+        return i < index.size() ? index[i] : -1;
+    }
+};
+
+struct Influence { i32 bone; f32 weight; };
+
+} // namespace
+
+bool FBXDocument::Extract(FBXScene& out) const {
+    out = FBXScene();
+    out.version = m_Version;
+    const FBXNode* objects = FindRoot("Objects");
+    const FBXNode* connections = FindRoot("Connections");
+    if (!objects) return false;
+
+    // ── Object table and connection graph ─────────────────────────────────
+    std::unordered_map<i64, const FBXNode*> byId;
+    for (auto& o : objects->children)
+        if (!o.props.empty() && o.props[0].type == 'L') byId[o.props[0].i] = &o;
+
+    struct Link { i64 other; std::string prop; };
+    std::unordered_map<i64, std::vector<Link>> childrenOf, parentsOf;
+    if (connections) {
+        for (auto& c : connections->children) {
+            if (c.name != "C" || c.props.size() < 3) continue;
+            i64 child = c.props[1].i, parent = c.props[2].i;
+            std::string prop = c.props.size() > 3 ? c.props[3].AsString() : std::string();
+            childrenOf[parent].push_back({ child, prop });
+            parentsOf[child].push_back({ parent, prop });
+        }
+    }
+    auto nodeOf = [&](i64 id) -> const FBXNode* { auto it = byId.find(id); return it == byId.end() ? nullptr : it->second; };
+    auto parentModel = [&](i64 id) -> i64 {
+        auto it = parentsOf.find(id);
+        if (it == parentsOf.end()) return 0;
+        for (auto& l : it->second) {
+            const FBXNode* n = nodeOf(l.other);
+            if (n && n->name == "Model") return l.other;
+        }
+        return 0;
+    };
+    std::unordered_map<i64, Mat4> worldCache;
+    std::function<Mat4(i64)> modelWorld = [&](i64 id) -> Mat4 {
+        auto it = worldCache.find(id);
+        if (it != worldCache.end()) return it->second;
+        const FBXNode* n = nodeOf(id);
+        Mat4 local = n ? ReadModelTRS(*n).Local() : Mat4::Identity();
+        i64 parent = parentModel(id);
+        worldCache[id] = Mat4::Identity();   // cycle guard
+        Mat4 w = parent ? modelWorld(parent) * local : local;
+        worldCache[id] = w;
+        return w;
+    };
+
+    // ── Materials ─────────────────────────────────────────────────────────
+    std::unordered_map<i64, i32> materialIndex;
+    for (auto& o : objects->children) {
+        if (o.name != "Material" || o.props.empty()) continue;
+        FBXMaterial m;
+        m.name = ObjectName(o);
+        m.diffuse = GetP70Vec3(o, "DiffuseColor", GetP70Vec3(o, "Diffuse", m.diffuse));
+        m.emissive = GetP70Vec3(o, "EmissiveColor", m.emissive);
+        f64 v[3];
+        if (GetP70(o, "Opacity", v)) m.opacity = static_cast<f32>(v[0]);
+        else if (GetP70(o, "TransparencyFactor", v)) m.opacity = 1.0f - static_cast<f32>(v[0]);
+        for (auto& l : childrenOf[o.props[0].i]) {
+            const FBXNode* tex = nodeOf(l.other);
+            if (!tex || tex->name != "Texture" || (l.prop != "DiffuseColor" && l.prop != "Diffuse")) continue;
+            m.diffuseTexture = ChildString(*tex, "RelativeFilename");
+            if (m.diffuseTexture.empty()) m.diffuseTexture = ChildString(*tex, "FileName");
+        }
+        materialIndex[o.props[0].i] = static_cast<i32>(out.materials.size());
+        out.materials.push_back(std::move(m));
+    }
+
+    // ── Skeleton: every model linked from a skin cluster, parents first ────
+    struct ClusterInfo { i64 bone; Mat4 transform, transformLink; std::vector<i32> indexes; std::vector<f64> weights; };
+    std::unordered_map<i64, std::vector<ClusterInfo>> clustersOfGeometry;
+    std::vector<i64> boneModels;
+    for (auto& o : objects->children) {
+        if (o.name != "Deformer" || ObjectClass(o) != "Skin") continue;
+        i64 skinId = o.props[0].i;
+        i64 geometry = 0;
+        for (auto& l : parentsOf[skinId]) {
+            const FBXNode* g = nodeOf(l.other);
+            if (g && g->name == "Geometry") geometry = l.other;
+        }
+        for (auto& l : childrenOf[skinId]) {
+            const FBXNode* cl = nodeOf(l.other);
+            if (!cl || cl->name != "Deformer" || ObjectClass(*cl) != "Cluster") continue;
+            ClusterInfo ci;
+            ci.bone = 0;
+            for (auto& bl : childrenOf[l.other]) {
+                const FBXNode* b = nodeOf(bl.other);
+                if (b && b->name == "Model") ci.bone = bl.other;
+            }
+            if (!ci.bone) continue;
+            ChildArray(*cl, "Indexes", ci.indexes);
+            ChildArray(*cl, "Weights", ci.weights);
+            ci.transform = MatrixFromArray(cl->Find("Transform"));
+            ci.transformLink = MatrixFromArray(cl->Find("TransformLink"));
+            if (std::find(boneModels.begin(), boneModels.end(), ci.bone) == boneModels.end())
+                boneModels.push_back(ci.bone);
+            clustersOfGeometry[geometry].push_back(std::move(ci));
+        }
+    }
+
+    std::unordered_map<i64, i32> boneIndex;
+    std::vector<ModelTRS> boneTRS;
+    if (!boneModels.empty()) {
+        auto depthOf = [&](i64 id) { int d = 0; for (i64 p = parentModel(id); p && d < 256; p = parentModel(p)) ++d; return d; };
+        std::stable_sort(boneModels.begin(), boneModels.end(),
+                         [&](i64 a, i64 b) { return depthOf(a) < depthOf(b); });
+        if (boneModels.size() > Skeleton::MAX_BONES)
+            GV_LOG_WARN("FBX loader — " + std::to_string(boneModels.size()) + " bones; the skinning shader uses the first " +
+                        std::to_string(Skeleton::MAX_BONES));
+        out.skeleton = MakeShared<Skeleton>("FBXSkeleton");
+        for (i64 id : boneModels) {
+            const FBXNode* n = nodeOf(id);
+            i32 parent = -1;
+            for (i64 p = parentModel(id); p && parent < 0; p = parentModel(p)) {
+                auto it = boneIndex.find(p);
+                if (it != boneIndex.end()) parent = it->second;
+            }
+            std::string name = n ? ObjectName(*n) : std::string();
+            if (name.empty() || out.skeleton->FindBoneIndex(name) >= 0) name += "#" + std::to_string(id);
+            i32 bi = out.skeleton->AddBone(name, parent, Mat4::Identity());
+            ModelTRS trs = n ? ReadModelTRS(*n) : ModelTRS();
+            Bone& b = out.skeleton->GetBone(bi);
+            b.localPosition = trs.t;
+            b.localRotation = trs.Rotation(trs.r);
+            b.localScale    = trs.s;
+            boneIndex[id] = bi;
+            boneTRS.push_back(trs);
+        }
+    }
+
+    // ── Geometry ──────────────────────────────────────────────────────────
+    bool skeletonRootSet = false;
+    for (auto& o : objects->children) {
+        if (o.name != "Geometry" || ObjectClass(o) != "Mesh") continue;
+        i64 geomId = o.props[0].i;
+        std::vector<f64> cps;
+        std::vector<i32> pvi;
+        if (!ChildArray(o, "Vertices", cps) || !ChildArray(o, "PolygonVertexIndex", pvi) || cps.size() < 3) continue;
+        const u32 cpCount = static_cast<u32>(cps.size() / 3);
+
+        // Layer 0 normals / UVs / materials.
+        std::vector<f64> normals, uvs;
+        std::vector<i32> polyMaterials;
+        LayerMapping nMap, uvMap, matMap;
+        if (const FBXNode* l = o.Find("LayerElementNormal")) { ChildArray(*l, "Normals", normals); nMap.Init(*l, "NormalsIndex"); }
+        if (const FBXNode* l = o.Find("LayerElementUV"))     { ChildArray(*l, "UV", uvs);           uvMap.Init(*l, "UVIndex"); }
+        if (const FBXNode* l = o.Find("LayerElementMaterial")) { ChildArray(*l, "Materials", polyMaterials); matMap.Init(*l, ""); }
+
+        // Owning model, its world transform and material slots.
+        i64 modelId = 0;
+        for (auto& l : parentsOf[geomId]) {
+            const FBXNode* m = nodeOf(l.other);
+            if (m && m->name == "Model") { modelId = l.other; break; }
+        }
+        const FBXNode* model = nodeOf(modelId);
+        std::vector<i32> slots;
+        if (modelId)
+            for (auto& l : childrenOf[modelId]) {
+                auto it = materialIndex.find(l.other);
+                if (it != materialIndex.end()) slots.push_back(it->second);
+            }
+        Mat4 geometric = Mat4::Identity();
+        if (model) {
+            Vec3 gt = GetP70Vec3(*model, "GeometricTranslation", Vec3(0, 0, 0));
+            Vec3 gr = GetP70Vec3(*model, "GeometricRotation", Vec3(0, 0, 0));
+            Vec3 gs = GetP70Vec3(*model, "GeometricScaling", Vec3(1, 1, 1));
+            geometric = Mat4::Translate(gt) * EulerToQuat(gr, 0).ToMat4() * Mat4::Scale(gs);
+        }
+
+        // Skin influences per control point.
+        std::vector<std::vector<Influence>> influences;
+        auto clusters = clustersOfGeometry.find(geomId);
+        bool skinned = clusters != clustersOfGeometry.end() && out.skeleton;
+        if (skinned) {
+            influences.resize(cpCount);
+            for (auto& ci : clusters->second) {
+                i32 bi = boneIndex[ci.bone];
+                out.skeleton->GetBone(bi).offsetMatrix = ci.transformLink.Inverse() * ci.transform;
+                for (size_t k = 0; k < ci.indexes.size() && k < ci.weights.size(); ++k) {
+                    i32 cp = ci.indexes[k];
+                    if (cp >= 0 && static_cast<u32>(cp) < cpCount && ci.weights[k] > 0.0)
+                        influences[cp].push_back({ bi, static_cast<f32>(ci.weights[k]) });
+                }
+            }
+            if (!skeletonRootSet) {
+                // Bone globals start at the root bone; put back what sits above
+                // it and undo the mesh's own world transform (the renderer
+                // applies it as the model matrix).
+                skeletonRootSet = true;
+                i64 rootParent = parentModel(boneModels.front());
+                Mat4 above = rootParent ? modelWorld(rootParent) : Mat4::Identity();
+                Mat4 meshWorld = modelId ? modelWorld(modelId) : Mat4::Identity();
+                out.skeleton->SetGlobalInverseTransform(meshWorld.Inverse() * above);
+            }
+        }
+
+        FBXMesh mesh;
+        mesh.name = model ? ObjectName(*model) : ObjectName(o);
+        mesh.worldTransform = modelId ? modelWorld(modelId) : Mat4::Identity();
+        mesh.skinned = skinned;
+        mesh.vertices.reserve(pvi.size());
+
+        // Triangles per material slot, then concatenated into sub-meshes.
+        std::map<i32, std::vector<u32>> bySlot;
+        size_t polyStart = 0, poly = 0;
+        for (size_t pv = 0; pv < pvi.size(); ++pv) {
+            if (pvi[pv] >= 0) continue;
+            // Polygon [polyStart, pv]; the last index is stored as ~index.
+            size_t first = mesh.vertices.size();
+            for (size_t k = polyStart; k <= pv; ++k) {
+                i32 raw = pvi[k];
+                u32 cp = static_cast<u32>(raw < 0 ? ~raw : raw);
+                SkinnedVertex v;
+                if (cp < cpCount) {
+                    Vec3 p(static_cast<f32>(cps[cp * 3]), static_cast<f32>(cps[cp * 3 + 1]), static_cast<f32>(cps[cp * 3 + 2]));
+                    const f32* g = geometric.m;
+                    v.position = Vec3(g[0] * p.x + g[4] * p.y + g[8] * p.z + g[12],
+                                      g[1] * p.x + g[5] * p.y + g[9] * p.z + g[13],
+                                      g[2] * p.x + g[6] * p.y + g[10] * p.z + g[14]);
+                }
+                i64 ni = nMap.Lookup(k, poly, cp);
+                if (ni >= 0 && static_cast<size_t>(ni) * 3 + 2 < normals.size()) {
+                    Vec3 n(static_cast<f32>(normals[ni * 3]), static_cast<f32>(normals[ni * 3 + 1]), static_cast<f32>(normals[ni * 3 + 2]));
+                    const f32* g = geometric.m;
+                    v.normal = Vec3(g[0] * n.x + g[4] * n.y + g[8] * n.z,
+                                    g[1] * n.x + g[5] * n.y + g[9] * n.z,
+                                    g[2] * n.x + g[6] * n.y + g[10] * n.z).Normalized();
+                }
+                i64 ui = uvMap.Lookup(k, poly, cp);
+                if (ui >= 0 && static_cast<size_t>(ui) * 2 + 1 < uvs.size())
+                    v.texCoord = Vec2(static_cast<f32>(uvs[ui * 2]), static_cast<f32>(uvs[ui * 2 + 1]));
+                if (skinned && cp < cpCount) {
+                    auto& inf = influences[cp];
+                    std::partial_sort(inf.begin(), inf.begin() + std::min<size_t>(4, inf.size()), inf.end(),
+                                      [](const Influence& a, const Influence& b) { return a.weight > b.weight; });
+                    f32 sum = 0.0f;
+                    for (size_t w = 0; w < inf.size() && w < 4; ++w) sum += inf[w].weight;
+                    for (size_t w = 0; w < inf.size() && w < 4; ++w) {
+                        v.boneIDs[w] = inf[w].bone;
+                        v.boneWeights[w] = sum > 0.0f ? inf[w].weight / sum : 0.0f;
+                    }
+                }
+                mesh.vertices.push_back(v);
+            }
+            size_t count = mesh.vertices.size() - first;
+            bool computeNormal = normals.empty() || nMap.mode == LayerMapping::None;
+            if (computeNormal && count >= 3) {
+                Vec3 fn = (mesh.vertices[first + 1].position - mesh.vertices[first].position)
+                          .Cross(mesh.vertices[first + 2].position - mesh.vertices[first].position).Normalized();
+                for (size_t k = first; k < first + count; ++k) mesh.vertices[k].normal = fn;
+            }
+            i32 slot = 0;
+            if (!polyMaterials.empty()) {
+                size_t mi = (matMap.mode == LayerMapping::AllSame) ? 0 : poly;
+                slot = mi < polyMaterials.size() ? polyMaterials[mi] : 0;
+            }
+            auto& tri = bySlot[slot];
+            for (size_t k = 1; k + 1 < count; ++k) {
+                tri.push_back(static_cast<u32>(first));
+                tri.push_back(static_cast<u32>(first + k));
+                tri.push_back(static_cast<u32>(first + k + 1));
+            }
+            polyStart = pv + 1;
+            ++poly;
+        }
+
+        for (auto& kv : bySlot) {
+            FBXSubMesh sm;
+            sm.material = (kv.first >= 0 && kv.first < static_cast<i32>(slots.size())) ? slots[kv.first] : -1;
+            sm.firstIndex = static_cast<u32>(mesh.indices.size());
+            sm.indexCount = static_cast<u32>(kv.second.size());
+            mesh.indices.insert(mesh.indices.end(), kv.second.begin(), kv.second.end());
+            mesh.subMeshes.push_back(sm);
+        }
+        if (!mesh.indices.empty()) out.meshes.push_back(std::move(mesh));
+    }
+    if (out.skeleton) out.skeleton->ComputeGlobalTransforms();
+
+    // ── Animation: one clip per stack, bone curves of its first layer ──────
+    const f64 kTicksPerSecond = 46186158000.0;
+    for (auto& o : objects->children) {
+        if (o.name != "AnimationStack" || boneModels.empty()) continue;
+        i64 layer = 0;
+        for (auto& l : childrenOf[o.props[0].i]) {
+            const FBXNode* n = nodeOf(l.other);
+            if (n && n->name == "AnimationLayer") { layer = l.other; break; }
+        }
+        if (!layer) continue;
+
+        struct Curve { std::vector<f64> times; std::vector<f32> values; };
+        struct BoneCurves { const Curve* c[3][3] = {}; };   // [T,R,S][x,y,z]
+        std::deque<Curve> curves;   // stable addresses for BoneCurves
+        std::map<i32, BoneCurves> perBone;
+        f64 duration = 0.0;
+        for (auto& l : childrenOf[layer]) {
+            const FBXNode* cn = nodeOf(l.other);
+            if (!cn || cn->name != "AnimationCurveNode") continue;
+            int channel = -1;
+            i32 bone = -1;
+            for (auto& pl : parentsOf[l.other]) {
+                auto it = boneIndex.find(pl.other);
+                if (it == boneIndex.end()) continue;
+                if (pl.prop == "Lcl Translation") channel = 0;
+                else if (pl.prop == "Lcl Rotation") channel = 1;
+                else if (pl.prop == "Lcl Scaling") channel = 2;
+                bone = it->second;
+            }
+            if (channel < 0 || bone < 0) continue;
+            for (auto& cl : childrenOf[l.other]) {
+                const FBXNode* curve = nodeOf(cl.other);
+                if (!curve || curve->name != "AnimationCurve") continue;
+                int axis = (cl.prop == "d|X") ? 0 : (cl.prop == "d|Y") ? 1 : (cl.prop == "d|Z") ? 2 : -1;
+                if (axis < 0) continue;
+                Curve c;
+                std::vector<i64> ticks;
+                if (!ChildArray(*curve, "KeyTime", ticks) || !ChildArray(*curve, "KeyValueFloat", c.values) ||
+                    ticks.empty() || ticks.size() != c.values.size())
+                    continue;
+                c.times.resize(ticks.size());
+                for (size_t k = 0; k < ticks.size(); ++k) c.times[k] = static_cast<f64>(ticks[k]) / kTicksPerSecond;
+                duration = std::max(duration, c.times.back());
+                curves.push_back(std::move(c));
+                perBone[bone].c[channel][axis] = &curves.back();
+            }
+        }
+        if (perBone.empty()) continue;
+
+        auto sample = [](const Curve* c, f64 t, f32 def) -> f32 {
+            if (!c) return def;
+            if (t <= c->times.front()) return c->values.front();
+            if (t >= c->times.back()) return c->values.back();
+            size_t k = static_cast<size_t>(std::upper_bound(c->times.begin(), c->times.end(), t) - c->times.begin()) - 1;
+            f64 u = (t - c->times[k]) / (c->times[k + 1] - c->times[k]);
+            return static_cast<f32>(c->values[k] + (c->values[k + 1] - c->values[k]) * u);
+        };
+
+        SkeletalAnimClip clip;
+        std::string stackName = ObjectName(o);
+        clip.SetName(stackName.empty() ? "Take " + std::to_string(out.animations.size()) : stackName);
+        for (auto& kv : perBone) {
+            const ModelTRS& rest = boneTRS[kv.first];
+            std::vector<f64> times;
+            for (auto& ch : kv.second.c)
+                for (const Curve* c : ch)
+                    if (c) times.insert(times.end(), c->times.begin(), c->times.end());
+            std::sort(times.begin(), times.end());
+            times.erase(std::unique(times.begin(), times.end()), times.end());
+
+            BoneChannel channel;
+            channel.boneIndex = kv.first;
+            channel.boneName = out.skeleton->GetBone(kv.first).name;
+            channel.keyframes.reserve(times.size());
+            const auto& c = kv.second.c;
+            for (f64 t : times) {
+                BoneKeyframe key;
+                key.time = static_cast<f32>(t);
+                key.position = Vec3(sample(c[0][0], t, rest.t.x), sample(c[0][1], t, rest.t.y), sample(c[0][2], t, rest.t.z));
+                key.rotation = rest.Rotation(Vec3(sample(c[1][0], t, rest.r.x), sample(c[1][1], t, rest.r.y), sample(c[1][2], t, rest.r.z)));
+                key.scale    = Vec3(sample(c[2][0], t, rest.s.x), sample(c[2][1], t, rest.s.y), sample(c[2][2], t, rest.s.z));
+                channel.keyframes.push_back(key);
+            }
+            clip.AddChannel(channel);
+        }
+        clip.SetDuration(static_cast<f32>(duration));
+        clip.SetLooping(true);
+        out.animations.push_back(std::move(clip));
+    }
+    return true;
+}
+
+bool LoadFBXBinary(const std::string& path, FBXScene& out) {
+    FBXDocument doc;
+    if (!doc.Load(path)) return false;
+    if (!doc.Extract(out)) {
+        GV_LOG_WARN("FBX loader — no Objects section in: " + path);
+        return false;
+    }
+    return true;
+}
+
+} // namespace gv
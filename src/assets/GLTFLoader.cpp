@@ -0,0 +1,1674 @@
+// ============================================================================
+// GameVoid Engine — glTF 2.0 Loader Implementation
+// ============================================================================
+#include "assets/GLTFLoader.h"
+#include "assets/Assets.h"
+#include "core/Scene.h"
+#include "core/GameObject.h"
+#include "renderer/MeshRenderer.h"
+#include "renderer/MaterialComponent.h"
+#include "animation/Animation.h"
+#include "animation/SkeletalAnimation.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+
+namespace gv {
+
+namespace {
+
+// ============================================================================
+// JSON pull parser
+// ============================================================================
+// Reads values in document order without building a tree.  The caller
+// drives it: BeginObject/NextKey and BeginArray/NextElement walk containers,
+// the typed readers consume scalars and Skip() discards whatever is next.
+// Any syntax error latches Ok() to false and makes every later call fail,
+// so loops written as `while (r.NextKey(k))` always terminate.
+class JsonReader {
+public:
+    JsonReader(const char* data, size_t size) : m_Begin(data), m_P(data), m_End(data + size) {
+        if (size >= 3 && static_cast<u8>(data[0]) == 0xEF &&
+            static_cast<u8>(data[1]) == 0xBB && static_cast<u8>(data[2]) == 0xBF)
+            m_P += 3;   // UTF-8 BOM
+    }
+
+    bool   Ok() const       { return !m_Failed; }
+    size_t Position() const { return static_cast<size_t>(m_P - m_Begin); }
+
+    char Peek() {
+        while (m_P < m_End && (*m_P == ' ' || *m_P == '\t' || *m_P == '\n' || *m_P == '\r')) ++m_P;
+        return (m_P < m_End && !m_Failed) ? *m_P : '\0';
+    }
+
+    bool BeginObject() { return Open('{'); }
+    bool BeginArray()  { return Open('['); }
+
+    /// Next member of the current object; false (and the object is closed)
+    /// at '}'.
+    bool NextKey(std::string& key) {
+        if (!Advance('}')) return false;
+        if (!ReadString(key) || Peek() != ':') return Error();
+        ++m_P;
+        return true;
+    }
+
+    /// True if another element follows in the current array.
+    bool NextElement() { return Advance(']'); }
+
+    f64 Number() {
+        char buf[64];
+        size_t n = 0;
+        Peek();
+        while (m_P < m_End && n + 1 < sizeof(buf) &&
+               ((*m_P >= '0' && *m_P <= '9') || *m_P == '-' || *m_P == '+' ||
+                *m_P == '.' || *m_P == 'e' || *m_P == 'E'))
+            buf[n++] = *m_P++;
+        buf[n] = '\0';
+        char* end = nullptr;
+        f64 v = std::strtod(buf, &end);
+        if (n == 0 || end != buf + n) { Error(); return 0.0; }
+        return v;
+    }
+    i32 Int() { return static_cast<i32>(Number()); }
+    f32 Float() { return static_cast<f32>(Number()); }
+
+    bool Bool() {
+        char c = Peek();
+        if (c == 't' && Literal("true"))  return true;
+        if (c == 'f' && Literal("false")) return false;
+        Error();
+        return false;
+    }
+
+    std::string String() {
+        std::string s;
+        if (!ReadString(s)) Error();
+        return s;
+    }
+
+    void Skip() {
+        std::string tmp;
+        switch (Peek()) {
+            case '{': if (BeginObject()) while (NextKey(tmp)) Skip(); break;
+            case '[': if (BeginArray())  while (NextElement()) Skip(); break;
+            case '"': if (!ReadString(tmp)) Error(); break;
+            case 't': if (!Literal("true"))  Error(); break;
+            case 'f': if (!Literal("false")) Error(); break;
+            case 'n': if (!Literal("null"))  Error(); break;
+            default:  Number(); break;
+        }
+    }
+
+private:
+    bool Error() { m_Failed = true; return false; }
+
+    bool Open(char c) {
+        if (Peek() != c) return Error();
+        ++m_P;
+        m_First.push_back(true);
+        return true;
+    }
+
+    bool Advance(char close) {
+        if (m_Failed || m_First.empty()) return false;
+        char c = Peek();
+        if (c == close) { ++m_P; m_First.pop_back(); return false; }
+        if (!m_First.back()) {
+            if (c != ',') return Error();
+            ++m_P;
+            if (Peek() == close) return Error();   // trailing comma
+        }
+        m_First.back() = false;
+        return !m_Failed;
+    }
+
+    bool Literal(const char* lit) {
+        size_t n = std::strlen(lit);
+        if (static_cast<size_t>(m_End - m_P) < n || std::memcmp(m_P, lit, n) != 0) return false;
+        m_P += n;
+        return true;
+    }
+
+    static void AppendUTF8(std::string& out, u32 cp) {
+        if (cp < 0x80) { out += static_cast<char>(cp); }
+        else if (cp < 0x800) {
+            out += static_cast<char>(0xC0 | (cp >> 6));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            out += static_cast<char>(0xE0 | (cp >> 12));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (cp >> 18));
+            out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    }
+
+    bool Hex4(u32& out) {
+        if (m_End - m_P < 4) return false;
+        out = 0;
+        for (int i = 0; i < 4; ++i) {
+            char c = *m_P++;
+            out <<= 4;
+            if (c >= '0' && c <= '9')      out |= static_cast<u32>(c - '0');
+            else if (c >= 'a' && c <= 'f') out |= static_cast<u32>(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') out |= static_cast<u32>(c - 'A' + 10);
+            else return false;
+        }
+        return true;
+    }
+
+    bool ReadString(std::string& out) {
+        out.clear();
+        if (Peek() != '"') return false;
+        ++m_P;
+        while (m_P < m_End) {
+            // Copy the run up to the next quote, escape or control character.
+            const char* run = m_P;
+            while (m_P < m_End && *m_P != '"' && *m_P != '\\' && static_cast<u8>(*m_P) >= 0x20) ++m_P;
+            out.append(run, static_cast<size_t>(m_P - run));
+            if (m_P >= m_End) return false;
+            char c = *m_P++;
+            if (c == '"') return true;
+            if (c != '\\' || m_P >= m_End) return false;   // raw control character
+            char e = *m_P++;
+            switch (e) {
+                case '"':  out += '"';  break;
+                case '\\': out += '\\'; break;
+                case '/':  out += '/';  break;
+                case 'b':  out += '\b'; break;
+                case 'f':  out += '\f'; break;
+                case 'n':  out += '\n'; break;
+                case 'r':  out += '\r'; break;
+                case 't':  out += '\t'; break;
+                case 'u': {
+                    u32 cp;
+                    if (!Hex4(cp)) return false;
+                    if (cp >= 0xD800 && cp < 0xDC00) {
+                        u32 lo;
+                        if (m_End - m_P < 2 || m_P[0] != '\\' || m_P[1] != 'u') return false;
+                        m_P += 2;
+                        if (!Hex4(lo) || lo < 0xDC00 || lo > 0xDFFF) return false;
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                    }
+                    AppendUTF8(out, cp);
+                    break;
+                }
+                default: return false;
+            }
+        }
+        return false;
+    }
+
+    const char*       m_Begin;
+    const char*       m_P;
+    const char*       m_End;
+    std::vector<bool> m_First;   // per open container: no element read yet
+    bool              m_Failed = false;
+};
+
+template <typename Fn>
+void ReadObject(JsonReader& r, Fn&& fn) {
+    std::string key;
+    if (!r.BeginObject()) return;
+    while (r.NextKey(key)) fn(key);
+}
+
+template <typename Fn>
+void ReadArray(JsonReader& r, Fn&& fn) {
+    if (!r.BeginArray()) return;
+    while (r.NextElement()) fn();
+}
+
+void ReadFloatArray(JsonReader& r, std::vector<f32>& out) {
+    out.clear();
+    ReadArray(r, [&] { out.push_back(r.Float()); });
+}
+
+void ReadIntArray(JsonReader& r, std::vector<i32>& out) {
+    out.clear();
+    ReadArray(r, [&] { out.push_back(r.Int()); });
+}
+
+i32 ReadTextureRef(JsonReader& r) {
+    i32 index = -1;
+    ReadObject(r, [&](const std::string& k) {
+        if (k == "index") index = r.Int(); else r.Skip();
+    });
+    return index;
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+bool DecodeBase64(const char* s, size_t n, std::vector<u8>& out) {
+    auto val = [](char c) -> i32 {
+        if (c >= 'A' && c <= 'Z') return c - 'A';
+        if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+        if (c >= '0' && c <= '9') return c - '0' + 52;
+        if (c == '+' || c == '-') return 62;
+        if (c == '/' || c == '_') return 63;
+        return -1;
+    };
+    out.clear();
+    out.reserve(n / 4 * 3);
+    u32 acc = 0;
+    int bits = 0;
+    for (size_t i = 0; i < n; ++i) {
+        char c = s[i];
+        if (c == '=') break;
+        if (c == ' ' || c == '\n' || c == '\r' || c == '\t') continue;
+        i32 v = val(c);
+        if (v < 0) return false;
+        acc = (acc << 6) | static_cast<u32>(v);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out.push_back(static_cast<u8>((acc >> bits) & 0xFF));
+        }
+    }
+    return true;
+}
+
+std::string DecodeURI(const std::string& uri) {
+    std::string out;
+    out.reserve(uri.size());
+    for (size_t i = 0; i < uri.size(); ++i) {
+        if (uri[i] == '%' && i + 2 < uri.size()) {
+            char hex[3] = { uri[i + 1], uri[i + 2], 0 };
+            char* end = nullptr;
+            long v = std::strtol(hex, &end, 16);
+            if (end == hex + 2) { out += static_cast<char>(v); i += 2; continue; }
+        }
+        out += uri[i];
+    }
+    return out;
+}
+
+u32 ComponentSize(u32 type) {
+    switch (type) {
+        case GLTFAccessor::Byte: case GLTFAccessor::UnsignedByte:   return 1;
+        case GLTFAccessor::Short: case GLTFAccessor::UnsignedShort: return 2;
+        case GLTFAccessor::UnsignedInt: case GLTFAccessor::Float:   return 4;
+        default: return 0;
+    }
+}
+
+/// Element layout: component byte offsets and element size.  Matrix columns
+/// start on 4-byte boundaries (MAT2/MAT3 of bytes or shorts are padded).
+size_t ElementLayout(const GLTFAccessor& acc, u32 offsets[16]) {
+    u32 cs = ComponentSize(acc.componentType);
+    if (acc.rows > 1) {
+        u32 colStride = (acc.rows * cs + 3u) & ~3u;
+        for (u32 c = 0; c < acc.components; ++c)
+            offsets[c] = (c / acc.rows) * colStride + (c % acc.rows) * cs;
+        return static_cast<size_t>(colStride) * (acc.components / acc.rows);
+    }
+    for (u32 c = 0; c < acc.components; ++c) offsets[c] = c * cs;
+    return static_cast<size_t>(cs) * acc.components;
+}
+
+/// Byte range [offset, offset+bytes) of a buffer view, or null if it
+/// doesn't fit.
+const u8* ViewBytes(const GLTFDocument& doc, i32 view, size_t offset, size_t bytes) {
+    if (view < 0 || view >= static_cast<i32>(doc.bufferViews.size())) return nullptr;
+    const GLTFBufferView& bv = doc.bufferViews[view];
+    if (bv.buffer < 0 || bv.buffer >= static_cast<i32>(doc.buffers.size())) return nullptr;
+    const GLTFBuffer& buf = doc.buffers[bv.buffer];
+    if (!buf.data || bv.offset > buf.size || bv.length > buf.size - bv.offset) return nullptr;
+    if (offset > bv.length || bytes > bv.length - offset) return nullptr;
+    return buf.data + bv.offset + offset;
+}
+
+/// Views over a sparse accessor's index and value arrays.
+bool SparseViews(const GLTFDocument& doc, const GLTFAccessor& acc,
+                 GLTFAccessorView& idx, GLTFAccessorView& vals) {
+    const auto& sp = acc.sparse;
+    u32 is = ComponentSize(sp.indicesComponentType);
+    if (is == 0 || sp.indicesComponentType == GLTFAccessor::Byte ||
+        sp.indicesComponentType == GLTFAccessor::Short || sp.indicesComponentType == GLTFAccessor::Float)
+        return false;
+    idx = {};
+    idx.base = ViewBytes(doc, sp.indicesView, sp.indicesOffset, static_cast<size_t>(is) * sp.count);
+    idx.stride = is;
+    idx.count = sp.count;
+    idx.componentType = sp.indicesComponentType;
+
+    vals = {};
+    size_t elem = ElementLayout(acc, vals.componentOffset);
+    vals.base = ViewBytes(doc, sp.valuesView, sp.valuesOffset, elem * sp.count);
+    vals.stride = elem;
+    vals.count = sp.count;
+    vals.components = acc.components;
+    vals.componentType = acc.componentType;
+    vals.normalized = acc.normalized;
+    return idx.base && vals.base;
+}
+
+Quaternion QuatFromMatrix(const f32 r[3][3]) {
+    // r[row][col]
+    Quaternion q;
+    f32 trace = r[0][0] + r[1][1] + r[2][2];
+    if (trace > 0.0f) {
+        f32 s = 0.5f / std::sqrt(trace + 1.0f);
+        q.w = 0.25f / s;
+        q.x = (r[2][1] - r[1][2]) * s;
+        q.y = (r[0][2] - r[2][0]) * s;
+        q.z = (r[1][0] - r[0][1]) * s;
+    } else if (r[0][0] > r[1][1] && r[0][0] > r[2][2]) {
+        f32 s = 2.0f * std::sqrt(1.0f + r[0][0] - r[1][1] - r[2][2]);
+        q.w = (r[2][1] - r[1][2]) / s;
+        q.x = 0.25f * s;
+        q.y = (r[0][1] + r[1][0]) / s;
+        q.z = (r[0][2] + r[2][0]) / s;
+    } else if (r[1][1] > r[2][2]) {
+        f32 s = 2.0f * std::sqrt(1.0f + r[1][1] - r[0][0] - r[2][2]);
+        q.w = (r[0][2] - r[2][0]) / s;
+        q.x = (r[0][1] + r[1][0]) / s;
+        q.y = 0.25f * s;
+        q.z = (r[1][2] + r[2][1]) / s;
+    } else {
+        f32 s = 2.0f * std::sqrt(1.0f + r[2][2] - r[0][0] - r[1][1]);
+        q.w = (r[1][0] - r[0][1]) / s;
+        q.x = (r[0][2] + r[2][0]) / s;
+        q.y = (r[1][2] + r[2][1]) / s;
+        q.z = 0.25f * s;
+    }
+    return q.Normalized();
+}
+
+/// Column-major 4x4 → translation, rotation, scale (no shear).
+void DecomposeMatrix(const f32 m[16], Vec3& t, Quaternion& q, Vec3& s) {
+    t = { m[12], m[13], m[14] };
+    Vec3 c0(m[0], m[1], m[2]), c1(m[4], m[5], m[6]), c2(m[8], m[9], m[10]);
+    s = { c0.Length(), c1.Length(), c2.Length() };
+    if (c0.Cross(c1).Dot(c2) < 0.0f) s.x = -s.x;
+    if (std::fabs(s.x) < 1e-8f || std::fabs(s.y) < 1e-8f || std::fabs(s.z) < 1e-8f) {
+        q = Quaternion();
+        return;
+    }
+    c0 = c0 / s.x; c1 = c1 / s.y; c2 = c2 / s.z;
+    f32 r[3][3] = { { c0.x, c1.x, c2.x }, { c0.y, c1.y, c2.y }, { c0.z, c1.z, c2.z } };
+    q = QuatFromMatrix(r);
+}
+
+Quaternion NormalizedQuat(f32 x, f32 y, f32 z, f32 w) {
+    f32 len = std::sqrt(x * x + y * y + z * z + w * w);
+    if (len < 1e-8f) return Quaternion();
+    return { x / len, y / len, z / len, w / len };
+}
+
+/// Per-vertex tangent frame from UVs (accumulated over triangles, then
+/// Gram-Schmidt against the normal).  Bitangent sign follows the UV winding.
+void GenerateTangents(std::vector<SkinnedVertex>& v, const std::vector<u32>& idx) {
+    std::vector<Vec3> tan(v.size()), bit(v.size());
+    for (size_t i = 0; i + 2 < idx.size(); i += 3) {
+        u32 a = idx[i], b = idx[i + 1], c = idx[i + 2];
+        Vec3 e1 = v[b].position - v[a].position, e2 = v[c].position - v[a].position;
+        Vec2 d1 = v[b].texCoord - v[a].texCoord, d2 = v[c].texCoord - v[a].texCoord;
+        f32 det = d1.x * d2.y - d2.x * d1.y;
+        if (std::fabs(det) < 1e-12f) continue;
+        f32 r = 1.0f / det;
+        Vec3 t = (e1 * d2.y - e2 * d1.y) * r;
+        Vec3 bt = (e2 * d1.x - e1 * d2.x) * r;
+        for (u32 k : { a, b, c }) { tan[k] = tan[k] + t; bit[k] = bit[k] + bt; }
+    }
+    for (size_t i = 0; i < v.size(); ++i) {
+        const Vec3& n = v[i].normal;
+        Vec3 t = tan[i] - n * n.Dot(tan[i]);
+        if (t.Length() < 1e-6f) {
+            // No usable UV gradient: any vector perpendicular to the normal.
+            t = (std::fabs(n.x) < 0.9f ? Vec3(1, 0, 0) : Vec3(0, 1, 0));
+            t = t - n * n.Dot(t);
+        }
+        t = t.Normalized();
+        f32 sign = (n.Cross(t).Dot(bit[i]) < 0.0f) ? -1.0f : 1.0f;
+        v[i].tangent = t;
+        v[i].bitangent = n.Cross(t) * sign;
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Accessor view
+// ============================================================================
+f32 GLTFAccessorView::Float(u32 i, u32 c) const {
+    if (!base) return 0.0f;
+    const u8* p = base + static_cast<size_t>(i) * stride + componentOffset[c];
+    switch (componentType) {
+        case GLTFAccessor::Float:         { f32 v; std::memcpy(&v, p, 4); return v; }
+        case GLTFAccessor::UnsignedByte:  return normalized ? p[0] / 255.0f : static_cast<f32>(p[0]);
+        case GLTFAccessor::Byte: {
+            i8 v = static_cast<i8>(p[0]);
+            return normalized ? std::max(v / 127.0f, -1.0f) : static_cast<f32>(v);
+        }
+        case GLTFAccessor::UnsignedShort: {
+            u16 v; std::memcpy(&v, p, 2);
+            return normalized ? v / 65535.0f : static_cast<f32>(v);
+        }
+        case GLTFAccessor::Short: {
+            i16 v; std::memcpy(&v, p, 2);
+            return normalized ? std::max(v / 32767.0f, -1.0f) : static_cast<f32>(v);
+        }
+        case GLTFAccessor::UnsignedInt:   { u32 v; std::memcpy(&v, p, 4); return static_cast<f32>(v); }
+        default: return 0.0f;
+    }
+}
+
+u32 GLTFAccessorView::UInt(u32 i, u32 c) const {
+    if (!base) return 0;
+    const u8* p = base + static_cast<size_t>(i) * stride + componentOffset[c];
+    switch (componentType) {
+        case GLTFAccessor::UnsignedByte: case GLTFAccessor::Byte: return p[0];
+        case GLTFAccessor::UnsignedShort: case GLTFAccessor::Short: { u16 v; std::memcpy(&v, p, 2); return v; }
+        case GLTFAccessor::UnsignedInt: { u32 v; std::memcpy(&v, p, 4); return v; }
+        case GLTFAccessor::Float: { f32 v; std::memcpy(&v, p, 4); return v > 0.0f ? static_cast<u32>(v) : 0u; }
+        default: return 0;
+    }
+}
+
+// ============================================================================
+// GLTFDocument — loading
+// ============================================================================
+bool GLTFDocument::Fail(const std::string& msg) {
+    m_Error = msg;
+    GV_LOG_WARN("glTF loader — " + msg);
+    return false;
+}
+
+bool GLTFDocument::Load(const std::string& path) {
+    if (!m_File.Open(path)) return Fail("cannot open " + path);
+    size_t slash = path.find_last_of("/\\");
+    std::string dir = (slash == std::string::npos) ? std::string() : path.substr(0, slash + 1);
+    if (!Parse(m_File.Data(), m_File.Size(), dir)) {
+        m_Error += " (" + path + ")";
+        return false;
+    }
+    return true;
+}
+
+bool GLTFDocument::Parse(const u8* data, size_t size, const std::string& baseDir) {
+    buffers.clear(); bufferViews.clear(); accessors.clear(); meshes.clear();
+    nodes.clear(); skins.clear(); animations.clear(); materials.clear();
+    images.clear(); textures.clear(); scenes.clear();
+    scene = -1;
+    m_ExternalFiles.clear();
+    m_DecodedBuffers.clear();
+    m_Error.clear();
+    m_BaseDir = baseDir;
+
+    if (!data || size == 0) return Fail("empty file");
+
+    auto rd32 = [&](size_t off) { u32 v; std::memcpy(&v, data + off, 4); return v; };
+
+    // ── GLB container: 12-byte header, JSON chunk, optional BIN chunk ──────
+    if (size >= 12 && rd32(0) == 0x46546C67u) {   // "glTF"
+        if (rd32(4) != 2) return Fail("unsupported GLB version " + std::to_string(rd32(4)));
+        size_t total = std::min<size_t>(rd32(8), size);
+        const char* json = nullptr;
+        size_t jsonSize = 0;
+        const u8* bin = nullptr;
+        size_t binSize = 0;
+        size_t off = 12;
+        while (off + 8 <= total) {
+            u32 len = rd32(off), type = rd32(off + 4);
+            off += 8;
+            if (len > total - off) return Fail("truncated GLB chunk");
+            if (type == 0x4E4F534Au && !json) { json = reinterpret_cast<const char*>(data + off); jsonSize = len; }
+            else if (type == 0x004E4942u && !bin) { bin = data + off; binSize = len; }
+            off += (static_cast<size_t>(len) + 3) & ~static_cast<size_t>(3);
+        }
+        if (!json) return Fail("GLB has no JSON chunk");
+        return ParseJSON(json, jsonSize, bin, binSize);
+    }
+    return ParseJSON(reinterpret_cast<const char*>(data), size, nullptr, 0);
+}
+
+bool GLTFDocument::ParseJSON(const char* json, size_t size, const u8* glbBin, size_t glbBinSize) {
+    JsonReader r(json, size);
+    std::vector<std::string> bufferUris;
+    std::vector<size_t>      bufferSizes;
+    std::string              version;
+    std::vector<std::string> required;
+
+    ReadObject(r, [&](const std::string& key) {
+        if (key == "asset") {
+            ReadObject(r, [&](const std::string& k) {
+                if (k == "version") version = r.String(); else r.Skip();
+            });
+        } else if (key == "buffers") {
+            ReadArray(r, [&] {
+                std::string uri;
+                size_t len = 0;
+                ReadObject(r, [&](const std::string& k) {
+                    if (k == "uri") uri = r.String();
+                    else if (k == "byteLength") len = static_cast<size_t>(r.Number());
+                    else r.Skip();
+                });
+                bufferUris.push_back(uri);
+                bufferSizes.push_back(len);
+            });
+        } else if (key == "bufferViews") {
+            ReadArray(r, [&] {
+                GLTFBufferView bv;
+                ReadObject(r, [&](const std::string& k) {
+                    if (k == "buffer") bv.buffer = r.Int();
+                    else if (k == "byteOffset") bv.offset = static_cast<size_t>(r.Number());
+                    else if (k == "byteLength") bv.length = static_cast<size_t>(r.Number());
+                    else if (k == "byteStride") bv.stride = static_cast<u32>(r.Number());
+                    else r.Skip();
+                });
+                bufferViews.push_back(bv);
+            });
+        } else if (key == "accessors") {
+            ReadArray(r, [&] {
+                GLTFAccessor a;
+                ReadObject(r, [&](const std::string& k) {
+                    if (k == "bufferView") a.bufferView = r.Int();
+                    else if (k == "byteOffset") a.offset = static_cast<size_t>(r.Number());
+                    else if (k == "componentType") a.componentType = static_cast<u32>(r.Number());
+                    else if (k == "normalized") a.normalized = r.Bool();
+                    else if (k == "count") a.count = static_cast<u32>(r.Number());
+                    else if (k == "type") {
+                        std::string t = r.String();
+                        if (t == "SCALAR")    { a.components = 1;  a.rows = 1; }
+                        else if (t == "VEC2") { a.components = 2;  a.rows = 1; }
+                        else if (t == "VEC3") { a.components = 3;  a.rows = 1; }
+                        else if (t == "VEC4") { a.components = 4;  a.rows = 1; }
+                        else if (t == "MAT2") { a.components = 4;  a.rows = 2; }
+                        else if (t == "MAT3") { a.components = 9;  a.rows = 3; }
+                        else if (t == "MAT4") { a.components = 16; a.rows = 4; }
+                    }
+                    else if (k == "min") ReadFloatArray(r, a.min);
+                    else if (k == "max") ReadFloatArray(r, a.max);
+                    else if (k == "sparse") {
+                        ReadObject(r, [&](const std::string& sk) {
+                            if (sk == "count") a.sparse.count = static_cast<u32>(r.Number());
+                            else if (sk == "indices") {
+                                ReadObject(r, [&](const std::string& ik) {
+                                    if (ik == "bufferView") a.sparse.indicesView = r.Int();
+                                    else if (ik == "byteOffset") a.sparse.indicesOffset = static_cast<size_t>(r.Number());
+                                    else if (ik == "componentType") a.sparse.indicesComponentType = static_cast<u32>(r.Number());
+                                    else r.Skip();
+                                });
+                            } else if (sk == "values") {
+                                ReadObject(r, [&](const std::string& vk) {
+                                    if (vk == "bufferView") a.sparse.valuesView = r.Int();
+                                    else if (vk == "byteOffset") a.sparse.valuesOffset = static_cast<size_t>(r.Number());
+                                    else r.Skip();
+                                });
+                            } else r.Skip();
+                        });
+                    }
+                    else r.Skip();
+                });
+                accessors.push_back(std::move(a));
+            });
+        } else if (key == "meshes") {
+            ReadArray(r, [&] {
+                GLTFMesh mesh;
+                ReadObject(r, [&](const std::string& k) {
+                    if (k == "name") mesh.name = r.String();
+                    else if (k == "weights") ReadFloatArray(r, mesh.weights);
+                    else if (k == "primitives") {
+                        ReadArray(r, [&] {
+                            GLTFPrimitive prim;
+                            ReadObject(r, [&](const std::string& pk) {
+                                if (pk == "attributes") {
+                                    ReadObject(r, [&](const std::string& ak) {
+                                        if (ak == "POSITION")        prim.position  = r.Int();
+                                        else if (ak == "NORMAL")     prim.normal    = r.Int();
+                                        else if (ak == "TANGENT")    prim.tangent   = r.Int();
+                                        else if (ak == "TEXCOORD_0") prim.texcoord0 = r.Int();
+                                        else if (ak == "COLOR_0")    prim.color0    = r.Int();
+                                        else if (ak == "JOINTS_0")   prim.joints0   = r.Int();
+                                        else if (ak == "WEIGHTS_0")  prim.weights0  = r.Int();
+                                        else r.Skip();
+                                    });
+                                } else if (pk == "indices")  prim.indices  = r.Int();
+                                else if (pk == "material")   prim.material = r.Int();
+                                else if (pk == "mode")       prim.mode     = static_cast<u32>(r.Number());
+                                else if (pk == "targets") {
+                                    ReadArray(r, [&] {
+                                        GLTFMorphTarget t;
+                                        ReadObject(r, [&](const std::string& tk) {
+                                            if (tk == "POSITION")     t.position = r.Int();
+                                            else if (tk == "NORMAL")  t.normal   = r.Int();
+                                            else if (tk == "TANGENT") t.tangent  = r.Int();
+                                            else r.Skip();
+                                        });
+                                        prim.targets.push_back(t);
+                                    });
+                                } else r.Skip();
+                            });
+                            mesh.primitives.push_back(std::move(prim));
+                        });
+                    } else r.Skip();
+                });
+                meshes.push_back(std::move(mesh));
+            });
+        } else if (key == "nodes") {
+            ReadArray(r, [&] {
+                GLTFNode node;
+                ReadObject(r, [&](const std::string& k) {
+                    if (k == "name") node.name = r.String();
+                    else if (k == "children") ReadIntArray(r, node.children);
+                    else if (k == "mesh") node.mesh = r.Int();
+                    else if (k == "skin") node.skin = r.Int();
+                    else if (k == "weights") ReadFloatArray(r, node.weights);
+                    else if (k == "translation" || k == "scale" || k == "rotation" || k == "matrix") {
+                        std::vector<f32> v;
+                        ReadFloatArray(r, v);
+                        if (k == "translation" && v.size() == 3) node.translation = { v[0], v[1], v[2] };
+                        else if (k == "scale" && v.size() == 3)  node.scale = { v[0], v[1], v[2] };
+                        else if (k == "rotation" && v.size() == 4) node.rotation = NormalizedQuat(v[0], v[1], v[2], v[3]);
+                        else if (k == "matrix" && v.size() == 16)
+                            DecomposeMatrix(v.data(), node.translation, node.rotation, node.scale);
+                    }
+                    else r.Skip();
+                });
+                nodes.push_back(std::move(node));
+            });
+        } else if (key == "skins") {
+            ReadArray(r, [&] {
+                GLTFSkin skin;
+                ReadObject(r, [&](const std::string& k) {
+                    if (k == "name") skin.name = r.String();
+                    else if (k == "inverseBindMatrices") skin.inverseBindMatrices = r.Int();
+                    else if (k == "skeleton") skin.skeleton = r.Int();
+                    else if (k == "joints") ReadIntArray(r, skin.joints);
+                    else r.Skip();
+                });
+                skins.push_back(std::move(skin));
+            });
+        } else if (key == "animations") {
+            ReadArray(r, [&] {
+                GLTFAnimation anim;
+                ReadObject(r, [&](const std::string& k) {
+                    if (k == "name") anim.name = r.String();
+                    else if (k == "samplers") {
+                        ReadArray(r, [&] {
+                            GLTFAnimationSampler s;
+                            ReadObject(r, [&](const std::string& sk) {
+                                if (sk == "input") s.input = r.Int();
+                                else if (sk == "output") s.output = r.Int();
+                                else if (sk == "interpolation") {
+                                    std::string i = r.String();
+                                    s.interpolation = (i == "STEP") ? GLTFAnimationSampler::Step
+                                                    : (i == "CUBICSPLINE") ? GLTFAnimationSampler::CubicSpline
+                                                    : GLTFAnimationSampler::Linear;
+                                } else r.Skip();
+                            });
+                            anim.samplers.push_back(s);
+                        });
+                    } else if (k == "channels") {
+                        ReadArray(r, [&] {
+                            GLTFAnimationChannel c;
+                            bool known = false;
+                            ReadObject(r, [&](const std::string& ck) {
+                                if (ck == "sampler") c.sampler = r.Int();
+                                else if (ck == "target") {
+                                    ReadObject(r, [&](const std::string& tk) {
+                                        if (tk == "node") c.node = r.Int();
+                                        else if (tk == "path") {
+                                            std::string p = r.String();
+                                            known = true;
+                                            if (p == "translation")   c.path = GLTFAnimationChannel::Translation;
+                                            else if (p == "rotation") c.path = GLTFAnimationChannel::Rotation;
+                                            else if (p == "scale")    c.path = GLTFAnimationChannel::Scale;
+                                            else if (p == "weights")  c.path = GLTFAnimationChannel::Weights;
+                                            else known = false;   // extension-defined target
+                                        } else r.Skip();
+                                    });
+                                } else r.Skip();
+                            });
+                            if (known && c.node >= 0) anim.channels.push_back(c);
+                        });
+                    } else r.Skip();
+                });
+                animations.push_back(std::move(anim));
+            });
+        } else if (key == "materials") {
+            ReadArray(r, [&] {
+                GLTFMaterial m;
+                ReadObject(r, [&](const std::string& k) {
+                    if (k == "name") m.name = r.String();
+                    else if (k == "pbrMetallicRoughness") {
+                        ReadObject(r, [&](const std::string& pk) {
+                            if (pk == "baseColorFactor") {
+                                std::vector<f32> v;
+                                ReadFloatArray(r, v);
+                                if (v.size() == 4) m.baseColor = { v[0], v[1], v[2], v[3] };
+                            }
+                            else if (pk == "metallicFactor")   m.metallic  = r.Float();
+                            else if (pk == "roughnessFactor")  m.roughness = r.Float();
+                            else if (pk == "baseColorTexture") m.baseColorTexture = ReadTextureRef(r);
+                            else r.Skip();
+                        });
+                    }
+                    else if (k == "normalTexture") m.normalTexture = ReadTextureRef(r);
+                    else if (k == "emissiveFactor") {
+                        std::vector<f32> v;
+                        ReadFloatArray(r, v);
+                        if (v.size() == 3) m.emissive = { v[0], v[1], v[2] };
+                    }
+                    else if (k == "doubleSided") m.doubleSided = r.Bool();
+                    else if (k == "alphaMode") m.alphaBlend = (r.String() == "BLEND");
+                    else r.Skip();
+                });
+                materials.push_back(std::move(m));
+            });
+        } else if (key == "images") {
+            ReadArray(r, [&] {
+                GLTFImage img;
+                ReadObject(r, [&](const std::string& k) {
+                    if (k == "uri") img.uri = r.String();
+                    else if (k == "bufferView") img.bufferView = r.Int();
+                    else if (k == "mimeType") img.mimeType = r.String();
+                    else r.Skip();
+                });
+                images.push_back(std::move(img));
+            });
+        } else if (key == "textures") {
+            ReadArray(r, [&] {
+                GLTFTexture t;
+                ReadObject(r, [&](const std::string& k) {
+                    if (k == "source") t.source = r.Int(); else r.Skip();
+                });
+                textures.push_back(t);
+            });
+        } else if (key == "scenes") {
+            ReadArray(r, [&] {
+                GLTFSceneDesc s;
+                ReadObject(r, [&](const std::string& k) {
+                    if (k == "name") s.name = r.String();
+                    else if (k == "nodes") ReadIntArray(r, s.nodes);
+                    else r.Skip();
+                });
+                scenes.push_back(std::move(s));
+            });
+        } else if (key == "scene") {
+            scene = r.Int();
+        } else if (key == "extensionsRequired") {
+            ReadArray(r, [&] { required.push_back(r.String()); });
+        } else {
+            r.Skip();
+        }
+    });
+
+    if (!r.Ok()) return Fail("malformed JSON near byte " + std::to_string(r.Position()));
+    if (version.empty() || version[0] != '2') return Fail("unsupported asset version '" + version + "'");
+    for (auto& ext : required) {
+        if (ext != "KHR_mesh_quantization")
+            return Fail("required extension " + ext + " is not supported");
+    }
+
+    // ── Parents from children; reject nodes with two parents or cycles ─────
+    const i32 nodeCount = static_cast<i32>(nodes.size());
+    for (i32 i = 0; i < nodeCount; ++i) {
+        for (i32 c : nodes[i].children) {
+            if (c < 0 || c >= nodeCount || c == i) return Fail("invalid child index in node " + std::to_string(i));
+            if (nodes[c].parent >= 0) return Fail("node " + std::to_string(c) + " has more than one parent");
+            nodes[c].parent = i;
+        }
+    }
+    for (i32 i = 0; i < nodeCount; ++i) {
+        i32 steps = 0;
+        for (i32 p = nodes[i].parent; p >= 0; p = nodes[p].parent)
+            if (++steps > nodeCount) return Fail("node hierarchy contains a cycle");
+    }
+
+    return ResolveBuffers(bufferUris, bufferSizes, glbBin, glbBinSize);
+}
+
+bool GLTFDocument::ResolveBuffers(const std::vector<std::string>& uris, const std::vector<size_t>& sizes,
+                                  const u8* glbBin, size_t glbBinSize) {
+    buffers.resize(uris.size());
+    m_DecodedBuffers.reserve(uris.size());
+    for (size_t i = 0; i < uris.size(); ++i) {
+        const std::string& uri = uris[i];
+        GLTFBuffer& buf = buffers[i];
+        if (uri.empty()) {
+            // Only the first buffer of a GLB may refer to the BIN chunk.
+            if (i != 0 || !glbBin) return Fail("buffer " + std::to_string(i) + " has no data");
+            buf.data = glbBin;
+            buf.size = glbBinSize;
+        } else if (uri.compare(0, 5, "data:") == 0) {
+            size_t comma = uri.find(',');
+            if (comma == std::string::npos || uri.rfind(";base64", comma) == std::string::npos)
+                return Fail("buffer " + std::to_string(i) + " has an unsupported data URI");
+            m_DecodedBuffers.emplace_back();
+            if (!DecodeBase64(uri.data() + comma + 1, uri.size() - comma - 1, m_DecodedBuffers.back()))
+                return Fail("buffer " + std::to_string(i) + " has invalid base64 data");
+            buf.data = m_DecodedBuffers.back().data();
+            buf.size = m_DecodedBuffers.back().size();
+        } else {
+            auto file = MakeUnique<MappedFile>();
+            std::string path = m_BaseDir + DecodeURI(uri);
+            if (!file->Open(path)) return Fail("cannot open buffer " + path);
+            buf.data = file->Data();
+            buf.size = file->Size();
+            m_ExternalFiles.push_back(std::move(file));
+        }
+        if (buf.size < sizes[i]) return Fail("buffer " + std::to_string(i) + " is shorter than its byteLength");
+        buf.size = sizes[i];
+    }
+    return true;
+}
+
+// ============================================================================
+// GLTFDocument — accessors
+// ============================================================================
+bool GLTFDocument::GetView(i32 accessor, GLTFAccessorView& out) const {
+    const GLTFAccessor* acc = GetAccessor(accessor);
+    if (!acc || ComponentSize(acc->componentType) == 0 || acc->components == 0) return false;
+    out = {};
+    size_t elem = ElementLayout(*acc, out.componentOffset);
+    out.count = acc->count;
+    out.components = acc->components;
+    out.componentType = acc->componentType;
+    out.normalized = acc->normalized;
+    if (acc->bufferView < 0) return true;   // zeros
+
+    if (acc->bufferView >= static_cast<i32>(bufferViews.size())) return false;
+    u32 viewStride = bufferViews[acc->bufferView].stride;
+    out.stride = viewStride ? viewStride : elem;
+    size_t span = acc->count ? (static_cast<size_t>(acc->count) - 1) * out.stride + elem : 0;
+    out.base = ViewBytes(*this, acc->bufferView, acc->offset, span);
+    return out.base != nullptr;
+}
+
+bool GLTFDocument::ReadFloats(i32 accessor, f32* dst, u32 dstComponents, size_t dstStride) const {
+    GLTFAccessorView view;
+    if (!GetView(accessor, view)) return false;
+    u32 n = std::min(view.components, dstComponents);
+    u8* out = reinterpret_cast<u8*>(dst);
+
+    if (view.base && view.componentType == GLTFAccessor::Float && view.components == n &&
+        view.stride == n * sizeof(f32) && view.componentOffset[n - 1] == (n - 1) * sizeof(f32)) {
+        for (u32 i = 0; i < view.count; ++i)
+            std::memcpy(out + i * dstStride, view.base + static_cast<size_t>(i) * view.stride, n * sizeof(f32));
+    } else {
+        for (u32 i = 0; i < view.count; ++i) {
+            f32* d = reinterpret_cast<f32*>(out + i * dstStride);
+            for (u32 c = 0; c < n; ++c) d[c] = view.Float(i, c);
+        }
+    }
+
+    const GLTFAccessor& acc = accessors[accessor];
+    if (acc.sparse.count > 0) {
+        GLTFAccessorView idx, vals;
+        if (!SparseViews(*this, acc, idx, vals)) return false;
+        for (u32 k = 0; k < acc.sparse.count; ++k) {
+            u32 i = idx.UInt(k, 0);
+            if (i >= view.count) return false;
+            f32* d = reinterpret_cast<f32*>(out + i * dstStride);
+            for (u32 c = 0; c < n; ++c) d[c] = vals.Float(k, c);
+        }
+    }
+    return true;
+}
+
+bool GLTFDocument::ReadUInts(i32 accessor, u32* dst, u32 dstComponents, size_t dstStride) const {
+    GLTFAccessorView view;
+    if (!GetView(accessor, view)) return false;
+    u32 n = std::min(view.components, dstComponents);
+    u8* out = reinterpret_cast<u8*>(dst);
+    for (u32 i = 0; i < view.count; ++i) {
+        u32* d = reinterpret_cast<u32*>(out + i * dstStride);
+        for (u32 c = 0; c < n; ++c) d[c] = view.UInt(i, c);
+    }
+
+    const GLTFAccessor& acc = accessors[accessor];
+    if (acc.sparse.count > 0) {
+        GLTFAccessorView idx, vals;
+        if (!SparseViews(*this, acc, idx, vals)) return false;
+        for (u32 k = 0; k < acc.sparse.count; ++k) {
+            u32 i = idx.UInt(k, 0);
+            if (i >= view.count) return false;
+            u32* d = reinterpret_cast<u32*>(out + i * dstStride);
+            for (u32 c = 0; c < n; ++c) d[c] = vals.UInt(k, c);
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// GLTFDocument — geometry and transforms
+// ============================================================================
+bool GLTFDocument::ReadPrimitive(const GLTFPrimitive& prim, std::vector<SkinnedVertex>& vertices,
+                                 std::vector<u32>& indices, const std::vector<f32>* morphWeights) const {
+    vertices.clear();
+    indices.clear();
+    if (prim.mode != GLTFPrimitive::Triangles && prim.mode != GLTFPrimitive::TriangleStrip &&
+        prim.mode != GLTFPrimitive::TriangleFan)
+        return false;   // points and lines have no renderer path
+
+    const GLTFAccessor* posAcc = GetAccessor(prim.position);
+    if (!posAcc || posAcc->components != 3) return false;
+    const u32 n = posAcc->count;
+    const size_t vs = sizeof(SkinnedVertex);
+    auto sameCount = [&](i32 a) { const GLTFAccessor* x = GetAccessor(a); return x && x->count == n; };
+
+    vertices.assign(n, SkinnedVertex{});
+    if (n == 0) return true;
+    if (!ReadFloats(prim.position, &vertices[0].position.x, 3, vs)) return false;
+
+    bool hasNormals = prim.normal >= 0 && sameCount(prim.normal) &&
+                      ReadFloats(prim.normal, &vertices[0].normal.x, 3, vs);
+    bool hasUVs = prim.texcoord0 >= 0 && sameCount(prim.texcoord0) &&
+                  ReadFloats(prim.texcoord0, &vertices[0].texCoord.x, 2, vs);
+    if (hasUVs) {
+        // glTF's UV origin is the top-left; textures are uploaded flipped.
+        for (auto& v : vertices) v.texCoord.y = 1.0f - v.texCoord.y;
+    }
+
+    std::vector<f32> tangents;
+    if (hasNormals && prim.tangent >= 0 && sameCount(prim.tangent)) {
+        tangents.assign(static_cast<size_t>(n) * 4, 0.0f);
+        if (!ReadFloats(prim.tangent, tangents.data(), 4, 4 * sizeof(f32))) tangents.clear();
+    }
+
+    // ── Skin influences ───────────────────────────────────────────────────
+    if (prim.joints0 >= 0 && prim.weights0 >= 0 && sameCount(prim.joints0) && sameCount(prim.weights0)) {
+        std::vector<u32> joints(static_cast<size_t>(n) * 4, 0);
+        if (ReadUInts(prim.joints0, joints.data(), 4, 4 * sizeof(u32)) &&
+            ReadFloats(prim.weights0, &vertices[0].boneWeights[0], 4, vs)) {
+            for (u32 i = 0; i < n; ++i) {
+                SkinnedVertex& v = vertices[i];
+                f32 sum = 0.0f;
+                for (int k = 0; k < 4; ++k) {
+                    v.boneIDs[k] = v.boneWeights[k] > 0.0f ? static_cast<i32>(joints[i * 4 + k]) : -1;
+                    if (v.boneIDs[k] < 0) v.boneWeights[k] = 0.0f;
+                    sum += v.boneWeights[k];
+                }
+                if (sum > 0.0f && std::fabs(sum - 1.0f) > 1e-4f)
+                    for (int k = 0; k < 4; ++k) v.boneWeights[k] /= sum;
+            }
+        }
+    }
+
+    // ── Morph targets at the given weights ────────────────────────────────
+    if (morphWeights) {
+        std::vector<Vec3> delta;
+        for (size_t t = 0; t < prim.targets.size() && t < morphWeights->size(); ++t) {
+            f32 w = (*morphWeights)[t];
+            if (w == 0.0f) continue;
+            const GLTFMorphTarget& target = prim.targets[t];
+            auto apply = [&](i32 acc, u32 field) {
+                if (acc < 0 || !sameCount(acc)) return;
+                delta.assign(n, Vec3());
+                if (!ReadFloats(acc, &delta[0].x, 3, sizeof(Vec3))) return;
+                for (u32 i = 0; i < n; ++i) {
+                    if (field == 0) vertices[i].position = vertices[i].position + delta[i] * w;
+                    else if (field == 1) vertices[i].normal = vertices[i].normal + delta[i] * w;
+                    else if (!tangents.empty()) {
+                        tangents[i * 4 + 0] += delta[i].x * w;
+                        tangents[i * 4 + 1] += delta[i].y * w;
+                        tangents[i * 4 + 2] += delta[i].z * w;
+                    }
+                }
+            };
+            apply(target.position, 0);
+            if (hasNormals) apply(target.normal, 1);
+            apply(target.tangent, 2);
+        }
+    }
+
+    // ── Indices → triangle list ───────────────────────────────────────────
+    std::vector<u32> raw;
+    if (prim.indices >= 0) {
+        const GLTFAccessor* ia = GetAccessor(prim.indices);
+        if (!ia || ia->components != 1) return false;
+        raw.resize(ia->count);
+        if (ia->count && !ReadUInts(prim.indices, raw.data(), 1, sizeof(u32))) return false;
+        for (u32 i : raw) if (i >= n) return false;
+    } else {
+        raw.resize(n);
+        for (u32 i = 0; i < n; ++i) raw[i] = i;
+    }
+    if (prim.mode == GLTFPrimitive::Triangles) {
+        raw.resize(raw.size() - raw.size() % 3);
+        indices = std::move(raw);
+    } else if (raw.size() >= 3) {
+        indices.reserve((raw.size() - 2) * 3);
+        for (size_t i = 0; i + 2 < raw.size(); ++i) {
+            if (prim.mode == GLTFPrimitive::TriangleStrip) {
+                // Keep the winding of the first triangle.
+                indices.push_back(raw[i]);
+                indices.push_back(raw[i + 1 + (i & 1)]);
+                indices.push_back(raw[i + 2 - (i & 1)]);
+            } else {
+                indices.push_back(raw[i + 1]);
+                indices.push_back(raw[i + 2]);
+                indices.push_back(raw[0]);
+            }
+        }
+    }
+
+    // ── Normals: flat when missing (the spec's rule), so unweld ───────────
+    if (!hasNormals) {
+        std::vector<SkinnedVertex> flat;
+        flat.reserve(indices.size());
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            SkinnedVertex a = vertices[indices[i]], b = vertices[indices[i + 1]], c = vertices[indices[i + 2]];
+            Vec3 fn = (b.position - a.position).Cross(c.position - a.position).Normalized();
+            a.normal = b.normal = c.normal = fn;
+            flat.push_back(a); flat.push_back(b); flat.push_back(c);
+        }
+        vertices = std::move(flat);
+        for (u32 i = 0; i < static_cast<u32>(indices.size()); ++i) indices[i] = i;
+    } else {
+        for (auto& v : vertices) v.normal = v.normal.Normalized();
+    }
+
+    // ── Tangent frame ─────────────────────────────────────────────────────
+    if (!tangents.empty()) {
+        for (u32 i = 0; i < n; ++i) {
+            SkinnedVertex& v = vertices[i];
+            Vec3 t(tangents[i * 4], tangents[i * 4 + 1], tangents[i * 4 + 2]);
+            f32 sign = tangents[i * 4 + 3] < 0.0f ? -1.0f : 1.0f;
+            v.tangent = t.Normalized();
+            v.bitangent = v.normal.Cross(v.tangent) * sign;
+        }
+    } else {
+        GenerateTangents(vertices, indices);
+    }
+    return true;
+}
+
+Mat4 GLTFDocument::GetLocalMatrix(i32 node) const {
+    if (node < 0 || node >= static_cast<i32>(nodes.size())) return Mat4::Identity();
+    const GLTFNode& n = nodes[node];
+    return Mat4::Translate(n.translation) * n.rotation.ToMat4() * Mat4::Scale(n.scale);
+}
+
+Mat4 GLTFDocument::GetWorldMatrix(i32 node) const {
+    Mat4 m = Mat4::Identity();
+    for (i32 i = node; i >= 0 && i < static_cast<i32>(nodes.size()); i = nodes[i].parent)
+        m = GetLocalMatrix(i) * m;
+    return m;
+}
+
+i32 GLTFDocument::GetDefaultScene() const {
+    if (scene >= 0 && scene < static_cast<i32>(scenes.size())) return scene;
+    return scenes.empty() ? -1 : 0;
+}
+
+// ============================================================================
+// Scene import
+// ============================================================================
+namespace {
+
+/// One decoded animation sampler.
+struct GLTFTrack {
+    std::vector<f32> times;
+    std::vector<f32> values;        // comps per key (×3 for cubic: in-tangent, value, out-tangent)
+    u32  comps = 0;
+    GLTFAnimationSampler::Interpolation interp = GLTFAnimationSampler::Linear;
+    bool rotation = false;
+
+    bool Load(const GLTFDocument& doc, const GLTFAnimationSampler& s, u32 components) {
+        const GLTFAccessor* in  = doc.GetAccessor(s.input);
+        const GLTFAccessor* out = doc.GetAccessor(s.output);
+        if (!in || !out || in->count == 0 || out->components != components) return false;
+        u32 perKey = (s.interpolation == GLTFAnimationSampler::CubicSpline) ? 3u : 1u;
+        if (out->count != in->count * perKey) return false;
+        times.resize(in->count);
+        values.resize(static_cast<size_t>(out->count) * components);
+        comps = components;
+        interp = s.interpolation;
+        return doc.ReadFloats(s.input, times.data(), 1, sizeof(f32)) &&
+               doc.ReadFloats(s.output, values.data(), components, components * sizeof(f32));
+    }
+
+    const f32* Value(size_t key) const {
+        size_t stride = (interp == GLTFAnimationSampler::CubicSpline) ? 3 : 1;
+        return &values[(key * stride + (stride == 3 ? 1 : 0)) * comps];
+    }
+
+    void Sample(f32 t, f32 out[4]) const {
+        size_t last = times.size() - 1;
+        if (t <= times.front() || last == 0) { std::memcpy(out, Value(0), comps * sizeof(f32)); return; }
+        if (t >= times[last]) { std::memcpy(out, Value(last), comps * sizeof(f32)); return; }
+        size_t k = static_cast<size_t>(std::upper_bound(times.begin(), times.end(), t) - times.begin()) - 1;
+        f32 dt = times[k + 1] - times[k];
+        f32 u = dt > 0.0f ? (t - times[k]) / dt : 0.0f;
+        const f32* a = Value(k);
+        const f32* b = Value(k + 1);
+        if (interp == GLTFAnimationSampler::Step) {
+            std::memcpy(out, a, comps * sizeof(f32));
+        } else if (interp == GLTFAnimationSampler::CubicSpline) {
+            const f32* outTan = &values[(k * 3 + 2) * comps];
+            const f32* inTan  = &values[((k + 1) * 3) * comps];
+            f32 u2 = u * u, u3 = u2 * u;
+            f32 h00 = 2 * u3 - 3 * u2 + 1, h10 = u3 - 2 * u2 + u;
+            f32 h01 = -2 * u3 + 3 * u2,    h11 = u3 - u2;
+            for (u32 c = 0; c < comps; ++c)
+                out[c] = h00 * a[c] + h10 * dt * outTan[c] + h01 * b[c] + h11 * dt * inTan[c];
+        } else if (rotation) {
+            f32 dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+            f32 sgn = dot < 0.0f ? -1.0f : 1.0f;
+            dot *= sgn;
+            f32 wa = 1.0f - u, wb = u * sgn;
+            if (dot < 0.9995f) {
+                f32 theta = std::acos(dot), s = std::sin(theta);
+                wa = std::sin((1.0f - u) * theta) / s;
+                wb = std::sin(u * theta) / s * sgn;
+            }
+            for (u32 c = 0; c < 4; ++c) out[c] = a[c] * wa + b[c] * wb;
+        } else {
+            for (u32 c = 0; c < comps; ++c) out[c] = a[c] + (b[c] - a[c]) * u;
+        }
+        if (rotation) {
+            Quaternion q = NormalizedQuat(out[0], out[1], out[2], out[3]);
+            out[0] = q.x; out[1] = q.y; out[2] = q.z; out[3] = q.w;
+        }
+    }
+};
+
+/// The T/R/S tracks that drive one node within one animation.
+struct GLTFNodeTracks {
+    const GLTFTrack* track[3] = { nullptr, nullptr, nullptr };   // translation, rotation, scale
+};
+
+struct GLTFResampledKey {
+    f32        time;
+    Vec3       position;
+    Quaternion rotation;
+    Vec3       scale;
+};
+
+/// Bake a node's tracks into TRS keys the engine's linear samplers can play
+/// back.  Keys land on every source key; STEP tracks get a hold key just
+/// before each change and CUBICSPLINE segments are subdivided.
+std::vector<GLTFResampledKey> ResampleNode(const GLTFNode& node, const GLTFNodeTracks& nt) {
+    std::vector<f32> times;
+    for (const GLTFTrack* tr : nt.track) {
+        if (!tr) continue;
+        for (size_t k = 0; k < tr->times.size(); ++k) {
+            times.push_back(tr->times[k]);
+            if (k + 1 == tr->times.size()) break;
+            f32 t0 = tr->times[k], t1 = tr->times[k + 1];
+            if (tr->interp == GLTFAnimationSampler::Step && t1 - t0 > 2e-4f) {
+                times.push_back(t1 - 1e-4f);
+            } else if (tr->interp == GLTFAnimationSampler::CubicSpline) {
+                for (int s = 1; s < 4; ++s) times.push_back(t0 + (t1 - t0) * (s / 4.0f));
+            }
+        }
+    }
+    std::sort(times.begin(), times.end());
+    times.erase(std::unique(times.begin(), times.end(),
+                            [](f32 a, f32 b) { return std::fabs(a - b) < 1e-6f; }), times.end());
+
+    std::vector<GLTFResampledKey> keys;
+    keys.reserve(times.size());
+    for (f32 t : times) {
+        GLTFResampledKey key { t, node.translation, node.rotation, node.scale };
+        f32 v[4];
+        if (nt.track[0]) { nt.track[0]->Sample(t, v); key.position = { v[0], v[1], v[2] }; }
+        if (nt.track[1]) { nt.track[1]->Sample(t, v); key.rotation = { v[0], v[1], v[2], v[3] }; }
+        if (nt.track[2]) { nt.track[2]->Sample(t, v); key.scale    = { v[0], v[1], v[2] }; }
+        keys.push_back(key);
+    }
+    return keys;
+}
+
+/// Decoded tracks of one animation, grouped by target node.
+struct GLTFDecodedAnimation {
+    std::string                             name;
+    f32                                     duration = 0.0f;
+    std::vector<GLTFTrack>                  tracks;
+    std::vector<std::pair<i32, GLTFNodeTracks>> nodes;
+    bool                                    hasWeights = false;
+};
+
+std::vector<GLTFDecodedAnimation> DecodeAnimations(const GLTFDocument& doc) {
+    std::vector<GLTFDecodedAnimation> out;
+    for (size_t a = 0; a < doc.animations.size(); ++a) {
+        const GLTFAnimation& anim = doc.animations[a];
+        GLTFDecodedAnimation dec;
+        dec.name = anim.name.empty() ? "Animation " + std::to_string(a) : anim.name;
+        dec.tracks.reserve(anim.channels.size());   // stable addresses for GLTFNodeTracks
+        for (const auto& ch : anim.channels) {
+            if (ch.node < 0 || ch.node >= static_cast<i32>(doc.nodes.size()) ||
+                ch.sampler < 0 || ch.sampler >= static_cast<i32>(anim.samplers.size()))
+                continue;
+            if (ch.path == GLTFAnimationChannel::Weights) { dec.hasWeights = true; continue; }
+            GLTFTrack track;
+            track.rotation = (ch.path == GLTFAnimationChannel::Rotation);
+            if (!track.Load(doc, anim.samplers[ch.sampler], track.rotation ? 4u : 3u)) {
+                GV_LOG_WARN("glTF loader — skipping invalid channel in animation '" + dec.name + "'");
+                continue;
+            }
+            dec.duration = std::max(dec.duration, track.times.back());
+            dec.tracks.push_back(std::move(track));
+            auto it = std::find_if(dec.nodes.begin(), dec.nodes.end(),
+                                   [&](const auto& p) { return p.first == ch.node; });
+            if (it == dec.nodes.end()) { dec.nodes.push_back({ ch.node, GLTFNodeTracks{} }); it = dec.nodes.end() - 1; }
+            it->second.track[static_cast<int>(ch.path)] = &dec.tracks.back();
+        }
+        out.push_back(std::move(dec));
+    }
+    return out;
+}
+
+/// Skeleton for a skinned mesh node.  Bones are ordered parents-first (the
+/// order Skeleton::ComputeGlobalTransforms needs); `jointToBone` maps skin
+/// joint indices (what JOINTS_0 holds) to bone indices.
+Shared<Skeleton> BuildSkeleton(const GLTFDocument& doc, i32 meshNode, const GLTFSkin& skin,
+                               std::vector<i32>& jointToBone, std::vector<i32>& boneNodes) {
+    const size_t jointCount = skin.joints.size();
+    std::vector<i32> order(jointCount);
+    std::vector<i32> depth(jointCount, 0);
+    for (size_t j = 0; j < jointCount; ++j) {
+        order[j] = static_cast<i32>(j);
+        for (i32 p = doc.nodes[skin.joints[j]].parent; p >= 0; p = doc.nodes[p].parent) ++depth[j];
+    }
+    std::stable_sort(order.begin(), order.end(), [&](i32 a, i32 b) { return depth[a] < depth[b]; });
+
+    std::vector<Mat4> ibm(jointCount, Mat4::Identity());
+    const GLTFAccessor* ibmAcc = doc.GetAccessor(skin.inverseBindMatrices);
+    if (ibmAcc && ibmAcc->components == 16 && ibmAcc->count >= jointCount)
+        doc.ReadFloats(skin.inverseBindMatrices, ibm[0].m, 16, sizeof(Mat4));
+
+    auto skel = MakeShared<Skeleton>(skin.name.empty() ? "Skeleton" : skin.name);
+    jointToBone.assign(jointCount, -1);
+    boneNodes.clear();
+    std::set<std::string> used;
+    for (i32 j : order) {
+        i32 nodeIdx = skin.joints[j];
+        const GLTFNode& node = doc.nodes[nodeIdx];
+        // Parent bone: nearest ancestor that is also a joint of this skin.
+        i32 parentBone = -1;
+        for (i32 p = node.parent; p >= 0 && parentBone < 0; p = doc.nodes[p].parent) {
+            for (size_t k = 0; k < jointCount; ++k)
+                if (skin.joints[k] == p) { parentBone = jointToBone[k]; break; }
+        }
+        std::string name = node.name;
+        if (name.empty() || used.count(name)) name += "#" + std::to_string(nodeIdx);
+        used.insert(name);
+
+        i32 bone = skel->AddBone(name, parentBone, ibm[j]);
+        Bone& b = skel->GetBone(bone);
+        b.localPosition = node.translation;
+        b.localRotation = node.rotation;
+        b.localScale    = node.scale;
+        jointToBone[j] = bone;
+        boneNodes.push_back(nodeIdx);
+    }
+
+    // Joint matrices are relative to the skinned node (spec), and the
+    // renderer applies that node's model matrix on top — undo it, and put
+    // back whatever sits above the root joint.
+    Mat4 rootParent = Mat4::Identity();
+    if (!boneNodes.empty() && doc.nodes[boneNodes[0]].parent >= 0)
+        rootParent = doc.GetWorldMatrix(doc.nodes[boneNodes[0]].parent);
+    skel->SetGlobalInverseTransform(doc.GetWorldMatrix(meshNode).Inverse() * rootParent);
+    skel->ComputeGlobalTransforms();
+    return skel;
+}
+
+std::vector<SkeletalAnimClip> BuildSkeletalClips(const GLTFDocument& doc,
+                                                 const std::vector<GLTFDecodedAnimation>& anims,
+                                                 const Skeleton& skel, const std::vector<i32>& boneNodes) {
+    std::vector<SkeletalAnimClip> clips;
+    for (const auto& anim : anims) {
+        SkeletalAnimClip clip(anim.name);
+        for (const auto& nt : anim.nodes) {
+            auto it = std::find(boneNodes.begin(), boneNodes.end(), nt.first);
+            if (it == boneNodes.end()) continue;
+            i32 bone = static_cast<i32>(it - boneNodes.begin());
+            BoneChannel ch;
+            ch.boneName  = skel.GetBone(bone).name;
+            ch.boneIndex = bone;
+            for (const auto& k : ResampleNode(doc.nodes[nt.first], nt.second))
+                ch.keyframes.push_back({ k.time, k.position, k.rotation, k.scale });
+            clip.AddChannel(ch);
+        }
+        if (clip.GetChannels().empty()) continue;
+        clip.SetDuration(anim.duration);
+        clip.SetLooping(true);
+        clips.push_back(std::move(clip));
+    }
+    return clips;
+}
+
+GameObject* CreateChild(Scene& scene, GameObject* parent, const std::string& name) {
+    scene.CreateGameObject(name);
+    Shared<GameObject> obj = scene.GetAllObjects().back();
+    if (parent) parent->AddChild(obj);
+    return obj.get();
+}
+
+struct GLTFMaterialCache {
+    std::vector<Shared<Material>> materials;
+    std::vector<u32>              albedo, normal;
+    std::vector<bool>             resolved;
+};
+
+Shared<Texture> LoadGLTFTexture(const GLTFDocument& doc, i32 texture, AssetManager* assets) {
+    if (!assets || texture < 0 || texture >= static_cast<i32>(doc.textures.size())) return nullptr;
+    i32 src = doc.textures[texture].source;
+    if (src < 0 || src >= static_cast<i32>(doc.images.size())) return nullptr;
+    const GLTFImage& img = doc.images[src];
+    if (img.uri.empty() || img.uri.compare(0, 5, "data:") == 0) {
+        GV_LOG_INFO("glTF loader — embedded image " + std::to_string(src) + " skipped (file images only)");
+        return nullptr;
+    }
+    return assets->LoadTexture(doc.GetBaseDir() + DecodeURI(img.uri));
+}
+
+void ApplyMaterial(const GLTFDocument& doc, i32 index, GameObject* obj, MeshRenderer* mr,
+                   SkinnedMeshRenderer* smr, AssetManager* assets, GLTFMaterialCache& cache) {
+    GLTFMaterial def;
+    const bool valid = index >= 0 && index < static_cast<i32>(doc.materials.size());
+    const GLTFMaterial& m = valid ? doc.materials[index] : def;
+
+    Shared<Material> mat;
+    u32 albedoID = 0, normalID = 0;
+    if (valid && assets) {
+        if (cache.resolved.empty()) {
+            cache.materials.resize(doc.materials.size());
+            cache.albedo.assign(doc.materials.size(), 0);
+            cache.normal.assign(doc.materials.size(), 0);
+            cache.resolved.assign(doc.materials.size(), false);
+        }
+        if (!cache.resolved[index]) {
+            cache.resolved[index] = true;
+            auto& cm = cache.materials[index];
+            cm = assets->CreateMaterial(m.name.empty() ? obj->GetName() + "_mat" : m.name);
+            cm->albedo     = { m.baseColor.x, m.baseColor.y, m.baseColor.z };
+            cm->tintColour = m.baseColor;
+            cm->metallic   = m.metallic;
+            cm->roughness  = m.roughness;
+            cm->diffuseMap = LoadGLTFTexture(doc, m.baseColorTexture, assets);
+            cm->normalMap  = LoadGLTFTexture(doc, m.normalTexture, assets);
+            if (cm->diffuseMap) cache.albedo[index] = cm->diffuseMap->GetID();
+            if (cm->normalMap)  cache.normal[index] = cm->normalMap->GetID();
+        }
+        mat = cache.materials[index];
+        albedoID = cache.albedo[index];
+        normalID = cache.normal[index];
+    }
+
+    if (mr) {
+        mr->color = m.baseColor;
+        if (mat) mr->SetMaterial(mat);
+    }
+    if (smr) smr->color = m.baseColor;
+
+    auto* mc = obj->AddComponent<MaterialComponent>();
+    mc->albedo    = m.baseColor;
+    mc->metallic  = m.metallic;
+    mc->roughness = m.roughness;
+    mc->emission  = m.emissive;
+    mc->emissionStrength = (m.emissive.x + m.emissive.y + m.emissive.z) > 0.0f ? 1.0f : 0.0f;
+    mc->albedoMap = albedoID;
+    mc->normalMap = normalID;
+    if (!m.name.empty()) mc->SetMaterialName(m.name);
+}
+
+} // namespace
+
+bool ImportGLTFScene(const GLTFDocument& doc, Scene& scene, const std::string& rootName,
+                     GLTFImportResult& result, AssetManager* assets) {
+    result = {};
+    const i32 nodeCount = static_cast<i32>(doc.nodes.size());
+    result.nodeObjects.assign(nodeCount, nullptr);
+
+    std::vector<i32> roots;
+    i32 sceneIdx = doc.GetDefaultScene();
+    if (sceneIdx >= 0) {
+        roots = doc.scenes[sceneIdx].nodes;
+    } else {
+        for (i32 i = 0; i < nodeCount; ++i)
+            if (doc.nodes[i].parent < 0) roots.push_back(i);
+    }
+
+    result.root = CreateChild(scene, nullptr, rootName);
+
+    // ── Nodes (depth-first, hierarchy mirrored) ───────────────────────────
+    std::vector<std::pair<i32, GameObject*>> stack;
+    for (auto it = roots.rbegin(); it != roots.rend(); ++it) stack.push_back({ *it, result.root });
+    std::vector<i32> order;
+    while (!stack.empty()) {
+        auto [idx, parent] = stack.back();
+        stack.pop_back();
+        if (idx < 0 || idx >= nodeCount || result.nodeObjects[idx]) continue;
+        const GLTFNode& node = doc.nodes[idx];
+        GameObject* obj = CreateChild(scene, parent,
+                                      node.name.empty() ? "Node " + std::to_string(idx) : node.name);
+        Transform& tr = obj->GetTransform();
+        tr.position = node.translation;
+        tr.rotation = node.rotation;
+        tr.scale    = node.scale;
+        result.nodeObjects[idx] = obj;
+        order.push_back(idx);
+        for (auto it = node.children.rbegin(); it != node.children.rend(); ++it) stack.push_back({ *it, obj });
+    }
+
+    std::vector<GLTFDecodedAnimation> anims = DecodeAnimations(doc);
+    std::vector<bool> isJoint(nodeCount, false);
+    for (const auto& skin : doc.skins)
+        for (i32 j : skin.joints)
+            if (j >= 0 && j < nodeCount) isJoint[j] = true;
+
+    // ── Meshes ────────────────────────────────────────────────────────────
+    GLTFMaterialCache matCache;
+    std::vector<SkinnedVertex> sv;
+    std::vector<u32> indices;
+    for (i32 idx : order) {
+        const GLTFNode& node = doc.nodes[idx];
+        if (node.mesh < 0 || node.mesh >= static_cast<i32>(doc.meshes.size())) continue;
+        const GLTFMesh& mesh = doc.meshes[node.mesh];
+        const std::vector<f32>& weights = node.weights.empty() ? mesh.weights : node.weights;
+        GameObject* nodeObj = result.nodeObjects[idx];
+
+        Shared<Skeleton> skel;
+        std::vector<i32> jointToBone, boneNodes;
+        std::vector<SkeletalAnimClip> clips;
+        if (node.skin >= 0 && node.skin < static_cast<i32>(doc.skins.size())) {
+            const GLTFSkin& skin = doc.skins[node.skin];
+            bool ok = !skin.joints.empty() && skin.joints.size() <= Skeleton::MAX_BONES;
+            for (i32 j : skin.joints) ok = ok && j >= 0 && j < nodeCount;
+            if (ok) {
+                skel = BuildSkeleton(doc, idx, skin, jointToBone, boneNodes);
+                clips = BuildSkeletalClips(doc, anims, *skel, boneNodes);
+            } else {
+                GV_LOG_WARN("glTF loader — skin " + std::to_string(node.skin) + " is invalid or has more than " +
+                            std::to_string(Skeleton::MAX_BONES) + " joints; mesh imported unskinned");
+            }
+        }
+
+        for (size_t p = 0; p < mesh.primitives.size(); ++p) {
+            const GLTFPrimitive& prim = mesh.primitives[p];
+            if (!doc.ReadPrimitive(prim, sv, indices, weights.empty() ? nullptr : &weights) || indices.empty()) {
+                GV_LOG_WARN("glTF loader — skipped primitive " + std::to_string(p) + " of mesh '" + mesh.name +
+                            "' (unsupported mode or invalid data)");
+                continue;
+            }
+            std::string meshName = mesh.name.empty() ? nodeObj->GetName() : mesh.name;
+            if (mesh.primitives.size() > 1) meshName += " [" + std::to_string(p) + "]";
+            // One renderer per object: extra primitives become child objects.
+            GameObject* target = (mesh.primitives.size() == 1) ? nodeObj : CreateChild(scene, nodeObj, meshName);
+
+            if (skel && prim.joints0 >= 0) {
+                for (auto& v : sv)
+                    for (int k = 0; k < 4; ++k)
+                        if (v.boneIDs[k] >= 0)
+                            v.boneIDs[k] = v.boneIDs[k] < static_cast<i32>(jointToBone.size())
+                                         ? jointToBone[v.boneIDs[k]] : -1;
+                auto skinned = MakeShared<SkinnedMesh>(meshName);
+                skinned->Build(sv, indices);
+                auto* smr = target->AddComponent<SkinnedMeshRenderer>();
+                smr->mesh = skinned;
+                smr->skeleton = skel;
+                smr->meshPath = rootName;
+                auto* anim = target->AddComponent<SkeletalAnimator>();
+                anim->SetSkeleton(skel);
+                for (const auto& clip : clips) anim->AddClip(clip);
+                if (!clips.empty()) anim->Play(clips.front().GetName());
+                ApplyMaterial(doc, prim.material, target, nullptr, smr, assets, matCache);
+                ++result.skinnedObjects;
+            } else {
+                std::vector<Vertex> verts(sv.size());
+                for (size_t i = 0; i < sv.size(); ++i) {
+                    verts[i].position  = sv[i].position;
+                    verts[i].normal    = sv[i].normal;
+                    verts[i].texCoord  = sv[i].texCoord;
+                    verts[i].tangent   = sv[i].tangent;
+                    verts[i].bitangent = sv[i].bitangent;
+                }
+                auto m = MakeShared<Mesh>(meshName);
+                m->Build(verts, indices);
+                auto* mr = target->AddComponent<MeshRenderer>();
+                mr->primitiveType = PrimitiveType::None;
+                mr->SetMesh(m);
+                ApplyMaterial(doc, prim.material, target, mr, nullptr, assets, matCache);
+                ++result.meshObjects;
+            }
+        }
+    }
+
+    // ── Rigid node animation (joints are driven by their skeleton) ─────────
+    for (const auto& anim : anims) {
+        if (anim.hasWeights)
+            GV_LOG_INFO("glTF loader — morph weight tracks in '" + anim.name +
+                        "' are not played back; targets are baked at their default weights");
+        for (const auto& nt : anim.nodes) {
+            GameObject* obj = result.nodeObjects[nt.first];
+            if (!obj || isJoint[nt.first]) continue;
+            AnimationClip clip(anim.name);
+            for (const auto& k : ResampleNode(doc.nodes[nt.first], nt.second))
+                clip.AddKeyframe({ k.time, k.position, k.rotation, k.scale });
+            clip.SetDuration(anim.duration);
+            clip.SetLooping(true);
+            auto* animator = obj->GetComponent<Animator>();
+            if (!animator) {
+                animator = obj->AddComponent<Animator>();
+                animator->AddClip(clip);
+                animator->Play(clip.GetName());
+            } else {
+                animator->AddClip(clip);
+            }
+        }
+        ++result.animationClips;
+    }
+
+    GV_LOG_INFO("glTF loader — imported '" + rootName + "': " + std::to_string(order.size()) + " nodes, " +
+                std::to_string(result.meshObjects) + " meshes, " + std::to_string(result.skinnedObjects) +
+                " skinned, " + std::to_string(result.animationClips) + " animations");
+    return true;
+}
+
+bool ImportGLTFScene(const std::string& path, Scene& scene, GLTFImportResult& result, AssetManager* assets) {
+    GLTFDocument doc;
+    if (!doc.Load(path)) return false;
+    std::string name = path;
+    size_t slash = name.find_last_of("/\\");
+    if (slash != std::string::npos) name = name.substr(slash + 1);
+    size_t dot = name.rfind('.');
+    if (dot != std::string::npos) name = name.substr(0, dot);
+    return ImportGLTFScene(doc, scene, name, result, assets);
+}
+
+// ============================================================================
+// Flattened load (Mesh::LoadFromFile)
+// ============================================================================
+/// Every primitive of the default scene in one vertex/index list.  Static
+/// meshes are baked into scene space; skinned meshes stay in bind space with
+/// skin joint indices in boneIDs.
+bool LoadGLTF(const std::string& path, GLTFLoadResult& result) {
+    result = {};
+    GLTFDocument doc;
+    if (!doc.Load(path)) return false;
+
+    std::vector<i32> stack;
+    i32 sceneIdx = doc.GetDefaultScene();
+    if (sceneIdx >= 0) {
+        stack.assign(doc.scenes[sceneIdx].nodes.rbegin(), doc.scenes[sceneIdx].nodes.rend());
+    } else {
+        for (i32 i = static_cast<i32>(doc.nodes.size()) - 1; i >= 0; --i)
+            if (doc.nodes[i].parent < 0) stack.push_back(i);
+    }
+
+    std::vector<SkinnedVertex> sv;
+    std::vector<u32> idx;
+    std::vector<bool> seen(doc.nodes.size(), false);
+    while (!stack.empty()) {
+        i32 n = stack.back();
+        stack.pop_back();
+        if (n < 0 || n >= static_cast<i32>(doc.nodes.size()) || seen[n]) continue;
+        seen[n] = true;
+        const GLTFNode& node = doc.nodes[n];
+        for (auto it = node.children.rbegin(); it != node.children.rend(); ++it) stack.push_back(*it);
+        if (node.mesh < 0 || node.mesh >= static_cast<i32>(doc.meshes.size())) continue;
+
+        const GLTFMesh& mesh = doc.meshes[node.mesh];
+        const std::vector<f32>& weights = node.weights.empty() ? mesh.weights : node.weights;
+        bool skinned = node.skin >= 0;
+        Mat4 world = doc.GetWorldMatrix(n);
+        Mat4 normalMat = world.Inverse();   // transposed in xformNormal below
+        const f32* w = world.m;
+        bool mirrored = !skinned &&
+            (w[0] * (w[5] * w[10] - w[9] * w[6]) - w[4] * (w[1] * w[10] - w[9] * w[2]) +
+             w[8] * (w[1] * w[6] - w[5] * w[2])) < 0.0f;
+        auto xformPoint = [&](const Vec3& p) {
+            const f32* m = world.m;
+            return Vec3(m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12],
+                        m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13],
+                        m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14]);
+        };
+        auto xformDir = [](const f32* m, const Vec3& d) {
+            return Vec3(m[0] * d.x + m[4] * d.y + m[8] * d.z,
+                        m[1] * d.x + m[5] * d.y + m[9] * d.z,
+                        m[2] * d.x + m[6] * d.y + m[10] * d.z);
+        };
+        auto xformNormal = [&](const Vec3& d) {
+            const f32* m = normalMat.m;   // inverse-transpose
+            return Vec3(m[0] * d.x + m[1] * d.y + m[2] * d.z,
+                        m[4] * d.x + m[5] * d.y + m[6] * d.z,
+                        m[8] * d.x + m[9] * d.y + m[10] * d.z).Normalized();
+        };
+
+        for (const auto& prim : mesh.primitives) {
+            if (!doc.ReadPrimitive(prim, sv, idx, weights.empty() ? nullptr : &weights)) continue;
+            u32 base = static_cast<u32>(result.vertices.size());
+            if (!skinned) {
+                for (auto& v : sv) {
+                    v.position  = xformPoint(v.position);
+                    v.normal    = xformNormal(v.normal);
+                    v.tangent   = xformDir(world.m, v.tangent).Normalized();
+                    v.bitangent = xformDir(world.m, v.bitangent).Normalized();
+                }
+            } else if (prim.joints0 >= 0) {
+                result.hasBones = true;
+            }
+            result.vertices.insert(result.vertices.end(), sv.begin(), sv.end());
+            for (size_t i = 0; i + 2 < idx.size(); i += 3) {
+                // A mirroring node transform flips the winding.
+                result.indices.push_back(base + idx[i]);
+                result.indices.push_back(base + idx[mirrored ? i + 2 : i + 1]);
+                result.indices.push_back(base + idx[mirrored ? i + 1 : i + 2]);
+            }
+        }
+    }
+
+    if (result.vertices.empty()) {
+        GV_LOG_WARN("glTF loader — no triangle geometry in: " + path);
+        return false;
+    }
+    GV_LOG_INFO("glTF loader — loaded " + std::to_string(result.vertices.size()) +
+                " vertices, " + std::to_string(result.indices.size() / 3) +
+                " triangles from: " + path);
+    return true;
+}
+
+} // namespace gv
@@ -0,0 +1,284 @@
+// ============================================================================
+// GameVoid Engine — Shared Mesh Registry Implementation
+// ============================================================================
+#include "assets/MeshRegistry.h"
+#include "geometry/MeshBuilder.h"
+#include "renderer/MeshRenderer.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace gv {
+
+namespace {
+
+constexpr u64 kFnvOffset = 1469598103934665603ull;
+constexpr u64 kFnvPrime  = 1099511628211ull;
+
+inline u64 Fnv1a(u64 hash, const void* data, size_t size) {
+    const u8* p = static_cast<const u8*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= p[i];
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
+// Any unit vector perpendicular to n.
+inline Vec3 Perpendicular(const Vec3& n) {
+    Vec3 axis = std::fabs(n.x) < 0.9f ? Vec3(1, 0, 0) : Vec3(0, 1, 0);
+    return n.Cross(axis).Normalized();
+}
+
+bool SameContent(const Mesh& mesh, const std::vector<Vertex>& vertices, const MeshData& data) {
+    const auto& mv = mesh.GetVertices();
+    if (mv.size() != vertices.size()) return false;
+    for (size_t i = 0; i < mv.size(); ++i) {
+        const Vertex& a = mv[i];
+        const Vertex& b = vertices[i];
+        if (a.position.x != b.position.x || a.position.y != b.position.y || a.position.z != b.position.z ||
+            a.normal.x != b.normal.x || a.normal.y != b.normal.y || a.normal.z != b.normal.z ||
+            a.texCoord.x != b.texCoord.x || a.texCoord.y != b.texCoord.y)
+            return false;
+    }
+    // Meshlet builds reorder the index buffer; the count still has to match.
+    if (mesh.GetIndexCount() != data.indices.size()) return false;
+    if (!mesh.HasMeshlets() && !std::equal(data.indices.begin(), data.indices.end(), mesh.GetIndices().begin()))
+        return false;
+    return true;
+}
+
+} // anonymous namespace
+
+// ── Keys and content ───────────────────────────────────────────────────────
+
+void MeshRegistry::AppendKeyPart(std::string& key, const void* bytes, size_t size) {
+    static const char kHex[] = "0123456789abcdef";
+    if (key.back() != '(') key += ',';
+    const u8* p = static_cast<const u8*>(bytes);
+    for (size_t i = 0; i < size; ++i) {
+        key += kHex[p[i] >> 4];
+        key += kHex[p[i] & 0xF];
+    }
+}
+
+u64 MeshRegistry::HashContent(const MeshData& data) {
+    u64 h = kFnvOffset;
+    u64 counts[2] = { data.vertices.size(), data.indices.size() };
+    h = Fnv1a(h, counts, sizeof(counts));
+    for (const auto& v : data.vertices) {
+        f32 f[8] = { v.position.x, v.position.y, v.position.z,
+                     v.normal.x, v.normal.y, v.normal.z, v.uv.x, v.uv.y };
+        h = Fnv1a(h, f, sizeof(f));
+    }
+    if (!data.indices.empty())
+        h = Fnv1a(h, data.indices.data(), data.indices.size() * sizeof(u32));
+    return h;
+}
+
+void MeshRegistry::ConvertVertices(const MeshData& data, std::vector<Vertex>& out) {
+    out.resize(data.vertices.size());
+    std::vector<Vec3> tan(data.vertices.size(), Vec3(0, 0, 0));
+    for (size_t i = 0; i + 2 < data.indices.size(); i += 3) {
+        u32 i0 = data.indices[i], i1 = data.indices[i + 1], i2 = data.indices[i + 2];
+        if (i0 >= data.vertices.size() || i1 >= data.vertices.size() || i2 >= data.vertices.size()) continue;
+        const Vertex3D& v0 = data.vertices[i0];
+        const Vertex3D& v1 = data.vertices[i1];
+        const Vertex3D& v2 = data.vertices[i2];
+        Vec3 e1 = v1.position - v0.position;
+        Vec3 e2 = v2.position - v0.position;
+        f32 du1 = v1.uv.x - v0.uv.x, dv1 = v1.uv.y - v0.uv.y;
+        f32 du2 = v2.uv.x - v0.uv.x, dv2 = v2.uv.y - v0.uv.y;
+        f32 det = du1 * dv2 - du2 * dv1;
+        if (std::fabs(det) < 1e-12f) continue;
+        Vec3 t = (e1 * dv2 - e2 * dv1) * (1.0f / det);
+        tan[i0] = tan[i0] + t;
+        tan[i1] = tan[i1] + t;
+        tan[i2] = tan[i2] + t;
+    }
+    for (size_t i = 0; i < data.vertices.size(); ++i) {
+        const Vertex3D& src = data.vertices[i];
+        Vertex& dst = out[i];
+        dst.position = src.position;
+        dst.normal   = src.normal;
+        dst.texCoord = src.uv;
+        // Gram-Schmidt against the normal; fall back to any perpendicular.
+        Vec3 n = src.normal;
+        Vec3 t = tan[i] - n * n.Dot(tan[i]);
+        t = t.Dot(t) > 1e-12f ? t.Normalized() : Perpendicular(n.Dot(n) > 1e-12f ? n.Normalized() : Vec3(0, 1, 0));
+        dst.tangent   = t;
+        dst.bitangent = n.Cross(t);
+    }
+}
+
+Shared<Mesh> MeshRegistry::BuildMesh(const MeshData& data) {
+    auto mesh = MakeShared<Mesh>(data.name.empty() ? std::string("Generated") : data.name);
+    std::vector<Vertex> vertices;
+    ConvertVertices(data, vertices);
+    mesh->Build(vertices, data.indices);
+    return mesh;
+}
+
+// ── Acquisition ────────────────────────────────────────────────────────────
+
+Shared<Mesh> MeshRegistry::Hit(Entry& entry) {
+    entry.lastUse = ++m_Clock;
+    ++m_Hits;
+    return entry.mesh;
+}
+
+Shared<Mesh> MeshRegistry::Insert(const std::string& key, Shared<Mesh> mesh, u64 contentHash) {
+    ++m_Misses;
+    Entry& entry = m_Entries[key];
+    entry.mesh = std::move(mesh);
+    entry.contentHash = contentHash;
+    entry.lastUse = ++m_Clock;
+    Shared<Mesh> result = entry.mesh;   // referenced, so Trim() keeps it
+    Trim();
+    return result;
+}
+
+Shared<Mesh> MeshRegistry::AcquireMesh(const std::string& key, const std::function<Shared<Mesh>()>& build) {
+    auto it = m_Entries.find(key);
+    if (it != m_Entries.end()) return Hit(it->second);
+    Shared<Mesh> mesh = build ? build() : nullptr;
+    if (!mesh) return nullptr;
+    return Insert(key, std::move(mesh), 0);
+}
+
+Shared<Mesh> MeshRegistry::Acquire(const std::string& key, const Generator& generate) {
+    return AcquireMesh(key, [&]() -> Shared<Mesh> {
+        if (!generate) return nullptr;
+        return BuildMesh(generate());
+    });
+}
+
+Shared<Mesh> MeshRegistry::AcquireData(const MeshData& data) {
+    const u64 hash = HashContent(data);
+    char hex[17];
+    static const char kHex[] = "0123456789abcdef";
+    for (int i = 0; i < 16; ++i) hex[i] = kHex[(hash >> (60 - 4 * i)) & 0xF];
+    hex[16] = '\0';
+    const std::string base = std::string("data:") + hex;
+
+    // Equal hashes are compared in full; a genuine collision gets its own
+    // numbered key.
+    std::vector<Vertex> vertices;
+    ConvertVertices(data, vertices);
+    std::string key = base;
+    for (u32 n = 1;; ++n) {
+        auto it = m_Entries.find(key);
+        if (it == m_Entries.end()) break;
+        if (SameContent(*it->second.mesh, vertices, data)) return Hit(it->second);
+        key = base + "#" + std::to_string(n);
+    }
+
+    auto mesh = MakeShared<Mesh>(data.name.empty() ? std::string("Generated") : data.name);
+    mesh->Build(vertices, data.indices);
+    return Insert(key, std::move(mesh), hash);
+}
+
+Shared<Mesh> MeshRegistry::AcquireBuilt(const MeshBuilder& builder, const std::string& name) {
+    return AcquireData(builder.Build(name));
+}
+
+Shared<Mesh> MeshRegistry::Cube() {
+    return AcquireMesh("Mesh::CreateCube()", [] { return Mesh::CreateCube(); });
+}
+
+Shared<Mesh> MeshRegistry::Sphere(u32 segments, u32 rings) {
+    return AcquireMesh(MakeKey("Mesh::CreateSphere", segments, rings),
+                        [&] { return Mesh::CreateSphere(segments, rings); });
+}
+
+Shared<Mesh> MeshRegistry::Plane(f32 width, f32 depth) {
+    return AcquireMesh(MakeKey("Mesh::CreatePlane", width, depth),
+                        [&] { return Mesh::CreatePlane(width, depth); });
+}
+
+Shared<Mesh> MeshRegistry::Quad() {
+    return AcquireMesh("Mesh::CreateQuad()", [] { return Mesh::CreateQuad(); });
+}
+
+Shared<Mesh> MeshRegistry::Triangle() {
+    return AcquireMesh("Mesh::CreateTriangle()", [] { return Mesh::CreateTriangle(); });
+}
+
+Shared<Mesh> MeshRegistry::Primitive(PrimitiveType type) {
+    switch (type) {
+        case PrimitiveType::Triangle: return Triangle();
+        case PrimitiveType::Cube:     return Cube();
+        case PrimitiveType::Plane:    return Plane(1.0f, 1.0f);   // the renderer's unit plane
+        case PrimitiveType::None:     break;
+    }
+    return nullptr;
+}
+
+// ── Inspection ─────────────────────────────────────────────────────────────
+
+i32 MeshRegistry::GetRefCount(const std::string& key) const {
+    auto it = m_Entries.find(key);
+    if (it == m_Entries.end()) return -1;
+    return static_cast<i32>(it->second.mesh.use_count()) - 1;
+}
+
+MeshRegistryStats MeshRegistry::GetStats() const {
+    MeshRegistryStats s;
+    s.entries   = static_cast<u32>(m_Entries.size());
+    s.hits      = m_Hits;
+    s.misses    = m_Misses;
+    s.evictions = m_Evictions;
+    for (const auto& kv : m_Entries) {
+        const Mesh& mesh = *kv.second.mesh;
+        u64 bytes = mesh.GetMemoryBytes();
+        s.cpuBytes += bytes;
+        if (mesh.IsUploaded()) s.gpuBytes += bytes;
+        if (kv.second.mesh.use_count() > 1) ++s.referenced;
+        else                                s.cachedBytes += bytes;
+    }
+    return s;
+}
+
+// ── Eviction ───────────────────────────────────────────────────────────────
+
+u32 MeshRegistry::EvictUnreferenced() {
+    u32 dropped = 0;
+    for (auto it = m_Entries.begin(); it != m_Entries.end();) {
+        if (it->second.mesh.use_count() == 1) {
+            it = m_Entries.erase(it);
+            ++dropped;
+        } else {
+            ++it;
+        }
+    }
+    m_Evictions += dropped;
+    return dropped;
+}
+
+u32 MeshRegistry::Trim() {
+    std::vector<std::pair<u64, const std::string*>> idle;   // (lastUse, key)
+    u64 cached = 0;
+    for (const auto& kv : m_Entries) {
+        if (kv.second.mesh.use_count() != 1) continue;
+        cached += kv.second.mesh->GetMemoryBytes();
+        idle.emplace_back(kv.second.lastUse, &kv.first);
+    }
+    if (cached <= m_CacheBudget) return 0;
+
+    std::sort(idle.begin(), idle.end());
+    std::vector<std::string> victims;
+    for (const auto& e : idle) {
+        if (cached <= m_CacheBudget) break;
+        cached -= m_Entries.at(*e.second).mesh->GetMemoryBytes();
+        victims.push_back(*e.second);
+    }
+    for (const auto& key : victims) m_Entries.erase(key);
+    m_Evictions += victims.size();
+    return static_cast<u32>(victims.size());
+}
+
+void MeshRegistry::Clear() {
+    m_Entries.clear();
+}
+
+} // namespace gv
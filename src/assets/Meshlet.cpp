@@ -0,0 +1,305 @@
+// ============================================================================
+// GameVoid Engine — Meshlet Builder Implementation
+// ============================================================================
+#include "assets/Meshlet.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace gv {
+
+namespace {
+
+/// Uniform grid over triangle centroids, used to find the nearest free
+/// triangle when a meshlet has no free neighbours left.
+class TriangleGrid {
+public:
+    void Build(const std::vector<Vec3>& centroids) {
+        Vec3 mn = centroids[0], mx = centroids[0];
+        for (auto& c : centroids) {
+            mn.x = std::min(mn.x, c.x); mn.y = std::min(mn.y, c.y); mn.z = std::min(mn.z, c.z);
+            mx.x = std::max(mx.x, c.x); mx.y = std::max(mx.y, c.y); mx.z = std::max(mx.z, c.z);
+        }
+        Vec3 ext = mx - mn;
+        m_Origin = mn;
+
+        // Cell size for roughly four triangles per cell: bisect on the size.
+        const f64 target = std::max<f64>(1.0, static_cast<f64>(centroids.size()) / 4.0);
+        f32 lo = 0.0f, hi = std::max(std::max(ext.x, ext.y), std::max(ext.z, 1e-6f));
+        for (int it = 0; it < 32; ++it) {
+            f32 mid = 0.5f * (lo + hi);
+            if (mid <= 0.0f) break;
+            f64 cells = 1.0;
+            for (f32 e : { ext.x, ext.y, ext.z }) cells *= std::min(1024.0, std::max(1.0, std::ceil(static_cast<f64>(e) / mid)));
+            if (cells > target) lo = mid; else hi = mid;
+        }
+        m_Cell = hi;
+        for (int a = 0; a < 3; ++a) {
+            f32 e = a == 0 ? ext.x : a == 1 ? ext.y : ext.z;
+            m_Dim[a] = static_cast<i32>(std::min(1024.0f, std::max(1.0f, std::ceil(e / m_Cell))));
+        }
+
+        size_t cellCount = static_cast<size_t>(m_Dim[0]) * m_Dim[1] * m_Dim[2];
+        m_Start.assign(cellCount + 1, 0);
+        std::vector<u32> cellOf(centroids.size());
+        for (size_t t = 0; t < centroids.size(); ++t) {
+            cellOf[t] = CellIndex(CellCoord(centroids[t], 0), CellCoord(centroids[t], 1), CellCoord(centroids[t], 2));
+            m_Start[cellOf[t] + 1]++;
+        }
+        for (size_t c = 0; c < cellCount; ++c) m_Start[c + 1] += m_Start[c];
+        m_Cursor.assign(m_Start.begin(), m_Start.end() - 1);
+        m_Tris.resize(centroids.size());
+        std::vector<u32> fill(m_Cursor);
+        for (size_t t = 0; t < centroids.size(); ++t) m_Tris[fill[cellOf[t]]++] = static_cast<u32>(t);
+    }
+
+    /// Nearest free triangle to `p` within `maxRing` cells, or -1.
+    i64 FindNearest(const Vec3& p, const std::vector<Vec3>& centroids, const std::vector<u8>& used, int maxRing) {
+        i32 c[3] = { CellCoord(p, 0), CellCoord(p, 1), CellCoord(p, 2) };
+        i64 best = -1;
+        f32 bestD = 0.0f;
+        for (int r = 0; r <= maxRing; ++r) {
+            for (i32 z = c[2] - r; z <= c[2] + r; ++z) {
+                if (z < 0 || z >= m_Dim[2]) continue;
+                for (i32 y = c[1] - r; y <= c[1] + r; ++y) {
+                    if (y < 0 || y >= m_Dim[1]) continue;
+                    for (i32 x = c[0] - r; x <= c[0] + r; ++x) {
+                        if (x < 0 || x >= m_Dim[0]) continue;
+                        // Only the shell of this ring.
+                        if (std::max(std::abs(x - c[0]), std::max(std::abs(y - c[1]), std::abs(z - c[2]))) != r) continue;
+                        u32 cell = CellIndex(x, y, z);
+                        u32& cur = m_Cursor[cell];
+                        while (cur < m_Start[cell + 1] && used[m_Tris[cur]]) ++cur;   // drop used prefix
+                        for (u32 k = cur; k < m_Start[cell + 1]; ++k) {
+                            u32 t = m_Tris[k];
+                            if (used[t]) continue;
+                            Vec3 d = centroids[t] - p;
+                            f32 d2 = d.Dot(d);
+                            if (best < 0 || d2 < bestD) { best = t; bestD = d2; }
+                        }
+                    }
+                }
+            }
+            // Anything in a later ring is at least r cells away.
+            f32 reach = static_cast<f32>(r) * m_Cell;
+            if (best >= 0 && bestD <= reach * reach) break;
+        }
+        return best;
+    }
+
+private:
+    i32 CellCoord(const Vec3& p, int axis) const {
+        f32 v = axis == 0 ? p.x - m_Origin.x : axis == 1 ? p.y - m_Origin.y : p.z - m_Origin.z;
+        i32 c = static_cast<i32>(v / m_Cell);
+        return std::min(std::max(c, 0), m_Dim[axis] - 1);
+    }
+    u32 CellIndex(i32 x, i32 y, i32 z) const {
+        return static_cast<u32>((z * m_Dim[1] + y) * m_Dim[0] + x);
+    }
+
+    Vec3             m_Origin;
+    f32              m_Cell = 1.0f;
+    i32              m_Dim[3] = { 1, 1, 1 };
+    std::vector<u32> m_Start;    // per-cell ranges into m_Tris
+    std::vector<u32> m_Cursor;   // first possibly-free entry per cell
+    std::vector<u32> m_Tris;
+};
+
+/// Bounding sphere and normal cone of one finished meshlet.  `tris` are
+/// triangle numbers into `indices`.
+void ComputeMeshletBounds(Meshlet& m, const std::vector<u32>& verts, const std::vector<u32>& tris,
+                          const std::vector<u32>& indices, const std::vector<Vec3>& pos,
+                          const std::vector<Vec3>& normals) {
+    Vec3 mn = pos[verts[0]], mx = pos[verts[0]];
+    for (u32 v : verts) {
+        const Vec3& p = pos[v];
+        mn.x = std::min(mn.x, p.x); mn.y = std::min(mn.y, p.y); mn.z = std::min(mn.z, p.z);
+        mx.x = std::max(mx.x, p.x); mx.y = std::max(mx.y, p.y); mx.z = std::max(mx.z, p.z);
+    }
+    m.center = (mn + mx) * 0.5f;
+    f32 r2 = 0.0f;
+    for (u32 v : verts) { Vec3 d = pos[v] - m.center; r2 = std::max(r2, d.Dot(d)); }
+    m.radius = std::sqrt(r2);
+
+    // Cone: the average normal, and how far the normals stray from it.
+    Vec3 axis(0, 0, 0);
+    for (u32 t : tris) axis = axis + normals[t];
+    m.coneAxis = Vec3(0, 0, 1);
+    m.coneApex = m.center;
+    m.coneCutoff = 1.0f;
+    if (axis.Length() < 1e-6f) return;
+    axis = axis.Normalized();
+    f32 minDot = 1.0f;
+    for (u32 t : tris) {
+        const Vec3& n = normals[t];
+        if (n.Dot(n) > 0.0f) minDot = std::min(minDot, n.Dot(axis));
+    }
+    m.coneAxis = axis;
+    if (minDot <= 0.1f) return;   // wider than ~84°: never fully backfacing in practice
+
+    // Apex: slide back along the axis until the point is behind every
+    // triangle's plane; viewers inside the reflected cone see only backs.
+    f32 maxT = 0.0f;
+    for (u32 t : tris) {
+        const Vec3& n = normals[t];
+        if (n.Dot(n) == 0.0f) continue;
+        f32 dc = (m.center - pos[indices[t * 3]]).Dot(n);
+        maxT = std::max(maxT, dc / n.Dot(axis));
+    }
+    m.coneApex = m.center - axis * maxT;
+    m.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+}
+
+} // namespace
+
+void BuildMeshlets(const std::vector<u32>& indices, const f32* positions, size_t vertexCount,
+                   size_t positionStride, MeshletData& out, std::vector<u32>& outIndices,
+                   const MeshletBuildSettings& settings) {
+    out.Clear();
+    outIndices.clear();
+    const u32 maxV = std::max<u32>(3, std::min<u32>(settings.maxVertices, 255));
+    const u32 maxT = std::max<u32>(1, std::min<u32>(settings.maxTriangles, 512));
+
+    // Positions, and the triangles that reference valid vertices.
+    std::vector<Vec3> pos(vertexCount);
+    const u8* base = reinterpret_cast<const u8*>(positions);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        f32 p[3];
+        std::memcpy(p, base + v * positionStride, sizeof(p));
+        pos[v] = Vec3(p[0], p[1], p[2]);
+    }
+    std::vector<u32> tri;
+    tri.reserve(indices.size());
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        u32 a = indices[i], b = indices[i + 1], c = indices[i + 2];
+        if (a >= vertexCount || b >= vertexCount || c >= vertexCount) continue;
+        tri.push_back(a); tri.push_back(b); tri.push_back(c);
+    }
+    const u32 triCount = static_cast<u32>(tri.size() / 3);
+    if (triCount == 0) return;
+
+    std::vector<Vec3> normals(triCount), centroids(triCount);
+    for (u32 t = 0; t < triCount; ++t) {
+        const Vec3& a = pos[tri[t * 3]];
+        const Vec3& b = pos[tri[t * 3 + 1]];
+        const Vec3& c = pos[tri[t * 3 + 2]];
+        Vec3 n = (b - a).Cross(c - a);
+        f32 len = n.Length();
+        normals[t] = len > 1e-12f ? n * (1.0f / len) : Vec3(0, 0, 0);
+        centroids[t] = (a + b + c) * (1.0f / 3.0f);
+    }
+
+    // Vertex → triangle adjacency (CSR).
+    std::vector<u32> adjStart(vertexCount + 1, 0), adj(tri.size());
+    for (u32 v : tri) adjStart[v + 1]++;
+    for (size_t v = 0; v < vertexCount; ++v) adjStart[v + 1] += adjStart[v];
+    {
+        std::vector<u32> fill(adjStart.begin(), adjStart.end() - 1);
+        for (size_t i = 0; i < tri.size(); ++i) adj[fill[tri[i]]++] = static_cast<u32>(i / 3);
+    }
+
+    TriangleGrid grid;
+    grid.Build(centroids);
+
+    std::vector<u8>  used(triCount, 0);
+    std::vector<u8>  local(vertexCount, 0xFF);
+    std::vector<u32> mVerts, mTris;
+    mVerts.reserve(maxV);
+    mTris.reserve(maxT);
+    Vec3 centroidSum(0, 0, 0), normalSum(0, 0, 0);
+    // Free triangles touching the current meshlet, stamped per meshlet so
+    // each is listed once.
+    std::vector<u32> candidates, candStamp(triCount, 0);
+    u32 meshletId = 1;
+    u32 scan = 0;
+    out.meshlets.reserve(triCount / maxT + 1);
+    outIndices.reserve(tri.size());
+
+    auto extraVerts = [&](u32 t) {
+        return static_cast<u32>(local[tri[t * 3]] == 0xFF) + static_cast<u32>(local[tri[t * 3 + 1]] == 0xFF) +
+               static_cast<u32>(local[tri[t * 3 + 2]] == 0xFF);
+    };
+    auto addTriangle = [&](u32 t) {
+        used[t] = 1;
+        mTris.push_back(t);
+        for (int k = 0; k < 3; ++k) {
+            u32 v = tri[t * 3 + k];
+            if (local[v] != 0xFF) continue;
+            local[v] = static_cast<u8>(mVerts.size());
+            mVerts.push_back(v);
+            // A new vertex brings its free triangles onto the candidate list.
+            for (u32 k = adjStart[v]; k < adjStart[v + 1]; ++k) {
+                u32 n = adj[k];
+                if (!used[n] && candStamp[n] != meshletId) { candStamp[n] = meshletId; candidates.push_back(n); }
+            }
+        }
+        centroidSum = centroidSum + centroids[t];
+        normalSum = normalSum + normals[t];
+    };
+    auto finishMeshlet = [&]() {
+        Meshlet m;
+        m.vertexOffset = static_cast<u32>(out.vertices.size());
+        m.vertexCount = static_cast<u32>(mVerts.size());
+        m.triangleOffset = static_cast<u32>(out.triangles.size() / 3);
+        m.triangleCount = static_cast<u32>(mTris.size());
+        m.firstIndex = static_cast<u32>(outIndices.size());
+        m.indexCount = m.triangleCount * 3;
+        for (u32 t : mTris)
+            for (int k = 0; k < 3; ++k) {
+                u32 v = tri[t * 3 + k];
+                out.triangles.push_back(local[v]);
+                outIndices.push_back(v);
+            }
+        out.vertices.insert(out.vertices.end(), mVerts.begin(), mVerts.end());
+        ComputeMeshletBounds(m, mVerts, mTris, tri, pos, normals);
+        out.meshlets.push_back(m);
+
+        for (u32 v : mVerts) local[v] = 0xFF;
+        mVerts.clear();
+        mTris.clear();
+        candidates.clear();
+        ++meshletId;
+        centroidSum = normalSum = Vec3(0, 0, 0);
+    };
+
+    for (;;) {
+        if (mTris.empty()) {
+            while (scan < triCount && used[scan]) ++scan;
+            if (scan == triCount) break;
+            addTriangle(scan);
+        }
+        if (mTris.size() >= maxT) { finishMeshlet(); continue; }
+
+        // Best free neighbour: fewest new vertices, then closest to the
+        // meshlet centre, weighted by how far its normal turns away.
+        Vec3 center = centroidSum * (1.0f / static_cast<f32>(mTris.size()));
+        Vec3 avgN = normalSum.Length() > 1e-6f ? normalSum.Normalized() : Vec3(0, 0, 0);
+        // Scores are compared squared to keep sqrt out of the inner loop.
+        i64 best = -1;
+        u32 bestExtra = 4;
+        f32 bestScore = 0.0f;
+        size_t keep = 0;
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            u32 t = candidates[i];
+            if (used[t]) continue;
+            candidates[keep++] = t;
+            u32 extra = extraVerts(t);
+            if (mVerts.size() + extra > maxV || extra > bestExtra) continue;
+            Vec3 d = centroids[t] - center;
+            f32 w = 1.0f + settings.coneWeight * (1.0f - normals[t].Dot(avgN));
+            f32 score = d.Dot(d) * w * w;
+            if (extra < bestExtra || score < bestScore) { best = t; bestExtra = extra; bestScore = score; }
+        }
+        candidates.resize(keep);
+        if (best < 0 && mVerts.size() + 3 <= maxV) {
+            // No free neighbours: continue with the nearest free triangle so
+            // small disconnected pieces share meshlets.
+            best = grid.FindNearest(center, centroids, used, 2);
+        }
+        if (best < 0 || mVerts.size() + extraVerts(static_cast<u32>(best)) > maxV) { finishMeshlet(); continue; }
+        addTriangle(static_cast<u32>(best));
+    }
+    if (!mTris.empty()) finishMeshlet();
+}
+
+} // namespace gv
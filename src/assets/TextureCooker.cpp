@@ -0,0 +1,903 @@
+// ============================================================================
+// GameVoid Engine — Texture Cooker Implementation
+// ============================================================================
+#include "assets/TextureCooker.h"
+
+#ifdef GV_HAS_GLFW
+#include "stb/stb_image.h"
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <thread>
+
+namespace gv {
+
+const char* TextureFormatName(TextureFormat fmt) {
+    switch (fmt) {
+        case TextureFormat::RGBA8: return "RGBA8";
+        case TextureFormat::BC1:   return "BC1";
+        case TextureFormat::BC3:   return "BC3";
+        case TextureFormat::BC4:   return "BC4";
+        case TextureFormat::BC5:   return "BC5";
+        case TextureFormat::BC7:   return "BC7";
+    }
+    return "?";
+}
+
+bool IsBlockCompressed(TextureFormat fmt) { return fmt != TextureFormat::RGBA8; }
+
+namespace {
+
+// ── Colour space ───────────────────────────────────────────────────────────
+struct SRGBTable {
+    f32 toLinear[256];
+    SRGBTable() {
+        for (int i = 0; i < 256; ++i) {
+            f32 c = static_cast<f32>(i) / 255.0f;
+            toLinear[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+    }
+};
+const SRGBTable& SRGB() { static SRGBTable t; return t; }
+
+u8 ToByte(f32 v) {
+    v = std::min(std::max(v, 0.0f), 1.0f);
+    return static_cast<u8>(v * 255.0f + 0.5f);
+}
+
+u8 LinearToSRGB(f32 v) {
+    v = std::min(std::max(v, 0.0f), 1.0f);
+    f32 s = v <= 0.0031308f ? v * 12.92f : 1.055f * std::pow(v, 1.0f / 2.4f) - 0.055f;
+    return ToByte(s);
+}
+
+// ── Mip filters ────────────────────────────────────────────────────────────
+f64 BesselI0(f64 x) {
+    f64 sum = 1.0, term = 1.0, q = x * x / 4.0;
+    for (int k = 1; k < 32; ++k) {
+        term *= q / (static_cast<f64>(k) * k);
+        sum += term;
+        if (term < sum * 1e-12) break;
+    }
+    return sum;
+}
+
+constexpr f64 kKaiserRadius = 1.5;   // in destination texels
+constexpr f64 kKaiserAlpha  = 4.0;
+
+f64 KaiserWeight(f64 x) {
+    if (std::fabs(x) >= kKaiserRadius) return 0.0;
+    f64 sinc = std::fabs(x) < 1e-6 ? 1.0 : std::sin(3.14159265358979 * x) / (3.14159265358979 * x);
+    f64 r = x / kKaiserRadius;
+    return sinc * BesselI0(kKaiserAlpha * std::sqrt(1.0 - r * r)) / BesselI0(kKaiserAlpha);
+}
+
+/// Taps for one output texel along one axis.
+struct Taps {
+    std::vector<i32> index;
+    std::vector<f32> weight;
+};
+
+std::vector<Taps> BuildTaps(u32 srcSize, u32 dstSize, MipFilter filter, bool wrap) {
+    std::vector<Taps> taps(dstSize);
+    f64 scale = static_cast<f64>(srcSize) / dstSize;
+    for (u32 i = 0; i < dstSize; ++i) {
+        f64 centre = (i + 0.5) * scale;
+        Taps& t = taps[i];
+        f64 total = 0.0;
+        auto add = [&](i64 j, f64 w) {
+            if (w == 0.0) return;
+            i64 n = static_cast<i64>(srcSize);
+            i64 k = wrap ? ((j % n) + n) % n : std::min(std::max<i64>(j, 0), n - 1);
+            t.index.push_back(static_cast<i32>(k));
+            t.weight.push_back(static_cast<f32>(w));
+            total += w;
+        };
+        if (filter == MipFilter::Box || scale <= 1.0) {
+            f64 lo = centre - scale * 0.5, hi = centre + scale * 0.5;
+            for (i64 j = static_cast<i64>(std::floor(lo)); j < static_cast<i64>(std::ceil(hi)); ++j)
+                add(j, std::min(hi, static_cast<f64>(j + 1)) - std::max(lo, static_cast<f64>(j)));
+        } else {
+            f64 support = kKaiserRadius * scale;
+            for (i64 j = static_cast<i64>(std::floor(centre - support));
+                 j <= static_cast<i64>(std::ceil(centre + support)); ++j)
+                add(j, KaiserWeight(((j + 0.5) - centre) / scale));
+        }
+        for (auto& w : t.weight) w = static_cast<f32>(w / total);
+    }
+    return taps;
+}
+
+// ── Block helpers ──────────────────────────────────────────────────────────
+void GatherBlock(const ImageRGBA8& img, u32 bx, u32 by, u8 out[64]) {
+    for (u32 y = 0; y < 4; ++y) {
+        u32 sy = std::min(by * 4 + y, img.height - 1);
+        for (u32 x = 0; x < 4; ++x) {
+            u32 sx = std::min(bx * 4 + x, img.width - 1);
+            std::memcpy(out + (y * 4 + x) * 4, img.At(sx, sy), 4);
+        }
+    }
+}
+
+void ScatterBlock(ImageRGBA8& img, u32 bx, u32 by, const u8 in[64]) {
+    for (u32 y = 0; y < 4 && by * 4 + y < img.height; ++y)
+        for (u32 x = 0; x < 4 && bx * 4 + x < img.width; ++x)
+            std::memcpy(img.At(bx * 4 + x, by * 4 + y), in + (y * 4 + x) * 4, 4);
+}
+
+size_t BlockBytes(TextureFormat fmt) {
+    return (fmt == TextureFormat::BC1 || fmt == TextureFormat::BC4) ? 8 : 16;
+}
+
+/// Principal axis of `n` points of dimension `dim` (power iteration on the
+/// covariance).  Falls back to the diagonal for degenerate sets.
+void PrincipalAxis(const f32* pts, int n, int dim, f32* mean, f32* axis) {
+    for (int d = 0; d < dim; ++d) {
+        mean[d] = 0.0f;
+        for (int i = 0; i < n; ++i) mean[d] += pts[i * dim + d];
+        mean[d] /= static_cast<f32>(n);
+    }
+    f32 cov[16] = {};
+    for (int i = 0; i < n; ++i)
+        for (int a = 0; a < dim; ++a)
+            for (int b = 0; b < dim; ++b)
+                cov[a * dim + b] += (pts[i * dim + a] - mean[a]) * (pts[i * dim + b] - mean[b]);
+    for (int d = 0; d < dim; ++d) axis[d] = 1.0f;
+    for (int it = 0; it < 8; ++it) {
+        f32 v[4] = {};
+        for (int a = 0; a < dim; ++a)
+            for (int b = 0; b < dim; ++b) v[a] += cov[a * dim + b] * axis[b];
+        f32 len = 0.0f;
+        for (int d = 0; d < dim; ++d) len += v[d] * v[d];
+        if (len < 1e-12f) break;
+        len = std::sqrt(len);
+        for (int d = 0; d < dim; ++d) axis[d] = v[d] / len;
+    }
+}
+
+// ── BC1 ────────────────────────────────────────────────────────────────────
+u16 Pack565(const f32 c[3]) {
+    auto q = [](f32 v, int bits) {
+        int maxv = (1 << bits) - 1;
+        return std::min(std::max(static_cast<int>(v / 255.0f * maxv + 0.5f), 0), maxv);
+    };
+    return static_cast<u16>((q(c[0], 5) << 11) | (q(c[1], 6) << 5) | q(c[2], 5));
+}
+
+void Unpack565(u16 c, int out[3]) {
+    int r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+    out[0] = (r << 3) | (r >> 2);
+    out[1] = (g << 2) | (g >> 4);
+    out[2] = (b << 3) | (b >> 2);
+}
+
+/// 4-colour palette for two 565 endpoints (the interpretation BC3 always uses).
+void Palette4(u16 c0, u16 c1, int pal[4][3]) {
+    Unpack565(c0, pal[0]);
+    Unpack565(c1, pal[1]);
+    for (int k = 0; k < 3; ++k) {
+        pal[2][k] = (2 * pal[0][k] + pal[1][k]) / 3;
+        pal[3][k] = (pal[0][k] + 2 * pal[1][k]) / 3;
+    }
+}
+
+/// Choose the best 4-colour index per texel; returns total squared error.
+u32 AssignBC1(const u8 rgba[64], u16 c0, u16 c1, u8 idx[16]) {
+    int pal[4][3];
+    Palette4(c0, c1, pal);
+    u32 total = 0;
+    for (int i = 0; i < 16; ++i) {
+        u32 best = std::numeric_limits<u32>::max();
+        for (int p = 0; p < 4; ++p) {
+            int dr = rgba[i * 4] - pal[p][0], dg = rgba[i * 4 + 1] - pal[p][1], db = rgba[i * 4 + 2] - pal[p][2];
+            u32 e = static_cast<u32>(dr * dr + dg * dg + db * db);
+            if (e < best) { best = e; idx[i] = static_cast<u8>(p); }
+        }
+        total += best;
+    }
+    return total;
+}
+
+/// Least-squares endpoints for fixed indices (weights 1, 0, 2/3, 1/3 on c0).
+bool SolveEndpoints(const f32* pts, int dim, const u8* idx, const f32* w0, int n,
+                    f32* e0, f32* e1) {
+    f32 aa = 0, bb = 0, ab = 0;
+    f32 ax[4] = {}, bx[4] = {};
+    for (int i = 0; i < n; ++i) {
+        f32 a = w0[idx[i]], b = 1.0f - a;
+        aa += a * a; bb += b * b; ab += a * b;
+        for (int d = 0; d < dim; ++d) { ax[d] += a * pts[i * dim + d]; bx[d] += b * pts[i * dim + d]; }
+    }
+    f32 det = aa * bb - ab * ab;
+    if (std::fabs(det) < 1e-6f) return false;
+    for (int d = 0; d < dim; ++d) {
+        e0[d] = std::min(std::max((ax[d] * bb - bx[d] * ab) / det, 0.0f), 255.0f);
+        e1[d] = std::min(std::max((bx[d] * aa - ax[d] * ab) / det, 0.0f), 255.0f);
+    }
+    return true;
+}
+
+void WriteBC1(u16 c0, u16 c1, const u8 idx[16], u8 out[8]) {
+    // Keep 4-colour mode: colour0 must compare greater than colour1.
+    u8 map[4] = { 0, 1, 2, 3 };
+    if (c0 < c1) { std::swap(c0, c1); map[0] = 1; map[1] = 0; map[2] = 3; map[3] = 2; }
+    u32 bits = 0;
+    if (c0 != c1)
+        for (int i = 0; i < 16; ++i) bits |= static_cast<u32>(map[idx[i]]) << (2 * i);
+    out[0] = static_cast<u8>(c0); out[1] = static_cast<u8>(c0 >> 8);
+    out[2] = static_cast<u8>(c1); out[3] = static_cast<u8>(c1 >> 8);
+    for (int k = 0; k < 4; ++k) out[4 + k] = static_cast<u8>(bits >> (8 * k));
+}
+
+// ── BC4 ────────────────────────────────────────────────────────────────────
+void PaletteBC4(int a0, int a1, int pal[8]) {
+    pal[0] = a0; pal[1] = a1;
+    if (a0 > a1) {
+        for (int i = 1; i <= 6; ++i) pal[1 + i] = ((7 - i) * a0 + i * a1 + 3) / 7;
+    } else {
+        for (int i = 1; i <= 4; ++i) pal[1 + i] = ((5 - i) * a0 + i * a1 + 2) / 5;
+        pal[6] = 0; pal[7] = 255;
+    }
+}
+
+u32 AssignBC4(const u8 v[16], int a0, int a1, u8 idx[16]) {
+    int pal[8];
+    PaletteBC4(a0, a1, pal);
+    u32 total = 0;
+    for (int i = 0; i < 16; ++i) {
+        u32 best = std::numeric_limits<u32>::max();
+        for (int p = 0; p < 8; ++p) {
+            int d = v[i] - pal[p];
+            u32 e = static_cast<u32>(d * d);
+            if (e < best) { best = e; idx[i] = static_cast<u8>(p); }
+        }
+        total += best;
+    }
+    return total;
+}
+
+// ── BC7 mode 6 ─────────────────────────────────────────────────────────────
+const int kBC7Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+struct BitWriter {
+    u8  bytes[16] = {};
+    u32 pos = 0;
+    void Put(u32 value, u32 bits) {
+        for (u32 i = 0; i < bits; ++i, ++pos)
+            if (value & (1u << i)) bytes[pos >> 3] |= static_cast<u8>(1u << (pos & 7));
+    }
+};
+
+struct BitReader {
+    const u8* bytes;
+    u32 pos = 0;
+    explicit BitReader(const u8* b) : bytes(b) {}
+    u32 Get(u32 bits) {
+        u32 v = 0;
+        for (u32 i = 0; i < bits; ++i, ++pos)
+            v |= static_cast<u32>((bytes[pos >> 3] >> (pos & 7)) & 1u) << i;
+        return v;
+    }
+};
+
+int InterpBC7(int e0, int e1, int w) { return ((64 - w) * e0 + w * e1 + 32) >> 6; }
+
+/// Quantise a float endpoint to 7 bits + shared p-bit.
+void QuantiseBC7(const f32 e[4], int p, int q7[4], int full[4]) {
+    for (int c = 0; c < 4; ++c) {
+        int v = static_cast<int>(std::floor((e[c] - p) / 2.0f + 0.5f));
+        q7[c] = std::min(std::max(v, 0), 127);
+        full[c] = (q7[c] << 1) | p;
+    }
+}
+
+u32 AssignBC7(const u8 rgba[64], const int e0[4], const int e1[4], u8 idx[16]) {
+    int pal[16][4];
+    for (int w = 0; w < 16; ++w)
+        for (int c = 0; c < 4; ++c) pal[w][c] = InterpBC7(e0[c], e1[c], kBC7Weights4[w]);
+    u32 total = 0;
+    for (int i = 0; i < 16; ++i) {
+        u32 best = std::numeric_limits<u32>::max();
+        for (int w = 0; w < 16; ++w) {
+            u32 e = 0;
+            for (int c = 0; c < 4; ++c) { int d = rgba[i * 4 + c] - pal[w][c]; e += static_cast<u32>(d * d); }
+            if (e < best) { best = e; idx[i] = static_cast<u8>(w); }
+        }
+        total += best;
+    }
+    return total;
+}
+
+} // namespace
+
+// ============================================================================
+// Mips
+// ============================================================================
+ImageRGBA8 TextureCooker::Downsample(const ImageRGBA8& src, const TextureCookSettings& settings) {
+    u32 dw = std::max(1u, src.width / 2), dh = std::max(1u, src.height / 2);
+    bool srgb = settings.srgb && !settings.normalMap;
+
+    // Decode to linear floats
+    std::vector<f32> lin(static_cast<size_t>(src.width) * src.height * 4);
+    const auto& lut = SRGB().toLinear;
+    for (size_t i = 0, n = static_cast<size_t>(src.width) * src.height; i < n; ++i) {
+        const u8* p = &src.pixels[i * 4];
+        f32* q = &lin[i * 4];
+        for (int c = 0; c < 3; ++c) {
+            if (settings.normalMap) q[c] = p[c] / 127.5f - 1.0f;
+            else if (srgb)          q[c] = lut[p[c]];
+            else                    q[c] = p[c] / 255.0f;
+        }
+        q[3] = p[3] / 255.0f;
+    }
+
+    // Separable resample: horizontal then vertical
+    auto tx = BuildTaps(src.width, dw, settings.filter, settings.wrap);
+    auto ty = BuildTaps(src.height, dh, settings.filter, settings.wrap);
+    std::vector<f32> tmp(static_cast<size_t>(dw) * src.height * 4, 0.0f);
+    for (u32 y = 0; y < src.height; ++y)
+        for (u32 x = 0; x < dw; ++x) {
+            f32* o = &tmp[(static_cast<size_t>(y) * dw + x) * 4];
+            const Taps& t = tx[x];
+            for (size_t k = 0; k < t.index.size(); ++k) {
+                const f32* s = &lin[(static_cast<size_t>(y) * src.width + t.index[k]) * 4];
+                for (int c = 0; c < 4; ++c) o[c] += s[c] * t.weight[k];
+            }
+        }
+
+    ImageRGBA8 dst(dw, dh);
+    for (u32 y = 0; y < dh; ++y)
+        for (u32 x = 0; x < dw; ++x) {
+            f32 v[4] = {};
+            const Taps& t = ty[y];
+            for (size_t k = 0; k < t.index.size(); ++k) {
+                const f32* s = &tmp[(static_cast<size_t>(t.index[k]) * dw + x) * 4];
+                for (int c = 0; c < 4; ++c) v[c] += s[c] * t.weight[k];
+            }
+            u8* o = dst.At(x, y);
+            if (settings.normalMap) {
+                f32 len = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+                if (len < 1e-6f) { v[0] = 0; v[1] = 0; v[2] = 1; len = 1; }
+                for (int c = 0; c < 3; ++c) o[c] = ToByte((v[c] / len) * 0.5f + 0.5f);
+            } else {
+                for (int c = 0; c < 3; ++c) o[c] = srgb ? LinearToSRGB(v[c]) : ToByte(v[c]);
+            }
+            o[3] = ToByte(v[3]);
+        }
+    return dst;
+}
+
+std::vector<ImageRGBA8> TextureCooker::BuildMipChain(const ImageRGBA8& base,
+                                                     const TextureCookSettings& settings) {
+    std::vector<ImageRGBA8> chain;
+    chain.push_back(base);
+    while (chain.back().width > 1 || chain.back().height > 1)
+        chain.push_back(Downsample(chain.back(), settings));
+    return chain;
+}
+
+// ============================================================================
+// Block codecs
+// ============================================================================
+void TextureCooker::EncodeBlockBC1(const u8 rgba[64], u8 out[8]) {
+    f32 pts[48];
+    for (int i = 0; i < 16; ++i)
+        for (int c = 0; c < 3; ++c) pts[i * 3 + c] = rgba[i * 4 + c];
+
+    f32 mean[3], axis[3];
+    PrincipalAxis(pts, 16, 3, mean, axis);
+    f32 lo = std::numeric_limits<f32>::max(), hi = -lo;
+    for (int i = 0; i < 16; ++i) {
+        f32 t = 0;
+        for (int c = 0; c < 3; ++c) t += (pts[i * 3 + c] - mean[c]) * axis[c];
+        lo = std::min(lo, t); hi = std::max(hi, t);
+    }
+    f32 e0[3], e1[3];
+    for (int c = 0; c < 3; ++c) {
+        e0[c] = std::min(std::max(mean[c] + axis[c] * hi, 0.0f), 255.0f);
+        e1[c] = std::min(std::max(mean[c] + axis[c] * lo, 0.0f), 255.0f);
+    }
+
+    u16 c0 = Pack565(e0), c1 = Pack565(e1);
+    u8 idx[16], bestIdx[16];
+    u32 bestErr = AssignBC1(rgba, c0, c1, bestIdx);
+    u16 best0 = c0, best1 = c1;
+
+    // Refine: least squares on the current assignment, keep if better
+    static const f32 kW0[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+    std::memcpy(idx, bestIdx, 16);
+    for (int it = 0; it < 2 && bestErr > 0; ++it) {
+        if (!SolveEndpoints(pts, 3, idx, kW0, 16, e0, e1)) break;
+        c0 = Pack565(e0); c1 = Pack565(e1);
+        u32 err = AssignBC1(rgba, c0, c1, idx);
+        if (err >= bestErr) break;
+        bestErr = err; best0 = c0; best1 = c1;
+        std::memcpy(bestIdx, idx, 16);
+    }
+    WriteBC1(best0, best1, bestIdx, out);
+}
+
+void TextureCooker::EncodeBlockBC4(const u8 v[16], u8 out[8]) {
+    int mn = 255, mx = 0, mnIn = 255, mxIn = 0;
+    for (int i = 0; i < 16; ++i) {
+        mn = std::min<int>(mn, v[i]); mx = std::max<int>(mx, v[i]);
+        if (v[i] != 0 && v[i] != 255) { mnIn = std::min<int>(mnIn, v[i]); mxIn = std::max<int>(mxIn, v[i]); }
+    }
+    u8 idx[16], idx6[16];
+    int a0 = mx, a1 = mn;
+    u32 err = (mx == mn) ? 0 : AssignBC4(v, a0, a1, idx);
+    if (mx == mn) { a0 = mx; a1 = mn; std::memset(idx, 0, 16); }
+
+    // 6-value mode keeps exact 0 / 255 when the block has both extremes
+    if (err > 0 && mnIn <= mxIn) {
+        u32 err6 = AssignBC4(v, mnIn, mxIn, idx6);
+        if (err6 < err) { a0 = mnIn; a1 = mxIn; std::memcpy(idx, idx6, 16); err = err6; }
+    }
+
+    out[0] = static_cast<u8>(a0);
+    out[1] = static_cast<u8>(a1);
+    u64 bits = 0;
+    for (int i = 0; i < 16; ++i) bits |= static_cast<u64>(idx[i] & 7) << (3 * i);
+    for (int k = 0; k < 6; ++k) out[2 + k] = static_cast<u8>(bits >> (8 * k));
+}
+
+void TextureCooker::EncodeBlockBC3(const u8 rgba[64], u8 out[16]) {
+    u8 alpha[16];
+    for (int i = 0; i < 16; ++i) alpha[i] = rgba[i * 4 + 3];
+    EncodeBlockBC4(alpha, out);
+    EncodeBlockBC1(rgba, out + 8);
+}
+
+void TextureCooker::EncodeBlockBC5(const u8 rgba[64], u8 out[16]) {
+    u8 r[16], g[16];
+    for (int i = 0; i < 16; ++i) { r[i] = rgba[i * 4]; g[i] = rgba[i * 4 + 1]; }
+    EncodeBlockBC4(r, out);
+    EncodeBlockBC4(g, out + 8);
+}
+
+void TextureCooker::EncodeBlockBC7(const u8 rgba[64], u8 out[16]) {
+    f32 pts[64];
+    for (int i = 0; i < 64; ++i) pts[i] = rgba[i];
+
+    f32 mean[4], axis[4];
+    PrincipalAxis(pts, 16, 4, mean, axis);
+    f32 lo = std::numeric_limits<f32>::max(), hi = -lo;
+    for (int i = 0; i < 16; ++i) {
+        f32 t = 0;
+        for (int c = 0; c < 4; ++c) t += (pts[i * 4 + c] - mean[c]) * axis[c];
+        lo = std::min(lo, t); hi = std::max(hi, t);
+    }
+    f32 e0[4], e1[4];
+    for (int c = 0; c < 4; ++c) {
+        e0[c] = std::min(std::max(mean[c] + axis[c] * lo, 0.0f), 255.0f);
+        e1[c] = std::min(std::max(mean[c] + axis[c] * hi, 0.0f), 255.0f);
+    }
+
+    int bestQ0[4] = {}, bestQ1[4] = {}, bestP0 = 0, bestP1 = 0;
+    u8  bestIdx[16] = {};
+    u32 bestErr = std::numeric_limits<u32>::max();
+    auto tryEndpoints = [&](const f32 a[4], const f32 b[4]) {
+        for (int p0 = 0; p0 < 2; ++p0)
+            for (int p1 = 0; p1 < 2; ++p1) {
+                int q0[4], q1[4], f0[4], f1[4];
+                u8 idx[16];
+                QuantiseBC7(a, p0, q0, f0);
+                QuantiseBC7(b, p1, q1, f1);
+                u32 err = AssignBC7(rgba, f0, f1, idx);
+                if (err < bestErr) {
+                    bestErr = err; bestP0 = p0; bestP1 = p1;
+                    std::memcpy(bestQ0, q0, sizeof(q0)); std::memcpy(bestQ1, q1, sizeof(q1));
+                    std::memcpy(bestIdx, idx, 16);
+                }
+            }
+    };
+    tryEndpoints(e0, e1);
+
+    // Least-squares refinement on the chosen indices
+    f32 w0[16];
+    for (int w = 0; w < 16; ++w) w0[w] = 1.0f - kBC7Weights4[w] / 64.0f;
+    for (int it = 0; it < 2 && bestErr > 0; ++it) {
+        u32 before = bestErr;
+        if (!SolveEndpoints(pts, 4, bestIdx, w0, 16, e0, e1)) break;
+        tryEndpoints(e0, e1);
+        if (bestErr >= before) break;
+    }
+
+    // Anchor texel 0 stores only 3 index bits: its MSB must be 0
+    if (bestIdx[0] & 8) {
+        std::swap(bestQ0, bestQ1);
+        std::swap(bestP0, bestP1);
+        for (auto& i : bestIdx) i = static_cast<u8>(15 - i);
+    }
+
+    BitWriter bw;
+    bw.Put(1u << 6, 7);                       // mode 6
+    for (int c = 0; c < 4; ++c) { bw.Put(static_cast<u32>(bestQ0[c]), 7); bw.Put(static_cast<u32>(bestQ1[c]), 7); }
+    bw.Put(static_cast<u32>(bestP0), 1);
+    bw.Put(static_cast<u32>(bestP1), 1);
+    bw.Put(bestIdx[0], 3);
+    for (int i = 1; i < 16; ++i) bw.Put(bestIdx[i], 4);
+    std::memcpy(out, bw.bytes, 16);
+}
+
+void TextureCooker::DecodeBlockBC1(const u8 in[8], u8 rgba[64], bool forceFourColour) {
+    u16 c0 = static_cast<u16>(in[0] | (in[1] << 8));
+    u16 c1 = static_cast<u16>(in[2] | (in[3] << 8));
+    int pal[4][4];
+    int a[3], b[3];
+    Unpack565(c0, a);
+    Unpack565(c1, b);
+    for (int k = 0; k < 3; ++k) { pal[0][k] = a[k]; pal[1][k] = b[k]; }
+    pal[0][3] = pal[1][3] = pal[2][3] = pal[3][3] = 255;
+    if (c0 > c1 || forceFourColour) {
+        for (int k = 0; k < 3; ++k) {
+            pal[2][k] = (2 * a[k] + b[k]) / 3;
+            pal[3][k] = (a[k] + 2 * b[k]) / 3;
+        }
+    } else {
+        for (int k = 0; k < 3; ++k) { pal[2][k] = (a[k] + b[k]) / 2; pal[3][k] = 0; }
+        pal[3][3] = 0;
+    }
+    u32 bits = static_cast<u32>(in[4]) | (static_cast<u32>(in[5]) << 8) |
+               (static_cast<u32>(in[6]) << 16) | (static_cast<u32>(in[7]) << 24);
+    for (int i = 0; i < 16; ++i) {
+        int p = (bits >> (2 * i)) & 3;
+        for (int k = 0; k < 4; ++k) rgba[i * 4 + k] = static_cast<u8>(pal[p][k]);
+    }
+}
+
+void TextureCooker::DecodeBlockBC4(const u8 in[8], u8 values[16]) {
+    int pal[8];
+    PaletteBC4(in[0], in[1], pal);
+    u64 bits = 0;
+    for (int k = 0; k < 6; ++k) bits |= static_cast<u64>(in[2 + k]) << (8 * k);
+    for (int i = 0; i < 16; ++i) values[i] = static_cast<u8>(pal[(bits >> (3 * i)) & 7]);
+}
+
+bool TextureCooker::DecodeBlockBC7(const u8 in[16], u8 rgba[64]) {
+    BitReader br(in);
+    if (br.Get(7) != (1u << 6)) {
+        // Only mode 6 (what EncodeBlockBC7 writes) is decoded on the CPU.
+        std::memset(rgba, 0, 64);
+        return false;
+    }
+    int q0[4], q1[4];
+    for (int c = 0; c < 4; ++c) { q0[c] = static_cast<int>(br.Get(7)); q1[c] = static_cast<int>(br.Get(7)); }
+    int p0 = static_cast<int>(br.Get(1)), p1 = static_cast<int>(br.Get(1));
+    int e0[4], e1[4];
+    for (int c = 0; c < 4; ++c) { e0[c] = (q0[c] << 1) | p0; e1[c] = (q1[c] << 1) | p1; }
+    for (int i = 0; i < 16; ++i) {
+        int w = kBC7Weights4[br.Get(i == 0 ? 3 : 4)];
+        for (int c = 0; c < 4; ++c) rgba[i * 4 + c] = static_cast<u8>(InterpBC7(e0[c], e1[c], w));
+    }
+    return true;
+}
+
+// ============================================================================
+// Whole levels
+// ============================================================================
+size_t TextureCooker::EncodedSize(u32 width, u32 height, TextureFormat fmt) {
+    if (fmt == TextureFormat::RGBA8) return static_cast<size_t>(width) * height * 4;
+    size_t bx = (width + 3) / 4, by = (height + 3) / 4;
+    return bx * by * BlockBytes(fmt);
+}
+
+std::vector<u8> TextureCooker::Encode(const ImageRGBA8& image, TextureFormat fmt, u32 threads) {
+    if (fmt == TextureFormat::RGBA8) return image.pixels;
+
+    u32 bw = (image.width + 3) / 4, bh = (image.height + 3) / 4;
+    size_t blockBytes = BlockBytes(fmt);
+    std::vector<u8> out(static_cast<size_t>(bw) * bh * blockBytes);
+
+    auto encodeRows = [&](u32 rowBegin, u32 rowEnd) {
+        u8 block[64], tmp[16];
+        for (u32 by = rowBegin; by < rowEnd; ++by)
+            for (u32 bx = 0; bx < bw; ++bx) {
+                GatherBlock(image, bx, by, block);
+                u8* dst = &out[(static_cast<size_t>(by) * bw + bx) * blockBytes];
+                switch (fmt) {
+                    case TextureFormat::BC1: EncodeBlockBC1(block, dst); break;
+                    case TextureFormat::BC3: EncodeBlockBC3(block, dst); break;
+                    case TextureFormat::BC4:
+                        for (int i = 0; i < 16; ++i) tmp[i] = block[i * 4];
+                        EncodeBlockBC4(tmp, dst);
+                        break;
+                    case TextureFormat::BC5: EncodeBlockBC5(block, dst); break;
+                    case TextureFormat::BC7: EncodeBlockBC7(block, dst); break;
+                    default: break;
+                }
+            }
+    };
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    // Small levels aren't worth a thread each
+    threads = std::min(threads, std::max(1u, static_cast<u32>((static_cast<size_t>(bw) * bh) / 256)));
+    threads = std::min(threads, bh);
+    if (threads <= 1) {
+        encodeRows(0, bh);
+        return out;
+    }
+    std::vector<std::thread> pool;
+    u32 rowsPer = (bh + threads - 1) / threads;
+    for (u32 t = 0; t < threads; ++t) {
+        u32 begin = t * rowsPer, end = std::min(bh, begin + rowsPer);
+        if (begin >= end) break;
+        pool.emplace_back(encodeRows, begin, end);
+    }
+    for (auto& th : pool) th.join();
+    return out;
+}
+
+bool TextureCooker::Decode(const u8* data, size_t size, u32 width, u32 height,
+                           TextureFormat fmt, ImageRGBA8& out) {
+    if (size < EncodedSize(width, height, fmt)) return false;
+    out = ImageRGBA8(width, height);
+    if (fmt == TextureFormat::RGBA8) {
+        std::memcpy(out.pixels.data(), data, out.pixels.size());
+        return true;
+    }
+    u32 bw = (width + 3) / 4, bh = (height + 3) / 4;
+    size_t blockBytes = BlockBytes(fmt);
+    bool ok = true;
+    u8 block[64], a[16], b[16];
+    for (u32 by = 0; by < bh; ++by)
+        for (u32 bx = 0; bx < bw; ++bx) {
+            const u8* src = data + (static_cast<size_t>(by) * bw + bx) * blockBytes;
+            switch (fmt) {
+                case TextureFormat::BC1: DecodeBlockBC1(src, block); break;
+                case TextureFormat::BC3:
+                    DecodeBlockBC1(src + 8, block, true);
+                    DecodeBlockBC4(src, a);
+                    for (int i = 0; i < 16; ++i) block[i * 4 + 3] = a[i];
+                    break;
+                case TextureFormat::BC4:
+                    DecodeBlockBC4(src, a);
+                    for (int i = 0; i < 16; ++i) {
+                        block[i * 4] = block[i * 4 + 1] = block[i * 4 + 2] = a[i];
+                        block[i * 4 + 3] = 255;
+                    }
+                    break;
+                case TextureFormat::BC5:
+                    DecodeBlockBC4(src, a);
+                    DecodeBlockBC4(src + 8, b);
+                    for (int i = 0; i < 16; ++i) {
+                        f32 x = a[i] / 127.5f - 1.0f, y = b[i] / 127.5f - 1.0f;
+                        f32 z = std::sqrt(std::max(0.0f, 1.0f - x * x - y * y));
+                        block[i * 4] = a[i];
+                        block[i * 4 + 1] = b[i];
+                        block[i * 4 + 2] = ToByte(z * 0.5f + 0.5f);
+                        block[i * 4 + 3] = 255;
+                    }
+                    break;
+                case TextureFormat::BC7: ok &= DecodeBlockBC7(src, block); break;
+                default: return false;
+            }
+            ScatterBlock(out, bx, by, block);
+        }
+    return ok;
+}
+
+// ============================================================================
+// Cooking
+// ============================================================================
+bool TextureCooker::Cook(const ImageRGBA8& image, const TextureCookSettings& settings,
+                         CookedTexture& out) {
+    if (image.width == 0 || image.height == 0 ||
+        image.pixels.size() != static_cast<size_t>(image.width) * image.height * 4)
+        return false;
+
+    TextureCookSettings s = settings;
+    if (s.normalMap) s.srgb = false;
+
+    out = CookedTexture();
+    out.format = s.format;
+    out.width  = image.width;
+    out.height = image.height;
+    if (s.srgb)      out.flags |= CookedTexture::kFlagSRGB;
+    if (s.normalMap) out.flags |= CookedTexture::kFlagNormalMap;
+    for (size_t i = 3; i < image.pixels.size(); i += 4)
+        if (image.pixels[i] != 255) { out.flags |= CookedTexture::kFlagHasAlpha; break; }
+
+    std::vector<ImageRGBA8> chain;
+    if (s.generateMips) chain = BuildMipChain(image, s);
+    else chain.push_back(image);
+
+    for (auto& level : chain) {
+        CookedLevel cl;
+        cl.width  = level.width;
+        cl.height = level.height;
+        cl.data   = Encode(level, s.format, s.threads);
+        out.levels.push_back(std::move(cl));
+    }
+    return true;
+}
+
+bool TextureCooker::CookFile(const std::string& srcPath, const std::string& dstPath,
+                             const TextureCookSettings& settings, bool flipY) {
+#ifdef GV_HAS_GLFW
+    stbi_set_flip_vertically_on_load(flipY ? 1 : 0);
+    int w = 0, h = 0, channels = 0;
+    unsigned char* data = stbi_load(srcPath.c_str(), &w, &h, &channels, 4);
+    stbi_set_flip_vertically_on_load(1);
+    if (!data) {
+        GV_LOG_WARN("TextureCooker — failed to decode " + srcPath);
+        return false;
+    }
+    ImageRGBA8 img(static_cast<u32>(w), static_cast<u32>(h));
+    std::memcpy(img.pixels.data(), data, img.pixels.size());
+    stbi_image_free(data);
+
+    CookedTexture cooked;
+    if (!Cook(img, settings, cooked) || !cooked.Save(dstPath)) {
+        GV_LOG_WARN("TextureCooker — failed to write " + dstPath);
+        return false;
+    }
+    GV_LOG_INFO("TextureCooker — " + srcPath + " -> " + dstPath + " (" +
+                TextureFormatName(cooked.format) + ", " + std::to_string(cooked.levels.size()) + " mips)");
+    return true;
+#else
+    (void)srcPath; (void)dstPath; (void)settings; (void)flipY;
+    GV_LOG_WARN("TextureCooker — image decoding is only available in window builds.");
+    return false;
+#endif
+}
+
+TextureFormat TextureCooker::PickFormat(const ImageRGBA8& image, bool normalMap, bool highQuality) {
+    // Normal maps keep XYZ so shaders that sample .xyz need no changes;
+    // BC5 is available for pipelines that reconstruct Z.
+    if (normalMap || highQuality) return TextureFormat::BC7;
+    for (size_t i = 3; i < image.pixels.size(); i += 4)
+        if (image.pixels[i] != 255) return TextureFormat::BC3;
+    return TextureFormat::BC1;
+}
+
+bool TextureCooker::LooksLikeNormalMap(const std::string& path) {
+    std::string stem = path;
+    size_t slash = stem.find_last_of("/\\");
+    if (slash != std::string::npos) stem = stem.substr(slash + 1);
+    size_t dot = stem.rfind('.');
+    if (dot != std::string::npos) stem = stem.substr(0, dot);
+    std::transform(stem.begin(), stem.end(), stem.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    for (const char* suffix : { "_n", "_nrm", "_norm", "_normal", "_normals", "_normalmap" }) {
+        size_t n = std::strlen(suffix);
+        if (stem.size() > n && stem.compare(stem.size() - n, n, suffix) == 0) return true;
+    }
+    return stem.find("normal") != std::string::npos;
+}
+
+f64 TextureCooker::PSNR(const ImageRGBA8& a, const ImageRGBA8& b, u32 channelMask) {
+    if (a.width != b.width || a.height != b.height || a.pixels.size() != b.pixels.size())
+        return 0.0;
+    f64 sum = 0.0;
+    size_t count = 0;
+    for (size_t i = 0; i < a.pixels.size(); i += 4)
+        for (int c = 0; c < 4; ++c) {
+            if (!(channelMask & (1u << c))) continue;
+            f64 d = static_cast<f64>(a.pixels[i + c]) - b.pixels[i + c];
+            sum += d * d;
+            ++count;
+        }
+    if (count == 0 || sum == 0.0) return std::numeric_limits<f64>::infinity();
+    f64 mse = sum / static_cast<f64>(count);
+    return 10.0 * std::log10(255.0 * 255.0 / mse);
+}
+
+// ============================================================================
+// .gvtx container
+// ============================================================================
+// Little-endian:
+//   [0]  12-byte identifier  «GVTX 10»\r\n\x1A\n
+//   [12] u32 format, width, height, levelCount, flags, reserved
+//   [36] levelCount × { u64 offset, u64 size, u32 width, u32 height }
+//   level data, each 16-byte aligned, smallest mip first (like KTX2) so a
+//   streamer can read the tail of the file first
+namespace {
+const u8 kGVTXIdentifier[12] = { 0xAB, 'G', 'V', 'T', 'X', ' ', '1', '0', 0xBB, '\r', '\n', 0x1A };
+constexpr size_t kGVTXHeaderSize = 36;
+constexpr size_t kGVTXLevelSize  = 24;
+constexpr u32    kGVTXMaxLevels  = 32;
+
+size_t Align16(size_t v) { return (v + 15) & ~static_cast<size_t>(15); }
+
+template <typename T>
+void Put(std::vector<u8>& buf, size_t at, T v) { std::memcpy(&buf[at], &v, sizeof(T)); }
+template <typename T>
+T Get(const u8* p) { T v; std::memcpy(&v, p, sizeof(T)); return v; }
+}
+
+bool CookedTexture::Save(const std::string& path) const {
+    if (levels.empty() || levels.size() > kGVTXMaxLevels) return false;
+    size_t tableEnd = kGVTXHeaderSize + levels.size() * kGVTXLevelSize;
+
+    std::vector<size_t> offsets(levels.size());
+    size_t cursor = Align16(tableEnd);
+    for (size_t i = levels.size(); i-- > 0;) {
+        offsets[i] = cursor;
+        cursor = Align16(cursor + levels[i].data.size());
+    }
+
+    std::vector<u8> buf(cursor, 0);
+    std::memcpy(buf.data(), kGVTXIdentifier, sizeof(kGVTXIdentifier));
+    Put<u32>(buf, 12, static_cast<u32>(format));
+    Put<u32>(buf, 16, width);
+    Put<u32>(buf, 20, height);
+    Put<u32>(buf, 24, static_cast<u32>(levels.size()));
+    Put<u32>(buf, 28, flags);
+    Put<u32>(buf, 32, 0);
+    for (size_t i = 0; i < levels.size(); ++i) {
+        size_t at = kGVTXHeaderSize + i * kGVTXLevelSize;
+        Put<u64>(buf, at,      static_cast<u64>(offsets[i]));
+        Put<u64>(buf, at + 8,  static_cast<u64>(levels[i].data.size()));
+        Put<u32>(buf, at + 16, levels[i].width);
+        Put<u32>(buf, at + 20, levels[i].height);
+        if (!levels[i].data.empty())
+            std::memcpy(&buf[offsets[i]], levels[i].data.data(), levels[i].data.size());
+    }
+
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+        if (!f.is_open()) return false;
+        f.write(reinterpret_cast<const char*>(buf.data()), static_cast<std::streamsize>(buf.size()));
+        if (!f) return false;
+    }
+    std::remove(path.c_str());
+    return std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+bool CookedTextureView::Open(const std::string& path) {
+    Close();
+    if (!m_File.Open(path)) return false;
+    if (!Parse(m_File.Data(), m_File.Size())) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool CookedTextureView::Parse(const u8* data, size_t size) {
+    m_Levels.clear();
+    if (!data || size < kGVTXHeaderSize ||
+        std::memcmp(data, kGVTXIdentifier, sizeof(kGVTXIdentifier)) != 0)
+        return false;
+    u32 fmt   = Get<u32>(data + 12);
+    u32 count = Get<u32>(data + 24);
+    if (fmt > static_cast<u32>(TextureFormat::BC7) || count == 0 || count > kGVTXMaxLevels ||
+        size < kGVTXHeaderSize + count * kGVTXLevelSize)
+        return false;
+    m_Format = static_cast<TextureFormat>(fmt);
+    m_Width  = Get<u32>(data + 16);
+    m_Height = Get<u32>(data + 20);
+    m_Flags  = Get<u32>(data + 28);
+
+    for (u32 i = 0; i < count; ++i) {
+        const u8* e = data + kGVTXHeaderSize + i * kGVTXLevelSize;
+        u64 offset = Get<u64>(e), bytes = Get<u64>(e + 8);
+        Level lv;
+        lv.width  = Get<u32>(e + 16);
+        lv.height = Get<u32>(e + 20);
+        if (offset > size || bytes > size - offset ||
+            bytes != TextureCooker::EncodedSize(lv.width, lv.height, m_Format)) {
+            m_Levels.clear();
+            return false;
+        }
+        lv.data = data + offset;
+        lv.size = static_cast<size_t>(bytes);
+        m_Levels.push_back(lv);
+    }
+    return true;
+}
+
+void CookedTextureView::Close() {
+    m_Levels.clear();
+    m_File.Close();
+}
+
+} // namespace gv
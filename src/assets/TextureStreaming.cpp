@@ -0,0 +1,454 @@
+// ============================================================================
+// GameVoid Engine — Texture Streaming Implementation
+// ============================================================================
+#include "assets/TextureStreaming.h"
+
+#ifdef GV_HAS_GLFW
+#include "core/GLDefs.h"
+#endif
+
+#include <algorithm>
+#include <cmath>
+
+namespace gv {
+
+// ============================================================================
+// GL upload
+// ============================================================================
+#ifdef GV_HAS_GLFW
+static GLenum CompressedGLFormat(TextureFormat fmt) {
+    switch (fmt) {
+        case TextureFormat::BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case TextureFormat::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case TextureFormat::BC4: return GL_COMPRESSED_RED_RGTC1;
+        case TextureFormat::BC5: return GL_COMPRESSED_RG_RGTC2;
+        case TextureFormat::BC7: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+        default:                 return GL_RGBA8;
+    }
+}
+#endif
+
+bool UploadTextureLevels(u32 texture, TextureFormat fmt, const std::vector<StreamLevelData>& levels) {
+#ifdef GV_HAS_GLFW
+    if (levels.empty()) return false;
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    while (glGetError() != GL_NO_ERROR) {}
+
+    // Compressed levels go straight from the mapping to the driver
+    bool uploaded = false;
+    if (!IsBlockCompressed(fmt) || glCompressedTexImage2D) {
+        for (size_t i = 0; i < levels.size(); ++i) {
+            const auto& lv = levels[i];
+            if (IsBlockCompressed(fmt))
+                glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), CompressedGLFormat(fmt),
+                                       static_cast<GLsizei>(lv.width), static_cast<GLsizei>(lv.height), 0,
+                                       static_cast<GLsizei>(lv.size), lv.data);
+            else
+                glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), GL_RGBA8,
+                             static_cast<GLsizei>(lv.width), static_cast<GLsizei>(lv.height), 0,
+                             GL_RGBA, GL_UNSIGNED_BYTE, lv.data);
+        }
+        uploaded = glGetError() == GL_NO_ERROR;
+    }
+    // Driver without S3TC/RGTC/BPTC: decode on the CPU
+    if (!uploaded) {
+        for (size_t i = 0; i < levels.size(); ++i) {
+            const auto& lv = levels[i];
+            ImageRGBA8 img(lv.width, lv.height);
+            if (lv.data) TextureCooker::Decode(lv.data, lv.size, lv.width, lv.height, fmt, img);
+            glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), GL_RGBA8,
+                         static_cast<GLsizei>(lv.width), static_cast<GLsizei>(lv.height), 0,
+                         GL_RGBA, GL_UNSIGNED_BYTE, img.pixels.data());
+        }
+    }
+
+    GLint count = static_cast<GLint>(levels.size());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, count - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, count > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return uploaded;
+#else
+    (void)texture; (void)fmt; (void)levels;
+    return false;
+#endif
+}
+
+#ifdef GV_HAS_GLFW
+namespace {
+class GLTextureStreamBackend : public TextureStreamBackend {
+public:
+    u32 Create() override {
+        GLuint id = 0;
+        glGenTextures(1, &id);
+        return id;
+    }
+    void Upload(u32 handle, TextureFormat fmt, const std::vector<StreamLevelData>& levels) override {
+        UploadTextureLevels(handle, fmt, levels);
+    }
+    void Destroy(u32 handle) override {
+        GLuint id = handle;
+        glDeleteTextures(1, &id);
+    }
+};
+} // namespace
+#endif
+
+Unique<TextureStreamBackend> CreateGLTextureStreamBackend() {
+#ifdef GV_HAS_GLFW
+    return MakeUnique<GLTextureStreamBackend>();
+#else
+    return nullptr;
+#endif
+}
+
+// ============================================================================
+// Heuristics
+// ============================================================================
+f32 TextureStreamer::ProjectedSize(const Vec3& centre, f32 radius, const Vec3& cameraPos,
+                                   f32 fovYDegrees, f32 viewportHeight) {
+    Vec3 d = centre - cameraPos;
+    f32 dist = std::sqrt(d.x * d.x + d.y * d.y + d.z * d.z);
+    // Camera inside the bounds: the object fills the screen and then some
+    if (dist <= radius) return viewportHeight * 4.0f;
+    f32 tanHalf = std::tan(fovYDegrees * (3.14159265358979f / 180.0f) * 0.5f);
+    if (tanHalf <= 0.0f) return 0.0f;
+    return (radius / (dist * tanHalf)) * viewportHeight;
+}
+
+u32 TextureStreamer::DesiredLevel(u32 texWidth, u32 texHeight, f32 screenPixels,
+                                  f32 lodBias, u32 coarsest) {
+    if (screenPixels <= 0.0f) return coarsest;
+    f32 texels = static_cast<f32>(std::max(texWidth, texHeight));
+    f32 lod = std::log2(texels / screenPixels) + lodBias;
+    if (lod <= 0.0f) return 0;
+    return std::min(coarsest, static_cast<u32>(lod));
+}
+
+// ============================================================================
+// Lifetime
+// ============================================================================
+TextureStreamer::TextureStreamer(TextureStreamBackend* backend, const TextureStreamSettings& settings)
+    : m_Backend(backend), m_Settings(settings) {
+    for (u32 i = 0; i < m_Settings.workerThreads; ++i)
+        m_Workers.emplace_back(&TextureStreamer::WorkerLoop, this);
+}
+
+TextureStreamer::~TextureStreamer() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+    }
+    m_CV.notify_all();
+    for (auto& t : m_Workers) t.join();
+    // GL names are left to the context — it may already be gone here.
+}
+
+u32 TextureStreamer::Add(Entry&& e) {
+    if (!m_Backend || e.levels.empty()) return 0;
+    u32 handle = m_Backend->Create();
+    if (handle == 0) return 0;
+    e.handle = handle;
+
+    // Tail: every level that fits in tailSize (at least the last one)
+    u32 n = static_cast<u32>(e.levels.size());
+    e.tailLevel = n - 1;
+    for (u32 i = 0; i < n; ++i)
+        if (std::max(e.levels[i].width, e.levels[i].height) <= m_Settings.tailSize) { e.tailLevel = i; break; }
+    e.resident = n;
+    e.wanted   = e.tailLevel;
+    e.lastSeen = m_Frame;
+
+    auto it = m_Textures.emplace(handle, std::move(e)).first;
+    ApplyResidency(it->second, it->second.tailLevel, 0, nullptr);
+    return handle;
+}
+
+u32 TextureStreamer::Register(const std::string& cookedPath) {
+    auto view = MakeShared<CookedTextureView>();
+    if (!view->Open(cookedPath)) {
+        GV_LOG_WARN("TextureStreamer — cannot open cooked texture: " + cookedPath);
+        return 0;
+    }
+    Entry e;
+    e.name   = cookedPath;
+    e.view   = view;
+    e.format = view->GetFormat();
+    for (u32 i = 0; i < view->GetLevelCount(); ++i) {
+        const auto& lv = view->GetLevel(i);
+        e.levels.push_back({ lv.width, lv.height, lv.size });
+    }
+    return Add(std::move(e));
+}
+
+u32 TextureStreamer::RegisterSynthetic(const std::string& name, TextureFormat fmt, u32 width, u32 height) {
+    if (width == 0 || height == 0) return 0;
+    Entry e;
+    e.name   = name;
+    e.format = fmt;
+    for (u32 w = width, h = height;; w = std::max(1u, w / 2), h = std::max(1u, h / 2)) {
+        e.levels.push_back({ w, h, TextureCooker::EncodedSize(w, h, fmt) });
+        if (w == 1 && h == 1) break;
+    }
+    return Add(std::move(e));
+}
+
+void TextureStreamer::Unregister(u32 handle) {
+    auto it = m_Textures.find(handle);
+    if (it == m_Textures.end()) return;
+    Entry& e = it->second;
+    m_PendingBytes  -= e.reserved;   // a finished load for it is dropped by the handle lookup
+    m_ResidentBytes -= Bytes(e, e.resident, static_cast<u32>(e.levels.size()));
+    m_Backend->Destroy(handle);
+    m_Textures.erase(it);
+}
+
+void TextureStreamer::Clear() {
+    {
+        // Queued jobs are dropped; ones already being staged are waited for
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Jobs.clear();
+        m_Idle.wait(lock, [this] { return m_Staging == 0; });
+        m_Done.clear();
+    }
+    std::vector<u32> handles;
+    for (auto& kv : m_Textures) handles.push_back(kv.first);
+    for (u32 h : handles) Unregister(h);
+    m_ResidentBytes = 0;
+    m_PendingBytes  = 0;
+}
+
+// ============================================================================
+// Residency
+// ============================================================================
+size_t TextureStreamer::Bytes(const Entry& e, u32 first, u32 last) const {
+    size_t total = 0;
+    for (u32 i = first; i < last && i < e.levels.size(); ++i) total += e.levels[i].bytes;
+    return total;
+}
+
+void TextureStreamer::ApplyResidency(Entry& e, u32 level, u32 stagedFirst,
+                                     const std::vector<std::vector<u8>>* staged) {
+    u32 n = static_cast<u32>(e.levels.size());
+    std::vector<StreamLevelData> upload;
+    upload.reserve(n - level);
+    for (u32 i = level; i < n; ++i) {
+        StreamLevelData d;
+        d.width  = e.levels[i].width;
+        d.height = e.levels[i].height;
+        d.size   = e.levels[i].bytes;
+        if (staged && i >= stagedFirst && i - stagedFirst < staged->size() && !(*staged)[i - stagedFirst].empty())
+            d.data = (*staged)[i - stagedFirst].data();
+        else if (e.view)
+            d.data = e.view->GetLevel(i).data;
+        upload.push_back(d);
+    }
+    m_Backend->Upload(e.handle, e.format, upload);
+
+    m_ResidentBytes -= Bytes(e, e.resident, n);
+    e.resident = level;
+    size_t bytes = Bytes(e, level, n);
+    m_ResidentBytes += bytes;
+    m_Stats.uploadedBytesLastFrame += bytes;
+}
+
+bool TextureStreamer::EvictOne(u32 exceptHandle) {
+    // Least recently seen texture holding more than it currently needs
+    Entry* victim = nullptr;
+    for (auto& kv : m_Textures) {
+        Entry& e = kv.second;
+        if (e.handle == exceptHandle || e.loading || e.resident >= e.wanted) continue;
+        if (!victim || e.lastSeen < victim->lastSeen ||
+            (e.lastSeen == victim->lastSeen &&
+             Bytes(e, e.resident, e.wanted) > Bytes(*victim, victim->resident, victim->wanted)))
+            victim = &e;
+    }
+    if (!victim) return false;
+    ApplyResidency(*victim, victim->wanted, 0, nullptr);
+    ++m_Stats.evictions;
+    return true;
+}
+
+void TextureStreamer::Issue(Entry& e, u32 target) {
+    Job job;
+    job.handle     = e.handle;
+    job.generation = e.generation = m_NextGeneration++;
+    job.first      = target;
+    job.last       = e.resident;
+    job.view       = e.view;
+
+    e.loading    = true;
+    e.loadTarget = target;
+    e.reserved   = Bytes(e, target, e.resident);
+    m_PendingBytes += e.reserved;
+    ++m_Stats.loadsIssued;
+
+    if (m_Workers.empty()) {
+        Stage(job);
+        m_Done.push_back(std::move(job));
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Jobs.push_back(std::move(job));
+    }
+    m_CV.notify_one();
+}
+
+void TextureStreamer::Stage(Job& job) {
+    // Copying out of the mapping faults the pages in here, off the main thread
+    if (!job.view) return;
+    job.staged.resize(job.last - job.first);
+    for (u32 i = job.first; i < job.last; ++i) {
+        const auto& lv = job.view->GetLevel(i);
+        job.staged[i - job.first].assign(lv.data, lv.data + lv.size);
+    }
+}
+
+void TextureStreamer::WorkerLoop() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_CV.wait(lock, [this] { return m_Stop || !m_Jobs.empty(); });
+            if (m_Stop) return;
+            job = std::move(m_Jobs.front());
+            m_Jobs.pop_front();
+            ++m_Staging;
+        }
+        Stage(job);
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Done.push_back(std::move(job));
+            --m_Staging;
+        }
+        m_Idle.notify_all();
+    }
+}
+
+void TextureStreamer::ApplyCompleted() {
+    std::deque<Job> done;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        done.swap(m_Done);
+    }
+    size_t start = m_Stats.uploadedBytesLastFrame;
+    bool   applied = false;
+    while (!done.empty()) {
+        if (applied && m_Stats.uploadedBytesLastFrame - start >= m_Settings.uploadBytesPerFrame) break;
+        Job job = std::move(done.front());
+        done.pop_front();
+
+        auto it = m_Textures.find(job.handle);
+        if (it == m_Textures.end() || it->second.generation != job.generation) continue;
+        Entry& e = it->second;
+        m_PendingBytes -= e.reserved;
+        e.reserved = 0;
+        e.loading  = false;
+        // The camera may have moved away while loading — stop at what's wanted now
+        u32 level = std::max(job.first, std::min(e.wanted, e.resident));
+        if (level < e.resident) ApplyResidency(e, level, job.first, &job.staged);
+        ++m_Stats.loadsApplied;
+        applied = true;
+    }
+    if (!done.empty()) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        for (auto it = done.rbegin(); it != done.rend(); ++it) m_Done.push_front(std::move(*it));
+    }
+}
+
+void TextureStreamer::Request(u32 handle, f32 screenPixels) {
+    auto it = m_Textures.find(handle);
+    if (it == m_Textures.end()) return;
+    it->second.requested = std::max(it->second.requested, screenPixels);
+}
+
+void TextureStreamer::Update() {
+    ++m_Frame;
+    m_Stats.uploadedBytesLastFrame = 0;
+    ApplyCompleted();
+
+    // Resolve this frame's requests
+    struct Candidate { Entry* e; f32 size; };
+    std::vector<Candidate> candidates;
+    for (auto& kv : m_Textures) {
+        Entry& e = kv.second;
+        if (e.requested > 0.0f) {
+            e.wanted = DesiredLevel(e.levels[0].width, e.levels[0].height, e.requested,
+                                    m_Settings.lodBias, e.tailLevel);
+            e.lastSeen = m_Frame;
+        } else {
+            e.wanted = e.tailLevel;
+        }
+        if (e.wanted < e.resident && !e.loading) candidates.push_back({ &e, e.requested });
+        e.requested = 0.0f;
+    }
+
+    // Budget lowered since last frame
+    while (m_ResidentBytes + m_PendingBytes > m_Settings.budgetBytes && EvictOne(0)) {}
+
+    // Largest on screen first
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate& a, const Candidate& b) { return a.size > b.size; });
+    for (auto& c : candidates) {
+        Entry& e = *c.e;
+        auto fits = [&](u32 target) {
+            return m_ResidentBytes + m_PendingBytes + Bytes(e, target, e.resident) <= m_Settings.budgetBytes;
+        };
+        while (!fits(e.wanted) && EvictOne(e.handle)) {}
+        u32 target = e.wanted;
+        while (target < e.resident && !fits(target)) ++target;
+        if (target != e.wanted) ++m_Stats.deferred;
+        if (target < e.resident) Issue(e, target);
+    }
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+u32 TextureStreamer::GetResidentLevel(u32 handle) const {
+    auto it = m_Textures.find(handle);
+    return it != m_Textures.end() ? it->second.resident : 0;
+}
+
+u32 TextureStreamer::GetWantedLevel(u32 handle) const {
+    auto it = m_Textures.find(handle);
+    return it != m_Textures.end() ? it->second.wanted : 0;
+}
+
+u32 TextureStreamer::GetLevelCount(u32 handle) const {
+    auto it = m_Textures.find(handle);
+    return it != m_Textures.end() ? static_cast<u32>(it->second.levels.size()) : 0;
+}
+
+u32 TextureStreamer::GetWidth(u32 handle) const {
+    auto it = m_Textures.find(handle);
+    return it != m_Textures.end() ? it->second.levels[0].width : 0;
+}
+
+u32 TextureStreamer::GetHeight(u32 handle) const {
+    auto it = m_Textures.find(handle);
+    return it != m_Textures.end() ? it->second.levels[0].height : 0;
+}
+
+bool TextureStreamer::IsLoading(u32 handle) const {
+    auto it = m_Textures.find(handle);
+    return it != m_Textures.end() && it->second.loading;
+}
+
+TextureStreamStats TextureStreamer::GetStats() const {
+    TextureStreamStats s = m_Stats;
+    s.textures      = static_cast<u32>(m_Textures.size());
+    s.residentBytes = m_ResidentBytes;
+    s.pendingBytes  = m_PendingBytes;
+    s.budgetBytes   = m_Settings.budgetBytes;
+    s.loadsInFlight = 0;
+    for (auto& kv : m_Textures) if (kv.second.loading) ++s.loadsInFlight;
+    return s;
+}
+
+} // namespace gv
@@ -11,7 +11,9 @@
 #include "renderer/MaterialComponent.h"
 #include "scripting/NativeScript.h"
 #include "scripting/ScriptEngine.h"
+#include "scripting/physics/BehaviorAnalyzer.h"
 #include "vehicle/CarController3D.h"
+#include "assets/TextureStreaming.h"
 #ifdef GV_HAS_GLFW
 #include "core/GLDefs.h"
 #endif
@@ -44,11 +46,22 @@ bool Engine::Init(const EngineConfig& config) {
     if (m_Window.IsInitialised()) {
         static_cast<OpenGLRenderer*>(m_Renderer.get())->SetWindow(&m_Window);
     }
+    static_cast<OpenGLRenderer*>(m_Renderer.get())->SetMeshRegistry(&m_Assets.GetMeshRegistry());
     if (!m_Renderer->Init(config.windowWidth, config.windowHeight, config.windowTitle)) {
         GV_LOG_FATAL("Failed to initialise renderer.");
         return false;
     }
 
+#ifdef GV_HAS_GLFW
+    // ── Texture streaming ──────────────────────────────────────────────────
+    if (config.enableTextureStreaming && m_Window.IsInitialised()) {
+        TextureStreamSettings streamSettings;
+        streamSettings.budgetBytes = static_cast<size_t>(config.textureBudgetMB) * 1024 * 1024;
+        m_Assets.EnableTextureStreaming(streamSettings);
+        static_cast<OpenGLRenderer*>(m_Renderer.get())->SetTextureStreamer(m_Assets.GetTextureStreamer());
+    }
+#endif
+
     // ── Scene ──────────────────────────────────────────────────────────────
     Scene* defaultScene = m_SceneManager.CreateScene("Default");
 
@@ -138,7 +151,12 @@ bool Engine::Init(const EngineConfig& config) {
     if (config.enableScripting) {
         m_Scripting.Init();
         m_Scripting.BindSceneAPI(*defaultScene);
+        m_Scripting.BindGameObjectAPI();
         m_Scripting.BindEventAPI();
+        // Edited .gvs files are picked up live while the editor is open.
+        m_Scripting.EnableHotReload(config.enableEditor);
+        if (!config.scriptDebugAddress.empty() && !m_Scripting.StartDebugServer(config.scriptDebugAddress))
+            GV_LOG_WARN("Script debugger not started — " + m_Scripting.GetLastError());
     }
 
     // ── AI ─────────────────────────────────────────────────────────────────
@@ -253,9 +271,10 @@ void Engine::Run() {
                     auto* carCtrl = obj->GetComponent<CarController3D>();
                     if (!carCtrl) continue;
                     auto* rb = obj->GetComponent<RigidBody>();
+                    scene->TouchForPlay(obj.get());
                     carCtrl->inputForward = inputForward;
                     carCtrl->inputTurn = inputTurn;
-                    carCtrl->UpdateController(dt, rb);
+                    carCtrl->UpdateController(dt, rb, &m_Physics, scene);
                     droveWithController = true;
                     break;
                 }
@@ -267,6 +286,7 @@ void Engine::Run() {
                         auto* rb = obj->GetComponent<RigidBody>();
                         if (!rb || rb->bodyType != RigidBodyType::Dynamic) continue;
 
+                        scene->TouchForPlay(obj.get());
                         Vec3 vel = rb->velocity;
                         const f32 moveSpeed = 6.0f;
                         vel.x = inputTurn * moveSpeed;
@@ -277,6 +297,7 @@ void Engine::Run() {
                 }
 
                 m_Physics.Step(dt);
+                BehaviorAnalysisSystem::Instance().Analyze(dt);
                 // Dispatch collision events
                 for (auto& col : m_Physics.GetCollisions()) {
                     Event e;
@@ -302,6 +323,7 @@ void Engine::Run() {
             }
 
             scene->Update(dt);
+            if (m_Config.enableScripting) m_Scripting.Update(dt);
 
             // ── Audio update ───────────────────────────────────────────
             m_Audio.Update();
@@ -436,6 +458,7 @@ void Engine::Run() {
         // ── Physics ────────────────────────────────────────────────────
         if (m_Config.enablePhysics) {
             m_Physics.Step(dt);
+            BehaviorAnalysisSystem::Instance().Analyze(dt);
 
             // Dispatch collision events via the EventBus
             for (auto& col : m_Physics.GetCollisions()) {
@@ -471,6 +494,7 @@ void Engine::Run() {
 
         // ── Logic ──────────────────────────────────────────────────────
         scene->Update(dt);
+        if (m_Config.enableScripting) m_Scripting.Update(dt);
         m_Audio.Update();
 
         // ── Render ─────────────────────────────────────────────────────
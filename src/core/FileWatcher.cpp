@@ -0,0 +1,180 @@
+// ============================================================================
+// GameVoid Engine — File Watcher Implementation
+// ============================================================================
+#include "core/FileWatcher.h"
+#include <filesystem>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace gv {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+void Stat(const std::string& path, i64& stamp, i64& size) {
+    std::error_code ec;
+    auto t = fs::last_write_time(path, ec);
+    if (ec) { stamp = -1; size = -1; return; }
+    stamp = static_cast<i64>(t.time_since_epoch().count());
+    auto sz = fs::file_size(path, ec);
+    size = ec ? -1 : static_cast<i64>(sz);
+}
+
+std::string DirOf(const std::string& path) {
+    std::string dir = fs::path(path).parent_path().generic_string();
+    return dir.empty() ? "." : dir;
+}
+
+} // anonymous namespace
+
+FileWatcher::FileWatcher() {
+#ifdef __linux__
+    m_InotifyFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+}
+
+FileWatcher::~FileWatcher() {
+#ifdef __linux__
+    if (m_InotifyFD >= 0) close(m_InotifyFD);
+#endif
+}
+
+std::string FileWatcher::Normalise(const std::string& path) {
+    return fs::path(path).lexically_normal().generic_string();
+}
+
+void FileWatcher::Watch(const std::string& path) {
+    std::string key = Normalise(path);
+    if (m_Files.count(key)) return;
+    Entry& e = m_Files[key];
+    Stat(key, e.stamp, e.size);
+    if (m_InotifyFD >= 0) AddDirWatch(DirOf(key));
+}
+
+void FileWatcher::Unwatch(const std::string& path) {
+    if (m_Files.erase(Normalise(path))) RemoveUnusedDirWatches();
+}
+
+bool FileWatcher::IsWatching(const std::string& path) const {
+    return m_Files.count(Normalise(path)) != 0;
+}
+
+void FileWatcher::Clear() {
+    m_Files.clear();
+    RemoveUnusedDirWatches();
+}
+
+void FileWatcher::ForcePolling(bool force) {
+    m_ForcePolling = force;
+#ifdef __linux__
+    if (force && m_InotifyFD >= 0) {
+        close(m_InotifyFD);
+        m_InotifyFD = -1;
+        m_DirByWD.clear();
+        m_WDByDir.clear();
+    } else if (!force && m_InotifyFD < 0) {
+        m_InotifyFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_InotifyFD >= 0)
+            for (auto& kv : m_Files) AddDirWatch(DirOf(kv.first));
+    }
+#endif
+}
+
+void FileWatcher::AddDirWatch(const std::string& dir) {
+#ifdef __linux__
+    if (m_InotifyFD < 0 || m_WDByDir.count(dir)) return;
+    int wd = inotify_add_watch(m_InotifyFD, dir.c_str(),
+                               IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE | IN_DELETE | IN_ATTRIB);
+    if (wd < 0) {
+        // Directory missing or watch limit hit: fall back to polling.
+        GV_LOG_WARN("FileWatcher — inotify unavailable for '" + dir + "', polling instead.");
+        ForcePolling(true);
+        return;
+    }
+    m_WDByDir[dir] = wd;
+    m_DirByWD[wd] = dir;
+#else
+    (void)dir;
+#endif
+}
+
+void FileWatcher::RemoveUnusedDirWatches() {
+#ifdef __linux__
+    if (m_InotifyFD < 0) return;
+    for (auto it = m_WDByDir.begin(); it != m_WDByDir.end();) {
+        bool used = false;
+        for (auto& kv : m_Files) if (DirOf(kv.first) == it->first) { used = true; break; }
+        if (used) { ++it; continue; }
+        inotify_rm_watch(m_InotifyFD, it->second);
+        m_DirByWD.erase(it->second);
+        it = m_WDByDir.erase(it);
+    }
+#endif
+}
+
+void FileWatcher::ReadInotify(f64 now) {
+#ifdef __linux__
+    alignas(inotify_event) char buf[4096];
+    for (;;) {
+        ssize_t n = read(m_InotifyFD, buf, sizeof(buf));
+        if (n <= 0) break;      // EAGAIN: drained
+        for (ssize_t off = 0; off < n;) {
+            auto* ev = reinterpret_cast<inotify_event*>(buf + off);
+            off += static_cast<ssize_t>(sizeof(inotify_event) + ev->len);
+            if (ev->mask & IN_Q_OVERFLOW) { m_LastScan = -1e300; continue; }   // rescan everything
+            auto dir = m_DirByWD.find(ev->wd);
+            if (dir == m_DirByWD.end() || ev->len == 0) continue;
+            std::string path = Normalise(dir->second + "/" + ev->name);
+            auto it = m_Files.find(path);
+            if (it == m_Files.end()) continue;
+            it->second.dirty = true;
+            it->second.lastChange = now;
+        }
+    }
+#else
+    (void)now;
+#endif
+}
+
+void FileWatcher::ScanStamps(f64 now) {
+    for (auto& kv : m_Files) {
+        i64 stamp, size;
+        Stat(kv.first, stamp, size);
+        if (stamp == kv.second.stamp && size == kv.second.size) continue;
+        kv.second.stamp = stamp;
+        kv.second.size = size;
+        kv.second.dirty = true;
+        kv.second.lastChange = now;
+    }
+}
+
+std::vector<std::string> FileWatcher::Poll(f64 now) {
+    std::vector<std::string> settled;
+    if (m_Files.empty()) return settled;
+
+    if (m_InotifyFD >= 0) {
+        ReadInotify(now);
+        if (m_LastScan < -1e299) {          // first poll, or queue overflow
+            ScanStamps(now);
+            m_LastScan = now;
+        }
+    } else if (now - m_LastScan >= m_PollInterval) {
+        ScanStamps(now);
+        m_LastScan = now;
+    }
+
+    for (auto& kv : m_Files) {
+        Entry& e = kv.second;
+        if (!e.dirty || now - e.lastChange < m_Debounce) continue;
+        e.dirty = false;
+        Stat(kv.first, e.stamp, e.size);
+        settled.push_back(kv.first);
+    }
+    return settled;
+}
+
+} // namespace gv
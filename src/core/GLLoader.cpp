@@ -89,6 +89,25 @@ PFN_glVertexAttribIPointer     glVertexAttribIPointer     = nullptr;
 // MRT draw buffers
 PFN_glDrawBuffers              glDrawBuffers              = nullptr;
 
+// Program binaries
+PFN_glGetProgramBinary         glGetProgramBinary         = nullptr;
+PFN_glProgramBinary            glProgramBinary            = nullptr;
+PFN_glProgramParameteri        glProgramParameteri        = nullptr;
+
+// Compressed textures
+PFN_glCompressedTexImage2D     glCompressedTexImage2D     = nullptr;
+
+// Multi-draw
+PFN_glMultiDrawElements        glMultiDrawElements        = nullptr;
+
+// Timer queries
+PFN_glGenQueries               glGenQueries               = nullptr;
+PFN_glDeleteQueries            glDeleteQueries            = nullptr;
+PFN_glBeginQuery               glBeginQuery               = nullptr;
+PFN_glEndQuery                 glEndQuery                 = nullptr;
+PFN_glGetQueryObjectiv         glGetQueryObjectiv         = nullptr;
+PFN_glGetQueryObjectui64v      glGetQueryObjectui64v      = nullptr;
+
 // ── Loader implementation ──────────────────────────────────────────────────
 
 #define GV_LOAD(name) \
@@ -176,6 +195,25 @@ bool gvLoadGL() {
     // MRT draw buffers (deferred rendering)
     GV_LOAD(glDrawBuffers);
 
+    // Program binaries — optional, ShaderLibrary falls back to compiling
+    glGetProgramBinary  = (PFN_glGetProgramBinary)glfwGetProcAddress("glGetProgramBinary");
+    glProgramBinary     = (PFN_glProgramBinary)glfwGetProcAddress("glProgramBinary");
+    glProgramParameteri = (PFN_glProgramParameteri)glfwGetProcAddress("glProgramParameteri");
+
+    // Compressed texture upload — optional, cooked textures fall back to RGBA8
+    glCompressedTexImage2D = (PFN_glCompressedTexImage2D)glfwGetProcAddress("glCompressedTexImage2D");
+
+    // Multi-draw — optional, meshlet ranges fall back to one draw each
+    glMultiDrawElements = (PFN_glMultiDrawElements)glfwGetProcAddress("glMultiDrawElements");
+
+    // Timer queries — optional, dynamic resolution falls back to CPU frame time
+    glGenQueries          = (PFN_glGenQueries)glfwGetProcAddress("glGenQueries");
+    glDeleteQueries       = (PFN_glDeleteQueries)glfwGetProcAddress("glDeleteQueries");
+    glBeginQuery          = (PFN_glBeginQuery)glfwGetProcAddress("glBeginQuery");
+    glEndQuery            = (PFN_glEndQuery)glfwGetProcAddress("glEndQuery");
+    glGetQueryObjectiv    = (PFN_glGetQueryObjectiv)glfwGetProcAddress("glGetQueryObjectiv");
+    glGetQueryObjectui64v = (PFN_glGetQueryObjectui64v)glfwGetProcAddress("glGetQueryObjectui64v");
+
     return ok;
 }
 
@@ -0,0 +1,892 @@
+// ============================================================================
+// GameVoid Engine — Save Game Implementation
+// ============================================================================
+#include "core/SaveGame.h"
+#include "core/Scene.h"
+
+#ifdef GV_HAS_GLFW
+#include "core/GLDefs.h"
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <unordered_set>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace gv {
+
+namespace {
+
+constexpr char kMagic[4] = { 'G', 'V', 'S', 'V' };
+constexpr u32  kFormatVersion = 1;
+constexpr u32  kFlagCompressed = 1u << 0;
+constexpr size_t kHeaderSize = 40;
+constexpr u64  kMaxPayload = 1ull << 31;        // refuse corrupt sizes before allocating
+
+constexpr u32 FourCC(char a, char b, char c, char d) {
+    return static_cast<u32>(static_cast<u8>(a)) | (static_cast<u32>(static_cast<u8>(b)) << 8) |
+           (static_cast<u32>(static_cast<u8>(c)) << 16) | (static_cast<u32>(static_cast<u8>(d)) << 24);
+}
+constexpr u32 kChunkScene  = FourCC('S', 'C', 'N', 'E');
+constexpr u32 kChunkObject = FourCC('O', 'B', 'J', 'T');
+
+u32 Crc32(const u8* data, size_t size) {
+    static const std::array<u32, 256> table = [] {
+        std::array<u32, 256> t{};
+        for (u32 i = 0; i < 256; ++i) {
+            u32 c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    u32 crc = ~0u;
+    for (size_t i = 0; i < size; ++i) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+/// Flush `f` through the OS cache to the disk.
+bool SyncFile(std::FILE* f) {
+    if (std::fflush(f) != 0) return false;
+#ifdef _WIN32
+    return _commit(_fileno(f)) == 0;
+#else
+    return fsync(fileno(f)) == 0;
+#endif
+}
+
+/// Make a rename inside `dir` durable.  NTFS journals renames itself.
+void SyncDirectory(const fs::path& dir) {
+#ifndef _WIN32
+    const int fd = open(dir.empty() ? "." : dir.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    fsync(fd);
+    close(fd);
+#else
+    (void)dir;
+#endif
+}
+
+template <typename T>
+void Put(std::vector<u8>& buf, size_t at, T v) { std::memcpy(&buf[at], &v, sizeof(T)); }
+template <typename T>
+T Get(const u8* p) { T v; std::memcpy(&v, p, sizeof(T)); return v; }
+
+void WriteMetadata(SaveWriter& w, const SaveMetadata& meta) {
+    w.WriteString(meta.title);
+    w.WriteString(meta.sceneName);
+    w.WriteU64(meta.timestamp);
+    w.WriteF64(meta.playTime);
+    w.WriteU32(meta.gameVersion);
+    w.WriteU32(static_cast<u32>(meta.extra.size()));
+    for (const auto& [key, value] : meta.extra) { w.WriteString(key); w.WriteString(value); }
+    w.WriteU32(meta.thumbnail.width);
+    w.WriteU32(meta.thumbnail.height);
+    w.WriteU32(static_cast<u32>(meta.thumbnail.bc1.size()));
+    w.WriteBytes(meta.thumbnail.bc1.data(), meta.thumbnail.bc1.size());
+}
+
+bool ReadMetadata(SaveReader& r, SaveMetadata& meta) {
+    meta.title = r.ReadString();
+    meta.sceneName = r.ReadString();
+    meta.timestamp = r.ReadU64();
+    meta.playTime = r.ReadF64();
+    meta.gameVersion = r.ReadU32();
+    u32 extras = r.ReadU32();
+    meta.extra.clear();
+    for (u32 i = 0; i < extras && r.IsOK(); ++i) {
+        std::string key = r.ReadString();
+        meta.extra.emplace_back(std::move(key), r.ReadString());
+    }
+    meta.thumbnail.width = r.ReadU32();
+    meta.thumbnail.height = r.ReadU32();
+    u32 bytes = r.ReadU32();
+    meta.thumbnail.bc1.clear();
+    if (bytes > r.Remaining() ||
+        bytes != TextureCooker::EncodedSize(meta.thumbnail.width, meta.thumbnail.height, TextureFormat::BC1))
+        bytes = 0;
+    if (bytes == 0) meta.thumbnail.width = meta.thumbnail.height = 0;
+    meta.thumbnail.bc1.resize(bytes);
+    r.ReadBytes(meta.thumbnail.bc1.data(), bytes);
+    return r.IsOK();
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// SaveWriter / SaveReader
+// ============================================================================
+size_t SaveWriter::BeginChunk(u32 type, u32 version) {
+    size_t at = m_Data.size();
+    WriteU32(type);
+    WriteU32(version);
+    WriteU32(0);                                  // size, patched by EndChunk
+    return at;
+}
+
+void SaveWriter::EndChunk(size_t chunk) {
+    u32 size = static_cast<u32>(m_Data.size() - chunk - 12);
+    std::memcpy(&m_Data[chunk + 8], &size, 4);
+}
+
+bool SaveReader::Get(void* out, size_t size) {
+    if (!m_OK || size > m_Size - m_Pos) {
+        m_OK = false;
+        std::memset(out, 0, size);
+        return false;
+    }
+    if (size) std::memcpy(out, m_Data + m_Pos, size);
+    m_Pos += size;
+    return true;
+}
+
+std::string SaveReader::ReadString() {
+    u32 length = ReadU32();
+    if (!m_OK || length > Remaining()) { m_OK = false; return {}; }
+    std::string s(reinterpret_cast<const char*>(m_Data + m_Pos), length);
+    m_Pos += length;
+    return s;
+}
+
+bool SaveReader::NextChunk(Chunk& out) {
+    if (!m_OK || AtEnd()) return false;
+    out.type = ReadU32();
+    out.version = ReadU32();
+    out.size = ReadU32();
+    if (!m_OK || out.size > Remaining()) { m_OK = false; return false; }
+    out.data = m_Data + m_Pos;
+    m_Pos += out.size;
+    return true;
+}
+
+// ============================================================================
+// SaveRegistry
+// ============================================================================
+SaveRegistry& SaveRegistry::Global() {
+    static SaveRegistry registry;
+    return registry;
+}
+
+u32 SaveRegistry::TypeHash(std::string_view name) {
+    u32 h = 2166136261u;                          // FNV-1a
+    for (char c : name) { h ^= static_cast<u8>(c); h *= 16777619u; }
+    // Never collide with the engine's own chunks.
+    if (h == kChunkScene || h == kChunkObject) h ^= 0x80000000u;
+    return h;
+}
+
+SaveRegistry::Entry* SaveRegistry::Add(const std::string& name, u32 version, std::type_index type) {
+    const u32 hash = TypeHash(name);
+    if (name.empty() || version == 0) {
+        GV_LOG_ERROR("SaveRegistry — '" + name + "' needs a name and a version >= 1");
+        return nullptr;
+    }
+    auto it = m_ByHash.find(hash);
+    if (it != m_ByHash.end() && m_Entries[it->second].name != name) {
+        GV_LOG_ERROR("SaveRegistry — '" + name + "' hashes like '" + m_Entries[it->second].name + "'; rename one");
+        return nullptr;
+    }
+    if (it != m_ByHash.end() && m_Entries[it->second].type != type) {
+        GV_LOG_ERROR("SaveRegistry — '" + name + "' is already registered for another type");
+        return nullptr;
+    }
+
+    // Re-registering keeps the migrations.
+    size_t index = it != m_ByHash.end() ? it->second : m_Entries.size();
+    if (index == m_Entries.size()) m_Entries.emplace_back();
+    Entry& e = m_Entries[index];
+    e.name = name;
+    e.hash = hash;
+    e.version = version;
+    e.type = type;
+    m_ByHash[hash] = index;
+    if (type != std::type_index(typeid(void))) m_ByType[type] = index;
+    return &e;
+}
+
+void SaveRegistry::RegisterSection(const std::string& name, u32 version,
+                                   std::function<void(SaveWriter&)> save, std::function<void(SaveReader&)> load) {
+    Entry* e = Add(name, version, std::type_index(typeid(void)));
+    if (!e) return;
+    e->saveSection = std::move(save);
+    e->loadSection = std::move(load);
+}
+
+void SaveRegistry::AddMigration(const std::string& name, u32 fromVersion, Migration migration) {
+    auto it = m_ByHash.find(TypeHash(name));
+    if (it == m_ByHash.end()) {
+        GV_LOG_ERROR("SaveRegistry — migration for unregistered '" + name + "'");
+        return;
+    }
+    m_Entries[it->second].migrations[fromVersion] = std::move(migration);
+}
+
+const SaveRegistry::Entry* SaveRegistry::Find(u32 hash) const {
+    auto it = m_ByHash.find(hash);
+    return it != m_ByHash.end() ? &m_Entries[it->second] : nullptr;
+}
+
+const SaveRegistry::Entry* SaveRegistry::Find(const Component& c) const {
+    auto it = m_ByType.find(std::type_index(typeid(c)));
+    return it != m_ByType.end() ? &m_Entries[it->second] : nullptr;
+}
+
+bool SaveRegistry::Migrate(const Entry& e, u32 version, std::vector<u8>& data, std::string& error) const {
+    if (version == 0 || version > e.version) {
+        error = "'" + e.name + "' v" + std::to_string(version) + " is newer than this build (v" +
+                std::to_string(e.version) + ")";
+        return false;
+    }
+    for (u32 v = version; v < e.version; ++v) {
+        auto it = e.migrations.find(v);
+        if (it == e.migrations.end()) {
+            error = "'" + e.name + "' has no migration from v" + std::to_string(v);
+            return false;
+        }
+        SaveReader in(data);
+        SaveWriter out;
+        if (!it->second(in, out) || !in.IsOK()) {
+            error = "'" + e.name + "' migration from v" + std::to_string(v) + " failed";
+            return false;
+        }
+        data = out.Take();
+    }
+    return true;
+}
+
+// ============================================================================
+// Thumbnails
+// ============================================================================
+SaveThumbnail SaveThumbnail::FromImage(const ImageRGBA8& image, u32 maxSize) {
+    SaveThumbnail thumb;
+    if (image.width == 0 || image.height == 0 || image.pixels.size() < static_cast<size_t>(image.width) * image.height * 4)
+        return thumb;
+    TextureCookSettings settings;
+    settings.filter = MipFilter::Box;
+    settings.wrap = false;
+
+    ImageRGBA8 small = image;
+    maxSize = std::max(1u, maxSize);
+    while (std::max(small.width, small.height) > maxSize) small = TextureCooker::Downsample(small, settings);
+
+    thumb.width = small.width;
+    thumb.height = small.height;
+    thumb.bc1 = TextureCooker::Encode(small, TextureFormat::BC1, 1);
+    return thumb;
+}
+
+bool SaveThumbnail::Decode(ImageRGBA8& out) const {
+    return !IsEmpty() && TextureCooker::Decode(bc1.data(), bc1.size(), width, height, TextureFormat::BC1, out);
+}
+
+bool SaveThumbnail::CaptureFramebuffer(ImageRGBA8& out) {
+#ifdef GV_HAS_GLFW
+    GLint viewport[4] = { 0, 0, 0, 0 };
+    glGetIntegerv(GL_VIEWPORT_ENUM, viewport);
+    if (viewport[2] <= 0 || viewport[3] <= 0) return false;
+    out = ImageRGBA8(static_cast<u32>(viewport[2]), static_cast<u32>(viewport[3]));
+    glReadPixels(viewport[0], viewport[1], viewport[2], viewport[3], GL_RGBA, GL_UNSIGNED_BYTE, out.pixels.data());
+
+    // GL rows run bottom to top.
+    const size_t row = static_cast<size_t>(out.width) * 4;
+    for (u32 y = 0; y < out.height / 2; ++y)
+        std::swap_ranges(out.pixels.begin() + static_cast<std::ptrdiff_t>(y * row),
+                         out.pixels.begin() + static_cast<std::ptrdiff_t>((y + 1) * row),
+                         out.pixels.begin() + static_cast<std::ptrdiff_t>((out.height - 1 - y) * row));
+    return true;
+#else
+    (void)out;
+    return false;
+#endif
+}
+
+// ============================================================================
+// Compression
+// ============================================================================
+// LZ4-style sequences: a token (literal count << 4 | match length - 4,
+// 15 = continued in following 255-bytes), the literals, a 16-bit offset and
+// any match-length continuation.  The last sequence has literals only.
+namespace {
+
+constexpr u32 kHashBits = 14;
+constexpr u32 kMinMatch = 4;
+
+void PutLength(std::vector<u8>& out, size_t length) {
+    for (; length >= 255; length -= 255) out.push_back(255);
+    out.push_back(static_cast<u8>(length));
+}
+
+void EmitSequence(std::vector<u8>& out, const u8* literals, size_t count, size_t offset, size_t match) {
+    const size_t matchCode = match ? match - kMinMatch : 0;
+    out.push_back(static_cast<u8>((std::min<size_t>(count, 15) << 4) | std::min<size_t>(matchCode, 15)));
+    if (count >= 15) PutLength(out, count - 15);
+    out.insert(out.end(), literals, literals + count);
+    if (!match) return;
+    out.push_back(static_cast<u8>(offset));
+    out.push_back(static_cast<u8>(offset >> 8));
+    if (matchCode >= 15) PutLength(out, matchCode - 15);
+}
+
+} // anonymous namespace
+
+std::vector<u8> SaveGame::Compress(const u8* data, size_t size) {
+    std::vector<u8> out;
+    out.reserve(size / 2 + 16);
+    std::vector<u32> table(1u << kHashBits, 0);  // position + 1; 0 = empty
+
+    size_t anchor = 0, i = 0;
+    while (i + kMinMatch <= size) {
+        const u32 seq = Get<u32>(data + i);
+        const u32 h = (seq * 2654435761u) >> (32 - kHashBits);
+        const size_t candidate = table[h];
+        table[h] = static_cast<u32>(i + 1);
+        if (candidate && i - (candidate - 1) <= 0xFFFF && Get<u32>(data + candidate - 1) == seq) {
+            const size_t from = candidate - 1;
+            size_t length = kMinMatch;
+            while (i + length < size && data[from + length] == data[i + length]) ++length;
+            EmitSequence(out, data + anchor, i - anchor, i - from, length);
+            i += length;
+            anchor = i;
+            continue;
+        }
+        // Skip faster through data that doesn't compress.
+        i += 1 + ((i - anchor) >> 6);
+    }
+    EmitSequence(out, data + anchor, size - anchor, 0, 0);
+    return out;
+}
+
+bool SaveGame::Decompress(const u8* data, size_t size, size_t rawSize, std::vector<u8>& out) {
+    out.assign(rawSize, 0);
+    size_t ip = 0, op = 0;
+    auto length = [&](size_t base, size_t& result) {
+        result = base;
+        if (base != 15) return true;
+        for (;;) {
+            if (ip >= size) return false;
+            const u8 b = data[ip++];
+            result += b;
+            if (result > rawSize) return false;
+            if (b != 255) return true;
+        }
+    };
+    while (ip < size) {
+        const u8 token = data[ip++];
+        size_t literals = 0, match = 0;
+        if (!length(token >> 4, literals)) return false;
+        if (literals > size - ip || literals > rawSize - op) return false;
+        if (literals) std::memcpy(out.data() + op, data + ip, literals);   // out may be empty
+        ip += literals;
+        op += literals;
+        if (ip == size) break;                    // last sequence
+
+        if (size - ip < 2) return false;
+        const size_t offset = data[ip] | (static_cast<size_t>(data[ip + 1]) << 8);
+        ip += 2;
+        if (!length(token & 15, match)) return false;
+        match += kMinMatch;
+        if (offset == 0 || offset > op || match > rawSize - op) return false;
+        for (size_t k = 0; k < match; ++k, ++op) out[op] = out[op - offset];   // may overlap
+    }
+    return op == rawSize;
+}
+
+// ============================================================================
+// SaveGame — capture / restore
+// ============================================================================
+std::vector<u8> SaveGame::Capture(const Scene& scene, const SaveRegistry& registry) {
+    SaveWriter w;
+    size_t chunk = w.BeginChunk(kChunkScene, 1);
+    w.WriteString(scene.GetName());
+    w.WriteU32(scene.GetNextID());
+    w.EndChunk(chunk);
+
+    for (const auto& obj : scene.GetAllObjects()) {
+        chunk = w.BeginChunk(kChunkObject, 1);
+        w.WriteU32(obj->GetID());
+        w.WriteU32(obj->GetParent() ? obj->GetParent()->GetID() : 0);
+        w.WriteString(obj->GetName());
+        w.WriteBool(obj->IsActive());
+        const Transform& t = obj->GetTransform();
+        w.WriteVec3(t.position);
+        w.WriteQuat(t.rotation);
+        w.WriteVec3(t.scale);
+
+        // Component chunks: the enabled flag, then the component's own data
+        // (which is what migrations see).
+        for (const auto& c : obj->GetComponents()) {
+            const SaveRegistry::Entry* e = registry.Find(*c);
+            if (!e) continue;
+            size_t sub = w.BeginChunk(e->hash, e->version);
+            w.WriteBool(c->IsEnabled());
+            e->save(*c, w);
+            w.EndChunk(sub);
+        }
+        w.EndChunk(chunk);
+    }
+
+    for (const auto& e : registry.m_Entries) {
+        if (!e.saveSection) continue;
+        chunk = w.BeginChunk(e.hash, e.version);
+        e.saveSection(w);
+        w.EndChunk(chunk);
+    }
+    return w.Take();
+}
+
+bool SaveGame::Restore(Scene& scene, const std::vector<u8>& payload, std::string& error,
+                       const SaveRegistry& registry) {
+    struct SavedObject {
+        u32 id = 0, parent = 0;
+        std::string name;
+        bool active = true;
+        Vec3 position, scale;
+        Quaternion rotation;
+        std::vector<SaveReader::Chunk> components;
+    };
+
+    // ── Parse everything before touching the scene ─────────────────────────
+    std::vector<SavedObject> objects;
+    std::vector<SaveReader::Chunk> sections;
+    std::unordered_set<u32> ids;
+    u32  nextID = 1;
+    bool sawScene = false;
+    u32  skipped = 0;
+
+    SaveReader top(payload);
+    SaveReader::Chunk chunk;
+    while (top.NextChunk(chunk)) {
+        if (chunk.type == kChunkScene || chunk.type == kChunkObject) {
+            if (chunk.version != 1) { error = "save was written by a newer build"; return false; }
+        }
+        if (chunk.type == kChunkScene) {
+            SaveReader r(chunk);
+            r.ReadString();
+            nextID = r.ReadU32();
+            if (!r.IsOK()) { error = "malformed scene chunk"; return false; }
+            sawScene = true;
+        } else if (chunk.type == kChunkObject) {
+            SaveReader r(chunk);
+            SavedObject o;
+            o.id = r.ReadU32();
+            o.parent = r.ReadU32();
+            o.name = r.ReadString();
+            o.active = r.ReadBool();
+            o.position = r.ReadVec3();
+            o.rotation = r.ReadQuat();
+            o.scale = r.ReadVec3();
+            SaveReader::Chunk sub;
+            while (r.NextChunk(sub)) o.components.push_back(sub);
+            if (!r.IsOK() || o.id == 0 || !ids.insert(o.id).second) {
+                error = "malformed object chunk";
+                return false;
+            }
+            objects.push_back(std::move(o));
+        } else {
+            const SaveRegistry::Entry* e = registry.Find(chunk.type);
+            if (e && e->loadSection) sections.push_back(chunk);
+            else ++skipped;
+        }
+    }
+    if (!top.IsOK() || !sawScene) { error = "malformed save payload"; return false; }
+
+    // ── Objects the save doesn't have ──────────────────────────────────────
+    std::vector<GameObject*> doomed;
+    for (const auto& o : scene.GetAllObjects())
+        if (!ids.count(o->GetID())) doomed.push_back(o.get());
+    for (GameObject* o : doomed) {
+        // Unlink first so nothing keeps a pointer to the destroyed object.
+        while (!o->GetChildren().empty()) o->RemoveChild(o->GetChildren().back().get());
+        if (o->GetParent()) o->GetParent()->RemoveChild(o);
+        scene.DestroyGameObject(o);
+    }
+    scene.FlushDestroyQueue();
+
+    std::unordered_map<u32, GameObject*> live;
+    for (const auto& o : scene.GetAllObjects()) live[o->GetID()] = o.get();
+
+    // ── Objects and components ─────────────────────────────────────────────
+    std::string problem;
+    for (const auto& saved : objects) {
+        GameObject* obj = live.count(saved.id) ? live[saved.id] : nullptr;
+        if (!obj) {
+            obj = scene.CreateGameObjectWithID(saved.id, saved.name);
+            live[saved.id] = obj;
+        }
+        scene.TouchForPlay(obj);
+        obj->SetName(saved.name);
+        obj->SetActive(saved.active);
+        Transform& t = obj->GetTransform();
+        t.position = saved.position;
+        t.rotation = saved.rotation;
+        t.scale = saved.scale;
+
+        std::unordered_map<u32, u32> seen;       // per type: how many loaded so far
+        for (const auto& sub : saved.components) {
+            const SaveRegistry::Entry* e = registry.Find(sub.type);
+            if (!e || !e->load) { ++skipped; continue; }
+            SaveReader head(sub);
+            const bool enabled = head.ReadBool();
+            std::vector<u8> data(sub.data + (sub.size ? 1 : 0), sub.data + sub.size);
+            if (!head.IsOK() || !registry.Migrate(*e, sub.version, data, problem)) {
+                GV_LOG_WARN("SaveGame — object " + std::to_string(saved.id) + ": " +
+                            (head.IsOK() ? problem : "empty '" + e->name + "' chunk"));
+                ++skipped;
+                continue;
+            }
+
+            // The n-th saved component of a type goes to the n-th one on the object.
+            Component* target = nullptr;
+            u32 nth = seen[sub.type]++;
+            for (const auto& c : obj->GetComponents())
+                if (std::type_index(typeid(*c)) == e->type && nth-- == 0) { target = c.get(); break; }
+            if (!target) target = e->create(*obj);
+
+            SaveReader in(data);
+            e->load(*target, in);
+            target->SetEnabled(enabled);
+            if (!in.IsOK())
+                GV_LOG_WARN("SaveGame — object " + std::to_string(saved.id) + ": '" + e->name + "' data ran short");
+        }
+    }
+
+    // ── Hierarchy ──────────────────────────────────────────────────────────
+    std::unordered_map<GameObject*, Shared<GameObject>> owners;
+    for (const auto& o : scene.GetAllObjects()) owners[o.get()] = o;
+    for (const auto& saved : objects) {
+        GameObject* obj = live[saved.id];
+        GameObject* parent = saved.parent && live.count(saved.parent) ? live[saved.parent] : nullptr;
+        for (GameObject* p = parent; p; p = p->GetParent())
+            if (p == obj) { parent = nullptr; break; }            // would be a cycle
+        if (obj->GetParent() == parent) continue;
+        Shared<GameObject> shared = owners[obj];
+        if (obj->GetParent()) obj->GetParent()->RemoveChild(obj);
+        if (parent) parent->AddChild(shared);
+    }
+
+    // ── Sections ───────────────────────────────────────────────────────────
+    for (const auto& sub : sections) {
+        const SaveRegistry::Entry* e = registry.Find(sub.type);
+        std::vector<u8> data(sub.data, sub.data + sub.size);
+        if (!registry.Migrate(*e, sub.version, data, problem)) {
+            GV_LOG_WARN("SaveGame — section: " + problem);
+            ++skipped;
+            continue;
+        }
+        SaveReader in(data);
+        e->loadSection(in);
+    }
+
+    scene.SetNextID(std::max(nextID, scene.GetNextID()));
+    if (skipped) GV_LOG_WARN("SaveGame — skipped " + std::to_string(skipped) + " unreadable chunk(s)");
+    return true;
+}
+
+// ============================================================================
+// SaveGame — files
+// ============================================================================
+//   0  "GVSV"          16 u64 payload bytes stored
+//   4  u32 version     24 u64 payload bytes raw
+//   8  u32 flags       32 u32 payload CRC-32 (raw)
+//  12  u32 meta bytes  36 u32 metadata CRC-32
+//  40  metadata, then payload
+bool SaveGame::WriteFile(const std::string& path, const SaveMetadata& meta, const std::vector<u8>& payload,
+                         std::string& error, bool compress) {
+    SaveWriter metaBlock;
+    WriteMetadata(metaBlock, meta);
+    const std::vector<u8>& metaBytes = metaBlock.GetData();
+
+    std::vector<u8> packed;
+    if (compress) packed = Compress(payload.data(), payload.size());
+    const bool compressed = compress && packed.size() < payload.size();
+    const std::vector<u8>& body = compressed ? packed : payload;
+
+    std::vector<u8> header(kHeaderSize, 0);
+    std::memcpy(header.data(), kMagic, 4);
+    Put<u32>(header, 4, kFormatVersion);
+    Put<u32>(header, 8, compressed ? kFlagCompressed : 0u);
+    Put<u32>(header, 12, static_cast<u32>(metaBytes.size()));
+    Put<u64>(header, 16, static_cast<u64>(body.size()));
+    Put<u64>(header, 24, static_cast<u64>(payload.size()));
+    Put<u32>(header, 32, Crc32(payload.data(), payload.size()));
+    Put<u32>(header, 36, Crc32(metaBytes.data(), metaBytes.size()));
+
+    // Write and sync a temp file, then rename it over the old save: a crash
+    // at any point leaves either the old file or the complete new one.
+    const std::string tmp = path + ".tmp";
+    {
+        std::FILE* f = std::fopen(tmp.c_str(), "wb");
+        if (!f) { error = "can't write " + tmp; return false; }
+        auto put = [f](const std::vector<u8>& bytes) {
+            return bytes.empty() || std::fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+        };
+        const bool ok = put(header) && put(metaBytes) && put(body) && SyncFile(f);
+        if (std::fclose(f) != 0 || !ok) {
+            error = "write failed: " + tmp;
+            std::remove(tmp.c_str());
+            return false;
+        }
+    }
+    std::error_code ec;
+    fs::rename(tmp, path, ec);
+    if (ec) {
+        error = "can't replace " + path + ": " + ec.message();
+        std::remove(tmp.c_str());
+        return false;
+    }
+    SyncDirectory(fs::path(path).parent_path());
+    return true;
+}
+
+bool SaveGame::ReadFile(const std::string& path, SaveMetadata* meta, std::vector<u8>* payload, std::string& error) {
+    std::ifstream f(path, std::ios::binary | std::ios::ate);
+    if (!f) { error = "can't open " + path; return false; }
+    const u64 fileSize = static_cast<u64>(f.tellg());
+    f.seekg(0);
+
+    u8 header[kHeaderSize];
+    if (fileSize < kHeaderSize || !f.read(reinterpret_cast<char*>(header), kHeaderSize) ||
+        std::memcmp(header, kMagic, 4) != 0) {
+        error = path + ": not a save file";
+        return false;
+    }
+    const u32 version   = Get<u32>(header + 4);
+    const u32 flags     = Get<u32>(header + 8);
+    const u32 metaSize  = Get<u32>(header + 12);
+    const u64 stored    = Get<u64>(header + 16);
+    const u64 raw       = Get<u64>(header + 24);
+    const u32 crc       = Get<u32>(header + 32);
+    const u32 metaCrc   = Get<u32>(header + 36);
+    if (version > kFormatVersion) { error = path + ": written by a newer build"; return false; }
+    if (metaSize > fileSize - kHeaderSize || stored != fileSize - kHeaderSize - metaSize ||
+        raw > kMaxPayload || (!(flags & kFlagCompressed) && stored != raw)) {
+        error = path + ": truncated or corrupt";
+        return false;
+    }
+
+    std::vector<u8> metaBytes(metaSize);
+    if (!f.read(reinterpret_cast<char*>(metaBytes.data()), metaSize) ||
+        Crc32(metaBytes.data(), metaBytes.size()) != metaCrc) {
+        error = path + ": corrupt metadata";
+        return false;
+    }
+    if (meta) {
+        SaveReader r(metaBytes);
+        if (!ReadMetadata(r, *meta)) { error = path + ": corrupt metadata"; return false; }
+    }
+    if (!payload) return true;
+
+    std::vector<u8> body(static_cast<size_t>(stored));
+    if (!f.read(reinterpret_cast<char*>(body.data()), static_cast<std::streamsize>(stored))) {
+        error = path + ": truncated payload";
+        return false;
+    }
+    if (flags & kFlagCompressed) {
+        if (!Decompress(body.data(), body.size(), static_cast<size_t>(raw), *payload)) {
+            error = path + ": corrupt payload";
+            return false;
+        }
+    } else {
+        *payload = std::move(body);
+    }
+    if (Crc32(payload->data(), payload->size()) != crc) {
+        error = path + ": payload checksum mismatch";
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// SaveSlots
+// ============================================================================
+SaveSlots::SaveSlots(const std::string& directory, const SaveRegistry& registry)
+    : m_Directory(directory), m_Registry(registry) {
+    std::error_code ec;
+    fs::create_directories(m_Directory, ec);
+    m_Worker = std::thread(&SaveSlots::WorkerLoop, this);
+}
+
+SaveSlots::~SaveSlots() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+    }
+    m_CV.notify_all();
+    m_Worker.join();
+}
+
+bool SaveSlots::IsValidSlotName(const std::string& slot) {
+    if (slot.empty() || slot.size() > 64) return false;
+    return std::all_of(slot.begin(), slot.end(), [](char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-';
+    });
+}
+
+std::string SaveSlots::GetPath(const std::string& slot) const {
+    return (fs::path(m_Directory) / (slot + ".gvsave")).string();
+}
+
+u32 SaveSlots::Queue(const std::string& slot, std::vector<u8> payload, SaveMetadata meta, bool waited) {
+    if (!IsValidSlotName(slot)) {
+        GV_LOG_ERROR("SaveSlots — invalid slot name '" + slot + "'");
+        return 0;
+    }
+    if (meta.timestamp == 0) meta.timestamp = static_cast<u64>(std::time(nullptr));
+
+    Job job;
+    job.slot = slot;
+    job.meta = std::move(meta);
+    job.payload = std::move(payload);
+    u32 ticket;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        ticket = job.ticket = m_NextTicket++;
+        if (waited) m_Waited.insert(ticket);
+        m_Jobs.push_back(std::move(job));
+    }
+    m_CV.notify_one();
+    return ticket;
+}
+
+u32 SaveSlots::SaveAsync(const std::string& slot, const Scene& scene, SaveMetadata meta) {
+    if (!IsValidSlotName(slot)) return Queue(slot, {}, std::move(meta), false);
+    if (meta.sceneName.empty()) meta.sceneName = scene.GetName();
+    return Queue(slot, SaveGame::Capture(scene, m_Registry), std::move(meta), false);
+}
+
+bool SaveSlots::Save(const std::string& slot, const Scene& scene, SaveMetadata meta, std::string& error) {
+    if (!IsValidSlotName(slot)) { error = "invalid slot name '" + slot + "'"; return false; }
+    if (meta.sceneName.empty()) meta.sceneName = scene.GetName();
+    const u32 ticket = Queue(slot, SaveGame::Capture(scene, m_Registry), std::move(meta), true);
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    for (;;) {
+        auto it = std::find_if(m_Done.begin(), m_Done.end(), [ticket](const SaveResult& r) { return r.ticket == ticket; });
+        if (it != m_Done.end()) {
+            SaveResult result = std::move(*it);
+            m_Done.erase(it);
+            m_Waited.erase(ticket);
+            error = result.error;
+            return result.ok;
+        }
+        m_IdleCV.wait(lock);
+    }
+}
+
+bool SaveSlots::Load(const std::string& slot, Scene& scene, std::string& error, SaveMetadata* meta) {
+    if (!IsValidSlotName(slot)) { error = "invalid slot name '" + slot + "'"; return false; }
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_IdleCV.wait(lock, [&] {
+            return !m_Writing.count(slot) && std::none_of(m_Jobs.begin(), m_Jobs.end(),
+                [&](const Job& j) { return j.slot == slot; });
+        });
+    }
+    std::vector<u8> payload;
+    SaveMetadata ignored;
+    if (!SaveGame::ReadFile(GetPath(slot), meta ? meta : &ignored, &payload, error)) return false;
+    return SaveGame::Restore(scene, payload, error, m_Registry);
+}
+
+std::vector<SaveSlotInfo> SaveSlots::List() const {
+    std::vector<SaveSlotInfo> slots;
+    std::error_code ec;
+    for (fs::directory_iterator it(m_Directory, ec), end; !ec && it != end; it.increment(ec)) {
+        const fs::path& p = it->path();
+        if (p.extension() != ".gvsave") continue;
+        SaveSlotInfo info;
+        info.slot = p.stem().string();
+        std::string error;
+        if (IsValidSlotName(info.slot) && SaveGame::ReadFile(p.string(), &info.meta, nullptr, error))
+            slots.push_back(std::move(info));
+    }
+    std::sort(slots.begin(), slots.end(), [](const SaveSlotInfo& a, const SaveSlotInfo& b) {
+        return a.meta.timestamp != b.meta.timestamp ? a.meta.timestamp > b.meta.timestamp : a.slot < b.slot;
+    });
+    return slots;
+}
+
+bool SaveSlots::Exists(const std::string& slot) const {
+    std::error_code ec;
+    return IsValidSlotName(slot) && fs::exists(GetPath(slot), ec);
+}
+
+bool SaveSlots::Delete(const std::string& slot) {
+    if (!IsValidSlotName(slot)) return false;
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_IdleCV.wait(lock, [&] {
+            return !m_Writing.count(slot) && std::none_of(m_Jobs.begin(), m_Jobs.end(),
+                [&](const Job& j) { return j.slot == slot; });
+        });
+    }
+    std::error_code ec;
+    return fs::remove(GetPath(slot), ec);
+}
+
+std::vector<SaveResult> SaveSlots::PollCompleted() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::vector<SaveResult> done, kept;
+    for (auto& r : m_Done) (m_Waited.count(r.ticket) ? kept : done).push_back(std::move(r));
+    m_Done.swap(kept);
+    return done;
+}
+
+void SaveSlots::Flush() {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_IdleCV.wait(lock, [this] { return m_Jobs.empty() && m_Writing.empty(); });
+}
+
+bool SaveSlots::IsBusy() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return !m_Jobs.empty() || !m_Writing.empty();
+}
+
+void SaveSlots::WorkerLoop() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_CV.wait(lock, [this] { return m_Stop || !m_Jobs.empty(); });
+            if (m_Jobs.empty()) return;           // stopping, queue drained
+            job = std::move(m_Jobs.front());
+            m_Jobs.pop_front();
+            m_Writing.insert(job.slot);
+        }
+
+        SaveResult result;
+        result.ticket = job.ticket;
+        result.slot = job.slot;
+        result.rawBytes = job.payload.size();
+        const std::string path = GetPath(job.slot);
+        result.ok = SaveGame::WriteFile(path, job.meta, job.payload, result.error);
+        if (result.ok) {
+            std::error_code ec;
+            result.fileBytes = static_cast<size_t>(fs::file_size(path, ec));
+        } else {
+            GV_LOG_ERROR("SaveSlots — " + result.error);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Writing.erase(job.slot);
+            m_Done.push_back(std::move(result));
+        }
+        m_IdleCV.notify_all();
+    }
+}
+
+} // namespace gv
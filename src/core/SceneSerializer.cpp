@@ -367,7 +367,13 @@ std::string SceneSerializer::SerializeObject(const GameObject* obj, int indent)
         ss << "\n" << in2 << "{\n";
         ss << Indent(indent + 3) << "\"type\": \"MeshRenderer\",\n";
         ss << Indent(indent + 3) << "\"primitiveType\": \"" << PrimitiveTypeToString(mr->primitiveType) << "\",\n";
-        ss << Indent(indent + 3) << "\"color\": " << SerializeVec4(mr->color) << "\n";
+        ss << Indent(indent + 3) << "\"color\": " << SerializeVec4(mr->color);
+        if (mr->occluder) ss << ",\n" << Indent(indent + 3) << "\"occluder\": true";
+        if (mr->impostorDistance > 0.0f) {
+            ss << ",\n" << Indent(indent + 3) << "\"impostorDistance\": " << mr->impostorDistance;
+            ss << ",\n" << Indent(indent + 3) << "\"impostorFade\": " << mr->impostorFade;
+        }
+        ss << "\n";
         ss << in2 << "}";
         first = false;
     }
@@ -663,6 +669,9 @@ void SceneSerializer::DeserializeObject(Scene& scene, const JsonValue& jObj,
                 auto* mr = obj->AddComponent<MeshRenderer>();
                 mr->primitiveType = StringToPrimitiveType(comp["primitiveType"].AsStr());
                 if (comp.Has("color")) mr->color = ParseVec4(comp["color"]);
+                if (comp.Has("occluder")) mr->occluder = comp["occluder"].AsBool();
+                if (comp.Has("impostorDistance")) mr->impostorDistance = comp["impostorDistance"].AsFloat();
+                if (comp.Has("impostorFade"))     mr->impostorFade     = comp["impostorFade"].AsFloat();
             }
             else if (type == "Material") {
                 auto* mc = obj->AddComponent<MaterialComponent>();
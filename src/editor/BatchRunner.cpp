@@ -0,0 +1,499 @@
+// ============================================================================
+// GameVoid Engine — Headless Batch Runner Implementation
+// ============================================================================
+#include "editor/BatchRunner.h"
+#include "editor/CLIEditor.h"
+#include "core/Scene.h"
+#include "core/GameObject.h"
+#include "core/SceneSerializer.h"
+#include "core/EventSystem.h"
+#include "physics/Physics.h"
+#include "scripting/ScriptEngine.h"
+#include "scripting/physics/BehaviorAnalyzer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#endif
+
+namespace gv {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+f64 MsSince(Clock::time_point t0) {
+    return std::chrono::duration<f64, std::milli>(Clock::now() - t0).count();
+}
+
+bool IsFinite(const Vec3& v) {
+    return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
+}
+
+std::string FileStem(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    std::string name = (slash == std::string::npos) ? path : path.substr(slash + 1);
+    size_t dot = name.find_last_of('.');
+    return (dot == std::string::npos) ? name : name.substr(0, dot);
+}
+
+std::string Quote(const std::string& s) {
+    std::string out = "\"";
+    for (char c : s) {
+#ifndef _WIN32
+        if (c == '"' || c == '\\' || c == '$' || c == '`') out += '\\';
+#endif
+        out += c;
+    }
+    return out + "\"";
+}
+
+// ── Trace writer ──────────────────────────────────────────────────────────
+// CSV: one row per object per frame.
+// Binary ("GVTR" v1):
+//   header  : char[4] magic, u32 version, f32 dt
+//   frame*  : u32 frame, u32 collisions, f32 stepMs, u32 count,
+//             count × { u32 id, f32 pos[3], f32 rot[4] (xyzw), f32 vel[3] }
+//   names   : u32 count, count × { u32 id, u32 len, char[len] }
+//   trailer : u64 byte offset of the name table
+class TraceWriter {
+public:
+    bool Open(const std::string& path, BatchTraceFormat fmt, f32 dt) {
+        m_Format = fmt;
+        if (fmt == BatchTraceFormat::None) return true;
+        m_File.open(path, fmt == BatchTraceFormat::Binary ? std::ios::binary : std::ios::out);
+        if (!m_File.is_open()) return false;
+        if (fmt == BatchTraceFormat::CSV) {
+            m_File << "frame,time,collisions,step_ms,id,name,px,py,pz,qx,qy,qz,qw,vx,vy,vz\n";
+        } else {
+            u32 version = 1;
+            m_File.write("GVTR", 4);
+            Put(version);
+            Put(dt);
+        }
+        return true;
+    }
+
+    void WriteFrame(u32 frame, f32 time, u32 collisions, f32 stepMs, const Scene& scene) {
+        if (m_Format == BatchTraceFormat::None) return;
+        const auto& objs = scene.GetAllObjects();
+        if (m_Format == BatchTraceFormat::Binary) {
+            Put(frame); Put(collisions); Put(stepMs);
+            Put(static_cast<u32>(objs.size()));
+        }
+        for (const auto& o : objs) {
+            const Transform& t = o->GetTransform();
+            Vec3 v;
+            if (auto* rb = o->GetComponent<RigidBody>()) v = rb->velocity;
+            if (m_Format == BatchTraceFormat::CSV) {
+                m_File << frame << ',' << time << ',' << collisions << ',' << stepMs << ','
+                       << o->GetID() << ',' << o->GetName() << ','
+                       << t.position.x << ',' << t.position.y << ',' << t.position.z << ','
+                       << t.rotation.x << ',' << t.rotation.y << ',' << t.rotation.z << ','
+                       << t.rotation.w << ',' << v.x << ',' << v.y << ',' << v.z << '\n';
+            } else {
+                Put(o->GetID());
+                const f32 data[10] = { t.position.x, t.position.y, t.position.z,
+                                       t.rotation.x, t.rotation.y, t.rotation.z, t.rotation.w,
+                                       v.x, v.y, v.z };
+                m_File.write(reinterpret_cast<const char*>(data), sizeof(data));
+                if (std::find(m_SeenIDs.begin(), m_SeenIDs.end(), o->GetID()) == m_SeenIDs.end()) {
+                    m_SeenIDs.push_back(o->GetID());
+                    m_SeenNames.push_back(o->GetName());
+                }
+            }
+        }
+    }
+
+    void Close() {
+        if (!m_File.is_open()) return;
+        if (m_Format == BatchTraceFormat::Binary) {
+            u64 tableOffset = static_cast<u64>(m_File.tellp());
+            Put(static_cast<u32>(m_SeenIDs.size()));
+            for (size_t i = 0; i < m_SeenIDs.size(); ++i) {
+                Put(m_SeenIDs[i]);
+                Put(static_cast<u32>(m_SeenNames[i].size()));
+                m_File.write(m_SeenNames[i].data(), static_cast<std::streamsize>(m_SeenNames[i].size()));
+            }
+            Put(tableOffset);
+        }
+        m_File.close();
+    }
+
+private:
+    template <typename T> void Put(const T& v) {
+        m_File.write(reinterpret_cast<const char*>(&v), sizeof(T));
+    }
+
+    std::ofstream            m_File;
+    BatchTraceFormat         m_Format = BatchTraceFormat::None;
+    std::vector<u32>         m_SeenIDs;
+    std::vector<std::string> m_SeenNames;
+};
+
+} // namespace
+
+// ============================================================================
+// BatchInvariant
+// ============================================================================
+
+bool BatchInvariant::Parse(const std::string& expr, BatchInvariant& out) {
+    static const char* kOps[] = { "<=", ">=", "==", "!=", "<", ">" };
+    static const char* kFields[] = { "x", "y", "z", "vx", "vy", "vz", "speed", "angspeed" };
+
+    for (const char* op : kOps) {
+        size_t at = expr.find(op);
+        if (at == std::string::npos) continue;
+
+        std::string lhs = expr.substr(0, at);
+        std::string rhs = expr.substr(at + std::char_traits<char>::length(op));
+        lhs.erase(std::remove(lhs.begin(), lhs.end(), ' '), lhs.end());
+        rhs.erase(std::remove(rhs.begin(), rhs.end(), ' '), rhs.end());
+
+        size_t dot = lhs.find_last_of('.');
+        if (dot == std::string::npos || dot == 0 || rhs.empty()) return false;
+
+        BatchInvariant inv;
+        inv.text   = expr;
+        inv.object = lhs.substr(0, dot);
+        inv.field  = lhs.substr(dot + 1);
+        inv.op     = op;
+        if (std::find(std::begin(kFields), std::end(kFields), inv.field) == std::end(kFields))
+            return false;
+        try { inv.value = std::stof(rhs); } catch (...) { return false; }
+        out = inv;
+        return true;
+    }
+    return false;
+}
+
+bool BatchInvariant::Check(GameObject* obj) const {
+    const Transform& t = obj->GetTransform();
+    Vec3 v, w;
+    if (auto* rb = obj->GetComponent<RigidBody>()) { v = rb->velocity; w = rb->angularVelocity; }
+
+    f32 lhs = 0.0f;
+    if      (field == "x")        lhs = t.position.x;
+    else if (field == "y")        lhs = t.position.y;
+    else if (field == "z")        lhs = t.position.z;
+    else if (field == "vx")       lhs = v.x;
+    else if (field == "vy")       lhs = v.y;
+    else if (field == "vz")       lhs = v.z;
+    else if (field == "speed")    lhs = v.Length();
+    else if (field == "angspeed") lhs = w.Length();
+
+    if (op == "<")  return lhs <  value;
+    if (op == "<=") return lhs <= value;
+    if (op == ">")  return lhs >  value;
+    if (op == ">=") return lhs >= value;
+    if (op == "==") return std::fabs(lhs - value) <= 1e-4f;
+    if (op == "!=") return std::fabs(lhs - value) >  1e-4f;
+    return false;
+}
+
+// ============================================================================
+// BatchRunner
+// ============================================================================
+
+BatchResult BatchRunner::RunJob(const BatchJob& job) {
+    BatchResult result;
+    result.scenePath = job.scenePath;
+    auto t0 = Clock::now();
+
+    auto fail = [&](i32 code, const std::string& msg) {
+        result.exitCode = std::max(result.exitCode, code);
+        result.failures.push_back(msg);
+    };
+
+    // ── Headless engine systems (no Window / Renderer) ─────────────────────
+    Scene        scene(FileStem(job.scenePath));
+    PhysicsWorld physics;
+    ScriptEngine scripting;
+    physics.fixedTimeStep = job.dt;
+    physics.Init();
+    scene.SetPhysicsWorld(&physics);
+    if (job.enableScripting) {
+        scripting.Init();
+        scripting.BindSceneAPI(scene);
+        scripting.BindGameObjectAPI();
+        scripting.BindEventAPI();
+    }
+
+    if (!SceneSerializer::LoadScene(scene, job.scenePath, &physics)) {
+        fail(2, "failed to load scene '" + job.scenePath + "'");
+        result.wallMs = MsSince(t0);
+        return result;
+    }
+    if (!job.forceFieldsPath.empty() && !physics.LoadForceFields(job.forceFieldsPath))
+        fail(2, "failed to load force fields '" + job.forceFieldsPath + "'");
+
+    if (!job.commands.empty()) {
+        CLIEditor cli;
+        cli.Init(&scene, &physics, nullptr, job.enableScripting ? &scripting : nullptr, nullptr);
+        for (const auto& cmd : job.commands) cli.ExecuteCommand(cmd);
+    }
+
+    TraceWriter trace;
+    if (!trace.Open(job.tracePath, job.traceFormat, job.dt))
+        fail(2, "cannot open trace '" + job.tracePath + "'");
+
+    if (result.exitCode != 0) {
+        result.wallMs = MsSince(t0);
+        return result;
+    }
+
+    if (job.enableScripting) {
+        for (auto& obj : scene.GetAllObjects()) {
+            auto* sc = obj->GetComponent<ScriptComponent>();
+            if (sc && !sc->GetEngine()) sc->SetEngine(&scripting);
+        }
+    }
+    scene.Start();
+
+    // ── Fixed-step loop (same order as the engine's real-time loop) ────────
+    for (u32 frame = 0; frame < job.frames; ++frame) {
+        auto stepStart = Clock::now();
+
+        physics.Step(job.dt);
+        BehaviorAnalysisSystem::Instance().Analyze(job.dt);
+        for (auto& col : physics.GetCollisions()) {
+            Event e;
+            e.type = EventType::CollisionEnter;
+            e.objectA = col.objectA;
+            e.objectB = col.objectB;
+            e.contactPoint = col.contactPoint;
+            e.contactNormal = col.contactNormal;
+            e.penetration = col.penetrationDepth;
+            EventBus::Instance().QueueEvent(e);
+        }
+        EventBus::Instance().FlushQueue();
+        scene.Update(job.dt);
+        if (job.enableScripting) scripting.Update(job.dt);
+
+        f32 stepMs = static_cast<f32>(MsSince(stepStart));
+        f32 time = static_cast<f32>(frame + 1) * job.dt;
+        trace.WriteFrame(frame, time, static_cast<u32>(physics.GetCollisions().size()), stepMs, scene);
+        result.framesRun = frame + 1;
+
+        // ── Invariants ─────────────────────────────────────────────────────
+        std::string at = "frame " + std::to_string(frame) + ": ";
+        for (auto& obj : scene.GetAllObjects()) {
+            const Transform& t = obj->GetTransform();
+            auto* rb = obj->GetComponent<RigidBody>();
+            if (!IsFinite(t.position) || (rb && !IsFinite(rb->velocity)))
+                fail(1, at + "non-finite state on '" + obj->GetName() + "'");
+        }
+        for (const auto& inv : job.invariants) {
+            if (inv.object == "*") {
+                for (auto& obj : scene.GetAllObjects())
+                    if (!inv.Check(obj.get()))
+                        fail(1, at + inv.text + "  (failed on '" + obj->GetName() + "')");
+            } else if (GameObject* obj = scene.FindByName(inv.object)) {
+                if (!inv.Check(obj)) fail(1, at + inv.text);
+            } else {
+                fail(1, at + inv.text + "  (object '" + inv.object + "' not found)");
+            }
+        }
+        if (result.exitCode != 0) break;
+    }
+
+    trace.Close();
+    if (job.enableScripting) scripting.Shutdown();
+    physics.Shutdown();
+
+    result.passed = (result.exitCode == 0);
+    result.wallMs = MsSince(t0);
+    return result;
+}
+
+std::string BatchRunner::BuildWorkerCommand(const BatchJob& job, const std::string& exePath,
+                                            const std::string& logPath) {
+    std::ostringstream cmd;
+    cmd << Quote(exePath) << " --batch --jobs 1"
+        << " --frames " << job.frames
+        << " --dt " << std::setprecision(std::numeric_limits<f32>::max_digits10) << job.dt;
+    if (!job.enableScripting) cmd << " --no-scripts";
+    if (job.traceFormat != BatchTraceFormat::None) {
+        cmd << " --format " << (job.traceFormat == BatchTraceFormat::Binary ? "bin" : "csv")
+            << " --trace " << Quote(job.tracePath);
+    }
+    if (!job.forceFieldsPath.empty()) cmd << " --fields " << Quote(job.forceFieldsPath);
+    for (const auto& inv : job.invariants) cmd << " --assert " << Quote(inv.text);
+    for (const auto& c : job.commands)     cmd << " --exec " << Quote(c);
+    cmd << " " << Quote(job.scenePath) << " > " << Quote(logPath) << " 2>&1";
+#ifdef _WIN32
+    // cmd.exe strips the outermost quotes of /c arguments.
+    return "\"" + cmd.str() + "\"";
+#else
+    return cmd.str();
+#endif
+}
+
+i32 BatchRunner::RunParallel(const std::vector<BatchJob>& jobs, u32 workers,
+                             const std::string& exePath) {
+    if (workers == 0) workers = 1;
+    workers = std::min<u32>(workers, static_cast<u32>(jobs.size()));
+
+    std::atomic<size_t> next{ 0 };
+    std::atomic<i32>    worst{ 0 };
+    std::mutex          printMutex;
+
+    auto worker = [&]() {
+        for (size_t i = next++; i < jobs.size(); i = next++) {
+            const BatchJob& job = jobs[i];
+            std::string logPath = !job.logPath.empty() ? job.logPath
+                                : (job.tracePath.empty() ? FileStem(job.scenePath) + "-" + std::to_string(i)
+                                                         : job.tracePath) + ".log";
+            auto t0 = Clock::now();
+            int status = std::system(BuildWorkerCommand(job, exePath, logPath).c_str());
+#ifdef _WIN32
+            i32 code = status;
+#else
+            i32 code = (status != -1 && WIFEXITED(status)) ? WEXITSTATUS(status) : 2;
+#endif
+            i32 prev = worst.load();
+            while (code > prev && !worst.compare_exchange_weak(prev, code)) {}
+
+            std::lock_guard<std::mutex> lock(printMutex);
+            std::cout << (code == 0 ? "[PASS] " : "[FAIL] ") << job.scenePath
+                      << "  (" << static_cast<i64>(MsSince(t0)) << " ms, exit " << code
+                      << ", log: " << logPath << ")\n";
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (u32 w = 0; w < workers; ++w) pool.emplace_back(worker);
+    for (auto& t : pool) t.join();
+    return worst.load();
+}
+
+void BatchRunner::PrintUsage() {
+    std::cout << "Usage: GameVoid --batch [options] <scene> [scene ...]\n"
+              << "  --frames <N>        Frames to simulate (default 600)\n"
+              << "  --dt <seconds>      Fixed timestep (default 1/60)\n"
+              << "  --trace <file>      Trace output for a single scene\n"
+              << "  --trace-dir <dir>   Per-scene traces (<dir>/<scene>.csv|.gvtr)\n"
+              << "  --format csv|bin    Trace format (default: from extension, else csv)\n"
+              << "  --assert \"<expr>\"   Invariant, e.g. \"Ball.y > -5\" or \"*.speed < 50\"\n"
+              << "                      fields: x y z vx vy vz speed angspeed\n"
+              << "  --exec \"<command>\"  CLIEditor command to run after loading\n"
+              << "  --fields <file>     Force-field definitions to add to the world\n"
+              << "  --no-scripts        Do not run ScriptComponents\n"
+              << "  --jobs <N>          Worker processes for multiple scenes\n"
+              << "                      (default: hardware threads; 1 = in-process)\n"
+              << "Exit code: 0 all passed, 1 invariant failed, 2 load/usage error.\n";
+}
+
+i32 BatchRunner::Main(int argc, char* argv[]) {
+    BatchJob proto;
+    std::vector<std::string> scenes;
+    std::string tracePath, traceDir, format;
+    u32 jobsCount = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        try {
+            if (arg == "--batch") continue;
+            else if (arg == "--frames" && hasValue)    proto.frames = static_cast<u32>(std::stoul(argv[++i]));
+            else if (arg == "--dt" && hasValue)        proto.dt = std::stof(argv[++i]);
+            else if (arg == "--trace" && hasValue)     tracePath = argv[++i];
+            else if (arg == "--trace-dir" && hasValue) traceDir = argv[++i];
+            else if (arg == "--format" && hasValue)    format = argv[++i];
+            else if (arg == "--fields" && hasValue)    proto.forceFieldsPath = argv[++i];
+            else if (arg == "--exec" && hasValue)      proto.commands.push_back(argv[++i]);
+            else if (arg == "--jobs" && hasValue)      jobsCount = static_cast<u32>(std::stoul(argv[++i]));
+            else if (arg == "--no-scripts")            proto.enableScripting = false;
+            else if (arg == "--assert" && hasValue) {
+                BatchInvariant inv;
+                if (!BatchInvariant::Parse(argv[++i], inv)) {
+                    std::cerr << "Invalid invariant: " << argv[i] << "\n";
+                    return 2;
+                }
+                proto.invariants.push_back(inv);
+            }
+            else if (arg == "--help" || arg == "-h") { PrintUsage(); return 0; }
+            else if (!arg.empty() && arg[0] == '-') {
+                std::cerr << "Unknown batch option: " << arg << "\n";
+                return 2;
+            }
+            else scenes.push_back(arg);
+        } catch (const std::exception&) {
+            std::cerr << "Invalid value for " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (scenes.empty() || proto.dt <= 0.0f) { PrintUsage(); return 2; }
+    if (!tracePath.empty() && scenes.size() > 1) {
+        std::cerr << "--trace takes a single scene; use --trace-dir for several.\n";
+        return 2;
+    }
+
+    auto formatFor = [&](const std::string& path) {
+        if (format == "bin" || format == "binary") return BatchTraceFormat::Binary;
+        if (format == "csv") return BatchTraceFormat::CSV;
+        if (path.size() >= 5 && path.compare(path.size() - 5, 5, ".gvtr") == 0) return BatchTraceFormat::Binary;
+        if (path.size() >= 4 && path.compare(path.size() - 4, 4, ".bin") == 0)  return BatchTraceFormat::Binary;
+        return BatchTraceFormat::CSV;
+    };
+
+    // Output names come from the scene's file name, plus its position on the
+    // command line when two scenes in different folders share a name.
+    std::vector<BatchJob> jobs;
+    for (size_t i = 0; i < scenes.size(); ++i) {
+        const std::string& scene = scenes[i];
+        std::string name = FileStem(scene);
+        size_t sameName = std::count_if(scenes.begin(), scenes.end(),
+                                        [&](const std::string& s) { return FileStem(s) == name; });
+        if (sameName > 1) name += "-" + std::to_string(i);
+
+        BatchJob job = proto;
+        job.scenePath = scene;
+        if (!tracePath.empty()) {
+            job.tracePath = tracePath;
+            job.logPath = tracePath + ".log";
+        } else if (!traceDir.empty()) {
+            bool bin = (format == "bin" || format == "binary");
+            job.tracePath = traceDir + "/" + name + (bin ? ".gvtr" : ".csv");
+            job.logPath = traceDir + "/" + name + ".log";
+        } else {
+            job.logPath = name + ".log";
+        }
+        if (!job.tracePath.empty()) job.traceFormat = formatFor(job.tracePath);
+        jobs.push_back(job);
+    }
+
+    // ── Several scenes: fan out to worker processes ────────────────────────
+    if (jobs.size() > 1 && jobsCount > 1) {
+        i32 code = RunParallel(jobs, jobsCount, argv[0]);
+        std::cout << "Batch finished: " << (code == 0 ? "all scenes passed" : "FAILURES") << "\n";
+        return code;
+    }
+
+    // ── In-process ─────────────────────────────────────────────────────────
+    i32 worst = 0;
+    for (const auto& job : jobs) {
+        BatchResult r = RunJob(job);
+        std::cout << (r.passed ? "[PASS] " : "[FAIL] ") << r.scenePath << "  ("
+                  << r.framesRun << "/" << job.frames << " frames, "
+                  << static_cast<i64>(r.wallMs) << " ms)\n";
+        for (const auto& f : r.failures) std::cout << "    " << f << "\n";
+        worst = std::max(worst, r.exitCode);
+    }
+    return worst;
+}
+
+} // namespace gv
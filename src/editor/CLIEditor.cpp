@@ -10,6 +10,8 @@
 #include "scripting/ScriptEngine.h"
 #include "scripting/NativeScript.h"
 #include "assets/Assets.h"
+#include "assets/TextureCooker.h"
+#include "editor2d/DialogueBank.h"
 #include "renderer/MeshRenderer.h"
 #include "renderer/Lighting.h"
 #include "renderer/Camera.h"
@@ -80,6 +82,12 @@ void CLIEditor::Init(Scene* scene, PhysicsWorld* physics, AIManager* ai,
         [this](Args a){ CmdSave(a); });
     RegisterCommand("load",      "load [file]  — load scene from disk (default: scene.gvs)",
         [this](Args a){ CmdLoad(a); });
+    RegisterCommand("cook",      "cook <image> [out.gvtx] [rgba8|bc1|bc3|bc4|bc5|bc7] [normal]  — cook a texture",
+        [this](Args a){ CmdCook(a); });
+    RegisterCommand("profile",   "profile start [sample] | stop | report [n] | export <file.folded>  — script profiler",
+        [this](Args a){ CmdProfile(a); });
+    RegisterCommand("dialogue",  "dialogue compile <script.gvdlg> [out.gvdb] | strings <bank.gvdb> <out.tsv>  — dialogue banks",
+        [this](Args a){ CmdDialogue(a); });
 
     GV_LOG_INFO("CLIEditor initialised — type 'help' for commands.");
 }
@@ -348,4 +356,89 @@ void CLIEditor::CmdLoad(const std::vector<std::string>& args) {
         std::cout << "Failed to load scene from '" << path << "'.\n";
 }
 
+void CLIEditor::CmdCook(const std::vector<std::string>& args) {
+    if (args.empty()) { std::cout << "Usage: cook <image> [out.gvtx] [format] [normal]\n"; return; }
+    const std::string& src = args[0];
+    std::string dst;
+    TextureCookSettings settings;
+    bool explicitFormat = false;
+    for (size_t i = 1; i < args.size(); ++i) {
+        const std::string& a = args[i];
+        if      (a == "rgba8") { settings.format = TextureFormat::RGBA8; explicitFormat = true; }
+        else if (a == "bc1")   { settings.format = TextureFormat::BC1;   explicitFormat = true; }
+        else if (a == "bc3")   { settings.format = TextureFormat::BC3;   explicitFormat = true; }
+        else if (a == "bc4")   { settings.format = TextureFormat::BC4;   explicitFormat = true; }
+        else if (a == "bc5")   { settings.format = TextureFormat::BC5;   explicitFormat = true; }
+        else if (a == "bc7")   { settings.format = TextureFormat::BC7;   explicitFormat = true; }
+        else if (a == "normal") settings.normalMap = true;
+        else dst = a;
+    }
+    if (!settings.normalMap) settings.normalMap = TextureCooker::LooksLikeNormalMap(src);
+    settings.srgb = !settings.normalMap;
+    if (!explicitFormat && settings.normalMap) settings.format = TextureFormat::BC7;
+    if (dst.empty()) {
+        size_t dot = src.rfind('.');
+        dst = (dot == std::string::npos ? src : src.substr(0, dot)) + ".gvtx";
+    }
+    if (TextureCooker::CookFile(src, dst, settings))
+        std::cout << "Cooked '" << src << "' -> '" << dst << "' (" << TextureFormatName(settings.format) << ").\n";
+    else
+        std::cout << "Failed to cook '" << src << "'.\n";
+}
+
+void CLIEditor::CmdProfile(const std::vector<std::string>& args) {
+    if (!m_Scripting) { std::cout << "Scripting not available.\n"; return; }
+    if (args.empty()) { std::cout << "Usage: profile start [sample] | stop | report [n] | export <file>\n"; return; }
+    ScriptProfiler& profiler = m_Scripting->GetProfiler();
+    const std::string& sub = args[0];
+    if (sub == "start") {
+        bool sample = args.size() > 1 && args[1] == "sample";
+        profiler.Reset();
+        profiler.Start(sample ? ScriptProfiler::Mode::Sample : ScriptProfiler::Mode::Instrument);
+        std::cout << "Script profiler started (" << (sample ? "sampling" : "instrumenting") << ").\n";
+    } else if (sub == "stop") {
+        profiler.Stop();
+        std::cout << "Script profiler stopped.\n";
+    } else if (sub == "report") {
+        u32 count = 20;
+        if (args.size() > 1) {
+            try { count = static_cast<u32>(std::max(1, std::stoi(args[1]))); }
+            catch (const std::exception&) { std::cout << "Invalid count, showing 20.\n"; }
+        }
+        std::cout << profiler.Report(count);
+    } else if (sub == "export" && args.size() > 1) {
+        if (profiler.WriteFoldedStacks(args[1]))
+            std::cout << "Folded stacks written to '" << args[1] << "'.\n";
+    } else {
+        std::cout << "Usage: profile start [sample] | stop | report [n] | export <file>\n";
+    }
+}
+
+void CLIEditor::CmdDialogue(const std::vector<std::string>& args) {
+    if (args.size() >= 2 && args[0] == "compile") {
+        const std::string& src = args[1];
+        std::string dst = args.size() > 2 ? args[2] : "";
+        if (dst.empty()) {
+            size_t dot = src.rfind('.');
+            dst = (dot == std::string::npos ? src : src.substr(0, dot)) + ".gvdb";
+        }
+        std::string error;
+        if (!DialogueCompiler::CompileFile(src, dst, error)) {
+            std::cout << "Dialogue compile failed: " << error << "\n";
+            return;
+        }
+        DialogueBank bank;
+        bank.Open(dst);
+        std::cout << "Compiled '" << src << "' -> '" << dst << "' (" << bank.GetNodeCount() << " nodes, "
+                  << bank.GetStringCount() << " strings, " << bank.GetVariableCount() << " variables).\n";
+    } else if (args.size() >= 3 && args[0] == "strings") {
+        DialogueBank bank;
+        if (!bank.Open(args[1])) { std::cout << "Cannot open bank '" << args[1] << "'.\n"; return; }
+        if (bank.ExportStrings(args[2]))
+            std::cout << "Wrote " << bank.GetStringCount() << " strings to '" << args[2] << "'.\n";
+    } else {
+        std::cout << "Usage: dialogue compile <script.gvdlg> [out.gvdb] | strings <bank.gvdb> <out.tsv>\n";
+    }
+}
+
 } // namespace gv
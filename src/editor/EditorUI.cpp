@@ -33,6 +33,7 @@
 #include "scripting/physics/ForceController.h"
 #include "editor/UndoRedo.h"
 #include "assets/Assets.h"
+#include "assets/GLTFLoader.h"
 #include "vehicle/CarController3D.h"
 #include "editor2d/Editor2DTypes.h"
 #include "editor2d/Editor2DViewport.h"
@@ -321,6 +322,8 @@ void EditorUI::Update3DPlayWindow(f32 /*dt*/) {
     if (glfwWindowShouldClose(m_PlayWindow3D)) {
         Close3DPlayWindow();
         m_Playing = false;
+        if (m_Scene) m_Scene->StopPlay();
+        m_2DViewport.GetScene().StopPlay();
         PushLog("[Editor] 3D play window closed.");
         return;
     }
@@ -335,6 +338,8 @@ void EditorUI::Update3DPlayWindow(f32 /*dt*/) {
     if (glfwGetKey(m_PlayWindow3D, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
         Close3DPlayWindow();
         m_Playing = false;
+        if (m_Scene) m_Scene->StopPlay();
+        m_2DViewport.GetScene().StopPlay();
         PushLog("[Editor] Stopped 3D play (Esc in game window).");
         return;
     }
@@ -925,6 +930,7 @@ void EditorUI::DrawToolbar() {
         if (ImGui::Button("Play From View")) {
             SyncPlayCameraToEditorView();
             m_Playing = true;
+            if (m_Scene) m_Scene->BeginPlay();
             Ensure3DPlayWindow();
             PushLog("[Editor] Play mode from current view.");
         }
@@ -935,6 +941,7 @@ void EditorUI::DrawToolbar() {
         ImGui::SameLine();
         if (ImGui::Button("  Play  ")) {
             m_Playing = true;
+            if (m_Scene) m_Scene->BeginPlay();
             Ensure3DPlayWindow();
             PushLog("[Editor] Play mode.");
         }
@@ -942,6 +949,7 @@ void EditorUI::DrawToolbar() {
         ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.7f, 0.2f, 0.2f, 1));
         if (ImGui::Button("  Stop  ")) {
             m_Playing = false;
+            if (m_Scene) m_Scene->StopPlay();
             Close3DPlayWindow();
             PushLog("[Editor] Stopped.");
         }
@@ -5864,6 +5872,57 @@ void EditorUI::ImportModelIntoScene(const std::string& path) {
         return;
     }
 
+    // glTF carries a scene graph: import it as a hierarchy under one root.
+    std::string ext = path.substr(path.find_last_of('.') == std::string::npos ? path.size() : path.find_last_of('.'));
+    for (auto& c : ext) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    if (ext == ".gltf" || ext == ".glb") {
+        GLTFImportResult imported;
+        if (!ImportGLTFScene(path, *m_Scene, imported, m_Assets) || !imported.root) {
+            PushLog("[Import] Failed to load model: " + path);
+            return;
+        }
+        // Fit the whole hierarchy within ~1 unit, bottom on the grid.
+        Vec3 lo(FLT_MAX, FLT_MAX, FLT_MAX), hi(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+        std::vector<GameObject*> walk { imported.root };
+        while (!walk.empty()) {
+            GameObject* node = walk.back();
+            walk.pop_back();
+            for (auto& child : node->GetChildren()) walk.push_back(child.get());
+            auto* nmr = node->GetComponent<MeshRenderer>();
+            if (!nmr || !nmr->GetMesh()) continue;
+            Vec3 mn, mx;
+            nmr->GetMesh()->GetBounds(mn, mx);
+            Mat4 m = node->GetTransform().GetModelMatrix();
+            for (int corner = 0; corner < 8; ++corner) {
+                Vec3 p((corner & 1) ? mx.x : mn.x, (corner & 2) ? mx.y : mn.y, (corner & 4) ? mx.z : mn.z);
+                Vec3 w(m.m[0] * p.x + m.m[4] * p.y + m.m[8] * p.z + m.m[12],
+                       m.m[1] * p.x + m.m[5] * p.y + m.m[9] * p.z + m.m[13],
+                       m.m[2] * p.x + m.m[6] * p.y + m.m[10] * p.z + m.m[14]);
+                lo = Vec3(std::min(lo.x, w.x), std::min(lo.y, w.y), std::min(lo.z, w.z));
+                hi = Vec3(std::max(hi.x, w.x), std::max(hi.y, w.y), std::max(hi.z, w.z));
+            }
+        }
+        if (lo.x <= hi.x) {
+            Vec3 ext3 = hi - lo;
+            float maxExtent = std::max(ext3.x, std::max(ext3.y, ext3.z));
+            float scaleFactor = (maxExtent > 0.0001f) ? (1.0f / maxExtent) : 1.0f;
+            imported.root->GetTransform().SetScale(scaleFactor);
+            imported.root->GetTransform().SetPosition(-(lo.x + hi.x) * 0.5f * scaleFactor,
+                                                      -lo.y * scaleFactor,
+                                                      -(lo.z + hi.z) * 0.5f * scaleFactor);
+        }
+
+        m_Selected = imported.root;
+        ClearSelection();
+        SelectObject(imported.root, false);
+        ImportAssetFile(path);
+        PushLog("[Import] Added '" + imported.root->GetName() + "' to scene (" +
+                std::to_string(imported.meshObjects + imported.skinnedObjects) + " meshes, " +
+                std::to_string(imported.skinnedObjects) + " skinned, " +
+                std::to_string(imported.animationClips) + " animations).");
+        return;
+    }
+
     // Load the mesh through the asset manager
     auto mesh = m_Assets->LoadMesh(path);
     if (!mesh || mesh->GetIndexCount() == 0) {
@@ -6256,13 +6315,18 @@ void EditorUI::BuildGame() {
             "g++ -std=c++17 -DGV_HAS_GLFW -DIMGUI_DISABLE_WIN32_FUNCTIONS " + configFlag +
             " -Iinclude -Ideps -Ideps/glfw/include -Ideps/imgui -Ideps/miniaudio"
             " -Ldeps/glfw/lib -o \"" + exePath + "\""
-            " src/main.cpp src/core/Engine.cpp src/core/FPSCamera.cpp src/core/SceneSerializer.cpp"
+            " src/main.cpp src/core/Engine.cpp src/core/FileWatcher.cpp src/core/FPSCamera.cpp src/core/SceneSerializer.cpp src/core/SaveGame.cpp"
             " src/renderer/Renderer.cpp src/renderer/Camera.cpp src/renderer/Material.cpp"
             " src/renderer/MaterialComponent.cpp src/physics/Physics.cpp src/assets/Assets.cpp"
-            " src/ai/AIManager.cpp src/scripting/ScriptEngine.cpp src/scripting/NodeGraph.cpp"
+            " src/ai/AIManager.cpp src/ai/BehaviorTree.cpp src/scripting/ScriptEngine.cpp src/scripting/NodeGraph.cpp"
+            " src/scripting/VMHeap.cpp src/scripting/VMCompiler.cpp src/scripting/ScriptVM.cpp"
+            " src/scripting/ScriptScheduler.cpp"
+            " src/scripting/ScriptProfiler.cpp"
+            " src/scripting/ScriptDebugger.cpp"
             " src/scripting/NativeScript.cpp src/editor/CLIEditor.cpp src/editor/OrbitCamera.cpp"
+            " src/editor2d/DialogueBank.cpp"
             " src/terrain/Terrain.cpp src/effects/ParticleSystem.cpp"
-            " src/animation/Animation.cpp src/animation/SkeletalAnimation.cpp"
+            " src/animation/Animation.cpp src/animation/AnimStateMachine.cpp src/animation/SkeletalAnimation.cpp"
             " src/future/Placeholders.cpp src/core/Window.cpp src/core/GLLoader.cpp"
             " src/editor/EditorUI.cpp"
             " deps/imgui/imgui.cpp deps/imgui/imgui_draw.cpp deps/imgui/imgui_tables.cpp"
@@ -6862,6 +6926,22 @@ void EditorUI::DrawInspector2D() {
         if (ImGui::CollapsingHeader("Anim State Machine 2D", ImGuiTreeNodeFlags_DefaultOpen)) {
             ImGui::Text("Current State: %s",
                 animSM->currentStateName.empty() ? "(none)" : animSM->currentStateName.c_str());
+            if (animSM->machine.IsValid()) {
+                const AnimStateMachine& m = animSM->machine;
+                const AnimGraph& graph = *m.GetGraph();
+                ImGui::TextDisabled("Graph: %u states, %u transitions, t = %.2f",
+                    graph.GetStateCount(), graph.GetTransitionCount(), m.GetNormalizedTime());
+                if (m.IsInTransition())
+                    ImGui::TextDisabled("  -> %s (%.0f%%)", graph.GetStateName(m.GetNextState()).c_str(),
+                        m.GetBlendWeight() * 100.0f);
+                for (u32 p = 0; p < graph.GetParameterCount(); ++p)
+                    ImGui::TextDisabled("  %s = %g", graph.GetParameterName(p).c_str(), m.GetFloat(p));
+            }
+            if (!animSM->transitions.empty() && ImGui::Button("Build Graph##AnimSM")) {
+                std::string err;
+                if (animSM->Build(&err)) PushLog("[2D] Built animation graph for " + sel->GetName());
+                else PushLog("[2D] Animation graph: " + err);
+            }
 
             for (size_t i = 0; i < animSM->states.size(); ++i) {
                 auto& st = animSM->states[i];
@@ -7079,17 +7159,17 @@ void EditorUI::DrawInspector2D() {
                         dialogueRunner->IsActive() ? "Yes" : "No",
                         dialogueRunner->IsFinished() ? "Yes" : "No");
             if (dialogueRunner->IsActive()) {
-                auto* curNode = dialogueRunner->GetCurrentNode();
-                if (curNode) {
-                    ImGui::Text("Speaker: %s", curNode->speaker.c_str());
-                    ImGui::TextWrapped("Text: %s", dialogueRunner->GetVisibleText().c_str());
-                    auto choices = dialogueRunner->GetAvailableChoices();
-                    if (!choices.empty()) {
-                        ImGui::Text("Choices: %d", static_cast<int>(choices.size()));
-                    }
+                if (const DialogueBank* bank = dialogueRunner->GetBank())
+                    ImGui::Text("Bank: %s (node %u of %u)", bank->GetName().c_str(),
+                                dialogueRunner->GetBankNode(), bank->GetNodeCount());
+                ImGui::Text("Speaker: %s", dialogueRunner->GetSpeaker().c_str());
+                ImGui::TextWrapped("Text: %s", dialogueRunner->GetVisibleText().c_str());
+                auto choices = dialogueRunner->GetChoiceTexts();
+                if (!choices.empty()) {
+                    ImGui::Text("Choices: %d", static_cast<int>(choices.size()));
                 }
             }
-            ImGui::TextDisabled("(Dialogue trees are built via script or code)");
+            ImGui::TextDisabled("(Dialogue trees are built in code; banks compile from .gvdlg)");
         }
     }
 
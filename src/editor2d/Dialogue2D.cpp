@@ -61,19 +61,16 @@ std::vector<std::string> DialogueTree::GetAllNodeIDs() const {
 // DialogueRunner2D — static flags
 // ════════════════════════════════════════════════════════════════════════════
 
-std::unordered_map<std::string, bool> DialogueRunner2D::s_Flags;
-
 void DialogueRunner2D::SetFlag(const std::string& flag, bool value) {
-    s_Flags[flag] = value;
+    DialogueVariables::Global().Set(flag, value ? 1.0 : 0.0);
 }
 
 bool DialogueRunner2D::HasFlag(const std::string& flag) {
-    auto it = s_Flags.find(flag);
-    return (it != s_Flags.end()) && it->second;
+    return DialogueVariables::Global().Get(flag) != 0.0;
 }
 
 void DialogueRunner2D::ClearAllFlags() {
-    s_Flags.clear();
+    DialogueVariables::Global().Reset();
 }
 
 // ════════════════════════════════════════════════════════════════════════════
@@ -83,6 +80,8 @@ void DialogueRunner2D::ClearAllFlags() {
 void DialogueRunner2D::StartDialogue(DialogueTree* tree) {
     if (!tree || tree->GetNodeCount() == 0) return;
 
+    m_Bank.reset();
+    m_BankNode = DialogueBank::kNone;
     m_Tree     = tree;
     m_Active   = true;
     m_Finished = false;
@@ -90,6 +89,20 @@ void DialogueRunner2D::StartDialogue(DialogueTree* tree) {
     EnterNode(tree->GetStartNodeID());
 }
 
+void DialogueRunner2D::StartDialogue(Shared<DialogueBank> bank, u32 node, DialogueVariables* vars) {
+    if (!bank || !bank->IsOpen()) return;
+    if (node == DialogueBank::kNone) node = bank->GetStartNode();
+    if (node >= bank->GetNodeCount()) return;
+
+    m_Tree     = nullptr;
+    m_Bank     = std::move(bank);
+    m_Vars     = vars ? vars : &DialogueVariables::Global();
+    m_Active   = true;
+    m_Finished = false;
+
+    EnterBankNode(node);
+}
+
 void DialogueRunner2D::EndDialogue() {
     if (!m_Active) return;
 
@@ -102,12 +115,23 @@ void DialogueRunner2D::EndDialogue() {
     m_Active   = false;
     m_Finished = true;
     m_Tree     = nullptr;
+    m_Bank.reset();
+    m_BankNode = DialogueBank::kNone;
     m_CurrentID.clear();
+    m_Speaker.clear();
     m_FullText.clear();
     m_VisibleText.clear();
 }
 
 void DialogueRunner2D::ChooseOption(i32 index) {
+    if (m_Active && m_Bank) {
+        std::vector<u32> choices = BankChoices();
+        if (index < 0 || index >= static_cast<i32>(choices.size())) return;
+        u32 target = m_Bank->GetChoice(choices[static_cast<size_t>(index)]).target;
+        if (target == DialogueBank::kNone) EndDialogue();
+        else EnterBankNode(target);
+        return;
+    }
     if (!m_Active || !m_Tree) return;
 
     auto choices = GetAvailableChoices();
@@ -128,7 +152,7 @@ void DialogueRunner2D::ChooseOption(i32 index) {
 }
 
 void DialogueRunner2D::Advance() {
-    if (!m_Active || !m_Tree) return;
+    if (!m_Active || (!m_Tree && !m_Bank)) return;
 
     // If still revealing text, skip to full
     if (m_Revealing) {
@@ -136,6 +160,14 @@ void DialogueRunner2D::Advance() {
         return;
     }
 
+    if (m_Bank) {
+        if (!BankChoices().empty()) return;
+        u32 next = m_Bank->GetNextNode(m_BankNode, *m_Vars);
+        if (next == DialogueBank::kNone) EndDialogue();
+        else EnterBankNode(next);
+        return;
+    }
+
     auto* node = m_Tree->GetNode(m_CurrentID);
     if (!node) { EndDialogue(); return; }
 
@@ -208,8 +240,42 @@ std::vector<const DialogueChoice*> DialogueRunner2D::GetAvailableChoices() const
     return result;
 }
 
+std::vector<std::string_view> DialogueRunner2D::GetChoiceTexts() const {
+    std::vector<std::string_view> texts;
+    if (m_Active && m_Bank) {
+        for (u32 c : BankChoices()) texts.push_back(m_Bank->GetString(m_Bank->GetChoice(c).text));
+        return texts;
+    }
+    for (const DialogueChoice* c : GetAvailableChoices()) texts.push_back(c->text);
+    return texts;
+}
+
 // ── Private ────────────────────────────────────────────────────────────────
 
+std::vector<u32> DialogueRunner2D::BankChoices() const {
+    std::vector<u32> choices;
+    if (m_Bank) m_Bank->GetAvailableChoices(m_BankNode, *m_Vars, choices);
+    return choices;
+}
+
+void DialogueRunner2D::EnterBankNode(u32 node) {
+    m_BankNode = node;
+    DialogueBank::Node n = m_Bank->GetNode(node);
+    m_Bank->Run(n.actions, *m_Vars);
+    m_CurrentID = std::string(m_Bank->GetNodeName(node));
+    m_Speaker   = std::string(m_Bank->GetString(n.speaker));
+    StartReveal(std::string(m_Bank->GetString(n.text)));
+}
+
+void DialogueRunner2D::StartReveal(const std::string& text) {
+    m_FullText       = text;
+    m_VisibleText.clear();
+    m_RevealTimer    = 0.0f;
+    m_CharsRevealed  = 0;
+    m_Revealing      = true;
+    m_AutoTimer      = 0.0f;
+}
+
 void DialogueRunner2D::EnterNode(const std::string& nodeID) {
     m_CurrentID = nodeID;
 
@@ -228,12 +294,8 @@ void DialogueRunner2D::EnterNode(const std::string& nodeID) {
     if (node->onEnter) node->onEnter();
 
     // Start typewriter
-    m_FullText       = node->text;
-    m_VisibleText.clear();
-    m_RevealTimer    = 0.0f;
-    m_CharsRevealed  = 0;
-    m_Revealing      = true;
-    m_AutoTimer      = 0.0f;
+    m_Speaker = node->speaker;
+    StartReveal(node->text);
 }
 
 } // namespace gv
@@ -0,0 +1,1169 @@
+// ============================================================================
+// GameVoid Engine — Compiled Dialogue Banks Implementation
+// ============================================================================
+#include "editor2d/DialogueBank.h"
+#include "editor2d/Dialogue2D.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace gv {
+
+namespace fs = std::filesystem;
+
+// ════════════════════════════════════════════════════════════════════════════
+// DialogueVariables
+// ════════════════════════════════════════════════════════════════════════════
+
+DialogueVariables::DialogueVariables() {
+    static u32 s_NextId = 1;
+    m_Id = s_NextId++;
+}
+
+DialogueVariables& DialogueVariables::Global() {
+    static DialogueVariables s_Global;
+    return s_Global;
+}
+
+u32 DialogueVariables::Intern(const std::string& name) {
+    auto it = m_Index.find(name);
+    if (it != m_Index.end()) return it->second;
+    u32 index = static_cast<u32>(m_Values.size());
+    m_Index.emplace(name, index);
+    m_Names.push_back(name);
+    m_Values.push_back(0.0);
+    return index;
+}
+
+u32 DialogueVariables::Find(const std::string& name) const {
+    auto it = m_Index.find(name);
+    return it == m_Index.end() ? kInvalid : it->second;
+}
+
+void DialogueVariables::Reset() {
+    std::fill(m_Values.begin(), m_Values.end(), 0.0);
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Bank layout
+// ════════════════════════════════════════════════════════════════════════════
+// Little-endian:
+//   [0]  12-byte identifier  «GVDB 10»\r\n\x1A
+//   [12] u32 nodeCount, choiceCount, linkCount, stringCount, varCount,
+//            codeSize, charBytes, startNode, reserved
+//   [48] nodes    nodeCount   × { u32 speaker, text, actions, firstChoice,
+//                                 firstLink; u16 choiceCount, linkCount }
+//        choices  choiceCount × { u32 text, target, condition }
+//        links    linkCount   × { u32 target, condition }
+//        strings  stringCount × { u32 offset, length, key }
+//        names    (nodeCount + varCount) × { u32 offset, length }
+//        order    nodeCount   × u32   node indices sorted by name
+//        code     codeSize bytes
+//        chars    charBytes   string, name and variable text (not terminated)
+namespace {
+
+const u8 kGVDBIdentifier[12] = { 0xAB, 'G', 'V', 'D', 'B', ' ', '1', '0', 0xBB, '\r', '\n', 0x1A };
+constexpr size_t kGVDBHeaderSize = 48;
+constexpr size_t kNodeSize   = 24;
+constexpr size_t kChoiceSize = 12;
+constexpr size_t kLinkSize   = 8;
+constexpr size_t kStringSize = 12;
+constexpr size_t kNameSize   = 8;
+
+constexpr u32 kNone = DialogueBank::kNone;
+constexpr u32 kStackSize = 16;          // deepest expression the compiler accepts
+
+// Condition / action bytecode.  Operands follow the opcode, little-endian.
+enum Op : u8 {
+    OpEnd,              // result = top of stack (0 if empty)
+    OpConst,            // f64
+    OpSmall,            // i8
+    OpLoad,             // u16 variable
+    OpStore,            // u16 variable; pops
+    OpNot, OpNeg,
+    OpAdd, OpSub, OpMul, OpDiv, OpMod,
+    OpEq, OpNe, OpLt, OpLe, OpGt, OpGe,
+    OpJumpIfFalse,      // u16 forward offset; keeps the tested value
+    OpJumpIfTrue,       // u16
+    OpPop,
+};
+
+template <typename T>
+void Put(std::vector<u8>& buf, size_t at, T v) { std::memcpy(&buf[at], &v, sizeof(T)); }
+template <typename T>
+void Append(std::vector<u8>& buf, T v) {
+    size_t at = buf.size();
+    buf.resize(at + sizeof(T));
+    Put<T>(buf, at, v);
+}
+template <typename T>
+T Get(const u8* p) { T v; std::memcpy(&v, p, sizeof(T)); return v; }
+
+u32 HashText(std::string_view text) {
+    u32 h = 2166136261u;                // FNV-1a
+    for (char c : text) { h ^= static_cast<u8>(c); h *= 16777619u; }
+    return h;
+}
+
+std::string Trim(const std::string& s) {
+    size_t b = s.find_first_not_of(" \t");
+    if (b == std::string::npos) return std::string();
+    size_t e = s.find_last_not_of(" \t");
+    return s.substr(b, e - b + 1);
+}
+
+bool IsNameChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.' || c == '-';
+}
+
+/// Operand bytes after `op`, or -1 if `op` is not an opcode.
+i32 OperandSize(u8 op) {
+    switch (op) {
+    case OpConst:                        return 8;
+    case OpSmall:                        return 1;
+    case OpLoad: case OpStore:
+    case OpJumpIfFalse: case OpJumpIfTrue: return 2;
+    default:                             return op <= OpPop ? 0 : -1;
+    }
+}
+
+/// Walk the whole code section once: every opcode known, every operand
+/// inside it, every variable declared and every jump landing on an
+/// instruction.  `starts` marks where instructions begin.
+bool VerifyCode(const u8* code, u32 size, u32 varCount, std::vector<bool>& starts) {
+    starts.assign(size, false);
+    std::vector<u32> jumps;
+    for (u32 pc = 0; pc < size;) {
+        const u8 op = code[pc];
+        const i32 operands = OperandSize(op);
+        if (operands < 0 || static_cast<u64>(pc) + 1 + operands > size) return false;
+        starts[pc] = true;
+        if ((op == OpLoad || op == OpStore) && Get<u16>(code + pc + 1) >= varCount) return false;
+        if (op == OpJumpIfFalse || op == OpJumpIfTrue) jumps.push_back(pc + 3 + Get<u16>(code + pc + 1));
+        pc += 1 + operands;
+    }
+    for (u32 target : jumps)
+        if (target >= size || !starts[target]) return false;
+    return true;
+}
+
+} // anonymous namespace
+
+// ════════════════════════════════════════════════════════════════════════════
+// DialogueBank — loading
+// ════════════════════════════════════════════════════════════════════════════
+
+bool DialogueBank::Open(const std::string& path) {
+    Close();
+    if (!m_File.Open(path)) return false;
+    m_Data = m_File.Data();
+    m_Size = m_File.Size();
+    m_Name = fs::path(path).stem().string();
+    if (!Parse()) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool DialogueBank::Load(std::vector<u8> bytes, const std::string& name) {
+    Close();
+    m_Bytes = std::move(bytes);
+    m_Data = m_Bytes.data();
+    m_Size = m_Bytes.size();
+    m_Name = name;
+    if (!Parse()) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void DialogueBank::Close() {
+    m_File.Close();
+    m_Bytes.clear();
+    m_Data = nullptr;
+    m_Size = 0;
+    m_NodeCount = m_ChoiceCount = m_LinkCount = m_StringCount = 0;
+    m_VarCount = m_CodeSize = m_CharBytes = 0;
+    m_Start = kNone;
+    m_Translation.clear();
+    m_Translated.clear();
+    m_BoundStore = 0;
+    m_Slots.clear();
+}
+
+bool DialogueBank::Parse() {
+    const u8* d = m_Data;
+    if (!d || m_Size < kGVDBHeaderSize || std::memcmp(d, kGVDBIdentifier, sizeof(kGVDBIdentifier)) != 0)
+        return false;
+    m_NodeCount   = Get<u32>(d + 12);
+    m_ChoiceCount = Get<u32>(d + 16);
+    m_LinkCount   = Get<u32>(d + 20);
+    m_StringCount = Get<u32>(d + 24);
+    m_VarCount    = Get<u32>(d + 28);
+    m_CodeSize    = Get<u32>(d + 32);
+    m_CharBytes   = Get<u32>(d + 36);
+    m_Start       = Get<u32>(d + 40);
+
+    // Section offsets in 64 bits, so hostile counts can't wrap.
+    const u64 sizes[8] = {
+        static_cast<u64>(m_NodeCount) * kNodeSize, static_cast<u64>(m_ChoiceCount) * kChoiceSize,
+        static_cast<u64>(m_LinkCount) * kLinkSize, static_cast<u64>(m_StringCount) * kStringSize,
+        (static_cast<u64>(m_NodeCount) + m_VarCount) * kNameSize, static_cast<u64>(m_NodeCount) * 4,
+        m_CodeSize, m_CharBytes,
+    };
+    u64 offsets[8];
+    u64 at = kGVDBHeaderSize;
+    for (int i = 0; i < 8; ++i) { offsets[i] = at; at += sizes[i]; }
+    if (at != m_Size || m_NodeCount == 0 || m_Start >= m_NodeCount || m_VarCount > 0xFFFF) return false;
+    m_Nodes   = d + offsets[0];
+    m_Choices = d + offsets[1];
+    m_Links   = d + offsets[2];
+    m_Strings = d + offsets[3];
+    m_Names   = d + offsets[4];
+    m_Order   = d + offsets[5];
+    m_Code    = d + offsets[6];
+    m_Chars   = d + offsets[7];
+
+    // Every reference is checked once here, so accessors can trust them.
+    // Code is rejected outright if any instruction is malformed.
+    std::vector<bool> starts;
+    if (!VerifyCode(m_Code, m_CodeSize, m_VarCount, starts)) return false;
+    auto okString = [&](u32 s) { return s == kNone || s < m_StringCount; };
+    auto okCode   = [&](u32 c) { return c == kNone || (c < m_CodeSize && starts[c]); };
+    auto okTarget = [&](u32 n) { return n == kNone || n < m_NodeCount; };
+    auto okChars  = [&](const u8* e) {
+        return static_cast<u64>(Get<u32>(e)) + Get<u32>(e + 4) <= m_CharBytes;
+    };
+    for (u32 i = 0; i < m_NodeCount; ++i) {
+        Node n = GetNode(i);
+        if (!okString(n.speaker) || !okString(n.text) || !okCode(n.actions) ||
+            static_cast<u64>(n.firstChoice) + n.choiceCount > m_ChoiceCount ||
+            static_cast<u64>(n.firstLink) + n.linkCount > m_LinkCount ||
+            Get<u32>(m_Order + i * 4) >= m_NodeCount)
+            return false;
+    }
+    for (u32 i = 0; i < m_ChoiceCount; ++i) {
+        Choice c = GetChoice(i);
+        if (!okString(c.text) || !okTarget(c.target) || !okCode(c.condition)) return false;
+    }
+    for (u32 i = 0; i < m_LinkCount; ++i) {
+        Link l = GetLink(i);
+        if (!okTarget(l.target) || !okCode(l.condition)) return false;
+    }
+    for (u32 i = 0; i < m_StringCount; ++i)
+        if (!okChars(m_Strings + i * kStringSize)) return false;
+    for (u32 i = 0; i < m_NodeCount + m_VarCount; ++i)
+        if (!okChars(m_Names + i * kNameSize)) return false;
+
+    m_Translation.assign(m_StringCount, std::string());
+    m_Translated.assign(m_StringCount, 0);
+    return true;
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// DialogueBank — graph and strings
+// ════════════════════════════════════════════════════════════════════════════
+
+DialogueBank::Node DialogueBank::GetNode(u32 node) const {
+    const u8* e = m_Nodes + static_cast<size_t>(node) * kNodeSize;
+    Node n;
+    n.speaker     = Get<u32>(e);
+    n.text        = Get<u32>(e + 4);
+    n.actions     = Get<u32>(e + 8);
+    n.firstChoice = Get<u32>(e + 12);
+    n.firstLink   = Get<u32>(e + 16);
+    n.choiceCount = Get<u16>(e + 20);
+    n.linkCount   = Get<u16>(e + 22);
+    return n;
+}
+
+DialogueBank::Choice DialogueBank::GetChoice(u32 choice) const {
+    const u8* e = m_Choices + static_cast<size_t>(choice) * kChoiceSize;
+    Choice c;
+    c.text      = Get<u32>(e);
+    c.target    = Get<u32>(e + 4);
+    c.condition = Get<u32>(e + 8);
+    return c;
+}
+
+DialogueBank::Link DialogueBank::GetLink(u32 link) const {
+    const u8* e = m_Links + static_cast<size_t>(link) * kLinkSize;
+    Link l;
+    l.target    = Get<u32>(e);
+    l.condition = Get<u32>(e + 4);
+    return l;
+}
+
+std::string_view DialogueBank::Chars(u32 offset, u32 length) const {
+    return std::string_view(reinterpret_cast<const char*>(m_Chars) + offset, length);
+}
+
+std::string_view DialogueBank::GetNodeName(u32 node) const {
+    if (node >= m_NodeCount) return std::string_view();
+    const u8* e = m_Names + static_cast<size_t>(node) * kNameSize;
+    return Chars(Get<u32>(e), Get<u32>(e + 4));
+}
+
+std::string_view DialogueBank::GetVariableName(u32 var) const {
+    if (var >= m_VarCount) return std::string_view();
+    const u8* e = m_Names + (static_cast<size_t>(m_NodeCount) + var) * kNameSize;
+    return Chars(Get<u32>(e), Get<u32>(e + 4));
+}
+
+u32 DialogueBank::FindNode(std::string_view name) const {
+    u32 lo = 0, hi = m_NodeCount;
+    while (lo < hi) {
+        u32 mid = lo + (hi - lo) / 2;
+        u32 node = Get<u32>(m_Order + static_cast<size_t>(mid) * 4);
+        std::string_view at = GetNodeName(node);
+        if (at == name) return node;
+        if (at < name) lo = mid + 1;
+        else hi = mid;
+    }
+    return kNone;
+}
+
+std::string_view DialogueBank::GetSourceString(u32 index) const {
+    if (index >= m_StringCount) return std::string_view();
+    const u8* e = m_Strings + static_cast<size_t>(index) * kStringSize;
+    return Chars(Get<u32>(e), Get<u32>(e + 4));
+}
+
+std::string_view DialogueBank::GetString(u32 index) const {
+    if (index < m_StringCount && m_Translated[index]) return m_Translation[index];
+    return GetSourceString(index);
+}
+
+u32 DialogueBank::GetStringKey(u32 index) const {
+    if (index >= m_StringCount) return 0;
+    return Get<u32>(m_Strings + static_cast<size_t>(index) * kStringSize + 8);
+}
+
+// ── Translation files ──────────────────────────────────────────────────────
+
+u32 DialogueBank::LoadTranslation(const std::string& path) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f.is_open() || !IsOpen()) return 0;
+
+    std::unordered_map<u32, std::vector<u32>> byKey;
+    for (u32 i = 0; i < m_StringCount; ++i) byKey[GetStringKey(i)].push_back(i);
+
+    u32 applied = 0;
+    std::string line;
+    while (std::getline(f, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        size_t tab = line.find('\t');
+        if (line.empty() || line[0] == '#' || tab == std::string::npos || tab == 0 || tab > 8) continue;
+        if (line.find_first_not_of("0123456789abcdefABCDEF") < tab) continue;
+        u32 key = static_cast<u32>(std::stoul(line.substr(0, tab), nullptr, 16));
+        auto it = byKey.find(key);
+        if (it == byKey.end()) continue;
+
+        std::string text;
+        for (size_t i = tab + 1; i < line.size(); ++i) {
+            char c = line[i];
+            if (c == '\\' && i + 1 < line.size()) {
+                char n = line[++i];
+                text += n == 'n' ? '\n' : n == 't' ? '\t' : n;
+            } else {
+                text += c;
+            }
+        }
+        for (u32 index : it->second) {
+            m_Translation[index] = text;
+            m_Translated[index] = 1;
+            ++applied;
+        }
+    }
+    return applied;
+}
+
+void DialogueBank::ClearTranslation() {
+    std::fill(m_Translation.begin(), m_Translation.end(), std::string());
+    std::fill(m_Translated.begin(), m_Translated.end(), 0);
+}
+
+bool DialogueBank::ExportStrings(const std::string& path) const {
+    if (!IsOpen()) return false;
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    if (!f.is_open()) {
+        GV_LOG_ERROR("DialogueBank — cannot write '" + path + "'");
+        return false;
+    }
+    f << "# " << m_Name << ": " << m_StringCount << " strings (key<TAB>text)\n";
+    char key[16];
+    for (u32 i = 0; i < m_StringCount; ++i) {
+        std::snprintf(key, sizeof(key), "%08x\t", GetStringKey(i));
+        f << key;
+        for (char c : GetSourceString(i)) {
+            if (c == '\n') f << "\\n";
+            else if (c == '\t') f << "\\t";
+            else if (c == '\\') f << "\\\\";
+            else f << c;
+        }
+        f << '\n';
+    }
+    return static_cast<bool>(f);
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// DialogueBank — evaluation
+// ════════════════════════════════════════════════════════════════════════════
+
+const std::vector<u32>& DialogueBank::Bind(DialogueVariables& vars) const {
+    if (m_BoundStore != vars.GetId()) {
+        m_Slots.resize(m_VarCount);
+        for (u32 i = 0; i < m_VarCount; ++i) m_Slots[i] = vars.Intern(std::string(GetVariableName(i)));
+        m_BoundStore = vars.GetId();
+    }
+    return m_Slots;
+}
+
+f64 DialogueBank::Execute(u32 code, DialogueVariables& vars) const {
+    const std::vector<u32>& slots = Bind(vars);
+    f64 stack[kStackSize];
+    u32 sp = 0;
+    u32 pc = code;
+    // Parse() verified the instructions; the stack depth depends on the
+    // path taken, so it is still checked here and a bad program just stops.
+    auto has = [&](u32 bytes) { return static_cast<u64>(pc) + bytes <= m_CodeSize; };
+    while (pc < m_CodeSize) {
+        u8 op = m_Code[pc++];
+        if (op >= OpNot && op <= OpGe) {
+            bool binary = op >= OpAdd;
+            if (sp < (binary ? 2u : 1u)) return 0.0;
+            f64 b = stack[sp - 1];
+            f64 a = binary ? stack[sp - 2] : 0.0;
+            f64 r = 0.0;
+            switch (op) {
+            case OpNot: r = b == 0.0 ? 1.0 : 0.0; break;
+            case OpNeg: r = -b; break;
+            case OpAdd: r = a + b; break;
+            case OpSub: r = a - b; break;
+            case OpMul: r = a * b; break;
+            case OpDiv: r = b != 0.0 ? a / b : 0.0; break;
+            case OpMod: r = b != 0.0 ? std::fmod(a, b) : 0.0; break;
+            case OpEq:  r = a == b; break;
+            case OpNe:  r = a != b; break;
+            case OpLt:  r = a < b; break;
+            case OpLe:  r = a <= b; break;
+            case OpGt:  r = a > b; break;
+            default:    r = a >= b; break;
+            }
+            if (binary) --sp;
+            stack[sp - 1] = r;
+            continue;
+        }
+        switch (op) {
+        case OpEnd:
+            return sp ? stack[sp - 1] : 0.0;
+        case OpConst:
+            if (!has(8) || sp == kStackSize) return 0.0;
+            stack[sp++] = Get<f64>(m_Code + pc);
+            pc += 8;
+            break;
+        case OpSmall:
+            if (!has(1) || sp == kStackSize) return 0.0;
+            stack[sp++] = static_cast<f64>(static_cast<i8>(m_Code[pc++]));
+            break;
+        case OpLoad: {
+            if (!has(2) || sp == kStackSize) return 0.0;
+            u16 var = Get<u16>(m_Code + pc);
+            pc += 2;
+            stack[sp++] = var < m_VarCount ? vars.Get(slots[var]) : 0.0;
+            break;
+        }
+        case OpStore: {
+            if (!has(2) || sp == 0) return 0.0;
+            u16 var = Get<u16>(m_Code + pc);
+            pc += 2;
+            --sp;
+            if (var < m_VarCount) vars.Set(slots[var], stack[sp]);
+            break;
+        }
+        case OpJumpIfFalse:
+        case OpJumpIfTrue: {
+            if (!has(2) || sp == 0) return 0.0;
+            u16 offset = Get<u16>(m_Code + pc);
+            pc += 2;
+            if ((stack[sp - 1] != 0.0) == (op == OpJumpIfTrue)) pc += offset;
+            break;
+        }
+        case OpPop:
+            if (sp == 0) return 0.0;
+            --sp;
+            break;
+        default:
+            return 0.0;
+        }
+    }
+    return 0.0;
+}
+
+bool DialogueBank::Test(u32 code, DialogueVariables& vars) const {
+    return code == kNone || Execute(code, vars) != 0.0;
+}
+
+void DialogueBank::Run(u32 code, DialogueVariables& vars) const {
+    if (code != kNone) Execute(code, vars);
+}
+
+void DialogueBank::GetAvailableChoices(u32 node, DialogueVariables& vars, std::vector<u32>& out) const {
+    out.clear();
+    if (node >= m_NodeCount) return;
+    Node n = GetNode(node);
+    for (u32 i = n.firstChoice; i < n.firstChoice + n.choiceCount; ++i)
+        if (Test(GetChoice(i).condition, vars)) out.push_back(i);
+}
+
+u32 DialogueBank::GetNextNode(u32 node, DialogueVariables& vars) const {
+    if (node >= m_NodeCount) return kNone;
+    Node n = GetNode(node);
+    for (u32 i = n.firstLink; i < n.firstLink + n.linkCount; ++i) {
+        Link l = GetLink(i);
+        if (Test(l.condition, vars)) return l.target;
+    }
+    return kNone;
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// DialogueCompiler
+// ════════════════════════════════════════════════════════════════════════════
+namespace {
+
+/// Everything a bank holds, with names still unresolved.
+struct BankBuilder {
+    struct ChoiceSrc { std::string text, target; u32 condition = kNone; i32 line = 0; };
+    struct LinkSrc   { std::string target; u32 condition = kNone; i32 line = 0; };
+    struct NodeSrc {
+        std::string name, speaker, text;
+        std::vector<std::pair<std::string, i32>> actions;   // statement text, line
+        u32 actionCode = kNone;
+        std::vector<ChoiceSrc> choices;
+        std::vector<LinkSrc>   links;
+        i32 line = 0;
+    };
+
+    std::string name;
+    std::string error;
+    std::vector<NodeSrc> nodes;
+    std::unordered_map<std::string, u32> nodeIndex;
+    std::vector<std::string> strings;
+    std::unordered_map<std::string, u32> stringIndex;
+    std::vector<std::string> vars;
+    std::unordered_map<std::string, u32> varIndex;
+    std::vector<u8> code;
+    std::unordered_map<std::string, u32> codeCache;     // identical programs share code
+
+    /// Line 0 = the bank as a whole.
+    bool Fail(i32 line, const std::string& message) {
+        error = name + (line > 0 ? ":" + std::to_string(line) : std::string()) + ": " + message;
+        return false;
+    }
+
+    u32 String(const std::string& s) {
+        if (s.empty()) return kNone;
+        auto it = stringIndex.find(s);
+        if (it != stringIndex.end()) return it->second;
+        u32 index = static_cast<u32>(strings.size());
+        strings.push_back(s);
+        stringIndex.emplace(s, index);
+        return index;
+    }
+
+    bool Var(const std::string& v, u16& out, i32 line) {
+        auto it = varIndex.find(v);
+        if (it == varIndex.end()) {
+            if (vars.size() > 0xFFFF) return Fail(line, "too many variables");
+            it = varIndex.emplace(v, static_cast<u32>(vars.size())).first;
+            vars.push_back(v);
+        }
+        out = static_cast<u16>(it->second);
+        return true;
+    }
+
+    /// Script names are checked; tree ids may be any non-empty string.
+    bool AddNode(const std::string& nodeName, i32 line, bool checkName = true) {
+        if (nodeName.empty() || (checkName && !std::all_of(nodeName.begin(), nodeName.end(), IsNameChar)))
+            return Fail(line, "bad node name '" + nodeName + "'");
+        if (nodeName == "END") return Fail(line, "END is reserved");
+        if (!nodeIndex.emplace(nodeName, static_cast<u32>(nodes.size())).second)
+            return Fail(line, "node '" + nodeName + "' defined twice");
+        nodes.emplace_back();
+        nodes.back().name = nodeName;
+        nodes.back().line = line;
+        return true;
+    }
+
+    bool Compile(const std::vector<std::pair<std::string, i32>>& pieces, bool condition, u32& out);
+    bool Build(u32 start, std::vector<u8>& out);
+};
+
+// ── Expressions ────────────────────────────────────────────────────────────
+class ExprCompiler {
+public:
+    ExprCompiler(BankBuilder& bank, std::vector<u8>& out, const std::string& text, i32 line)
+        : m_Bank(bank), m_Code(out), m_Text(text), m_Line(line) {}
+
+    /// Whole input as one expression.
+    bool Condition() {
+        if (!Or()) return false;
+        Skip();
+        if (m_Pos < m_Text.size()) return Error("unexpected '" + m_Text.substr(m_Pos, 12) + "'");
+        return true;
+    }
+
+    /// "a = expr; b += expr, c -= expr"
+    bool Actions() {
+        for (;;) {
+            Skip();
+            if (m_Pos >= m_Text.size()) return true;
+            if (Accept(";") || Accept(",")) continue;
+            std::string target;
+            if (!Identifier(target) || IsKeyword(target)) return Error("expected 'variable = value'");
+            Op combine = OpEnd;
+            if (Accept("+=")) combine = OpAdd;
+            else if (Accept("-=")) combine = OpSub;
+            else if (!Accept("=")) return Error("expected '=', '+=' or '-=' after '" + target + "'");
+            u16 var = 0;
+            if (!m_Bank.Var(target, var, m_Line)) return false;
+            if (combine != OpEnd) EmitVar(OpLoad, var, +1);
+            if (!Or()) return false;
+            if (combine != OpEnd) Emit(combine, -1);
+            EmitVar(OpStore, var, -1);
+            Skip();
+            if (m_Pos < m_Text.size() && m_Text[m_Pos] != ';' && m_Text[m_Pos] != ',')
+                return Error("expected ';' between actions");
+        }
+    }
+
+private:
+    bool Error(const std::string& message) {
+        if (m_Bank.error.empty()) m_Bank.Fail(m_Line, message + " in '" + m_Text + "'");
+        return false;
+    }
+
+    void Skip() { while (m_Pos < m_Text.size() && std::isspace(static_cast<unsigned char>(m_Text[m_Pos]))) ++m_Pos; }
+
+    bool Accept(const char* token) {
+        Skip();
+        size_t n = std::strlen(token);
+        if (m_Text.compare(m_Pos, n, token) != 0) return false;
+        // "=" must not swallow "==", nor "<" swallow "<="
+        if (n == 1 && (token[0] == '=' || token[0] == '<' || token[0] == '>' || token[0] == '!') &&
+            m_Pos + 1 < m_Text.size() && m_Text[m_Pos + 1] == '=')
+            return false;
+        m_Pos += n;
+        return true;
+    }
+
+    bool AcceptWord(const char* word) {
+        Skip();
+        size_t n = std::strlen(word);
+        if (m_Text.compare(m_Pos, n, word) != 0) return false;
+        if (m_Pos + n < m_Text.size() && IsNameChar(m_Text[m_Pos + n])) return false;
+        m_Pos += n;
+        return true;
+    }
+
+    bool Identifier(std::string& out) {
+        Skip();
+        size_t start = m_Pos;
+        if (m_Pos >= m_Text.size() || !(std::isalpha(static_cast<unsigned char>(m_Text[m_Pos])) || m_Text[m_Pos] == '_'))
+            return false;
+        while (m_Pos < m_Text.size() && (IsNameChar(m_Text[m_Pos]) && m_Text[m_Pos] != '-')) ++m_Pos;
+        out = m_Text.substr(start, m_Pos - start);
+        return true;
+    }
+
+    static bool IsKeyword(const std::string& w) {
+        return w == "and" || w == "or" || w == "not" || w == "true" || w == "false";
+    }
+
+    void Emit(u8 op, i32 stackEffect) {
+        m_Code.push_back(op);
+        m_Depth += stackEffect;
+    }
+    void EmitVar(u8 op, u16 var, i32 stackEffect) {
+        Emit(op, stackEffect);
+        Append<u16>(m_Code, var);
+    }
+    void EmitNumber(f64 v) {
+        if (v == std::floor(v) && v >= -128 && v <= 127) {
+            Emit(OpSmall, +1);
+            m_Code.push_back(static_cast<u8>(static_cast<i8>(v)));
+        } else {
+            Emit(OpConst, +1);
+            Append<f64>(m_Code, v);
+        }
+    }
+
+    /// `a or b`: a; JumpIfTrue end; Pop; b; end:
+    bool ShortCircuit(u8 jump, bool (ExprCompiler::*operand)()) {
+        Emit(jump, 0);
+        size_t at = m_Code.size();
+        Append<u16>(m_Code, 0);
+        Emit(OpPop, -1);
+        if (!(this->*operand)()) return false;
+        size_t distance = m_Code.size() - (at + 2);
+        if (distance > 0xFFFF) return Error("expression too long");
+        Put<u16>(m_Code, at, static_cast<u16>(distance));
+        return true;
+    }
+
+    bool Or() {
+        if (!And()) return false;
+        while (AcceptWord("or") || Accept("||"))
+            if (!ShortCircuit(OpJumpIfTrue, &ExprCompiler::And)) return false;
+        return true;
+    }
+
+    bool And() {
+        if (!Not()) return false;
+        while (AcceptWord("and") || Accept("&&"))
+            if (!ShortCircuit(OpJumpIfFalse, &ExprCompiler::Not)) return false;
+        return true;
+    }
+
+    bool Not() {
+        if (AcceptWord("not") || Accept("!")) {
+            if (!Not()) return false;
+            Emit(OpNot, 0);
+            return true;
+        }
+        return Compare();
+    }
+
+    bool Compare() {
+        if (!Sum()) return false;
+        static const std::pair<const char*, Op> ops[] = {
+            { "==", OpEq }, { "!=", OpNe }, { "<=", OpLe }, { ">=", OpGe }, { "<", OpLt }, { ">", OpGt },
+        };
+        for (const auto& o : ops) {
+            if (!Accept(o.first)) continue;
+            if (!Sum()) return false;
+            Emit(o.second, -1);
+            return true;
+        }
+        return true;
+    }
+
+    bool Sum() {
+        if (!Product()) return false;
+        for (;;) {
+            Op op = Accept("+") ? OpAdd : Accept("-") ? OpSub : OpEnd;
+            if (op == OpEnd) return true;
+            if (!Product()) return false;
+            Emit(op, -1);
+        }
+    }
+
+    bool Product() {
+        if (!Unary()) return false;
+        for (;;) {
+            Op op = Accept("*") ? OpMul : Accept("/") ? OpDiv : Accept("%") ? OpMod : OpEnd;
+            if (op == OpEnd) return true;
+            if (!Unary()) return false;
+            Emit(op, -1);
+        }
+    }
+
+    bool Unary() {
+        if (Accept("-")) {
+            if (!Unary()) return false;
+            Emit(OpNeg, 0);
+            return true;
+        }
+        return Primary();
+    }
+
+    bool Primary() {
+        if (m_Depth >= static_cast<i32>(kStackSize)) return Error("expression too deep");
+        Skip();
+        if (Accept("(")) {
+            if (!Or()) return false;
+            if (!Accept(")")) return Error("missing ')'");
+            return true;
+        }
+        if (m_Pos < m_Text.size() && (std::isdigit(static_cast<unsigned char>(m_Text[m_Pos])) || m_Text[m_Pos] == '.')) {
+            const char* begin = m_Text.c_str() + m_Pos;
+            char* end = nullptr;
+            f64 v = std::strtod(begin, &end);
+            if (end == begin) return Error("bad number");
+            m_Pos += static_cast<size_t>(end - begin);
+            EmitNumber(v);
+            return true;
+        }
+        std::string word;
+        if (!Identifier(word)) {
+            if (m_Pos >= m_Text.size()) return Error("expression ends early");
+            return Error(std::string("unexpected '") + m_Text[m_Pos] + "'");
+        }
+        if (word == "true" || word == "false") { EmitNumber(word == "true" ? 1.0 : 0.0); return true; }
+        if (IsKeyword(word)) return Error("unexpected '" + word + "'");
+        u16 var = 0;
+        if (!m_Bank.Var(word, var, m_Line)) return false;
+        EmitVar(OpLoad, var, +1);
+        return true;
+    }
+
+    BankBuilder& m_Bank;
+    std::vector<u8>& m_Code;
+    const std::string& m_Text;
+    i32 m_Line;
+    size_t m_Pos = 0;
+    i32 m_Depth = 0;                    // values on the stack at this point
+};
+
+bool BankBuilder::Compile(const std::vector<std::pair<std::string, i32>>& pieces, bool condition, u32& out) {
+    out = kNone;
+    std::string key = condition ? "?" : "!";
+    for (const auto& p : pieces) key += p.first + "\n";
+    auto cached = codeCache.find(key);
+    if (cached != codeCache.end()) { out = cached->second; return true; }
+
+    std::vector<u8> program;
+    for (const auto& p : pieces) {
+        ExprCompiler expr(*this, program, p.first, p.second);
+        if (!(condition ? expr.Condition() : expr.Actions())) return false;
+    }
+    if (program.empty()) return true;       // e.g. "~ ;"
+    program.push_back(OpEnd);
+    out = static_cast<u32>(code.size());
+    code.insert(code.end(), program.begin(), program.end());
+    codeCache.emplace(std::move(key), out);
+    return true;
+}
+
+bool BankBuilder::Build(u32 start, std::vector<u8>& out) {
+    if (nodes.empty()) return Fail(0, "no nodes");
+
+    auto resolve = [&](const std::string& target, i32 line, u32& node) {
+        if (target.empty() || target == "END") { node = kNone; return true; }
+        auto it = nodeIndex.find(target);
+        if (it == nodeIndex.end()) return Fail(line, "unknown node '" + target + "'");
+        node = it->second;
+        return true;
+    };
+
+    // ── Records ─────────────────────────────────────────────────────────────
+    std::vector<u8> nodeBytes, choiceBytes, linkBytes;
+    u32 choiceCount = 0, linkCount = 0;
+    for (NodeSrc& n : nodes) {
+        if (!n.actions.empty() && !Compile(n.actions, false, n.actionCode)) return false;
+        if (n.choices.size() > 0xFFFF || n.links.size() > 0xFFFF) return Fail(n.line, "too many choices or links");
+        Append<u32>(nodeBytes, String(n.speaker));
+        Append<u32>(nodeBytes, String(n.text));
+        Append<u32>(nodeBytes, n.actionCode);
+        Append<u32>(nodeBytes, choiceCount);
+        Append<u32>(nodeBytes, linkCount);
+        Append<u16>(nodeBytes, static_cast<u16>(n.choices.size()));
+        Append<u16>(nodeBytes, static_cast<u16>(n.links.size()));
+        for (const ChoiceSrc& c : n.choices) {
+            u32 target = kNone;
+            if (!resolve(c.target, c.line, target)) return false;
+            Append<u32>(choiceBytes, String(c.text));
+            Append<u32>(choiceBytes, target);
+            Append<u32>(choiceBytes, c.condition);
+        }
+        for (const LinkSrc& l : n.links) {
+            u32 target = kNone;
+            if (!resolve(l.target, l.line, target)) return false;
+            Append<u32>(linkBytes, target);
+            Append<u32>(linkBytes, l.condition);
+        }
+        choiceCount += static_cast<u32>(n.choices.size());
+        linkCount   += static_cast<u32>(n.links.size());
+    }
+
+    // ── Text ────────────────────────────────────────────────────────────────
+    std::string chars;
+    std::vector<u8> stringBytes, nameBytes;
+    std::unordered_map<u32, u32> keys;      // key → string, to catch collisions
+    auto addChars = [&](std::vector<u8>& table, const std::string& s) {
+        Append<u32>(table, static_cast<u32>(chars.size()));
+        Append<u32>(table, static_cast<u32>(s.size()));
+        chars += s;
+    };
+    for (u32 i = 0; i < strings.size(); ++i) {
+        u32 key = HashText(strings[i]);
+        if (!keys.emplace(key, i).second)
+            return Fail(0, "string key collision between \"" + strings[keys[key]] + "\" and \"" + strings[i] + "\"");
+        addChars(stringBytes, strings[i]);
+        Append<u32>(stringBytes, key);
+    }
+    for (const NodeSrc& n : nodes) addChars(nameBytes, n.name);
+    for (const std::string& v : vars) addChars(nameBytes, v);
+    if (chars.size() > 0xFFFFFFFFull || code.size() > 0xFFFFFFFFull) return Fail(0, "bank too large");
+
+    std::vector<u32> order(nodes.size());
+    for (u32 i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](u32 a, u32 b) { return nodes[a].name < nodes[b].name; });
+
+    // ── File ────────────────────────────────────────────────────────────────
+    out.assign(kGVDBHeaderSize, 0);
+    std::memcpy(out.data(), kGVDBIdentifier, sizeof(kGVDBIdentifier));
+    Put<u32>(out, 12, static_cast<u32>(nodes.size()));
+    Put<u32>(out, 16, choiceCount);
+    Put<u32>(out, 20, linkCount);
+    Put<u32>(out, 24, static_cast<u32>(strings.size()));
+    Put<u32>(out, 28, static_cast<u32>(vars.size()));
+    Put<u32>(out, 32, static_cast<u32>(code.size()));
+    Put<u32>(out, 36, static_cast<u32>(chars.size()));
+    Put<u32>(out, 40, start);
+    for (const std::vector<u8>* section : { &nodeBytes, &choiceBytes, &linkBytes, &stringBytes, &nameBytes })
+        out.insert(out.end(), section->begin(), section->end());
+    for (u32 node : order) Append<u32>(out, node);
+    out.insert(out.end(), code.begin(), code.end());
+    out.insert(out.end(), chars.begin(), chars.end());
+    return true;
+}
+
+/// Split "text -> target" at the last arrow.
+bool SplitArrow(const std::string& s, std::string& before, std::string& after) {
+    size_t arrow = s.rfind("->");
+    if (arrow == std::string::npos) return false;
+    before = Trim(s.substr(0, arrow));
+    after  = Trim(s.substr(arrow + 2));
+    return true;
+}
+
+} // anonymous namespace
+
+bool DialogueCompiler::CompileSource(const std::string& source, const std::string& name,
+                                     std::vector<u8>& out, std::string& error) {
+    BankBuilder bank;
+    bank.name = name;
+    std::istringstream in(source);
+    std::string raw;
+    i32 lineNo = 0;
+    BankBuilder::NodeSrc* node = nullptr;
+    auto fail = [&](const std::string& message) {
+        bank.Fail(lineNo, message);
+        error = bank.error;
+        return false;
+    };
+    auto failed = [&]() { error = bank.error; return false; };
+
+    while (std::getline(in, raw)) {
+        ++lineNo;
+        std::string line = Trim(raw);
+        if (!line.empty() && line.back() == '\r') line = Trim(line.substr(0, line.size() - 1));
+        if (line.empty() || line[0] == '#') continue;
+
+        if (line.compare(0, 2, "::") == 0) {
+            if (!bank.AddNode(Trim(line.substr(2)), lineNo)) return failed();
+            node = &bank.nodes.back();
+            continue;
+        }
+        if (!node) return fail("text before the first node (start one with ':: name')");
+
+        if (line[0] == '~') {
+            node->actions.emplace_back(line.substr(1), lineNo);
+            // Check now, so errors point at this line.
+            std::vector<u8> scratch;
+            if (!ExprCompiler(bank, scratch, node->actions.back().first, lineNo).Actions()) return failed();
+        } else if (line[0] == '*') {
+            BankBuilder::ChoiceSrc choice;
+            choice.line = lineNo;
+            std::string rest = Trim(line.substr(1));
+            std::string condition;
+            if (!rest.empty() && rest[0] == '[') {
+                size_t close = rest.find(']');
+                if (close == std::string::npos) return fail("missing ']' after the choice condition");
+                condition = rest.substr(1, close - 1);
+                rest = Trim(rest.substr(close + 1));
+            }
+            if (!SplitArrow(rest, choice.text, choice.target)) return fail("choice needs '-> target' (or '-> END')");
+            if (choice.text.empty()) return fail("choice has no text");
+            if (!Trim(condition).empty() && !bank.Compile({ { condition, lineNo } }, true, choice.condition))
+                return failed();
+            node->choices.push_back(std::move(choice));
+        } else if (line.compare(0, 2, "->") == 0) {
+            BankBuilder::LinkSrc link;
+            link.line = lineNo;
+            std::string rest = Trim(line.substr(2));
+            size_t when = rest.find(" if ");
+            std::string condition;
+            if (when != std::string::npos) {
+                condition = rest.substr(when + 4);
+                rest = Trim(rest.substr(0, when));
+            }
+            if (rest.find(' ') != std::string::npos) return fail("expected '-> node [if condition]'");
+            link.target = rest;
+            if (!condition.empty() && !bank.Compile({ { condition, lineNo } }, true, link.condition))
+                return failed();
+            node->links.push_back(std::move(link));
+        } else if (node->text.empty() && node->speaker.empty()) {
+            size_t colon = line.find(':');
+            if (colon == std::string::npos) {
+                node->text = line;
+            } else {
+                node->speaker = Trim(line.substr(0, colon));
+                node->text = Trim(line.substr(colon + 1));
+            }
+        } else {
+            node->text += node->text.empty() ? line : "\n" + line;
+        }
+    }
+
+    if (!bank.Build(0, out)) return failed();
+    return true;
+}
+
+bool DialogueCompiler::CompileTree(const DialogueTree& tree, std::vector<u8>& out, std::string& error) {
+    BankBuilder bank;
+    bank.name = tree.name;
+    // Flags are names, not expressions: emit their code directly.
+    auto flagCode = [&](const std::string& flag, bool set, u32& at) {
+        u16 var;
+        if (!bank.Var(flag, var, 0)) return false;
+        auto cached = bank.codeCache.find((set ? "=" : "?") + flag);
+        if (cached != bank.codeCache.end()) { at = cached->second; return true; }
+        at = static_cast<u32>(bank.code.size());
+        if (set) { bank.code.push_back(OpSmall); bank.code.push_back(1); }
+        bank.code.push_back(set ? OpStore : OpLoad);
+        Append<u16>(bank.code, var);
+        bank.code.push_back(OpEnd);
+        bank.codeCache.emplace((set ? "=" : "?") + flag, at);
+        return true;
+    };
+
+    bool callbacks = false;
+    for (const std::string& id : tree.GetAllNodeIDs()) {
+        const DialogueNode* src = tree.GetNode(id);
+        if (!bank.AddNode(id, 0, false)) { error = bank.error; return false; }
+        BankBuilder::NodeSrc& node = bank.nodes.back();
+        node.speaker = src->speaker;
+        node.text = src->text;
+        if (!src->setFlag.empty() && !flagCode(src->setFlag, true, node.actionCode)) { error = bank.error; return false; }
+        for (const DialogueChoice& c : src->choices) {
+            BankBuilder::ChoiceSrc choice;
+            choice.text = c.text;
+            choice.target = c.targetNodeID;
+            if (!c.requiredFlag.empty() && !flagCode(c.requiredFlag, false, choice.condition)) { error = bank.error; return false; }
+            node.choices.push_back(std::move(choice));
+        }
+        if (!src->nextNodeID.empty()) {
+            BankBuilder::LinkSrc link;
+            link.target = src->nextNodeID;
+            node.links.push_back(std::move(link));
+        }
+        callbacks = callbacks || src->onEnter || src->onExit;
+    }
+    if (bank.nodes.empty()) { error = tree.name + ": no nodes"; return false; }
+    if (callbacks) GV_LOG_WARN("DialogueCompiler — '" + tree.name + "': onEnter/onExit callbacks are not cooked.");
+
+    auto start = bank.nodeIndex.find(tree.GetStartNodeID());
+    if (!bank.Build(start == bank.nodeIndex.end() ? 0 : start->second, out)) { error = bank.error; return false; }
+    return true;
+}
+
+bool DialogueCompiler::CompileFile(const std::string& srcPath, const std::string& dstPath, std::string& error) {
+    std::ifstream f(srcPath, std::ios::binary);
+    if (!f.is_open()) { error = "cannot open '" + srcPath + "'"; return false; }
+    std::stringstream ss;
+    ss << f.rdbuf();
+
+    std::vector<u8> bytes;
+    if (!CompileSource(ss.str(), fs::path(srcPath).filename().string(), bytes, error)) return false;
+
+    std::string tmp = dstPath + ".tmp";
+    {
+        std::ofstream o(tmp, std::ios::binary | std::ios::trunc);
+        if (!o.is_open()) { error = "cannot write '" + dstPath + "'"; return false; }
+        o.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!o) { error = "cannot write '" + dstPath + "'"; return false; }
+    }
+    std::remove(dstPath.c_str());
+    if (std::rename(tmp.c_str(), dstPath.c_str()) != 0) { error = "cannot write '" + dstPath + "'"; return false; }
+    return true;
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// DialogueLibrary
+// ════════════════════════════════════════════════════════════════════════════
+
+void DialogueLibrary::Register(const std::string& name, const std::string& path) {
+    Entry& entry = m_Entries[name];
+    if (entry.path != path) entry.bank.reset();
+    entry.path = path;
+}
+
+u32 DialogueLibrary::RegisterDirectory(const std::string& directory) {
+    std::error_code ec;
+    u32 count = 0;
+    for (fs::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+        if (!it->is_regular_file(ec) || it->path().extension() != ".gvdb") continue;
+        Register(it->path().stem().string(), it->path().string());
+        ++count;
+    }
+    return count;
+}
+
+Shared<DialogueBank> DialogueLibrary::Get(const std::string& name) {
+    auto it = m_Entries.find(name);
+    if (it == m_Entries.end()) return nullptr;
+    Entry& entry = it->second;
+    if (entry.bank) return entry.bank;
+
+    auto bank = MakeShared<DialogueBank>();
+    if (!bank->Open(entry.path)) {
+        GV_LOG_ERROR("DialogueLibrary — cannot open bank '" + name + "' (" + entry.path + ")");
+        return nullptr;
+    }
+    entry.bank = bank;
+    Translate(entry);
+    return bank;
+}
+
+bool DialogueLibrary::IsLoaded(const std::string& name) const {
+    auto it = m_Entries.find(name);
+    return it != m_Entries.end() && it->second.bank != nullptr;
+}
+
+void DialogueLibrary::Unload(const std::string& name) {
+    auto it = m_Entries.find(name);
+    if (it != m_Entries.end()) it->second.bank.reset();
+}
+
+u32 DialogueLibrary::UnloadUnused() {
+    u32 closed = 0;
+    for (auto& kv : m_Entries) {
+        if (kv.second.bank && kv.second.bank.use_count() == 1) {
+            kv.second.bank.reset();
+            ++closed;
+        }
+    }
+    return closed;
+}
+
+u32 DialogueLibrary::GetLoadedCount() const {
+    u32 count = 0;
+    for (const auto& kv : m_Entries) count += kv.second.bank ? 1u : 0u;
+    return count;
+}
+
+void DialogueLibrary::SetLanguage(const std::string& language) {
+    m_Language = language;
+    for (auto& kv : m_Entries)
+        if (kv.second.bank) Translate(kv.second);
+}
+
+void DialogueLibrary::Translate(Entry& entry) const {
+    entry.bank->ClearTranslation();
+    if (m_Language.empty()) return;
+    fs::path path(entry.path);
+    path.replace_extension("." + m_Language + ".tsv");
+    std::error_code ec;
+    if (fs::exists(path, ec)) entry.bank->LoadTranslation(path.string());
+}
+
+} // namespace gv
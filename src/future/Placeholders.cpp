@@ -30,38 +30,9 @@ namespace gv {
 
 // Animator — removed; see animation/Animation.cpp for full implementation
 
-// ── Shader Library ─────────────────────────────────────────────────────────
-bool ShaderLibrary::Load(const std::string& name, const std::string& vertPath,
-                         const std::string& fragPath) {
-    (void)name; (void)vertPath; (void)fragPath;
-    GV_LOG_INFO("ShaderLibrary — loaded '" + name + "' (placeholder).");
-    return true;
-}
-
-void ShaderLibrary::ReloadAll() {
-    GV_LOG_INFO("ShaderLibrary — reload all (placeholder).");
-}
-
-// ── Post-Processing ────────────────────────────────────────────────────────
-void PostProcessing::Init(u32 width, u32 height) {
-    (void)width; (void)height;
-    GV_LOG_INFO("PostProcessing pipeline initialised (placeholder).");
-}
+// ShaderLibrary — removed; see renderer/ShaderLibrary.cpp for full implementation
 
-void PostProcessing::Resize(u32 width, u32 height) { (void)width; (void)height; }
-
-void PostProcessing::AddEffect(const std::string& effectName) {
-    m_Effects.push_back(effectName);
-    GV_LOG_INFO("PostProcessing — added effect: " + effectName);
-}
-
-void PostProcessing::RemoveEffect(const std::string& effectName) {
-    m_Effects.erase(std::remove(m_Effects.begin(), m_Effects.end(), effectName), m_Effects.end());
-}
-
-void PostProcessing::Apply() {
-    // Bind FBO, run each effect pass, blit to screen.
-}
+// PostProcessing — removed; see renderer/PostProcessing.cpp for full implementation
 
 // ============================================================================
 // Audio Engine — miniaudio-backed implementation
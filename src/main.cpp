@@ -4,9 +4,14 @@
 // Boots the engine with a default configuration and enters the main loop.
 // Pass --no-editor to skip the CLI editor and run a real-time window loop.
 // Pass --api-key <KEY> to configure the Gemini AI module.
+// Pass --batch to run scenes headless (see BatchRunner.h).
+// Pass --script-debug [addr] to attach to a running engine's script debugger
+// (started with --script-debug-listen <addr>; see ScriptDebugger.h).
 // ============================================================================
 
 #include "core/Engine.h"
+#include "editor/BatchRunner.h"
+#include "scripting/ScriptDebugger.h"
 #include <string>
 #include <stdexcept>
 
@@ -16,6 +21,14 @@ int main(int argc, char* argv[]) {
     config.windowWidth  = 1280;
     config.windowHeight = 720;
 
+    // ── Headless batch mode (no window, no GL) ─────────────────────────────
+    for (int i = 1; i < argc; ++i)
+        if (std::string(argv[i]) == "--batch") return gv::BatchRunner::Main(argc, argv);
+
+    // ── Script debugger client (attaches to another engine process) ────────
+    for (int i = 1; i < argc; ++i)
+        if (std::string(argv[i]) == "--script-debug") return gv::ScriptDebugClient::Main(argc, argv);
+
     // ── Parse command-line flags ────────────────────────────────────────────
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
@@ -25,6 +38,8 @@ int main(int argc, char* argv[]) {
             config.enableEditorGUI = true;
         } else if (arg == "--api-key" && i + 1 < argc) {
             config.geminiAPIKey = argv[++i];
+        } else if (arg == "--script-debug-listen" && i + 1 < argc) {
+            config.scriptDebugAddress = argv[++i];
         } else if (arg == "--width" && i + 1 < argc) {
             try {
                 int w = std::stoi(argv[++i]);
@@ -49,6 +64,11 @@ int main(int argc, char* argv[]) {
                       << "  --api-key <KEY>      Set Google Gemini API key\n"
                       << "  --width <W>          Window width  (default 1280)\n"
                       << "  --height <H>         Window height (default 720)\n"
+                      << "  --batch ...          Run scenes headless (--batch --help)\n"
+                      << "  --script-debug-listen <addr>\n"
+                      << "                       Serve the script debugger on 127.0.0.1:<port>\n"
+                      << "                       or unix:<path>\n"
+                      << "  --script-debug [addr]  Attach the script debugger (default 4711)\n"
                       << "  --help, -h           Show this message\n";
             return 0;
         }
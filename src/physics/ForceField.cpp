@@ -0,0 +1,331 @@
+// ============================================================================
+// GameVoid Engine -- Force Field Implementation
+// ============================================================================
+#include "physics/ForceField.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace gv {
+
+namespace {
+
+// ── Cheap 3D value noise in [-1, 1] (hash of lattice corners) ─────────────
+inline f32 LatticeHash(i32 x, i32 y, i32 z) {
+    u32 h = static_cast<u32>(x) * 73856093u ^ static_cast<u32>(y) * 19349663u ^
+            static_cast<u32>(z) * 83492791u;
+    h = (h ^ (h >> 13)) * 1274126177u;
+    h ^= h >> 16;
+    return static_cast<f32>(h & 0xFFFFu) * (2.0f / 65535.0f) - 1.0f;
+}
+
+inline f32 ValueNoise3(f32 x, f32 y, f32 z) {
+    f32 fx = std::floor(x), fy = std::floor(y), fz = std::floor(z);
+    i32 ix = static_cast<i32>(fx), iy = static_cast<i32>(fy), iz = static_cast<i32>(fz);
+    f32 tx = x - fx, ty = y - fy, tz = z - fz;
+    tx = tx * tx * (3.0f - 2.0f * tx);
+    ty = ty * ty * (3.0f - 2.0f * ty);
+    tz = tz * tz * (3.0f - 2.0f * tz);
+    f32 c00 = Lerpf(LatticeHash(ix, iy,     iz),     LatticeHash(ix + 1, iy,     iz),     tx);
+    f32 c10 = Lerpf(LatticeHash(ix, iy + 1, iz),     LatticeHash(ix + 1, iy + 1, iz),     tx);
+    f32 c01 = Lerpf(LatticeHash(ix, iy,     iz + 1), LatticeHash(ix + 1, iy,     iz + 1), tx);
+    f32 c11 = Lerpf(LatticeHash(ix, iy + 1, iz + 1), LatticeHash(ix + 1, iy + 1, iz + 1), tx);
+    return Lerpf(Lerpf(c00, c10, ty), Lerpf(c01, c11, ty), tz);
+}
+
+inline f32 Clamp01(f32 v) { return v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v); }
+
+} // namespace
+
+// ── ForceField ─────────────────────────────────────────────────────────────
+
+void ForceField::GetBounds(Vec3& outMin, Vec3& outMax) const {
+    switch (shape) {
+        case ForceFieldShape::Sphere:
+            outMin = center - Vec3(radius, radius, radius);
+            outMax = center + Vec3(radius, radius, radius);
+            return;
+        case ForceFieldShape::Box:
+            outMin = center - halfExtents;
+            outMax = center + halfExtents;
+            return;
+        case ForceFieldShape::Infinite:
+        default:
+            outMin = Vec3(-1e30f, -1e30f, -1e30f);
+            outMax = Vec3( 1e30f,  1e30f,  1e30f);
+            return;
+    }
+}
+
+void ForceFieldLanes::Resize(size_t n) {
+    for (auto* v : { &px, &py, &pz, &vx, &vy, &vz, &mass, &halfHeight, &volume })
+        v->resize(n);
+    fx.assign(n, 0.0f);
+    fy.assign(n, 0.0f);
+    fz.assign(n, 0.0f);
+}
+
+// ── Batched evaluation ─────────────────────────────────────────────────────
+// Every loop below is straight-line per lane: volume membership becomes a
+// 0/1 weight instead of a branch so the compiler can vectorise the range.
+
+void EvaluateForceField(const ForceField& field, ForceFieldLanes& L,
+                        size_t begin, size_t end, f32 time, f32 gravityMagnitude) {
+    if (!field.enabled || begin >= end) return;
+
+    const f32* px = L.px.data(); const f32* py = L.py.data(); const f32* pz = L.pz.data();
+    const f32* vx = L.vx.data(); const f32* vy = L.vy.data(); const f32* vz = L.vz.data();
+    const f32* mass = L.mass.data();
+    f32* fx = L.fx.data(); f32* fy = L.fy.data(); f32* fz = L.fz.data();
+
+    const f32 cx = field.center.x, cy = field.center.y, cz = field.center.z;
+    const f32 r2 = field.radius * field.radius;
+    const f32 invR = field.radius > 1e-6f ? 1.0f / field.radius : 0.0f;
+    const f32 hx = field.halfExtents.x, hy = field.halfExtents.y, hz = field.halfExtents.z;
+    const ForceFieldShape shape = field.shape;
+    const bool falloff = field.linearFalloff && shape == ForceFieldShape::Sphere;
+
+    // Weight scratch: volume membership × falloff × optional mass scaling.
+    thread_local std::vector<f32> s_Weight;
+    if (s_Weight.size() < end) s_Weight.resize(end);
+    f32* w = s_Weight.data();
+
+    for (size_t i = begin; i < end; ++i) {
+        f32 dx = px[i] - cx, dy = py[i] - cy, dz = pz[i] - cz;
+        f32 inside = 1.0f;
+        if (shape == ForceFieldShape::Sphere) {
+            f32 d2 = dx * dx + dy * dy + dz * dz;
+            inside = d2 <= r2 ? 1.0f : 0.0f;
+            if (falloff) inside *= Clamp01(1.0f - std::sqrt(d2) * invR);
+        } else if (shape == ForceFieldShape::Box) {
+            inside = (std::fabs(dx) <= hx && std::fabs(dy) <= hy && std::fabs(dz) <= hz) ? 1.0f : 0.0f;
+        }
+        w[i] = inside * (field.massIndependent ? mass[i] : 1.0f);
+    }
+
+    const f32 s = field.strength;
+    switch (field.type) {
+        case ForceFieldType::Directional: {
+            Vec3 d = field.direction.Normalized() * s;
+            for (size_t i = begin; i < end; ++i) {
+                fx[i] += d.x * w[i]; fy[i] += d.y * w[i]; fz[i] += d.z * w[i];
+            }
+            break;
+        }
+        case ForceFieldType::Radial: {
+            // Positive strength pushes away from the centre, negative attracts.
+            for (size_t i = begin; i < end; ++i) {
+                f32 dx = px[i] - cx, dy = py[i] - cy, dz = pz[i] - cz;
+                f32 inv = 1.0f / std::sqrt(dx * dx + dy * dy + dz * dz + 1e-6f);
+                f32 k = s * w[i] * inv;
+                fx[i] += dx * k; fy[i] += dy * k; fz[i] += dz * k;
+            }
+            break;
+        }
+        case ForceFieldType::Vortex: {
+            Vec3 a = field.direction.Normalized();
+            const f32 inward = field.inwardStrength;
+            for (size_t i = begin; i < end; ++i) {
+                f32 dx = px[i] - cx, dy = py[i] - cy, dz = pz[i] - cz;
+                f32 along = dx * a.x + dy * a.y + dz * a.z;
+                f32 rx = dx - a.x * along, ry = dy - a.y * along, rz = dz - a.z * along;
+                f32 inv = 1.0f / std::sqrt(rx * rx + ry * ry + rz * rz + 1e-6f);
+                // Tangent = axis × radial
+                f32 tx = a.y * rz - a.z * ry;
+                f32 ty = a.z * rx - a.x * rz;
+                f32 tz = a.x * ry - a.y * rx;
+                f32 kt = s * w[i] * inv, kr = -inward * w[i] * inv;
+                fx[i] += tx * kt + rx * kr;
+                fy[i] += ty * kt + ry * kr;
+                fz[i] += tz * kt + rz * kr;
+            }
+            break;
+        }
+        case ForceFieldType::Drag: {
+            const f32 lin = field.linearDrag, quad = field.quadraticDrag;
+            for (size_t i = begin; i < end; ++i) {
+                f32 speed = std::sqrt(vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i]);
+                f32 k = -(lin + quad * speed) * w[i];
+                fx[i] += vx[i] * k; fy[i] += vy[i] * k; fz[i] += vz[i] * k;
+            }
+            break;
+        }
+        case ForceFieldType::Buoyancy: {
+            // Archimedes on the submerged fraction of each body's vertical
+            // extent, plus fluid drag on that fraction.
+            const f32* hh = L.halfHeight.data();
+            const f32* vol = L.volume.data();
+            const f32 lift = field.fluidDensity * gravityMagnitude;
+            const f32 surface = field.surfaceHeight, lin = field.linearDrag;
+            for (size_t i = begin; i < end; ++i) {
+                f32 h = hh[i] > 1e-4f ? hh[i] : 1e-4f;
+                f32 sub = Clamp01((surface - (py[i] - h)) / (2.0f * h));
+                f32 k = sub * w[i];
+                fy[i] += lift * vol[i] * k;
+                fx[i] -= vx[i] * lin * k; fy[i] -= vy[i] * lin * k; fz[i] -= vz[i] * lin * k;
+            }
+            break;
+        }
+        case ForceFieldType::WindNoise: {
+            Vec3 d = field.direction.Normalized() * s;
+            const f32 amp = s * field.turbulence, freq = field.noiseFrequency;
+            const f32 t = time * field.noiseSpeed;
+            for (size_t i = begin; i < end; ++i) {
+                f32 nx = px[i] * freq + t, ny = py[i] * freq, nz = pz[i] * freq;
+                f32 gx = ValueNoise3(nx, ny, nz);
+                f32 gy = ValueNoise3(nx + 31.7f, ny + 11.3f, nz);
+                f32 gz = ValueNoise3(nx, ny + 57.1f, nz + 23.9f);
+                fx[i] += (d.x + gx * amp) * w[i];
+                fy[i] += (d.y + gy * amp) * w[i];
+                fz[i] += (d.z + gz * amp) * w[i];
+            }
+            break;
+        }
+    }
+}
+
+// ============================================================================
+// ForceFieldLibrary
+// ============================================================================
+
+namespace {
+
+const char* TypeName(ForceFieldType t) {
+    switch (t) {
+        case ForceFieldType::Directional: return "directional";
+        case ForceFieldType::Radial:      return "radial";
+        case ForceFieldType::Vortex:      return "vortex";
+        case ForceFieldType::Drag:        return "drag";
+        case ForceFieldType::Buoyancy:    return "buoyancy";
+        case ForceFieldType::WindNoise:   return "wind";
+    }
+    return "directional";
+}
+
+const char* ShapeName(ForceFieldShape s) {
+    switch (s) {
+        case ForceFieldShape::Infinite: return "infinite";
+        case ForceFieldShape::Sphere:   return "sphere";
+        case ForceFieldShape::Box:      return "box";
+    }
+    return "sphere";
+}
+
+Vec3 ParseVec3(const std::string& v) {
+    std::istringstream ss(v);
+    Vec3 r;
+    ss >> r.x >> r.y >> r.z;
+    return r;
+}
+
+bool ParseBool(const std::string& v) { return v == "1" || v == "true" || v == "yes"; }
+
+void ApplyKey(ForceField& f, const std::string& key, const std::string& val) {
+    try {
+        if      (key == "name")            f.name = val;
+        else if (key == "enabled")         f.enabled = ParseBool(val);
+        else if (key == "type") {
+            for (ForceFieldType t : { ForceFieldType::Directional, ForceFieldType::Radial,
+                                      ForceFieldType::Vortex, ForceFieldType::Drag,
+                                      ForceFieldType::Buoyancy, ForceFieldType::WindNoise })
+                if (val == TypeName(t)) f.type = t;
+        }
+        else if (key == "shape") {
+            for (ForceFieldShape s : { ForceFieldShape::Infinite, ForceFieldShape::Sphere, ForceFieldShape::Box })
+                if (val == ShapeName(s)) f.shape = s;
+        }
+        else if (key == "center")          f.center = ParseVec3(val);
+        else if (key == "radius")          f.radius = std::stof(val);
+        else if (key == "halfExtents")     f.halfExtents = ParseVec3(val);
+        else if (key == "linearFalloff")   f.linearFalloff = ParseBool(val);
+        else if (key == "strength")        f.strength = std::stof(val);
+        else if (key == "massIndependent") f.massIndependent = ParseBool(val);
+        else if (key == "direction")       f.direction = ParseVec3(val);
+        else if (key == "inwardStrength")  f.inwardStrength = std::stof(val);
+        else if (key == "linearDrag")      f.linearDrag = std::stof(val);
+        else if (key == "quadraticDrag")   f.quadraticDrag = std::stof(val);
+        else if (key == "fluidDensity")    f.fluidDensity = std::stof(val);
+        else if (key == "surfaceHeight")   f.surfaceHeight = std::stof(val);
+        else if (key == "turbulence")      f.turbulence = std::stof(val);
+        else if (key == "noiseFrequency")  f.noiseFrequency = std::stof(val);
+        else if (key == "noiseSpeed")      f.noiseSpeed = std::stof(val);
+        else GV_LOG_WARN("ForceFieldLibrary — unknown key '" + key + "'");
+    } catch (...) {
+        GV_LOG_WARN("ForceFieldLibrary — bad value for '" + key + "': " + val);
+    }
+}
+
+} // namespace
+
+std::vector<ForceField> ForceFieldLibrary::ParseString(const std::string& text) {
+    std::vector<ForceField> fields;
+    std::istringstream in(text);
+    std::string line;
+    while (std::getline(in, line)) {
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' ')) line.pop_back();
+        size_t first = line.find_first_not_of(" \t");
+        if (first == std::string::npos) continue;
+        line = line.substr(first);
+        if (line[0] == '#' || line[0] == ';') continue;
+        if (line[0] == '[') {
+            if (line == "[field]") fields.emplace_back();
+            continue;
+        }
+        auto eq = line.find('=');
+        if (eq == std::string::npos || fields.empty()) continue;
+        std::string key = line.substr(0, eq);
+        std::string val = line.substr(eq + 1);
+        while (!key.empty() && key.back() == ' ') key.pop_back();
+        while (!val.empty() && val.front() == ' ') val.erase(val.begin());
+        ApplyKey(fields.back(), key, val);
+    }
+    return fields;
+}
+
+std::vector<ForceField> ForceFieldLibrary::LoadFromFile(const std::string& path) {
+    std::ifstream ifs(path);
+    if (!ifs.is_open()) {
+        GV_LOG_WARN("ForceFieldLibrary — cannot open '" + path + "'");
+        return {};
+    }
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    auto fields = ParseString(ss.str());
+    GV_LOG_INFO("ForceFieldLibrary — loaded " + std::to_string(fields.size()) +
+                " field(s) from " + path);
+    return fields;
+}
+
+bool ForceFieldLibrary::SaveToFile(const std::string& path, const std::vector<ForceField>& fields) {
+    std::ofstream ofs(path);
+    if (!ofs.is_open()) return false;
+    auto vec = [](const Vec3& v) {
+        return std::to_string(v.x) + " " + std::to_string(v.y) + " " + std::to_string(v.z);
+    };
+    for (const auto& f : fields) {
+        ofs << "[field]\n";
+        ofs << "name=" << f.name << "\n";
+        ofs << "type=" << TypeName(f.type) << "\n";
+        ofs << "shape=" << ShapeName(f.shape) << "\n";
+        ofs << "enabled=" << (f.enabled ? 1 : 0) << "\n";
+        ofs << "center=" << vec(f.center) << "\n";
+        ofs << "radius=" << f.radius << "\n";
+        ofs << "halfExtents=" << vec(f.halfExtents) << "\n";
+        ofs << "linearFalloff=" << (f.linearFalloff ? 1 : 0) << "\n";
+        ofs << "strength=" << f.strength << "\n";
+        ofs << "massIndependent=" << (f.massIndependent ? 1 : 0) << "\n";
+        ofs << "direction=" << vec(f.direction) << "\n";
+        ofs << "inwardStrength=" << f.inwardStrength << "\n";
+        ofs << "linearDrag=" << f.linearDrag << "\n";
+        ofs << "quadraticDrag=" << f.quadraticDrag << "\n";
+        ofs << "fluidDensity=" << f.fluidDensity << "\n";
+        ofs << "surfaceHeight=" << f.surfaceHeight << "\n";
+        ofs << "turbulence=" << f.turbulence << "\n";
+        ofs << "noiseFrequency=" << f.noiseFrequency << "\n";
+        ofs << "noiseSpeed=" << f.noiseSpeed << "\n\n";
+    }
+    return ofs.good();
+}
+
+} // namespace gv
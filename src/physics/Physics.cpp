@@ -3,6 +3,7 @@
 // ============================================================================
 #include "physics/Physics.h"
 #include "core/GameObject.h"
+#include "core/PlaySnapshot.h"
 #include "core/Transform.h"
 #include <algorithm>
 #include <cmath>
@@ -19,6 +20,7 @@ void PhysicsWorld::Init() {
 void PhysicsWorld::Shutdown() {
     m_Bodies.clear();
     m_Collisions.clear();
+    m_ForceFields.clear();
     GV_LOG_INFO("PhysicsWorld shut down.");
 }
 
@@ -27,10 +29,13 @@ void PhysicsWorld::Step(f32 dt) {
     m_Accumulator += dt;
     i32 steps = 0;
     while (m_Accumulator >= fixedTimeStep && steps < maxSubSteps) {
+        ResolveBodyColliders();
+        ApplyForceFields();
         IntegrateBodies(fixedTimeStep);
         DetectCollisions();
         ResolveCollisions();
         m_Accumulator -= fixedTimeStep;
+        m_SimTime += fixedTimeStep;
         ++steps;
     }
 }
@@ -44,14 +49,15 @@ void PhysicsWorld::UnregisterBody(RigidBody* body) {
 }
 
 bool PhysicsWorld::Raycast(const Vec3& origin, const Vec3& direction,
-                           f32 maxDistance, CollisionInfo& outHit) const {
+                           f32 maxDistance, CollisionInfo& outHit,
+                           const RigidBody* ignore) const {
     // Real ray-AABB intersection against all registered bodies
     Vec3 dir = direction.Normalized();
     f32 closestT = maxDistance + 1.0f;
     bool hit = false;
 
     for (auto* rb : m_Bodies) {
-        if (!rb->GetOwner()) continue;
+        if (!rb->GetOwner() || rb == ignore) continue;
         Collider* col = rb->GetOwner()->GetComponent<Collider>();
         if (!col || col->type != ColliderType::Box) continue;
 
@@ -88,15 +94,170 @@ bool PhysicsWorld::Raycast(const Vec3& origin, const Vec3& direction,
     return hit;
 }
 
+// ── Force fields ───────────────────────────────────────────────────────────
+
+u32 PhysicsWorld::AddForceField(const ForceField& field) {
+    m_ForceFields.push_back(field);
+    return static_cast<u32>(m_ForceFields.size() - 1);
+}
+
+bool PhysicsWorld::RemoveForceField(const std::string& name) {
+    size_t before = m_ForceFields.size();
+    m_ForceFields.erase(std::remove_if(m_ForceFields.begin(), m_ForceFields.end(),
+                        [&](const ForceField& f) { return f.name == name; }),
+                        m_ForceFields.end());
+    return m_ForceFields.size() != before;
+}
+
+bool PhysicsWorld::LoadForceFields(const std::string& path) {
+    auto fields = ForceFieldLibrary::LoadFromFile(path);
+    if (fields.empty()) return false;
+    m_ForceFields.insert(m_ForceFields.end(), fields.begin(), fields.end());
+    return true;
+}
+
+// Gathers dynamic bodies into SoA lanes bucketed by a uniform grid (counting
+// sort, so each cell is one contiguous lane range), evaluates every field over
+// the cells its bounds overlap, then writes the summed forces back to
+// RigidBody::force for IntegrateBodies to consume with the real step size.
+void PhysicsWorld::ApplyForceFields() {
+    bool anyEnabled = false, needExtents = false;
+    for (const auto& f : m_ForceFields) {
+        if (!f.enabled) continue;
+        anyEnabled = true;
+        if (f.type == ForceFieldType::Buoyancy) needExtents = true;
+    }
+    if (!anyEnabled) return;
+
+    // ── Gather ─────────────────────────────────────────────────────────────
+    m_FieldBodies.clear();
+    Vec3 lo( 1e30f,  1e30f,  1e30f);
+    Vec3 hi(-1e30f, -1e30f, -1e30f);
+    for (size_t i = 0; i < m_Bodies.size(); ++i) {
+        RigidBody* rb = m_Bodies[i];
+        if (rb->bodyType != RigidBodyType::Dynamic || !rb->GetOwner()) continue;
+        m_FieldBodies.push_back({ rb, m_BodyColliders[i] });
+        const Vec3& p = rb->GetOwner()->GetTransform().position;
+        lo = Vec3(std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z));
+        hi = Vec3(std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z));
+    }
+    const size_t n = m_FieldBodies.size();
+    if (n == 0) return;
+
+    // ── Grid (cell count capped so sparse worlds don't explode) ────────────
+    const u32 kMaxCells = 32768;
+    f32 cell = std::max(forceFieldCellSize, 0.01f);
+    u32 dims[3];
+    for (;;) {
+        dims[0] = static_cast<u32>((hi.x - lo.x) / cell) + 1;
+        dims[1] = static_cast<u32>((hi.y - lo.y) / cell) + 1;
+        dims[2] = static_cast<u32>((hi.z - lo.z) / cell) + 1;
+        if (static_cast<u64>(dims[0]) * dims[1] * dims[2] <= kMaxCells) break;
+        cell *= 2.0f;
+    }
+    const f32 invCell = 1.0f / cell;
+    auto cellCoord = [&](f32 v, f32 origin, u32 dim) {
+        i32 c = static_cast<i32>((v - origin) * invCell);
+        return static_cast<u32>(std::clamp(c, 0, static_cast<i32>(dim) - 1));
+    };
+    const u32 numCells = dims[0] * dims[1] * dims[2];
+
+    // ── Counting sort into lanes ───────────────────────────────────────────
+    m_FieldCellOf.resize(n);
+    m_FieldCellStart.assign(numCells + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        const Vec3& p = m_FieldBodies[i].body->GetOwner()->GetTransform().position;
+        u32 c = cellCoord(p.x, lo.x, dims[0]) +
+                dims[0] * (cellCoord(p.y, lo.y, dims[1]) + dims[1] * cellCoord(p.z, lo.z, dims[2]));
+        m_FieldCellOf[i] = c;
+        ++m_FieldCellStart[c + 1];
+    }
+    for (u32 c = 0; c < numCells; ++c) m_FieldCellStart[c + 1] += m_FieldCellStart[c];
+
+    m_FieldLanes.Resize(n);
+    m_FieldSorted.resize(n);
+    m_FieldCursor.assign(m_FieldCellStart.begin(), m_FieldCellStart.end() - 1);
+    for (size_t i = 0; i < n; ++i)
+        m_FieldSorted[m_FieldCursor[m_FieldCellOf[i]]++] = m_FieldBodies[i];
+    m_FieldBodies.swap(m_FieldSorted);
+
+    auto& L = m_FieldLanes;
+    for (size_t i = 0; i < n; ++i) {
+        RigidBody* rb = m_FieldBodies[i].body;
+        const Transform& t = rb->GetOwner()->GetTransform();
+        L.px[i] = t.position.x; L.py[i] = t.position.y; L.pz[i] = t.position.z;
+        L.vx[i] = rb->velocity.x; L.vy[i] = rb->velocity.y; L.vz[i] = rb->velocity.z;
+        L.mass[i] = rb->mass;
+        L.halfHeight[i] = 0.5f;
+        L.volume[i] = 1.0f;
+        if (needExtents) {
+            if (Collider* col = m_FieldBodies[i].collider) {
+                if (col->type == ColliderType::Sphere) {
+                    f32 r = col->radius * t.scale.y;
+                    L.halfHeight[i] = r;
+                    L.volume[i] = 4.18879f * r * r * r;
+                } else {
+                    Vec3 h(col->boxHalfExtents.x * t.scale.x,
+                           col->boxHalfExtents.y * t.scale.y,
+                           col->boxHalfExtents.z * t.scale.z);
+                    L.halfHeight[i] = h.y;
+                    L.volume[i] = 8.0f * h.x * h.y * h.z;
+                }
+            }
+        }
+    }
+
+    // ── Evaluate ───────────────────────────────────────────────────────────
+    const f32 g = gravity.Length();
+    for (const auto& field : m_ForceFields) {
+        if (!field.enabled) continue;
+        if (field.shape == ForceFieldShape::Infinite) {
+            EvaluateForceField(field, L, 0, n, m_SimTime, g);
+            continue;
+        }
+        Vec3 fmin, fmax;
+        field.GetBounds(fmin, fmax);
+        if (fmax.x < lo.x || fmax.y < lo.y || fmax.z < lo.z ||
+            fmin.x > hi.x || fmin.y > hi.y || fmin.z > hi.z) continue;
+        u32 x0 = cellCoord(fmin.x, lo.x, dims[0]), x1 = cellCoord(fmax.x, lo.x, dims[0]);
+        u32 y0 = cellCoord(fmin.y, lo.y, dims[1]), y1 = cellCoord(fmax.y, lo.y, dims[1]);
+        u32 z0 = cellCoord(fmin.z, lo.z, dims[2]), z1 = cellCoord(fmax.z, lo.z, dims[2]);
+        // Cells along X are adjacent in lane order, so each row is one range.
+        for (u32 z = z0; z <= z1; ++z) {
+            for (u32 y = y0; y <= y1; ++y) {
+                u32 row = dims[0] * (y + dims[1] * z);
+                size_t b = m_FieldCellStart[row + x0];
+                size_t e = m_FieldCellStart[row + x1 + 1];
+                EvaluateForceField(field, L, b, e, m_SimTime, g);
+            }
+        }
+    }
+
+    // ── Scatter ────────────────────────────────────────────────────────────
+    for (size_t i = 0; i < n; ++i)
+        m_FieldBodies[i].body->AddForce(Vec3(L.fx[i], L.fy[i], L.fz[i]));
+}
+
 // ── Private helpers ────────────────────────────────────────────────────────
 
+// Colliders are looked up once per sub-step, together with the bodies, and
+// shared by the force-field gather, integration and collision detection.
+void PhysicsWorld::ResolveBodyColliders() {
+    m_BodyColliders.resize(m_Bodies.size());
+    for (size_t i = 0; i < m_Bodies.size(); ++i)
+        m_BodyColliders[i] = m_Bodies[i]->GetOwner()
+                           ? m_Bodies[i]->GetOwner()->GetComponent<Collider>() : nullptr;
+}
+
 void PhysicsWorld::IntegrateBodies(f32 dt) {
-    for (auto* rb : m_Bodies) {
+    for (size_t i = 0; i < m_Bodies.size(); ++i) {
+        RigidBody* rb = m_Bodies[i];
         if (rb->bodyType != RigidBodyType::Dynamic) continue;
         if (!rb->GetOwner()) continue;
+        if (m_PlaySnapshot) m_PlaySnapshot->Touch(rb->GetOwner());
 
         Transform& t = rb->GetOwner()->GetTransform();
-        Collider* col = rb->GetOwner()->GetComponent<Collider>();
+        Collider* col = m_BodyColliders[i];
 
         // Apply gravity
         if (rb->useGravity) {
@@ -184,19 +345,18 @@ void PhysicsWorld::DetectCollisions() {
     m_Collisions.clear();
 
     for (size_t i = 0; i < m_Bodies.size(); ++i) {
+        if (!m_BodyColliders[i]) continue;
         for (size_t j = i + 1; j < m_Bodies.size(); ++j) {
             RigidBody* a = m_Bodies[i];
             RigidBody* b = m_Bodies[j];
-            if (!a->GetOwner() || !b->GetOwner()) continue;
+            Collider* colA = m_BodyColliders[i];
+            Collider* colB = m_BodyColliders[j];
+            if (!colB) continue;
 
             // Skip static-static pairs
             if (a->bodyType == RigidBodyType::Static &&
                 b->bodyType == RigidBodyType::Static) continue;
 
-            Collider* colA = a->GetOwner()->GetComponent<Collider>();
-            Collider* colB = b->GetOwner()->GetComponent<Collider>();
-            if (!colA || !colB) continue;
-
             Vec3 posA = a->GetOwner()->GetTransform().position;
             Vec3 posB = b->GetOwner()->GetTransform().position;
             Vec3 sclA = a->GetOwner()->GetTransform().scale;
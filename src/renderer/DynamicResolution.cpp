@@ -0,0 +1,123 @@
+// ============================================================================
+// GameVoid Engine — Dynamic Resolution Governor Implementation
+// ============================================================================
+#include "renderer/DynamicResolution.h"
+#include <cmath>
+
+namespace gv {
+
+namespace {
+
+// Largest relative change of the desired scale in a single frame, so one
+// bad sample can't swing the controller across its whole range.
+constexpr f32 kMaxFrameChange = 0.1f;
+
+} // anonymous namespace
+
+void DynamicResolution::Configure(const DynamicResolutionSettings& settings) {
+    m_Settings = settings;
+    DynamicResolutionSettings& s = m_Settings;
+    if (!(s.maxScale > 0.0f)) s.maxScale = 1.0f;
+    if (!(s.minScale > 0.0f)) s.minScale = s.maxScale;
+    if (s.minScale > s.maxScale) s.minScale = s.maxScale;
+    if (!(s.targetMs > 0.0f)) s.targetMs = 16.6f;
+    if (!(s.smoothing > 0.0f)) s.smoothing = 1.0f;
+    if (s.smoothing > 1.0f) s.smoothing = 1.0f;
+    if (s.step < 0.0f) s.step = 0.0f;
+    if (s.panicRatio < 1.0f) s.panicRatio = 1.0f;
+
+    m_Scale   = Quantise(Clamp(m_Scale));
+    m_Desired = Clamp(m_Desired);
+}
+
+void DynamicResolution::Reset() {
+    m_Scale = m_Desired = m_Settings.maxScale;
+    m_Filtered = 0.0f;
+    m_Error1 = m_Error2 = 0.0f;
+    m_HaveSample = false;
+    m_SinceChange = 0;
+    m_Changes = 0;
+}
+
+f32 DynamicResolution::Clamp(f32 scale) const {
+    if (scale < m_Settings.minScale) return m_Settings.minScale;
+    if (scale > m_Settings.maxScale) return m_Settings.maxScale;
+    return scale;
+}
+
+// Steps are counted down from maxScale, and the result is the largest
+// step at or below `scale` so the applied size never costs more than the
+// controller asked for.  Going up therefore needs the desired scale to
+// clear a whole step, which keeps the target from flickering between two
+// sizes when the ideal scale sits on a boundary.
+f32 DynamicResolution::Quantise(f32 scale) const {
+    const f32 step = m_Settings.step;
+    if (step <= 0.0f) return Clamp(scale);
+    f32 steps = std::ceil((m_Settings.maxScale - scale) / step - 1e-4f);
+    return Clamp(m_Settings.maxScale - steps * step);
+}
+
+u32 DynamicResolution::ScaledSize(u32 size, f32 scale) {
+    f32 scaled = static_cast<f32>(size) * scale + 0.5f;
+    return scaled < 1.0f ? 1u : static_cast<u32>(scaled);
+}
+
+bool DynamicResolution::Update(f32 cpuMs, f32 gpuMs) {
+    const f32 ms = gpuMs > 0.0f ? gpuMs : cpuMs;
+    if (!(ms > 0.0f) || !std::isfinite(ms)) return false;
+
+    const DynamicResolutionSettings& s = m_Settings;
+    if (m_SinceChange < 0xFFFFFFFFu) ++m_SinceChange;
+
+    // Far over budget: drop straight to the size the cost model says fits,
+    // without waiting for the filter or the cooldown.
+    if (ms > s.targetMs * s.panicRatio && m_Scale > s.minScale) {
+        f32 fit = Clamp(m_Scale * std::sqrt(s.targetMs / ms));
+        f32 q = s.step > 0.0f
+            ? Clamp(s.maxScale - std::ceil((s.maxScale - fit) / s.step - 1e-4f) * s.step)
+            : fit;
+        if (q < m_Scale) {
+            f32 ratio = q / m_Scale;
+            m_Filtered = ms * ratio * ratio;
+            m_HaveSample = true;
+            m_Desired = fit;
+            m_Error1 = m_Error2 = 0.0f;
+            m_Scale = q;
+            m_SinceChange = 0;
+            ++m_Changes;
+            return true;
+        }
+    }
+
+    m_Filtered = m_HaveSample ? m_Filtered + s.smoothing * (ms - m_Filtered) : ms;
+    m_HaveSample = true;
+
+    // Relative error at the desired scale: the cost there is predicted as
+    // filtered * (desired / applied)^2.
+    // Only headroom is dead-banded; running over budget always counts.
+    f32 error = (m_Scale / m_Desired) * std::sqrt(s.targetMs / m_Filtered) - 1.0f;
+    if (error > 0.0f && error < s.deadband) error = 0.0f;
+
+    f32 delta = s.kp * (error - m_Error1)
+              + s.ki * error
+              + s.kd * (error - 2.0f * m_Error1 + m_Error2);
+    if (delta >  kMaxFrameChange) delta =  kMaxFrameChange;
+    if (delta < -kMaxFrameChange) delta = -kMaxFrameChange;
+    m_Error2 = m_Error1;
+    m_Error1 = error;
+    m_Desired = Clamp(m_Desired * (1.0f + delta));
+
+    f32 q = Quantise(m_Desired);
+    if (q == m_Scale || m_SinceChange < s.cooldownFrames) return false;
+
+    // Re-base the filter on the expected cost at the new size so samples
+    // from before the change don't read as a sudden error.
+    f32 ratio = q / m_Scale;
+    m_Filtered *= ratio * ratio;
+    m_Scale = q;
+    m_SinceChange = 0;
+    ++m_Changes;
+    return true;
+}
+
+} // namespace gv
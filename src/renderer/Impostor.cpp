@@ -0,0 +1,366 @@
+// ============================================================================
+// GameVoid Engine — Billboard Impostor Implementation
+// ============================================================================
+#include "renderer/Impostor.h"
+#include "assets/Assets.h"
+
+#ifdef GV_HAS_GLFW
+#include "core/GLDefs.h"
+#endif
+
+#include <algorithm>
+#include <cmath>
+
+namespace gv {
+
+namespace {
+
+inline f32 SignNotZero(f32 v) { return v >= 0.0f ? 1.0f : -1.0f; }
+
+inline u8 ToUnorm8(f32 v) {
+    v = std::min(std::max(v, 0.0f), 1.0f);
+    return static_cast<u8>(v * 255.0f + 0.5f);
+}
+
+Vec4 SampleAlbedo(const ImpostorSource& src, const Vec2& uv) {
+    if (!src.albedoPixels || src.albedoWidth == 0 || src.albedoHeight == 0)
+        return src.color;
+    // Nearest, wrapped; rows bottom-up like the GL textures they come from.
+    f32 u = uv.x - std::floor(uv.x);
+    f32 v = uv.y - std::floor(uv.y);
+    u32 x = std::min(static_cast<u32>(u * static_cast<f32>(src.albedoWidth)), src.albedoWidth - 1);
+    u32 y = std::min(static_cast<u32>(v * static_cast<f32>(src.albedoHeight)), src.albedoHeight - 1);
+    const u8* p = src.albedoPixels + (static_cast<size_t>(y) * src.albedoWidth + x) * 4;
+    const f32 k = 1.0f / 255.0f;
+    return { src.color.x * p[0] * k, src.color.y * p[1] * k, src.color.z * p[2] * k, src.color.w * p[3] * k };
+}
+
+} // namespace
+
+// ── View-direction mapping ─────────────────────────────────────────────────
+
+Vec2 OctahedralEncode(const Vec3& dir) {
+    f32 l1 = std::fabs(dir.x) + std::fabs(dir.y) + std::fabs(dir.z);
+    if (l1 <= 0.0f) return { 0.5f, 0.5f };
+    f32 px = dir.x / l1, pz = dir.z / l1;
+    if (dir.y < 0.0f) {
+        f32 fx = (1.0f - std::fabs(pz)) * SignNotZero(px);
+        f32 fz = (1.0f - std::fabs(px)) * SignNotZero(pz);
+        px = fx; pz = fz;
+    }
+    return { px * 0.5f + 0.5f, pz * 0.5f + 0.5f };
+}
+
+Vec3 OctahedralDecode(const Vec2& uv) {
+    f32 px = uv.x * 2.0f - 1.0f, pz = uv.y * 2.0f - 1.0f;
+    f32 y = 1.0f - std::fabs(px) - std::fabs(pz);
+    if (y < 0.0f) {
+        f32 fx = (1.0f - std::fabs(pz)) * SignNotZero(px);
+        f32 fz = (1.0f - std::fabs(px)) * SignNotZero(pz);
+        px = fx; pz = fz;
+    }
+    return Vec3(px, y, pz).Normalized();
+}
+
+Vec2 HemiOctahedralEncode(const Vec3& dir) {
+    f32 y = std::max(dir.y, 0.0f);
+    f32 l1 = std::fabs(dir.x) + y + std::fabs(dir.z);
+    if (l1 <= 0.0f) return { 0.5f, 0.5f };
+    f32 px = dir.x / l1, pz = dir.z / l1;
+    // Rotate the |x| + |z| <= 1 diamond by 45 degrees onto the square.  On
+    // the horizon the sum can round a hair past the edge.
+    auto unit = [](f32 v) { return std::min(std::max(v, 0.0f), 1.0f); };
+    return { unit((px + pz) * 0.5f + 0.5f), unit((pz - px) * 0.5f + 0.5f) };
+}
+
+Vec3 HemiOctahedralDecode(const Vec2& uv) {
+    f32 a = uv.x * 2.0f - 1.0f, b = uv.y * 2.0f - 1.0f;
+    f32 px = (a - b) * 0.5f, pz = (a + b) * 0.5f;
+    f32 y = std::max(1.0f - std::fabs(px) - std::fabs(pz), 0.0f);
+    return Vec3(px, y, pz).Normalized();
+}
+
+void ImpostorBasis(const Vec3& dir, Vec3& right, Vec3& up) {
+    Vec3 ref = std::fabs(dir.y) > 0.999f ? Vec3(0, 0, -SignNotZero(dir.y)) : Vec3(0, 1, 0);
+    right = ref.Cross(dir).Normalized();
+    up    = dir.Cross(right);
+}
+
+// ── Frames ─────────────────────────────────────────────────────────────────
+
+Vec3 ImpostorFrameDirection(const ImpostorSettings& settings, u32 x, u32 y) {
+    u32 n = std::max(settings.framesPerSide, 1u);
+    f32 step = n > 1 ? 1.0f / static_cast<f32>(n - 1) : 0.0f;
+    Vec2 uv = n > 1 ? Vec2(static_cast<f32>(x) * step, static_cast<f32>(y) * step) : Vec2(0.5f, 0.5f);
+    return settings.hemisphere ? HemiOctahedralDecode(uv) : OctahedralDecode(uv);
+}
+
+ImpostorFrameBlend ImpostorFramesForDirection(const ImpostorSettings& settings, const Vec3& dir) {
+    ImpostorFrameBlend blend;
+    u32 n = std::max(settings.framesPerSide, 1u);
+    if (n == 1) return blend;
+
+    Vec2 uv = settings.hemisphere ? HemiOctahedralEncode(dir) : OctahedralEncode(dir);
+    f32 last = static_cast<f32>(n - 1);
+    f32 gx = std::min(std::max(uv.x * last, 0.0f), last);
+    f32 gy = std::min(std::max(uv.y * last, 0.0f), last);
+    u32 ix = std::min(static_cast<u32>(gx), n - 2);
+    u32 iy = std::min(static_cast<u32>(gy), n - 2);
+    f32 fx = gx - static_cast<f32>(ix), fy = gy - static_cast<f32>(iy);
+
+    blend.x[0] = ix;     blend.y[0] = iy;     blend.weight[0] = (1.0f - fx) * (1.0f - fy);
+    blend.x[1] = ix + 1; blend.y[1] = iy;     blend.weight[1] = fx * (1.0f - fy);
+    blend.x[2] = ix;     blend.y[2] = iy + 1; blend.weight[2] = (1.0f - fx) * fy;
+    blend.x[3] = ix + 1; blend.y[3] = iy + 1; blend.weight[3] = fx * fy;
+    return blend;
+}
+
+// ── Atlas ──────────────────────────────────────────────────────────────────
+
+void ImpostorAtlas::Upload() {
+#ifdef GV_HAS_GLFW
+    if (Empty()) return;
+    auto upload = [this](u32& tex, GLenum format, GLint internalFormat, const std::vector<u8>& data) {
+        if (!tex) glGenTextures(1, &tex);
+        glBindTexture(GL_TEXTURE_2D, tex);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, static_cast<GLsizei>(width),
+                     static_cast<GLsizei>(height), 0, format, GL_UNSIGNED_BYTE, data.data());
+        // No mips: they would blend neighbouring cells.
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    };
+    upload(albedoTexture, GL_RGBA, GL_RGBA8, albedo);
+    upload(normalTexture, GL_RGBA, GL_RGBA8, normal);
+    upload(depthTexture, GL_RED, GL_RED, depth);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+#endif
+}
+
+void ImpostorAtlas::Release() {
+#ifdef GV_HAS_GLFW
+    u32 textures[3] = { albedoTexture, normalTexture, depthTexture };
+    for (u32 t : textures)
+        if (t) glDeleteTextures(1, &t);
+#endif
+    albedoTexture = normalTexture = depthTexture = 0;
+}
+
+bool PrepareImpostorAtlas(const ImpostorSource& source, const ImpostorSettings& settings, ImpostorAtlas& out) {
+    if (!source.mesh || source.mesh->GetVertices().empty() || source.mesh->GetIndices().size() < 3)
+        return false;
+    if (settings.framesPerSide == 0 || settings.frameSize == 0)
+        return false;
+
+    Vec3 bmin, bmax;
+    source.mesh->GetBounds(bmin, bmax);
+    Vec3 center = (bmin + bmax) * 0.5f;
+    f32 r2 = 0.0f;
+    for (const auto& v : source.mesh->GetVertices()) {
+        Vec3 d = v.position - center;
+        r2 = std::max(r2, d.Dot(d));
+    }
+
+    out.Release();
+    out.settings = settings;
+    out.center   = center;
+    out.radius   = std::max(std::sqrt(r2), 1e-4f);
+    out.width    = settings.framesPerSide * settings.frameSize;
+    out.height   = out.width;
+    size_t texels = static_cast<size_t>(out.width) * out.height;
+    out.albedo.assign(texels * 4, 0);
+    out.normal.assign(texels * 4, 0);
+    out.depth.assign(texels, 255);
+    return true;
+}
+
+void ResolveImpostorSamples(ImpostorAtlas& atlas, const u8* albedo, const u8* normal, const u8* depth, u32 supersample) {
+    const u32 ss = std::max(supersample, 1u);
+    const size_t rowStride = static_cast<size_t>(atlas.width) * ss;
+    const f32 invSamples = 1.0f / static_cast<f32>(ss * ss);
+
+    for (u32 y = 0; y < atlas.height; ++y) {
+        for (u32 x = 0; x < atlas.width; ++x) {
+            u32 covered = 0, sum[7] = { 0, 0, 0, 0, 0, 0, 0 };
+            u32 nearest = 255;
+            for (u32 sy = 0; sy < ss; ++sy) {
+                size_t row = (static_cast<size_t>(y) * ss + sy) * rowStride + static_cast<size_t>(x) * ss;
+                for (u32 sx = 0; sx < ss; ++sx) {
+                    size_t s = (row + sx) * 4;
+                    if (normal[s + 3] == 0) continue;
+                    ++covered;
+                    for (u32 c = 0; c < 4; ++c) sum[c] += albedo[s + c];
+                    for (u32 c = 0; c < 3; ++c) sum[4 + c] += normal[s + c];
+                    nearest = std::min<u32>(nearest, depth[s]);
+                }
+            }
+            if (covered == 0) continue;
+
+            // Colour and normal average over the covered samples only; the
+            // coverage fraction goes to alpha.
+            size_t t = static_cast<size_t>(y) * atlas.width + x;
+            f32 coverage = static_cast<f32>(covered) * invSamples;
+            f32 inv = 1.0f / static_cast<f32>(covered);
+            Vec3 n(static_cast<f32>(sum[4]) * inv / 127.5f - 1.0f,
+                   static_cast<f32>(sum[5]) * inv / 127.5f - 1.0f,
+                   static_cast<f32>(sum[6]) * inv / 127.5f - 1.0f);
+            n = n.Normalized();
+            for (u32 c = 0; c < 3; ++c)
+                atlas.albedo[t * 4 + c] = static_cast<u8>((sum[c] + covered / 2) / covered);
+            atlas.albedo[t * 4 + 3] = ToUnorm8(static_cast<f32>(sum[3]) * inv / 255.0f * coverage);
+            atlas.normal[t * 4 + 0] = ToUnorm8(n.x * 0.5f + 0.5f);
+            atlas.normal[t * 4 + 1] = ToUnorm8(n.y * 0.5f + 0.5f);
+            atlas.normal[t * 4 + 2] = ToUnorm8(n.z * 0.5f + 0.5f);
+            atlas.normal[t * 4 + 3] = ToUnorm8(coverage);
+            atlas.depth[t] = static_cast<u8>(nearest);
+        }
+    }
+}
+
+bool BakeImpostorSoftware(const ImpostorSource& source, const ImpostorSettings& settings, ImpostorAtlas& out) {
+    if (!PrepareImpostorAtlas(source, settings, out))
+        return false;
+
+    const auto& verts = source.mesh->GetVertices();
+    const auto& idx   = source.mesh->GetIndices();
+    const u32 ss = std::max(settings.supersample, 1u);
+    const u32 S = settings.frameSize * ss;            // samples per cell side
+    const size_t rowStride = static_cast<size_t>(out.width) * ss;
+    const f32 invR = 1.0f / out.radius;
+
+    size_t samples = rowStride * rowStride;
+    std::vector<u8> albedo(samples * 4, 0), normal(samples * 4, 0), depth(samples * 4, 255);
+    std::vector<f32> zbuf(static_cast<size_t>(S) * S);
+    std::vector<f32> sx(verts.size()), sy(verts.size()), sz(verts.size());
+
+    for (u32 cy = 0; cy < settings.framesPerSide; ++cy) {
+        for (u32 cx = 0; cx < settings.framesPerSide; ++cx) {
+            Vec3 dir = ImpostorFrameDirection(settings, cx, cy);
+            Vec3 right, up;
+            ImpostorBasis(dir, right, up);
+
+            // Orthographic projection of the bounding sphere onto the cell.
+            const f32 half = static_cast<f32>(S) * 0.5f;
+            for (size_t i = 0; i < verts.size(); ++i) {
+                Vec3 q = verts[i].position - out.center;
+                sx[i] = (q.Dot(right) * invR + 1.0f) * half;
+                sy[i] = (q.Dot(up) * invR + 1.0f) * half;
+                sz[i] = 0.5f - 0.5f * q.Dot(dir) * invR;
+            }
+            std::fill(zbuf.begin(), zbuf.end(), 2.0f);
+            const size_t cellOrigin = static_cast<size_t>(cy) * S * rowStride + static_cast<size_t>(cx) * S;
+
+            for (size_t t = 0; t + 2 < idx.size(); t += 3) {
+                u32 i0 = idx[t], i1 = idx[t + 1], i2 = idx[t + 2];
+                if (i0 >= verts.size() || i1 >= verts.size() || i2 >= verts.size()) continue;
+                f32 area = (sx[i1] - sx[i0]) * (sy[i2] - sy[i0]) - (sx[i2] - sx[i0]) * (sy[i1] - sy[i0]);
+                if (std::fabs(area) < 1e-12f) continue;
+                // Both windings: impostors are seen from every side, and
+                // foliage cards are single-sided geometry.
+                if (area < 0.0f) { std::swap(i1, i2); area = -area; }
+                const f32 invArea = 1.0f / area;
+
+                f32 fx0 = std::min({ sx[i0], sx[i1], sx[i2] }), fx1 = std::max({ sx[i0], sx[i1], sx[i2] });
+                f32 fy0 = std::min({ sy[i0], sy[i1], sy[i2] }), fy1 = std::max({ sy[i0], sy[i1], sy[i2] });
+                i32 x0 = std::max(static_cast<i32>(std::floor(fx0 - 0.5f)), 0);
+                i32 x1 = std::min(static_cast<i32>(std::ceil(fx1 - 0.5f)), static_cast<i32>(S) - 1);
+                i32 y0 = std::max(static_cast<i32>(std::floor(fy0 - 0.5f)), 0);
+                i32 y1 = std::min(static_cast<i32>(std::ceil(fy1 - 0.5f)), static_cast<i32>(S) - 1);
+
+                for (i32 y = y0; y <= y1; ++y) {
+                    f32 py = static_cast<f32>(y) + 0.5f;
+                    for (i32 x = x0; x <= x1; ++x) {
+                        f32 px = static_cast<f32>(x) + 0.5f;
+                        f32 w0 = (sx[i2] - sx[i1]) * (py - sy[i1]) - (sy[i2] - sy[i1]) * (px - sx[i1]);
+                        f32 w1 = (sx[i0] - sx[i2]) * (py - sy[i2]) - (sy[i0] - sy[i2]) * (px - sx[i2]);
+                        f32 w2 = (sx[i1] - sx[i0]) * (py - sy[i0]) - (sy[i1] - sy[i0]) * (px - sx[i0]);
+                        if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) continue;
+                        w0 *= invArea; w1 *= invArea; w2 *= invArea;
+
+                        f32 z = sz[i0] * w0 + sz[i1] * w1 + sz[i2] * w2;
+                        f32& zs = zbuf[static_cast<size_t>(y) * S + static_cast<size_t>(x)];
+                        if (z >= zs) continue;
+                        zs = z;
+
+                        Vec3 n = (verts[i0].normal * w0 + verts[i1].normal * w1 + verts[i2].normal * w2).Normalized();
+                        if (n.Dot(dir) < 0.0f) n = -n;
+                        Vec4 a = SampleAlbedo(source, verts[i0].texCoord * w0 + verts[i1].texCoord * w1 +
+                                                      verts[i2].texCoord * w2);
+                        size_t s = (cellOrigin + static_cast<size_t>(y) * rowStride + static_cast<size_t>(x)) * 4;
+                        albedo[s + 0] = ToUnorm8(a.x);
+                        albedo[s + 1] = ToUnorm8(a.y);
+                        albedo[s + 2] = ToUnorm8(a.z);
+                        albedo[s + 3] = ToUnorm8(a.w);
+                        normal[s + 0] = ToUnorm8(n.x * 0.5f + 0.5f);
+                        normal[s + 1] = ToUnorm8(n.y * 0.5f + 0.5f);
+                        normal[s + 2] = ToUnorm8(n.z * 0.5f + 0.5f);
+                        normal[s + 3] = 255;
+                        depth[s] = ToUnorm8(z);
+                    }
+                }
+            }
+        }
+    }
+
+    ResolveImpostorSamples(out, albedo.data(), normal.data(), depth.data(), ss);
+    DilateImpostorAtlas(out);
+    return true;
+}
+
+void DilateImpostorAtlas(ImpostorAtlas& atlas) {
+    const u32 frame = atlas.settings.frameSize;
+    if (atlas.Empty() || frame == 0 || atlas.settings.dilation == 0) return;
+
+    const size_t texels = static_cast<size_t>(atlas.width) * atlas.height;
+    std::vector<u8> filled(texels);
+    for (size_t i = 0; i < texels; ++i)
+        filled[i] = atlas.normal[i * 4 + 3] != 0;
+
+    std::vector<u8> next;
+    static const i32 kOffsets[4][2] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+    for (u32 pass = 0; pass < atlas.settings.dilation; ++pass) {
+        next = filled;
+        bool changed = false;
+        for (u32 y = 0; y < atlas.height; ++y) {
+            u32 cellY0 = (y / frame) * frame;
+            for (u32 x = 0; x < atlas.width; ++x) {
+                size_t t = static_cast<size_t>(y) * atlas.width + x;
+                if (filled[t]) continue;
+                u32 cellX0 = (x / frame) * frame;
+
+                u32 sum[7] = { 0, 0, 0, 0, 0, 0, 0 };
+                u32 n = 0;
+                for (const auto& o : kOffsets) {
+                    i32 nx = static_cast<i32>(x) + o[0], ny = static_cast<i32>(y) + o[1];
+                    // Stay inside the cell: neighbouring cells are other views.
+                    if (nx < static_cast<i32>(cellX0) || nx >= static_cast<i32>(cellX0 + frame) ||
+                        ny < static_cast<i32>(cellY0) || ny >= static_cast<i32>(cellY0 + frame))
+                        continue;
+                    size_t s = static_cast<size_t>(ny) * atlas.width + static_cast<size_t>(nx);
+                    if (!filled[s]) continue;
+                    for (u32 c = 0; c < 3; ++c) {
+                        sum[c]     += atlas.albedo[s * 4 + c];
+                        sum[3 + c] += atlas.normal[s * 4 + c];
+                    }
+                    sum[6] += atlas.depth[s];
+                    ++n;
+                }
+                if (n == 0) continue;
+                for (u32 c = 0; c < 3; ++c) {
+                    atlas.albedo[t * 4 + c] = static_cast<u8>((sum[c] + n / 2) / n);
+                    atlas.normal[t * 4 + c] = static_cast<u8>((sum[3 + c] + n / 2) / n);
+                }
+                atlas.depth[t] = static_cast<u8>((sum[6] + n / 2) / n);
+                next[t] = 1;
+                changed = true;
+            }
+        }
+        filled.swap(next);
+        if (!changed) break;
+    }
+}
+
+} // namespace gv
@@ -0,0 +1,19 @@
+// ============================================================================
+// GameVoid Engine — Mesh Renderer Component Implementation
+// ============================================================================
+#include "renderer/MeshRenderer.h"
+#include "assets/MeshRegistry.h"
+
+namespace gv {
+
+void MeshRenderer::SetPrimitive(PrimitiveType type, MeshRegistry& registry) {
+    primitiveType = type;
+    m_Mesh = registry.Primitive(type);
+}
+
+void MeshRenderer::SetMeshData(const MeshData& data, MeshRegistry& registry) {
+    primitiveType = PrimitiveType::None;
+    m_Mesh = registry.AcquireData(data);
+}
+
+} // namespace gv
@@ -0,0 +1,67 @@
+// ============================================================================
+// GameVoid Engine — Meshlet Culling Implementation
+// ============================================================================
+#include "renderer/MeshletCulling.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace gv {
+
+u32 CullMeshlets(const MeshletData& meshlets, const Mat4& model, const Frustum& frustum,
+                 const Vec3& cameraPos, MeshletDrawList& out,
+                 const MeshletCullSettings& settings, MeshletCullStats* stats) {
+    out.Clear();
+    MeshletCullStats local;
+    const f32* m = model.m;
+
+    // Column lengths give the scale; the sphere radius takes the largest.
+    f32 sx = std::sqrt(m[0] * m[0] + m[1] * m[1] + m[2] * m[2]);
+    f32 sy = std::sqrt(m[4] * m[4] + m[5] * m[5] + m[6] * m[6]);
+    f32 sz = std::sqrt(m[8] * m[8] + m[9] * m[9] + m[10] * m[10]);
+    f32 maxScale = std::max(sx, std::max(sy, sz));
+    f32 minScale = std::min(sx, std::min(sy, sz));
+    f32 det = m[0] * (m[5] * m[10] - m[9] * m[6]) - m[4] * (m[1] * m[10] - m[9] * m[2]) +
+              m[8] * (m[1] * m[6] - m[5] * m[2]);
+
+    // The cone test runs in mesh space: valid for rotation + uniform scale.
+    bool coneTest = settings.backface && det > 0.0f && maxScale > 0.0f &&
+                    (maxScale - minScale) <= 1e-3f * maxScale;
+    Vec3 viewPos(0, 0, 0);
+    if (coneTest) {
+        Mat4 inv = model.Inverse();
+        viewPos = Vec3(inv.m[0] * cameraPos.x + inv.m[4] * cameraPos.y + inv.m[8]  * cameraPos.z + inv.m[12],
+                       inv.m[1] * cameraPos.x + inv.m[5] * cameraPos.y + inv.m[9]  * cameraPos.z + inv.m[13],
+                       inv.m[2] * cameraPos.x + inv.m[6] * cameraPos.y + inv.m[10] * cameraPos.z + inv.m[14]);
+    }
+
+    for (const Meshlet& ml : meshlets.meshlets) {
+        local.tested++;
+        if (coneTest && MeshletBackfacing(ml, viewPos)) { local.backfaceCulled++; continue; }
+
+        const Vec3& c = ml.center;
+        Vec3 wc(m[0] * c.x + m[4] * c.y + m[8]  * c.z + m[12],
+                m[1] * c.x + m[5] * c.y + m[9]  * c.z + m[13],
+                m[2] * c.x + m[6] * c.y + m[10] * c.z + m[14]);
+        f32 wr = ml.radius * maxScale;
+        if (settings.frustum && !frustum.TestSphere(wc, wr)) { local.frustumCulled++; continue; }
+        if (settings.occlusion && settings.occlusion(wc, wr)) { local.occlusionCulled++; continue; }
+
+        local.visible++;
+        local.indicesDrawn += ml.indexCount;
+        // Meshlets are stored back to back, so neighbours merge into one range.
+        if (!out.counts.empty() && out.firstIndex.back() + static_cast<u32>(out.counts.back()) == ml.firstIndex) {
+            out.counts.back() += static_cast<i32>(ml.indexCount);
+        } else {
+            out.counts.push_back(static_cast<i32>(ml.indexCount));
+            out.firstIndex.push_back(ml.firstIndex);
+            out.offsets.push_back(reinterpret_cast<const void*>(
+                static_cast<uintptr_t>(ml.firstIndex) * sizeof(u32)));
+        }
+    }
+    local.ranges = static_cast<u32>(out.counts.size());
+    if (stats) stats->Add(local);
+    return local.visible;
+}
+
+} // namespace gv
@@ -0,0 +1,492 @@
+// ============================================================================
+// GameVoid Engine — Software Occlusion Culling Implementation
+// ============================================================================
+#include "renderer/OcclusionCulling.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GV_OCCLUSION_SSE 1
+#endif
+
+namespace gv {
+
+namespace {
+
+// Triangles may reach this many half-screens past the edges before they are
+// clipped; beyond it the edge functions would start losing precision.
+constexpr f32 kGuardBand = 4.0f;
+
+// Front faces thinner than this many pixels count as back faces.  A pixel
+// straddling the edge beside one is written by the wider face from its
+// centre, yet pokes out past the sliver; two walls either side of a slit
+// would close it that way.  As back faces they make that edge an outline.
+constexpr f32 kMinFacePixels = 1.5f;
+
+// Solid box: corner i has x from bit 0, y from bit 1, z from bit 2.
+// Counter-clockwise seen from outside.
+const u32 kBoxIndices[36] = {
+    0, 2, 1,  1, 2, 3,    4, 5, 6,  5, 7, 6,    0, 1, 4,  1, 5, 4,
+    2, 6, 3,  3, 6, 7,    0, 4, 2,  2, 4, 6,    1, 3, 5,  3, 7, 5,
+};
+
+inline Vec4 TransformPoint(const Mat4& m, f32 x, f32 y, f32 z) {
+    return Vec4(m.m[0] * x + m.m[4] * y + m.m[8]  * z + m.m[12],
+                m.m[1] * x + m.m[5] * y + m.m[9]  * z + m.m[13],
+                m.m[2] * x + m.m[6] * y + m.m[10] * z + m.m[14],
+                m.m[3] * x + m.m[7] * y + m.m[11] * z + m.m[15]);
+}
+
+/// Transform `count` positions to clip space.
+void TransformVertices(const Mat4& mvp, const u8* src, size_t stride, size_t count, Vec4* dst) {
+#ifdef GV_OCCLUSION_SSE
+    const __m128 c0 = _mm_loadu_ps(mvp.m + 0), c1 = _mm_loadu_ps(mvp.m + 4);
+    const __m128 c2 = _mm_loadu_ps(mvp.m + 8), c3 = _mm_loadu_ps(mvp.m + 12);
+    for (size_t v = 0; v < count; ++v) {
+        f32 p[3];
+        std::memcpy(p, src + v * stride, sizeof(p));
+        __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(p[0])), _mm_mul_ps(c1, _mm_set1_ps(p[1]))),
+                              _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(p[2])), c3));
+        _mm_storeu_ps(&dst[v].x, r);
+    }
+#else
+    for (size_t v = 0; v < count; ++v) {
+        f32 p[3];
+        std::memcpy(p, src + v * stride, sizeof(p));
+        dst[v] = TransformPoint(mvp, p[0], p[1], p[2]);
+    }
+#endif
+}
+
+/// Signed distance of a clip-space point to clip plane `i` (>= 0 is kept):
+/// near, then the four guard-band sides.
+inline f32 ClipDistance(const Vec4& v, int i) {
+    switch (i) {
+        case 0:  return v.z + v.w;
+        case 1:  return kGuardBand * v.w - v.x;
+        case 2:  return kGuardBand * v.w + v.x;
+        case 3:  return kGuardBand * v.w - v.y;
+        default: return kGuardBand * v.w + v.y;
+    }
+}
+
+/// Triangle across each edge (triangle t, edge k at t*3+k), -1 for open or
+/// non-manifold edges.
+void FindNeighbours(const u32* indices, size_t triCount, std::vector<std::pair<u64, u32>>& edges,
+                    std::vector<i32>& neighbour) {
+    neighbour.assign(triCount * 3, -1);
+    edges.clear();
+    for (size_t t = 0; t < triCount; ++t)
+        for (u32 k = 0; k < 3; ++k) {
+            u64 v0 = indices[t * 3 + k], v1 = indices[t * 3 + (k + 1) % 3];
+            edges.emplace_back(std::min(v0, v1) << 32 | std::max(v0, v1), static_cast<u32>(t * 3 + k));
+        }
+    std::sort(edges.begin(), edges.end());
+    for (size_t e = 0; e < edges.size();) {
+        size_t run = e + 1;
+        while (run < edges.size() && edges[run].first == edges[e].first) ++run;
+        if (run - e == 2) {
+            neighbour[edges[e].second]     = static_cast<i32>(edges[e + 1].second / 3);
+            neighbour[edges[e + 1].second] = static_cast<i32>(edges[e].second / 3);
+        }
+        e = run;
+    }
+}
+
+const std::vector<i32>& BoxNeighbours() {
+    static const std::vector<i32> table = [] {
+        std::vector<std::pair<u64, u32>> edges;
+        std::vector<i32> n;
+        FindNeighbours(kBoxIndices, 12, edges, n);
+        return n;
+    }();
+    return table;
+}
+
+inline Vec4 Lerp4(const Vec4& a, const Vec4& b, f32 t) {
+    return Vec4(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t);
+}
+
+} // namespace
+
+void OcclusionBuffer::Configure(const OcclusionSettings& settings) {
+    m_Settings = settings;
+    m_Width  = std::max<u32>(4, (settings.width + 3) & ~3u);
+    m_Height = std::max<u32>(1, settings.height);
+    m_HiZ.clear();
+    m_LevelW.clear();
+    m_LevelH.clear();
+    u32 w = m_Width, h = m_Height;
+    for (;;) {
+        m_HiZ.emplace_back(static_cast<size_t>(w) * h, 1.0f);
+        m_LevelW.push_back(w);
+        m_LevelH.push_back(h);
+        if (w == 1 && h == 1) break;
+        w = (w + 1) / 2;
+        h = (h + 1) / 2;
+    }
+}
+
+void OcclusionBuffer::BeginFrame(const Mat4& viewProj) {
+    m_ViewProj = viewProj;
+    m_Occluders.clear();
+    m_Stats = OcclusionStats();
+}
+
+bool OcclusionBuffer::AddOccluder(const f32* positions, size_t positionStride, size_t vertexCount,
+                                  const u32* indices, size_t indexCount, const Mat4& model) {
+    if (!positions || !indices || indexCount < 3) return false;
+    if (indexCount / 3 > m_Settings.maxOccluderTriangles) return false;
+    Occluder o;
+    o.positions = positions;
+    o.stride = positionStride;
+    o.vertexCount = vertexCount;
+    o.indices = indices;
+    o.indexCount = indexCount - indexCount % 3;
+    o.model = model;
+    m_Occluders.push_back(o);
+    return true;
+}
+
+void OcclusionBuffer::AddOccluderBox(const Vec3& boxMin, const Vec3& boxMax, const Mat4& model) {
+    Occluder o;
+    o.model = model;
+    o.boxMin = boxMin;
+    o.boxMax = boxMax;
+    o.box = true;
+    o.indices = kBoxIndices;
+    o.indexCount = 36;
+    o.vertexCount = 8;
+    m_Occluders.push_back(o);
+}
+
+// ── Setup ──────────────────────────────────────────────────────────────────
+
+void OcclusionBuffer::SetupOccluders(size_t first, size_t last, std::vector<ScreenTri>& out,
+                                     SetupScratch& scratch) const {
+    for (size_t i = first; i < last; ++i) {
+        const Occluder& o = m_Occluders[i];
+        Mat4 mvp = m_ViewProj * o.model;
+        std::vector<Vec4>& clip = scratch.clip;
+        clip.resize(o.vertexCount);
+        if (o.box) {
+            for (u32 c = 0; c < 8; ++c)
+                clip[c] = TransformPoint(mvp, (c & 1) ? o.boxMax.x : o.boxMin.x,
+                                              (c & 2) ? o.boxMax.y : o.boxMin.y,
+                                              (c & 4) ? o.boxMax.z : o.boxMin.z);
+        } else {
+            TransformVertices(mvp, reinterpret_cast<const u8*>(o.positions), o.stride, o.vertexCount, clip.data());
+        }
+
+        // Facing per triangle, from the homogeneous determinant (valid even
+        // behind the eye), and the triangle across each edge.
+        const size_t triCount = o.indexCount / 3;
+        scratch.front.assign(triCount, 0);
+        for (size_t t = 0; t < triCount; ++t) {
+            const u32* idx = o.indices + t * 3;
+            if (idx[0] >= o.vertexCount || idx[1] >= o.vertexCount || idx[2] >= o.vertexCount) continue;
+            const Vec4& a = clip[idx[0]];
+            const Vec4& b = clip[idx[1]];
+            const Vec4& c = clip[idx[2]];
+            f32 det = a.x * (b.y * c.w - c.y * b.w) - a.y * (b.x * c.w - c.x * b.w) + a.w * (b.x * c.y - c.x * b.y);
+            scratch.front[t] = det > 0.0f;
+            if (!scratch.front[t] || a.w <= 1e-6f || b.w <= 1e-6f || c.w <= 1e-6f) continue;
+
+            // Height over the longest edge, in pixels.
+            const f32 hw = 0.5f * static_cast<f32>(m_Width), hh = 0.5f * static_cast<f32>(m_Height);
+            const f32 ax = a.x / a.w * hw, ay = a.y / a.w * hh;
+            const f32 ux = b.x / b.w * hw - ax, uy = b.y / b.w * hh - ay;
+            const f32 vx = c.x / c.w * hw - ax, vy = c.y / c.w * hh - ay;
+            const f32 area2 = std::fabs(ux * vy - uy * vx);
+            const f32 longest = std::max(std::max(ux * ux + uy * uy, vx * vx + vy * vy),
+                                         (vx - ux) * (vx - ux) + (vy - uy) * (vy - uy));
+            if (area2 * area2 < kMinFacePixels * kMinFacePixels * longest) scratch.front[t] = 0;
+        }
+        if (!o.box) FindNeighbours(o.indices, triCount, scratch.edges, scratch.neighbour);
+        const std::vector<i32>& neighbour = o.box ? BoxNeighbours() : scratch.neighbour;
+
+        for (size_t t = 0; t < triCount; ++t) {
+            if (!scratch.front[t]) continue;
+            const u32* idx = o.indices + t * 3;
+            const Vec4& a = clip[idx[0]];
+            const Vec4& b = clip[idx[1]];
+            const Vec4& c = clip[idx[2]];
+
+            // Entirely outside one frustum side: nothing to draw.
+            if ((a.x >  a.w && b.x >  b.w && c.x >  c.w) || (a.x < -a.w && b.x < -b.w && c.x < -c.w) ||
+                (a.y >  a.w && b.y >  b.w && c.y >  c.w) || (a.y < -a.w && b.y < -b.w && c.y < -c.w) ||
+                (a.z < -a.w && b.z < -b.w && c.z < -c.w) || (a.z >  a.w && b.z >  b.w && c.z >  c.w))
+                continue;
+
+            // An edge is an outline edge unless a front face lies across it.
+            u8 silhouette = 0;
+            for (u32 k = 0; k < 3; ++k) {
+                i32 n = neighbour[t * 3 + k];
+                if (n < 0 || !scratch.front[static_cast<size_t>(n)]) silhouette |= static_cast<u8>(1u << k);
+            }
+
+            bool inside = true;
+            for (int p = 0; p < 5 && inside; ++p)
+                inside = ClipDistance(a, p) >= 0.0f && ClipDistance(b, p) >= 0.0f && ClipDistance(c, p) >= 0.0f;
+            if (inside) {
+                EmitTriangle(a, b, c, silhouette, out);
+                continue;
+            }
+
+            // Clip against the near plane and the guard band, then fan.  Each
+            // vertex carries the outline flag of the edge leaving it; edges
+            // made by a clip plane are not outlines.
+            Vec4 poly[2][9];
+            u8   flag[2][9];
+            int n = 3, cur = 0;
+            poly[0][0] = a; poly[0][1] = b; poly[0][2] = c;
+            for (int k = 0; k < 3; ++k) flag[0][k] = (silhouette >> k) & 1;
+            for (int p = 0; p < 5 && n >= 3; ++p) {
+                int m = 0;
+                for (int k = 0; k < n; ++k) {
+                    const Vec4& s = poly[cur][k];
+                    const Vec4& e = poly[cur][(k + 1) % n];
+                    f32 ds = ClipDistance(s, p), de = ClipDistance(e, p);
+                    if (ds >= 0.0f) { poly[cur ^ 1][m] = s; flag[cur ^ 1][m++] = flag[cur][k]; }
+                    if ((ds >= 0.0f) != (de >= 0.0f)) {
+                        poly[cur ^ 1][m] = Lerp4(s, e, ds / (ds - de));
+                        flag[cur ^ 1][m++] = ds >= 0.0f ? 0 : flag[cur][k];
+                    }
+                }
+                n = m;
+                cur ^= 1;
+            }
+            for (int k = 1; k + 1 < n; ++k) {
+                u8 f = static_cast<u8>(((k == 1 ? flag[cur][0] : 0) << 0) | (flag[cur][k] << 1) |
+                                       ((k + 2 == n ? flag[cur][n - 1] : 0) << 2));
+                EmitTriangle(poly[cur][0], poly[cur][k], poly[cur][k + 1], f, out);
+            }
+        }
+    }
+}
+
+void OcclusionBuffer::EmitTriangle(const Vec4& a, const Vec4& b, const Vec4& c, u8 silhouette,
+                                   std::vector<ScreenTri>& out) const {
+    const Vec4* v[3] = { &a, &b, &c };
+    f32 sx[3], sy[3], sz[3];
+    const f32 hw = 0.5f * static_cast<f32>(m_Width), hh = 0.5f * static_cast<f32>(m_Height);
+    for (int k = 0; k < 3; ++k) {
+        if (v[k]->w <= 1e-6f) return;
+        f32 iw = 1.0f / v[k]->w;
+        sx[k] = (v[k]->x * iw + 1.0f) * hw;
+        sy[k] = (v[k]->y * iw + 1.0f) * hh;
+        sz[k] = v[k]->z * iw * 0.5f + 0.5f;
+    }
+    // Counter-clockwise (y up) = positive area = front-facing.
+    f32 area = (sx[1] - sx[0]) * (sy[2] - sy[0]) - (sy[1] - sy[0]) * (sx[2] - sx[0]);
+    if (!(area > 0.0f)) return;
+
+    ScreenTri t;
+    // Pixel i is covered when its centre (i + 0.5) is inside.
+    f32 minX = std::min(sx[0], std::min(sx[1], sx[2])), maxX = std::max(sx[0], std::max(sx[1], sx[2]));
+    f32 minY = std::min(sy[0], std::min(sy[1], sy[2])), maxY = std::max(sy[0], std::max(sy[1], sy[2]));
+    t.minX = std::max(0, static_cast<i32>(std::ceil(minX - 0.5f)));
+    t.maxX = std::min(static_cast<i32>(m_Width) - 1, static_cast<i32>(std::floor(maxX - 0.5f)));
+    t.minY = std::max(0, static_cast<i32>(std::ceil(minY - 0.5f)));
+    t.maxY = std::min(static_cast<i32>(m_Height) - 1, static_cast<i32>(std::floor(maxY - 0.5f)));
+    if (t.minX > t.maxX || t.minY > t.maxY) return;
+
+    t.zMax = std::max(sz[0], std::max(sz[1], sz[2]));
+    if (std::min(sz[0], std::min(sz[1], sz[2])) >= 1.0f) return;
+    for (int k = 0; k < 3; ++k) { t.x[k] = sx[k]; t.y[k] = sy[k]; }
+    t.silhouette = silhouette;
+
+    // Depth plane z = zx*x + zy*y + zc, raised by its largest change within
+    // half a pixel so each pixel stores the farthest depth it could contain.
+    f32 inv = 1.0f / area;
+    t.zx = ((sz[1] - sz[0]) * (sy[2] - sy[0]) - (sz[2] - sz[0]) * (sy[1] - sy[0])) * inv;
+    t.zy = ((sz[2] - sz[0]) * (sx[1] - sx[0]) - (sz[1] - sz[0]) * (sx[2] - sx[0])) * inv;
+    t.zc = sz[0] - t.zx * sx[0] - t.zy * sy[0] + 0.5f * (std::fabs(t.zx) + std::fabs(t.zy));
+    out.push_back(t);
+}
+
+// ── Rasterization ──────────────────────────────────────────────────────────
+
+void OcclusionBuffer::RasterBand(i32 y0, i32 y1) {
+    f32* depth = m_HiZ[0].data();
+    const i32 W = static_cast<i32>(m_Width);
+    for (const auto& bin : m_Bins) {
+        for (const ScreenTri& t : bin) {
+            i32 ya = std::max(t.minY, y0), yb = std::min(t.maxY, y1 - 1);
+            if (ya > yb) continue;
+            // Edge k runs from vertex k to k+1; inside is E >= 0.  Outline
+            // edges are moved in by half a pixel's extent along their normal,
+            // so only pixels wholly inside pass.
+            f32 A[3], B[3], C[3];
+            for (int k = 0; k < 3; ++k) {
+                int n = (k + 1) % 3;
+                A[k] = -(t.y[n] - t.y[k]);
+                B[k] = t.x[n] - t.x[k];
+                C[k] = -(A[k] * t.x[k] + B[k] * t.y[k]);
+                if (t.silhouette & (1u << k)) C[k] -= 0.5f * (std::fabs(A[k]) + std::fabs(B[k]));
+            }
+            const i32 xa = t.minX & ~3;
+            for (i32 y = ya; y <= yb; ++y) {
+                const f32 py = static_cast<f32>(y) + 0.5f;
+                f32* row = depth + static_cast<size_t>(y) * W;
+#ifdef GV_OCCLUSION_SSE
+                const __m128 lane = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+                const __m128 zero = _mm_setzero_ps();
+                const __m128 zMax = _mm_set1_ps(t.zMax);
+                __m128 e[3], step[3];
+                __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<f32>(xa)), lane);
+                for (int k = 0; k < 3; ++k) {
+                    e[k] = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(A[k]), px), _mm_set1_ps(B[k] * py + C[k]));
+                    step[k] = _mm_set1_ps(A[k] * 4.0f);
+                }
+                __m128 z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t.zx), px), _mm_set1_ps(t.zy * py + t.zc));
+                const __m128 zStep = _mm_set1_ps(t.zx * 4.0f);
+                for (i32 x = xa; x <= t.maxX; x += 4) {
+                    __m128 in = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e[0], zero), _mm_cmpge_ps(e[1], zero)),
+                                           _mm_cmpge_ps(e[2], zero));
+                    if (_mm_movemask_ps(in)) {
+                        __m128 old = _mm_loadu_ps(row + x);
+                        __m128 nz = _mm_min_ps(old, _mm_min_ps(z, zMax));
+                        _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(in, nz), _mm_andnot_ps(in, old)));
+                    }
+                    for (int k = 0; k < 3; ++k) e[k] = _mm_add_ps(e[k], step[k]);
+                    z = _mm_add_ps(z, zStep);
+                }
+#else
+                for (i32 x = t.minX; x <= t.maxX; ++x) {
+                    const f32 px = static_cast<f32>(x) + 0.5f;
+                    if (A[0] * px + B[0] * py + C[0] < 0.0f || A[1] * px + B[1] * py + C[1] < 0.0f ||
+                        A[2] * px + B[2] * py + C[2] < 0.0f)
+                        continue;
+                    f32 z = std::min(t.zx * px + t.zy * py + t.zc, t.zMax);
+                    if (z < row[x]) row[x] = z;
+                }
+                (void)xa;
+#endif
+            }
+        }
+    }
+}
+
+void OcclusionBuffer::BuildHiZ() {
+    for (size_t l = 1; l < m_HiZ.size(); ++l) {
+        const std::vector<f32>& src = m_HiZ[l - 1];
+        std::vector<f32>& dst = m_HiZ[l];
+        const u32 sw = m_LevelW[l - 1], sh = m_LevelH[l - 1];
+        const u32 dw = m_LevelW[l], dh = m_LevelH[l];
+        for (u32 y = 0; y < dh; ++y) {
+            const f32* r0 = &src[static_cast<size_t>(std::min(2 * y, sh - 1)) * sw];
+            const f32* r1 = &src[static_cast<size_t>(std::min(2 * y + 1, sh - 1)) * sw];
+            for (u32 x = 0; x < dw; ++x) {
+                u32 xa = std::min(2 * x, sw - 1), xb = std::min(2 * x + 1, sw - 1);
+                dst[static_cast<size_t>(y) * dw + x] = std::max(std::max(r0[xa], r0[xb]), std::max(r1[xa], r1[xb]));
+            }
+        }
+    }
+}
+
+void OcclusionBuffer::Rasterize() {
+    auto t0 = std::chrono::steady_clock::now();
+    std::fill(m_HiZ[0].begin(), m_HiZ[0].end(), 1.0f);
+
+    size_t triangles = 0;
+    for (const Occluder& o : m_Occluders) triangles += o.indexCount / 3;
+    m_Stats.occluders = static_cast<u32>(m_Occluders.size());
+    m_Stats.trianglesIn = static_cast<u32>(triangles);
+
+    u32 threads = m_Settings.threads;
+    if (threads == 0) threads = std::min(4u, std::max(1u, std::thread::hardware_concurrency()));
+    // Thread start-up costs more than a few hundred triangles do.
+    if (triangles < 512) threads = 1;
+    threads = std::min<u32>(threads, m_Height);
+
+    // Setup: occluders split across threads, one triangle list each.
+    m_Bins.resize(threads);
+    for (auto& bin : m_Bins) bin.clear();
+    {
+        std::vector<std::thread> pool;
+        size_t per = (m_Occluders.size() + threads - 1) / threads;
+        for (u32 i = 1; i < threads; ++i) {
+            size_t first = std::min(m_Occluders.size(), i * per), last = std::min(m_Occluders.size(), first + per);
+            pool.emplace_back([this, i, first, last] {
+                SetupScratch scratch;
+                SetupOccluders(first, last, m_Bins[i], scratch);
+            });
+        }
+        SetupScratch scratch;
+        SetupOccluders(0, std::min(m_Occluders.size(), per), m_Bins[0], scratch);
+        for (auto& th : pool) th.join();
+    }
+    size_t emitted = 0;
+    for (auto& bin : m_Bins) emitted += bin.size();
+    m_Stats.trianglesRasterized = static_cast<u32>(emitted);
+
+    // Raster: each thread owns a band of rows, so no pixel is shared.
+    {
+        std::vector<std::thread> pool;
+        i32 band = static_cast<i32>((m_Height + threads - 1) / threads);
+        for (u32 i = 1; i < threads; ++i) {
+            i32 y0 = static_cast<i32>(i) * band, y1 = std::min(static_cast<i32>(m_Height), y0 + band);
+            if (y0 < y1) pool.emplace_back([this, y0, y1] { RasterBand(y0, y1); });
+        }
+        RasterBand(0, std::min(static_cast<i32>(m_Height), band));
+        for (auto& th : pool) th.join();
+    }
+
+    BuildHiZ();
+    m_Stats.rasterMs = std::chrono::duration<f32, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// ── Occludee tests ─────────────────────────────────────────────────────────
+
+bool OcclusionBuffer::IsRectOccluded(f32 xMin, f32 yMin, f32 xMax, f32 yMax, f32 zMin) {
+    const i32 W = static_cast<i32>(m_Width), H = static_cast<i32>(m_Height);
+    if (xMax < 0.0f || yMax < 0.0f || xMin >= static_cast<f32>(W) || yMin >= static_cast<f32>(H)) return false;
+    // Grown by a pixel: occluders are sampled at pixel centres, so one may
+    // cover a centre while the occludee shows past its edge.
+    i32 x0 = std::max(0, static_cast<i32>(std::floor(xMin)) - 1);
+    i32 y0 = std::max(0, static_cast<i32>(std::floor(yMin)) - 1);
+    i32 x1 = std::min(W - 1, static_cast<i32>(std::floor(xMax)) + 1);
+    i32 y1 = std::min(H - 1, static_cast<i32>(std::floor(yMax)) + 1);
+
+    // Coarsest level at which the rectangle spans at most 4x4 texels.
+    u32 level = 0;
+    while (level + 1 < m_HiZ.size() && ((x1 >> level) - (x0 >> level) >= 4 || (y1 >> level) - (y0 >> level) >= 4))
+        ++level;
+    const std::vector<f32>& hiz = m_HiZ[level];
+    const u32 lw = m_LevelW[level];
+    for (i32 y = y0 >> level; y <= (y1 >> level); ++y)
+        for (i32 x = x0 >> level; x <= (x1 >> level); ++x)
+            if (zMin <= hiz[static_cast<size_t>(y) * lw + x]) return false;
+    return true;
+}
+
+bool OcclusionBuffer::IsBoxOccluded(const Vec3& boxMin, const Vec3& boxMax, const Mat4& model) {
+    m_Stats.tested++;
+    Mat4 mvp = m_ViewProj * model;
+    f32 xMin = 1e30f, yMin = 1e30f, xMax = -1e30f, yMax = -1e30f, zMin = 1e30f;
+    const f32 hw = 0.5f * static_cast<f32>(m_Width), hh = 0.5f * static_cast<f32>(m_Height);
+    for (u32 c = 0; c < 8; ++c) {
+        Vec4 p = TransformPoint(mvp, (c & 1) ? boxMax.x : boxMin.x, (c & 2) ? boxMax.y : boxMin.y,
+                                     (c & 4) ? boxMax.z : boxMin.z);
+        if (p.w <= 1e-6f || p.z < -p.w) return false;   // reaches the near plane
+        f32 iw = 1.0f / p.w;
+        f32 sx = (p.x * iw + 1.0f) * hw, sy = (p.y * iw + 1.0f) * hh;
+        xMin = std::min(xMin, sx); xMax = std::max(xMax, sx);
+        yMin = std::min(yMin, sy); yMax = std::max(yMax, sy);
+        zMin = std::min(zMin, p.z * iw * 0.5f + 0.5f);
+    }
+    bool hidden = IsRectOccluded(xMin, yMin, xMax, yMax, zMin);
+    if (hidden) m_Stats.occluded++;
+    return hidden;
+}
+
+bool OcclusionBuffer::IsSphereOccluded(const Vec3& center, f32 radius) {
+    Vec3 r(radius, radius, radius);
+    return IsBoxOccluded(center - r, center + r, Mat4::Identity());
+}
+
+} // namespace gv
@@ -0,0 +1,316 @@
+// ============================================================================
+// GameVoid Engine — Post-Processing Effect Chain Implementation
+// ============================================================================
+#include "renderer/PostProcessing.h"
+
+#ifdef GV_HAS_GLFW
+#include "core/GLDefs.h"
+#endif
+
+#include <algorithm>
+
+namespace gv {
+
+// ── Effect list (no GL) ────────────────────────────────────────────────────
+
+PostProcessing::Effect* PostProcessing::Find(const std::string& name) {
+    for (auto& e : m_Effects)
+        if (e.name == name) return &e;
+    return nullptr;
+}
+
+const PostProcessing::Effect* PostProcessing::Find(const std::string& name) const {
+    for (auto& e : m_Effects)
+        if (e.name == name) return &e;
+    return nullptr;
+}
+
+void PostProcessing::Sort() {
+    std::sort(m_Effects.begin(), m_Effects.end(), [](const Effect& a, const Effect& b) {
+        return a.order != b.order ? a.order < b.order : a.sequence < b.sequence;
+    });
+}
+
+bool PostProcessing::AddEffect(const std::string& name, const std::string& fragmentSrc,
+                               i32 order, PostEffectSetup setup) {
+    Effect* effect = Find(name);
+    if (effect) {
+#ifdef GV_HAS_GLFW
+        if (effect->program) glDeleteProgram(effect->program);
+#endif
+        effect->program = 0;
+    } else {
+        m_Effects.emplace_back();
+        effect = &m_Effects.back();
+        effect->name = name;
+        effect->sequence = m_NextSequence++;
+    }
+    effect->fragmentSrc = fragmentSrc;
+    effect->order = order;
+    effect->setup = std::move(setup);
+    effect->failed = false;
+
+    bool ok = m_Initialised ? Compile(*effect) : true;
+    Sort();
+    return ok;
+}
+
+void PostProcessing::RemoveEffect(const std::string& name) {
+    auto it = std::find_if(m_Effects.begin(), m_Effects.end(),
+                           [&](const Effect& e) { return e.name == name; });
+    if (it == m_Effects.end()) return;
+#ifdef GV_HAS_GLFW
+    if (it->program) glDeleteProgram(it->program);
+#endif
+    m_Effects.erase(it);
+}
+
+bool PostProcessing::HasEffect(const std::string& name) const {
+    return Find(name) != nullptr;
+}
+
+void PostProcessing::SetEffectEnabled(const std::string& name, bool enabled) {
+    if (Effect* e = Find(name)) e->enabled = enabled;
+}
+
+bool PostProcessing::IsEffectEnabled(const std::string& name) const {
+    const Effect* e = Find(name);
+    return e && e->enabled;
+}
+
+void PostProcessing::SetEffectOrder(const std::string& name, i32 order) {
+    Effect* e = Find(name);
+    if (!e || e->order == order) return;
+    e->order = order;
+    Sort();
+}
+
+std::vector<std::string> PostProcessing::GetActiveEffects() const {
+    std::vector<std::string> names;
+    for (auto& e : m_Effects)
+        if (e.enabled && !e.failed) names.push_back(e.name);
+    return names;
+}
+
+// ── GL side ────────────────────────────────────────────────────────────────
+
+#ifdef GV_HAS_GLFW
+
+static const char* s_PostChainVert =
+    "#version 330 core\n"
+    "layout(location = 0) in vec2 aPos;\n"
+    "layout(location = 1) in vec2 aTexCoord;\n"
+    "out vec2 vTexCoord;\n"
+    "void main() {\n"
+    "    gl_Position = vec4(aPos, 0.0, 1.0);\n"
+    "    vTexCoord = aTexCoord;\n"
+    "}\n";
+
+static GLuint CompilePostStage(GLenum type, const char* src, const std::string& name) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &src, nullptr);
+    glCompileShader(shader);
+    GLint ok = 0;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+    if (!ok) {
+        char buf[1024];
+        glGetShaderInfoLog(shader, 1024, nullptr, buf);
+        GV_LOG_ERROR("PostProcessing '" + name + "' compile: " + std::string(buf));
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+bool PostProcessing::Compile(Effect& effect) {
+    effect.program = 0;
+    effect.failed = true;
+    GLuint vs = CompilePostStage(GL_VERTEX_SHADER, s_PostChainVert, effect.name);
+    GLuint fs = CompilePostStage(GL_FRAGMENT_SHADER, effect.fragmentSrc.c_str(), effect.name);
+    if (!vs || !fs) {
+        if (vs) glDeleteShader(vs);
+        if (fs) glDeleteShader(fs);
+        return false;
+    }
+    GLuint prog = glCreateProgram();
+    glAttachShader(prog, vs);
+    glAttachShader(prog, fs);
+    glLinkProgram(prog);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+    GLint linked = 0;
+    glGetProgramiv(prog, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        char buf[1024];
+        glGetProgramInfoLog(prog, 1024, nullptr, buf);
+        GV_LOG_ERROR("PostProcessing '" + effect.name + "' link: " + std::string(buf));
+        glDeleteProgram(prog);
+        return false;
+    }
+    effect.program = prog;
+    effect.failed = false;
+    return true;
+}
+
+void PostProcessing::CreateTargets() {
+    GLsizei w = static_cast<GLsizei>(m_Width);
+    GLsizei h = static_cast<GLsizei>(m_Height);
+    for (int i = 0; i < 2; ++i) {
+        glGenFramebuffers(1, &m_FBO[i]);
+        glGenTextures(1, &m_ColorTex[i]);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_FBO[i]);
+        glBindTexture(GL_TEXTURE_2D, m_ColorTex[i]);
+        if (m_HDR)
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, w, h, 0, GL_RGBA, GL_FLOAT, nullptr);
+        else
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_ColorTex[i], 0);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+            GV_LOG_ERROR("PostProcessing target incomplete!");
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void PostProcessing::DestroyTargets() {
+    for (int i = 0; i < 2; ++i) {
+        if (m_FBO[i])      { glDeleteFramebuffers(1, &m_FBO[i]);  m_FBO[i] = 0; }
+        if (m_ColorTex[i]) { glDeleteTextures(1, &m_ColorTex[i]); m_ColorTex[i] = 0; }
+    }
+}
+
+void PostProcessing::Init(u32 width, u32 height, bool hdr) {
+    if (m_Initialised) Shutdown();
+    if (!glGenFramebuffers || !glCreateShader || !glGenVertexArrays) return;
+    m_Width  = width  ? width  : 1;
+    m_Height = height ? height : 1;
+    m_HDR = hdr;
+
+    CreateTargets();
+
+    float quadVerts[] = {
+        -1, -1,   0, 0,
+         1, -1,   1, 0,
+         1,  1,   1, 1,
+        -1, -1,   0, 0,
+         1,  1,   1, 1,
+        -1,  1,   0, 1,
+    };
+    glGenVertexArrays(1, &m_QuadVAO);
+    glGenBuffers(1, &m_QuadVBO);
+    glBindVertexArray(m_QuadVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_QuadVBO);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(sizeof(quadVerts)), quadVerts, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4*sizeof(float), reinterpret_cast<void*>(0));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4*sizeof(float),
+                          reinterpret_cast<void*>(2*sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glBindVertexArray(0);
+
+    m_Initialised = true;
+    for (auto& e : m_Effects) Compile(e);
+
+    GV_LOG_INFO("PostProcessing chain initialised (" + std::to_string(m_Width) + "x" +
+                std::to_string(m_Height) + ", " + std::to_string(m_Effects.size()) + " effects).");
+}
+
+void PostProcessing::Resize(u32 width, u32 height) {
+    if (!width)  width = 1;
+    if (!height) height = 1;
+    if (width == m_Width && height == m_Height) return;
+    m_Width = width;
+    m_Height = height;
+    if (!m_Initialised) return;
+    DestroyTargets();
+    CreateTargets();
+}
+
+void PostProcessing::Shutdown() {
+    if (!m_Initialised) return;
+    for (auto& e : m_Effects) {
+        if (e.program) { glDeleteProgram(e.program); e.program = 0; }
+    }
+    DestroyTargets();
+    if (m_QuadVAO) { glDeleteVertexArrays(1, &m_QuadVAO); m_QuadVAO = 0; }
+    if (m_QuadVBO) { glDeleteBuffers(1, &m_QuadVBO);      m_QuadVBO = 0; }
+    m_Initialised = false;
+}
+
+u32 PostProcessing::Apply(u32 source) {
+    if (!m_Initialised) return source;
+
+    GLint prevFBO = 0;
+    GLint prevViewport[4] = { 0, 0, 0, 0 };
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFBO);
+    glGetIntegerv(GL_VIEWPORT_ENUM, prevViewport);
+    GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+    glDisable(GL_DEPTH_TEST);
+
+    u32 current = source;
+    int target = (source == m_ColorTex[0]) ? 1 : 0;
+    bool ran = false;
+    for (auto& e : m_Effects) {
+        if (!e.enabled || !e.program) continue;
+        if (!ran) {
+            glViewport(0, 0, static_cast<GLsizei>(m_Width), static_cast<GLsizei>(m_Height));
+            glBindVertexArray(m_QuadVAO);
+            ran = true;
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, m_FBO[target]);
+        glUseProgram(e.program);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, current);
+        glUniform1i(glGetUniformLocation(e.program, "u_Source"), 0);
+        glUniform2f(glGetUniformLocation(e.program, "u_TexelSize"),
+                    1.0f / static_cast<f32>(m_Width), 1.0f / static_cast<f32>(m_Height));
+        if (e.setup) {
+            PostEffectContext ctx;
+            ctx.program = e.program;
+            ctx.source  = current;
+            ctx.width   = m_Width;
+            ctx.height  = m_Height;
+            e.setup(ctx);
+        }
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+        current = m_ColorTex[target];
+        target ^= 1;
+    }
+
+    if (ran) {
+        glBindVertexArray(0);
+        glUseProgram(0);
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(prevFBO));
+        glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
+    }
+    if (depthTest) glEnable(GL_DEPTH_TEST);
+    return current;
+}
+
+#else  // !GV_HAS_GLFW
+
+bool PostProcessing::Compile(Effect& effect) { effect.program = 0; return true; }
+void PostProcessing::CreateTargets() {}
+void PostProcessing::DestroyTargets() {}
+
+void PostProcessing::Init(u32 width, u32 height, bool hdr) {
+    m_Width = width;
+    m_Height = height;
+    m_HDR = hdr;
+}
+
+void PostProcessing::Resize(u32 width, u32 height) {
+    m_Width = width;
+    m_Height = height;
+}
+
+void PostProcessing::Shutdown() {}
+
+u32 PostProcessing::Apply(u32 source) { return source; }
+
+#endif // GV_HAS_GLFW
+
+} // namespace gv
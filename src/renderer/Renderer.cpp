@@ -10,7 +10,10 @@
 #include "renderer/MeshRenderer.h"
 #include "renderer/MaterialComponent.h"
 #include "renderer/Frustum.h"
+#include "renderer/ShaderLibrary.h"
 #include "assets/Assets.h"
+#include "assets/MeshRegistry.h"
+#include "assets/TextureStreaming.h"
 #include "animation/SkeletalAnimation.h"
 #include "core/Scene.h"
 #include "core/GameObject.h"
@@ -18,9 +21,11 @@
 #ifdef GV_HAS_GLFW
 #include "core/GLDefs.h"
 #include "core/Window.h"
+#include <chrono>
 #include <cmath>
 #include <vector>
 #include <algorithm>
+#include <future>
 #endif
 
 namespace gv {
@@ -42,6 +47,9 @@ void IRenderer::DrawDebugLine(const Vec3& f, const Vec3& t, const Vec4& col)
 bool OpenGLRenderer::Init(u32 width, u32 height, const std::string& title) {
     m_Width  = width;
     m_Height = height;
+    m_RenderScale  = m_DynResEnabled ? m_DynRes.GetScale() : m_FixedScale;
+    m_RenderWidth  = DynamicResolution::ScaledSize(width, m_RenderScale);
+    m_RenderHeight = DynamicResolution::ScaledSize(height, m_RenderScale);
 
 #ifdef GV_HAS_GLFW
     if (m_Window && m_Window->IsInitialised()) {
@@ -73,6 +81,7 @@ bool OpenGLRenderer::Init(u32 width, u32 height, const std::string& title) {
         InitScreenQuad();
         InitSpriteRenderer();
         InitDeferredPipeline();
+        InitImpostorShaders();
     }
 #endif
 
@@ -91,6 +100,8 @@ void OpenGLRenderer::Shutdown() {
     CleanupPostProcessing();
     CleanupSpriteRenderer();
     CleanupDeferred();
+    CleanupImpostors();
+    m_Shaders.Clear();
 #endif
     m_Initialised = false;
     GV_LOG_INFO("OpenGLRenderer shut down.");
@@ -122,6 +133,9 @@ void OpenGLRenderer::EndFrame() {
 // ============================================================================
 void OpenGLRenderer::RenderScene(Scene& scene, Camera& camera) {
 #ifdef GV_HAS_GLFW
+    // Pick up edited shader files (rate-limited inside the library)
+    if (m_Shaders.PollChanges() > 0) RefreshShaderHandles();
+
     if (!m_SceneShader) {
         (void)scene; (void)camera;
         return;
@@ -182,19 +196,34 @@ void OpenGLRenderer::RenderScene(Scene& scene, Camera& camera) {
         }
     }
 
-    // ── 2. Shadow pass (directional light) ─────────────────────────────────
+    Mat4 view = camera.GetViewMatrix();
+    Mat4 proj = camera.GetProjectionMatrix();
+    Mat4 viewProj = proj * view;
+
+    // ── 2. Occluders: rasterized on a worker during the shadow pass ───────
+    bool occlusion = false;
+    std::future<void> occlusionJob;
+    if (m_OcclusionCulling) {
+        m_Occlusion.BeginFrame(viewProj);
+        CollectOccluders(scene);
+        occlusion = m_Occlusion.HasOccluders();
+        if (occlusion) occlusionJob = std::async(std::launch::async, [this] { m_Occlusion.Rasterize(); });
+    }
+
+    // ── 2b. Shadow pass (directional light) ────────────────────────────────
     if (m_ShadowsEnabled && m_ShadowShader && m_ShadowFBO) {
         RenderShadowPass(scene, lightDir);
     }
+    if (occlusionJob.valid()) occlusionJob.get();
 
     // ── 3. Rendering ─────────────────────────────────────────────────────────
-    Mat4 view = camera.GetViewMatrix();
-    Mat4 proj = camera.GetProjectionMatrix();
-    Mat4 viewProj = proj * view;
-
     // Extract frustum planes for culling
     Frustum frustum;
     frustum.ExtractFromVP(viewProj);
+    Mat4 invView = view.Inverse();
+    Vec3 eye(invView.m[12], invView.m[13], invView.m[14]);   // world-space camera position
+    m_MeshletStats.Reset();
+    m_ImpostorQueue.clear();
 
     i32 drawCount = 0;
     i32 culledCount = 0;
@@ -204,10 +233,14 @@ void OpenGLRenderer::RenderScene(Scene& scene, Camera& camera) {
     // ── 3a. Deferred rendering path ────────────────────────────────────────
     if (m_DeferredEnabled && m_GeoPassShader && m_GBufferFBO && m_DeferredLightShader) {
         GLint prevFBO = 0;
+        GLint prevViewport[4] = { 0, 0, 0, 0 };
         glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFBO);
+        glGetIntegerv(GL_VIEWPORT_ENUM, prevViewport);
 
         // ── Geometry pass (write to G-buffer MRT) ──────────────────────────
+        // The G-buffer and SSAO targets are at render resolution.
         glBindFramebuffer(GL_FRAMEBUFFER, m_GBufferFBO);
+        glViewport(0, 0, static_cast<GLsizei>(m_RenderWidth), static_cast<GLsizei>(m_RenderHeight));
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         glUseProgram(m_GeoPassShader);
         glUniformMatrix4fv(glGetUniformLocation(m_GeoPassShader, "u_View"), 1, GL_FALSE, view.m);
@@ -219,6 +252,7 @@ void OpenGLRenderer::RenderScene(Scene& scene, Camera& camera) {
         GLint gLocAO      = glGetUniformLocation(m_GeoPassShader, "u_AO");
         GLint gLocHasAlb  = glGetUniformLocation(m_GeoPassShader, "u_HasAlbedoMap");
         GLint gLocHasNorm = glGetUniformLocation(m_GeoPassShader, "u_HasNormalMap");
+        GLint gLocFade    = glGetUniformLocation(m_GeoPassShader, "u_DitherFade");
 
         for (auto& obj : scene.GetAllObjects()) {
             if (!obj->IsActive()) continue;
@@ -230,9 +264,14 @@ void OpenGLRenderer::RenderScene(Scene& scene, Camera& camera) {
             if (!frustum.TestObject(objPos, objScale)) { culledCount++; continue; }
 
             Mat4 model = obj->GetTransform().GetModelMatrix();
+            if (occlusion && IsOccluded(*mr, model)) { culledCount++; continue; }
+            f32 fade = QueueImpostor(*mr, model, objPos, eye);
+            if (fade >= 1.0f) { drawCount++; continue; }
+            glUniform1f(gLocFade, fade);
             glUniformMatrix4fv(gLocModel, 1, GL_FALSE, model.m);
 
             auto* mc = obj->GetComponent<MaterialComponent>();
+            if (mc && m_TextureStreamer) RequestStreamedTextures(*mc, objPos, objScale, camPos, camera);
             if (mc) {
                 glUniform4f(gLocColor, mc->albedo.x, mc->albedo.y, mc->albedo.z, mc->albedo.w);
                 glUniform1f(gLocMetal, mc->metallic);
@@ -260,10 +299,7 @@ void OpenGLRenderer::RenderScene(Scene& scene, Camera& camera) {
             }
             // Draw primitive
             if (mr->GetMesh() && mr->GetMesh()->GetIndexCount() > 0) {
-                mr->GetMesh()->Bind();
-                glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(mr->GetMesh()->GetIndexCount()),
-                               GL_UNSIGNED_INT, nullptr);
-                mr->GetMesh()->Unbind();
+                if (!DrawMesh(*mr->GetMesh(), model, frustum, eye)) { culledCount++; continue; }
             } else if (mr->primitiveType == PrimitiveType::Triangle) {
                 glBindVertexArray(m_TriVAO); glDrawArrays(GL_TRIANGLES, 0, 3); glBindVertexArray(0);
             } else if (mr->primitiveType == PrimitiveType::Cube) {
@@ -296,7 +332,7 @@ void OpenGLRenderer::RenderScene(Scene& scene, Camera& camera) {
             glUniformMatrix4fv(glGetUniformLocation(m_SSAOShader, "u_View"), 1, GL_FALSE, view.m);
             glUniformMatrix4fv(glGetUniformLocation(m_SSAOShader, "u_Projection"), 1, GL_FALSE, proj.m);
             glUniform2f(glGetUniformLocation(m_SSAOShader, "u_NoiseScale"),
-                        static_cast<f32>(m_Width) / 4.0f, static_cast<f32>(m_Height) / 4.0f);
+                        static_cast<f32>(m_RenderWidth) / 4.0f, static_cast<f32>(m_RenderHeight) / 4.0f);
             glBindVertexArray(m_ScreenQuadVAO);
             glDrawArrays(GL_TRIANGLES, 0, 6);
             glBindVertexArray(0);
@@ -319,6 +355,7 @@ void OpenGLRenderer::RenderScene(Scene& scene, Camera& camera) {
 
         // ── Deferred lighting pass (full-screen quad) ──────────────────────
         glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(prevFBO));
+        glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         glDisable(GL_DEPTH_TEST);
         glUseProgram(m_DeferredLightShader);
@@ -390,8 +427,9 @@ void OpenGLRenderer::RenderScene(Scene& scene, Camera& camera) {
         // Copy G-buffer depth to current FBO for subsequent draws (skybox, debug)
         glBindFramebuffer(GL_READ_FRAMEBUFFER, m_GBufferFBO);
         glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(prevFBO));
-        glBlitFramebuffer(0, 0, static_cast<GLint>(m_Width), static_cast<GLint>(m_Height),
-                          0, 0, static_cast<GLint>(m_Width), static_cast<GLint>(m_Height),
+        glBlitFramebuffer(0, 0, static_cast<GLint>(m_RenderWidth), static_cast<GLint>(m_RenderHeight),
+                          prevViewport[0], prevViewport[1],
+                          prevViewport[0] + prevViewport[2], prevViewport[1] + prevViewport[3],
                           GL_DEPTH_BUFFER_BIT, GL_NEAREST);
         glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(prevFBO));
     }
@@ -480,6 +518,7 @@ void OpenGLRenderer::RenderScene(Scene& scene, Camera& camera) {
     GLint locAO        = glGetUniformLocation(m_SceneShader, "u_AO");
     GLint locHasAlbedo = glGetUniformLocation(m_SceneShader, "u_HasAlbedoMap");
     GLint locHasNormal = glGetUniformLocation(m_SceneShader, "u_HasNormalMap");
+    GLint locFade      = glGetUniformLocation(m_SceneShader, "u_DitherFade");
 
     for (auto& obj : scene.GetAllObjects()) {
         if (!obj->IsActive()) continue;
@@ -510,10 +549,16 @@ void OpenGLRenderer::RenderScene(Scene& scene, Camera& camera) {
         }
 
         Mat4 model = obj->GetTransform().GetModelMatrix();
+        if (occlusion && IsOccluded(*mr, model)) { culledCount++; continue; }
+        // Far enough for the impostor: skip the mesh, or dither it out.
+        f32 fade = QueueImpostor(*mr, model, objPos, eye);
+        if (fade >= 1.0f) { drawCount++; continue; }
+        glUniform1f(locFade, fade);
         glUniformMatrix4fv(locModel, 1, GL_FALSE, model.m);
 
         // Check for MaterialComponent (PBR overrides)
         auto* matComp = obj->GetComponent<MaterialComponent>();
+        if (matComp && m_TextureStreamer) RequestStreamedTextures(*matComp, objPos, objScale, camPos, camera);
         if (matComp) {
             glUniform4f(locColor, matComp->albedo.x, matComp->albedo.y,
                         matComp->albedo.z, matComp->albedo.w);
@@ -553,11 +598,7 @@ void OpenGLRenderer::RenderScene(Scene& scene, Camera& camera) {
         // Draw the built-in primitive or custom mesh
         if (mr->GetMesh() && mr->GetMesh()->GetIndexCount() > 0) {
             // Custom loaded mesh (e.g. OBJ)
-            mr->GetMesh()->Bind();
-            glDrawElements(GL_TRIANGLES,
-                           static_cast<GLsizei>(mr->GetMesh()->GetIndexCount()),
-                           GL_UNSIGNED_INT, reinterpret_cast<void*>(0));
-            mr->GetMesh()->Unbind();
+            if (!DrawMesh(*mr->GetMesh(), model, frustum, eye)) { culledCount++; continue; }
         } else if (mr->primitiveType == PrimitiveType::Triangle) {
             glBindVertexArray(m_TriVAO);
             glDrawArrays(GL_TRIANGLES, 0, 3);
@@ -580,6 +621,10 @@ void OpenGLRenderer::RenderScene(Scene& scene, Camera& camera) {
 
     } // end forward PBR else block
 
+    // ── 4a. Impostors (after the opaque pass, depth-tested against it) ─────
+    RenderImpostors(view, proj, eye, lightDir, lightColor, ambientColor);
+    m_ImpostorsDrawn = static_cast<u32>(m_ImpostorQueue.size());
+
     // ── 4b. Draw skinned mesh objects (GPU bone animation) ─────────────────
     if (m_SkinnedShader) {
         glUseProgram(m_SkinnedShader);
@@ -663,12 +708,17 @@ void OpenGLRenderer::RenderScene(Scene& scene, Camera& camera) {
                 glUniform1i(locSkHasBones, 0);
             }
 
-            // Draw — the SkinnedMeshRenderer doesn't have a mesh VAO built-in yet,
-            // so we render it as a cube placeholder if no custom skinned mesh is attached.
-            // Full skinned mesh rendering would use a SkinnedMesh VAO.
-            glBindVertexArray(m_CubeVAO);
-            glDrawElements(GL_TRIANGLES, m_CubeIndexCount, GL_UNSIGNED_INT, nullptr);
-            glBindVertexArray(0);
+            // Draw the skinned mesh, or a cube placeholder if none is attached.
+            if (smr->mesh && smr->mesh->GetIndexCount() > 0) {
+                smr->mesh->Bind();
+                glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(smr->mesh->GetIndexCount()),
+                               GL_UNSIGNED_INT, nullptr);
+                smr->mesh->Unbind();
+            } else {
+                glBindVertexArray(m_CubeVAO);
+                glDrawElements(GL_TRIANGLES, m_CubeIndexCount, GL_UNSIGNED_INT, nullptr);
+                glBindVertexArray(0);
+            }
 
             drawCount++;
         }
@@ -678,6 +728,9 @@ void OpenGLRenderer::RenderScene(Scene& scene, Camera& camera) {
     // ── 5. Flush debug draw ────────────────────────────────────────────────
     FlushDebugDraw(camera);
 
+    // ── 6. Texture streaming: act on this frame's on-screen sizes ──────────
+    if (m_TextureStreamer) m_TextureStreamer->Update();
+
     static bool loggedOnce = false;
     if (!loggedOnce) {
         GV_LOG_INFO("RenderScene: drew " + std::to_string(drawCount) +
@@ -691,6 +744,84 @@ void OpenGLRenderer::RenderScene(Scene& scene, Camera& camera) {
 #endif
 }
 
+#ifdef GV_HAS_GLFW
+void OpenGLRenderer::RequestStreamedTextures(const MaterialComponent& mat, const Vec3& pos, f32 radius,
+                                             const Vec3& camPos, const Camera& camera) {
+    f32 pixels = TextureStreamer::ProjectedSize(pos, radius, camPos, camera.fov,
+                                                static_cast<f32>(m_RenderHeight));
+    for (u32 id : { mat.albedoMap, mat.normalMap, mat.roughnessMap, mat.metallicMap })
+        if (id) m_TextureStreamer->Request(id, pixels);
+}
+
+bool OpenGLRenderer::DrawMesh(const Mesh& mesh, const Mat4& model, const Frustum& frustum, const Vec3& eye) {
+    if (m_MeshletCulling && mesh.HasMeshlets()) {
+        if (m_OcclusionCulling && m_Occlusion.HasOccluders() && !m_MeshletCullSettings.occlusion) {
+            // No caller-supplied test: use this frame's occlusion buffer.
+            MeshletCullSettings settings = m_MeshletCullSettings;
+            settings.occlusion = [this](const Vec3& c, f32 r) { return m_Occlusion.IsSphereOccluded(c, r); };
+            CullMeshlets(mesh.GetMeshlets(), model, frustum, eye, m_MeshletDrawList, settings, &m_MeshletStats);
+        } else {
+            CullMeshlets(mesh.GetMeshlets(), model, frustum, eye, m_MeshletDrawList, m_MeshletCullSettings,
+                         &m_MeshletStats);
+        }
+        if (m_MeshletDrawList.Empty()) return false;
+        const auto& dl = m_MeshletDrawList;
+        mesh.Bind();
+        if (glMultiDrawElements) {
+            glMultiDrawElements(GL_TRIANGLES, dl.counts.data(), GL_UNSIGNED_INT, dl.offsets.data(),
+                                static_cast<GLsizei>(dl.counts.size()));
+        } else {
+            for (size_t i = 0; i < dl.counts.size(); ++i)
+                glDrawElements(GL_TRIANGLES, dl.counts[i], GL_UNSIGNED_INT, dl.offsets[i]);
+        }
+        mesh.Unbind();
+        return true;
+    }
+    mesh.Bind();
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(mesh.GetIndexCount()), GL_UNSIGNED_INT, nullptr);
+    mesh.Unbind();
+    return true;
+}
+
+/// Local-space bounds of what a MeshRenderer draws.
+static void RendererBounds(const MeshRenderer& mr, Vec3& outMin, Vec3& outMax) {
+    if (mr.GetMesh() && mr.GetMesh()->GetIndexCount() > 0) {
+        mr.GetMesh()->GetBounds(outMin, outMax);
+    } else if (mr.primitiveType == PrimitiveType::Plane) {
+        outMin = Vec3(-0.5f, 0.0f, -0.5f); outMax = Vec3(0.5f, 0.0f, 0.5f);
+    } else if (mr.primitiveType == PrimitiveType::Triangle) {
+        outMin = Vec3(-0.5f, -0.5f, 0.0f); outMax = Vec3(0.5f, 0.5f, 0.0f);
+    } else {
+        outMin = Vec3(-0.5f, -0.5f, -0.5f); outMax = Vec3(0.5f, 0.5f, 0.5f);
+    }
+}
+
+void OpenGLRenderer::CollectOccluders(Scene& scene) {
+    for (auto& obj : scene.GetAllObjects()) {
+        if (!obj->IsActive()) continue;
+        MeshRenderer* mr = obj->GetComponent<MeshRenderer>();
+        if (!mr || !mr->occluder) continue;
+        Mat4 model = obj->GetTransform().GetModelMatrix();
+        Shared<Mesh> mesh = mr->GetOccluderMesh() ? mr->GetOccluderMesh() : mr->GetMesh();
+        if (mesh && mesh->GetIndexCount() > 0) {
+            const auto& verts = mesh->GetVertices();
+            const auto& idx = mesh->GetIndices();
+            m_Occlusion.AddOccluder(&verts[0].position.x, sizeof(Vertex), verts.size(), idx.data(), idx.size(), model);
+        } else if (!mesh && (mr->primitiveType == PrimitiveType::Cube || mr->primitiveType == PrimitiveType::Plane)) {
+            Vec3 bMin, bMax;
+            RendererBounds(*mr, bMin, bMax);
+            m_Occlusion.AddOccluderBox(bMin, bMax, model);
+        }
+    }
+}
+
+bool OpenGLRenderer::IsOccluded(const MeshRenderer& mr, const Mat4& model) {
+    Vec3 bMin, bMax;
+    RendererBounds(mr, bMin, bMax);
+    return m_Occlusion.IsBoxOccluded(bMin, bMax, model);
+}
+#endif
+
 void OpenGLRenderer::ApplyLighting(Scene& scene) {
     (void)scene;
     // Lighting is now uploaded directly in RenderScene
@@ -709,6 +840,49 @@ void OpenGLRenderer::PollEvents() {
 #endif
 }
 
+bool OpenGLRenderer::BakeImpostor(const ImpostorSource& source, const ImpostorSettings& settings, ImpostorAtlas& out) {
+#ifdef GV_HAS_GLFW
+    if (m_ImpostorBakeShader && PrepareImpostorAtlas(source, settings, out) && BakeImpostorGPU(source, out)) {
+        out.Upload();
+        GV_LOG_INFO("Impostor baked on the GPU (" + std::to_string(out.width) + "x" + std::to_string(out.height) + ")");
+        return true;
+    }
+#endif
+    if (!BakeImpostorSoftware(source, settings, out)) {
+        GV_LOG_WARN("BakeImpostor — nothing to bake (no mesh or empty settings)");
+        return false;
+    }
+#ifdef GV_HAS_GLFW
+    if (m_ImpostorShader) out.Upload();
+#endif
+    GV_LOG_INFO("Impostor baked on the CPU (" + std::to_string(out.width) + "x" + std::to_string(out.height) + ")");
+    return true;
+}
+
+void OpenGLRenderer::SetRenderScale(f32 scale) {
+    m_FixedScale = scale < 0.1f ? 0.1f : (scale > 1.0f ? 1.0f : scale);
+    if (!m_DynResEnabled) ApplyRenderScale();
+}
+
+void OpenGLRenderer::SetDynamicResolutionEnabled(bool e) {
+    if (e == m_DynResEnabled) return;
+    m_DynResEnabled = e;
+    if (e) m_DynRes.Reset();
+    ApplyRenderScale();
+}
+
+void OpenGLRenderer::ApplyRenderScale() {
+    m_RenderScale = m_DynResEnabled ? m_DynRes.GetScale() : m_FixedScale;
+    u32 w = DynamicResolution::ScaledSize(m_Width, m_RenderScale);
+    u32 h = DynamicResolution::ScaledSize(m_Height, m_RenderScale);
+    if (w == m_RenderWidth && h == m_RenderHeight) return;
+    m_RenderWidth  = w;
+    m_RenderHeight = h;
+#ifdef GV_HAS_GLFW
+    if (m_Initialised && (m_HDR_FBO || m_GBufferFBO)) ResizeRenderTargets();
+#endif
+}
+
 // ============================================================================
 // Demo triangle
 // ============================================================================
@@ -822,6 +996,9 @@ void OpenGLRenderer::CleanupDemo() {
 // Cook-Torrance BRDF with GGX distribution, Smith geometry, Fresnel-Schlick.
 // Supports: directional light, up to 8 point lights, up to 4 spot lights,
 // shadow mapping, normal mapping, albedo/roughness/metallic textures.
+// The vertex stage has a SKINNED permutation (GPU bone skinning).  These
+// sources are registered with the ShaderLibrary as "pbr.vert" / "pbr.frag";
+// a file of the same name under shaders/ overrides them and hot-reloads.
 
 static const char* s_PBR_VertSrc =
     "#version 330 core\n"
@@ -830,12 +1007,22 @@ static const char* s_PBR_VertSrc =
     "layout(location = 2) in vec2 aTexCoord;\n"
     "layout(location = 3) in vec3 aTangent;\n"
     "layout(location = 4) in vec3 aBitangent;\n"
+    "#ifdef SKINNED\n"
+    "layout(location = 5) in ivec4 aBoneIDs;\n"
+    "layout(location = 6) in vec4 aBoneWeights;\n"
+    "#endif\n"
     "\n"
     "uniform mat4 u_Model;\n"
     "uniform mat4 u_View;\n"
     "uniform mat4 u_Proj;\n"
     "uniform mat4 u_LightSpaceMatrix;\n"
     "\n"
+    "#ifdef SKINNED\n"
+    "#define MAX_BONES 128\n"
+    "uniform mat4 u_BoneMatrices[MAX_BONES];\n"
+    "uniform int  u_HasBones;\n"
+    "#endif\n"
+    "\n"
     "out vec3 vWorldPos;\n"
     "out vec3 vNormal;\n"
     "out vec2 vTexCoord;\n"
@@ -843,10 +1030,25 @@ static const char* s_PBR_VertSrc =
     "out mat3 vTBN;\n"
     "\n"
     "void main() {\n"
-    "    vec4 worldPos = u_Model * vec4(aPos, 1.0);\n"
+    "#ifdef SKINNED\n"
+    "    mat4 skinMatrix = mat4(1.0);\n"
+    "    if (u_HasBones != 0) {\n"
+    "        skinMatrix = mat4(0.0);\n"
+    "        for (int i = 0; i < 4; ++i) {\n"
+    "            if (aBoneIDs[i] >= 0 && aBoneIDs[i] < MAX_BONES) {\n"
+    "                skinMatrix += u_BoneMatrices[aBoneIDs[i]] * aBoneWeights[i];\n"
+    "            }\n"
+    "        }\n"
+    "    }\n"
+    "    vec4 localPos = skinMatrix * vec4(aPos, 1.0);\n"
+    "    mat3 normalMat = mat3(u_Model) * mat3(skinMatrix);\n"
+    "#else\n"
+    "    vec4 localPos = vec4(aPos, 1.0);\n"
+    "    mat3 normalMat = mat3(u_Model);\n"
+    "#endif\n"
+    "    vec4 worldPos = u_Model * localPos;\n"
     "    gl_Position = u_Proj * u_View * worldPos;\n"
     "    vWorldPos = worldPos.xyz;\n"
-    "    mat3 normalMat = mat3(u_Model);\n"
     "    vNormal = normalize(normalMat * aNormal);\n"
     "    vTexCoord = aTexCoord;\n"
     "    vLightSpacePos = u_LightSpaceMatrix * worldPos;\n"
@@ -980,7 +1182,18 @@ static const char* s_PBR_FragSrc =
     "    return (kD * albedo / PI + specular) * lightColor * NdotL;\n"
     "}\n"
     "\n"
+    "uniform float u_DitherFade;   // > 0 while cross-fading to an impostor\n"
+    "\n"
+    "// 4x4 ordered dither; the impostor discards the complementary pixels.\n"
+    "float DitherThreshold() {\n"
+    "    const float b[16] = float[16](0.0, 8.0, 2.0, 10.0, 12.0, 4.0, 14.0, 6.0,\n"
+    "                                  3.0, 11.0, 1.0, 9.0, 15.0, 7.0, 13.0, 5.0);\n"
+    "    ivec2 p = ivec2(gl_FragCoord.xy) & 3;\n"
+    "    return (b[p.y * 4 + p.x] + 0.5) / 16.0;\n"
+    "}\n"
+    "\n"
     "void main() {\n"
+    "    if (u_DitherFade > 0.0 && DitherThreshold() < u_DitherFade) discard;\n"
     "    // Get albedo\n"
     "    vec3 albedo = u_Color.rgb;\n"
     "    float alpha = u_Color.a;\n"
@@ -1057,9 +1270,11 @@ static const char* s_PBR_FragSrc =
 void OpenGLRenderer::InitSceneShader() {
     if (!glCreateShader) return;
 
-    GLuint vs = CompileShaderStage(GL_VERTEX_SHADER,   s_PBR_VertSrc);
-    GLuint fs = CompileShaderStage(GL_FRAGMENT_SHADER, s_PBR_FragSrc);
-    m_SceneShader = LinkProgram(vs, fs);
+    m_Shaders.AddSearchPath("shaders");
+    m_Shaders.RegisterSource("pbr.vert", s_PBR_VertSrc);
+    m_Shaders.RegisterSource("pbr.frag", s_PBR_FragSrc);
+    m_Shaders.Load("pbr", "pbr.vert", "pbr.frag");
+    m_SceneShader = m_Shaders.Get("pbr");
 
     GV_LOG_INFO("PBR scene shader compiled (Cook-Torrance BRDF).");
 
@@ -1068,64 +1283,13 @@ void OpenGLRenderer::InitSceneShader() {
 }
 
 // ============================================================================
-// GPU Skinning Shader — PBR vertex shader with bone matrix transforms
+// GPU Skinning Shader — the SKINNED permutation of the PBR program
 // ============================================================================
-static const char* s_Skinned_VertSrc =
-    "#version 330 core\n"
-    "layout(location = 0) in vec3 aPos;\n"
-    "layout(location = 1) in vec3 aNormal;\n"
-    "layout(location = 2) in vec2 aTexCoord;\n"
-    "layout(location = 3) in vec3 aTangent;\n"
-    "layout(location = 4) in vec3 aBitangent;\n"
-    "layout(location = 5) in ivec4 aBoneIDs;\n"
-    "layout(location = 6) in vec4 aBoneWeights;\n"
-    "\n"
-    "uniform mat4 u_Model;\n"
-    "uniform mat4 u_View;\n"
-    "uniform mat4 u_Proj;\n"
-    "uniform mat4 u_LightSpaceMatrix;\n"
-    "\n"
-    "#define MAX_BONES 128\n"
-    "uniform mat4 u_BoneMatrices[MAX_BONES];\n"
-    "uniform int  u_HasBones;\n"
-    "\n"
-    "out vec3 vWorldPos;\n"
-    "out vec3 vNormal;\n"
-    "out vec2 vTexCoord;\n"
-    "out vec4 vLightSpacePos;\n"
-    "out mat3 vTBN;\n"
-    "\n"
-    "void main() {\n"
-    "    mat4 skinMatrix = mat4(1.0);\n"
-    "    if (u_HasBones != 0) {\n"
-    "        skinMatrix = mat4(0.0);\n"
-    "        for (int i = 0; i < 4; ++i) {\n"
-    "            if (aBoneIDs[i] >= 0 && aBoneIDs[i] < MAX_BONES) {\n"
-    "                skinMatrix += u_BoneMatrices[aBoneIDs[i]] * aBoneWeights[i];\n"
-    "            }\n"
-    "        }\n"
-    "    }\n"
-    "    vec4 skinnedPos = skinMatrix * vec4(aPos, 1.0);\n"
-    "    vec4 worldPos = u_Model * skinnedPos;\n"
-    "    gl_Position = u_Proj * u_View * worldPos;\n"
-    "    vWorldPos = worldPos.xyz;\n"
-    "    mat3 normalMat = mat3(u_Model) * mat3(skinMatrix);\n"
-    "    vNormal = normalize(normalMat * aNormal);\n"
-    "    vTexCoord = aTexCoord;\n"
-    "    vLightSpacePos = u_LightSpaceMatrix * worldPos;\n"
-    "    vec3 T = normalize(normalMat * aTangent);\n"
-    "    vec3 B = normalize(normalMat * aBitangent);\n"
-    "    vec3 N = vNormal;\n"
-    "    vTBN = mat3(T, B, N);\n"
-    "}\n";
-
 void OpenGLRenderer::InitSkinnedShader() {
     if (!glCreateShader) return;
 
-    GLuint vs = CompileShaderStage(GL_VERTEX_SHADER, s_Skinned_VertSrc);
-    // Uses the same PBR fragment shader as the standard scene shader
-    GLuint fs = CompileShaderStage(GL_FRAGMENT_SHADER, s_PBR_FragSrc);
-    m_SkinnedShader = LinkProgram(vs, fs);
+    // Same sources as the scene shader, with bone skinning compiled in
+    m_SkinnedShader = m_Shaders.Get("pbr", { "SKINNED" });
 
     GV_LOG_INFO("Skinned PBR shader compiled (GPU bone skinning, max 128 bones).");
 }
@@ -1136,132 +1300,25 @@ void OpenGLRenderer::InitSkinnedShader() {
 void OpenGLRenderer::InitPrimitives() {
     if (!glGenVertexArrays) return;
 
-    // Vertex layout: position(3) + normal(3) + texCoord(2) + tangent(3) + bitangent(3)
-    // = 14 floats, 56 bytes per vertex
-    const int STRIDE = 14;
-
-    // ── Triangle ───────────────────────────────────────────────────────────
-    float triVerts[] = {
-        // pos                 normal              uv        tangent             bitangent
-         0.0f,  0.5f, 0.0f,   0,0,1,   0.5f,1,   1,0,0,   0,1,0,
-        -0.5f, -0.5f, 0.0f,   0,0,1,   0,0,      1,0,0,   0,1,0,
-         0.5f, -0.5f, 0.0f,   0,0,1,   1,0,      1,0,0,   0,1,0,
-    };
-
-    glGenVertexArrays(1, &m_TriVAO);
-    glGenBuffers(1, &m_TriVBO);
-    glBindVertexArray(m_TriVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_TriVBO);
-    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(sizeof(triVerts)),
-                 triVerts, GL_STATIC_DRAW);
-    for (int i = 0; i < 5; ++i) {
-        int sz = (i == 2) ? 2 : 3;
-        int off = 0;
-        if (i == 1) off = 3; else if (i == 2) off = 6; else if (i == 3) off = 8; else if (i == 4) off = 11;
-        glVertexAttribPointer(i, sz, GL_FLOAT, GL_FALSE, STRIDE * sizeof(float),
-                              reinterpret_cast<void*>(off * sizeof(float)));
-        glEnableVertexAttribArray(i);
-    }
-    glBindVertexArray(0);
-    GV_LOG_INFO("Built-in triangle primitive created.");
-
-    // ── Cube ───────────────────────────────────────────────────────────────
-    struct CubeFace { float nx,ny,nz; float tx,ty,tz; float bx,by,bz;
-                      float verts[4][3]; float uvs[4][2]; };
-    CubeFace cubeFaces[] = {
-        // front +Z
-        { 0,0,1, 1,0,0, 0,1,0,
-          {{-0.5f,-0.5f,0.5f},{0.5f,-0.5f,0.5f},{0.5f,0.5f,0.5f},{-0.5f,0.5f,0.5f}},
-          {{0,0},{1,0},{1,1},{0,1}} },
-        // back -Z
-        { 0,0,-1, -1,0,0, 0,1,0,
-          {{-0.5f,-0.5f,-0.5f},{-0.5f,0.5f,-0.5f},{0.5f,0.5f,-0.5f},{0.5f,-0.5f,-0.5f}},
-          {{1,0},{1,1},{0,1},{0,0}} },
-        // top +Y
-        { 0,1,0, 1,0,0, 0,0,-1,
-          {{-0.5f,0.5f,-0.5f},{-0.5f,0.5f,0.5f},{0.5f,0.5f,0.5f},{0.5f,0.5f,-0.5f}},
-          {{0,0},{0,1},{1,1},{1,0}} },
-        // bottom -Y
-        { 0,-1,0, 1,0,0, 0,0,1,
-          {{-0.5f,-0.5f,-0.5f},{0.5f,-0.5f,-0.5f},{0.5f,-0.5f,0.5f},{-0.5f,-0.5f,0.5f}},
-          {{0,0},{1,0},{1,1},{0,1}} },
-        // right +X
-        { 1,0,0, 0,0,-1, 0,1,0,
-          {{0.5f,-0.5f,-0.5f},{0.5f,0.5f,-0.5f},{0.5f,0.5f,0.5f},{0.5f,-0.5f,0.5f}},
-          {{0,0},{0,1},{1,1},{1,0}} },
-        // left -X
-        { -1,0,0, 0,0,1, 0,1,0,
-          {{-0.5f,-0.5f,-0.5f},{-0.5f,-0.5f,0.5f},{-0.5f,0.5f,0.5f},{-0.5f,0.5f,-0.5f}},
-          {{0,0},{1,0},{1,1},{0,1}} },
-    };
-
-    std::vector<float> cubeData;
-    std::vector<unsigned int> cubeIdx;
-    for (int f = 0; f < 6; ++f) {
-        unsigned int base = static_cast<unsigned int>(cubeData.size() / STRIDE);
-        for (int v = 0; v < 4; ++v) {
-            cubeData.insert(cubeData.end(), {cubeFaces[f].verts[v][0], cubeFaces[f].verts[v][1], cubeFaces[f].verts[v][2]});
-            cubeData.insert(cubeData.end(), {cubeFaces[f].nx, cubeFaces[f].ny, cubeFaces[f].nz});
-            cubeData.insert(cubeData.end(), {cubeFaces[f].uvs[v][0], cubeFaces[f].uvs[v][1]});
-            cubeData.insert(cubeData.end(), {cubeFaces[f].tx, cubeFaces[f].ty, cubeFaces[f].tz});
-            cubeData.insert(cubeData.end(), {cubeFaces[f].bx, cubeFaces[f].by, cubeFaces[f].bz});
-        }
-        cubeIdx.insert(cubeIdx.end(), {base, base+1, base+2, base+2, base+3, base});
-    }
-    m_CubeIndexCount = static_cast<i32>(cubeIdx.size());
-
-    glGenVertexArrays(1, &m_CubeVAO);
-    glGenBuffers(1, &m_CubeVBO);
-    glGenBuffers(1, &m_CubeEBO);
-    glBindVertexArray(m_CubeVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_CubeVBO);
-    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(cubeData.size() * sizeof(float)),
-                 cubeData.data(), GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_CubeEBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(cubeIdx.size() * sizeof(unsigned int)),
-                 cubeIdx.data(), GL_STATIC_DRAW);
-    for (int i = 0; i < 5; ++i) {
-        int sz = (i == 2) ? 2 : 3;
-        int off = 0;
-        if (i == 1) off = 3; else if (i == 2) off = 6; else if (i == 3) off = 8; else if (i == 4) off = 11;
-        glVertexAttribPointer(i, sz, GL_FLOAT, GL_FALSE, STRIDE * sizeof(float),
-                              reinterpret_cast<void*>(off * sizeof(float)));
-        glEnableVertexAttribArray(i);
-    }
-    glBindVertexArray(0);
-    GV_LOG_INFO("Built-in cube primitive created (24 verts, PBR layout).");
-
-    // ── Plane ──────────────────────────────────────────────────────────────
-    float planeVerts[] = {
-        // pos               normal   uv     tangent    bitangent
-        -0.5f,0,-0.5f,  0,1,0,  0,0,  1,0,0,  0,0,1,
-         0.5f,0,-0.5f,  0,1,0,  1,0,  1,0,0,  0,0,1,
-         0.5f,0, 0.5f,  0,1,0,  1,1,  1,0,0,  0,0,1,
-        -0.5f,0, 0.5f,  0,1,0,  0,1,  1,0,0,  0,0,1,
-    };
-    unsigned int planeIdx[] = { 0, 1, 2, 2, 3, 0 };
-    m_PlaneIndexCount = 6;
-
-    glGenVertexArrays(1, &m_PlaneVAO);
-    glGenBuffers(1, &m_PlaneVBO);
-    glGenBuffers(1, &m_PlaneEBO);
-    glBindVertexArray(m_PlaneVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_PlaneVBO);
-    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(sizeof(planeVerts)),
-                 planeVerts, GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_PlaneEBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(sizeof(planeIdx)),
-                 planeIdx, GL_STATIC_DRAW);
-    for (int i = 0; i < 5; ++i) {
-        int sz = (i == 2) ? 2 : 3;
-        int off = 0;
-        if (i == 1) off = 3; else if (i == 2) off = 6; else if (i == 3) off = 8; else if (i == 4) off = 11;
-        glVertexAttribPointer(i, sz, GL_FLOAT, GL_FALSE, STRIDE * sizeof(float),
-                              reinterpret_cast<void*>(off * sizeof(float)));
-        glEnableVertexAttribArray(i);
+    // The built-ins are ordinary Meshes (position + normal + uv + tangent +
+    // bitangent, 56 bytes per vertex).  With a registry they are its shared
+    // entries, so objects given a primitive through MeshRenderer::SetPrimitive
+    // draw from the same buffers.
+    if (m_MeshRegistry) {
+        m_TriMesh   = m_MeshRegistry->Primitive(PrimitiveType::Triangle);
+        m_CubeMesh  = m_MeshRegistry->Primitive(PrimitiveType::Cube);
+        m_PlaneMesh = m_MeshRegistry->Primitive(PrimitiveType::Plane);
+    } else {
+        m_TriMesh   = Mesh::CreateTriangle();
+        m_CubeMesh  = Mesh::CreateCube();
+        m_PlaneMesh = Mesh::CreatePlane(1.0f, 1.0f);
     }
-    glBindVertexArray(0);
-    GV_LOG_INFO("Built-in plane primitive created (PBR layout).");
+    m_TriVAO          = m_TriMesh->GetVAO();
+    m_CubeVAO         = m_CubeMesh->GetVAO();
+    m_CubeIndexCount  = static_cast<i32>(m_CubeMesh->GetIndexCount());
+    m_PlaneVAO        = m_PlaneMesh->GetVAO();
+    m_PlaneIndexCount = static_cast<i32>(m_PlaneMesh->GetIndexCount());
+    GV_LOG_INFO("Built-in triangle, cube and plane primitives created (PBR layout).");
 }
 
 // ============================================================================
@@ -1282,12 +1339,22 @@ static const char* s_ShadowFragSrc =
     "    // Depth is written automatically\n"
     "}\n";
 
+void OpenGLRenderer::RefreshShaderHandles() {
+    if (m_Shaders.Has("pbr")) {
+        if (m_HighlightShader == m_SceneShader) m_HighlightShader = m_Shaders.Get("pbr");
+        m_SceneShader   = m_Shaders.Get("pbr");
+        m_SkinnedShader = m_Shaders.Get("pbr", { "SKINNED" });
+    }
+    if (m_Shaders.Has("shadow")) m_ShadowShader = m_Shaders.Get("shadow");
+}
+
 void OpenGLRenderer::InitShadowMap() {
     if (!glGenFramebuffers) return;
 
-    GLuint vs = CompileShaderStage(GL_VERTEX_SHADER, s_ShadowVertSrc);
-    GLuint fs = CompileShaderStage(GL_FRAGMENT_SHADER, s_ShadowFragSrc);
-    m_ShadowShader = LinkProgram(vs, fs);
+    m_Shaders.RegisterSource("shadow.vert", s_ShadowVertSrc);
+    m_Shaders.RegisterSource("shadow.frag", s_ShadowFragSrc);
+    m_Shaders.Load("shadow", "shadow.vert", "shadow.frag");
+    m_ShadowShader = m_Shaders.Get("shadow");
 
     // Create depth texture
     glGenTextures(1, &m_ShadowMap);
@@ -1389,9 +1456,7 @@ void OpenGLRenderer::RenderShadowPass(Scene& scene, const Vec3& lightDir) {
 void OpenGLRenderer::CleanupShadowMap() {
     if (m_ShadowFBO)    { glDeleteFramebuffers(1, &m_ShadowFBO); m_ShadowFBO = 0; }
     if (m_ShadowMap)    { glDeleteTextures(1, &m_ShadowMap);     m_ShadowMap = 0; }
-    if (m_ShadowShader && m_ShadowShader != m_SceneShader) {
-        glDeleteProgram(m_ShadowShader); m_ShadowShader = 0;
-    }
+    m_ShadowShader = 0;   // owned by m_Shaders
 }
 
 // ============================================================================
@@ -1556,8 +1621,60 @@ static const char* s_FXAAFrag =
     "        FragColor = vec4(rgbB, 1.0);\n"
     "}\n";
 
-void OpenGLRenderer::InitPostProcessing() {
-    if (!glGenFramebuffers || !glCreateShader) return;
+// Upscale resolve: render resolution → window.  Catmull-Rom reconstruction
+// in 9 bilinear taps, plus a light unsharp mask over the source texel's
+// neighbours to win back some of the detail the lower resolution lost.
+// At 1:1 the filter reduces to a plain copy.
+static const char* s_UpscaleFrag =
+    "#version 330 core\n"
+    "in vec2 vTexCoord;\n"
+    "out vec4 FragColor;\n"
+    "uniform sampler2D u_Source;\n"
+    "uniform vec2 u_SourceSize;\n"
+    "uniform float u_Sharpness;\n"
+    "\n"
+    "vec3 CatmullRom(vec2 uv) {\n"
+    "    vec2 pos = uv * u_SourceSize;\n"
+    "    vec2 c = floor(pos - 0.5) + 0.5;\n"
+    "    vec2 f = pos - c;\n"
+    "    vec2 w0 = f * (-0.5 + f * (1.0 - 0.5 * f));\n"
+    "    vec2 w1 = 1.0 + f * f * (-2.5 + 1.5 * f);\n"
+    "    vec2 w2 = f * (0.5 + f * (2.0 - 1.5 * f));\n"
+    "    vec2 w3 = f * f * (-0.5 + 0.5 * f);\n"
+    "    vec2 w12 = w1 + w2;\n"
+    "    vec2 t0  = (c - 1.0) / u_SourceSize;\n"
+    "    vec2 t12 = (c + w2 / w12) / u_SourceSize;\n"
+    "    vec2 t3  = (c + 2.0) / u_SourceSize;\n"
+    "    vec3 r = vec3(0.0);\n"
+    "    r += texture(u_Source, vec2(t0.x,  t0.y)).rgb  * w0.x  * w0.y;\n"
+    "    r += texture(u_Source, vec2(t12.x, t0.y)).rgb  * w12.x * w0.y;\n"
+    "    r += texture(u_Source, vec2(t3.x,  t0.y)).rgb  * w3.x  * w0.y;\n"
+    "    r += texture(u_Source, vec2(t0.x,  t12.y)).rgb * w0.x  * w12.y;\n"
+    "    r += texture(u_Source, vec2(t12.x, t12.y)).rgb * w12.x * w12.y;\n"
+    "    r += texture(u_Source, vec2(t3.x,  t12.y)).rgb * w3.x  * w12.y;\n"
+    "    r += texture(u_Source, vec2(t0.x,  t3.y)).rgb  * w0.x  * w3.y;\n"
+    "    r += texture(u_Source, vec2(t12.x, t3.y)).rgb  * w12.x * w3.y;\n"
+    "    r += texture(u_Source, vec2(t3.x,  t3.y)).rgb  * w3.x  * w3.y;\n"
+    "    return r;\n"
+    "}\n"
+    "\n"
+    "void main() {\n"
+    "    vec3 color = CatmullRom(vTexCoord);\n"
+    "    if (u_Sharpness > 0.0) {\n"
+    "        vec2 ts = 1.0 / u_SourceSize;\n"
+    "        vec3 cross = texture(u_Source, vTexCoord + vec2(ts.x, 0.0)).rgb\n"
+    "                   + texture(u_Source, vTexCoord - vec2(ts.x, 0.0)).rgb\n"
+    "                   + texture(u_Source, vTexCoord + vec2(0.0, ts.y)).rgb\n"
+    "                   + texture(u_Source, vTexCoord - vec2(0.0, ts.y)).rgb;\n"
+    "        color += (color - cross * 0.25) * u_Sharpness;\n"
+    "    }\n"
+    "    FragColor = vec4(clamp(color, 0.0, 1.0), 1.0);\n"
+    "}\n";
+
+// ── Render targets (render resolution) ─────────────────────────────────────
+void OpenGLRenderer::CreatePostTargets() {
+    GLsizei w = static_cast<GLsizei>(m_RenderWidth);
+    GLsizei h = static_cast<GLsizei>(m_RenderHeight);
 
     // ── HDR framebuffer ────────────────────────────────────────────────────
     glGenFramebuffers(1, &m_HDR_FBO);
@@ -1566,9 +1683,7 @@ void OpenGLRenderer::InitPostProcessing() {
     // HDR color attachment (RGBA16F)
     glGenTextures(1, &m_HDR_ColorTex);
     glBindTexture(GL_TEXTURE_2D, m_HDR_ColorTex);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F,
-                 static_cast<GLsizei>(m_Width), static_cast<GLsizei>(m_Height),
-                 0, GL_RGBA, GL_FLOAT, nullptr);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, w, h, 0, GL_RGBA, GL_FLOAT, nullptr);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -1578,8 +1693,7 @@ void OpenGLRenderer::InitPostProcessing() {
     // Depth renderbuffer
     glGenRenderbuffers(1, &m_HDR_DepthRBO);
     glBindRenderbuffer(GL_RENDERBUFFER, m_HDR_DepthRBO);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24,
-                          static_cast<GLsizei>(m_Width), static_cast<GLsizei>(m_Height));
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, w, h);
     glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_HDR_DepthRBO);
 
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
@@ -1594,7 +1708,7 @@ void OpenGLRenderer::InitPostProcessing() {
         glBindFramebuffer(GL_FRAMEBUFFER, m_BloomFBO[i]);
         glBindTexture(GL_TEXTURE_2D, m_BloomTex[i]);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F,
-                     static_cast<GLsizei>(m_Width / 2), static_cast<GLsizei>(m_Height / 2),
+                     std::max<GLsizei>(w / 2, 1), std::max<GLsizei>(h / 2, 1),
                      0, GL_RGBA, GL_FLOAT, nullptr);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -1602,11 +1716,41 @@ void OpenGLRenderer::InitPostProcessing() {
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
         glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_BloomTex[i], 0);
     }
+
+    // ── Tone-mapped (LDR) target — input to the effect chain ───────────────
+    glGenFramebuffers(1, &m_LDR_FBO);
+    glGenTextures(1, &m_LDR_ColorTex);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_LDR_FBO);
+    glBindTexture(GL_TEXTURE_2D, m_LDR_ColorTex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_LDR_ColorTex, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        GV_LOG_ERROR("LDR FBO incomplete!");
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
 
-    // ── Compile post-processing shaders ────────────────────────────────────
-    GLuint screenVS = CompileShaderStage(GL_VERTEX_SHADER, s_ScreenQuadVert);
+void OpenGLRenderer::DestroyPostTargets() {
+    if (m_HDR_FBO)       { glDeleteFramebuffers(1, &m_HDR_FBO);       m_HDR_FBO = 0; }
+    if (m_HDR_ColorTex)  { glDeleteTextures(1, &m_HDR_ColorTex);      m_HDR_ColorTex = 0; }
+    if (m_HDR_DepthRBO)  { glDeleteRenderbuffers(1, &m_HDR_DepthRBO); m_HDR_DepthRBO = 0; }
+    for (int i = 0; i < 2; ++i) {
+        if (m_BloomFBO[i]) { glDeleteFramebuffers(1, &m_BloomFBO[i]); m_BloomFBO[i] = 0; }
+        if (m_BloomTex[i]) { glDeleteTextures(1, &m_BloomTex[i]);     m_BloomTex[i] = 0; }
+    }
+    if (m_LDR_FBO)       { glDeleteFramebuffers(1, &m_LDR_FBO);       m_LDR_FBO = 0; }
+    if (m_LDR_ColorTex)  { glDeleteTextures(1, &m_LDR_ColorTex);      m_LDR_ColorTex = 0; }
+}
+
+void OpenGLRenderer::InitPostProcessing() {
+    if (!glGenFramebuffers || !glCreateShader) return;
+
+    CreatePostTargets();
 
+    // ── Compile post-processing shaders ────────────────────────────────────
     GLuint bpFS = CompileShaderStage(GL_FRAGMENT_SHADER, s_BrightPassFrag);
     m_BrightPassShader = LinkProgram(CompileShaderStage(GL_VERTEX_SHADER, s_ScreenQuadVert), bpFS);
 
@@ -1616,35 +1760,127 @@ void OpenGLRenderer::InitPostProcessing() {
     GLuint tmFS = CompileShaderStage(GL_FRAGMENT_SHADER, s_TonemapFrag);
     m_TonemapShader = LinkProgram(CompileShaderStage(GL_VERTEX_SHADER, s_ScreenQuadVert), tmFS);
 
-    GLuint fxFS = CompileShaderStage(GL_FRAGMENT_SHADER, s_FXAAFrag);
-    m_FXAAShader = LinkProgram(CompileShaderStage(GL_VERTEX_SHADER, s_ScreenQuadVert), fxFS);
+    GLuint upFS = CompileShaderStage(GL_FRAGMENT_SHADER, s_UpscaleFrag);
+    m_UpscaleShader = LinkProgram(CompileShaderStage(GL_VERTEX_SHADER, s_ScreenQuadVert), upFS);
+
+    // ── Effect chain (tone-mapped image, render resolution) ────────────────
+    if (!m_PostChain.HasEffect("fxaa")) {
+        m_PostChain.AddEffect("fxaa", s_FXAAFrag, 100, [](const PostEffectContext& ctx) {
+            glUniform1i(glGetUniformLocation(ctx.program, "u_Screen"), 0);
+            glUniform2f(glGetUniformLocation(ctx.program, "u_InvScreenSize"),
+                        1.0f / static_cast<f32>(ctx.width), 1.0f / static_cast<f32>(ctx.height));
+        });
+    }
+    m_PostChain.SetEffectEnabled("fxaa", m_FXAAEnabled);
+    m_PostChain.Init(m_RenderWidth, m_RenderHeight);
+
+    // ── GPU frame timer ring ───────────────────────────────────────────────
+    if (glGenQueries && glBeginQuery && glEndQuery && glGetQueryObjectiv && glGetQueryObjectui64v) {
+        glGenQueries(static_cast<GLsizei>(kGpuTimerQueries), m_GpuTimers);
+    } else {
+        GV_LOG_INFO("Timer queries unavailable — dynamic resolution will use CPU frame time.");
+    }
+
+    GV_LOG_INFO("Post-processing pipeline initialised (bloom + ACES tone mapping + effect chain + upscale).");
+}
+
+// ── Dynamic resolution ─────────────────────────────────────────────────────
+void OpenGLRenderer::ResizeRenderTargets() {
+    GLint prevFBO = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFBO);
+    bool hdrBound = prevFBO != 0 && static_cast<u32>(prevFBO) == m_HDR_FBO;
 
-    (void)screenVS; // used inline above
+    if (m_HDR_FBO) {
+        DestroyPostTargets();
+        CreatePostTargets();
+    }
+    if (m_GBufferFBO) {
+        DestroyDeferredTargets();
+        CreateDeferredTargets();
+    }
+    m_PostChain.Resize(m_RenderWidth, m_RenderHeight);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, hdrBound ? m_HDR_FBO : static_cast<GLuint>(prevFBO));
+}
+
+void OpenGLRenderer::UpdateFrameTiming() {
+    f64 now = std::chrono::duration<f64, std::milli>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    if (m_LastFrameStartMs > 0.0)
+        m_CpuFrameMs = static_cast<f32>(now - m_LastFrameStartMs);
+    m_LastFrameStartMs = now;
+
+    // The ring slot about to be reused was issued kGpuTimerQueries frames
+    // ago and has normally finished, so reading it doesn't stall.
+    bool haveTimers = m_GpuTimers[0] != 0;
+    f32 gpuSample = 0.0f;
+    if (haveTimers && m_GpuTimerFrame >= kGpuTimerQueries) {
+        GLuint query = m_GpuTimers[m_GpuTimerFrame % kGpuTimerQueries];
+        GLint available = 0;
+        glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available) {
+            GLuint64 ns = 0;
+            glGetQueryObjectui64v(query, GL_QUERY_RESULT, &ns);
+            gpuSample = static_cast<f32>(static_cast<f64>(ns) * 1e-6);
+            m_GpuFrameMs = gpuSample;
+        }
+    }
 
-    GV_LOG_INFO("Post-processing pipeline initialised (bloom + ACES tone mapping + FXAA).");
+    if (m_DynResEnabled) {
+        // With timers, only fresh GPU samples drive the governor; mixing in
+        // CPU intervals would mean mixing two different measures.
+        if (!haveTimers)          m_DynRes.Update(m_CpuFrameMs, 0.0f);
+        else if (gpuSample > 0.0f) m_DynRes.Update(m_CpuFrameMs, gpuSample);
+    }
 }
 
 void OpenGLRenderer::BeginHDRPass() {
+    // Follow the window size (the framebuffer callback only sets the default
+    // viewport), then let the governor pick this frame's scale.
+    if (m_Window && m_Window->GetWidth() && m_Window->GetHeight() &&
+        (m_Window->GetWidth() != m_Width || m_Window->GetHeight() != m_Height)) {
+        m_Width  = m_Window->GetWidth();
+        m_Height = m_Window->GetHeight();
+    }
+    UpdateFrameTiming();
+    ApplyRenderScale();
+
     if (!m_HDR_FBO) return;
+    if (m_GpuTimerActive) {
+        // Last frame skipped RenderPostProcessing; close its query.
+        glEndQuery(GL_TIME_ELAPSED);
+        m_GpuTimerActive = false;
+        ++m_GpuTimerFrame;
+    }
+    if (m_GpuTimers[0]) {
+        glBeginQuery(GL_TIME_ELAPSED, m_GpuTimers[m_GpuTimerFrame % kGpuTimerQueries]);
+        m_GpuTimerActive = true;
+    }
     glBindFramebuffer(GL_FRAMEBUFFER, m_HDR_FBO);
+    glViewport(0, 0, static_cast<GLsizei>(m_RenderWidth), static_cast<GLsizei>(m_RenderHeight));
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
 void OpenGLRenderer::EndHDRPass() {
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, static_cast<GLsizei>(m_Width), static_cast<GLsizei>(m_Height));
 }
 
 void OpenGLRenderer::RenderPostProcessing() {
-    if (!m_ScreenQuadVAO || !m_TonemapShader) return;
+    if (!m_ScreenQuadVAO || !m_TonemapShader || !m_UpscaleShader) {
+        if (m_GpuTimerActive) { glEndQuery(GL_TIME_ELAPSED); m_GpuTimerActive = false; ++m_GpuTimerFrame; }
+        return;
+    }
 
     glDisable(GL_DEPTH_TEST);
 
-    GLuint finalTex = m_HDR_ColorTex;
+    GLsizei rw = static_cast<GLsizei>(m_RenderWidth);
+    GLsizei rh = static_cast<GLsizei>(m_RenderHeight);
 
     // ── Bloom pass ─────────────────────────────────────────────────────────
     if (m_BloomEnabled && m_BrightPassShader && m_BlurShader) {
         // 1. Extract bright pixels
-        glViewport(0, 0, static_cast<GLsizei>(m_Width/2), static_cast<GLsizei>(m_Height/2));
+        glViewport(0, 0, std::max<GLsizei>(rw / 2, 1), std::max<GLsizei>(rh / 2, 1));
         glBindFramebuffer(GL_FRAMEBUFFER, m_BloomFBO[0]);
         glClear(GL_COLOR_BUFFER_BIT);
         glUseProgram(m_BrightPassShader);
@@ -1668,13 +1904,13 @@ void OpenGLRenderer::RenderPostProcessing() {
             horizontal = !horizontal;
         }
         glBindVertexArray(0);
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-        glViewport(0, 0, static_cast<GLsizei>(m_Width), static_cast<GLsizei>(m_Height));
     }
 
-    // ── Tone mapping pass ──────────────────────────────────────────────────
-    if (m_ToneMappingEnabled) {
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    // ── Tone mapping pass (→ LDR target, render resolution) ────────────────
+    GLuint ldrTex = m_HDR_ColorTex;
+    if (m_ToneMappingEnabled && m_LDR_FBO) {
+        glBindFramebuffer(GL_FRAMEBUFFER, m_LDR_FBO);
+        glViewport(0, 0, rw, rh);
         glClear(GL_COLOR_BUFFER_BIT);
         glUseProgram(m_TonemapShader);
         glActiveTexture(GL_TEXTURE0);
@@ -1693,29 +1929,51 @@ void OpenGLRenderer::RenderPostProcessing() {
         glBindVertexArray(m_ScreenQuadVAO);
         glDrawArrays(GL_TRIANGLES, 0, 6);
         glBindVertexArray(0);
+        ldrTex = m_LDR_ColorTex;
     }
 
-    // ── FXAA pass ──────────────────────────────────────────────────────────
-    // Note: FXAA requires an additional FBO to read from. For simplicity,
-    // we skip it when not explicitly enabled (it would need another intermediate texture).
-    // The shader is ready for use when an additional FBO is set up.
+    // ── Effect chain (FXAA + user effects) ─────────────────────────────────
+    m_PostChain.SetEffectEnabled("fxaa", m_FXAAEnabled);
+    GLuint finalTex = m_PostChain.Apply(ldrTex);
+
+    // ── Upscale resolve (→ window) ─────────────────────────────────────────
+    bool scaled = m_RenderWidth != m_Width || m_RenderHeight != m_Height;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, static_cast<GLsizei>(m_Width), static_cast<GLsizei>(m_Height));
+    glClear(GL_COLOR_BUFFER_BIT);
+    glUseProgram(m_UpscaleShader);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, finalTex);
+    glUniform1i(glGetUniformLocation(m_UpscaleShader, "u_Source"), 0);
+    glUniform2f(glGetUniformLocation(m_UpscaleShader, "u_SourceSize"),
+                static_cast<f32>(rw), static_cast<f32>(rh));
+    glUniform1f(glGetUniformLocation(m_UpscaleShader, "u_Sharpness"), scaled ? m_UpscaleSharpness : 0.0f);
+    glBindVertexArray(m_ScreenQuadVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    glBindVertexArray(0);
+
+    if (m_GpuTimerActive) {
+        glEndQuery(GL_TIME_ELAPSED);
+        m_GpuTimerActive = false;
+        ++m_GpuTimerFrame;
+    }
 
     glEnable(GL_DEPTH_TEST);
     glUseProgram(0);
 }
 
 void OpenGLRenderer::CleanupPostProcessing() {
-    if (m_HDR_FBO)       { glDeleteFramebuffers(1, &m_HDR_FBO);       m_HDR_FBO = 0; }
-    if (m_HDR_ColorTex)  { glDeleteTextures(1, &m_HDR_ColorTex);      m_HDR_ColorTex = 0; }
-    if (m_HDR_DepthRBO)  { glDeleteRenderbuffers(1, &m_HDR_DepthRBO); m_HDR_DepthRBO = 0; }
-    for (int i = 0; i < 2; ++i) {
-        if (m_BloomFBO[i]) { glDeleteFramebuffers(1, &m_BloomFBO[i]); m_BloomFBO[i] = 0; }
-        if (m_BloomTex[i]) { glDeleteTextures(1, &m_BloomTex[i]);     m_BloomTex[i] = 0; }
+    DestroyPostTargets();
+    m_PostChain.Shutdown();
+    if (m_GpuTimers[0] && glDeleteQueries) {
+        if (m_GpuTimerActive) { glEndQuery(GL_TIME_ELAPSED); m_GpuTimerActive = false; }
+        glDeleteQueries(static_cast<GLsizei>(kGpuTimerQueries), m_GpuTimers);
+        for (u32& q : m_GpuTimers) q = 0;
     }
     if (m_BrightPassShader) { glDeleteProgram(m_BrightPassShader); m_BrightPassShader = 0; }
     if (m_BlurShader)       { glDeleteProgram(m_BlurShader);       m_BlurShader = 0; }
     if (m_TonemapShader)    { glDeleteProgram(m_TonemapShader);    m_TonemapShader = 0; }
-    if (m_FXAAShader)       { glDeleteProgram(m_FXAAShader);       m_FXAAShader = 0; }
+    if (m_UpscaleShader)    { glDeleteProgram(m_UpscaleShader);    m_UpscaleShader = 0; }
     if (m_ScreenQuadVAO)    { glDeleteVertexArrays(1, &m_ScreenQuadVAO); m_ScreenQuadVAO = 0; }
     if (m_ScreenQuadVBO)    { glDeleteBuffers(1, &m_ScreenQuadVBO);      m_ScreenQuadVBO = 0; }
 }
@@ -1745,8 +2003,18 @@ static const char* s_GeoPass_FragSrc =
     "uniform sampler2D u_NormalMap;\n"
     "uniform int u_HasAlbedoMap;\n"
     "uniform int u_HasNormalMap;\n"
+    "uniform float u_DitherFade;\n"
+    "\n"
+    "// Same ordered dither as the forward shader.\n"
+    "float DitherThreshold() {\n"
+    "    const float b[16] = float[16](0.0, 8.0, 2.0, 10.0, 12.0, 4.0, 14.0, 6.0,\n"
+    "                                  3.0, 11.0, 1.0, 9.0, 15.0, 7.0, 13.0, 5.0);\n"
+    "    ivec2 p = ivec2(gl_FragCoord.xy) & 3;\n"
+    "    return (b[p.y * 4 + p.x] + 0.5) / 16.0;\n"
+    "}\n"
     "\n"
     "void main() {\n"
+    "    if (u_DitherFade > 0.0 && DitherThreshold() < u_DitherFade) discard;\n"
     "    vec3 albedo = u_Color.rgb;\n"
     "    if (u_HasAlbedoMap != 0) albedo *= texture(u_AlbedoMap, vTexCoord).rgb;\n"
     "    vec3 N = normalize(vNormal);\n"
@@ -1921,12 +2189,10 @@ static const char* s_SSAOBlur_FragSrc =
     "    FragColor = r / 25.0;\n"
     "}\n";
 
-// ── InitDeferredPipeline ───────────────────────────────────────────────────
-void OpenGLRenderer::InitDeferredPipeline() {
-    if (!glGenFramebuffers || !glCreateShader || !glDrawBuffers) return;
-
-    GLsizei w = static_cast<GLsizei>(m_Width);
-    GLsizei h = static_cast<GLsizei>(m_Height);
+// ── G-buffer + SSAO targets (render resolution) ───────────────────────────
+void OpenGLRenderer::CreateDeferredTargets() {
+    GLsizei w = static_cast<GLsizei>(m_RenderWidth);
+    GLsizei h = static_cast<GLsizei>(m_RenderHeight);
 
     // ── G-Buffer FBO ───────────────────────────────────────────────────────
     glGenFramebuffers(1, &m_GBufferFBO);
@@ -1995,6 +2261,25 @@ void OpenGLRenderer::InitDeferredPipeline() {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_SSAO_BlurTex, 0);
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void OpenGLRenderer::DestroyDeferredTargets() {
+    if (m_GBufferFBO)          { glDeleteFramebuffers(1, &m_GBufferFBO);        m_GBufferFBO = 0; }
+    if (m_GBufPosTex)          { glDeleteTextures(1, &m_GBufPosTex);            m_GBufPosTex = 0; }
+    if (m_GBufNormTex)         { glDeleteTextures(1, &m_GBufNormTex);           m_GBufNormTex = 0; }
+    if (m_GBufAlbTex)          { glDeleteTextures(1, &m_GBufAlbTex);            m_GBufAlbTex = 0; }
+    if (m_GBufDepthRBO)        { glDeleteRenderbuffers(1, &m_GBufDepthRBO);     m_GBufDepthRBO = 0; }
+    if (m_SSAO_FBO)            { glDeleteFramebuffers(1, &m_SSAO_FBO);          m_SSAO_FBO = 0; }
+    if (m_SSAO_Tex)            { glDeleteTextures(1, &m_SSAO_Tex);              m_SSAO_Tex = 0; }
+    if (m_SSAO_BlurFBO)        { glDeleteFramebuffers(1, &m_SSAO_BlurFBO);      m_SSAO_BlurFBO = 0; }
+    if (m_SSAO_BlurTex)        { glDeleteTextures(1, &m_SSAO_BlurTex);          m_SSAO_BlurTex = 0; }
+}
+
+// ── InitDeferredPipeline ───────────────────────────────────────────────────
+void OpenGLRenderer::InitDeferredPipeline() {
+    if (!glGenFramebuffers || !glCreateShader || !glDrawBuffers) return;
+
+    CreateDeferredTargets();
 
     // ── SSAO noise texture (4x4 random rotations) ──────────────────────────
     float ssaoNoise[48];
@@ -2054,22 +2339,342 @@ void OpenGLRenderer::InitDeferredPipeline() {
 }
 
 void OpenGLRenderer::CleanupDeferred() {
-    if (m_GBufferFBO)          { glDeleteFramebuffers(1, &m_GBufferFBO);        m_GBufferFBO = 0; }
-    if (m_GBufPosTex)          { glDeleteTextures(1, &m_GBufPosTex);            m_GBufPosTex = 0; }
-    if (m_GBufNormTex)         { glDeleteTextures(1, &m_GBufNormTex);           m_GBufNormTex = 0; }
-    if (m_GBufAlbTex)          { glDeleteTextures(1, &m_GBufAlbTex);            m_GBufAlbTex = 0; }
-    if (m_GBufDepthRBO)        { glDeleteRenderbuffers(1, &m_GBufDepthRBO);     m_GBufDepthRBO = 0; }
+    DestroyDeferredTargets();
     if (m_GeoPassShader)       { glDeleteProgram(m_GeoPassShader);              m_GeoPassShader = 0; }
     if (m_DeferredLightShader) { glDeleteProgram(m_DeferredLightShader);         m_DeferredLightShader = 0; }
-    if (m_SSAO_FBO)            { glDeleteFramebuffers(1, &m_SSAO_FBO);          m_SSAO_FBO = 0; }
-    if (m_SSAO_Tex)            { glDeleteTextures(1, &m_SSAO_Tex);              m_SSAO_Tex = 0; }
-    if (m_SSAO_BlurFBO)        { glDeleteFramebuffers(1, &m_SSAO_BlurFBO);      m_SSAO_BlurFBO = 0; }
-    if (m_SSAO_BlurTex)        { glDeleteTextures(1, &m_SSAO_BlurTex);          m_SSAO_BlurTex = 0; }
     if (m_SSAO_NoiseTex)       { glDeleteTextures(1, &m_SSAO_NoiseTex);         m_SSAO_NoiseTex = 0; }
     if (m_SSAOShader)          { glDeleteProgram(m_SSAOShader);                  m_SSAOShader = 0; }
     if (m_SSAOBlurShader)      { glDeleteProgram(m_SSAOBlurShader);              m_SSAOBlurShader = 0; }
 }
 
+// ============================================================================
+// Impostors
+// ============================================================================
+
+// ── Billboard: a quad in the atlas basis over the bounding sphere ──────────
+static const char* s_Impostor_VertSrc =
+    "#version 330 core\n"
+    "layout(location = 0) in vec2 aPos;\n"
+    "layout(location = 1) in vec2 aTexCoord;\n"
+    "uniform mat4 u_Model;\n"
+    "uniform mat4 u_ViewProj;\n"
+    "uniform vec3 u_Center;\n"
+    "uniform float u_Radius;\n"
+    "uniform vec3 u_Right;   // mesh space\n"
+    "uniform vec3 u_Up;\n"
+    "out vec2 vCellUV;\n"
+    "out vec3 vWorldPos;\n"
+    "void main() {\n"
+    "    vec3 p = u_Center + (u_Right * aPos.x + u_Up * aPos.y) * u_Radius;\n"
+    "    vec4 wp = u_Model * vec4(p, 1.0);\n"
+    "    vWorldPos = wp.xyz;\n"
+    "    vCellUV = aTexCoord;\n"
+    "    gl_Position = u_ViewProj * wp;\n"
+    "}\n";
+
+// Blends the four nearest views, relights with the baked normals and moves
+// the depth from the billboard plane onto the baked surface.
+static const char* s_Impostor_FragSrc =
+    "#version 330 core\n"
+    "in vec2 vCellUV;\n"
+    "in vec3 vWorldPos;\n"
+    "out vec4 FragColor;\n"
+    "uniform sampler2D u_AlbedoAtlas;\n"
+    "uniform sampler2D u_NormalAtlas;\n"
+    "uniform sampler2D u_DepthAtlas;\n"
+    "uniform vec2  u_Frame[4];      // cell origins, atlas UV\n"
+    "uniform vec4  u_FrameWeight;\n"
+    "uniform float u_CellScale;     // 1 / framesPerSide\n"
+    "uniform float u_CellInset;     // half a texel, cell UV\n"
+    "uniform mat4  u_Model;\n"
+    "uniform mat4  u_ViewProj;\n"
+    "uniform vec3  u_ToViewer;      // world space, radius long\n"
+    "uniform float u_DitherFade;\n"
+    "uniform int   u_LightingEnabled;\n"
+    "uniform vec3  u_LightDir;\n"
+    "uniform vec3  u_LightColor;\n"
+    "uniform vec3  u_AmbientColor;\n"
+    "float DitherThreshold() {\n"
+    "    const float b[16] = float[16](0.0, 8.0, 2.0, 10.0, 12.0, 4.0, 14.0, 6.0,\n"
+    "                                  3.0, 11.0, 1.0, 9.0, 15.0, 7.0, 13.0, 5.0);\n"
+    "    ivec2 p = ivec2(gl_FragCoord.xy) & 3;\n"
+    "    return (b[p.y * 4 + p.x] + 0.5) / 16.0;\n"
+    "}\n"
+    "void main() {\n"
+    "    if (DitherThreshold() >= u_DitherFade) discard;\n"
+    "    vec2 uv = clamp(vCellUV, vec2(u_CellInset), vec2(1.0 - u_CellInset)) * u_CellScale;\n"
+    "    vec4 albedo = vec4(0.0);\n"
+    "    vec3 n = vec3(0.0);\n"
+    "    float depth = 0.0;\n"
+    "    for (int i = 0; i < 4; ++i) {\n"
+    "        vec2 t = u_Frame[i] + uv;\n"
+    "        albedo += texture(u_AlbedoAtlas, t) * u_FrameWeight[i];\n"
+    "        n      += (texture(u_NormalAtlas, t).xyz * 2.0 - 1.0) * u_FrameWeight[i];\n"
+    "        depth  += texture(u_DepthAtlas, t).r * u_FrameWeight[i];\n"
+    "    }\n"
+    "    if (albedo.a < 0.5) discard;\n"
+    "    vec3 color = albedo.rgb;\n"
+    "    if (u_LightingEnabled != 0) {\n"
+    "        vec3 N = normalize(mat3(u_Model) * n);\n"
+    "        float NdotL = max(dot(N, normalize(u_LightDir)), 0.0);\n"
+    "        color = albedo.rgb * (u_AmbientColor + u_LightColor * NdotL / 3.14159265);\n"
+    "    }\n"
+    "    vec4 clip = u_ViewProj * vec4(vWorldPos + u_ToViewer * (1.0 - 2.0 * depth), 1.0);\n"
+    "    gl_FragDepth = clip.z / clip.w * 0.5 + 0.5;\n"
+    "    FragColor = vec4(color, 1.0);\n"
+    "}\n";
+
+// ── Baker: orthographic view of the bounding sphere into three targets ─────
+static const char* s_ImpostorBake_VertSrc =
+    "#version 330 core\n"
+    "layout(location = 0) in vec3 aPos;\n"
+    "layout(location = 1) in vec3 aNormal;\n"
+    "layout(location = 2) in vec2 aTexCoord;\n"
+    "uniform vec3 u_Center;\n"
+    "uniform float u_InvRadius;\n"
+    "uniform vec3 u_Right;\n"
+    "uniform vec3 u_Up;\n"
+    "uniform vec3 u_Dir;\n"
+    "out vec3 vNormal;\n"
+    "out vec2 vTexCoord;\n"
+    "out float vDepth;\n"
+    "void main() {\n"
+    "    vec3 q = (aPos - u_Center) * u_InvRadius;\n"
+    "    vNormal = aNormal;\n"
+    "    vTexCoord = aTexCoord;\n"
+    "    vDepth = 0.5 - 0.5 * dot(q, u_Dir);\n"
+    "    gl_Position = vec4(dot(q, u_Right), dot(q, u_Up), -dot(q, u_Dir), 1.0);\n"
+    "}\n";
+
+static const char* s_ImpostorBake_FragSrc =
+    "#version 330 core\n"
+    "in vec3 vNormal;\n"
+    "in vec2 vTexCoord;\n"
+    "in float vDepth;\n"
+    "layout(location = 0) out vec4 oAlbedo;\n"
+    "layout(location = 1) out vec4 oNormal;\n"
+    "layout(location = 2) out vec4 oDepth;\n"
+    "uniform vec4 u_Color;\n"
+    "uniform sampler2D u_AlbedoMap;\n"
+    "uniform int u_HasAlbedoMap;\n"
+    "uniform vec3 u_Dir;\n"
+    "void main() {\n"
+    "    vec4 a = u_Color;\n"
+    "    if (u_HasAlbedoMap != 0) a *= texture(u_AlbedoMap, vTexCoord);\n"
+    "    vec3 n = normalize(vNormal);\n"
+    "    if (dot(n, u_Dir) < 0.0) n = -n;   // back faces seen through gaps\n"
+    "    oAlbedo = a;\n"
+    "    oNormal = vec4(n * 0.5 + 0.5, 1.0);\n"
+    "    oDepth  = vec4(vDepth, 0.0, 0.0, 1.0);\n"
+    "}\n";
+
+void OpenGLRenderer::InitImpostorShaders() {
+    if (!glCreateShader) return;
+    GLuint vs = CompileShaderStage(GL_VERTEX_SHADER, s_Impostor_VertSrc);
+    GLuint fs = CompileShaderStage(GL_FRAGMENT_SHADER, s_Impostor_FragSrc);
+    m_ImpostorShader = LinkProgram(vs, fs);
+
+    if (glGenFramebuffers && glDrawBuffers) {
+        GLuint bvs = CompileShaderStage(GL_VERTEX_SHADER, s_ImpostorBake_VertSrc);
+        GLuint bfs = CompileShaderStage(GL_FRAGMENT_SHADER, s_ImpostorBake_FragSrc);
+        m_ImpostorBakeShader = LinkProgram(bvs, bfs);
+    }
+}
+
+void OpenGLRenderer::CleanupImpostors() {
+    if (m_ImpostorShader)     { glDeleteProgram(m_ImpostorShader);     m_ImpostorShader = 0; }
+    if (m_ImpostorBakeShader) { glDeleteProgram(m_ImpostorBakeShader); m_ImpostorBakeShader = 0; }
+    m_ImpostorQueue.clear();
+}
+
+f32 OpenGLRenderer::QueueImpostor(const MeshRenderer& mr, const Mat4& model, const Vec3& objPos, const Vec3& eye) {
+    if (!m_ImpostorShader || !m_ScreenQuadVAO) return 0.0f;
+    f32 fade = mr.GetImpostorBlend((objPos - eye).Length());
+    if (fade <= 0.0f) return 0.0f;
+    const ImpostorAtlas* atlas = mr.GetImpostor().get();
+    if (atlas->Empty() || !atlas->albedoTexture) return 0.0f;
+    m_ImpostorQueue.push_back({ atlas, model, fade });
+    return fade;
+}
+
+void OpenGLRenderer::RenderImpostors(const Mat4& view, const Mat4& proj, const Vec3& eye, const Vec3& lightDir,
+                                     const Vec3& lightColor, const Vec3& ambientColor) {
+    if (m_ImpostorQueue.empty()) return;
+    Mat4 viewProj = proj * view;
+    GLuint sh = m_ImpostorShader;
+    glUseProgram(sh);
+    glUniformMatrix4fv(glGetUniformLocation(sh, "u_ViewProj"), 1, GL_FALSE, viewProj.m);
+    glUniform1i(glGetUniformLocation(sh, "u_AlbedoAtlas"), 0);
+    glUniform1i(glGetUniformLocation(sh, "u_NormalAtlas"), 1);
+    glUniform1i(glGetUniformLocation(sh, "u_DepthAtlas"), 2);
+    glUniform1i(glGetUniformLocation(sh, "u_LightingEnabled"), m_LightingEnabled ? 1 : 0);
+    glUniform3f(glGetUniformLocation(sh, "u_LightDir"), lightDir.x, lightDir.y, lightDir.z);
+    glUniform3f(glGetUniformLocation(sh, "u_LightColor"), lightColor.x, lightColor.y, lightColor.z);
+    glUniform3f(glGetUniformLocation(sh, "u_AmbientColor"), ambientColor.x, ambientColor.y, ambientColor.z);
+
+    GLint locModel   = glGetUniformLocation(sh, "u_Model");
+    GLint locCenter  = glGetUniformLocation(sh, "u_Center");
+    GLint locRadius  = glGetUniformLocation(sh, "u_Radius");
+    GLint locRight   = glGetUniformLocation(sh, "u_Right");
+    GLint locUp      = glGetUniformLocation(sh, "u_Up");
+    GLint locWeight  = glGetUniformLocation(sh, "u_FrameWeight");
+    GLint locScale   = glGetUniformLocation(sh, "u_CellScale");
+    GLint locInset   = glGetUniformLocation(sh, "u_CellInset");
+    GLint locViewer  = glGetUniformLocation(sh, "u_ToViewer");
+    GLint locFade    = glGetUniformLocation(sh, "u_DitherFade");
+    GLint locFrame[4];
+    for (int i = 0; i < 4; ++i)
+        locFrame[i] = glGetUniformLocation(sh, ("u_Frame[" + std::to_string(i) + "]").c_str());
+
+    glBindVertexArray(m_ScreenQuadVAO);
+    for (const auto& d : m_ImpostorQueue) {
+        const ImpostorAtlas& a = *d.atlas;
+        // View direction in mesh space picks the frames and the billboard axes.
+        Vec3 dir = (d.model.Inverse().TransformPoint(eye) - a.center).Normalized();
+        if (dir.Dot(dir) < 0.5f) dir = Vec3(0, 0, 1);
+        Vec3 right, up;
+        ImpostorBasis(dir, right, up);
+        ImpostorFrameBlend blend = ImpostorFramesForDirection(a.settings, dir);
+        Vec3 toViewer = d.model.TransformDir(dir * a.radius);
+        f32 cellScale = 1.0f / static_cast<f32>(a.settings.framesPerSide);
+
+        glUniformMatrix4fv(locModel, 1, GL_FALSE, d.model.m);
+        glUniform3f(locCenter, a.center.x, a.center.y, a.center.z);
+        glUniform1f(locRadius, a.radius);
+        glUniform3f(locRight, right.x, right.y, right.z);
+        glUniform3f(locUp, up.x, up.y, up.z);
+        glUniform3f(locViewer, toViewer.x, toViewer.y, toViewer.z);
+        glUniform1f(locScale, cellScale);
+        glUniform1f(locInset, 0.5f / static_cast<f32>(a.settings.frameSize));
+        glUniform1f(locFade, d.fade);
+        glUniform4f(locWeight, blend.weight[0], blend.weight[1], blend.weight[2], blend.weight[3]);
+        for (int i = 0; i < 4; ++i)
+            glUniform2f(locFrame[i], static_cast<f32>(blend.x[i]) * cellScale, static_cast<f32>(blend.y[i]) * cellScale);
+
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, a.albedoTexture);
+        glActiveTexture(GL_TEXTURE0 + 1);
+        glBindTexture(GL_TEXTURE_2D, a.normalTexture);
+        glActiveTexture(GL_TEXTURE0 + 2);
+        glBindTexture(GL_TEXTURE_2D, a.depthTexture);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+    }
+    glBindVertexArray(0);
+    glActiveTexture(GL_TEXTURE0);
+    glUseProgram(0);
+}
+
+bool OpenGLRenderer::BakeImpostorGPU(const ImpostorSource& source, ImpostorAtlas& out) {
+    const ImpostorSettings& settings = out.settings;
+    const u32 ss = std::max(settings.supersample, 1u);
+    const u32 cell = settings.frameSize * ss;
+    const GLsizei size = static_cast<GLsizei>(out.width * ss);
+    if (size > 8192) return false;
+
+    GLint prevFBO = 0;
+    GLint prevViewport[4] = { 0, 0, 0, 0 };
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFBO);
+    glGetIntegerv(GL_VIEWPORT_ENUM, prevViewport);
+
+    GLuint fbo = 0, rbo = 0, targets[3] = { 0, 0, 0 };
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glGenTextures(3, targets);
+    for (int i = 0; i < 3; ++i) {
+        glBindTexture(GL_TEXTURE_2D, targets[i]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, targets[i], 0);
+    }
+    GLenum drawBufs[] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2 };
+    glDrawBuffers(3, drawBufs);
+    glGenRenderbuffers(1, &rbo);
+    glBindRenderbuffer(GL_RENDERBUFFER, rbo);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size, size);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, rbo);
+
+    bool ok = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    std::vector<u8> albedo, normal, depth;
+    if (ok) {
+        // Optional albedo image, sampled like the CPU baker (nearest, wrapped).
+        GLuint albedoTex = 0;
+        if (source.albedoPixels && source.albedoWidth && source.albedoHeight) {
+            glGenTextures(1, &albedoTex);
+            glBindTexture(GL_TEXTURE_2D, albedoTex);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, static_cast<GLsizei>(source.albedoWidth),
+                         static_cast<GLsizei>(source.albedoHeight), 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                         source.albedoPixels);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        }
+
+        bool blend = glIsEnabled(GL_BLEND), cull = glIsEnabled(GL_CULL_FACE);
+        glDisable(GL_BLEND);
+        glDisable(GL_CULL_FACE);
+        glEnable(GL_DEPTH_TEST);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        GLuint sh = m_ImpostorBakeShader;
+        glUseProgram(sh);
+        glUniform3f(glGetUniformLocation(sh, "u_Center"), out.center.x, out.center.y, out.center.z);
+        glUniform1f(glGetUniformLocation(sh, "u_InvRadius"), 1.0f / out.radius);
+        glUniform4f(glGetUniformLocation(sh, "u_Color"), source.color.x, source.color.y, source.color.z, source.color.w);
+        glUniform1i(glGetUniformLocation(sh, "u_HasAlbedoMap"), albedoTex ? 1 : 0);
+        glUniform1i(glGetUniformLocation(sh, "u_AlbedoMap"), 0);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, albedoTex);
+        GLint locRight = glGetUniformLocation(sh, "u_Right");
+        GLint locUp    = glGetUniformLocation(sh, "u_Up");
+        GLint locDir   = glGetUniformLocation(sh, "u_Dir");
+
+        source.mesh->Bind();
+        for (u32 cy = 0; cy < settings.framesPerSide; ++cy) {
+            for (u32 cx = 0; cx < settings.framesPerSide; ++cx) {
+                Vec3 dir = ImpostorFrameDirection(settings, cx, cy);
+                Vec3 right, up;
+                ImpostorBasis(dir, right, up);
+                glUniform3f(locRight, right.x, right.y, right.z);
+                glUniform3f(locUp, up.x, up.y, up.z);
+                glUniform3f(locDir, dir.x, dir.y, dir.z);
+                glViewport(static_cast<GLint>(cx * cell), static_cast<GLint>(cy * cell),
+                           static_cast<GLsizei>(cell), static_cast<GLsizei>(cell));
+                glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(source.mesh->GetIndexCount()),
+                               GL_UNSIGNED_INT, nullptr);
+            }
+        }
+        source.mesh->Unbind();
+        glUseProgram(0);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        if (albedoTex) glDeleteTextures(1, &albedoTex);
+        if (blend) glEnable(GL_BLEND);
+        if (cull) glEnable(GL_CULL_FACE);
+
+        // Read back and resolve on the CPU, same as the software path.
+        size_t bytes = static_cast<size_t>(size) * static_cast<size_t>(size) * 4;
+        std::vector<u8>* images[3] = { &albedo, &normal, &depth };
+        for (int i = 0; i < 3; ++i) {
+            images[i]->resize(bytes);
+            glReadBuffer(GL_COLOR_ATTACHMENT0 + i);
+            glReadPixels(0, 0, size, size, GL_RGBA, GL_UNSIGNED_BYTE, images[i]->data());
+        }
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(prevFBO));
+    glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
+    glDeleteRenderbuffers(1, &rbo);
+    glDeleteTextures(3, targets);
+    glDeleteFramebuffers(1, &fbo);
+    if (!ok) return false;
+
+    ResolveImpostorSamples(out, albedo.data(), normal.data(), depth.data(), ss);
+    DilateImpostorAtlas(out);
+    return true;
+}
+
 // ============================================================================
 // Sprite / 2D Rendering
 // ============================================================================
@@ -2283,18 +2888,12 @@ void OpenGLRenderer::FlushDebugDraw(Camera& camera) {
 // ============================================================================
 
 void OpenGLRenderer::CleanupScene() {
-    if (m_TriVAO)      { glDeleteVertexArrays(1, &m_TriVAO);   m_TriVAO = 0; }
-    if (m_TriVBO)      { glDeleteBuffers(1, &m_TriVBO);         m_TriVBO = 0; }
-    if (m_CubeVAO)     { glDeleteVertexArrays(1, &m_CubeVAO);  m_CubeVAO = 0; }
-    if (m_CubeVBO)     { glDeleteBuffers(1, &m_CubeVBO);        m_CubeVBO = 0; }
-    if (m_CubeEBO)     { glDeleteBuffers(1, &m_CubeEBO);        m_CubeEBO = 0; }
-    if (m_PlaneVAO)    { glDeleteVertexArrays(1, &m_PlaneVAO); m_PlaneVAO = 0; }
-    if (m_PlaneVBO)    { glDeleteBuffers(1, &m_PlaneVBO);       m_PlaneVBO = 0; }
-    if (m_PlaneEBO)    { glDeleteBuffers(1, &m_PlaneEBO);       m_PlaneEBO = 0; }
-    if (m_SceneShader) { glDeleteProgram(m_SceneShader);        m_SceneShader = 0; }
-    if (m_SkinnedShader && m_SkinnedShader != m_SceneShader) {
-        glDeleteProgram(m_SkinnedShader); m_SkinnedShader = 0;
-    }
+    m_TriMesh.reset();                    // buffers go with the last reference
+    m_CubeMesh.reset();
+    m_PlaneMesh.reset();
+    m_TriVAO = m_CubeVAO = m_PlaneVAO = 0;
+    m_SceneShader = 0;     // scene / skinned programs are owned by m_Shaders
+    m_SkinnedShader = 0;
     if (m_SkyShader)   { glDeleteProgram(m_SkyShader);          m_SkyShader = 0; }
     if (m_SkyVAO)      { glDeleteVertexArrays(1, &m_SkyVAO);   m_SkyVAO = 0; }
     if (m_SkyVBO)      { glDeleteBuffers(1, &m_SkyVBO);         m_SkyVBO = 0; }
@@ -2303,9 +2902,7 @@ void OpenGLRenderer::CleanupScene() {
     if (m_LineVBO)     { glDeleteBuffers(1, &m_LineVBO);         m_LineVBO = 0; }
     if (m_GridVAO)     { glDeleteVertexArrays(1, &m_GridVAO);   m_GridVAO = 0; }
     if (m_GridVBO)     { glDeleteBuffers(1, &m_GridVBO);         m_GridVBO = 0; }
-    if (m_HighlightShader && m_HighlightShader != m_SceneShader) {
-        glDeleteProgram(m_HighlightShader); m_HighlightShader = 0;
-    }
+    m_HighlightShader = 0;  // aliases the scene shader
 }
 
 // ── Skybox ─────────────────────────────────────────────────────────────────
@@ -0,0 +1,610 @@
+// ============================================================================
+// GameVoid Engine — Shader Library Implementation
+// ============================================================================
+#include "renderer/ShaderLibrary.h"
+
+#ifdef GV_HAS_GLFW
+#include "core/GLDefs.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace gv {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::string Trim(const std::string& s) {
+    size_t b = s.find_first_not_of(" \t\r\n");
+    if (b == std::string::npos) return "";
+    size_t e = s.find_last_not_of(" \t\r\n");
+    return s.substr(b, e - b + 1);
+}
+
+std::string Normalise(const std::string& path) {
+    return fs::path(path).lexically_normal().generic_string();
+}
+
+std::string ParentDir(const std::string& path) {
+    return fs::path(path).parent_path().generic_string();
+}
+
+bool ReadFile(const std::string& path, std::string& out) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f.is_open()) return false;
+    std::ostringstream ss;
+    ss << f.rdbuf();
+    out = ss.str();
+    return true;
+}
+
+/// Last-write stamp, or -1 if the file does not exist.
+i64 FileStamp(const std::string& path) {
+    std::error_code ec;
+    auto t = fs::last_write_time(path, ec);
+    if (ec) return -1;
+    return static_cast<i64>(t.time_since_epoch().count());
+}
+
+/// If `line` is a preprocessor directive, return the text after '#'.
+bool Directive(const std::string& line, std::string& rest) {
+    size_t i = line.find_first_not_of(" \t");
+    if (i == std::string::npos || line[i] != '#') return false;
+    rest = Trim(line.substr(i + 1));
+    return true;
+}
+
+bool StartsWithWord(const std::string& s, const char* word) {
+    size_t n = std::strlen(word);
+    if (s.compare(0, n, word) != 0) return false;
+    return s.size() == n || s[n] == ' ' || s[n] == '\t' || s[n] == '"' || s[n] == '<';
+}
+
+/// Track /* */ state across a line (ignores comment markers after //).
+bool UpdateBlockComment(const std::string& line, bool inBlock) {
+    for (size_t i = 0; i + 1 < line.size(); ++i) {
+        if (inBlock) {
+            if (line[i] == '*' && line[i + 1] == '/') { inBlock = false; ++i; }
+        } else {
+            if (line[i] == '/' && line[i + 1] == '/') break;
+            if (line[i] == '/' && line[i + 1] == '*') { inBlock = true; ++i; }
+        }
+    }
+    return inBlock;
+}
+
+f64 NowSeconds() {
+    using namespace std::chrono;
+    return duration<f64>(steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+// ============================================================================
+// ShaderPermutation
+// ============================================================================
+std::vector<std::string> ShaderPermutation::Canonical(std::vector<std::string> defines) {
+    for (auto& d : defines) d = Trim(d);
+    defines.erase(std::remove(defines.begin(), defines.end(), std::string()), defines.end());
+    std::sort(defines.begin(), defines.end());
+    defines.erase(std::unique(defines.begin(), defines.end()), defines.end());
+    return defines;
+}
+
+std::string ShaderPermutation::ToString(const std::vector<std::string>& canonical) {
+    std::string s;
+    for (size_t i = 0; i < canonical.size(); ++i) {
+        if (i) s += ';';
+        s += canonical[i];
+    }
+    return s;
+}
+
+// ============================================================================
+// ShaderPreprocessor
+// ============================================================================
+void ShaderPreprocessor::AddSearchPath(const std::string& dir) {
+    if (std::find(m_SearchPaths.begin(), m_SearchPaths.end(), dir) == m_SearchPaths.end())
+        m_SearchPaths.push_back(dir);
+}
+
+void ShaderPreprocessor::RegisterSource(const std::string& name, const std::string& text) {
+    m_Virtual[Normalise(name)] = text;
+}
+
+bool ShaderPreprocessor::ReadSource(const std::string& name, const std::string& from,
+                                    std::string& text, std::string& resolved, bool& onDisk) const {
+    std::vector<std::string> candidates;
+    if (!from.empty()) candidates.push_back(Normalise((fs::path(ParentDir(from)) / name).generic_string()));
+    for (auto& dir : m_SearchPaths)
+        candidates.push_back(Normalise((fs::path(dir) / name).generic_string()));
+    candidates.push_back(Normalise(name));
+
+    for (auto& c : candidates) {
+        std::error_code ec;
+        if (fs::is_regular_file(c, ec) && ReadFile(c, text)) {
+            resolved = c;
+            onDisk = true;
+            return true;
+        }
+    }
+    // In-memory sources: relative to the includer first, then by name.
+    for (auto& c : { from.empty() ? std::string() : candidates.front(), Normalise(name) }) {
+        if (c.empty()) continue;
+        auto it = m_Virtual.find(c);
+        if (it != m_Virtual.end()) {
+            text = it->second;
+            resolved = c;
+            onDisk = false;
+            return true;
+        }
+    }
+    return false;
+}
+
+PreprocessedShader ShaderPreprocessor::Process(const std::string& path,
+                                               const std::vector<std::string>& defines) const {
+    Context ctx;
+    std::string text, resolved;
+    bool onDisk = false;
+    if (!ReadSource(path, "", text, resolved, onDisk)) {
+        ctx.out.error = path + ": source not found";
+        return ctx.out;
+    }
+    ctx.out.files.push_back(resolved);
+
+    // GLSL requires #version first, so the permutation defines go right
+    // after it.  Everything before it can only be comments / blank lines.
+    std::string prologue;
+    std::string body = text;
+    u32 firstLine = 1;
+    {
+        std::istringstream in(text);
+        std::string line, rest;
+        u32 lineNo = 0;
+        size_t offset = 0;
+        bool inBlock = false;
+        while (std::getline(in, line)) {
+            ++lineNo;
+            size_t next = offset + line.size() + 1;
+            if (!inBlock && Directive(line, rest) && StartsWithWord(rest, "version")) {
+                prologue = text.substr(0, std::min(next, text.size()));
+                if (prologue.empty() || prologue.back() != '\n') prologue += '\n';
+                body = next < text.size() ? text.substr(next) : std::string();
+                firstLine = lineNo + 1;
+                break;
+            }
+            inBlock = UpdateBlockComment(line, inBlock);
+            offset = next;
+        }
+    }
+
+    std::string& src = ctx.out.source;
+    src = prologue;
+    for (auto& d : ShaderPermutation::Canonical(defines)) {
+        size_t eq = d.find('=');
+        if (eq == std::string::npos) src += "#define " + d + " 1\n";
+        else src += "#define " + Trim(d.substr(0, eq)) + " " + Trim(d.substr(eq + 1)) + "\n";
+    }
+    src += "#line " + std::to_string(prologue.empty() ? 1u : firstLine) + " 0\n";
+
+    ctx.rootLineBase = prologue.empty() ? 0 : firstLine - 1;
+    ctx.stack.push_back(resolved);
+    if (!Expand(body, resolved, 0, ctx)) {
+        ctx.out.source.clear();
+        return ctx.out;
+    }
+    ctx.out.ok = true;
+    ctx.out.hash = Hash(ctx.out.source);
+    return ctx.out;
+}
+
+bool ShaderPreprocessor::Expand(const std::string& text, const std::string& file, u32 depth,
+                                Context& ctx) const {
+    auto& out = ctx.out;
+    u32 fileIndex = static_cast<u32>(
+        std::find(out.files.begin(), out.files.end(), file) - out.files.begin());
+
+    std::istringstream in(text);
+    std::string line, rest;
+    u32 lineNo = depth == 0 ? ctx.rootLineBase : 0;
+    bool inBlock = false;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        bool directive = !inBlock && Directive(line, rest);
+        inBlock = UpdateBlockComment(line, inBlock);
+        if (!directive) { out.source += line; out.source += '\n'; continue; }
+
+        if (StartsWithWord(rest, "pragma") && Trim(rest.substr(6)) == "once") {
+            if (std::find(ctx.once.begin(), ctx.once.end(), file) == ctx.once.end())
+                ctx.once.push_back(file);
+            out.source += '\n';
+            continue;
+        }
+        if (StartsWithWord(rest, "version")) {
+            // Only legal at the top of the root file.
+            out.source += '\n';
+            continue;
+        }
+        if (!StartsWithWord(rest, "include")) { out.source += line; out.source += '\n'; continue; }
+
+        std::string spec = Trim(rest.substr(7));
+        std::string where = file + ":" + std::to_string(lineNo) + ": ";
+        if (spec.size() < 2 || !((spec.front() == '"' && spec.back() == '"') ||
+                                 (spec.front() == '<' && spec.back() == '>'))) {
+            out.error = where + "malformed #include";
+            return false;
+        }
+        std::string name = spec.substr(1, spec.size() - 2);
+
+        std::string incText, incPath;
+        bool onDisk = false;
+        if (!ReadSource(name, spec.front() == '"' ? file : "", incText, incPath, onDisk)) {
+            out.error = where + "cannot find include '" + name + "'";
+            return false;
+        }
+        if (std::find(ctx.stack.begin(), ctx.stack.end(), incPath) != ctx.stack.end()) {
+            out.error = where + "recursive include of '" + incPath + "'";
+            return false;
+        }
+        if (depth + 1 >= kMaxIncludeDepth) {
+            out.error = where + "include depth exceeds " + std::to_string(kMaxIncludeDepth);
+            return false;
+        }
+        if (std::find(ctx.once.begin(), ctx.once.end(), incPath) != ctx.once.end()) {
+            out.source += '\n';
+            continue;
+        }
+
+        auto idx = std::find(out.files.begin(), out.files.end(), incPath) - out.files.begin();
+        if (static_cast<size_t>(idx) == out.files.size()) out.files.push_back(incPath);
+
+        out.source += "#line 1 " + std::to_string(idx) + "\n";
+        ctx.stack.push_back(incPath);
+        bool ok = Expand(incText, incPath, depth + 1, ctx);
+        ctx.stack.pop_back();
+        if (!ok) return false;
+        out.source += "#line " + std::to_string(lineNo + 1) + " " + std::to_string(fileIndex) + "\n";
+    }
+    return true;
+}
+
+u64 ShaderPreprocessor::Hash(const void* data, size_t size, u64 seed) {
+    const u8* p = static_cast<const u8*>(data);
+    u64 h = seed;
+    for (size_t i = 0; i < size; ++i) {
+        h ^= p[i];
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+u64 ShaderPreprocessor::Hash(const std::string& data, u64 seed) {
+    return Hash(data.data(), data.size(), seed);
+}
+
+// ============================================================================
+// ShaderLibrary
+// ============================================================================
+u64 ShaderLibrary::VariantKey(const std::string& name, const std::vector<std::string>& canonical) {
+    u64 h = ShaderPreprocessor::Hash(name);
+    return ShaderPreprocessor::Hash("|" + ShaderPermutation::ToString(canonical), h);
+}
+
+bool ShaderLibrary::Load(const std::string& name, const std::string& vertPath,
+                         const std::string& fragPath) {
+    for (auto it = m_Variants.begin(); it != m_Variants.end();) {
+        if (it->second.name == name) {
+#ifdef GV_HAS_GLFW
+            if (it->second.program && glDeleteProgram) glDeleteProgram(it->second.program);
+#endif
+            it = m_Variants.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    m_Programs[name] = { vertPath, fragPath };
+
+    std::string text, resolved;
+    bool onDisk = false;
+    bool found = m_Pre.ReadSource(vertPath, "", text, resolved, onDisk) &&
+                 m_Pre.ReadSource(fragPath, "", text, resolved, onDisk);
+    if (!found) GV_LOG_WARN("ShaderLibrary — '" + name + "': source not found yet (" +
+                            vertPath + ", " + fragPath + ").");
+    return found;
+}
+
+bool ShaderLibrary::Preprocess(const std::string& name, const std::vector<std::string>& defines,
+                               PreprocessedShader& vert, PreprocessedShader& frag) const {
+    auto it = m_Programs.find(name);
+    if (it == m_Programs.end()) {
+        vert = {};
+        vert.error = "unknown shader '" + name + "'";
+        return false;
+    }
+    vert = m_Pre.Process(it->second.vertPath, defines);
+    frag = m_Pre.Process(it->second.fragPath, defines);
+    return vert.ok && frag.ok;
+}
+
+u32 ShaderLibrary::Get(const std::string& name, const std::vector<std::string>& defines) {
+    auto canonical = ShaderPermutation::Canonical(defines);
+    u64 key = VariantKey(name, canonical);
+    auto it = m_Variants.find(key);
+    if (it != m_Variants.end()) return it->second.program;
+
+    if (!m_Programs.count(name)) {
+        GV_LOG_WARN("ShaderLibrary — unknown shader '" + name + "'.");
+        return 0;
+    }
+    Variant& v = m_Variants[key];
+    v.name = name;
+    v.defines = canonical;
+    Build(v, true);
+    return v.program;
+}
+
+bool ShaderLibrary::Build(Variant& v, bool useCache) {
+    std::string label = v.name + (v.defines.empty() ? "" : " [" + ShaderPermutation::ToString(v.defines) + "]");
+
+    PreprocessedShader vert, frag;
+    bool ok = Preprocess(v.name, v.defines, vert, frag);
+
+    // Watch every file we pulled from disk, plus the search-path locations
+    // that would shadow an in-memory source, so dropping an override file
+    // into place also triggers a reload.
+    v.watched.clear();
+    for (auto* pre : { &vert, &frag }) {
+        for (auto& f : pre->files) {
+            std::error_code ec;
+            if (fs::is_regular_file(f, ec)) {
+                v.watched.push_back(f);
+            } else {
+                for (auto& dir : m_Pre.GetSearchPaths())
+                    v.watched.push_back(Normalise((fs::path(dir) / f).generic_string()));
+            }
+        }
+    }
+    for (auto& f : v.watched)
+        if (!m_FileTimes.count(f)) m_FileTimes[f] = FileStamp(f);
+
+    if (!ok) {
+        ++m_Stats.failures;
+        GV_LOG_ERROR("ShaderLibrary — '" + label + "': " + (vert.ok ? frag.error : vert.error));
+        return false;
+    }
+    u64 hash = ShaderPreprocessor::Hash(frag.source, ShaderPreprocessor::Hash(vert.source, DriverHash()));
+
+#ifdef GV_HAS_GLFW
+    if (!glCreateShader) return false;
+    if (v.program && hash == v.sourceHash) return true;   // touched but unchanged
+
+    u32 program = useCache ? LoadBinary(hash) : 0;
+    if (program) {
+        ++m_Stats.binaryHits;
+    } else {
+        auto compile = [&](GLenum type, const PreprocessedShader& pre, const char* stage) -> GLuint {
+            GLuint sh = glCreateShader(type);
+            const char* src = pre.source.c_str();
+            glShaderSource(sh, 1, &src, nullptr);
+            glCompileShader(sh);
+            GLint status = 0;
+            glGetShaderiv(sh, GL_COMPILE_STATUS, &status);
+            if (status) return sh;
+            char buf[2048];
+            glGetShaderInfoLog(sh, sizeof(buf), nullptr, buf);
+            std::string files;
+            for (size_t i = 0; i < pre.files.size(); ++i)
+                files += (i ? ", " : "") + std::to_string(i) + "=" + pre.files[i];
+            GV_LOG_ERROR("ShaderLibrary — '" + label + "' " + stage + " stage: " +
+                         std::string(buf) + " (sources: " + files + ")");
+            glDeleteShader(sh);
+            return 0;
+        };
+        GLuint vs = compile(GL_VERTEX_SHADER, vert, "vertex");
+        GLuint fs = vs ? compile(GL_FRAGMENT_SHADER, frag, "fragment") : 0;
+        if (!vs || !fs) {
+            if (vs) glDeleteShader(vs);
+            ++m_Stats.failures;
+            return false;
+        }
+        program = glCreateProgram();
+        if (glProgramParameteri && !m_CacheDir.empty())
+            glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        glAttachShader(program, vs);
+        glAttachShader(program, fs);
+        glLinkProgram(program);
+        glDeleteShader(vs);
+        glDeleteShader(fs);
+        GLint linked = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (!linked) {
+            char buf[2048];
+            glGetProgramInfoLog(program, sizeof(buf), nullptr, buf);
+            GV_LOG_ERROR("ShaderLibrary — '" + label + "' link: " + std::string(buf));
+            glDeleteProgram(program);
+            ++m_Stats.failures;
+            return false;
+        }
+        ++m_Stats.compiled;
+        SaveBinary(hash, program);
+    }
+
+    if (v.program) glDeleteProgram(v.program);
+    v.program = program;
+    v.sourceHash = hash;
+    return true;
+#else
+    (void)useCache;
+    v.sourceHash = hash;
+    return false;
+#endif
+}
+
+u32 ShaderLibrary::PollChanges() {
+    f64 now = NowSeconds();
+    if (now - m_LastPoll < static_cast<f64>(m_WatchInterval)) return 0;
+    m_LastPoll = now;
+
+    std::vector<std::string> changed;
+    for (auto& kv : m_FileTimes) {
+        i64 stamp = FileStamp(kv.first);
+        if (stamp != kv.second) {
+            kv.second = stamp;
+            changed.push_back(kv.first);
+        }
+    }
+    if (changed.empty()) return 0;
+
+    u32 replaced = 0;
+    for (auto& kv : m_Variants) {
+        Variant& v = kv.second;
+        bool depends = std::any_of(v.watched.begin(), v.watched.end(), [&](const std::string& f) {
+            return std::find(changed.begin(), changed.end(), f) != changed.end();
+        });
+        if (!depends) continue;
+        u32 before = v.program;
+        if (Build(v, false) && v.program != before) ++replaced;
+    }
+    if (replaced) {
+        m_Stats.reloads += replaced;
+        GV_LOG_INFO("ShaderLibrary — hot-reloaded " + std::to_string(replaced) + " program(s).");
+    }
+    return replaced;
+}
+
+void ShaderLibrary::ReloadAll() {
+    u32 n = 0;
+    for (auto& kv : m_Variants) {
+        kv.second.sourceHash = 0;   // force a rebuild even if the text is unchanged
+        if (Build(kv.second, false)) ++n;
+    }
+    m_Stats.reloads += n;
+    GV_LOG_INFO("ShaderLibrary — reloaded " + std::to_string(n) + " of " +
+                std::to_string(m_Variants.size()) + " program(s).");
+}
+
+void ShaderLibrary::Clear() {
+#ifdef GV_HAS_GLFW
+    for (auto& kv : m_Variants)
+        if (kv.second.program && glDeleteProgram) glDeleteProgram(kv.second.program);
+#endif
+    m_Variants.clear();
+    m_FileTimes.clear();
+}
+
+// ── Program-binary cache ───────────────────────────────────────────────────
+// File layout: "GVPB" | u32 version | u32 binaryFormat | u32 length | u64 hash | blob
+namespace {
+constexpr char kBinaryMagic[4] = { 'G', 'V', 'P', 'B' };
+constexpr u32  kBinaryVersion  = 1;
+}
+
+std::string ShaderLibrary::BinaryPath(u64 hash) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.gvpb", static_cast<unsigned long long>(hash));
+    return (fs::path(m_CacheDir) / name).generic_string();
+}
+
+u64 ShaderLibrary::DriverHash() {
+    if (m_DriverHash) return m_DriverHash;
+    std::string id = "gv-shader-v1";
+#ifdef GV_HAS_GLFW
+    for (GLenum e : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+        const char* s = reinterpret_cast<const char*>(glGetString(e));
+        id += '|';
+        if (s) id += s;
+    }
+#endif
+    m_DriverHash = ShaderPreprocessor::Hash(id);
+    return m_DriverHash;
+}
+
+u32 ShaderLibrary::LoadBinary(u64 hash) const {
+#ifdef GV_HAS_GLFW
+    if (m_CacheDir.empty() || !glProgramBinary) return 0;
+    std::string path = BinaryPath(hash);
+    std::ifstream f(path, std::ios::binary);
+    if (!f.is_open()) return 0;
+
+    char magic[4];
+    u32 version = 0, format = 0, length = 0;
+    u64 stored = 0;
+    f.read(magic, 4);
+    f.read(reinterpret_cast<char*>(&version), sizeof(version));
+    f.read(reinterpret_cast<char*>(&format), sizeof(format));
+    f.read(reinterpret_cast<char*>(&length), sizeof(length));
+    f.read(reinterpret_cast<char*>(&stored), sizeof(stored));
+    if (!f || std::memcmp(magic, kBinaryMagic, 4) != 0 || version != kBinaryVersion ||
+        stored != hash || length == 0)
+        return 0;
+    std::vector<char> blob(length);
+    f.read(blob.data(), length);
+    if (!f) return 0;
+    f.close();
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, format, blob.data(), static_cast<GLsizei>(length));
+    GLint linked = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        // Driver update or corrupt file — drop it and compile from source.
+        glDeleteProgram(program);
+        std::error_code ec;
+        fs::remove(path, ec);
+        return 0;
+    }
+    return program;
+#else
+    (void)hash;
+    return 0;
+#endif
+}
+
+void ShaderLibrary::SaveBinary(u64 hash, u32 program) {
+#ifdef GV_HAS_GLFW
+    if (m_CacheDir.empty() || !glGetProgramBinary) return;
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if (formats <= 0) return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+    std::vector<char> blob(static_cast<size_t>(length));
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &format, blob.data());
+    if (written <= 0) return;
+
+    std::error_code ec;
+    fs::create_directories(m_CacheDir, ec);
+    std::string path = BinaryPath(hash);
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+        if (!f.is_open()) return;
+        u32 fmt = format, len = static_cast<u32>(written);
+        f.write(kBinaryMagic, 4);
+        f.write(reinterpret_cast<const char*>(&kBinaryVersion), sizeof(kBinaryVersion));
+        f.write(reinterpret_cast<const char*>(&fmt), sizeof(fmt));
+        f.write(reinterpret_cast<const char*>(&len), sizeof(len));
+        f.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+        f.write(blob.data(), written);
+        if (!f) return;
+    }
+    fs::rename(tmp, path, ec);
+    if (!ec) ++m_Stats.binaryWrites;
+#else
+    (void)hash; (void)program;
+#endif
+}
+
+} // namespace gv
@@ -0,0 +1,826 @@
+// ============================================================================
+// GameVoid Engine — GVScript Remote Debugger Implementation
+// ============================================================================
+#include "scripting/ScriptDebugger.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace gv {
+
+// ============================================================================
+// Sockets
+// ============================================================================
+namespace {
+
+constexpr const char* kDefaultAddress = "4711";
+
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;    // a vanished peer is an error, not SIGPIPE
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+#ifdef _WIN32
+using Socket = SOCKET;
+bool NetStartup() {
+    static const bool ok = [] { WSADATA data; return WSAStartup(MAKEWORD(2, 2), &data) == 0; }();
+    return ok;
+}
+void CloseSocket(intptr_t s) { closesocket(static_cast<SOCKET>(s)); }
+bool WouldBlock() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+void SetNonBlocking(intptr_t s) {
+    u_long on = 1;
+    ioctlsocket(static_cast<SOCKET>(s), FIONBIO, &on);
+}
+#else
+using Socket = int;
+bool NetStartup() { return true; }
+void CloseSocket(intptr_t s) { close(static_cast<int>(s)); }
+bool WouldBlock() { return errno == EAGAIN || errno == EWOULDBLOCK; }
+void SetNonBlocking(intptr_t s) {
+    int fd = static_cast<int>(s);
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+#endif
+
+/// Wait until `s` can be read (or written); a negative timeout waits forever.
+bool WaitFor(intptr_t s, f64 timeoutMs, bool write = false) {
+    fd_set set;
+    FD_ZERO(&set);
+    FD_SET(static_cast<Socket>(s), &set);
+    timeval tv{};
+    if (timeoutMs >= 0) {
+        tv.tv_sec  = static_cast<long>(timeoutMs / 1000.0);
+        tv.tv_usec = static_cast<long>((timeoutMs - tv.tv_sec * 1000.0) * 1000.0);
+    }
+    int n = select(static_cast<int>(s) + 1, write ? nullptr : &set, write ? &set : nullptr, nullptr,
+                   timeoutMs >= 0 ? &tv : nullptr);
+    return n > 0;
+}
+
+bool SendAll(intptr_t s, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        auto n = send(static_cast<Socket>(s), data.data() + sent,
+                      static_cast<int>(data.size() - sent), kSendFlags);
+        if (n > 0) { sent += static_cast<size_t>(n); continue; }
+        if (n < 0 && WouldBlock() && WaitFor(s, 1000.0, true)) continue;
+        return false;
+    }
+    return true;
+}
+
+/// Append whatever has arrived.  False once the peer has gone.
+bool Receive(intptr_t s, std::string& buffer) {
+    char chunk[4096];
+    for (;;) {
+        auto n = recv(static_cast<Socket>(s), chunk, sizeof(chunk), 0);
+        if (n > 0) { buffer.append(chunk, static_cast<size_t>(n)); continue; }
+        return n < 0 && WouldBlock();
+    }
+}
+
+bool TakeLine(std::string& buffer, std::string& line) {
+    size_t nl = buffer.find('\n');
+    if (nl == std::string::npos) return false;
+    line = buffer.substr(0, nl);
+    buffer.erase(0, nl + 1);
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    return true;
+}
+
+struct Address {
+    bool        local = false;      // Unix socket
+    std::string path;
+    u16         port = 0;
+};
+
+bool ParseAddress(const std::string& text, Address& out, std::string& error) {
+    if (text.rfind("unix:", 0) == 0) {
+#ifdef _WIN32
+        error = "Unix sockets are not available on this platform";
+        return false;
+#else
+        out.local = true;
+        out.path = text.substr(5);
+        if (out.path.empty() || out.path.size() >= sizeof(sockaddr_un::sun_path)) {
+            error = "bad socket path '" + out.path + "'";
+            return false;
+        }
+        return true;
+#endif
+    }
+    size_t colon = text.rfind(':');
+    std::string host = colon == std::string::npos ? "" : text.substr(0, colon);
+    std::string port = colon == std::string::npos ? text : text.substr(colon + 1);
+    if (!host.empty() && host != "localhost" && host != "127.0.0.1") {
+        error = "the debugger only listens on loopback (got '" + host + "')";
+        return false;
+    }
+    if (port.empty() || port.size() > 5 || port.find_first_not_of("0123456789") != std::string::npos ||
+        std::stoul(port) > 65535) {
+        error = "bad port '" + port + "'";
+        return false;
+    }
+    out.port = static_cast<u16>(std::stoul(port));
+    return true;
+}
+
+/// A listening (or, with `connect`, connected) socket for `address`.
+intptr_t OpenSocket(const Address& address, bool connectTo, u16& port, std::string& error) {
+    if (!NetStartup()) { error = "socket startup failed"; return -1; }
+#ifndef _WIN32
+    if (address.local) {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) { error = "cannot create socket"; return -1; }
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::copy(address.path.begin(), address.path.end(), addr.sun_path);
+        if (connectTo) {
+            if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+                error = "cannot connect to " + address.path;
+                close(fd);
+                return -1;
+            }
+            return fd;
+        }
+        // A stale socket from a previous run blocks bind; anything else
+        // at that path is left alone.
+        struct stat st;
+        if (stat(address.path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) unlink(address.path.c_str());
+        if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(fd, 1) != 0) {
+            error = "cannot listen on " + address.path;
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+#endif
+    auto s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    intptr_t fd = static_cast<intptr_t>(s);
+    if (fd < 0) { error = "cannot create socket"; return -1; }
+    int on = 1;
+    setsockopt(s, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&on), sizeof(on));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(address.port);
+    if (connectTo) {
+        if (connect(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            error = "cannot connect to 127.0.0.1:" + std::to_string(address.port);
+            CloseSocket(fd);
+            return -1;
+        }
+        return fd;
+    }
+    setsockopt(s, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&on), sizeof(on));
+    if (bind(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(s, 1) != 0) {
+        error = "cannot listen on 127.0.0.1:" + std::to_string(address.port);
+        CloseSocket(fd);
+        return -1;
+    }
+    socklen_t len = sizeof(addr);
+    getsockname(s, reinterpret_cast<sockaddr*>(&addr), &len);
+    port = ntohs(addr.sin_port);
+    return fd;
+}
+
+std::string FunctionName(const VMFunction* fn) {
+    return fn->name ? std::string(fn->name->View()) : std::string("<chunk>");
+}
+
+std::string ChunkName(const VMFunction* fn) {
+    return fn->chunk ? std::string(fn->chunk->View()) : std::string("script");
+}
+
+i32 LineAt(const VMFunction* fn, u32 pc) {
+    if (fn->lines.empty()) return 0;
+    return pc < fn->lines.size() ? fn->lines[pc] : fn->lines.back();
+}
+
+/// `chunk` is `name`, or ends with it after a path separator.
+bool ChunkMatches(std::string_view chunk, std::string_view name) {
+    if (chunk == name) return true;
+    if (chunk.size() <= name.size() || chunk.substr(chunk.size() - name.size()) != name) return false;
+    char sep = chunk[chunk.size() - name.size() - 1];
+    return sep == '/' || sep == '\\';
+}
+
+std::string Trim(const std::string& s) {
+    size_t b = s.find_first_not_of(" \t");
+    size_t e = s.find_last_not_of(" \t");
+    return b == std::string::npos ? std::string() : s.substr(b, e - b + 1);
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Server — connection
+// ============================================================================
+ScriptDebugger::ScriptDebugger(ScriptVM& vm) : m_VM(vm) {}
+
+ScriptDebugger::~ScriptDebugger() {
+    Close();
+}
+
+bool ScriptDebugger::Listen(const std::string& address) {
+    Close();
+    Address addr;
+    if (!ParseAddress(address, addr, m_LastError)) {
+        GV_LOG_ERROR("ScriptDebugger — " + m_LastError);
+        return false;
+    }
+    m_Listen = OpenSocket(addr, false, m_Port, m_LastError);
+    if (m_Listen < 0) {
+        GV_LOG_ERROR("ScriptDebugger — " + m_LastError);
+        return false;
+    }
+    SetNonBlocking(m_Listen);
+    if (addr.local) m_UnixPath = addr.path;
+    m_VM.AddHook(this);
+    UpdateStepInterval();
+    GV_LOG_INFO("ScriptDebugger — listening on " +
+                (addr.local ? m_UnixPath : "127.0.0.1:" + std::to_string(m_Port)));
+    return true;
+}
+
+void ScriptDebugger::Close() {
+    if (m_Listen < 0) return;
+    Disconnect();
+    CloseSocket(m_Listen);
+    m_Listen = -1;
+    m_Port = 0;
+#ifndef _WIN32
+    if (!m_UnixPath.empty()) unlink(m_UnixPath.c_str());
+#endif
+    m_UnixPath.clear();
+    m_VM.RemoveHook(this);
+}
+
+void ScriptDebugger::Accept() {
+    for (;;) {
+        auto s = accept(static_cast<Socket>(m_Listen), nullptr, nullptr);
+        intptr_t fd = static_cast<intptr_t>(s);
+        if (fd < 0) return;
+        if (m_Client >= 0) {
+            SendAll(fd, "err another client is attached\n");
+            CloseSocket(fd);
+            continue;
+        }
+        int on = 1;
+        setsockopt(s, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&on), sizeof(on));
+        SetNonBlocking(fd);
+        m_Client = fd;
+        GV_LOG_INFO("ScriptDebugger — client attached.");
+        Send("event hello gvscript-debug 1");
+        UpdateStepInterval();
+    }
+}
+
+void ScriptDebugger::Disconnect() {
+    if (m_Client < 0) return;
+    CloseSocket(m_Client);
+    m_Client = -1;
+    m_InBuffer.clear();
+    m_StepMode = StepMode::None;
+    m_PauseRequested = false;
+    m_StopAtNextStep = false;
+    UpdateStepInterval();
+    GV_LOG_INFO("ScriptDebugger — client detached.");
+}
+
+void ScriptDebugger::Send(const std::string& line) {
+    if (m_Client >= 0 && !SendAll(m_Client, line + "\n")) Disconnect();
+}
+
+void ScriptDebugger::SendEvent(const std::string& kind, const std::string& text) {
+    if (m_Client < 0) return;
+    std::istringstream lines(text);
+    std::string line;
+    while (std::getline(lines, line)) Send("event " + kind + " " + line);
+}
+
+bool ScriptDebugger::NextCommand(std::string& line) {
+    if (TakeLine(m_InBuffer, line)) return true;
+    if (!Receive(m_Client, m_InBuffer)) { Disconnect(); return false; }
+    return TakeLine(m_InBuffer, line);
+}
+
+void ScriptDebugger::Poll() {
+    if (m_Listen < 0) return;
+    Accept();
+    std::string line;
+    while (m_Client >= 0 && NextCommand(line)) Execute(line);
+}
+
+// ============================================================================
+// Server — breakpoints and stepping
+// ============================================================================
+u32 ScriptDebugger::AddBreakpoint(const std::string& chunk, i32 line) {
+    Breakpoint bp;
+    bp.id = m_NextBreakpoint++;
+    bp.chunk = chunk;
+    bp.line = line;
+    m_Breakpoints.push_back(bp);
+    m_BreakLines.insert(line);
+    UpdateStepInterval();
+    return bp.id;
+}
+
+bool ScriptDebugger::RemoveBreakpoint(u32 id) {
+    auto it = std::find_if(m_Breakpoints.begin(), m_Breakpoints.end(),
+                           [id](const Breakpoint& bp) { return bp.id == id; });
+    if (it == m_Breakpoints.end()) return false;
+    m_Breakpoints.erase(it);
+    m_BreakLines.clear();
+    for (const auto& bp : m_Breakpoints) m_BreakLines.insert(bp.line);
+    UpdateStepInterval();
+    return true;
+}
+
+void ScriptDebugger::RequestPause() {
+    m_PauseRequested = true;
+    UpdateStepInterval();
+}
+
+void ScriptDebugger::UpdateStepInterval() {
+    if (m_Listen < 0) return;
+    // Every instruction while something could stop; no steps otherwise.
+    bool armed = m_Client >= 0 && (!m_Breakpoints.empty() || m_PauseRequested ||
+                                   m_StepMode != StepMode::None || m_StopAtNextStep);
+    m_VM.SetStepInterval(this, armed ? 1 : 0);
+}
+
+bool ScriptDebugger::MatchesBreakpoint(const VMFunction* fn, i32 line) const {
+    std::string_view chunk = fn->chunk ? fn->chunk->View() : std::string_view("script");
+    for (const auto& bp : m_Breakpoints)
+        if (bp.line == line && ChunkMatches(chunk, bp.chunk)) return true;
+    return false;
+}
+
+ScriptDebugger::Position ScriptDebugger::PositionOf(const VMFiber& fiber) const {
+    Position p;
+    p.fiber = &fiber;
+    p.depth = fiber.frames.size();
+    if (fiber.frames.empty()) return p;
+    const VMCallFrame& frame = fiber.frames.back();
+    p.function = frame.closure->function;
+    p.line = LineAt(p.function, frame.pc);
+    return p;
+}
+
+void ScriptDebugger::OnEnter(ScriptVM&, const VMFiber&) {
+    m_Last = {};        // the first line of a new run is always new
+}
+
+void ScriptDebugger::OnCall(ScriptVM&, const VMFiber&) {
+    m_Last = {};
+}
+
+void ScriptDebugger::OnReturn(ScriptVM&, const VMFiber& fiber) {
+    // The caller carries on mid-line: not a new line.
+    m_Last = PositionOf(fiber);
+    if (m_StepMode != StepMode::None && &fiber == m_StepFrom.fiber && fiber.frames.size() < m_StepFrom.depth) {
+        m_StopAtNextStep = true;
+        UpdateStepInterval();
+    }
+}
+
+void ScriptDebugger::OnStep(ScriptVM&, const VMFiber& fiber) {
+    if (m_Client < 0 || fiber.frames.empty()) return;
+    if (m_PauseRequested) { Stop(fiber, "pause"); return; }
+    if (m_StopAtNextStep) { Stop(fiber, "step"); return; }
+
+    Position here = PositionOf(fiber);
+    bool newLine = here.fiber != m_Last.fiber || here.depth != m_Last.depth ||
+                   here.function != m_Last.function || here.line != m_Last.line;
+    m_Last = here;
+    if (!newLine) return;
+
+    if (m_StepMode == StepMode::Into ||
+        (m_StepMode == StepMode::Over && here.fiber == m_StepFrom.fiber && here.depth <= m_StepFrom.depth)) {
+        Stop(fiber, "step");
+        return;
+    }
+    if (m_BreakLines.count(here.line) && MatchesBreakpoint(here.function, here.line))
+        Stop(fiber, "breakpoint");
+}
+
+void ScriptDebugger::OnError(ScriptVM&, const VMFiber& fiber, const std::string& message) {
+    if (m_Client < 0 || !m_BreakOnError || fiber.frames.empty()) return;
+    SendEvent("error", message);
+    Stop(fiber, "error");
+}
+
+void ScriptDebugger::Stop(const VMFiber& fiber, const std::string& reason) {
+    if (m_Client < 0 || m_Stopped) return;
+    m_Stopped = &fiber;
+    m_StepMode = StepMode::None;
+    m_PauseRequested = false;
+    m_StopAtNextStep = false;
+    m_Last = PositionOf(fiber);
+
+    const VMFunction* fn = fiber.frames.back().closure->function;
+    Send("event stopped " + reason + " " + FunctionName(fn) + " " + ChunkName(fn) + ":" +
+         std::to_string(FrameLine(0)));
+
+    // Serve the client until it resumes (or goes away).
+    m_Resume = false;
+    std::string line;
+    while (m_Client >= 0 && !m_Resume) {
+        if (NextCommand(line)) { m_Resume = Execute(line); continue; }
+        if (m_Client >= 0) WaitFor(m_Client, -1.0);
+    }
+    m_Stopped = nullptr;
+    Send("event resumed");
+    UpdateStepInterval();
+}
+
+// ============================================================================
+// Server — inspection
+// ============================================================================
+const VMCallFrame* ScriptDebugger::Frame(u32 index) const {
+    if (!m_Stopped || index >= m_Stopped->frames.size()) return nullptr;
+    return &m_Stopped->frames[m_Stopped->frames.size() - 1 - index];
+}
+
+i32 ScriptDebugger::FrameLine(u32 index) const {
+    const VMCallFrame* frame = Frame(index);
+    if (!frame) return 0;
+    // Callers' pcs are already past their call instruction.
+    u32 pc = index == 0 ? frame->pc : (frame->pc ? frame->pc - 1 : 0);
+    return LineAt(frame->closure->function, pc);
+}
+
+std::string ScriptDebugger::Describe(VMValue value) const {
+    std::string text = m_VM.ToString(value);
+    if (value.IsString()) text = "\"" + text + "\"";
+    if (text.size() > 200) text = text.substr(0, 200) + "...";
+    std::string escaped;
+    for (char c : text) escaped += c == '\n' ? std::string("\\n") : std::string(1, c);
+    return std::string(ScriptVM::TypeName(value)) + " " + escaped;
+}
+
+void ScriptDebugger::ListVariables(u32 index) {
+    const VMCallFrame* frame = Frame(index);
+    const VMFunction* fn = frame->closure->function;
+    u32 pc = index == 0 ? frame->pc : (frame->pc ? frame->pc - 1 : 0);
+    for (const VMLocalName& local : fn->localNames) {
+        size_t slot = static_cast<size_t>(frame->base) + local.slot;
+        if (pc < local.startPc || pc >= local.endPc || slot >= m_Stopped->stack.size()) continue;
+        Send("var local " + local.name + " " + Describe(m_Stopped->stack[slot]));
+    }
+    for (size_t i = 0; i < fn->upvalueNames.size() && i < frame->closure->upvalues.size(); ++i)
+        if (frame->closure->upvalues[i])
+            Send("var upvalue " + fn->upvalueNames[i] + " " + Describe(frame->closure->upvalues[i]->Get()));
+    if (const VMMap* env = frame->closure->env) {
+        for (u32 i = 0; i < env->Size(); ++i) {
+            if (!env->keys[i].IsString() || env->values[i].IsClosure()) continue;
+            Send("var instance " + std::string(env->keys[i].AsString()->View()) + " " + Describe(env->values[i]));
+        }
+    }
+}
+
+bool ScriptDebugger::FindVariable(u32 index, const std::string& name, VMValue& out) const {
+    const VMCallFrame* frame = Frame(index);
+    const VMFunction* fn = frame->closure->function;
+    u32 pc = index == 0 ? frame->pc : (frame->pc ? frame->pc - 1 : 0);
+    // The innermost live declaration wins.
+    for (size_t i = fn->localNames.size(); i-- > 0;) {
+        const VMLocalName& local = fn->localNames[i];
+        size_t slot = static_cast<size_t>(frame->base) + local.slot;
+        if (local.name != name || pc < local.startPc || pc >= local.endPc || slot >= m_Stopped->stack.size()) continue;
+        out = m_Stopped->stack[slot];
+        return true;
+    }
+    for (size_t i = 0; i < fn->upvalueNames.size() && i < frame->closure->upvalues.size(); ++i) {
+        if (fn->upvalueNames[i] != name || !frame->closure->upvalues[i]) continue;
+        out = frame->closure->upvalues[i]->Get();
+        return true;
+    }
+    if (const VMMap* env = frame->closure->env) {
+        for (u32 i = 0; i < env->Size(); ++i) {
+            if (!env->keys[i].IsString() || env->keys[i].AsString()->View() != name) continue;
+            out = env->values[i];
+            return true;
+        }
+    }
+    if (!m_VM.HasGlobal(name)) return false;
+    out = m_VM.GetGlobal(name);
+    return true;
+}
+
+// ============================================================================
+// Server — commands
+// ============================================================================
+bool ScriptDebugger::Execute(const std::string& text) {
+    std::istringstream in(text);
+    std::string cmd;
+    in >> cmd;
+    std::string rest;
+    std::getline(in, rest);
+    rest = Trim(rest);
+
+    auto frameArg = [this](std::istringstream& args, u32& index) {
+        std::string word;
+        index = 0;
+        if (args >> word) {
+            if (word.find_first_not_of("0123456789") != std::string::npos || word.size() > 6) return false;
+            index = static_cast<u32>(std::stoul(word));
+        }
+        return Frame(index) != nullptr;
+    };
+
+    if (cmd.empty()) return false;
+    if (cmd == "help") {
+        for (const char* h : { "break <chunk>:<line>", "delete <id>", "breaks", "pause",
+                               "continue | step | next | finish", "stack", "locals [frame]",
+                               "print <name> [frame]", "errors on|off", "status", "detach" })
+            Send(std::string("help ") + h);
+        Send("ok");
+        return false;
+    }
+    if (cmd == "status") {
+        Send(m_Stopped ? "ok stopped" : "ok running");
+        return false;
+    }
+    if (cmd == "break") {
+        size_t colon = rest.rfind(':');
+        std::string num = colon == std::string::npos ? "" : rest.substr(colon + 1);
+        if (colon == 0 || num.empty() || num.size() > 9 || num.find_first_not_of("0123456789") != std::string::npos) {
+            Send("err usage: break <chunk>:<line>");
+            return false;
+        }
+        Send("ok " + std::to_string(AddBreakpoint(rest.substr(0, colon), std::stoi(num))));
+        return false;
+    }
+    if (cmd == "delete") {
+        bool numeric = !rest.empty() && rest.size() <= 9 && rest.find_first_not_of("0123456789") == std::string::npos;
+        Send(numeric && RemoveBreakpoint(static_cast<u32>(std::stoul(rest))) ? "ok" : "err no breakpoint '" + rest + "'");
+        return false;
+    }
+    if (cmd == "breaks") {
+        for (const auto& bp : m_Breakpoints)
+            Send("bp " + std::to_string(bp.id) + " " + bp.chunk + ":" + std::to_string(bp.line));
+        Send("ok");
+        return false;
+    }
+    if (cmd == "errors") {
+        if (rest != "on" && rest != "off") { Send("err usage: errors on|off"); return false; }
+        m_BreakOnError = rest == "on";
+        Send("ok");
+        return false;
+    }
+    if (cmd == "pause") {
+        if (!m_Stopped) RequestPause();
+        Send("ok");
+        return false;
+    }
+    if (cmd == "detach") {
+        Send("ok");
+        Disconnect();
+        return true;
+    }
+
+    // ── Only while stopped ──────────────────────────────────────────────────
+    bool resume = cmd == "continue" || cmd == "c" || cmd == "step" || cmd == "s" ||
+                  cmd == "next" || cmd == "n" || cmd == "finish" || cmd == "out";
+    bool inspect = cmd == "stack" || cmd == "bt" || cmd == "locals" || cmd == "print" || cmd == "p";
+    if (!resume && !inspect) {
+        Send("err unknown command '" + cmd + "' (try help)");
+        return false;
+    }
+    if (!m_Stopped) {
+        Send("err not stopped");
+        return false;
+    }
+    if (resume) {
+        m_StepMode = (cmd == "step" || cmd == "s") ? StepMode::Into
+                   : (cmd == "next" || cmd == "n") ? StepMode::Over
+                   : (cmd == "finish" || cmd == "out") ? StepMode::Out : StepMode::None;
+        m_StepFrom = PositionOf(*m_Stopped);
+        UpdateStepInterval();
+        Send("ok");
+        return true;
+    }
+    if (cmd == "stack" || cmd == "bt") {
+        for (u32 i = 0; Frame(i); ++i) {
+            const VMFunction* fn = Frame(i)->closure->function;
+            Send("frame " + std::to_string(i) + " " + FunctionName(fn) + " " + ChunkName(fn) + ":" +
+                 std::to_string(FrameLine(i)));
+        }
+        Send("ok");
+        return false;
+    }
+    if (cmd == "locals") {
+        std::istringstream args(rest);
+        u32 index;
+        if (!frameArg(args, index)) { Send("err no frame '" + rest + "'"); return false; }
+        ListVariables(index);
+        Send("ok");
+        return false;
+    }
+    // print <name> [frame]
+    std::istringstream args(rest);
+    std::string name;
+    u32 index;
+    if (!(args >> name)) { Send("err usage: print <name> [frame]"); return false; }
+    if (!frameArg(args, index)) { Send("err no such frame"); return false; }
+    VMValue value;
+    if (!FindVariable(index, name, value)) { Send("err no variable '" + name + "'"); return false; }
+    Send("value " + Describe(value));
+    Send("ok");
+    return false;
+}
+
+// ============================================================================
+// Client
+// ============================================================================
+ScriptDebugClient::~ScriptDebugClient() {
+    Disconnect();
+}
+
+bool ScriptDebugClient::Connect(const std::string& address) {
+    Disconnect();
+    Address addr;
+    if (!ParseAddress(address, addr, m_LastError)) return false;
+    u16 port = 0;
+    m_Socket = OpenSocket(addr, true, port, m_LastError);
+    if (m_Socket < 0) return false;
+    SetNonBlocking(m_Socket);
+    return true;
+}
+
+void ScriptDebugClient::Disconnect() {
+    if (m_Socket < 0) return;
+    CloseSocket(m_Socket);
+    m_Socket = -1;
+    m_InBuffer.clear();
+}
+
+bool ScriptDebugClient::ReadLine(std::string& line, f64 timeoutMs) {
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    for (;;) {
+        if (TakeLine(m_InBuffer, line)) return true;
+        if (m_Socket < 0) return false;
+        f64 left = -1.0;
+        if (timeoutMs >= 0) {
+            left = timeoutMs - std::chrono::duration<f64, std::milli>(Clock::now() - start).count();
+            if (left <= 0) { m_LastError = "timed out"; return false; }
+        }
+        if (!WaitFor(m_Socket, left)) continue;
+        if (!Receive(m_Socket, m_InBuffer)) {
+            m_LastError = "disconnected";
+            Disconnect();
+        }
+    }
+}
+
+bool ScriptDebugClient::Command(const std::string& command, std::vector<std::string>& reply, f64 timeoutMs) {
+    reply.clear();
+    if (m_Socket < 0) { m_LastError = "not connected"; return false; }
+    if (!SendAll(m_Socket, command + "\n")) {
+        m_LastError = "disconnected";
+        Disconnect();
+        return false;
+    }
+    std::string line;
+    while (ReadLine(line, timeoutMs)) {
+        if (line.rfind("event ", 0) == 0) { m_Events.push_back(line.substr(6)); continue; }
+        reply.push_back(line);
+        if (line == "ok" || line.rfind("ok ", 0) == 0 || line.rfind("err ", 0) == 0) return true;
+    }
+    return false;
+}
+
+bool ScriptDebugClient::WaitEvent(std::string& event, f64 timeoutMs) {
+    if (!m_Events.empty()) {
+        event = m_Events.front();
+        m_Events.pop_front();
+        return true;
+    }
+    std::string line;
+    while (ReadLine(line, timeoutMs)) {
+        if (line.rfind("event ", 0) != 0) continue;     // a stray reply
+        event = line.substr(6);
+        return true;
+    }
+    return false;
+}
+
+namespace {
+
+/// Print an event for a person; "stopped" also shows the source line when
+/// the chunk is a readable file.
+void PrintEvent(const std::string& event) {
+    std::istringstream in(event);
+    std::string kind;
+    in >> kind;
+    std::string rest;
+    std::getline(in, rest);
+    rest = Trim(rest);
+    if (kind == "resumed") return;
+    if (kind == "hello") { std::cout << "Connected (" << rest << ").\n"; return; }
+    if (kind == "error") { std::cout << "script error: " << rest << "\n"; return; }
+    if (kind != "stopped") { std::cout << event << "\n"; return; }
+
+    std::istringstream words(rest);
+    std::string reason, function, where;
+    words >> reason >> function;
+    std::getline(words, where);
+    where = Trim(where);
+    std::cout << "stopped at " << reason << " in " << function << ", " << where << "\n";
+
+    size_t colon = where.rfind(':');
+    if (colon == std::string::npos) return;
+    std::ifstream file(where.substr(0, colon));
+    int target = std::atoi(where.c_str() + colon + 1);
+    std::string source;
+    for (int n = 1; file && std::getline(file, source); ++n)
+        if (n == target) { std::cout << "  " << n << " | " << source << "\n"; break; }
+}
+
+} // anonymous namespace
+
+int ScriptDebugClient::Main(int argc, char* argv[]) {
+    std::string address = kDefaultAddress;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--script-debug" && i + 1 < argc && argv[i + 1][0] != '-') address = argv[++i];
+        else if (arg == "--help" || arg == "-h") {
+            std::cout << "Usage: GameVoid --script-debug [address]\n"
+                      << "  address: <port>, localhost:<port> or unix:<path> (default " << kDefaultAddress << ")\n"
+                      << "  Type 'help' once connected; an empty line repeats the last command;\n"
+                      << "  'quit' detaches and lets the engine run on.\n";
+            return 0;
+        }
+    }
+
+    ScriptDebugClient client;
+    if (!client.Connect(address)) {
+        std::cerr << "gvdb: " << client.GetLastError() << "\n";
+        return 1;
+    }
+    std::string event, last, line;
+    std::vector<std::string> reply;
+    for (;;) {
+        while (client.WaitEvent(event, 0.0)) PrintEvent(event);
+        if (!client.IsConnected()) { std::cout << "Engine disconnected.\n"; return 0; }
+
+        std::cout << "(gvdb) " << std::flush;
+        if (!std::getline(std::cin, line)) line = "quit";
+        line = Trim(line);
+        if (line.empty()) line = last;
+        if (line.empty()) continue;
+        last = line;
+        if (line == "quit" || line == "q" || line == "exit") {
+            client.Command("detach", reply);
+            return 0;
+        }
+
+        if (!client.Command(line, reply)) {
+            std::cout << "gvdb: " << client.GetLastError() << "\n";
+            if (!client.IsConnected()) return 1;
+            continue;
+        }
+        for (const std::string& r : reply) {
+            if (r == "ok") continue;
+            if (r.rfind("ok ", 0) == 0)       std::cout << r.substr(3) << "\n";
+            else if (r.rfind("err ", 0) == 0) std::cout << "error: " << r.substr(4) << "\n";
+            else                               std::cout << r << "\n";
+        }
+
+        // Resuming commands hold the prompt until the script stops again.
+        std::string cmd = line.substr(0, line.find(' '));
+        bool resumes = cmd == "continue" || cmd == "c" || cmd == "step" || cmd == "s" ||
+                       cmd == "next" || cmd == "n" || cmd == "finish" || cmd == "out";
+        if (!resumes || reply.empty() || reply.back().rfind("ok", 0) != 0) continue;
+        while (client.WaitEvent(event, -1.0)) {
+            PrintEvent(event);
+            if (event.rfind("stopped ", 0) == 0) break;
+        }
+    }
+}
+
+} // namespace gv
@@ -1,5 +1,5 @@
 // ============================================================================
-// GameVoid Engine — Script Engine Implementation (Embedded Interpreter)
+// GameVoid Engine — Script Engine Implementation
 // ============================================================================
 #include "scripting/ScriptEngine.h"
 #include "core/Scene.h"
@@ -14,6 +14,7 @@
 #include <cctype>
 #include <algorithm>
 #include <chrono>
+#include <stdexcept>
 
 namespace gv {
 
@@ -48,18 +49,12 @@ void ScriptComponent::OnStart() {
         GV_LOG_INFO("ScriptComponent::OnStart — " +
                     (m_ScriptPath.empty() ? "(inline source)" : m_ScriptPath));
 
-        // Set self-object context so script bindings know which object "self" refers to
-        m_Engine->SetSelfObject(GetOwner());
-
-        // Load from file or execute inline source
-        if (!m_ScriptPath.empty()) {
-            m_Engine->LoadFile(m_ScriptPath);
-        } else if (!m_Source.empty()) {
-            m_Engine->Execute(m_Source);
-        }
+        // Each component gets its own instance of the script, bound to its owner
+        if (!m_ScriptPath.empty() || !m_Source.empty())
+            m_Instance = m_Engine->CreateInstance(m_ScriptPath, m_Source, GetOwner());
 
         // Call on_start() if the script defines it
-        m_Engine->CallFunction("on_start");
+        m_Engine->CallInstance(m_Instance, "on_start");
 
         m_Loaded = true;
     }
@@ -71,79 +66,216 @@ void ScriptComponent::OnUpdate(f32 dt) {
     // Ensure script is loaded (late-attach)
     if (!m_Loaded) { OnStart(); }
 
-    // Set self-object context for this frame
-    m_Engine->SetSelfObject(GetOwner());
-
     // Call the script's on_update(dt) function
-    m_Engine->CallFunction("on_update", dt);
+    m_Engine->CallInstance(m_Instance, "on_update", dt);
 }
 
-void ScriptComponent::OnDetach() { m_Loaded = false; }
+void ScriptComponent::OnDetach() {
+    // Coroutines this object started must not resume with a stale `self`.
+    if (m_Engine) {
+        m_Engine->GetScheduler().StopContext(GetOwner());
+        m_Engine->DestroyInstance(m_Instance);
+    }
+    m_Instance = 0;
+    m_Loaded = false;
+}
 
 // ============================================================================
 // ScriptEngine — Init / Shutdown
 // ============================================================================
+ScriptEngine::ScriptEngine() {
+    m_RootMarker = m_VM.AddRootMarker([this](VMHeap& heap) { MarkInstances(heap); });
+}
+
+ScriptEngine::~ScriptEngine() {
+    if (m_SignalListener) EventBus::Instance().Unsubscribe(m_SignalListener);
+    m_VM.RemoveRootMarker(m_RootMarker);
+}
+
 bool ScriptEngine::Init() {
     m_Initialised = true;
-    m_Variables.clear();
-    m_NativeFunctions.clear();
-    m_ScriptFunctions.clear();
+    m_Scheduler.StopAll();
+    m_VM.ClearScriptState();
+    RegisterBuiltins();
+
+    // ── Coroutines ──────────────────────────────────────────────────────
+    m_Scheduler.RegisterNatives();
+    DefineCapability("coroutines", { "wait", "wait_event", "start_coroutine", "stop_coroutine",
+                                     "coroutine_running", "sim_time" });
+    // A coroutine runs under the sandbox of its object's script instance.
+    m_Scheduler.SetResumeHook([this](void* context) {
+        m_SelfObject = static_cast<GameObject*>(context);
+        auto it = m_InstanceBySelf.find(m_SelfObject);
+        if (it != m_InstanceBySelf.end()) EnterSandbox(it->second);
+        else LeaveSandbox();
+    });
+    m_Scheduler.SetContextSource([this]() -> void* { return m_SelfObject; });
+    m_Scheduler.SetErrorHandler([this](u32 id, const std::string& error) {
+        m_LastError = "Coroutine " + std::to_string(id) + ": " + error;
+        GV_LOG_ERROR("ScriptEngine — " + m_LastError);
+        m_Debugger.SendEvent("error", m_LastError);
+        VMFault fault = m_VM.GetLastFault();
+        if (m_Sandboxed && fault != VMFault::None && fault != VMFault::Error) Terminate(m_Sandboxed, error);
+    });
+    GV_LOG_INFO("ScriptEngine initialised (bytecode VM).");
+    return true;
+}
 
+void ScriptEngine::RegisterBuiltins() {
     // ── Built-in functions ──────────────────────────────────────────────
-    RegisterFunction("print", [](const std::vector<ScriptValue>& args) -> ScriptValue {
+    m_VM.RegisterNative("print", [](ScriptVM& vm, ScriptArgs a) -> VMValue {
         std::string out;
-        for (size_t i = 0; i < args.size(); ++i) { if (i) out += " "; out += args[i].AsString(); }
+        for (u32 i = 0; i < a.Count(); ++i) { if (i) out += " "; out += vm.ToString(a[i]); }
         GV_LOG_INFO("[Script] " + out);
         return {};
     });
 
-    RegisterFunction("sin", [](const std::vector<ScriptValue>& a) -> ScriptValue {
-        return a.empty() ? ScriptValue(0.0) : ScriptValue(std::sin(a[0].AsNumber()));
+    Bind("sin",   [](f64 x) { return std::sin(x); });
+    Bind("cos",   [](f64 x) { return std::cos(x); });
+    Bind("sqrt",  [](f64 x) { return std::sqrt(x); });
+    Bind("abs",   [](f64 x) { return std::fabs(x); });
+    Bind("floor", [](f64 x) { return std::floor(x); });
+    Bind("ceil",  [](f64 x) { return std::ceil(x); });
+    m_VM.RegisterNative("random", [](ScriptVM&, ScriptArgs a) -> VMValue {
+        f64 r = static_cast<f64>(std::rand()) / RAND_MAX;
+        if (a.Count() >= 2) return VMValue::Number(a.Number(0) + r * (a.Number(1) - a.Number(0)));
+        return VMValue::Number(r);
     });
-    RegisterFunction("cos", [](const std::vector<ScriptValue>& a) -> ScriptValue {
-        return a.empty() ? ScriptValue(0.0) : ScriptValue(std::cos(a[0].AsNumber()));
+    m_VM.RegisterNative("tostring", [](ScriptVM& vm, ScriptArgs a) -> VMValue {
+        return a[0].IsString() ? a[0] : vm.String(vm.ToString(a[0]));
     });
-    RegisterFunction("sqrt", [](const std::vector<ScriptValue>& a) -> ScriptValue {
-        return a.empty() ? ScriptValue(0.0) : ScriptValue(std::sqrt(a[0].AsNumber()));
+    m_VM.RegisterNative("tonumber", [](ScriptVM& vm, ScriptArgs a) -> VMValue {
+        if (a[0].IsNumber()) return a[0];
+        std::string s = vm.ToString(a[0]);
+        return VMValue::Number(std::strtod(s.c_str(), nullptr));
     });
-    RegisterFunction("abs", [](const std::vector<ScriptValue>& a) -> ScriptValue {
-        return a.empty() ? ScriptValue(0.0) : ScriptValue(std::fabs(a[0].AsNumber()));
+
+    // ── Containers ──────────────────────────────────────────────────────
+    m_VM.RegisterNative("type", [](ScriptVM& vm, ScriptArgs a) { return vm.String(ScriptVM::TypeName(a[0])); });
+
+    m_VM.RegisterNative("len", [](ScriptVM&, ScriptArgs a) -> VMValue {
+        VMValue v = a[0];
+        if (v.IsArray())  return VMValue::Number(static_cast<f64>(v.AsArray()->items.size()));
+        if (v.IsMap())    return VMValue::Number(static_cast<f64>(v.AsMap()->Size()));
+        if (v.IsString()) return VMValue::Number(static_cast<f64>(v.AsString()->length));
+        return VMValue::Number(0);
     });
-    RegisterFunction("floor", [](const std::vector<ScriptValue>& a) -> ScriptValue {
-        return a.empty() ? ScriptValue(0.0) : ScriptValue(std::floor(a[0].AsNumber()));
+
+    // push(array, value...) → new length
+    m_VM.RegisterNative("push", [](ScriptVM& vm, ScriptArgs a) -> VMValue {
+        if (!a[0].IsArray()) throw std::runtime_error("expected an array");
+        VMArray* arr = a[0].AsArray();
+        for (u32 i = 1; i < a.Count(); ++i) vm.GetHeap().ArrayPush(arr, a[i]);
+        return VMValue::Number(static_cast<f64>(arr->items.size()));
     });
-    RegisterFunction("ceil", [](const std::vector<ScriptValue>& a) -> ScriptValue {
-        return a.empty() ? ScriptValue(0.0) : ScriptValue(std::ceil(a[0].AsNumber()));
+
+    // pop(array) → last element (nil if empty)
+    m_VM.RegisterNative("pop", [](ScriptVM& vm, ScriptArgs a) -> VMValue {
+        if (!a[0].IsArray()) throw std::runtime_error("expected an array");
+        VMArray* arr = a[0].AsArray();
+        if (arr->items.empty()) return {};
+        VMValue last = arr->items.back();
+        vm.GetHeap().ArrayResize(arr, static_cast<u32>(arr->items.size() - 1));
+        return last;
     });
-    RegisterFunction("random", [](const std::vector<ScriptValue>& a) -> ScriptValue {
-        if (a.size() >= 2) {
-            f64 lo = a[0].AsNumber(), hi = a[1].AsNumber();
-            return ScriptValue(lo + static_cast<f64>(std::rand()) / RAND_MAX * (hi - lo));
+
+    // remove(array, index) / remove(map, key) → removed value
+    m_VM.RegisterNative("remove", [](ScriptVM& vm, ScriptArgs a) -> VMValue {
+        if (a[0].IsArray()) {
+            VMArray* arr = a[0].AsArray();
+            f64 k = a.Number(1, -1);
+            if (k < 0 || k >= static_cast<f64>(arr->items.size())) return {};
+            auto it = arr->items.begin() + static_cast<std::ptrdiff_t>(k);
+            VMValue removed = *it;
+            arr->items.erase(it);
+            vm.GetHeap().Reaccount(arr);
+            return removed;
         }
-        return ScriptValue(static_cast<f64>(std::rand()) / RAND_MAX);
+        if (a[0].IsMap()) {
+            const VMValue* v = a[0].AsMap()->Find(a[1]);
+            if (!v) return {};
+            VMValue removed = *v;
+            vm.GetHeap().MapRemove(a[0].AsMap(), a[1]);
+            return removed;
+        }
+        throw std::runtime_error("expected an array or a map");
     });
-    RegisterFunction("tostring", [](const std::vector<ScriptValue>& a) -> ScriptValue {
-        return a.empty() ? ScriptValue(std::string("nil")) : ScriptValue(a[0].AsString());
+
+    // keys(map) → array of keys in insertion order (swap-removal reorders)
+    m_VM.RegisterNative("keys", [](ScriptVM& vm, ScriptArgs a) -> VMValue {
+        if (!a[0].IsMap()) throw std::runtime_error("expected a map");
+        const VMMap* map = a[0].AsMap();
+        VMArray* arr = vm.GetHeap().NewArray(map->Size());
+        arr->items.assign(map->keys.begin(), map->keys.end());
+        vm.GetHeap().Reaccount(arr);
+        return VMValue::Object(arr);
     });
-    RegisterFunction("tonumber", [](const std::vector<ScriptValue>& a) -> ScriptValue {
-        if (a.empty()) return ScriptValue(0.0);
-        try { return ScriptValue(std::stod(a[0].AsString())); } catch (...) { return ScriptValue(0.0); }
+
+    // has(map, key) / has(array, index)
+    m_VM.RegisterNative("has", [](ScriptVM&, ScriptArgs a) -> VMValue {
+        if (a[0].IsMap()) return VMValue::Bool(a[0].AsMap()->Find(a[1]) != nullptr);
+        if (a[0].IsArray()) {
+            f64 k = a.Number(1, -1);
+            return VMValue::Bool(k >= 0 && k < static_cast<f64>(a[0].AsArray()->items.size()));
+        }
+        return VMValue::Bool(false);
     });
 
-    GV_LOG_INFO("ScriptEngine initialised (embedded interpreter).");
-    return true;
+    DefineCapability("core", { "print", "sin", "cos", "sqrt", "abs", "floor", "ceil", "random",
+                               "tostring", "tonumber", "type", "len", "push", "pop", "remove",
+                               "keys", "has" });
 }
 
 void ScriptEngine::Shutdown() {
-    m_Variables.clear();
-    m_NativeFunctions.clear();
-    m_ScriptFunctions.clear();
+    if (m_SignalListener) {
+        EventBus::Instance().Unsubscribe(m_SignalListener);
+        m_SignalListener = 0;
+    }
+    m_Debugger.Close();
+    m_Profiler.Stop();
+    m_Scheduler.StopAll();
+    ClearInstances();
+    m_VM.ClearScriptState();
+    m_VM.FullCollect();
     m_BoundScene  = nullptr;
     m_SelfObject  = nullptr;
     m_Initialised = false;
     GV_LOG_INFO("ScriptEngine shut down.");
 }
 
+void ScriptEngine::Update(f32 dt) {
+    if (!m_Initialised) return;
+    GameObject* self = m_SelfObject;
+    m_Debugger.Poll();
+    m_Clock += static_cast<f64>(dt);
+    if (m_HotReload)
+        for (const std::string& path : m_Watcher.Poll(m_Clock)) ReloadScript(path);
+    m_Scheduler.Update(static_cast<f64>(dt));
+    LeaveSandbox();
+    m_SelfObject = self;
+    m_VM.CollectGarbage(m_GCFrameBudgetMs);
+}
+
+u32 ScriptEngine::StartCoroutine(const std::string& funcName, GameObject* self) {
+    if (!m_Initialised || !m_VM.HasFunction(funcName)) return 0;
+    u32 id = m_Scheduler.Start(m_VM.String(funcName), {}, self);
+    if (!id) Report("Coroutine " + funcName + ": ");
+    return id;
+}
+
+bool ScriptEngine::Report(const std::string& context) {
+    m_LastError = context + m_VM.GetLastError();
+    GV_LOG_ERROR("ScriptEngine — " + m_LastError);
+    m_Debugger.SendEvent("error", m_LastError);
+    return false;
+}
+
+bool ScriptEngine::StartDebugServer(const std::string& address) {
+    if (m_Debugger.Listen(address)) return true;
+    m_LastError = "Debug server: " + m_Debugger.GetLastError();
+    return false;
+}
+
 // ============================================================================
 // Load / Execute
 // ============================================================================
@@ -158,22 +290,14 @@ bool ScriptEngine::LoadFile(const std::string& path) {
     std::stringstream ss;
     ss << file.rdbuf();
     GV_LOG_INFO("ScriptEngine — loading file: " + path);
-    return Execute(ss.str());
+    if (!m_VM.Execute(ss.str(), path)) return Report("Script error: ");
+    return true;
 }
 
 bool ScriptEngine::Execute(const std::string& source) {
     if (!m_Initialised) return false;
-    try {
-        auto tokens = Tokenize(source);
-        size_t pos = 0;
-        while (pos < tokens.size() && tokens[pos].kind != Token::Eof)
-            ExecuteStatement(tokens, pos);
-        return true;
-    } catch (const std::exception& e) {
-        m_LastError = std::string("Script error: ") + e.what();
-        GV_LOG_ERROR("ScriptEngine — " + m_LastError);
-        return false;
-    }
+    if (!m_VM.Execute(source, "script")) return Report("Script error: ");
+    return true;
 }
 
 // ============================================================================
@@ -181,69 +305,74 @@ bool ScriptEngine::Execute(const std::string& source) {
 // ============================================================================
 bool ScriptEngine::CallFunction(const std::string& funcName) {
     // Script functions
-    auto it = m_ScriptFunctions.find(funcName);
-    if (it != m_ScriptFunctions.end()) {
-        size_t pos = 0;
-        try {
-            while (pos < it->second.body.size() && it->second.body[pos].kind != Token::Eof)
-                ExecuteStatement(it->second.body, pos);
-            return true;
-        } catch (const std::exception& e) {
-            m_LastError = "Error in " + funcName + ": " + e.what();
-            GV_LOG_ERROR("ScriptEngine — " + m_LastError);
-            return false;
-        }
+    if (m_VM.HasFunction(funcName)) {
+        if (!m_VM.CallFunction(funcName)) return Report("Error in " + funcName + ": ");
+        return true;
     }
     // Native functions
-    auto nit = m_NativeFunctions.find(funcName);
-    if (nit != m_NativeFunctions.end()) { nit->second({}); return true; }
+    if (m_VM.HasNative(funcName)) {
+        m_VM.Call(m_VM.String(funcName));
+        return true;
+    }
     return false;
 }
 
 bool ScriptEngine::CallFunction(const std::string& funcName, f32 arg) {
-    auto it = m_ScriptFunctions.find(funcName);
-    if (it != m_ScriptFunctions.end()) {
-        auto& func = it->second;
-        if (!func.params.empty())
-            m_Variables[func.params[0]] = ScriptValue(static_cast<f64>(arg));
-        m_Variables["dt"] = ScriptValue(static_cast<f64>(arg));
-        size_t pos = 0;
-        try {
-            while (pos < func.body.size() && func.body[pos].kind != Token::Eof)
-                ExecuteStatement(func.body, pos);
-            return true;
-        } catch (const std::exception& e) {
-            m_LastError = "Error in " + funcName + ": " + e.what();
-            GV_LOG_ERROR("ScriptEngine — " + m_LastError);
-            return false;
-        }
+    VMValue dt = VMValue::Number(static_cast<f64>(arg));
+    if (m_VM.HasFunction(funcName)) {
+        m_VM.SetGlobal("dt", dt);
+        if (!m_VM.CallFunction(funcName, { &dt, 1 })) return Report("Error in " + funcName + ": ");
+        return true;
+    }
+    if (m_VM.HasNative(funcName)) {
+        m_VM.Call(m_VM.String(funcName), { &dt, 1 });
+        return true;
     }
-    auto nit = m_NativeFunctions.find(funcName);
-    if (nit != m_NativeFunctions.end()) { nit->second({ ScriptValue(static_cast<f64>(arg)) }); return true; }
     return false;
 }
 
 // ============================================================================
 // Register / Bind helpers
 // ============================================================================
+ScriptValue ScriptEngine::ToScriptValue(VMValue value) const {
+    if (value.IsNumber()) return ScriptValue(value.AsNumber());
+    if (value.IsBool())   return ScriptValue(value.AsBool());
+    if (value.IsString()) return ScriptValue(std::string(value.AsString()->View()));
+    return {};
+}
+
+VMValue ScriptEngine::FromScriptValue(const ScriptValue& value) {
+    switch (value.type) {
+        case ScriptValue::Number: return VMValue::Number(value.numberVal);
+        case ScriptValue::String: return m_VM.String(value.stringVal);
+        case ScriptValue::Bool:   return VMValue::Bool(value.boolVal);
+        case ScriptValue::Nil:    return {};
+    }
+    return {};
+}
+
 void ScriptEngine::RegisterFunction(const std::string& name, NativeFunc func) {
-    m_NativeFunctions[name] = std::move(func);
+    m_VM.RegisterNative(name, [this, fn = std::move(func)](ScriptVM&, ScriptArgs a) -> VMValue {
+        std::vector<ScriptValue> args;
+        args.reserve(a.Count());
+        for (u32 i = 0; i < a.Count(); ++i) args.push_back(ToScriptValue(a[i]));
+        return FromScriptValue(fn(args));
+    });
 }
 
 void ScriptEngine::SetVariable(const std::string& name, ScriptValue val) {
-    m_Variables[name] = std::move(val);
+    m_VM.SetGlobal(name, FromScriptValue(val));
 }
 
 ScriptValue ScriptEngine::GetVariable(const std::string& name) const {
-    auto it = m_Variables.find(name);
-    return (it != m_Variables.end()) ? it->second : ScriptValue();
+    return ToScriptValue(m_VM.GetGlobal(name));
 }
 
 void ScriptEngine::BindSceneAPI(Scene& scene) {
     m_BoundScene = &scene;
 
-    auto keyFromArg = [](const ScriptValue& v) -> i32 {
-        const std::string s = v.AsString();
+    auto keyFromArg = [](ScriptVM& vm, VMValue v) -> i32 {
+        const std::string s = vm.ToString(v);
         if (s.empty()) return -1;
         if (s.size() == 1) {
             char c = static_cast<char>(std::toupper(static_cast<unsigned char>(s[0])));
@@ -263,110 +392,118 @@ void ScriptEngine::BindSceneAPI(Scene& scene) {
         return -1;
     };
 
-    RegisterFunction("is_key_down", [keyFromArg](const std::vector<ScriptValue>& args) -> ScriptValue {
-        if (args.empty()) return ScriptValue(false);
-        const i32 key = keyFromArg(args[0]);
-        if (key < 0) return ScriptValue(false);
-        return ScriptValue(Engine::Instance().GetWindow().IsKeyDown(key));
+    m_VM.RegisterNative("is_key_down", [keyFromArg](ScriptVM& vm, ScriptArgs args) -> VMValue {
+        if (args.Empty()) return VMValue::Bool(false);
+        const i32 key = keyFromArg(vm, args[0]);
+        if (key < 0) return VMValue::Bool(false);
+        return VMValue::Bool(Engine::Instance().GetWindow().IsKeyDown(key));
     });
 
-    RegisterFunction("is_key_pressed", [keyFromArg](const std::vector<ScriptValue>& args) -> ScriptValue {
-        if (args.empty()) return ScriptValue(false);
-        const i32 key = keyFromArg(args[0]);
-        if (key < 0) return ScriptValue(false);
-        return ScriptValue(Engine::Instance().GetWindow().IsKeyPressed(key));
+    m_VM.RegisterNative("is_key_pressed", [keyFromArg](ScriptVM& vm, ScriptArgs args) -> VMValue {
+        if (args.Empty()) return VMValue::Bool(false);
+        const i32 key = keyFromArg(vm, args[0]);
+        if (key < 0) return VMValue::Bool(false);
+        return VMValue::Bool(Engine::Instance().GetWindow().IsKeyPressed(key));
     });
 
-    RegisterFunction("spawn", [this](const std::vector<ScriptValue>& args) -> ScriptValue {
-        if (!m_BoundScene || args.empty()) return {};
-        std::string nm = args[0].AsString();
+    Bind("spawn", [this](const std::string& nm) -> VMValue {
+        if (!m_BoundScene) return {};
         auto* obj = m_BoundScene->CreateGameObject(nm);
         if (obj) {
             auto* mr = obj->AddComponent<MeshRenderer>();
             mr->primitiveType = PrimitiveType::Cube;
             mr->color = Vec4(0.5f, 0.8f, 0.3f, 1.0f);
             GV_LOG_INFO("[Script] Spawned object: " + nm);
-            return ScriptValue(static_cast<f64>(obj->GetID()));
+            return VMValue::Number(static_cast<f64>(obj->GetID()));
         }
         return {};
     });
 
-    RegisterFunction("find", [this](const std::vector<ScriptValue>& args) -> ScriptValue {
-        if (!m_BoundScene || args.empty()) return {};
-        auto* obj = m_BoundScene->FindByName(args[0].AsString());
-        return obj ? ScriptValue(static_cast<f64>(obj->GetID())) : ScriptValue();
+    Bind("find", [this](std::string_view name) -> VMValue {
+        auto* obj = m_BoundScene ? m_BoundScene->FindByName(std::string(name)) : nullptr;
+        return obj ? VMValue::Number(static_cast<f64>(obj->GetID())) : VMValue();
     });
 
-    RegisterFunction("destroy", [this](const std::vector<ScriptValue>& args) -> ScriptValue {
-        if (!m_BoundScene || args.empty()) return {};
-        u32 id = static_cast<u32>(args[0].AsNumber());
-        auto* obj = m_BoundScene->FindByID(id);
+    Bind("destroy", [this](u32 id) {
+        auto* obj = m_BoundScene ? m_BoundScene->FindByID(id) : nullptr;
         if (obj) { m_BoundScene->DestroyGameObject(obj); GV_LOG_INFO("[Script] Destroyed id=" + std::to_string(id)); }
-        return {};
     });
 
-    RegisterFunction("set_position", [this](const std::vector<ScriptValue>& args) -> ScriptValue {
-        if (args.size() < 3) return {};
+    m_VM.RegisterNative("set_position", [this](ScriptVM&, ScriptArgs args) -> VMValue {
+        if (args.Count() < 3) return {};
         GameObject* obj = m_SelfObject;
-        if (args.size() >= 4 && m_BoundScene) {
-            obj = m_BoundScene->FindByID(static_cast<u32>(args[0].AsNumber()));
-            if (obj) obj->GetTransform().SetPosition((f32)args[1].AsNumber(), (f32)args[2].AsNumber(), (f32)args[3].AsNumber());
-        } else if (obj) {
-            obj->GetTransform().SetPosition((f32)args[0].AsNumber(), (f32)args[1].AsNumber(), (f32)args[2].AsNumber());
+        if (args.Count() >= 4 && m_BoundScene) {
+            obj = TouchForPlay(m_BoundScene->FindByID(static_cast<u32>(args.Number(0))));
+            if (obj) obj->GetTransform().SetPosition((f32)args.Number(1), (f32)args.Number(2), (f32)args.Number(3));
+        } else if (TouchForPlay(obj)) {
+            obj->GetTransform().SetPosition((f32)args.Number(0), (f32)args.Number(1), (f32)args.Number(2));
         }
         return {};
     });
 
-    RegisterFunction("get_position_x", [this](const std::vector<ScriptValue>& args) -> ScriptValue {
+    m_VM.RegisterNative("get_position_x", [this](ScriptVM&, ScriptArgs args) -> VMValue {
         GameObject* obj = m_SelfObject;
-        if (!args.empty() && m_BoundScene) obj = m_BoundScene->FindByID((u32)args[0].AsNumber());
-        return obj ? ScriptValue((f64)obj->GetTransform().position.x) : ScriptValue(0.0);
+        if (!args.Empty() && m_BoundScene) obj = m_BoundScene->FindByID((u32)args.Number(0));
+        return VMValue::Number(obj ? (f64)obj->GetTransform().position.x : 0.0);
     });
-    RegisterFunction("get_position_y", [this](const std::vector<ScriptValue>& args) -> ScriptValue {
+    m_VM.RegisterNative("get_position_y", [this](ScriptVM&, ScriptArgs args) -> VMValue {
         GameObject* obj = m_SelfObject;
-        if (!args.empty() && m_BoundScene) obj = m_BoundScene->FindByID((u32)args[0].AsNumber());
-        return obj ? ScriptValue((f64)obj->GetTransform().position.y) : ScriptValue(0.0);
+        if (!args.Empty() && m_BoundScene) obj = m_BoundScene->FindByID((u32)args.Number(0));
+        return VMValue::Number(obj ? (f64)obj->GetTransform().position.y : 0.0);
     });
-    RegisterFunction("get_position_z", [this](const std::vector<ScriptValue>& args) -> ScriptValue {
+    m_VM.RegisterNative("get_position_z", [this](ScriptVM&, ScriptArgs args) -> VMValue {
         GameObject* obj = m_SelfObject;
-        if (!args.empty() && m_BoundScene) obj = m_BoundScene->FindByID((u32)args[0].AsNumber());
-        return obj ? ScriptValue((f64)obj->GetTransform().position.z) : ScriptValue(0.0);
+        if (!args.Empty() && m_BoundScene) obj = m_BoundScene->FindByID((u32)args.Number(0));
+        return VMValue::Number(obj ? (f64)obj->GetTransform().position.z : 0.0);
     });
 
-    RegisterFunction("set_scale", [this](const std::vector<ScriptValue>& args) -> ScriptValue {
-        if (args.empty()) return {};
+    m_VM.RegisterNative("set_scale", [this](ScriptVM&, ScriptArgs args) -> VMValue {
+        if (args.Empty()) return {};
         GameObject* obj = m_SelfObject;
-        if (args.size() >= 2 && m_BoundScene) {
-            obj = m_BoundScene->FindByID((u32)args[0].AsNumber());
-            if (obj) obj->GetTransform().SetScale((f32)args[1].AsNumber());
-        } else if (obj) obj->GetTransform().SetScale((f32)args[0].AsNumber());
+        if (args.Count() >= 2 && m_BoundScene) {
+            obj = TouchForPlay(m_BoundScene->FindByID((u32)args.Number(0)));
+            if (obj) obj->GetTransform().SetScale((f32)args.Number(1));
+        } else if (TouchForPlay(obj)) obj->GetTransform().SetScale((f32)args.Number(0));
         return {};
     });
 
-    RegisterFunction("set_rotation", [this](const std::vector<ScriptValue>& args) -> ScriptValue {
-        if (args.size() < 3) return {};
-        GameObject* obj = m_SelfObject;
-        if (obj) obj->GetTransform().SetEulerDeg((f32)args[0].AsNumber(), (f32)args[1].AsNumber(), (f32)args[2].AsNumber());
-        return {};
+    Bind("set_rotation", [this](f32 x, f32 y, f32 z) {
+        if (TouchForPlay(m_SelfObject)) m_SelfObject->GetTransform().SetEulerDeg(x, y, z);
     });
 
-    RegisterFunction("get_object_count", [this](const std::vector<ScriptValue>&) -> ScriptValue {
-        return m_BoundScene ? ScriptValue((f64)m_BoundScene->GetAllObjects().size()) : ScriptValue(0.0);
+    Bind("get_object_count", [this]() -> u32 {
+        return m_BoundScene ? static_cast<u32>(m_BoundScene->GetAllObjects().size()) : 0u;
     });
 
+    DefineCapability("input", { "is_key_down", "is_key_pressed" });
+    DefineCapability("scene", { "spawn", "find", "destroy", "set_position", "get_position_x",
+                                "get_position_y", "get_position_z", "set_scale", "set_rotation",
+                                "get_object_count" });
     GV_LOG_DEBUG("ScriptEngine — Scene API bound.");
 }
 
+GameObject* ScriptEngine::TouchForPlay(GameObject* obj) {
+    if (obj && m_BoundScene) m_BoundScene->TouchForPlay(obj);
+    return obj;
+}
+
 void ScriptEngine::BindGameObjectAPI() {
+    // Methods of the script's own object ("self").
+    BindMethod<GameObject>("get_name", &GameObject::GetName);
+    Bind("set_name", [this](const std::string& name) {
+        if (TouchForPlay(m_SelfObject)) m_SelfObject->SetName(name);
+    });
+    BindMethod<GameObject>("get_id",   &GameObject::GetID);
+    DefineCapability("self", { "get_name", "set_name", "get_id" });
     GV_LOG_DEBUG("ScriptEngine — GameObject API bound.");
 }
 
 void ScriptEngine::BindEventAPI() {
     // emit(signal_name)  or  emit(signal_name, data_string)
-    RegisterFunction("emit", [this](const std::vector<ScriptValue>& args) -> ScriptValue {
-        if (args.empty()) return {};
-        std::string sig = args[0].AsString();
-        std::string data = args.size() >= 2 ? args[1].AsString() : "";
+    m_VM.RegisterNative("emit", [this](ScriptVM& vm, ScriptArgs args) -> VMValue {
+        if (args.Empty()) return {};
+        std::string sig = vm.ToString(args[0]);
+        std::string data = args.Count() >= 2 ? vm.ToString(args[1]) : "";
         EventBus::Instance().EmitSignal(sig, data, m_SelfObject);
         return {};
     });
@@ -374,9 +511,9 @@ void ScriptEngine::BindEventAPI() {
     // on_collision(callback_func_name)  — sugar: calls callback_func_name when self collides
     // The callback function will be invoked with no args; the script can use
     // get_position_x/y/z to inspect the collision objects.
-    RegisterFunction("on_collision", [this](const std::vector<ScriptValue>& args) -> ScriptValue {
-        if (args.empty()) return {};
-        std::string funcName = args[0].AsString();
+    m_VM.RegisterNative("on_collision", [this](ScriptVM& vm, ScriptArgs args) -> VMValue {
+        if (args.Empty()) return {};
+        std::string funcName = vm.ToString(args[0]);
         GameObject* self = m_SelfObject;
         ScriptEngine* engine = this;
         EventBus::Instance().Subscribe(EventType::CollisionEnter,
@@ -387,441 +524,371 @@ void ScriptEngine::BindEventAPI() {
         return {};
     });
 
+    // Signals wake coroutines blocked in wait_event(name); the wait
+    // returns the signal's data string.
+    if (!m_SignalListener) {
+        m_SignalListener = EventBus::Instance().Subscribe(EventType::Custom, [this](const Event& e) {
+            m_Scheduler.Signal(e.signalName, m_VM.String(e.signalData));
+        });
+    }
+
     // get_delta_time() — returns the dt variable set during on_update
-    RegisterFunction("get_delta_time", [this](const std::vector<ScriptValue>&) -> ScriptValue {
-        return GetVariable("dt");
+    m_VM.RegisterNative("get_delta_time", [](ScriptVM& vm, ScriptArgs) -> VMValue {
+        return vm.GetGlobal("dt");
     });
 
     // get_time() — returns elapsed time from clock
-    RegisterFunction("get_time", [](const std::vector<ScriptValue>&) -> ScriptValue {
+    m_VM.RegisterNative("get_time", [](ScriptVM&, ScriptArgs) -> VMValue {
         static auto start = std::chrono::high_resolution_clock::now();
         auto now = std::chrono::high_resolution_clock::now();
         f64 elapsed = std::chrono::duration<f64>(now - start).count();
-        return ScriptValue(elapsed);
+        return VMValue::Number(elapsed);
     });
 
+    DefineCapability("events", { "emit", "on_collision", "get_delta_time", "get_time" });
     GV_LOG_DEBUG("ScriptEngine — Event API bound.");
 }
 
 void ScriptEngine::EnableHotReload(bool enable) {
     m_HotReload = enable;
-    GV_LOG_INFO(std::string("ScriptEngine — hot reload ") + (enable ? "enabled" : "disabled"));
+    m_Watcher.Clear();
+    if (enable)
+        for (auto& kv : m_Modules)
+            if (!kv.second->path.empty()) m_Watcher.Watch(kv.second->path);
+    GV_LOG_INFO(std::string("ScriptEngine — hot reload ") + (enable ? "enabled" : "disabled") +
+                (enable && !m_Watcher.UsingInotify() ? " (polling)" : ""));
 }
 
 // ============================================================================
-// Tokenizer
+// Instances
 // ============================================================================
-std::vector<ScriptEngine::Token> ScriptEngine::Tokenize(const std::string& source) {
-    std::vector<Token> tokens;
-    size_t i = 0;
-    i32 line = 1;
-
-    while (i < source.size()) {
-        char c = source[i];
-
-        // Whitespace
-        if (c == ' ' || c == '\t' || c == '\r') { ++i; continue; }
-        if (c == '\n') { ++line; ++i; continue; }
-
-        // Comments
-        if (c == '/' && i + 1 < source.size()) {
-            if (source[i + 1] == '/') { while (i < source.size() && source[i] != '\n') ++i; continue; }
-            if (source[i + 1] == '*') {
-                i += 2;
-                while (i + 1 < source.size() && !(source[i] == '*' && source[i + 1] == '/')) { if (source[i] == '\n') ++line; ++i; }
-                i += 2; continue;
-            }
-        }
+namespace {
 
-        // Numbers
-        if (std::isdigit(c) || (c == '.' && i + 1 < source.size() && std::isdigit(source[i + 1]))) {
-            std::string num;
-            while (i < source.size() && (std::isdigit(source[i]) || source[i] == '.')) num += source[i++];
-            tokens.push_back({ Token::Number, num, std::stod(num), line });
-            continue;
-        }
+u64 HashSource(const std::string& source) {
+    u64 h = 1469598103934665603ull;                 // FNV-1a
+    for (unsigned char c : source) { h ^= c; h *= 1099511628211ull; }
+    return h;
+}
 
-        // Strings
-        if (c == '"' || c == '\'') {
-            char q = c; ++i;
-            std::string str;
-            while (i < source.size() && source[i] != q) {
-                if (source[i] == '\\' && i + 1 < source.size()) {
-                    ++i;
-                    switch (source[i]) { case 'n': str += '\n'; break; case 't': str += '\t'; break; case '\\': str += '\\'; break; default: str += source[i]; }
-                } else str += source[i];
-                ++i;
-            }
-            if (i < source.size()) ++i;
-            tokens.push_back({ Token::Str, str, 0, line });
-            continue;
-        }
+bool ReadSource(const std::string& path, std::string& out) {
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+    std::stringstream ss;
+    ss << file.rdbuf();
+    out = ss.str();
+    return true;
+}
 
-        // Identifiers / keywords
-        if (std::isalpha(c) || c == '_') {
-            std::string id;
-            while (i < source.size() && (std::isalnum(source[i]) || source[i] == '_')) id += source[i++];
-            Token t; t.text = id; t.line = line; t.numVal = 0;
-            if      (id == "if")                        t.kind = Token::If;
-            else if (id == "else")                      t.kind = Token::Else;
-            else if (id == "while")                     t.kind = Token::While;
-            else if (id == "for")                       t.kind = Token::For;
-            else if (id == "func" || id == "function")  t.kind = Token::Func;
-            else if (id == "return")                    t.kind = Token::Return;
-            else if (id == "var" || id == "local")      t.kind = Token::Var;
-            else if (id == "true")                      t.kind = Token::True_;
-            else if (id == "false")                     t.kind = Token::False_;
-            else if (id == "and")                       t.kind = Token::And;
-            else if (id == "or")                        t.kind = Token::Or;
-            else if (id == "not")                       t.kind = Token::Not;
-            else                                        t.kind = Token::Ident;
-            tokens.push_back(t);
-            continue;
-        }
+void ClearMap(VMHeap& heap, VMMap* map) {
+    map->keys.clear();
+    map->values.clear();
+    map->index.clear();
+    heap.Reaccount(map);
+}
 
-        // Two-char operators
-        if (i + 1 < source.size()) {
-            std::string tw = source.substr(i, 2);
-            if (tw == "==") { tokens.push_back({ Token::Eq,  "==", 0, line }); i += 2; continue; }
-            if (tw == "!=") { tokens.push_back({ Token::Neq, "!=", 0, line }); i += 2; continue; }
-            if (tw == "<=") { tokens.push_back({ Token::Lte, "<=", 0, line }); i += 2; continue; }
-            if (tw == ">=") { tokens.push_back({ Token::Gte, ">=", 0, line }); i += 2; continue; }
-            if (tw == "&&") { tokens.push_back({ Token::And, "&&", 0, line }); i += 2; continue; }
-            if (tw == "||") { tokens.push_back({ Token::Or,  "||", 0, line }); i += 2; continue; }
-        }
+void CopyMap(VMHeap& heap, VMMap* dst, const VMMap* src) {
+    for (u32 i = 0; i < src->Size(); ++i) heap.MapSet(dst, src->keys[i], src->values[i]);
+}
 
-        // Single-char tokens
-        Token t; t.line = line; t.numVal = 0;
-        switch (c) {
-            case '(': t.kind = Token::LParen;    t.text = "("; break;
-            case ')': t.kind = Token::RParen;    t.text = ")"; break;
-            case '{': t.kind = Token::LBrace;    t.text = "{"; break;
-            case '}': t.kind = Token::RBrace;    t.text = "}"; break;
-            case ',': t.kind = Token::Comma;     t.text = ","; break;
-            case ';': t.kind = Token::Semicolon; t.text = ";"; break;
-            case '=': t.kind = Token::Assign;    t.text = "="; break;
-            case '+': t.kind = Token::Plus;      t.text = "+"; break;
-            case '-': t.kind = Token::Minus;     t.text = "-"; break;
-            case '*': t.kind = Token::Star;      t.text = "*"; break;
-            case '/': t.kind = Token::Slash;     t.text = "/"; break;
-            case '%': t.kind = Token::Percent;   t.text = "%"; break;
-            case '<': t.kind = Token::Lt;        t.text = "<"; break;
-            case '>': t.kind = Token::Gt;        t.text = ">"; break;
-            case '!': t.kind = Token::Not;       t.text = "!"; break;
-            case '.': t.kind = Token::Dot;       t.text = "."; break;
-            default:  ++i; continue;
-        }
-        tokens.push_back(t);
-        ++i;
-    }
+} // anonymous namespace
 
-    tokens.push_back({ Token::Eof, "", 0, line });
-    return tokens;
+void ScriptEngine::MarkInstances(VMHeap& heap) {
+    for (auto& kv : m_Modules) if (kv.second->chunk) heap.MarkObject(kv.second->chunk);
+    for (auto& kv : m_Instances) heap.MarkObject(kv.second.env);
 }
 
-// ============================================================================
-// Interpreter — recursive-descent
-// ============================================================================
-ScriptValue ScriptEngine::ExecuteStatement(const std::vector<Token>& tokens, size_t& pos) {
-    if (pos >= tokens.size() || tokens[pos].kind == Token::Eof) return {};
-
-    // Skip semicolons
-    while (pos < tokens.size() && tokens[pos].kind == Token::Semicolon) ++pos;
-    if (pos >= tokens.size() || tokens[pos].kind == Token::Eof) return {};
-
-    const Token& tok = tokens[pos];
-
-    // ── var x = expr ────────────────────────────────────────────────────
-    if (tok.kind == Token::Var) {
-        ++pos;
-        if (pos >= tokens.size() || tokens[pos].kind != Token::Ident)
-            throw std::runtime_error("Expected variable name after 'var'");
-        std::string name = tokens[pos].text; ++pos;
-        ScriptValue val;
-        if (pos < tokens.size() && tokens[pos].kind == Token::Assign) { ++pos; val = ExecuteExpression(tokens, pos); }
-        m_Variables[name] = val;
-        if (pos < tokens.size() && tokens[pos].kind == Token::Semicolon) ++pos;
-        return val;
-    }
+void ScriptEngine::ClearInstances() {
+    LeaveSandbox();
+    m_Instances.clear();
+    m_InstanceBySelf.clear();
+    m_Modules.clear();
+    m_Watcher.Clear();
+}
 
-    // ── func name(params) { body } ──────────────────────────────────────
-    if (tok.kind == Token::Func) {
-        ++pos;
-        if (pos >= tokens.size()) throw std::runtime_error("Expected function name");
-        std::string name = tokens[pos].text; ++pos;
-        // params
-        std::vector<std::string> params;
-        if (pos < tokens.size() && tokens[pos].kind == Token::LParen) {
-            ++pos;
-            while (pos < tokens.size() && tokens[pos].kind != Token::RParen) {
-                if (tokens[pos].kind == Token::Ident) params.push_back(tokens[pos].text);
-                ++pos;
-                if (pos < tokens.size() && tokens[pos].kind == Token::Comma) ++pos;
-            }
-            if (pos < tokens.size()) ++pos; // skip )
-        }
-        // collect body tokens between { ... }
-        std::vector<Token> body;
-        if (pos < tokens.size() && tokens[pos].kind == Token::LBrace) {
-            ++pos; int depth = 1;
-            while (pos < tokens.size() && depth > 0) {
-                if (tokens[pos].kind == Token::LBrace) depth++;
-                if (tokens[pos].kind == Token::RBrace) { depth--; if (depth == 0) break; }
-                body.push_back(tokens[pos]); ++pos;
-            }
-            if (pos < tokens.size()) ++pos; // skip }
+ScriptEngine::ScriptModule* ScriptEngine::LoadModule(const std::string& path, const std::string& source) {
+    std::string key, text = source;
+    if (!path.empty()) {
+        key = FileWatcher::Normalise(path);
+        auto it = m_Modules.find(key);
+        if (it != m_Modules.end()) return it->second.get();
+        if (!ReadSource(key, text)) {
+            m_LastError = "Failed to open script file: " + path;
+            GV_LOG_ERROR("ScriptEngine — " + m_LastError);
+            return nullptr;
         }
-        body.push_back({ Token::Eof, "", 0, 0 });
-        m_ScriptFunctions[name] = { name, params, body };
-        return {};
+        GV_LOG_INFO("ScriptEngine — loading file: " + path);
+    } else {
+        key = "inline:" + std::to_string(HashSource(source));
+        auto it = m_Modules.find(key);
+        if (it != m_Modules.end()) return it->second.get();
     }
 
-    // ── if (cond) { ... } else { ... } ──────────────────────────────────
-    if (tok.kind == Token::If) {
-        ++pos;
-        if (pos < tokens.size() && tokens[pos].kind == Token::LParen) ++pos;
-        ScriptValue cond = ExecuteExpression(tokens, pos);
-        if (pos < tokens.size() && tokens[pos].kind == Token::RParen) ++pos;
-
-        auto skipBlock = [&]() {
-            if (pos < tokens.size() && tokens[pos].kind == Token::LBrace) {
-                ++pos; int d = 1;
-                while (pos < tokens.size() && d > 0) { if (tokens[pos].kind == Token::LBrace) d++; if (tokens[pos].kind == Token::RBrace) d--; ++pos; }
-            }
-        };
-
-        if (cond.AsBool()) {
-            ScriptValue r = ExecuteBlock(tokens, pos);
-            if (pos < tokens.size() && tokens[pos].kind == Token::Else) { ++pos; skipBlock(); }
-            return r;
-        } else {
-            skipBlock();
-            if (pos < tokens.size() && tokens[pos].kind == Token::Else) { ++pos; return ExecuteBlock(tokens, pos); }
-            return {};
-        }
-    }
+    auto module = MakeUnique<ScriptModule>();
+    module->path = path.empty() ? "" : key;
+    module->sourceHash = HashSource(text);
+    // Rooted by MarkInstances as soon as it's stored.
+    module->chunk = m_VM.Compile(text, path.empty() ? "script" : path);
+    if (!module->chunk) Report("Script error: ");
+    // A file that doesn't compile yet still gets a module, so fixing it
+    // with hot reload on brings its instances to life.
+    if (!module->chunk && path.empty()) return nullptr;
+    if (m_HotReload && !module->path.empty()) m_Watcher.Watch(module->path);
+    ScriptModule* raw = module.get();
+    m_Modules.emplace(key, std::move(module));
+    return raw;
+}
 
-    // ── while (cond) { body } ───────────────────────────────────────────
-    if (tok.kind == Token::While) {
-        ++pos;
-        size_t condStart = pos;
-        for (int guard = 10000; guard > 0; --guard) {
-            pos = condStart;
-            if (pos < tokens.size() && tokens[pos].kind == Token::LParen) ++pos;
-            ScriptValue cond = ExecuteExpression(tokens, pos);
-            if (pos < tokens.size() && tokens[pos].kind == Token::RParen) ++pos;
-            if (!cond.AsBool()) {
-                // skip block
-                if (pos < tokens.size() && tokens[pos].kind == Token::LBrace) {
-                    ++pos; int d = 1;
-                    while (pos < tokens.size() && d > 0) { if (tokens[pos].kind == Token::LBrace) d++; if (tokens[pos].kind == Token::RBrace) d--; ++pos; }
-                }
-                break;
-            }
-            ExecuteBlock(tokens, pos);
-        }
-        return {};
+u32 ScriptEngine::CreateInstance(const std::string& path, const std::string& source, GameObject* self) {
+    if (!m_Initialised) return 0;
+    ScriptModule* module = LoadModule(path, source);
+    if (!module) return 0;
+
+    u32 id = m_NextInstance++;
+    ScriptInstance& inst = m_Instances[id];
+    inst.module = module;
+    inst.env    = m_VM.GetHeap().NewMap();
+    inst.self   = self;
+    inst.sandbox = m_DefaultSandbox;
+    ++module->instances;
+    if (self) m_InstanceBySelf[self] = id;
+
+    if (module->chunk) {
+        GameObject* prev = m_SelfObject;
+        m_SelfObject = self;
+        // A runtime error leaves whatever the script defined before it.
+        EnterSandbox(id);
+        bool ok = m_VM.RunChunk(module->chunk, inst.env);
+        LeaveSandbox();
+        if (!ok) InstanceFailed(id, "Script error: ");
+        m_SelfObject = prev;
     }
+    return id;
+}
 
-    // ── for (init; cond; step) { body } ─────────────────────────────────
-    if (tok.kind == Token::For) {
-        ++pos;
-        if (pos < tokens.size() && tokens[pos].kind == Token::LParen) ++pos;
-        ExecuteStatement(tokens, pos); // init
-        size_t condStart = pos;
-
-        for (int guard = 10000; guard > 0; --guard) {
-            pos = condStart;
-            ScriptValue cond = ExecuteExpression(tokens, pos);
-            if (pos < tokens.size() && tokens[pos].kind == Token::Semicolon) ++pos;
-            size_t stepStart = pos;
-            // find closing paren
-            size_t bodyStart = stepStart;
-            while (bodyStart < tokens.size() && tokens[bodyStart].kind != Token::RParen) ++bodyStart;
-            if (bodyStart < tokens.size()) ++bodyStart;
-
-            if (!cond.AsBool()) {
-                pos = bodyStart;
-                if (pos < tokens.size() && tokens[pos].kind == Token::LBrace) {
-                    ++pos; int d = 1;
-                    while (pos < tokens.size() && d > 0) { if (tokens[pos].kind == Token::LBrace) d++; if (tokens[pos].kind == Token::RBrace) d--; ++pos; }
-                }
-                break;
-            }
-            pos = bodyStart;
-            ExecuteBlock(tokens, pos);
-            size_t stp = stepStart;
-            ExecuteExpression(tokens, stp);
-        }
-        return {};
+void ScriptEngine::DestroyInstance(u32 id) {
+    auto it = m_Instances.find(id);
+    if (it == m_Instances.end()) return;
+    ScriptModule* module = it->second.module;
+    auto self = m_InstanceBySelf.find(it->second.self);
+    if (self != m_InstanceBySelf.end() && self->second == id) m_InstanceBySelf.erase(self);
+    m_Instances.erase(it);
+    if (--module->instances == 0) {
+        if (!module->path.empty()) m_Watcher.Unwatch(module->path);
+        for (auto m = m_Modules.begin(); m != m_Modules.end(); ++m)
+            if (m->second.get() == module) { m_Modules.erase(m); break; }
     }
+}
 
-    // ── return expr ─────────────────────────────────────────────────────
-    if (tok.kind == Token::Return) {
-        ++pos;
-        ScriptValue val;
-        if (pos < tokens.size() && tokens[pos].kind != Token::Semicolon &&
-            tokens[pos].kind != Token::RBrace && tokens[pos].kind != Token::Eof)
-            val = ExecuteExpression(tokens, pos);
-        if (pos < tokens.size() && tokens[pos].kind == Token::Semicolon) ++pos;
-        return val;
-    }
+bool ScriptEngine::CallInstance(u32 id, const std::string& funcName) {
+    auto it = m_Instances.find(id);
+    if (it == m_Instances.end()) return false;
+    VMString* name = m_VM.GetHeap().FindString(funcName);
+    const VMValue* fn = name ? it->second.env->Find(VMValue::Object(name)) : nullptr;
+    if (!fn || !fn->IsClosure() || it->second.terminated) return false;
+    m_SelfObject = it->second.self;
+    EnterSandbox(id);
+    bool ok = m_VM.Call(*fn);
+    LeaveSandbox();
+    if (!ok) return InstanceFailed(id, "Error in " + funcName + ": ");
+    return true;
+}
 
-    // ── Expression statement ────────────────────────────────────────────
-    ScriptValue val = ExecuteExpression(tokens, pos);
-    if (pos < tokens.size() && tokens[pos].kind == Token::Semicolon) ++pos;
-    return val;
+bool ScriptEngine::CallInstance(u32 id, const std::string& funcName, f32 arg) {
+    auto it = m_Instances.find(id);
+    if (it == m_Instances.end()) return false;
+    VMString* name = m_VM.GetHeap().FindString(funcName);
+    const VMValue* fn = name ? it->second.env->Find(VMValue::Object(name)) : nullptr;
+    if (!fn || !fn->IsClosure() || it->second.terminated) return false;
+    VMValue dt = VMValue::Number(static_cast<f64>(arg));
+    m_VM.SetGlobal("dt", dt);
+    m_SelfObject = it->second.self;
+    EnterSandbox(id);
+    bool ok = m_VM.Call(*fn, { &dt, 1 });
+    LeaveSandbox();
+    if (!ok) return InstanceFailed(id, "Error in " + funcName + ": ");
+    return true;
 }
 
-ScriptValue ScriptEngine::ExecuteBlock(const std::vector<Token>& tokens, size_t& pos) {
-    ScriptValue last;
-    if (pos < tokens.size() && tokens[pos].kind == Token::LBrace) {
-        ++pos;
-        while (pos < tokens.size() && tokens[pos].kind != Token::RBrace && tokens[pos].kind != Token::Eof)
-            last = ExecuteStatement(tokens, pos);
-        if (pos < tokens.size() && tokens[pos].kind == Token::RBrace) ++pos;
-    } else {
-        last = ExecuteStatement(tokens, pos);
-    }
-    return last;
-}
-
-// ── Expression hierarchy ────────────────────────────────────────────────
-ScriptValue ScriptEngine::ExecuteExpression(const std::vector<Token>& tokens, size_t& pos) {
-    return ExecuteComparison(tokens, pos);
-}
-
-ScriptValue ScriptEngine::ExecuteComparison(const std::vector<Token>& tokens, size_t& pos) {
-    ScriptValue left = ExecuteAddSub(tokens, pos);
-    while (pos < tokens.size()) {
-        auto k = tokens[pos].kind;
-        if (k == Token::Eq || k == Token::Neq || k == Token::Lt || k == Token::Gt ||
-            k == Token::Lte || k == Token::Gte || k == Token::And || k == Token::Or) {
-            ++pos;
-            ScriptValue right = ExecuteAddSub(tokens, pos);
-            switch (k) {
-                case Token::Eq:  left = ScriptValue(left.AsNumber() == right.AsNumber()); break;
-                case Token::Neq: left = ScriptValue(left.AsNumber() != right.AsNumber()); break;
-                case Token::Lt:  left = ScriptValue(left.AsNumber() <  right.AsNumber()); break;
-                case Token::Gt:  left = ScriptValue(left.AsNumber() >  right.AsNumber()); break;
-                case Token::Lte: left = ScriptValue(left.AsNumber() <= right.AsNumber()); break;
-                case Token::Gte: left = ScriptValue(left.AsNumber() >= right.AsNumber()); break;
-                case Token::And: left = ScriptValue(left.AsBool() && right.AsBool()); break;
-                case Token::Or:  left = ScriptValue(left.AsBool() || right.AsBool()); break;
-                default: break;
-            }
-        } else break;
-    }
-    return left;
-}
-
-ScriptValue ScriptEngine::ExecuteAddSub(const std::vector<Token>& tokens, size_t& pos) {
-    ScriptValue left = ExecuteMulDiv(tokens, pos);
-    while (pos < tokens.size()) {
-        if (tokens[pos].kind == Token::Plus) {
-            ++pos; ScriptValue r = ExecuteMulDiv(tokens, pos);
-            left = (left.type == ScriptValue::String || r.type == ScriptValue::String)
-                       ? ScriptValue(left.AsString() + r.AsString())
-                       : ScriptValue(left.AsNumber() + r.AsNumber());
-        } else if (tokens[pos].kind == Token::Minus) {
-            ++pos; ScriptValue r = ExecuteMulDiv(tokens, pos);
-            left = ScriptValue(left.AsNumber() - r.AsNumber());
-        } else break;
-    }
-    return left;
-}
-
-ScriptValue ScriptEngine::ExecuteMulDiv(const std::vector<Token>& tokens, size_t& pos) {
-    ScriptValue left = ExecuteUnary(tokens, pos);
-    while (pos < tokens.size()) {
-        if (tokens[pos].kind == Token::Star) {
-            ++pos; left = ScriptValue(left.AsNumber() * ExecuteUnary(tokens, pos).AsNumber());
-        } else if (tokens[pos].kind == Token::Slash) {
-            ++pos; f64 d = ExecuteUnary(tokens, pos).AsNumber();
-            left = ScriptValue(d != 0 ? left.AsNumber() / d : 0.0);
-        } else if (tokens[pos].kind == Token::Percent) {
-            ++pos; f64 d = ExecuteUnary(tokens, pos).AsNumber();
-            left = ScriptValue(d != 0 ? std::fmod(left.AsNumber(), d) : 0.0);
-        } else break;
-    }
-    return left;
+ScriptValue ScriptEngine::GetInstanceVariable(u32 id, const std::string& name) const {
+    auto it = m_Instances.find(id);
+    if (it == m_Instances.end()) return {};
+    VMString* key = m_VM.GetHeap().FindString(name);
+    const VMValue* v = key ? it->second.env->Find(VMValue::Object(key)) : nullptr;
+    return v ? ToScriptValue(*v) : ScriptValue();
 }
 
-ScriptValue ScriptEngine::ExecuteUnary(const std::vector<Token>& tokens, size_t& pos) {
-    if (pos < tokens.size() && tokens[pos].kind == Token::Minus) { ++pos; return ScriptValue(-ExecutePrimary(tokens, pos).AsNumber()); }
-    if (pos < tokens.size() && tokens[pos].kind == Token::Not)   { ++pos; return ScriptValue(!ExecutePrimary(tokens, pos).AsBool());   }
-    return ExecutePrimary(tokens, pos);
+// ============================================================================
+// Hot reload
+// ============================================================================
+bool ScriptEngine::ReloadScript(const std::string& path) {
+    if (!m_Initialised) return false;
+    auto it = m_Modules.find(FileWatcher::Normalise(path));
+    if (it == m_Modules.end()) return false;
+    std::string source;
+    if (!ReadSource(it->second->path, source))
+        return ReloadFailed(*it->second, "cannot read file");
+    return ReloadModule(*it->second, source);
 }
 
-ScriptValue ScriptEngine::ExecutePrimary(const std::vector<Token>& tokens, size_t& pos) {
-    if (pos >= tokens.size() || tokens[pos].kind == Token::Eof) return {};
-    const Token& tok = tokens[pos];
+bool ScriptEngine::ReloadFailed(const ScriptModule& module, const std::string& error) {
+    m_LastError = "Reload of " + module.path + " failed, keeping the old version: " + error;
+    GV_LOG_ERROR("ScriptEngine — " + m_LastError);
+    EventBus::Instance().EmitSignal("script_reload_failed", module.path + ": " + error);
+    return false;
+}
 
-    if (tok.kind == Token::Number) { ++pos; return ScriptValue(tok.numVal); }
-    if (tok.kind == Token::Str)    { ++pos; return ScriptValue(tok.text); }
-    if (tok.kind == Token::True_)  { ++pos; return ScriptValue(true); }
-    if (tok.kind == Token::False_) { ++pos; return ScriptValue(false); }
+bool ScriptEngine::ReloadModule(ScriptModule& module, const std::string& source) {
+    // Editors often touch a file without changing it.
+    const u64 hash = HashSource(source);
+    if (module.chunk && hash == module.sourceHash) return true;
+
+    VMHeap& heap = m_VM.GetHeap();
+    VMFunction* chunk = m_VM.Compile(source, module.path);
+    if (!chunk) return ReloadFailed(module, m_VM.GetLastError());
+    VMTempRoot chunkRoot(heap, VMValue::Object(chunk));
+
+    // Re-run the chunk in each instance's own env (so the closures it makes
+    // see that env), keeping a copy of the old contents to merge from — or
+    // to put back if any instance fails.
+    struct Staged { VMMap* env; VMMap* old; };
+    std::vector<Staged> staged;
+    GameObject* prevSelf = m_SelfObject;
+    auto rollback = [&]() {
+        for (Staged& s : staged) { ClearMap(heap, s.env); CopyMap(heap, s.env, s.old); }
+        for (size_t i = 0; i < staged.size(); ++i) heap.PopRoot();
+        m_SelfObject = prevSelf;
+    };
+    for (auto& kv : m_Instances) {
+        ScriptInstance& inst = kv.second;
+        if (inst.module != &module) continue;
+        VMMap* old = heap.NewMap();
+        heap.PushRoot(VMValue::Object(old));
+        CopyMap(heap, old, inst.env);
+        staged.push_back({ inst.env, old });
+        ClearMap(heap, inst.env);
+        m_SelfObject = inst.self;
+        EnterSandbox(kv.first);
+        bool ok = m_VM.RunChunk(chunk, inst.env);
+        LeaveSandbox();
+        if (!ok) {
+            std::string error = m_VM.GetLastError();
+            rollback();
+            return ReloadFailed(module, error);
+        }
+    }
 
-    // Parenthesised
-    if (tok.kind == Token::LParen) {
-        ++pos; ScriptValue v = ExecuteExpression(tokens, pos);
-        if (pos < tokens.size() && tokens[pos].kind == Token::RParen) ++pos;
-        return v;
+    // Commit: the new definitions stay; plain values the new version still
+    // declares with the same type come back from the old env.
+    for (Staged& s : staged) {
+        for (u32 i = 0; i < s.env->Size(); ++i) {
+            VMValue fresh = s.env->values[i];
+            const VMValue* prior = s.old->Find(s.env->keys[i]);
+            if (!prior || fresh.IsClosure() || prior->IsClosure()) continue;
+            if (fresh.IsNil() || std::string_view(ScriptVM::TypeName(fresh)) == ScriptVM::TypeName(*prior)) {
+                s.env->values[i] = *prior;
+                heap.Barrier(s.env, *prior);
+            }
+        }
     }
+    for (size_t i = 0; i < staged.size(); ++i) heap.PopRoot();
+    m_SelfObject = prevSelf;
+
+    module.chunk = chunk;
+    module.sourceHash = hash;
+    m_LastError.clear();
+    GV_LOG_INFO("ScriptEngine — reloaded " + module.path + " (" +
+                std::to_string(staged.size()) + " instance(s))");
+    EventBus::Instance().EmitSignal("script_reloaded", module.path);
+    return true;
+}
 
-    // Identifier — variable / assignment / function call
-    if (tok.kind == Token::Ident) {
-        std::string name = tok.text; ++pos;
+// ============================================================================
+// Sandboxing
+// ============================================================================
+void ScriptEngine::DefineCapability(const std::string& name, std::vector<std::string> natives) {
+    m_Capabilities[name] = std::move(natives);
+    for (auto& kv : m_Instances) kv.second.allowed.reset();     // rebuilt on next use
+}
 
-        // assignment
-        if (pos < tokens.size() && tokens[pos].kind == Token::Assign) {
-            ++pos; ScriptValue v = ExecuteExpression(tokens, pos);
-            m_Variables[name] = v;
-            return v;
-        }
+bool ScriptEngine::SetInstanceSandbox(u32 id, const ScriptSandbox& sandbox) {
+    auto it = m_Instances.find(id);
+    if (it == m_Instances.end()) return false;
+    it->second.sandbox = sandbox;
+    it->second.allowed.reset();
+    return true;
+}
+
+bool ScriptEngine::IsInstanceTerminated(u32 id) const {
+    auto it = m_Instances.find(id);
+    return it != m_Instances.end() && it->second.terminated;
+}
 
-        // function call
-        if (pos < tokens.size() && tokens[pos].kind == Token::LParen) {
-            ++pos;
-            std::vector<ScriptValue> args;
-            while (pos < tokens.size() && tokens[pos].kind != Token::RParen) {
-                args.push_back(ExecuteExpression(tokens, pos));
-                if (pos < tokens.size() && tokens[pos].kind == Token::Comma) ++pos;
+void ScriptEngine::EnterSandbox(u32 id) {
+    // A call nested in a running script stays under that script's limits.
+    if (m_VM.IsRunning()) return;
+    auto it = m_Instances.find(id);
+    if (it == m_Instances.end()) { LeaveSandbox(); return; }
+    ScriptInstance& inst = it->second;
+
+    if (!m_Sandboxed) m_HostLimits = m_VM.GetLimits();
+    const u32 natives = m_VM.GetNativeCount();
+    if (!inst.sandbox.capabilities.empty() && (!inst.allowed || inst.allowedFor != natives)) {
+        inst.allowed = MakeShared<std::vector<bool>>(natives, false);
+        for (const std::string& cap : inst.sandbox.capabilities) {
+            auto group = m_Capabilities.find(cap);
+            if (group == m_Capabilities.end()) {
+                i32 index = m_VM.NativeIndex(cap);
+                if (index >= 0) (*inst.allowed)[index] = true;
+                continue;
             }
-            if (pos < tokens.size()) ++pos; // skip )
-
-            // native
-            auto nit = m_NativeFunctions.find(name);
-            if (nit != m_NativeFunctions.end()) return nit->second(args);
-
-            // script
-            auto sit = m_ScriptFunctions.find(name);
-            if (sit != m_ScriptFunctions.end()) {
-                auto& fn = sit->second;
-                for (size_t j = 0; j < fn.params.size() && j < args.size(); ++j)
-                    m_Variables[fn.params[j]] = args[j];
-                size_t bp = 0; ScriptValue res;
-                while (bp < fn.body.size() && fn.body[bp].kind != Token::Eof)
-                    res = ExecuteStatement(fn.body, bp);
-                return res;
+            for (const std::string& name : group->second) {
+                i32 index = m_VM.NativeIndex(name);
+                if (index >= 0) (*inst.allowed)[index] = true;
             }
-            m_LastError = "Unknown function: " + name;
-            GV_LOG_WARN("[Script] " + m_LastError);
-            return {};
         }
-
-        // variable
-        auto it = m_Variables.find(name);
-        return (it != m_Variables.end()) ? it->second : ScriptValue();
+        inst.allowedFor = natives;
     }
+    m_VM.SetLimits(inst.sandbox.limits);
+    m_ActiveMask = inst.sandbox.capabilities.empty() ? nullptr : inst.allowed;
+    m_VM.SetAllowedNatives(m_ActiveMask.get());
+    m_Sandboxed = id;
+}
 
-    ++pos;
-    return {};
+void ScriptEngine::LeaveSandbox() {
+    if (m_VM.IsRunning() || !m_Sandboxed) return;
+    m_VM.SetLimits(m_HostLimits);
+    m_VM.SetAllowedNatives(nullptr);
+    m_ActiveMask.reset();
+    m_Sandboxed = 0;
 }
 
-ScriptValue ScriptEngine::CallNative(const std::string& name, const std::vector<ScriptValue>& args) {
-    auto it = m_NativeFunctions.find(name);
-    return (it != m_NativeFunctions.end()) ? it->second(args) : ScriptValue();
+bool ScriptEngine::InstanceFailed(u32 id, const std::string& context) {
+    const VMFault fault = m_VM.GetLastFault();
+    const std::string error = m_VM.GetLastError();
+    Report(context);
+    if (fault != VMFault::None && fault != VMFault::Error) Terminate(id, error);
+    return false;
+}
+
+void ScriptEngine::Terminate(u32 id, const std::string& reason) {
+    auto it = m_Instances.find(id);
+    if (it == m_Instances.end() || it->second.terminated) return;
+    ScriptInstance& inst = it->second;
+    inst.terminated = true;
+    GameObject* self = inst.self;
+    const std::string path = inst.module->path.empty() ? "(inline source)" : inst.module->path;
+
+    if (self) {
+        m_Scheduler.StopContext(self);
+        for (const auto& comp : self->GetComponents()) {
+            auto* sc = dynamic_cast<ScriptComponent*>(comp.get());
+            if (sc && sc->GetInstance() == id) sc->SetEnabled(false);
+        }
+    }
+    m_LastError = "Script " + path + " terminated: " + reason;
+    GV_LOG_ERROR("ScriptEngine — " + m_LastError);
+    m_Debugger.SendEvent("error", m_LastError);
+    EventBus::Instance().EmitSignal("script_terminated", path + ": " + reason, self);
 }
 
 } // namespace gv
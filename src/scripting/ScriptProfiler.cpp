@@ -0,0 +1,309 @@
+// ============================================================================
+// GameVoid Engine — GVScript Profiler Implementation
+// ============================================================================
+#include "scripting/ScriptProfiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace gv {
+
+namespace {
+
+constexpr u32 kSampleStride = 97;      // instructions between clock checks when sampling
+
+i64 Nanoseconds(std::chrono::steady_clock::duration d) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+}
+
+} // anonymous namespace
+
+ScriptProfiler::ScriptProfiler(ScriptVM& vm) : m_VM(vm) {
+    m_Nodes.emplace_back();
+    m_RootMarker = m_VM.AddRootMarker([this](VMHeap& heap) {
+        for (const Node& n : m_Nodes)
+            if (n.function) heap.MarkObject(n.function);
+    });
+}
+
+ScriptProfiler::~ScriptProfiler() {
+    Stop();
+    m_VM.RemoveRootMarker(m_RootMarker);
+}
+
+// ============================================================================
+// Control
+// ============================================================================
+void ScriptProfiler::Start(Mode mode) {
+    Stop();
+    m_Mode = mode;
+    m_Running = true;
+    m_Pending = 0;
+    m_VM.AddHook(this, mode == Mode::Instrument ? 1 : kSampleStride);
+}
+
+void ScriptProfiler::Stop() {
+    if (!m_Running) return;
+    if (!m_Active.empty() && m_Mode == Mode::Instrument) Flush(Clock::now());
+    m_VM.RemoveHook(this);
+    m_Running = false;
+    m_Active.clear();
+    m_Here = {};
+}
+
+void ScriptProfiler::Reset() {
+    m_Nodes.clear();
+    m_Nodes.emplace_back();
+    m_Lines.clear();
+    m_Here = {};
+    m_Pending = 0;
+}
+
+// ============================================================================
+// Locations
+// ============================================================================
+i32 ScriptProfiler::CurrentLine(const VMFiber& fiber) {
+    if (fiber.frames.empty()) return 0;
+    const VMCallFrame& frame = fiber.frames.back();
+    const auto& lines = frame.closure->function->lines;
+    if (lines.empty()) return 0;
+    return frame.pc < lines.size() ? lines[frame.pc] : lines.back();
+}
+
+u32 ScriptProfiler::NodeFor(const VMFiber& fiber) {
+    u32 node = 0;
+    for (const VMCallFrame& frame : fiber.frames) {
+        VMFunction* fn = frame.closure->function;
+        auto it = m_Nodes[node].children.find(fn);
+        if (it != m_Nodes[node].children.end()) { node = it->second; continue; }
+        u32 child = static_cast<u32>(m_Nodes.size());
+        m_Nodes[node].children.emplace(fn, child);
+        m_Nodes.emplace_back();
+        m_Nodes.back().function = fn;
+        m_Nodes.back().parent = node;
+        node = child;
+    }
+    return node;
+}
+
+ScriptProfiler::LineStats* ScriptProfiler::Line(VMFunction* function, i32 line) {
+    return &m_Lines[function][line];
+}
+
+ScriptProfiler::Location ScriptProfiler::LocationOf(const VMFiber& fiber) {
+    Location at;
+    at.node = NodeFor(fiber);
+    if (fiber.frames.empty()) return at;
+    at.line = CurrentLine(fiber);
+    at.stats = Line(fiber.frames.back().closure->function, at.line);
+    return at;
+}
+
+void ScriptProfiler::Charge(const Location& at, i64 ns, bool sample) {
+    if (ns <= 0) return;
+    Node& node = m_Nodes[at.node];
+    node.selfNs += static_cast<u64>(ns);
+    if (sample) ++node.samples;
+    if (at.stats) {
+        at.stats->selfNs += static_cast<u64>(ns);
+        if (sample) ++at.stats->samples;
+    }
+}
+
+void ScriptProfiler::Flush(Clock::time_point now) {
+    i64 ns = Nanoseconds(now - m_Last);
+    m_Last = now;
+    if (!m_Active.empty()) Charge(m_Here, ns, false);
+}
+
+// ============================================================================
+// VMHook
+// ============================================================================
+void ScriptProfiler::OnEnter(ScriptVM&, const VMFiber& fiber) {
+    Clock::time_point now = Clock::now();
+    if (m_Mode == Mode::Instrument) {
+        Flush(now);
+        m_Active.push_back(&fiber);
+        m_Here = LocationOf(fiber);
+        return;
+    }
+    if (m_Active.empty()) m_Last = now;
+    m_Active.push_back(&fiber);
+}
+
+void ScriptProfiler::OnLeave(ScriptVM&, const VMFiber&) {
+    Clock::time_point now = Clock::now();
+    if (m_Mode == Mode::Instrument) {
+        Flush(now);
+        if (!m_Active.empty()) m_Active.pop_back();
+        m_Here = m_Active.empty() ? Location{} : LocationOf(*m_Active.back());
+        return;
+    }
+    if (m_Active.empty()) return;
+    m_Active.pop_back();
+    if (m_Active.empty()) m_Pending += Nanoseconds(now - m_Last);
+}
+
+void ScriptProfiler::OnCall(ScriptVM&, const VMFiber& fiber) {
+    if (m_Mode != Mode::Instrument) return;
+    // Coroutines are prepared outside any run: count the call all the same.
+    const bool running = !m_Active.empty() && m_Active.back() == &fiber;
+    if (running) Flush(Clock::now());
+    Location at = LocationOf(fiber);
+    ++m_Nodes[at.node].calls;
+    if (at.stats) ++at.stats->hits;
+    if (running) m_Here = at;
+}
+
+void ScriptProfiler::OnReturn(ScriptVM&, const VMFiber& fiber) {
+    if (m_Mode != Mode::Instrument || m_Active.empty() || m_Active.back() != &fiber) return;
+    Flush(Clock::now());
+    m_Here = LocationOf(fiber);
+}
+
+void ScriptProfiler::OnStep(ScriptVM&, const VMFiber& fiber) {
+    if (m_Active.empty() || fiber.frames.empty()) return;
+    if (m_Mode == Mode::Instrument) {
+        i32 line = CurrentLine(fiber);
+        if (line == m_Here.line) return;
+        Flush(Clock::now());
+        m_Here.line = line;
+        m_Here.stats = Line(fiber.frames.back().closure->function, line);
+        ++m_Here.stats->hits;
+        return;
+    }
+    Clock::time_point now = Clock::now();
+    i64 elapsed = m_Pending + Nanoseconds(now - m_Last);
+    if (elapsed < m_SampleNs) return;
+    Charge(LocationOf(fiber), elapsed, true);
+    m_Pending = 0;
+    m_Last = now;
+}
+
+// ============================================================================
+// Results
+// ============================================================================
+std::string ScriptProfiler::Label(const VMFunction* fn) {
+    std::string label = fn->name ? std::string(fn->name->View()) : std::string("<chunk>");
+    label += " (";
+    label += fn->chunk ? std::string(fn->chunk->View()) : std::string("script");
+    label += ":" + std::to_string(fn->lines.empty() ? 0 : fn->lines.front()) + ")";
+    std::replace(label.begin(), label.end(), ';', ',');      // the folded format's separator
+    return label;
+}
+
+std::vector<ScriptProfiler::FunctionStats> ScriptProfiler::GetFunctions() const {
+    // Inclusive time per node: children always come after their parent.
+    std::vector<u64> inclusive(m_Nodes.size(), 0);
+    for (size_t i = m_Nodes.size(); i-- > 1;) {
+        inclusive[i] += m_Nodes[i].selfNs;
+        inclusive[m_Nodes[i].parent] += inclusive[i];
+    }
+
+    std::unordered_map<const VMFunction*, FunctionStats> byFunction;
+    for (size_t i = 1; i < m_Nodes.size(); ++i) {
+        const Node& node = m_Nodes[i];
+        FunctionStats& fs = byFunction[node.function];
+        fs.calls   += node.calls;
+        fs.samples += node.samples;
+        fs.selfNs  += node.selfNs;
+        // A recursive path counts its outermost call only.
+        bool nested = false;
+        for (u32 p = node.parent; p != 0 && !nested; p = m_Nodes[p].parent)
+            nested = m_Nodes[p].function == node.function;
+        if (!nested) fs.totalNs += inclusive[i];
+    }
+
+    std::vector<FunctionStats> out;
+    out.reserve(byFunction.size());
+    for (auto& kv : byFunction) {
+        const VMFunction* fn = kv.first;
+        FunctionStats& fs = kv.second;
+        fs.name  = fn->name ? std::string(fn->name->View()) : std::string("<chunk>");
+        fs.chunk = fn->chunk ? std::string(fn->chunk->View()) : std::string("script");
+        fs.line  = fn->lines.empty() ? 0 : fn->lines.front();
+        auto lines = m_Lines.find(const_cast<VMFunction*>(fn));
+        if (lines != m_Lines.end())
+            for (const auto& l : lines->second) fs.lines[l.first] = l.second;
+        out.push_back(std::move(fs));
+    }
+    std::sort(out.begin(), out.end(), [](const FunctionStats& a, const FunctionStats& b) {
+        if (a.selfNs != b.selfNs) return a.selfNs > b.selfNs;
+        if (a.calls != b.calls) return a.calls > b.calls;
+        return a.name < b.name;
+    });
+    return out;
+}
+
+std::string ScriptProfiler::Report(u32 count) const {
+    const bool sampled = m_Mode == Mode::Sample;
+    std::vector<FunctionStats> functions = GetFunctions();
+    u64 total = 0;
+    for (const auto& fs : functions) total += fs.selfNs;
+
+    char buf[256];
+    std::snprintf(buf, sizeof(buf), "GVScript profile (%s): %.3f ms of script time\n",
+                  sampled ? "sampled" : "instrumented", static_cast<f64>(total) / 1e6);
+    std::string out = buf;
+    std::snprintf(buf, sizeof(buf), "%10s %10s %10s  %s\n", "self ms", "total ms", sampled ? "samples" : "calls", "function");
+    out += buf;
+
+    for (size_t i = 0; i < functions.size() && i < count; ++i) {
+        const FunctionStats& fs = functions[i];
+        std::snprintf(buf, sizeof(buf), "%10.3f %10.3f %10llu  %s  %s:%d\n",
+                      static_cast<f64>(fs.selfNs) / 1e6, static_cast<f64>(fs.totalNs) / 1e6,
+                      static_cast<unsigned long long>(sampled ? fs.samples : fs.calls),
+                      fs.name.c_str(), fs.chunk.c_str(), fs.line);
+        out += buf;
+
+        // The three hottest lines.
+        std::vector<std::pair<i32, LineStats>> lines(fs.lines.begin(), fs.lines.end());
+        std::sort(lines.begin(), lines.end(), [](const auto& a, const auto& b) {
+            return a.second.selfNs != b.second.selfNs ? a.second.selfNs > b.second.selfNs : a.first < b.first;
+        });
+        for (size_t l = 0; l < lines.size() && l < 3; ++l) {
+            if (lines[l].second.selfNs == 0) break;
+            std::snprintf(buf, sizeof(buf), "%10.3f %10s %10llu    line %d\n",
+                          static_cast<f64>(lines[l].second.selfNs) / 1e6, "",
+                          static_cast<unsigned long long>(sampled ? lines[l].second.samples : lines[l].second.hits),
+                          lines[l].first);
+            out += buf;
+        }
+    }
+    return out;
+}
+
+std::string ScriptProfiler::FoldedStacks() const {
+    std::string out;
+    struct Item { u32 node; std::string path; };
+    std::vector<Item> stack;
+    stack.push_back({ 0, "" });
+    while (!stack.empty()) {
+        Item item = std::move(stack.back());
+        stack.pop_back();
+        const Node& node = m_Nodes[item.node];
+        u64 us = node.selfNs / 1000;
+        if (item.node != 0 && us > 0) out += item.path + " " + std::to_string(us) + "\n";
+
+        // Children in reverse label order, so they pop sorted.
+        std::vector<std::pair<std::string, u32>> children;
+        for (const auto& kv : node.children) children.emplace_back(Label(kv.first), kv.second);
+        std::sort(children.begin(), children.end());
+        for (size_t i = children.size(); i-- > 0;)
+            stack.push_back({ children[i].second,
+                              item.path.empty() ? children[i].first : item.path + ";" + children[i].first });
+    }
+    return out;
+}
+
+bool ScriptProfiler::WriteFoldedStacks(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        GV_LOG_ERROR("ScriptProfiler — cannot write '" + path + "'");
+        return false;
+    }
+    file << FoldedStacks();
+    return static_cast<bool>(file);
+}
+
+} // namespace gv
@@ -0,0 +1,401 @@
+// ============================================================================
+// GameVoid Engine — GVScript Coroutine Scheduler Implementation
+// ============================================================================
+#include "scripting/ScriptScheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace gv {
+
+// ============================================================================
+// TimerWheel
+// ============================================================================
+u32 TimerWheel::Add(u64 expiry, u64 payload) {
+    u32 h;
+    if (!m_FreeNodes.empty()) { h = m_FreeNodes.back(); m_FreeNodes.pop_back(); }
+    else { h = static_cast<u32>(m_Nodes.size()); m_Nodes.emplace_back(); }
+    Node& n = m_Nodes[h];
+    n.expiry  = std::max(expiry, m_Now + 1);
+    n.payload = payload;
+    Link(h);
+    ++m_Count;
+    return h;
+}
+
+void TimerWheel::Cancel(u32 h) {
+    if (h >= m_Nodes.size() || m_Nodes[h].list == kInvalid) return;
+    Unlink(h);
+    m_Nodes[h].list = kInvalid;
+    m_FreeNodes.push_back(h);
+    --m_Count;
+}
+
+void TimerWheel::Clear(u64 now) {
+    m_Nodes.clear();
+    m_FreeNodes.clear();
+    for (auto& l : m_Lists) l = List();
+    m_Now = now;
+    m_Count = 0;
+}
+
+void TimerWheel::Link(u32 h) {
+    Node& n = m_Nodes[h];
+    // The first level whose block distance fits in one revolution; timers
+    // past the top level's horizon park in its farthest slot and are
+    // re-linked each time they come round.
+    u32 level = 0;
+    u64 slotTick = n.expiry;
+    for (; level < kLevels; ++level) {
+        u32 shift = level * kSlotBits;
+        if ((n.expiry >> shift) - (m_Now >> shift) < kSlots) break;
+    }
+    if (level == kLevels) {
+        level = kLevels - 1;
+        slotTick = m_Now + (static_cast<u64>(kSlots - 1) << (level * kSlotBits));
+    }
+    u32 slot = static_cast<u32>((slotTick >> (level * kSlotBits)) & kSlotMask);
+    u32 li = level * kSlots + slot;
+    List& l = m_Lists[li];
+    n.list = li;
+    n.prev = l.tail;
+    n.next = kInvalid;
+    if (l.tail != kInvalid) m_Nodes[l.tail].next = h;
+    else                    l.head = h;
+    l.tail = h;
+}
+
+void TimerWheel::Unlink(u32 h) {
+    Node& n = m_Nodes[h];
+    List& l = m_Lists[n.list];
+    if (n.prev != kInvalid) m_Nodes[n.prev].next = n.next; else l.head = n.next;
+    if (n.next != kInvalid) m_Nodes[n.next].prev = n.prev; else l.tail = n.prev;
+    n.prev = n.next = kInvalid;
+}
+
+void TimerWheel::Cascade(u32 level) {
+    u32 slot = static_cast<u32>((m_Now >> (level * kSlotBits)) & kSlotMask);
+    List& l = m_Lists[level * kSlots + slot];
+    u32 h = l.head;
+    l = List();
+    while (h != kInvalid) {
+        u32 next = m_Nodes[h].next;
+        Link(h);
+        h = next;
+    }
+}
+
+void TimerWheel::Advance(u64 tick, std::vector<Expired>& out) {
+    while (m_Now < tick) {
+        if (m_Count == 0) { m_Now = tick; return; }
+        ++m_Now;
+        // Pull the next block of each level down, top level first, so a
+        // timer can fall through several levels in one tick.
+        for (u32 level = kLevels - 1; level >= 1; --level) {
+            u64 mask = (1ull << (level * kSlotBits)) - 1;
+            if ((m_Now & mask) == 0) Cascade(level);
+        }
+        List& l = m_Lists[m_Now & kSlotMask];
+        u32 h = l.head;
+        l = List();
+        while (h != kInvalid) {
+            Node& n = m_Nodes[h];
+            u32 next = n.next;
+            if (n.expiry <= m_Now) {
+                out.push_back({ n.expiry, n.payload });
+                n.list = kInvalid;
+                m_FreeNodes.push_back(h);
+                --m_Count;
+            } else {
+                Link(h);            // parked beyond the horizon
+            }
+            h = next;
+        }
+    }
+}
+
+// ============================================================================
+// ScriptScheduler
+// ============================================================================
+ScriptScheduler::ScriptScheduler(ScriptVM& vm) : m_VM(vm) {
+    m_RootMarker = m_VM.AddRootMarker([this](VMHeap& heap) { MarkRoots(heap); });
+}
+
+ScriptScheduler::~ScriptScheduler() {
+    StopAll();
+    m_VM.RemoveRootMarker(m_RootMarker);
+}
+
+void ScriptScheduler::MarkRoots(VMHeap& heap) {
+    for (const auto& co : m_Coroutines) {
+        if (co->state == State::Free) continue;
+        ScriptVM::MarkFiber(heap, co->fiber);
+        heap.MarkValue(co->resumeValue);
+        if (co->event) heap.MarkObject(co->event);
+    }
+    for (const auto& kv : m_EventWaiters) heap.MarkObject(kv.first);
+    if (m_PendingEvent) heap.MarkObject(m_PendingEvent);
+}
+
+ScriptScheduler::Coroutine* ScriptScheduler::Find(CoroutineID id) const {
+    if (id == 0) return nullptr;
+    u32 index = IndexOf(id);
+    if (index >= m_Coroutines.size()) return nullptr;
+    Coroutine* co = m_Coroutines[index].get();
+    if (co->state == State::Free || MakeID(index) != id) return nullptr;
+    return co;
+}
+
+ScriptScheduler::CoroutineID ScriptScheduler::Start(VMValue callee, ScriptArgs args, void* context) {
+    u32 index;
+    if (!m_FreeList.empty()) {
+        index = m_FreeList.back();
+        m_FreeList.pop_back();
+    } else {
+        if (m_Coroutines.size() >= 0xFFFFFu) {
+            m_VM.SetLastError("too many coroutines");
+            return 0;
+        }
+        index = static_cast<u32>(m_Coroutines.size());
+        m_Coroutines.push_back(MakeUnique<Coroutine>());
+    }
+    Coroutine& co = *m_Coroutines[index];
+    if (!m_VM.PrepareFiber(co.fiber, callee, args)) {
+        m_FreeList.push_back(index);
+        return 0;
+    }
+    co.context = context;
+    co.stopRequested = false;
+    ++m_Live;
+    CoroutineID id = MakeID(index);
+    MakeReady(index, VMValue());
+    return id;
+}
+
+void ScriptScheduler::MakeReady(u32 index, VMValue value) {
+    Coroutine& co = *m_Coroutines[index];
+    co.state = State::Ready;
+    co.resumeValue = value;
+    m_Ready.push_back(MakeID(index));
+}
+
+void ScriptScheduler::Release(u32 index) {
+    Coroutine& co = *m_Coroutines[index];
+    if (co.state == State::Free) return;
+    if (co.timer != TimerWheel::kInvalid) { m_Wheel.Cancel(co.timer); co.timer = TimerWheel::kInvalid; }
+    if (co.event) {
+        auto it = m_EventWaiters.find(co.event);
+        if (it != m_EventWaiters.end()) {
+            CoroutineID id = MakeID(index);
+            auto& list = it->second;
+            list.erase(std::remove_if(list.begin(), list.end(),
+                                      [id](const Waiter& w) { return w.id == id; }), list.end());
+            if (list.empty()) m_EventWaiters.erase(it);
+        }
+        co.event = nullptr;
+    }
+    m_VM.ResetFiber(co.fiber);
+    co.state = State::Free;
+    co.context = nullptr;
+    co.resumeValue = VMValue();
+    co.stopRequested = false;
+    ++co.generation;
+    m_FreeList.push_back(index);
+    --m_Live;
+}
+
+bool ScriptScheduler::Stop(CoroutineID id) {
+    Coroutine* co = Find(id);
+    if (!co) return false;
+    if (co->state == State::Running) { co->stopRequested = true; return true; }
+    Release(IndexOf(id));
+    return true;
+}
+
+void ScriptScheduler::StopContext(void* context) {
+    for (u32 i = 0; i < m_Coroutines.size(); ++i) {
+        Coroutine& co = *m_Coroutines[i];
+        if (co.state == State::Free || co.context != context) continue;
+        if (co.state == State::Running) co.stopRequested = true;
+        else Release(i);
+    }
+}
+
+void ScriptScheduler::StopAll() {
+    for (u32 i = 0; i < m_Coroutines.size(); ++i) {
+        Coroutine& co = *m_Coroutines[i];
+        if (co.state == State::Running) co.stopRequested = true;
+        else Release(i);
+    }
+    m_Ready.clear();
+}
+
+bool ScriptScheduler::IsRunning(CoroutineID id) const { return Find(id) != nullptr; }
+
+void ScriptScheduler::Signal(std::string_view name, VMValue data) {
+    VMString* key = m_VM.GetHeap().FindString(name);
+    if (!key) return;
+    auto it = m_EventWaiters.find(key);
+    if (it == m_EventWaiters.end()) return;
+    std::vector<Waiter> waiters = std::move(it->second);
+    m_EventWaiters.erase(it);
+    for (const Waiter& w : waiters) {
+        Coroutine* co = Find(w.id);
+        if (!co || co->state != State::WaitingEvent || co->event != key) continue;
+        co->event = nullptr;
+        MakeReady(IndexOf(w.id), data);
+    }
+}
+
+void ScriptScheduler::SetTickRate(f64 ticksPerSecond) {
+    if (ticksPerSecond <= 0 || m_Wheel.GetCount() != 0) return;
+    m_TickRate = ticksPerSecond;
+    m_Ticks = m_Time * m_TickRate;
+    m_Wheel.Clear(static_cast<u64>(std::floor(m_Ticks + 1e-6)));
+}
+
+void ScriptScheduler::Update(f64 dt) {
+    if (dt > 0) {
+        m_Time += dt;
+        m_Ticks += dt * m_TickRate;
+    }
+
+    // Sleepers whose tick has come, in (expiry, wait order).  The epsilon
+    // keeps accumulated rounding from landing a frame just short of a tick.
+    m_Expired.clear();
+    m_Wheel.Advance(static_cast<u64>(std::floor(m_Ticks + 1e-6)), m_Expired);
+    std::sort(m_Expired.begin(), m_Expired.end(), [](const TimerWheel::Expired& a, const TimerWheel::Expired& b) {
+        return a.expiry != b.expiry ? a.expiry < b.expiry : a.payload < b.payload;
+    });
+    for (const auto& e : m_Expired) {
+        u32 index = static_cast<u32>(e.payload & 0xFFFFFu);
+        Coroutine& co = *m_Coroutines[index];
+        co.timer = TimerWheel::kInvalid;
+        MakeReady(index, VMValue());
+    }
+
+    // Whatever is ready now runs; anything readied meanwhile waits a frame.
+    m_Running.swap(m_Ready);
+    m_Ready.clear();
+    for (CoroutineID id : m_Running) ResumeOne(id);
+    m_Running.clear();
+}
+
+void ScriptScheduler::ResumeOne(CoroutineID id) {
+    Coroutine* co = Find(id);
+    if (!co || co->state != State::Ready) return;
+    const u32 index = IndexOf(id);
+
+    if (m_ResumeHook) m_ResumeHook(co->context);
+    co->state = State::Running;
+    VMValue value = co->resumeValue;
+    co->resumeValue = VMValue();
+
+    const u32 prevCurrent = m_Current;
+    m_Current = index;
+    m_PendingWait = Wait::None;
+    VMResumeResult r = m_VM.Resume(co->fiber, value);
+    m_Current = prevCurrent;
+    ++m_Resumes;
+
+    if (r == VMResumeResult::Error) {
+        std::string message = m_VM.GetLastError();
+        Release(index);
+        if (m_OnError) m_OnError(id, message);
+        return;
+    }
+    if (r == VMResumeResult::Finished || co->stopRequested) {
+        Release(index);
+        return;
+    }
+
+    ++m_Order;
+    switch (m_PendingWait) {
+        case Wait::Sleep:
+            co->state = State::Sleeping;
+            co->timer = m_Wheel.Add(m_PendingTick, (m_Order << 20) | index);
+            break;
+        case Wait::Event:
+            co->state = State::WaitingEvent;
+            co->event = m_PendingEvent;
+            m_EventWaiters[m_PendingEvent].push_back({ id, m_Order });
+            m_PendingEvent = nullptr;
+            break;
+        case Wait::None:
+            MakeReady(index, VMValue());        // plain yield: next frame
+            break;
+    }
+    m_PendingWait = Wait::None;
+}
+
+ScriptScheduler::Stats ScriptScheduler::GetStats() const {
+    Stats s;
+    s.live = m_Live;
+    s.sleeping = m_Wheel.GetCount();
+    for (const auto& kv : m_EventWaiters) s.waitingEvent += static_cast<u32>(kv.second.size());
+    s.ready = static_cast<u32>(m_Ready.size());
+    s.resumes = m_Resumes;
+    return s;
+}
+
+// ============================================================================
+// Natives
+// ============================================================================
+void ScriptScheduler::RegisterNatives() {
+    auto requireCoroutine = [this]() {
+        if (m_Current == TimerWheel::kInvalid || !m_VM.CanSuspend())
+            throw std::runtime_error("only valid inside a coroutine");
+    };
+
+    // wait(seconds) — sleep on the simulated clock
+    m_VM.RegisterNative("wait", [this, requireCoroutine](ScriptVM& vm, ScriptArgs a) -> VMValue {
+        requireCoroutine();
+        f64 seconds = a.Number(0);
+        if (!(seconds > 0)) seconds = 0;
+        m_PendingWait = Wait::Sleep;
+        m_PendingTick = m_Wheel.GetNow() + static_cast<u64>(std::llround(seconds * m_TickRate));
+        vm.RequestSuspend();
+        return {};
+    });
+
+    // wait_event(name) → the signal's data
+    m_VM.RegisterNative("wait_event", [this, requireCoroutine](ScriptVM& vm, ScriptArgs a) -> VMValue {
+        requireCoroutine();
+        VMValue name = a[0].IsString() ? a[0] : vm.String(vm.ToString(a[0]));
+        m_PendingWait = Wait::Event;
+        m_PendingEvent = name.AsString();
+        vm.RequestSuspend();
+        return {};
+    });
+
+    // start_coroutine(func, args...) → id (0 on failure)
+    m_VM.RegisterNative("start_coroutine", [this](ScriptVM&, ScriptArgs a) -> VMValue {
+        if (a.Empty()) return VMValue::Number(0);
+        void* context = m_Current != TimerWheel::kInvalid ? m_Coroutines[m_Current]->context
+                      : m_ContextSource ? m_ContextSource() : nullptr;
+        ScriptArgs rest{ a.argv + 1, a.argc - 1 };
+        CoroutineID id = Start(a[0], rest, context);
+        if (!id) throw std::runtime_error(m_VM.GetLastError());
+        return VMValue::Number(static_cast<f64>(id));
+    });
+
+    // stop_coroutine(id) → whether it was running
+    m_VM.RegisterNative("stop_coroutine", [this](ScriptVM& vm, ScriptArgs a) -> VMValue {
+        CoroutineID id = static_cast<CoroutineID>(a.Number(0));
+        bool stopped = Stop(id);
+        if (stopped && m_Current != TimerWheel::kInvalid && MakeID(m_Current) == id && vm.CanSuspend())
+            vm.RequestSuspend();        // stopping itself: don't run on
+        return VMValue::Bool(stopped);
+    });
+
+    m_VM.RegisterNative("coroutine_running", [this](ScriptVM&, ScriptArgs a) -> VMValue {
+        return VMValue::Bool(IsRunning(static_cast<CoroutineID>(a.Number(0))));
+    });
+
+    // sim_time() — the scheduler's simulated clock, in seconds
+    m_VM.RegisterNative("sim_time", [this](ScriptVM&, ScriptArgs) -> VMValue {
+        return VMValue::Number(m_Time);
+    });
+}
+
+} // namespace gv
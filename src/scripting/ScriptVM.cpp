@@ -0,0 +1,945 @@
+// ============================================================================
+// GameVoid Engine — GVScript Virtual Machine Implementation
+// ============================================================================
+#include "scripting/ScriptVM.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+namespace gv {
+
+namespace {
+
+constexpr u32 kMainStackSlots = 1u << 16;   // fixed: natives hold views into it
+constexpr u32 kMaxFrames      = 256;
+constexpr u64 kClockSlice     = 1024;       // instructions between wall-clock checks
+constexpr u32 kTraceHead      = 16;         // innermost / outermost frames a traceback
+constexpr u32 kTraceTail      = 16;         //   keeps; the ones between are elided
+
+std::string NumberText(f64 n) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%g", n);
+    return buf;
+}
+
+} // anonymous namespace
+
+ScriptVM::ScriptVM() {
+    m_Main.stack.resize(kMainStackSlots);
+    m_Main.growable = false;
+    m_Main.frames.reserve(kMaxFrames);
+    m_Heap.SetRootMarker([this](VMHeap& heap) { MarkRoots(heap); });
+}
+
+ScriptVM::~ScriptVM() {
+    m_Heap.SetRootMarker(nullptr);
+}
+
+void ScriptVM::MarkFiber(VMHeap& heap, const VMFiber& fiber) {
+    for (u32 i = 0; i < fiber.top; ++i) heap.MarkValue(fiber.stack[i]);
+    for (const auto& frame : fiber.frames) heap.MarkObject(frame.closure);
+    for (VMUpvalue* u = fiber.openUpvalues; u; u = u->nextOpen) heap.MarkObject(u);
+}
+
+void ScriptVM::MarkRoots(VMHeap& heap) {
+    MarkFiber(heap, m_Main);
+    for (const auto& marker : m_ExtraRoots)
+        if (marker.second) marker.second(heap);
+    for (const auto& kv : m_Globals) { heap.MarkObject(kv.first); heap.MarkValue(kv.second); }
+    for (const auto& kv : m_Functions) { heap.MarkObject(kv.first); heap.MarkObject(kv.second); }
+    for (const auto& kv : m_NativeIndex) heap.MarkObject(kv.first);
+}
+
+// ============================================================================
+// Values
+// ============================================================================
+const char* ScriptVM::TypeName(VMValue v) {
+    if (v.IsNil())    return "nil";
+    if (v.IsBool())   return "boolean";
+    if (v.IsNumber()) return "number";
+    switch (v.AsObject()->type) {
+        case VMObjectType::String:   return "string";
+        case VMObjectType::Array:    return "array";
+        case VMObjectType::Map:      return "map";
+        case VMObjectType::Closure:  return "function";
+        case VMObjectType::Function: return "prototype";
+        case VMObjectType::Upvalue:  return "upvalue";
+    }
+    return "?";
+}
+
+bool ScriptVM::Equal(VMValue a, VMValue b) {
+    if (a.IsNumber() && b.IsNumber()) return a.AsNumber() == b.AsNumber();
+    if (a == b) return true;
+    if ((a.IsNumber() || a.IsBool()) && (b.IsNumber() || b.IsBool()))
+        return a.ToNumber() == b.ToNumber();
+    return false;
+}
+
+void ScriptVM::AppendString(std::string& out, VMValue v, int depth) const {
+    if (v.IsNumber()) { out += NumberText(v.AsNumber()); return; }
+    if (v.IsBool())   { out += v.AsBool() ? "true" : "false"; return; }
+    if (v.IsNil())    { out += "nil"; return; }
+    VMObject* obj = v.AsObject();
+    switch (obj->type) {
+        case VMObjectType::String:
+            out += v.AsString()->View();
+            return;
+        case VMObjectType::Array: {
+            const auto& items = v.AsArray()->items;
+            if (depth >= 3) { out += "[…]"; return; }
+            out += '[';
+            for (size_t i = 0; i < items.size(); ++i) {
+                if (i) out += ", ";
+                AppendString(out, items[i], depth + 1);
+            }
+            out += ']';
+            return;
+        }
+        case VMObjectType::Map: {
+            const VMMap* m = v.AsMap();
+            if (depth >= 3) { out += "{…}"; return; }
+            out += '{';
+            for (u32 i = 0; i < m->Size(); ++i) {
+                if (i) out += ", ";
+                AppendString(out, m->keys[i], depth + 1);
+                out += ": ";
+                AppendString(out, m->values[i], depth + 1);
+            }
+            out += '}';
+            return;
+        }
+        case VMObjectType::Closure: {
+            const VMString* name = v.AsClosure()->function->name;
+            out += "<func ";
+            out += name ? name->View() : std::string_view("anonymous");
+            out += '>';
+            return;
+        }
+        default:
+            out += '<';
+            out += TypeName(v);
+            out += '>';
+            return;
+    }
+}
+
+std::string ScriptVM::ToString(VMValue value) const {
+    if (value.IsString()) return std::string(value.AsString()->View());
+    std::string out;
+    AppendString(out, value, 0);
+    return out;
+}
+
+bool ScriptVM::Concat(VMValue a, VMValue b, VMValue& out) {
+    std::string s;
+    AppendString(s, a, 0);
+    AppendString(s, b, 0);
+    out = String(s);
+    return true;
+}
+
+// ============================================================================
+// Tables
+// ============================================================================
+void ScriptVM::RegisterNative(std::string_view name, VMNative fn) {
+    VMString* key = m_Heap.Intern(name);
+    auto it = m_NativeIndex.find(key);
+    if (it != m_NativeIndex.end()) { m_Natives[it->second].fn = std::move(fn); return; }
+    m_NativeIndex.emplace(key, static_cast<u32>(m_Natives.size()));
+    m_Natives.push_back({ std::string(name), std::move(fn) });
+}
+
+i32 ScriptVM::NativeIndex(std::string_view name) const {
+    VMString* key = m_Heap.FindString(name);
+    auto it = key ? m_NativeIndex.find(key) : m_NativeIndex.end();
+    return it != m_NativeIndex.end() ? static_cast<i32>(it->second) : -1;
+}
+
+bool ScriptVM::HasNative(std::string_view name) const {
+    VMString* key = m_Heap.FindString(name);
+    return key && m_NativeIndex.count(key);
+}
+
+VMClosure* ScriptVM::FindFunction(std::string_view name) const {
+    VMString* key = m_Heap.FindString(name);
+    if (!key) return nullptr;
+    auto it = m_Functions.find(key);
+    return it != m_Functions.end() ? it->second : nullptr;
+}
+
+bool ScriptVM::HasFunction(std::string_view name) const { return FindFunction(name) != nullptr; }
+
+void ScriptVM::SetGlobal(std::string_view name, VMValue value) {
+    m_Globals[m_Heap.Intern(name)] = value;
+}
+
+VMValue ScriptVM::GetGlobal(std::string_view name) const {
+    VMString* key = m_Heap.FindString(name);
+    if (!key) return {};
+    auto it = m_Globals.find(key);
+    return it != m_Globals.end() ? it->second : VMValue();
+}
+
+bool ScriptVM::HasGlobal(std::string_view name) const {
+    VMString* key = m_Heap.FindString(name);
+    return key && m_Globals.count(key);
+}
+
+void ScriptVM::ClearScriptState() {
+    m_Globals.clear();
+    m_Functions.clear();
+}
+
+// ============================================================================
+// Entry points
+// ============================================================================
+bool ScriptVM::Execute(const std::string& source, const std::string& chunkName, VMMap* env) {
+    VMFunction* fn = Compile(source, chunkName);
+    return fn && RunChunk(fn, env);
+}
+
+VMFunction* ScriptVM::Compile(const std::string& source, const std::string& chunkName) {
+    VMCompiler compiler(m_Heap, &m_NativeIndex);
+    std::string error;
+    VMFunction* fn = compiler.Compile(source, chunkName, error);
+    if (!fn) Fault(VMFault::Error, error);
+    return fn;
+}
+
+bool ScriptVM::RunChunk(VMFunction* function, VMMap* env) {
+    // No safepoint between allocation and the push inside Invoke.
+    VMClosure* closure = m_Heap.NewClosure(function);
+    closure->env = env;
+    return Invoke(VMValue::Object(closure), {}, nullptr);
+}
+
+u32 ScriptVM::AddRootMarker(VMHeap::RootMarker marker) {
+    u32 id = ++m_NextRootMarker;
+    m_ExtraRoots.emplace_back(id, std::move(marker));
+    return id;
+}
+
+void ScriptVM::RemoveRootMarker(u32 id) {
+    m_ExtraRoots.erase(std::remove_if(m_ExtraRoots.begin(), m_ExtraRoots.end(),
+                                      [id](const auto& m) { return m.first == id; }),
+                       m_ExtraRoots.end());
+}
+
+bool ScriptVM::CallFunction(std::string_view name, ScriptArgs args, VMValue* result) {
+    VMClosure* fn = FindFunction(name);
+    if (!fn) return false;
+    return Invoke(VMValue::Object(fn), args, result);
+}
+
+bool ScriptVM::Call(VMValue callee, ScriptArgs args, VMValue* result) {
+    return Invoke(callee, args, result);
+}
+
+bool ScriptVM::Invoke(VMValue callee, ScriptArgs args, VMValue* result) {
+    if (m_HostDepth > 0) return InvokeNested(callee, args, result);
+    BeginLimits();
+    bool ok = InvokeNested(callee, args, result);
+    EndLimits();
+    return ok;
+}
+
+bool ScriptVM::InvokeNested(VMValue callee, ScriptArgs args, VMValue* result) {
+    VMFiber& f = m_Main;
+
+    // A string callee names a native or a script function.
+    if (callee.IsString()) {
+        VMString* name = callee.AsString();
+        auto nit = m_NativeIndex.find(name);
+        if (nit != m_NativeIndex.end()) {
+            try {
+                VMValue r = m_Natives[nit->second].fn(*this, args);
+                if (result) *result = r;
+                m_LastError.clear();
+                return true;
+            } catch (const std::exception& e) {
+                m_LastError = m_Natives[nit->second].name + ": " + e.what();
+                return false;
+            }
+        }
+        auto fit = m_Functions.find(name);
+        if (fit == m_Functions.end()) {
+            m_LastError = "unknown function '" + std::string(name->View()) + "'";
+            return false;
+        }
+        callee = VMValue::Object(fit->second);
+    }
+    if (!callee.IsClosure()) {
+        m_LastError = std::string("attempt to call a ") + TypeName(callee);
+        return false;
+    }
+
+    const u32 base = f.top;
+    if (static_cast<size_t>(base) + 1 + args.argc > f.stack.size()) {
+        m_LastError = "script stack overflow";
+        return false;
+    }
+    f.stack[base] = callee;
+    for (u32 i = 0; i < args.argc; ++i) f.stack[base + 1 + i] = args.argv[i];
+    f.top = base + 1 + args.argc;
+
+    const size_t depth = f.frames.size();
+    ++m_HostDepth;
+    for (size_t i = 0; i < m_Hooks.size(); ++i) m_Hooks[i].first->OnEnter(*this, f);
+    bool ok = CallClosure(f, callee.AsClosure(), args.argc);
+    if (!ok) RuntimeError(f, depth, m_LastError);
+    else ok = Run(f, depth);
+    for (size_t i = 0; i < m_Hooks.size(); ++i) m_Hooks[i].first->OnLeave(*this, f);
+    --m_HostDepth;
+
+    if (!ok) {
+        CloseUpvalues(f, base);
+        f.frames.resize(depth);
+        f.top = base;
+        return false;
+    }
+    if (result) *result = f.stack[base];
+    f.top = base;
+    m_LastError.clear();        // errors a native caught along the way are stale now
+    return true;
+}
+
+// ============================================================================
+// Coroutines
+// ============================================================================
+bool ScriptVM::PrepareFiber(VMFiber& f, VMValue callee, ScriptArgs args) {
+    ResetFiber(f);
+    if (callee.IsString()) {
+        auto it = m_Functions.find(callee.AsString());
+        if (it != m_Functions.end()) callee = VMValue::Object(it->second);
+    }
+    if (!callee.IsClosure()) {
+        m_LastError = std::string("cannot run a ") + TypeName(callee) + " as a coroutine";
+        return false;
+    }
+    const size_t needed = static_cast<size_t>(args.argc) + 1;
+    if (f.stack.size() < std::max<size_t>(needed, 32)) f.stack.resize(std::max<size_t>(needed, 32));
+    f.stack[0] = callee;
+    for (u32 i = 0; i < args.argc; ++i) f.stack[1 + i] = args.argv[i];
+    f.top = 1 + args.argc;
+    if (!CallClosure(f, callee.AsClosure(), args.argc)) {
+        ResetFiber(f);
+        return false;
+    }
+    return true;
+}
+
+void ScriptVM::ResetFiber(VMFiber& f) {
+    CloseUpvalues(f, 0);
+    f.frames.clear();
+    f.top = 0;
+    f.started = false;
+}
+
+VMResumeResult ScriptVM::Resume(VMFiber& f, VMValue resumeValue, VMValue* result) {
+    if (f.frames.empty() || m_Running == &f || &f == &m_Main) {
+        m_LastError = "cannot resume a coroutine that is finished or running";
+        return VMResumeResult::Error;
+    }
+    // The suspending call's result slot (a native's, or yield's) is on top.
+    if (f.started) f.stack[f.top - 1] = resumeValue;
+    f.started = true;
+
+    const bool outermost = (m_HostDepth == 0);
+    if (outermost) BeginLimits();
+
+    VMFiber* prevRunning = m_Running;
+    const u32 prevDepth = m_RunningDepth;
+    m_Running = &f;
+    m_RunningDepth = ++m_HostDepth;
+    for (size_t i = 0; i < m_Hooks.size(); ++i) m_Hooks[i].first->OnEnter(*this, f);
+    bool ok = Run(f, 0);
+    for (size_t i = 0; i < m_Hooks.size(); ++i) m_Hooks[i].first->OnLeave(*this, f);
+    --m_HostDepth;
+    m_Running = prevRunning;
+    m_RunningDepth = prevDepth;
+    m_SuspendRequested = false;
+
+    if (outermost) EndLimits();
+    if (!ok) {
+        ResetFiber(f);
+        return VMResumeResult::Error;
+    }
+    m_LastError.clear();
+    if (!f.frames.empty()) return VMResumeResult::Suspended;
+    if (result) *result = f.stack[0];
+    ResetFiber(f);
+    return VMResumeResult::Finished;
+}
+
+// ============================================================================
+// Calls
+// ============================================================================
+bool ScriptVM::CallClosure(VMFiber& f, VMClosure* closure, u32 argc) {
+    VMFunction* fn = closure->function;
+    const u32 maxFrames = (m_Active.callDepth && m_Active.callDepth < kMaxFrames) ? m_Active.callDepth : kMaxFrames;
+    if (f.frames.size() >= maxFrames)
+        return Fault(VMFault::CallDepth, "stack overflow (call depth " + std::to_string(maxFrames) + ")");
+    // Missing arguments are nil, extra ones dropped.
+    const size_t needed = static_cast<size_t>(f.top) + (fn->arity > argc ? fn->arity - argc : 0) + fn->maxStack;
+    if (needed > f.stack.size()) {
+        if (!f.growable) { m_LastError = "script stack overflow"; return false; }
+        f.stack.resize(std::max(needed, f.stack.size() * 2));
+    }
+    while (argc < fn->arity) { f.stack[f.top++] = VMValue(); ++argc; }
+    if (argc > fn->arity) f.top -= argc - fn->arity;
+
+    VMCallFrame frame;
+    frame.closure = closure;
+    frame.pc = 0;
+    frame.base = f.top - fn->arity - 1;
+    f.frames.push_back(frame);
+    for (size_t i = 0; i < m_Hooks.size(); ++i) m_Hooks[i].first->OnCall(*this, f);
+    return true;
+}
+
+bool ScriptVM::CallNativeAt(VMFiber& f, u32 index, u32 argc) {
+    if (m_AllowedNatives && (index >= m_AllowedNatives->size() || !(*m_AllowedNatives)[index]))
+        return Fault(VMFault::Capability, m_Natives[index].name + ": not permitted for this script");
+    ScriptArgs args;
+    args.argv = f.stack.data() + f.top - argc;
+    args.argc = argc;
+    VMValue r;
+    try {
+        r = m_Natives[index].fn(*this, args);
+    } catch (const std::exception& e) {
+        m_LastError = m_Natives[index].name + ": " + e.what();
+        return false;
+    }
+    f.top -= argc;
+    f.stack[f.top - 1] = r;     // the callee slot
+    return true;
+}
+
+VMUpvalue* ScriptVM::CaptureUpvalue(VMFiber& f, u32 slot) {
+    VMUpvalue* prev = nullptr;
+    VMUpvalue* up = f.openUpvalues;
+    while (up && up->slot > slot) { prev = up; up = up->nextOpen; }
+    if (up && up->slot == slot) return up;
+    VMUpvalue* created = m_Heap.NewUpvalue(&f.stack, slot);
+    created->nextOpen = up;
+    if (prev) prev->nextOpen = created;
+    else      f.openUpvalues = created;
+    return created;
+}
+
+void ScriptVM::CloseUpvalues(VMFiber& f, u32 fromSlot) {
+    while (f.openUpvalues && f.openUpvalues->slot >= fromSlot) {
+        VMUpvalue* u = f.openUpvalues;
+        f.openUpvalues = u->nextOpen;
+        u->nextOpen = nullptr;
+        m_Heap.CloseUpvalue(u);
+    }
+}
+
+// ============================================================================
+// Limits
+// ============================================================================
+void ScriptVM::BeginLimits() {
+    m_Active = m_Limits;
+    m_Fault = VMFault::None;
+    m_CallInstructions = m_Active.instructions ? m_Active.instructions : std::numeric_limits<u64>::max();
+    m_Reserve = m_CallInstructions;
+    m_Budget = 0;
+    if (m_Active.timeMs > 0)
+        m_Deadline = std::chrono::steady_clock::now() +
+                     std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                         std::chrono::duration<f64, std::milli>(m_Active.timeMs));
+    m_Heap.SetQuota(m_Active.memoryBytes, m_Active.stringLength, m_Active.collectionSize);
+    RefillBudget();
+}
+
+void ScriptVM::EndLimits() {
+    m_InstructionCount += m_CallInstructions - (m_Reserve + m_Budget);
+    m_Heap.ClearQuota();
+}
+
+bool ScriptVM::RefillBudget() {
+    // The slice ran out: enforce the limits, then hand out the next one.
+    // A breached limit leaves a one-instruction slice, so code that goes
+    // on after a failed nested call trips it again straight away.
+    if (m_Reserve == 0) {
+        m_Budget = 1;
+        return Fault(VMFault::Instructions, "instruction limit exceeded (" + std::to_string(m_Active.instructions) + ")");
+    }
+    if (m_Active.timeMs > 0 && std::chrono::steady_clock::now() >= m_Deadline) {
+        m_Budget = 1;
+        return Fault(VMFault::Time, "time limit exceeded (" + NumberText(m_Active.timeMs) + " ms)");
+    }
+    u64 slice = m_Active.timeMs > 0 ? std::min(m_Reserve, kClockSlice) : m_Reserve;
+    if (m_StepInterval) slice = std::min<u64>(slice, m_StepInterval);
+    m_Reserve -= slice;
+    m_Budget = slice;
+    return true;
+}
+
+bool ScriptVM::Fault(VMFault fault, std::string message) {
+    m_Fault = fault;
+    m_LastError = std::move(message);
+    return false;
+}
+
+bool ScriptVM::RuntimeError(VMFiber& f, size_t stopDepth, const std::string& message) {
+    if (m_Fault == VMFault::None) m_Fault = VMFault::Error;
+    for (size_t i = 0; i < m_Hooks.size(); ++i) m_Hooks[i].first->OnError(*this, f, message);
+    std::string text;
+    const size_t frames = f.frames.size() > stopDepth ? f.frames.size() - stopDepth : 0;
+    for (size_t i = f.frames.size(); i-- > stopDepth;) {
+        // A runaway recursion would otherwise print every frame.
+        const size_t fromTop = f.frames.size() - 1 - i;
+        if (frames > kTraceHead + kTraceTail && fromTop == kTraceHead) {
+            const size_t skipped = frames - kTraceHead - kTraceTail;
+            text += "\n  ... " + std::to_string(skipped) + " more frames ...";
+            i -= skipped - 1;
+            continue;
+        }
+        const VMCallFrame& fr = f.frames[i];
+        const VMFunction* fn = fr.closure->function;
+        i32 line = (fr.pc > 0 && fr.pc <= fn->lines.size()) ? fn->lines[fr.pc - 1] : 0;
+        std::string where = (fn->chunk ? std::string(fn->chunk->View()) : std::string("script")) +
+                            ":" + std::to_string(line);
+        if (text.empty()) {
+            text = where + ": " + message;
+        } else {
+            text += "\n  at " + (fn->name ? std::string(fn->name->View()) : std::string("<chunk>")) +
+                    " (" + where + ")";
+        }
+    }
+    if (text.empty()) text = message;
+    m_LastError = text;
+
+    if (f.frames.size() > stopDepth) {
+        u32 base = f.frames[stopDepth].base;
+        CloseUpvalues(f, base);
+        f.frames.resize(stopDepth);
+        f.top = base;
+    }
+    return false;
+}
+
+// ============================================================================
+// Interpreter loop
+// ============================================================================
+bool ScriptVM::Run(VMFiber& f, size_t stopDepth) {
+    VMCallFrame*   frame;
+    VMFunction*    fn;
+    const u8*      code;
+    const VMValue* consts;
+    const u8*      ip;
+    VMValue*       slots;
+    VMValue*       sp;
+
+#define GV_VM_LOAD()                                                        \
+    do {                                                                    \
+        frame  = &f.frames.back();                                          \
+        fn     = frame->closure->function;                                  \
+        code   = fn->code.data();                                           \
+        consts = fn->constants.data();                                      \
+        ip     = code + frame->pc;                                          \
+        slots  = f.stack.data() + frame->base;                              \
+        sp     = f.stack.data() + f.top;                                    \
+    } while (0)
+#define GV_VM_SAVE()                                                        \
+    do {                                                                    \
+        frame->pc = static_cast<u32>(ip - code);                            \
+        f.top = static_cast<u32>(sp - f.stack.data());                      \
+    } while (0)
+#define GV_VM_ERROR(msg)                                                    \
+    do { GV_VM_SAVE(); return RuntimeError(f, stopDepth, (msg)); } while (0)
+#define GV_VM_SAFEPOINT()                                                   \
+    do {                                                                    \
+        GV_VM_SAVE();                                                       \
+        if (m_Heap.OverQuota()) {                                           \
+            Fault(VMFault::Memory, m_Heap.QuotaBreach());                   \
+            return RuntimeError(f, stopDepth, m_LastError);                 \
+        }                                                                   \
+        m_Heap.SafePoint();                                                 \
+    } while (0)
+#define READ_U8()  (*ip++)
+#define READ_U16() (ip += 2, static_cast<u32>(ip[-2] | (ip[-1] << 8)))
+
+    GV_VM_LOAD();
+    for (;;) {
+        if (--m_Budget == 0) {
+            GV_VM_SAVE();
+            if (!RefillBudget()) return RuntimeError(f, stopDepth, m_LastError);
+            if (m_StepInterval) Step(f);
+        }
+
+        switch (static_cast<VMOp>(*ip++)) {
+        case VMOp::Const: *sp++ = consts[READ_U16()]; break;
+        case VMOp::Nil:   *sp++ = VMValue(); break;
+        case VMOp::True:  *sp++ = VMValue::Bool(true); break;
+        case VMOp::False: *sp++ = VMValue::Bool(false); break;
+        case VMOp::Pop:   --sp; break;
+
+        case VMOp::GetLocal: *sp++ = slots[READ_U8()]; break;
+        case VMOp::SetLocal: slots[READ_U8()] = sp[-1]; break;
+        case VMOp::GetUpvalue: *sp++ = frame->closure->upvalues[READ_U8()]->Get(); break;
+        case VMOp::SetUpvalue: m_Heap.SetUpvalue(frame->closure->upvalues[READ_U8()], sp[-1]); break;
+
+        // Names resolve in the closure's instance env first, then globals,
+        // then the function table.
+        case VMOp::GetGlobal: {
+            VMString* name = consts[READ_U16()].AsString();
+            if (VMMap* env = frame->closure->env) {
+                if (const VMValue* v = env->Find(VMValue::Object(name))) { *sp++ = *v; break; }
+            }
+            auto it = m_Globals.find(name);
+            if (it != m_Globals.end()) { *sp++ = it->second; break; }
+            auto fit = m_Functions.find(name);
+            *sp++ = fit != m_Functions.end() ? VMValue::Object(fit->second) : VMValue();
+            break;
+        }
+        case VMOp::SetGlobal: {
+            VMString* name = consts[READ_U16()].AsString();
+            VMMap* env = frame->closure->env;
+            if (env && !env->Find(VMValue::Object(name))) {
+                auto it = m_Globals.find(name);
+                if (it != m_Globals.end()) { it->second = sp[-1]; break; }
+            }
+            if (env) m_Heap.MapSet(env, VMValue::Object(name), sp[-1]);
+            else     m_Globals[name] = sp[-1];
+            break;
+        }
+        case VMOp::DefineGlobal: {
+            VMString* name = consts[READ_U16()].AsString();
+            if (VMMap* env = frame->closure->env) m_Heap.MapSet(env, VMValue::Object(name), *--sp);
+            else m_Globals[name] = *--sp;
+            break;
+        }
+        case VMOp::DefineFunc: {
+            VMString* name = consts[READ_U16()].AsString();
+            if (VMMap* env = frame->closure->env) m_Heap.MapSet(env, VMValue::Object(name), *--sp);
+            else m_Functions[name] = (*--sp).AsClosure();
+            break;
+        }
+
+        case VMOp::GetIndex: {
+            VMValue key = *--sp;
+            VMValue obj = sp[-1];
+            if (obj.IsArray()) {
+                const auto& items = obj.AsArray()->items;
+                f64 k = key.ToNumber();
+                sp[-1] = (key.IsNumber() && k >= 0 && k < static_cast<f64>(items.size()))
+                             ? items[static_cast<size_t>(k)] : VMValue();
+            } else if (obj.IsMap()) {
+                const VMValue* v = obj.AsMap()->Find(key);
+                sp[-1] = v ? *v : VMValue();
+            } else if (obj.IsString()) {
+                std::string_view s = obj.AsString()->View();
+                f64 k = key.ToNumber();
+                sp[-1] = (key.IsNumber() && k >= 0 && k < static_cast<f64>(s.size()))
+                             ? String(s.substr(static_cast<size_t>(k), 1)) : VMValue();
+                GV_VM_SAFEPOINT();
+            } else {
+                GV_VM_ERROR(std::string("cannot index a ") + TypeName(obj));
+            }
+            break;
+        }
+        case VMOp::SetIndex: {
+            VMValue val = *--sp;
+            VMValue key = *--sp;
+            VMValue obj = sp[-1];
+            if (obj.IsArray()) {
+                VMArray* arr = obj.AsArray();
+                f64 k = key.ToNumber();
+                if (!key.IsNumber() || k < 0 || k > static_cast<f64>(arr->items.size()) || k != static_cast<f64>(static_cast<size_t>(k)))
+                    GV_VM_ERROR("array index " + ToString(key) + " out of range (size " +
+                                std::to_string(arr->items.size()) + ")");
+                size_t i = static_cast<size_t>(k);
+                if (i == arr->items.size()) m_Heap.ArrayPush(arr, val);
+                else                        m_Heap.ArraySet(arr, static_cast<u32>(i), val);
+            } else if (obj.IsMap()) {
+                if (key.IsNil() || (key.IsNumber() && key.AsNumber() != key.AsNumber()))
+                    GV_VM_ERROR("map key cannot be " + ToString(key));
+                m_Heap.MapSet(obj.AsMap(), key, val);
+            } else {
+                GV_VM_ERROR(std::string("cannot index-assign a ") + TypeName(obj));
+            }
+            sp[-1] = val;
+            GV_VM_SAFEPOINT();
+            break;
+        }
+        case VMOp::GetField: {
+            VMString* name = consts[READ_U16()].AsString();
+            VMValue obj = sp[-1];
+            if (obj.IsMap()) {
+                const VMValue* v = obj.AsMap()->Find(VMValue::Object(name));
+                sp[-1] = v ? *v : VMValue();
+            } else if ((obj.IsArray() || obj.IsString()) && name->View() == "length") {
+                sp[-1] = VMValue::Number(static_cast<f64>(obj.IsArray() ? obj.AsArray()->items.size()
+                                                                        : obj.AsString()->length));
+            } else {
+                GV_VM_ERROR("cannot read field '" + std::string(name->View()) + "' of a " + TypeName(obj));
+            }
+            break;
+        }
+        case VMOp::SetField: {
+            VMString* name = consts[READ_U16()].AsString();
+            VMValue val = *--sp;
+            VMValue obj = sp[-1];
+            if (!obj.IsMap())
+                GV_VM_ERROR("cannot set field '" + std::string(name->View()) + "' of a " + TypeName(obj));
+            m_Heap.MapSet(obj.AsMap(), VMValue::Object(name), val);
+            sp[-1] = val;
+            GV_VM_SAFEPOINT();
+            break;
+        }
+
+        case VMOp::Add: {
+            VMValue b = *--sp;
+            VMValue a = sp[-1];
+            if (a.IsNumber() && b.IsNumber()) { sp[-1] = VMValue::Number(a.AsNumber() + b.AsNumber()); break; }
+            if (a.IsString() || b.IsString()) {
+                Concat(a, b, sp[-1]);
+                GV_VM_SAFEPOINT();
+                break;
+            }
+            if ((a.IsObject()) || (b.IsObject()))
+                GV_VM_ERROR(std::string("cannot add a ") + TypeName(a) + " and a " + TypeName(b));
+            sp[-1] = VMValue::Number(a.ToNumber() + b.ToNumber());
+            break;
+        }
+        case VMOp::Sub: { f64 b = (*--sp).ToNumber(); sp[-1] = VMValue::Number(sp[-1].ToNumber() - b); break; }
+        case VMOp::Mul: { f64 b = (*--sp).ToNumber(); sp[-1] = VMValue::Number(sp[-1].ToNumber() * b); break; }
+        case VMOp::Div: {
+            f64 b = (*--sp).ToNumber();
+            sp[-1] = VMValue::Number(b != 0 ? sp[-1].ToNumber() / b : 0.0);
+            break;
+        }
+        case VMOp::Mod: {
+            f64 b = (*--sp).ToNumber();
+            sp[-1] = VMValue::Number(b != 0 ? std::fmod(sp[-1].ToNumber(), b) : 0.0);
+            break;
+        }
+        case VMOp::Neg: sp[-1] = VMValue::Number(-sp[-1].ToNumber()); break;
+        case VMOp::Not: sp[-1] = VMValue::Bool(!sp[-1].Truthy()); break;
+
+        case VMOp::Eq:  { VMValue b = *--sp; sp[-1] = VMValue::Bool(Equal(sp[-1], b)); break; }
+        case VMOp::Neq: { VMValue b = *--sp; sp[-1] = VMValue::Bool(!Equal(sp[-1], b)); break; }
+        case VMOp::Lt: case VMOp::Gt: case VMOp::Lte: case VMOp::Gte: {
+            VMOp op = static_cast<VMOp>(ip[-1]);
+            VMValue b = *--sp;
+            VMValue a = sp[-1];
+            int c;
+            if (a.IsString() && b.IsString()) {
+                int r = a.AsString()->View().compare(b.AsString()->View());
+                c = r < 0 ? -1 : (r > 0 ? 1 : 0);
+            } else {
+                f64 x = a.ToNumber(), y = b.ToNumber();
+                if (x != x || y != y) { sp[-1] = VMValue::Bool(false); break; }
+                c = x < y ? -1 : (x > y ? 1 : 0);
+            }
+            bool r = op == VMOp::Lt ? c < 0 : op == VMOp::Gt ? c > 0 : op == VMOp::Lte ? c <= 0 : c >= 0;
+            sp[-1] = VMValue::Bool(r);
+            break;
+        }
+        case VMOp::ToBool: sp[-1] = VMValue::Bool(sp[-1].Truthy()); break;
+
+        case VMOp::Jump: { u32 off = READ_U16(); ip += off; break; }
+        case VMOp::JumpIfFalse: { u32 off = READ_U16(); if (!sp[-1].Truthy()) ip += off; break; }
+        case VMOp::Loop: {
+            u32 off = READ_U16();
+            ip -= off;
+            GV_VM_SAFEPOINT();
+            break;
+        }
+
+        case VMOp::Call: {
+            u32 argc = READ_U8();
+            VMValue callee = sp[-1 - static_cast<i32>(argc)];
+            if (!callee.IsClosure()) GV_VM_ERROR(std::string("attempt to call a ") + TypeName(callee));
+            GV_VM_SAVE();
+            if (!CallClosure(f, callee.AsClosure(), argc)) return RuntimeError(f, stopDepth, m_LastError);
+            GV_VM_LOAD();
+            break;
+        }
+        case VMOp::CallNative: {
+            u32 index = READ_U16();
+            u32 argc = READ_U8();
+            GV_VM_SAVE();
+            if (!CallNativeAt(f, index, argc)) return RuntimeError(f, stopDepth, m_LastError);
+            GV_VM_LOAD();
+            if (m_SuspendRequested) {
+                m_SuspendRequested = false;
+                if (&f == m_Running) return true;   // frames stay for Resume
+            }
+            GV_VM_SAFEPOINT();
+            break;
+        }
+        case VMOp::CallNamed: {
+            VMString* name = consts[READ_U16()].AsString();
+            u32 argc = READ_U8();
+            auto nit = m_NativeIndex.find(name);
+            if (nit != m_NativeIndex.end()) {
+                GV_VM_SAVE();
+                if (!CallNativeAt(f, nit->second, argc)) return RuntimeError(f, stopDepth, m_LastError);
+                GV_VM_LOAD();
+                if (m_SuspendRequested) {
+                    m_SuspendRequested = false;
+                    if (&f == m_Running) return true;   // frames stay for Resume
+                }
+                GV_VM_SAFEPOINT();
+                break;
+            }
+            VMClosure* target = nullptr;
+            const VMValue* local = frame->closure->env ? frame->closure->env->Find(VMValue::Object(name)) : nullptr;
+            auto fit = m_Functions.find(name);
+            if (local && local->IsClosure()) {
+                target = local->AsClosure();
+            } else if (fit != m_Functions.end()) {
+                target = fit->second;
+            } else {
+                auto git = m_Globals.find(name);
+                if (git != m_Globals.end() && git->second.IsClosure()) target = git->second.AsClosure();
+            }
+            if (!target) {
+                m_LastError = "Unknown function: " + std::string(name->View());
+                GV_LOG_WARN("[Script] " + m_LastError);
+                sp -= argc;
+                sp[-1] = VMValue();
+                break;
+            }
+            sp[-1 - static_cast<i32>(argc)] = VMValue::Object(target);
+            GV_VM_SAVE();
+            if (!CallClosure(f, target, argc)) return RuntimeError(f, stopDepth, m_LastError);
+            GV_VM_LOAD();
+            break;
+        }
+        case VMOp::Closure: {
+            VMFunction* proto = reinterpret_cast<VMFunction*>(consts[READ_U16()].AsObject());
+            VMClosure* closure = m_Heap.NewClosure(proto);
+            closure->env = frame->closure->env;
+            *sp++ = VMValue::Object(closure);
+            for (u8 i = 0; i < proto->upvalueCount; ++i) {
+                u8 isLocal = READ_U8();
+                u8 index = READ_U8();
+                closure->upvalues[i] = isLocal ? CaptureUpvalue(f, frame->base + index)
+                                               : frame->closure->upvalues[index];
+            }
+            GV_VM_SAFEPOINT();
+            break;
+        }
+        case VMOp::Yield:
+            if (&f != m_Running || m_HostDepth != m_RunningDepth) GV_VM_ERROR("yield outside a coroutine");
+            *sp++ = VMValue();          // receives the resume value
+            GV_VM_SAVE();
+            return true;
+        case VMOp::CloseUpvalue:
+            CloseUpvalues(f, static_cast<u32>(sp - 1 - f.stack.data()));
+            --sp;
+            break;
+        case VMOp::Return: {
+            VMValue result = *--sp;
+            const u32 base = frame->base;
+            CloseUpvalues(f, base);
+            f.frames.pop_back();
+            f.stack[base] = result;
+            f.top = base + 1;
+            for (size_t i = 0; i < m_Hooks.size(); ++i) m_Hooks[i].first->OnReturn(*this, f);
+            if (f.frames.size() <= stopDepth) return true;
+            GV_VM_LOAD();
+            break;
+        }
+
+        case VMOp::Array: {
+            u32 n = READ_U16();
+            VMArray* arr = m_Heap.NewArray(n);
+            arr->items.assign(sp - n, sp);
+            sp -= n;
+            *sp++ = VMValue::Object(arr);
+            GV_VM_SAFEPOINT();
+            break;
+        }
+        case VMOp::Map: {
+            u32 n = READ_U16();
+            VMMap* map = m_Heap.NewMap();
+            VMValue* pairs = sp - 2 * n;
+            for (u32 i = 0; i < n; ++i) {
+                VMValue key = pairs[2 * i];
+                if (key.IsNil() || (key.IsNumber() && key.AsNumber() != key.AsNumber()))
+                    GV_VM_ERROR("map key cannot be " + ToString(key));
+                m_Heap.MapSet(map, key, pairs[2 * i + 1]);
+            }
+            sp = pairs;
+            *sp++ = VMValue::Object(map);
+            GV_VM_SAFEPOINT();
+            break;
+        }
+
+        default:
+            GV_VM_ERROR("bad opcode " + std::to_string(ip[-1]));
+        }
+    }
+
+#undef GV_VM_LOAD
+#undef GV_VM_SAVE
+#undef GV_VM_ERROR
+#undef GV_VM_SAFEPOINT
+#undef READ_U8
+#undef READ_U16
+}
+
+// ============================================================================
+// Hooks
+// ============================================================================
+void ScriptVM::AddHook(VMHook* hook, u32 stepInterval) {
+    for (auto& h : m_Hooks)
+        if (h.first == hook) { h.second = stepInterval; UpdateStepInterval(); return; }
+    m_Hooks.emplace_back(hook, stepInterval);
+    UpdateStepInterval();
+}
+
+void ScriptVM::RemoveHook(VMHook* hook) {
+    m_Hooks.erase(std::remove_if(m_Hooks.begin(), m_Hooks.end(),
+                                 [hook](const auto& h) { return h.first == hook; }),
+                  m_Hooks.end());
+    UpdateStepInterval();
+}
+
+void ScriptVM::SetStepInterval(VMHook* hook, u32 stepInterval) {
+    for (auto& h : m_Hooks)
+        if (h.first == hook) h.second = stepInterval;
+    UpdateStepInterval();
+}
+
+void ScriptVM::UpdateStepInterval() {
+    m_StepInterval = 0;
+    for (const auto& h : m_Hooks)
+        if (h.second && (!m_StepInterval || h.second < m_StepInterval)) m_StepInterval = h.second;
+    // A call in progress picks the new interval up now, not at the end of
+    // a slice that may be millions of instructions long.
+    if (m_HostDepth > 0 && m_StepInterval && m_Budget > m_StepInterval) {
+        m_Reserve += m_Budget - m_StepInterval;
+        m_Budget = m_StepInterval;
+    }
+}
+
+void ScriptVM::Step(const VMFiber& f) {
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    for (size_t i = 0; i < m_Hooks.size(); ++i) m_Hooks[i].first->OnStep(*this, f);
+    if (m_Active.timeMs > 0) m_Deadline += Clock::now() - start;
+}
+
+// ============================================================================
+// Collection
+// ============================================================================
+void ScriptVM::CollectGarbage(f64 budgetMs) {
+    if (!m_Heap.WantsStep()) return;
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    do {
+        if (m_Heap.Step(512)) break;
+    } while (std::chrono::duration<f64, std::milli>(Clock::now() - start).count() < budgetMs);
+}
+
+} // namespace gv
@@ -0,0 +1,854 @@
+// ============================================================================
+// GameVoid Engine — GVScript Compiler Implementation
+// ============================================================================
+#include "scripting/VMCompiler.h"
+#include <cctype>
+#include <cstdio>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace gv {
+
+// ============================================================================
+// Tokenizer
+// ============================================================================
+std::vector<ScriptToken> TokenizeScript(const std::string& source) {
+    using Token = ScriptToken;
+    std::vector<Token> tokens;
+    size_t i = 0;
+    i32 line = 1;
+
+    while (i < source.size()) {
+        char c = source[i];
+
+        // Whitespace
+        if (c == ' ' || c == '\t' || c == '\r') { ++i; continue; }
+        if (c == '\n') { ++line; ++i; continue; }
+
+        // Comments
+        if (c == '/' && i + 1 < source.size()) {
+            if (source[i + 1] == '/') { while (i < source.size() && source[i] != '\n') ++i; continue; }
+            if (source[i + 1] == '*') {
+                i += 2;
+                while (i + 1 < source.size() && !(source[i] == '*' && source[i + 1] == '/')) { if (source[i] == '\n') ++line; ++i; }
+                i += 2; continue;
+            }
+        }
+
+        // Numbers
+        if (std::isdigit(static_cast<unsigned char>(c)) ||
+            (c == '.' && i + 1 < source.size() && std::isdigit(static_cast<unsigned char>(source[i + 1])))) {
+            std::string num;
+            bool dot = false;
+            while (i < source.size() && (std::isdigit(static_cast<unsigned char>(source[i])) || (source[i] == '.' && !dot))) {
+                if (source[i] == '.') dot = true;
+                num += source[i++];
+            }
+            tokens.push_back({ Token::Number, num, std::stod(num), line });
+            continue;
+        }
+
+        // Strings
+        if (c == '"' || c == '\'') {
+            char q = c; ++i;
+            std::string str;
+            while (i < source.size() && source[i] != q) {
+                if (source[i] == '\\' && i + 1 < source.size()) {
+                    ++i;
+                    switch (source[i]) { case 'n': str += '\n'; break; case 't': str += '\t'; break; case '\\': str += '\\'; break; default: str += source[i]; }
+                } else {
+                    if (source[i] == '\n') ++line;
+                    str += source[i];
+                }
+                ++i;
+            }
+            if (i < source.size()) ++i;
+            tokens.push_back({ Token::Str, str, 0, line });
+            continue;
+        }
+
+        // Identifiers / keywords
+        if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+            std::string id;
+            while (i < source.size() && (std::isalnum(static_cast<unsigned char>(source[i])) || source[i] == '_')) id += source[i++];
+            Token t; t.text = id; t.line = line; t.numVal = 0;
+            if      (id == "if")                        t.kind = Token::If;
+            else if (id == "else")                      t.kind = Token::Else;
+            else if (id == "while")                     t.kind = Token::While;
+            else if (id == "for")                       t.kind = Token::For;
+            else if (id == "func" || id == "function")  t.kind = Token::Func;
+            else if (id == "return")                    t.kind = Token::Return;
+            else if (id == "var" || id == "local")      t.kind = Token::Var;
+            else if (id == "true")                      t.kind = Token::True_;
+            else if (id == "false")                     t.kind = Token::False_;
+            else if (id == "nil")                       t.kind = Token::Nil_;
+            else if (id == "and")                       t.kind = Token::And;
+            else if (id == "or")                        t.kind = Token::Or;
+            else if (id == "not")                       t.kind = Token::Not;
+            else if (id == "yield")                     t.kind = Token::Yield;
+            else if (id == "wait_until")                t.kind = Token::WaitUntil;
+            else                                        t.kind = Token::Ident;
+            tokens.push_back(t);
+            continue;
+        }
+
+        // Two-char operators
+        if (i + 1 < source.size()) {
+            std::string tw = source.substr(i, 2);
+            if (tw == "==") { tokens.push_back({ Token::Eq,  "==", 0, line }); i += 2; continue; }
+            if (tw == "!=") { tokens.push_back({ Token::Neq, "!=", 0, line }); i += 2; continue; }
+            if (tw == "<=") { tokens.push_back({ Token::Lte, "<=", 0, line }); i += 2; continue; }
+            if (tw == ">=") { tokens.push_back({ Token::Gte, ">=", 0, line }); i += 2; continue; }
+            if (tw == "&&") { tokens.push_back({ Token::And, "&&", 0, line }); i += 2; continue; }
+            if (tw == "||") { tokens.push_back({ Token::Or,  "||", 0, line }); i += 2; continue; }
+        }
+
+        // Single-char tokens
+        Token t; t.line = line; t.numVal = 0;
+        switch (c) {
+            case '(': t.kind = Token::LParen;    t.text = "("; break;
+            case ')': t.kind = Token::RParen;    t.text = ")"; break;
+            case '{': t.kind = Token::LBrace;    t.text = "{"; break;
+            case '}': t.kind = Token::RBrace;    t.text = "}"; break;
+            case '[': t.kind = Token::LBracket;  t.text = "["; break;
+            case ']': t.kind = Token::RBracket;  t.text = "]"; break;
+            case ',': t.kind = Token::Comma;     t.text = ","; break;
+            case ';': t.kind = Token::Semicolon; t.text = ";"; break;
+            case ':': t.kind = Token::Colon;     t.text = ":"; break;
+            case '=': t.kind = Token::Assign;    t.text = "="; break;
+            case '+': t.kind = Token::Plus;      t.text = "+"; break;
+            case '-': t.kind = Token::Minus;     t.text = "-"; break;
+            case '*': t.kind = Token::Star;      t.text = "*"; break;
+            case '/': t.kind = Token::Slash;     t.text = "/"; break;
+            case '%': t.kind = Token::Percent;   t.text = "%"; break;
+            case '<': t.kind = Token::Lt;        t.text = "<"; break;
+            case '>': t.kind = Token::Gt;        t.text = ">"; break;
+            case '!': t.kind = Token::Not;       t.text = "!"; break;
+            case '.': t.kind = Token::Dot;       t.text = "."; break;
+            default:  ++i; continue;
+        }
+        tokens.push_back(t);
+        ++i;
+    }
+
+    tokens.push_back({ Token::Eof, "", 0, line });
+    return tokens;
+}
+
+// ============================================================================
+// Compiler
+// ============================================================================
+namespace {
+
+using Token = ScriptToken;
+
+constexpr u32 kMaxLocals   = 255;
+constexpr u32 kMaxUpvalues = 255;
+
+struct CompileError : std::runtime_error {
+    i32 line;
+    CompileError(const std::string& msg, i32 l) : std::runtime_error(msg), line(l) {}
+};
+
+struct Local {
+    std::string name;
+    i32  depth = 0;
+    bool captured = false;
+    i32  info = -1;                     // index in VMFunction::localNames
+};
+
+struct UpvalueDesc {
+    u8   index = 0;
+    bool isLocal = false;
+};
+
+struct FuncState {
+    FuncState*  enclosing = nullptr;
+    VMFunction* function = nullptr;
+    bool        isScript = false;       // top level of a chunk: `var` is global
+    std::vector<Local>       locals;
+    std::vector<UpvalueDesc> upvalues;
+    std::unordered_map<u64, u16> constantIndex;
+    i32 scopeDepth = 0;
+    i32 depth = 1;                       // current stack depth (slot 0 = callee)
+};
+
+class Parser {
+public:
+    Parser(VMHeap& heap, const std::vector<Token>& tokens, VMString* chunk,
+           const VMCompiler::NativeTable* natives)
+        : m_Heap(heap), m_Tokens(tokens), m_Chunk(chunk), m_Natives(natives) {}
+
+    VMFunction* CompileChunk() {
+        FuncState fs;
+        Begin(fs, nullptr, true);
+        while (!Check(Token::Eof)) Statement();
+        return End();
+    }
+
+private:
+    // ── Token stream ───────────────────────────────────────────────────────
+    const Token& Peek(size_t ahead = 0) const {
+        size_t i = m_Pos + ahead;
+        return i < m_Tokens.size() ? m_Tokens[i] : m_Tokens.back();
+    }
+    const Token& Prev() const { return m_Tokens[m_Pos ? m_Pos - 1 : 0]; }
+    bool Check(Token::Kind k) const { return Peek().kind == k; }
+    const Token& Advance() { if (m_Pos < m_Tokens.size() - 1) ++m_Pos; return Prev(); }
+    bool Match(Token::Kind k) { if (!Check(k)) return false; Advance(); return true; }
+    const Token& Expect(Token::Kind k, const char* what) {
+        if (!Check(k)) Error(std::string("expected ") + what);
+        return Advance();
+    }
+    [[noreturn]] void Error(const std::string& msg) const {
+        const Token& t = Peek();
+        std::string near = t.kind == Token::Eof ? "end of script" : "'" + t.text + "'";
+        throw CompileError(msg + " near " + near, t.line);
+    }
+
+    // ── Emission ───────────────────────────────────────────────────────────
+    VMFunction* Fn() { return m_FS->function; }
+    void EmitByte(u8 b) {
+        Fn()->code.push_back(b);
+        Fn()->lines.push_back(Prev().line);
+    }
+    void EmitOp(VMOp op, i32 stackEffect) {
+        EmitByte(static_cast<u8>(op));
+        m_FS->depth += stackEffect;
+        if (m_FS->depth > static_cast<i32>(Fn()->maxStack)) Fn()->maxStack = static_cast<u32>(m_FS->depth);
+    }
+    void EmitU16(u32 v) {
+        if (v > 0xFFFF) Error("function too large");
+        EmitByte(static_cast<u8>(v & 0xFF));
+        EmitByte(static_cast<u8>(v >> 8));
+    }
+    u16 Constant(VMValue v) {
+        auto it = m_FS->constantIndex.find(v.Bits());
+        if (it != m_FS->constantIndex.end()) return it->second;
+        if (Fn()->constants.size() >= 0xFFFF) Error("too many constants in one function");
+        u16 idx = static_cast<u16>(Fn()->constants.size());
+        Fn()->constants.push_back(v);
+        m_FS->constantIndex.emplace(v.Bits(), idx);
+        return idx;
+    }
+    bool FindNative(const std::string& name, u32& slot) {
+        if (!m_Natives) return false;
+        auto it = m_Natives->find(m_Heap.Intern(name));
+        if (it == m_Natives->end()) return false;
+        slot = it->second;
+        return true;
+    }
+    u16 NameConstant(const std::string& name) { return Constant(VMValue::Object(m_Heap.Intern(name))); }
+    void EmitConst(VMValue v) { EmitOp(VMOp::Const, +1); EmitU16(Constant(v)); }
+
+    size_t EmitJump(VMOp op) {
+        EmitOp(op, 0);
+        EmitByte(0xFF); EmitByte(0xFF);
+        return Fn()->code.size() - 2;
+    }
+    void PatchJump(size_t at) {
+        size_t dist = Fn()->code.size() - at - 2;
+        if (dist > 0xFFFF) Error("jump too long");
+        Fn()->code[at]     = static_cast<u8>(dist & 0xFF);
+        Fn()->code[at + 1] = static_cast<u8>(dist >> 8);
+    }
+    void EmitLoop(size_t start) {
+        EmitOp(VMOp::Loop, 0);
+        size_t dist = Fn()->code.size() - start + 2;
+        if (dist > 0xFFFF) Error("loop body too long");
+        EmitByte(static_cast<u8>(dist & 0xFF));
+        EmitByte(static_cast<u8>(dist >> 8));
+    }
+
+    // ── Functions and scopes ───────────────────────────────────────────────
+    void Begin(FuncState& fs, VMString* name, bool isScript) {
+        fs.enclosing = m_FS;
+        fs.isScript = isScript;
+        fs.function = m_Heap.NewFunction();
+        fs.function->name = name;
+        fs.function->chunk = m_Chunk;
+        fs.function->maxStack = 1;
+        fs.locals.push_back({ "", 0, false });   // slot 0: the callee
+        m_FS = &fs;
+    }
+    VMFunction* End() {
+        EmitOp(VMOp::Nil, +1);
+        EmitOp(VMOp::Return, -1);
+        VMFunction* fn = m_FS->function;
+        for (const Local& l : m_FS->locals)
+            if (l.info >= 0 && fn->localNames[l.info].endPc == 0) fn->localNames[l.info].endPc = static_cast<u32>(fn->code.size());
+        fn->upvalueCount = static_cast<u8>(m_FS->upvalues.size());
+        fn->localNames.shrink_to_fit();
+        fn->code.shrink_to_fit();
+        fn->lines.shrink_to_fit();
+        fn->constants.shrink_to_fit();
+        m_Heap.Reaccount(fn);
+        m_FS = m_FS->enclosing;
+        return fn;
+    }
+    void BeginScope() { ++m_FS->scopeDepth; }
+    void EndScope() {
+        --m_FS->scopeDepth;
+        auto& locals = m_FS->locals;
+        while (locals.size() > 1 && locals.back().depth > m_FS->scopeDepth) {
+            if (locals.back().info >= 0) Fn()->localNames[locals.back().info].endPc = static_cast<u32>(Fn()->code.size());
+            EmitOp(locals.back().captured ? VMOp::CloseUpvalue : VMOp::Pop, -1);
+            locals.pop_back();
+        }
+    }
+    /// The value for the new local is on top of the stack.
+    void AddLocal(const std::string& name) {
+        if (m_FS->locals.size() > kMaxLocals) Error("too many local variables in one function");
+        VMLocalName debug;
+        debug.name = name;
+        debug.slot = static_cast<u8>(m_FS->locals.size());
+        debug.startPc = static_cast<u32>(Fn()->code.size());
+        Fn()->localNames.push_back(std::move(debug));
+        m_FS->locals.push_back({ name, m_FS->scopeDepth, false, static_cast<i32>(Fn()->localNames.size()) - 1 });
+    }
+    static i32 ResolveLocal(FuncState* fs, const std::string& name) {
+        for (i32 i = static_cast<i32>(fs->locals.size()) - 1; i >= 1; --i)
+            if (fs->locals[i].name == name) return i;
+        return -1;
+    }
+    i32 AddUpvalue(FuncState* fs, u8 index, bool isLocal, const std::string& name) {
+        for (size_t i = 0; i < fs->upvalues.size(); ++i)
+            if (fs->upvalues[i].index == index && fs->upvalues[i].isLocal == isLocal) return static_cast<i32>(i);
+        if (fs->upvalues.size() >= kMaxUpvalues) Error("too many captured variables in one function");
+        fs->upvalues.push_back({ index, isLocal });
+        fs->function->upvalueNames.push_back(name);
+        return static_cast<i32>(fs->upvalues.size()) - 1;
+    }
+    i32 ResolveUpvalue(FuncState* fs, const std::string& name) {
+        if (!fs->enclosing) return -1;
+        i32 local = ResolveLocal(fs->enclosing, name);
+        if (local >= 0) {
+            fs->enclosing->locals[local].captured = true;
+            return AddUpvalue(fs, static_cast<u8>(local), true, name);
+        }
+        i32 up = ResolveUpvalue(fs->enclosing, name);
+        if (up >= 0) return AddUpvalue(fs, static_cast<u8>(up), false, name);
+        return -1;
+    }
+
+    /// Parameters and body after the name; leaves a closure on the stack.
+    void FunctionBody(const std::string& name) {
+        FuncState fs;
+        Begin(fs, name.empty() ? nullptr : m_Heap.Intern(name), false);
+        BeginScope();
+        Expect(Token::LParen, "'(' after function name");
+        u32 arity = 0;
+        while (!Check(Token::RParen) && !Check(Token::Eof)) {
+            const Token& p = Expect(Token::Ident, "parameter name");
+            if (++arity > 255) Error("too many parameters");
+            AddLocal(p.text);
+            ++m_FS->depth;
+            if (m_FS->depth > static_cast<i32>(Fn()->maxStack)) Fn()->maxStack = static_cast<u32>(m_FS->depth);
+            if (!Match(Token::Comma)) break;
+        }
+        Expect(Token::RParen, "')' after parameters");
+        Fn()->arity = static_cast<u8>(arity);
+        Expect(Token::LBrace, "'{' before function body");
+        while (!Check(Token::RBrace) && !Check(Token::Eof)) Statement();
+        Expect(Token::RBrace, "'}' after function body");
+        std::vector<UpvalueDesc> upvalues = fs.upvalues;
+        VMFunction* fn = End();
+
+        EmitOp(VMOp::Closure, +1);
+        EmitU16(Constant(VMValue::Object(fn)));
+        for (const auto& u : upvalues) {
+            EmitByte(u.isLocal ? 1 : 0);
+            EmitByte(u.index);
+        }
+    }
+
+    // ── Statements ─────────────────────────────────────────────────────────
+    void Statement() {
+        if (Match(Token::Semicolon)) return;
+        if (Match(Token::Var))    { VarDeclaration(); return; }
+        if (Check(Token::Func) && Peek(1).kind == Token::Ident) { Advance(); FuncDeclaration(); return; }
+        if (Match(Token::If))     { IfStatement(); return; }
+        if (Match(Token::While))  { WhileStatement(); return; }
+        if (Match(Token::For))    { ForStatement(); return; }
+        if (Match(Token::Return)) { ReturnStatement(); return; }
+        if (Match(Token::Yield))  { EmitOp(VMOp::Yield, +1); EmitOp(VMOp::Pop, -1); Match(Token::Semicolon); return; }
+        if (Match(Token::WaitUntil)) { WaitUntilStatement(); return; }
+        if (Match(Token::LBrace)) { BeginScope(); Block(); EndScope(); return; }
+        Expression();
+        EmitOp(VMOp::Pop, -1);
+        Match(Token::Semicolon);
+    }
+
+    void Block() {
+        while (!Check(Token::RBrace) && !Check(Token::Eof)) Statement();
+        Expect(Token::RBrace, "'}'");
+    }
+
+    /// A braced block or a single statement, in its own scope.
+    void Body() {
+        BeginScope();
+        if (Match(Token::LBrace)) Block();
+        else Statement();
+        EndScope();
+    }
+
+    void VarDeclaration() {
+        std::string name = Expect(Token::Ident, "variable name after 'var'").text;
+        if (Match(Token::Assign)) Expression();
+        else EmitOp(VMOp::Nil, +1);
+        if (m_FS->isScript) {
+            EmitOp(VMOp::DefineGlobal, -1);
+            EmitU16(NameConstant(name));
+        } else {
+            AddLocal(name);
+        }
+        Match(Token::Semicolon);
+    }
+
+    void FuncDeclaration() {
+        std::string name = Expect(Token::Ident, "function name").text;
+        FunctionBody(name);
+        EmitOp(VMOp::DefineFunc, -1);
+        EmitU16(NameConstant(name));
+    }
+
+    void IfStatement() {
+        Expression();
+        size_t elseJump = EmitJump(VMOp::JumpIfFalse);
+        EmitOp(VMOp::Pop, -1);
+        Body();
+        size_t endJump = EmitJump(VMOp::Jump);
+        PatchJump(elseJump);
+        ++m_FS->depth;                  // the condition is still on the stack here
+        EmitOp(VMOp::Pop, -1);
+        if (Match(Token::Else)) Body();
+        PatchJump(endJump);
+    }
+
+    void WhileStatement() {
+        size_t loopStart = Fn()->code.size();
+        Expression();
+        size_t exitJump = EmitJump(VMOp::JumpIfFalse);
+        EmitOp(VMOp::Pop, -1);
+        Body();
+        EmitLoop(loopStart);
+        PatchJump(exitJump);
+        ++m_FS->depth;
+        EmitOp(VMOp::Pop, -1);
+    }
+
+    void ForStatement() {
+        BeginScope();
+        bool paren = Match(Token::LParen);
+        if (Match(Token::Semicolon)) {
+        } else if (Match(Token::Var)) {
+            VarDeclaration();
+        } else {
+            Expression();
+            EmitOp(VMOp::Pop, -1);
+            Match(Token::Semicolon);
+        }
+
+        size_t loopStart = Fn()->code.size();
+        size_t exitJump = 0;
+        bool hasCond = !Check(Token::Semicolon);
+        if (hasCond) {
+            Expression();
+            exitJump = EmitJump(VMOp::JumpIfFalse);
+            EmitOp(VMOp::Pop, -1);
+        }
+        Expect(Token::Semicolon, "';' after loop condition");
+
+        if (!Check(paren ? Token::RParen : Token::LBrace)) {
+            size_t bodyJump = EmitJump(VMOp::Jump);
+            size_t stepStart = Fn()->code.size();
+            Expression();
+            EmitOp(VMOp::Pop, -1);
+            EmitLoop(loopStart);
+            loopStart = stepStart;
+            PatchJump(bodyJump);
+        }
+        if (paren) Expect(Token::RParen, "')' after for clauses");
+
+        Body();
+        EmitLoop(loopStart);
+        if (hasCond) {
+            PatchJump(exitJump);
+            ++m_FS->depth;
+            EmitOp(VMOp::Pop, -1);
+        }
+        EndScope();
+    }
+
+    /// wait_until(cond)  →  while !(cond) { yield; }
+    void WaitUntilStatement() {
+        Expect(Token::LParen, "'(' after 'wait_until'");
+        size_t loopStart = Fn()->code.size();
+        Expression();
+        size_t exitJump = EmitJump(VMOp::JumpIfFalse);
+        EmitOp(VMOp::Pop, -1);
+        size_t yieldJump = EmitJump(VMOp::Jump);
+        PatchJump(exitJump);
+        ++m_FS->depth;
+        EmitOp(VMOp::Pop, -1);
+        EmitOp(VMOp::Yield, +1);
+        EmitOp(VMOp::Pop, -1);
+        EmitLoop(loopStart);
+        PatchJump(yieldJump);
+        Expect(Token::RParen, "')' after wait_until condition");
+        Match(Token::Semicolon);
+    }
+
+    void ReturnStatement() {
+        if (Check(Token::Semicolon) || Check(Token::RBrace) || Check(Token::Eof)) EmitOp(VMOp::Nil, +1);
+        else Expression();
+        EmitOp(VMOp::Return, -1);
+        Match(Token::Semicolon);
+    }
+
+    // ── Expressions (lowest to highest precedence) ─────────────────────────
+    void Expression() {
+        Assignment();
+        if (Check(Token::Assign)) Error("invalid assignment target");
+    }
+
+    void Assignment() { Or(true); }
+
+    void Or(bool canAssign) {
+        And(canAssign);
+        while (Match(Token::Or)) {
+            // left true → skip the right side, keep `true`
+            size_t elseJump = EmitJump(VMOp::JumpIfFalse);
+            size_t endJump = EmitJump(VMOp::Jump);
+            PatchJump(elseJump);
+            EmitOp(VMOp::Pop, -1);
+            And(false);
+            PatchJump(endJump);
+            EmitOp(VMOp::ToBool, 0);
+        }
+    }
+
+    void And(bool canAssign) {
+        Equality(canAssign);
+        while (Match(Token::And)) {
+            size_t endJump = EmitJump(VMOp::JumpIfFalse);
+            EmitOp(VMOp::Pop, -1);
+            Equality(false);
+            PatchJump(endJump);
+            EmitOp(VMOp::ToBool, 0);
+        }
+    }
+
+    void Equality(bool canAssign) {
+        Comparison(canAssign);
+        for (;;) {
+            if (Match(Token::Eq))       { Comparison(false); EmitOp(VMOp::Eq, -1); }
+            else if (Match(Token::Neq)) { Comparison(false); EmitOp(VMOp::Neq, -1); }
+            else break;
+        }
+    }
+
+    void Comparison(bool canAssign) {
+        Term(canAssign);
+        for (;;) {
+            VMOp op;
+            if (Match(Token::Lt))       op = VMOp::Lt;
+            else if (Match(Token::Gt))  op = VMOp::Gt;
+            else if (Match(Token::Lte)) op = VMOp::Lte;
+            else if (Match(Token::Gte)) op = VMOp::Gte;
+            else break;
+            Term(false);
+            EmitOp(op, -1);
+        }
+    }
+
+    void Term(bool canAssign) {
+        Factor(canAssign);
+        for (;;) {
+            if (Match(Token::Plus))       { Factor(false); EmitOp(VMOp::Add, -1); }
+            else if (Match(Token::Minus)) { Factor(false); EmitOp(VMOp::Sub, -1); }
+            else break;
+        }
+    }
+
+    void Factor(bool canAssign) {
+        Unary(canAssign);
+        for (;;) {
+            if (Match(Token::Star))         { Unary(false); EmitOp(VMOp::Mul, -1); }
+            else if (Match(Token::Slash))   { Unary(false); EmitOp(VMOp::Div, -1); }
+            else if (Match(Token::Percent)) { Unary(false); EmitOp(VMOp::Mod, -1); }
+            else break;
+        }
+    }
+
+    void Unary(bool canAssign) {
+        if (Match(Token::Minus)) { Unary(false); EmitOp(VMOp::Neg, 0); return; }
+        if (Match(Token::Not))   { Unary(false); EmitOp(VMOp::Not, 0); return; }
+        Postfix(canAssign);
+    }
+
+    u8 Arguments(Token::Kind close) {
+        u32 argc = 0;
+        while (!Check(close) && !Check(Token::Eof)) {
+            Expression();
+            if (++argc > 255) Error("too many arguments");
+            if (!Match(Token::Comma)) break;
+        }
+        Expect(close, close == Token::RParen ? "')' after arguments" : "']'");
+        return static_cast<u8>(argc);
+    }
+
+    void Postfix(bool canAssign) {
+        Primary(canAssign);
+        for (;;) {
+            if (Match(Token::LParen)) {
+                u8 argc = Arguments(Token::RParen);
+                EmitOp(VMOp::Call, -static_cast<i32>(argc));
+                EmitByte(argc);
+            } else if (Match(Token::LBracket)) {
+                Expression();
+                Expect(Token::RBracket, "']' after index");
+                if (canAssign && Match(Token::Assign)) {
+                    Expression();
+                    EmitOp(VMOp::SetIndex, -2);
+                    return;
+                }
+                EmitOp(VMOp::GetIndex, -1);
+            } else if (Match(Token::Dot)) {
+                u16 name = NameConstant(Expect(Token::Ident, "field name after '.'").text);
+                if (canAssign && Match(Token::Assign)) {
+                    Expression();
+                    EmitOp(VMOp::SetField, -1);
+                    EmitU16(name);
+                    return;
+                }
+                EmitOp(VMOp::GetField, 0);
+                EmitU16(name);
+            } else {
+                break;
+            }
+        }
+    }
+
+    void Primary(bool canAssign) {
+        const Token& tok = Peek();
+        switch (tok.kind) {
+            case Token::Number: Advance(); EmitConst(VMValue::Number(tok.numVal)); return;
+            case Token::Str:    Advance(); EmitConst(VMValue::Object(m_Heap.Intern(tok.text))); return;
+            case Token::True_:  Advance(); EmitOp(VMOp::True, +1); return;
+            case Token::False_: Advance(); EmitOp(VMOp::False, +1); return;
+            case Token::Nil_:   Advance(); EmitOp(VMOp::Nil, +1); return;
+            case Token::LParen:
+                Advance();
+                Expression();
+                Expect(Token::RParen, "')'");
+                return;
+            case Token::LBracket: {
+                Advance();
+                u32 n = 0;
+                while (!Check(Token::RBracket) && !Check(Token::Eof)) {
+                    Expression();
+                    if (++n > 0xFFFF) Error("array literal too long");
+                    if (!Match(Token::Comma)) break;
+                }
+                Expect(Token::RBracket, "']' after array elements");
+                EmitOp(VMOp::Array, 1 - static_cast<i32>(n));
+                EmitU16(n);
+                return;
+            }
+            case Token::LBrace: {
+                Advance();
+                u32 n = 0;
+                while (!Check(Token::RBrace) && !Check(Token::Eof)) {
+                    if (Check(Token::Ident) || Check(Token::Str)) {
+                        EmitConst(VMValue::Object(m_Heap.Intern(Advance().text)));
+                    } else if (Check(Token::Number)) {
+                        EmitConst(VMValue::Number(Advance().numVal));
+                    } else if (Match(Token::LBracket)) {
+                        Expression();
+                        Expect(Token::RBracket, "']' after computed key");
+                    } else {
+                        Error("expected map key");
+                    }
+                    Expect(Token::Colon, "':' after map key");
+                    Expression();
+                    if (++n > 0xFFFF) Error("map literal too long");
+                    if (!Match(Token::Comma)) break;
+                }
+                Expect(Token::RBrace, "'}' after map entries");
+                EmitOp(VMOp::Map, 1 - 2 * static_cast<i32>(n));
+                EmitU16(n);
+                return;
+            }
+            case Token::Func:
+                Advance();
+                FunctionBody("");
+                return;
+            case Token::Ident:
+                Advance();
+                NamedValue(tok.text, canAssign);
+                return;
+            default:
+                Error("unexpected token");
+        }
+    }
+
+    void NamedValue(const std::string& name, bool canAssign) {
+        i32 local = ResolveLocal(m_FS, name);
+        i32 up = local < 0 ? ResolveUpvalue(m_FS, name) : -1;
+
+        // name(args) on something that isn't a local: natives, then script
+        // functions, then a global holding a closure.  Natives can't be
+        // unregistered, so one known now is what the lookup would find.
+        if (local < 0 && up < 0 && Check(Token::LParen)) {
+            Advance();
+            EmitOp(VMOp::Nil, +1);              // callee slot, filled at run time
+            u8 argc = Arguments(Token::RParen);
+            u32 native = 0;
+            if (FindNative(name, native)) {
+                EmitOp(VMOp::CallNative, -static_cast<i32>(argc));
+                EmitU16(native);
+            } else {
+                EmitOp(VMOp::CallNamed, -static_cast<i32>(argc));
+                EmitU16(NameConstant(name));
+            }
+            EmitByte(argc);
+            return;
+        }
+
+        if (canAssign && Match(Token::Assign)) {
+            Expression();
+            if (local >= 0)   { EmitOp(VMOp::SetLocal, 0);   EmitByte(static_cast<u8>(local)); }
+            else if (up >= 0) { EmitOp(VMOp::SetUpvalue, 0); EmitByte(static_cast<u8>(up)); }
+            else              { EmitOp(VMOp::SetGlobal, 0);  EmitU16(NameConstant(name)); }
+            return;
+        }
+        if (local >= 0)   { EmitOp(VMOp::GetLocal, +1);   EmitByte(static_cast<u8>(local)); }
+        else if (up >= 0) { EmitOp(VMOp::GetUpvalue, +1); EmitByte(static_cast<u8>(up)); }
+        else              { EmitOp(VMOp::GetGlobal, +1);  EmitU16(NameConstant(name)); }
+    }
+
+    VMHeap& m_Heap;
+    const std::vector<Token>& m_Tokens;
+    VMString* m_Chunk;
+    const VMCompiler::NativeTable* m_Natives;
+    size_t m_Pos = 0;
+    FuncState* m_FS = nullptr;
+};
+
+} // anonymous namespace
+
+VMFunction* VMCompiler::Compile(const std::string& source, const std::string& chunkName, std::string& error) {
+    m_Heap.Pause();
+    VMFunction* result = nullptr;
+    try {
+        std::vector<Token> tokens = TokenizeScript(source);
+        Parser parser(m_Heap, tokens, m_Heap.Intern(chunkName), m_Natives);
+        result = parser.CompileChunk();
+    } catch (const CompileError& e) {
+        error = chunkName + ":" + std::to_string(e.line) + ": " + e.what();
+    } catch (const std::exception& e) {
+        error = chunkName + ": " + e.what();
+    }
+    m_Heap.Resume();
+    return result;
+}
+
+// ============================================================================
+// Disassembler
+// ============================================================================
+namespace {
+
+const char* OpName(VMOp op) {
+    switch (op) {
+        case VMOp::Const: return "CONST";           case VMOp::Nil: return "NIL";
+        case VMOp::True: return "TRUE";             case VMOp::False: return "FALSE";
+        case VMOp::Pop: return "POP";               case VMOp::GetLocal: return "GET_LOCAL";
+        case VMOp::SetLocal: return "SET_LOCAL";    case VMOp::GetUpvalue: return "GET_UPVAL";
+        case VMOp::SetUpvalue: return "SET_UPVAL";  case VMOp::GetGlobal: return "GET_GLOBAL";
+        case VMOp::SetGlobal: return "SET_GLOBAL";  case VMOp::DefineGlobal: return "DEF_GLOBAL";
+        case VMOp::DefineFunc: return "DEF_FUNC";   case VMOp::GetIndex: return "GET_INDEX";
+        case VMOp::SetIndex: return "SET_INDEX";    case VMOp::GetField: return "GET_FIELD";
+        case VMOp::SetField: return "SET_FIELD";    case VMOp::Add: return "ADD";
+        case VMOp::Sub: return "SUB";               case VMOp::Mul: return "MUL";
+        case VMOp::Div: return "DIV";               case VMOp::Mod: return "MOD";
+        case VMOp::Neg: return "NEG";               case VMOp::Not: return "NOT";
+        case VMOp::Eq: return "EQ";                 case VMOp::Neq: return "NEQ";
+        case VMOp::Lt: return "LT";                 case VMOp::Gt: return "GT";
+        case VMOp::Lte: return "LTE";               case VMOp::Gte: return "GTE";
+        case VMOp::ToBool: return "TO_BOOL";        case VMOp::Jump: return "JUMP";
+        case VMOp::JumpIfFalse: return "JUMP_IF_FALSE"; case VMOp::Loop: return "LOOP";
+        case VMOp::Call: return "CALL";             case VMOp::CallNamed: return "CALL_NAMED";
+        case VMOp::CallNative: return "CALL_NATIVE";
+        case VMOp::Closure: return "CLOSURE";       case VMOp::CloseUpvalue: return "CLOSE_UPVAL";
+        case VMOp::Return: return "RETURN";         case VMOp::Array: return "ARRAY";
+        case VMOp::Map: return "MAP";               case VMOp::Yield: return "YIELD";
+    }
+    return "?";
+}
+
+std::string ConstantText(VMValue v) {
+    if (v.IsNumber()) { char buf[32]; std::snprintf(buf, sizeof(buf), "%g", v.AsNumber()); return buf; }
+    if (v.IsString()) return "\"" + std::string(v.AsString()->View()) + "\"";
+    if (v.IsObject() && v.AsObject()->type == VMObjectType::Function) {
+        auto* f = reinterpret_cast<VMFunction*>(v.AsObject());
+        return "<fn " + (f->name ? std::string(f->name->View()) : std::string("anonymous")) + ">";
+    }
+    return "?";
+}
+
+} // anonymous namespace
+
+std::string DisassembleFunction(const VMFunction* fn) {
+    std::string out = "== " + (fn->name ? std::string(fn->name->View()) : std::string("<chunk>")) +
+                      " (arity " + std::to_string(fn->arity) + ", stack " + std::to_string(fn->maxStack) + ") ==\n";
+    const auto& code = fn->code;
+    auto u16At = [&](size_t i) { return static_cast<u32>(code[i] | (code[i + 1] << 8)); };
+    for (size_t i = 0; i < code.size();) {
+        char head[32];
+        std::snprintf(head, sizeof(head), "%04zu %4d ", i, fn->lines[i]);
+        out += head;
+        VMOp op = static_cast<VMOp>(code[i]);
+        out += OpName(op);
+        switch (op) {
+            case VMOp::Const: case VMOp::GetGlobal: case VMOp::SetGlobal: case VMOp::DefineGlobal:
+            case VMOp::DefineFunc: case VMOp::GetField: case VMOp::SetField:
+                out += " " + ConstantText(fn->constants[u16At(i + 1)]);
+                i += 3; break;
+            case VMOp::GetLocal: case VMOp::SetLocal: case VMOp::GetUpvalue: case VMOp::SetUpvalue:
+            case VMOp::Call:
+                out += " " + std::to_string(code[i + 1]);
+                i += 2; break;
+            case VMOp::Jump: case VMOp::JumpIfFalse:
+                out += " -> " + std::to_string(i + 3 + u16At(i + 1));
+                i += 3; break;
+            case VMOp::Loop:
+                out += " -> " + std::to_string(i + 3 - u16At(i + 1));
+                i += 3; break;
+            case VMOp::Array: case VMOp::Map:
+                out += " " + std::to_string(u16At(i + 1));
+                i += 3; break;
+            case VMOp::CallNamed:
+                out += " " + ConstantText(fn->constants[u16At(i + 1)]) + " " + std::to_string(code[i + 3]);
+                i += 4; break;
+            case VMOp::CallNative:
+                out += " #" + std::to_string(u16At(i + 1)) + " " + std::to_string(code[i + 3]);
+                i += 4; break;
+            case VMOp::Closure: {
+                auto* inner = reinterpret_cast<const VMFunction*>(fn->constants[u16At(i + 1)].AsObject());
+                out += " " + ConstantText(fn->constants[u16At(i + 1)]);
+                i += 3 + 2u * inner->upvalueCount;
+                break;
+            }
+            default:
+                i += 1; break;
+        }
+        out += "\n";
+    }
+    for (VMValue c : fn->constants)
+        if (c.IsObject() && c.AsObject()->type == VMObjectType::Function)
+            out += DisassembleFunction(reinterpret_cast<const VMFunction*>(c.AsObject()));
+    return out;
+}
+
+} // namespace gv
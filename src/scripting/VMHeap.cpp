@@ -0,0 +1,432 @@
+// ============================================================================
+// GameVoid Engine — GVScript Heap / Incremental Collector Implementation
+// ============================================================================
+// Colours: the current white (0 or 1), gray (2) and black (3).  A cycle
+// marks incrementally from the roots, then in one atomic step re-marks the
+// roots (the VM stack has no barrier), drops dead strings from the intern
+// table and flips the meaning of white.  Sweeping then frees objects of the
+// old white and resets survivors to the new one; anything allocated after
+// the flip is already the new white, so sweeping can interleave with the
+// mutator freely.
+// ============================================================================
+#include "scripting/VMHeap.h"
+#include <algorithm>
+#include <new>
+
+namespace gv {
+
+namespace {
+
+VMString* const kTombstone = reinterpret_cast<VMString*>(uintptr_t(1));
+
+inline u32 HashString(std::string_view text) {
+    u32 h = 2166136261u;
+    for (char c : text) { h ^= static_cast<u8>(c); h *= 16777619u; }
+    return h;
+}
+
+} // anonymous namespace
+
+VMHeap::VMHeap() {
+    m_Strings.assign(64, nullptr);
+}
+
+VMHeap::~VMHeap() { Reset(); }
+
+// ── Allocation ─────────────────────────────────────────────────────────────
+
+size_t VMHeap::SizeOf(const VMString* s) { return sizeof(VMString) + s->length + 1; }
+size_t VMHeap::SizeOf(const VMArray* a)  { return sizeof(VMArray) + a->items.capacity() * sizeof(VMValue); }
+
+size_t VMHeap::SizeOf(const VMMap* m) {
+    return sizeof(VMMap) + (m->keys.capacity() + m->values.capacity()) * sizeof(VMValue) +
+           m->index.size() * 32 + m->index.bucket_count() * sizeof(void*);
+}
+
+size_t VMHeap::SizeOf(const VMFunction* f) {
+    return sizeof(VMFunction) + f->code.capacity() + f->lines.capacity() * sizeof(i32) +
+           f->constants.capacity() * sizeof(VMValue) +
+           f->localNames.capacity() * sizeof(VMLocalName) +
+           f->upvalueNames.capacity() * sizeof(std::string);
+}
+
+size_t VMHeap::SizeOf(const VMClosure* c) { return sizeof(VMClosure) + c->upvalues.capacity() * sizeof(void*); }
+size_t VMHeap::SizeOf(const VMUpvalue*)   { return sizeof(VMUpvalue); }
+
+size_t VMHeap::ObjectBytes(const VMObject* obj) {
+    switch (obj->type) {
+        case VMObjectType::String:   return SizeOf(static_cast<const VMString*>(obj));
+        case VMObjectType::Array:    return SizeOf(static_cast<const VMArray*>(obj));
+        case VMObjectType::Map:      return SizeOf(static_cast<const VMMap*>(obj));
+        case VMObjectType::Function: return SizeOf(static_cast<const VMFunction*>(obj));
+        case VMObjectType::Closure:  return SizeOf(static_cast<const VMClosure*>(obj));
+        case VMObjectType::Upvalue:  return SizeOf(static_cast<const VMUpvalue*>(obj));
+    }
+    return 0;
+}
+
+// The size comes from T, not obj->type: switching on the tag here would let
+// the compiler see (and warn about) casts to larger types than `obj` is.
+template <typename T>
+T* VMHeap::Track(T* obj) {
+    obj->color = m_White;
+    obj->next = m_Objects;
+    m_Objects = obj;
+    obj->bytes = static_cast<u32>(SizeOf(obj));
+    m_Stats.bytesAllocated += obj->bytes;
+    m_Stats.bytesRequested += obj->bytes;
+    m_Debt += obj->bytes;
+    ++m_Stats.objectCount;
+    ++m_Stats.allocations;
+    return obj;
+}
+
+void VMHeap::Reaccount(VMObject* obj) {
+    u32 now = static_cast<u32>(ObjectBytes(obj));
+    if (now > obj->bytes) {
+        m_Debt += now - obj->bytes;
+        m_Stats.bytesRequested += now - obj->bytes;
+    }
+    m_Stats.bytesAllocated = m_Stats.bytesAllocated + now - obj->bytes;
+    obj->bytes = now;
+}
+
+VMString* VMHeap::Intern(std::string_view text) {
+    const u32 hash = HashString(text);
+    VMString** slot = FindSlot(text, hash);
+    if (*slot && *slot != kTombstone) return *slot;
+
+    CheckSize(text.size(), m_StringLimit, "string length");
+    if ((m_StringUsed + 1) * 4 > m_Strings.size() * 3) {
+        GrowStrings();
+        slot = FindSlot(text, hash);
+    }
+    void* mem = ::operator new(sizeof(VMString) + text.size() + 1);
+    VMString* str = new (mem) VMString();
+    str->hash = hash;
+    str->length = static_cast<u32>(text.size());
+    char* chars = reinterpret_cast<char*>(str + 1);
+    if (!text.empty()) std::memcpy(chars, text.data(), text.size());
+    chars[text.size()] = '\0';
+
+    if (*slot != kTombstone) ++m_StringUsed;
+    *slot = str;
+    ++m_StringCount;
+    return Track(str);
+}
+
+VMString* VMHeap::FindString(std::string_view text) const {
+    VMString* s = *const_cast<VMHeap*>(this)->FindSlot(text, HashString(text));
+    return s == kTombstone ? nullptr : s;
+}
+
+VMString** VMHeap::FindSlot(std::string_view text, u32 hash) {
+    const size_t mask = m_Strings.size() - 1;
+    VMString** tomb = nullptr;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        VMString*& s = m_Strings[i];
+        if (!s) return tomb ? tomb : &s;
+        if (s == kTombstone) { if (!tomb) tomb = &s; continue; }
+        if (s->hash == hash && s->View() == text) return &s;
+    }
+}
+
+void VMHeap::GrowStrings() {
+    std::vector<VMString*> old;
+    old.swap(m_Strings);
+    size_t cap = old.size();
+    if (m_StringCount * 2 >= cap / 2) cap *= 2;   // else just clear tombstones
+    m_Strings.assign(cap, nullptr);
+    m_StringUsed = 0;
+    for (VMString* s : old) {
+        if (!s || s == kTombstone) continue;
+        *FindSlot(s->View(), s->hash) = s;
+        ++m_StringUsed;
+    }
+}
+
+void VMHeap::PurgeDeadStrings() {
+    for (VMString*& s : m_Strings) {
+        if (s && s != kTombstone && s->color == m_White) {
+            s = kTombstone;
+            --m_StringCount;
+        }
+    }
+}
+
+VMArray* VMHeap::NewArray(u32 reserve) {
+    VMArray* a = new VMArray();
+    if (reserve) a->items.reserve(reserve);
+    return Track(a);
+}
+
+VMMap* VMHeap::NewMap()           { return Track(new VMMap()); }
+VMFunction* VMHeap::NewFunction() { return Track(new VMFunction()); }
+
+VMClosure* VMHeap::NewClosure(VMFunction* function) {
+    VMClosure* c = new VMClosure();
+    c->function = function;
+    c->upvalues.assign(function->upvalueCount, nullptr);
+    return Track(c);
+}
+
+VMUpvalue* VMHeap::NewUpvalue(std::vector<VMValue>* stack, u32 slot) {
+    VMUpvalue* u = new VMUpvalue();
+    u->stack = stack;
+    u->slot = slot;
+    return Track(u);
+}
+
+void VMHeap::Free(VMObject* obj) {
+    m_Stats.bytesAllocated -= obj->bytes;
+    --m_Stats.objectCount;
+    ++m_Stats.freed;
+    switch (obj->type) {
+        case VMObjectType::String: {
+            VMString* s = static_cast<VMString*>(obj);
+            s->~VMString();
+            ::operator delete(s);
+            break;
+        }
+        case VMObjectType::Array:    delete static_cast<VMArray*>(obj); break;
+        case VMObjectType::Map:      delete static_cast<VMMap*>(obj); break;
+        case VMObjectType::Function: delete static_cast<VMFunction*>(obj); break;
+        case VMObjectType::Closure:  delete static_cast<VMClosure*>(obj); break;
+        case VMObjectType::Upvalue:  delete static_cast<VMUpvalue*>(obj); break;
+    }
+}
+
+// ── Mutation ───────────────────────────────────────────────────────────────
+
+void VMHeap::ArrayPush(VMArray* array, VMValue value) {
+    size_t cap = array->items.capacity();
+    array->items.push_back(value);
+    if (array->items.capacity() != cap) Reaccount(array);
+    CheckSize(array->items.size(), m_ContainerLimit, "array size");
+    Barrier(array, value);
+}
+
+void VMHeap::ArrayResize(VMArray* array, u32 size) {
+    CheckSize(size, m_ContainerLimit, "array size");
+    array->items.resize(size);
+    Reaccount(array);
+}
+
+void VMHeap::MapSet(VMMap* map, VMValue key, VMValue value) {
+    key = VMMap::NormalKey(key);
+    auto it = map->index.find(key.Bits());
+    if (it != map->index.end()) {
+        map->values[it->second] = value;
+    } else {
+        map->index.emplace(key.Bits(), static_cast<u32>(map->keys.size()));
+        map->keys.push_back(key);
+        map->values.push_back(value);
+        Reaccount(map);
+        CheckSize(map->keys.size(), m_ContainerLimit, "map size");
+        Barrier(map, key);
+    }
+    Barrier(map, value);
+}
+
+bool VMHeap::MapRemove(VMMap* map, VMValue key) {
+    key = VMMap::NormalKey(key);
+    auto it = map->index.find(key.Bits());
+    if (it == map->index.end()) return false;
+    const u32 slot = it->second;
+    const u32 last = static_cast<u32>(map->keys.size()) - 1;
+    map->index.erase(it);
+    if (slot != last) {
+        map->keys[slot] = map->keys[last];
+        map->values[slot] = map->values[last];
+        map->index[map->keys[slot].Bits()] = slot;
+    }
+    map->keys.pop_back();
+    map->values.pop_back();
+    Reaccount(map);
+    return true;
+}
+
+void VMHeap::CloseUpvalue(VMUpvalue* upvalue) {
+    upvalue->closed = upvalue->Get();
+    upvalue->stack = nullptr;
+    Barrier(upvalue, upvalue->closed);
+}
+
+void VMHeap::SetUpvalue(VMUpvalue* upvalue, VMValue value) {
+    if (upvalue->stack) {
+        (*upvalue->stack)[upvalue->slot] = value;
+    } else {
+        upvalue->closed = value;
+        Barrier(upvalue, value);
+    }
+}
+
+// ── Marking ────────────────────────────────────────────────────────────────
+
+void VMHeap::MarkObject(VMObject* obj) {
+    if (!obj || obj->color != m_White) return;
+    if (obj->type == VMObjectType::String) { obj->color = kBlack; return; }   // no children
+    obj->color = kGray;
+    m_Gray.push_back(obj);
+}
+
+void VMHeap::Regray(VMObject* obj) {
+    obj->color = kGray;
+    m_Gray.push_back(obj);
+}
+
+void VMHeap::Traverse(VMObject* obj) {
+    obj->color = kBlack;
+    switch (obj->type) {
+        case VMObjectType::String: break;
+        case VMObjectType::Array:
+            for (VMValue v : static_cast<VMArray*>(obj)->items) MarkValue(v);
+            break;
+        case VMObjectType::Map: {
+            VMMap* m = static_cast<VMMap*>(obj);
+            for (VMValue v : m->keys)   MarkValue(v);
+            for (VMValue v : m->values) MarkValue(v);
+            break;
+        }
+        case VMObjectType::Function: {
+            VMFunction* f = static_cast<VMFunction*>(obj);
+            MarkObject(f->name);
+            MarkObject(f->chunk);
+            for (VMValue v : f->constants) MarkValue(v);
+            break;
+        }
+        case VMObjectType::Closure: {
+            VMClosure* c = static_cast<VMClosure*>(obj);
+            MarkObject(c->function);
+            MarkObject(c->env);
+            for (VMUpvalue* u : c->upvalues) MarkObject(u);
+            break;
+        }
+        case VMObjectType::Upvalue: {
+            VMUpvalue* u = static_cast<VMUpvalue*>(obj);
+            if (!u->IsOpen()) MarkValue(u->closed);   // open: the stack is a root
+            break;
+        }
+    }
+}
+
+// ── Collection ─────────────────────────────────────────────────────────────
+
+void VMHeap::BeginCycle() {
+    m_Phase = VMGCPhase::Mark;
+    if (m_RootMarker) m_RootMarker(*this);
+    for (VMValue v : m_TempRoots) MarkValue(v);
+}
+
+void VMHeap::Atomic() {
+    if (m_RootMarker) m_RootMarker(*this);
+    for (VMValue v : m_TempRoots) MarkValue(v);
+    while (!m_Gray.empty()) {
+        VMObject* obj = m_Gray.back();
+        m_Gray.pop_back();
+        Traverse(obj);
+    }
+    PurgeDeadStrings();
+    m_White ^= 1;
+    m_Phase = VMGCPhase::Sweep;
+    m_SweepCursor = &m_Objects;
+}
+
+bool VMHeap::Step(u32 work, bool force) {
+    if (m_Pause) return false;
+    if (m_Phase == VMGCPhase::Idle) {
+        if (!force && m_Stats.bytesAllocated < m_Threshold) return false;
+        BeginCycle();
+    }
+    ++m_Stats.steps;
+    i64 budget = work ? work : 1;
+    while (budget > 0) {
+        if (m_Phase == VMGCPhase::Mark) {
+            if (m_Gray.empty()) { Atomic(); continue; }
+            VMObject* obj = m_Gray.back();
+            m_Gray.pop_back();
+            Traverse(obj);
+            budget -= 1 + static_cast<i64>(obj->bytes / 256);
+        } else {
+            VMObject* obj = *m_SweepCursor;
+            if (!obj) {
+                m_Phase = VMGCPhase::Idle;
+                m_SweepCursor = nullptr;
+                u64 next = static_cast<u64>(static_cast<f64>(m_Stats.bytesAllocated) * m_GrowthFactor);
+                m_Threshold = std::max(next, m_MinThreshold);
+                ++m_Stats.cycles;
+                m_Debt = 0;
+                return true;
+            }
+            if (obj->color == (m_White ^ 1)) {
+                *m_SweepCursor = obj->next;
+                Free(obj);
+            } else {
+                obj->color = m_White;
+                m_SweepCursor = &obj->next;
+            }
+            --budget;
+        }
+    }
+    return false;
+}
+
+// Collector work proportional to allocation: two units per 64 bytes
+// allocated since the last step, so a cycle always finishes before the
+// heap can double.
+void VMHeap::PayDebt() {
+    if (!WantsStep()) { m_Debt = 0; return; }
+    u32 work = static_cast<u32>(std::min<u64>(m_Debt / 32, 1u << 20));
+    m_Debt = 0;
+    Step(work);
+}
+
+void VMHeap::FullCollect() {
+    if (m_Pause) return;
+    while (m_Phase != VMGCPhase::Idle) Step(1u << 30);
+    Step(1u << 30, true);
+    while (m_Phase != VMGCPhase::Idle) Step(1u << 30);
+}
+
+// ── Quotas ─────────────────────────────────────────────────────────────────
+
+void VMHeap::SetQuota(u64 bytes, u32 maxStringLength, u32 maxContainerSize) {
+    m_QuotaBytes     = bytes;
+    m_QuotaCeiling   = bytes ? m_Stats.bytesRequested + bytes : ~0ull;
+    m_StringLimit    = maxStringLength;
+    m_ContainerLimit = maxContainerSize;
+    m_SizeBreach     = nullptr;
+}
+
+void VMHeap::ClearQuota() { SetQuota(0, 0, 0); }
+
+std::string VMHeap::QuotaBreach() const {
+    if (m_SizeBreach) return std::string(m_SizeBreach) + " limit exceeded";
+    return "memory quota exceeded (" + std::to_string(m_QuotaBytes) + " bytes)";
+}
+
+VMHeapStats VMHeap::GetStats() const {
+    VMHeapStats s = m_Stats;
+    s.stringCount = m_StringCount;
+    return s;
+}
+
+void VMHeap::Reset() {
+    VMObject* obj = m_Objects;
+    while (obj) {
+        VMObject* next = obj->next;
+        Free(obj);
+        obj = next;
+    }
+    m_Objects = nullptr;
+    m_SweepCursor = nullptr;
+    m_Gray.clear();
+    m_TempRoots.clear();
+    m_Strings.assign(64, nullptr);
+    m_StringCount = m_StringUsed = 0;
+    m_Phase = VMGCPhase::Idle;
+    m_Debt = 0;
+    m_Threshold = m_MinThreshold;
+}
+
+} // namespace gv
@@ -6,7 +6,9 @@
 #include "core/GameObject.h"
 #include "physics/Physics.h"
 #include "editor2d/Editor2DTypes.h"
+#include <algorithm>
 #include <cmath>
+#include <fstream>
 #include <iostream>
 
 namespace gv {
@@ -18,40 +20,64 @@ const std::string& BehaviorAnalyzer::GetBehaviorStateName() const {
     return names[static_cast<int>(m_BehaviorState)];
 }
 
+BehaviorAnalyzer::~BehaviorAnalyzer() {
+    BehaviorAnalysisSystem::Instance().Unregister(this);
+}
+
+void BehaviorAnalyzer::OnAttach() {
+    BindBody();
+    BehaviorAnalysisSystem::Instance().Register(this);
+}
+
+void BehaviorAnalyzer::OnDetach() {
+    BehaviorAnalysisSystem::Instance().Unregister(this);
+    m_Body = nullptr;
+    m_Body2D = nullptr;
+}
+
+void BehaviorAnalyzer::OnComponentAdded(Component* added) {
+    if (!m_Body && (dynamic_cast<RigidBody*>(added) || dynamic_cast<RigidBody2D*>(added))) BindBody();
+}
+
+void BehaviorAnalyzer::OnComponentRemoved(Component* removed) {
+    if (removed == m_Body || removed == m_Body2D) BindBody();
+}
+
+void BehaviorAnalyzer::BindBody() {
+    m_Body = nullptr;
+    m_Body2D = nullptr;
+    if (GameObject* obj = GetOwner()) {
+        m_Body = obj->GetComponent<RigidBody>();
+        if (!m_Body) m_Body2D = obj->GetComponent<RigidBody2D>();
+    }
+}
+
 void BehaviorAnalyzer::Update(f32 dt) {
-    auto* obj = GetGameObject();
-    if (!obj) return;
+    if (!GetOwner()) return;
 
-    UpdateMetrics(dt);
+    UpdateMetrics(dt, m_Body, m_Body2D);
     UpdateBehaviorState();
-    RecordToHistory();
+    RecordToHistory(dt);
 
     if (enableDebugLog) {
         PrintBehaviorReport();
     }
 }
 
-void BehaviorAnalyzer::UpdateMetrics(f32 dt) {
-    auto* obj = GetGameObject();
-    if (!obj) return;
-
+void BehaviorAnalyzer::UpdateMetrics(f32 dt, const RigidBody* body, const RigidBody2D* body2D) {
     // Get velocity
     Vec3 velocity(0, 0, 0);
     Vec3 angularVel(0, 0, 0);
     f32 mass = 1.0f;
 
-    auto* rb = obj->GetComponent<RigidBody>();
-    if (rb) {
-        velocity = rb->velocity;
-        angularVel = rb->angularVelocity;
-        mass = rb->mass;
-    } else {
-        auto* rb2d = obj->GetComponent<RigidBody2D>();
-        if (rb2d) {
-            velocity = Vec3(rb2d->velocity.x, rb2d->velocity.y, 0);
-            angularVel = Vec3(0, 0, rb2d->angularVel);
-            mass = rb2d->mass;
-        }
+    if (body) {
+        velocity = body->velocity;
+        angularVel = body->angularVelocity;
+        mass = body->mass;
+    } else if (body2D) {
+        velocity = Vec3(body2D->velocity.x, body2D->velocity.y, 0);
+        angularVel = Vec3(0, 0, body2D->angularVel);
+        mass = body2D->mass;
     }
 
     // Compute magnitudes
@@ -59,7 +85,7 @@ void BehaviorAnalyzer::UpdateMetrics(f32 dt) {
     m_AngularVelocityMagnitude = angularVel.Length();
 
     // Acceleration (finite difference)
-    ComputeAcceleration();
+    ComputeAcceleration(velocity, dt);
 
     // Kinetic energy (0.5 * m * v^2)
     m_KineticEnergy = 0.5f * mass * (m_VelocityMagnitude * m_VelocityMagnitude);
@@ -91,44 +117,138 @@ void BehaviorAnalyzer::UpdateBehaviorState() {
     }
 }
 
-void BehaviorAnalyzer::RecordToHistory() {
-    m_VelocityHistory.push_back(m_VelocityMagnitude);
-    m_EnergyHistory.push_back(m_KineticEnergy);
-    m_MomentumHistory.push_back(m_MomentumMagnitude);
-
-    // Trim history to buffer size
-    while (m_VelocityHistory.size() > historyBufferSize) {
-        m_VelocityHistory.erase(m_VelocityHistory.begin());
-        m_EnergyHistory.erase(m_EnergyHistory.begin());
-        m_MomentumHistory.erase(m_MomentumHistory.begin());
+void BehaviorAnalyzer::RecordToHistory(f32 dt) {
+    size_t capacity = historyBufferSize > 0 ? static_cast<size_t>(historyBufferSize) : 1;
+    if (m_History[0].Capacity() != capacity) {
+        for (i32 c = 0; c < kChannelCount; ++c) {
+            m_History[c].SetCapacity(capacity);
+            m_Stats[c].Reset();
+        }
     }
-}
 
-void BehaviorAnalyzer::ComputeAcceleration() {
-    auto* obj = GetGameObject();
-    if (!obj) return;
+    const f32 samples[kChannelCount] = { m_VelocityMagnitude, m_KineticEnergy, m_MomentumMagnitude };
+    for (i32 c = 0; c < kChannelCount; ++c) {
+        if (m_History[c].Full()) m_Stats[c].Remove(m_History[c].Oldest());
+        m_History[c].Push(samples[c]);
+        m_Stats[c].Add(samples[c]);
+    }
 
-    Vec3 currentVel = Vec3(0, 0, 0);
-    auto* rb = obj->GetComponent<RigidBody>();
-    if (rb) currentVel = rb->velocity;
-    else {
-        auto* rb2d = obj->GetComponent<RigidBody2D>();
-        if (rb2d) currentVel = Vec3(rb2d->velocity.x, rb2d->velocity.y, 0);
+    // Running sums drift with float noise; re-anchor once per window.
+    if (++m_FramesRecorded % capacity == 0) {
+        for (i32 c = 0; c < kChannelCount; ++c) {
+            m_Stats[c].Reset();
+            for (f32 v : m_History[c].View()) m_Stats[c].Add(v);
+        }
     }
 
-    Vec3 accel = (currentVel - m_PreviousVelocity);  // Simplified: no dt
-    m_AccelerationMagnitude = accel.Length();
+    m_SampleDt = (m_SampleDt <= 0.0f) ? dt : Lerpf(m_SampleDt, dt, 0.05f);
+}
+
+void BehaviorAnalyzer::ComputeAcceleration(const Vec3& currentVel, f32 dt) {
+    Vec3 dv = currentVel - m_PreviousVelocity;
+    m_AccelerationMagnitude = (dt > 1e-6f) ? dv.Length() / dt : 0.0f;
     m_PreviousVelocity = currentVel;
 }
 
 void BehaviorAnalyzer::OnDestroy() {
-    m_VelocityHistory.clear();
-    m_EnergyHistory.clear();
-    m_MomentumHistory.clear();
+    for (i32 c = 0; c < kChannelCount; ++c) {
+        m_History[c].Clear();
+        m_Stats[c].Reset();
+    }
+    m_FramesRecorded = 0;
+}
+
+f32 BehaviorAnalyzer::GetPercentile(BehaviorChannel ch, f32 p) const {
+    ArrayView<f32> view = GetHistory(ch);
+    if (view.empty()) return 0.0f;
+    const i32 c = static_cast<i32>(ch);
+    std::vector<f32>& sorted = m_Sorted[c];
+    if (m_SortedFrame[c] != m_FramesRecorded || sorted.size() != view.size) {
+        sorted.assign(view.begin(), view.end());   // reuses capacity
+        std::sort(sorted.begin(), sorted.end());
+        m_SortedFrame[c] = m_FramesRecorded;
+    }
+    f32 clamped = std::min(std::max(p, 0.0f), 100.0f);
+    size_t rank = static_cast<size_t>(std::ceil(clamped / 100.0f * f32(sorted.size())));
+    size_t idx  = rank > 0 ? rank - 1 : 0;
+    return sorted[idx];
+}
+
+OscillationInfo BehaviorAnalyzer::DetectOscillation(BehaviorChannel ch, f32 minAmplitude,
+                                                    i32 minCycles) const {
+    OscillationInfo info;
+    ArrayView<f32> view = GetHistory(ch);
+    if (view.size < 4) return info;
+
+    // Count crossings of the window mean, ignoring wiggles inside the
+    // hysteresis band, and average each half-cycle's peak excursion.
+    const f32 mean = GetMean(ch);
+    i32 side = 0;
+    f32 extreme = 0.0f, peakSum = 0.0f;
+    i32 halfCycles = 0;
+    for (f32 v : view) {
+        f32 d = v - mean;
+        if (d > minAmplitude || d < -minAmplitude) {
+            i32 s = d > 0.0f ? 1 : -1;
+            if (side != 0 && s != side) {
+                ++info.crossings;
+                peakSum += extreme;
+                ++halfCycles;
+                extreme = 0.0f;
+            }
+            side = s;
+        }
+        extreme = std::max(extreme, std::fabs(d));
+    }
+
+    f32 window = m_SampleDt * f32(view.size);
+    if (halfCycles > 0) info.amplitude = peakSum / f32(halfCycles);
+    if (window > 0.0f)  info.frequency = f32(info.crossings) * 0.5f / window;
+    info.oscillating = info.crossings >= 2 * minCycles;
+    return info;
+}
+
+bool BehaviorAnalyzer::ExportCSV(const std::string& path) const {
+    std::ofstream f(path);
+    if (!f.is_open()) {
+        GV_LOG_ERROR("BehaviorAnalyzer — cannot write trace '" + path + "'");
+        return false;
+    }
+    f << "frame,time,velocity,energy,momentum\n";
+    size_t n = m_History[0].Size();
+    u64 first = m_FramesRecorded - n;
+    for (size_t i = 0; i < n; ++i) {
+        u64 frame = first + i;
+        f << frame << ',' << f32(frame) * m_SampleDt;
+        for (i32 c = 0; c < kChannelCount; ++c) f << ',' << m_History[c][i];
+        f << '\n';
+    }
+    return f.good();
+}
+
+bool BehaviorAnalyzer::ExportBinary(const std::string& path) const {
+    std::ofstream f(path, std::ios::binary);
+    if (!f.is_open()) {
+        GV_LOG_ERROR("BehaviorAnalyzer — cannot write trace '" + path + "'");
+        return false;
+    }
+    const u32 version = 1;
+    const u32 samples = static_cast<u32>(m_History[0].Size());
+    const u32 channels = static_cast<u32>(kChannelCount);
+    f.write("GVBT", 4);
+    f.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    f.write(reinterpret_cast<const char*>(&samples), sizeof(samples));
+    f.write(reinterpret_cast<const char*>(&channels), sizeof(channels));
+    f.write(reinterpret_cast<const char*>(&m_SampleDt), sizeof(m_SampleDt));
+    for (i32 c = 0; c < kChannelCount; ++c) {
+        ArrayView<f32> v = m_History[c].View();
+        f.write(reinterpret_cast<const char*>(v.data), static_cast<std::streamsize>(v.size * sizeof(f32)));
+    }
+    return f.good();
 }
 
 void BehaviorAnalyzer::PrintBehaviorReport() const {
-    std::cout << "[Behavior] " << GetGameObject()->GetName() << " - "
+    std::cout << "[Behavior] " << (GetOwner() ? GetOwner()->GetName() : std::string("?")) << " - "
               << GetBehaviorStateName() << " | "
               << "Vel: " << m_VelocityMagnitude << " m/s | "
               << "Acc: " << m_AccelerationMagnitude << " m/s² | "
@@ -137,11 +257,52 @@ void BehaviorAnalyzer::PrintBehaviorReport() const {
 }
 
 std::string BehaviorAnalyzer::GetBehaviorSummary() const {
-    std::string summary = GetGameObject()->GetName() + " [" + GetBehaviorStateName() + "]\n";
+    std::string summary = (GetOwner() ? GetOwner()->GetName() : std::string("?")) + " [" + GetBehaviorStateName() + "]\n";
     summary += "Velocity: " + std::to_string(m_VelocityMagnitude) + " m/s\n";
     summary += "Kinetic Energy: " + std::to_string(m_KineticEnergy) + " J\n";
     summary += "Angular Velocity: " + std::to_string(m_AngularVelocityMagnitude) + " rad/s\n";
     return summary;
 }
 
+// ============================================================================
+// BehaviorAnalysisSystem
+// ============================================================================
+
+void BehaviorAnalysisSystem::Register(BehaviorAnalyzer* analyzer) {
+    if (!analyzer) return;
+    if (std::find(m_Analyzers.begin(), m_Analyzers.end(), analyzer) == m_Analyzers.end())
+        m_Analyzers.push_back(analyzer);
+}
+
+void BehaviorAnalysisSystem::Unregister(BehaviorAnalyzer* analyzer) {
+    m_Analyzers.erase(std::remove(m_Analyzers.begin(), m_Analyzers.end(), analyzer),
+                      m_Analyzers.end());
+}
+
+void BehaviorAnalysisSystem::Analyze(f32 dt) {
+    for (auto* a : m_Analyzers) {
+        GameObject* owner = a->GetOwner();
+        if (!a->IsEnabled() || !owner || !owner->IsActive()) continue;
+        a->Update(dt);
+    }
+}
+
+bool BehaviorAnalysisSystem::ExportCSV(const std::string& path) const {
+    std::ofstream f(path);
+    if (!f.is_open()) {
+        GV_LOG_ERROR("BehaviorAnalysisSystem — cannot write trace '" + path + "'");
+        return false;
+    }
+    f << "object,sample,velocity,energy,momentum\n";
+    for (auto* a : m_Analyzers) {
+        std::string name = a->GetOwner() ? a->GetOwner()->GetName() : std::string("?");
+        ArrayView<f32> vel = a->GetVelocityHistory();
+        ArrayView<f32> en  = a->GetEnergyHistory();
+        ArrayView<f32> mom = a->GetMomentumHistory();
+        for (size_t i = 0; i < vel.size; ++i)
+            f << name << ',' << i << ',' << vel[i] << ',' << en[i] << ',' << mom[i] << '\n';
+    }
+    return f.good();
+}
+
 } // namespace gv
@@ -6,14 +6,38 @@
 #include "core/GameObject.h"
 #include "physics/Physics.h" // for RigidBody
 #include "editor2d/Editor2DTypes.h" // for RigidBody2D
+#ifdef GV_HAS_GLFW
 #include <imgui.h>
+#endif
 #include <cmath>
 
 namespace gv {
 
 void ForceController::OnCreate() {}
 void ForceController::OnDestroy() { m_KeyForceBindings.clear(); m_KeyMomentBindings.clear(); }
-void ForceController::Update(f32 dt) { ProcessInputBindings(); ApplyGravityOverride(); ApplyDamping(dt); ClampVelocities(); }
+void ForceController::Update(f32 dt) {
+    m_Dt = dt;
+    m_CurrentForce = Vec3(0, 0, 0);
+    m_CurrentMoment = Vec3(0, 0, 0);
+    ProcessInputBindings(); ApplyGravityOverride(); ApplyDamping(dt); ClampVelocities();
+}
+
+void ForceController::BindBody() {
+    m_Body = nullptr;
+    m_Body2D = nullptr;
+    if (auto* obj = GetOwner()) {
+        m_Body = obj->GetComponent<RigidBody>();
+        if (!m_Body) m_Body2D = obj->GetComponent<RigidBody2D>();
+    }
+}
+
+void ForceController::OnComponentAdded(Component* added) {
+    if (!m_Body && (dynamic_cast<RigidBody*>(added) || dynamic_cast<RigidBody2D*>(added))) BindBody();
+}
+
+void ForceController::OnComponentRemoved(Component* removed) {
+    if (removed == m_Body || removed == m_Body2D) BindBody();
+}
 
 void ForceController::ApplyForceInDirection(ForceDirection dir, f32 magnitude) {
     ApplyForceVector(GetForceDirectionVector(dir) * magnitude);
@@ -22,31 +46,48 @@ void ForceController::ApplyMomentInDirection(MomentDirection dir, f32 magnitude)
     ApplyMomentVector(GetMomentDirectionVector(dir) * magnitude);
 }
 void ForceController::ApplyForceVector(const Vec3& force) {
-    auto* obj = GetOwner();
-    if (!obj) return;
-    auto* rb = obj->GetComponent<RigidBody>();
-    if (rb) {
+    if (auto* rb = m_Body) {
+        // Continuous forces go through the body's accumulator so PhysicsWorld
+        // integrates them with its own fixed step.
         if (immediateMode) rb->velocity += force / rb->mass;
-        else { m_CurrentForce += force; rb->velocity += (force / rb->mass) * (1.0f / 60.0f); }
+        else { m_CurrentForce += force; rb->AddForce(force); }
         return;
     }
-    auto* rb2d = obj->GetComponent<RigidBody2D>();
-    if (rb2d) {
+    if (auto* rb2d = m_Body2D) {
         if (immediateMode) { rb2d->velocity.x += force.x / rb2d->mass; rb2d->velocity.y += force.y / rb2d->mass; }
-        else { m_CurrentForce += force; rb2d->velocity.x += (force.x / rb2d->mass) * (1.0f / 60.0f); rb2d->velocity.y += (force.y / rb2d->mass) * (1.0f / 60.0f); }
+        else { m_CurrentForce += force; rb2d->velocity.x += (force.x / rb2d->mass) * m_Dt; rb2d->velocity.y += (force.y / rb2d->mass) * m_Dt; }
         return;
     }
 }
 void ForceController::ApplyMomentVector(const Vec3& moment) {
-    auto* obj = GetOwner();
-    if (!obj) return;
-    auto* rb = obj->GetComponent<RigidBody>();
-    if (rb) { rb->angularVelocity += moment; m_CurrentMoment += moment; return; }
-    auto* rb2d = obj->GetComponent<RigidBody2D>();
-    if (rb2d) { rb2d->angularVel += moment.z; m_CurrentMoment += moment; return; }
+    if (m_Body) { m_Body->angularVelocity += moment; m_CurrentMoment += moment; return; }
+    if (m_Body2D) { m_Body2D->angularVel += moment.z; m_CurrentMoment += moment; return; }
+}
+
+i32 ForceController::ResolveKeyCode(const std::string& keyName) {
+#ifdef GV_HAS_GLFW
+    for (i32 k = ImGuiKey_NamedKey_BEGIN; k < ImGuiKey_NamedKey_END; ++k) {
+        const char* name = ImGui::GetKeyName(static_cast<ImGuiKey>(k));
+        if (name && keyName == name) return k;
+    }
+#else
+    (void)keyName;    // headless: no keyboard
+#endif
+    return -1;
+}
+
+bool ForceController::BindKeyToForce(const std::string& keyName, ForceDirection dir, f32 magnitude) {
+    i32 key = ResolveKeyCode(keyName);
+    if (key < 0) { GV_LOG_WARN("ForceController — unknown key '" + keyName + "'"); return false; }
+    m_KeyForceBindings.push_back({ key, dir, magnitude });
+    return true;
+}
+bool ForceController::BindKeyToMoment(const std::string& keyName, MomentDirection dir, f32 magnitude) {
+    i32 key = ResolveKeyCode(keyName);
+    if (key < 0) { GV_LOG_WARN("ForceController — unknown key '" + keyName + "'"); return false; }
+    m_KeyMomentBindings.push_back({ key, dir, magnitude });
+    return true;
 }
-void ForceController::BindKeyToForce(const std::string& keyName, ForceDirection dir, f32 magnitude) { m_KeyForceBindings.push_back({keyName, {dir, magnitude}}); }
-void ForceController::BindKeyToMoment(const std::string& keyName, MomentDirection dir, f32 magnitude) { m_KeyMomentBindings.push_back({keyName, {dir, magnitude}}); }
 
 Vec3 ForceController::GetForceDirectionVector(ForceDirection dir) const {
     switch (dir) {
@@ -71,37 +112,24 @@ Vec3 ForceController::GetMomentDirectionVector(MomentDirection dir) const {
 }
 
 void ForceController::ProcessInputBindings() {
-    for (auto& binding : m_KeyForceBindings) {
-        if (ImGui::IsKeyDown(ImGuiKey_UpArrow) && binding.first == "UpArrow") ApplyForceInDirection(binding.second.first, binding.second.second);
-        if (ImGui::IsKeyDown(ImGuiKey_DownArrow) && binding.first == "DownArrow") ApplyForceInDirection(binding.second.first, binding.second.second);
-        if (ImGui::IsKeyDown(ImGuiKey_LeftArrow) && binding.first == "LeftArrow") ApplyForceInDirection(binding.second.first, binding.second.second);
-        if (ImGui::IsKeyDown(ImGuiKey_RightArrow) && binding.first == "RightArrow") ApplyForceInDirection(binding.second.first, binding.second.second);
-        if (ImGui::IsKeyDown(ImGuiKey_W) && binding.first == "W") ApplyForceInDirection(binding.second.first, binding.second.second);
-        if (ImGui::IsKeyDown(ImGuiKey_A) && binding.first == "A") ApplyForceInDirection(binding.second.first, binding.second.second);
-        if (ImGui::IsKeyDown(ImGuiKey_S) && binding.first == "S") ApplyForceInDirection(binding.second.first, binding.second.second);
-        if (ImGui::IsKeyDown(ImGuiKey_D) && binding.first == "D") ApplyForceInDirection(binding.second.first, binding.second.second);
-        if (ImGui::IsKeyDown(ImGuiKey_Space) && binding.first == "Space") ApplyForceInDirection(binding.second.first, binding.second.second);
-    }
-    for (auto& binding : m_KeyMomentBindings) {
-        if (ImGui::IsKeyDown(ImGuiKey_Q) && binding.first == "Q") ApplyMomentInDirection(binding.second.first, binding.second.second);
-        if (ImGui::IsKeyDown(ImGuiKey_E) && binding.first == "E") ApplyMomentInDirection(binding.second.first, binding.second.second);
-    }
+#ifdef GV_HAS_GLFW
+    for (const auto& b : m_KeyForceBindings)
+        if (ImGui::IsKeyDown(static_cast<ImGuiKey>(b.key))) ApplyForceInDirection(b.dir, b.magnitude);
+    for (const auto& b : m_KeyMomentBindings)
+        if (ImGui::IsKeyDown(static_cast<ImGuiKey>(b.key))) ApplyMomentInDirection(b.dir, b.magnitude);
+#endif
 }
 
 void ForceController::ApplyDamping(f32 dt) {
-    auto* obj = GetOwner();
-    if (!obj) return;
-    auto* rb = obj->GetComponent<RigidBody>();
+    auto* rb = m_Body;
     if (rb) { rb->velocity *= (1.0f - m_LinearDamping * dt); rb->angularVelocity *= (1.0f - m_AngularDamping * dt); return; }
-    auto* rb2d = obj->GetComponent<RigidBody2D>();
+    auto* rb2d = m_Body2D;
     if (rb2d) { rb2d->velocity *= (1.0f - m_LinearDamping * dt); rb2d->angularVel *= (1.0f - m_AngularDamping * dt); return; }
 }
 
 
 void ForceController::ClampVelocities() {
-    auto* obj = GetOwner();
-    if (!obj) return;
-    auto* rb = obj->GetComponent<RigidBody>();
+    auto* rb = m_Body;
     if (rb) {
         f32 speed = rb->velocity.Length();
         if (speed > m_MaxVelocity) rb->velocity = (rb->velocity / speed) * m_MaxVelocity;
@@ -109,7 +137,7 @@ void ForceController::ClampVelocities() {
         if (angSpeed > m_MaxAngularVelocity) rb->angularVelocity = (rb->angularVelocity / angSpeed) * m_MaxAngularVelocity;
         return;
     }
-    auto* rb2d = obj->GetComponent<RigidBody2D>();
+    auto* rb2d = m_Body2D;
     if (rb2d) {
         f32 speed = rb2d->velocity.Length();
         if (speed > m_MaxVelocity) rb2d->velocity = (rb2d->velocity / speed) * m_MaxVelocity;
@@ -121,30 +149,24 @@ void ForceController::ClampVelocities() {
 // --- Out-of-namespace implementations for linkage ---
 void gv::ForceController::ApplyGravityOverride() {
     if (m_DisableGravity || !m_UseCustomGravity) return;
-    auto* obj = GetOwner();
-    if (!obj) return;
-    auto* rb = obj->GetComponent<RigidBody>();
-    if (rb) { rb->velocity.y += m_CustomGravity * (1.0f / 60.0f); return; }
-    auto* rb2d = obj->GetComponent<RigidBody2D>();
-    if (rb2d) { rb2d->velocity.y += m_CustomGravity * (1.0f / 60.0f); return; }
+    auto* rb = m_Body;
+    if (rb) { rb->velocity.y += m_CustomGravity * m_Dt; return; }
+    auto* rb2d = m_Body2D;
+    if (rb2d) { rb2d->velocity.y += m_CustomGravity * m_Dt; return; }
 }
 
 f32 gv::ForceController::GetCurrentSpeed() const {
-    auto* obj = GetOwner();
-    if (!obj) return 0.0f;
-    auto* rb = obj->GetComponent<RigidBody>();
+    auto* rb = m_Body;
     if (rb) return rb->velocity.Length();
-    auto* rb2d = obj->GetComponent<RigidBody2D>();
+    auto* rb2d = m_Body2D;
     if (rb2d) return rb2d->velocity.Length();
     return 0.0f;
 }
 
 f32 gv::ForceController::GetCurrentAngularSpeed() const {
-    auto* obj = GetOwner();
-    if (!obj) return 0.0f;
-    auto* rb = obj->GetComponent<RigidBody>();
+    auto* rb = m_Body;
     if (rb) return rb->angularVelocity.Length();
-    auto* rb2d = obj->GetComponent<RigidBody2D>();
+    auto* rb2d = m_Body2D;
     if (rb2d) return std::fabs(rb2d->angularVel);
     return 0.0f;
 }
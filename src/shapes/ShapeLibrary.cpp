@@ -1,8 +1,10 @@
 #include "shapes/ShapeLibrary.h"
 #include "geometry/Primitives.h"
 #include "geometry/MeshBuilder.h"
+#include "assets/MeshRegistry.h"
 #include <cmath>
 
+namespace gv {
 namespace Shapes {
 
 static const float kPiSh = 3.14159265358979323846f;
@@ -264,7 +266,7 @@ MeshData Crater(float outerR, float innerR, float depth, int segs) {
     return m;
 }
 
-MeshData Hill(float radius, float height, int segs) {
+MeshData Hill(float radius, [[maybe_unused]] float height, int segs) {
     MeshData m = Primitives::Sphere(radius, segs, segs);
     for (auto& v : m.vertices) { v.position.y = std::max(v.position.y, 0.0f); }
     m.RecalcSmoothNormals(); m.name = "Hill";
@@ -282,4 +284,30 @@ MeshData Canyon(float length, float width, float depth, int segs) {
     return b.Merge().Build("Canyon");
 }
 
+// ── Shared meshes ─────────────────────────────────────────────────────────────
+
+Shared<Mesh> Acquire(MeshRegistry& registry, const std::string& name) {
+    using Factory = MeshData (*)();
+    static const struct { const char* name; Factory make; } kShapes[] = {
+        { "Chair",    [] { return Chair(); } },
+        { "Table",    [] { return Table(); } },
+        { "Bed",      [] { return Bed(); } },
+        { "Sofa",     [] { return Sofa(); } },
+        { "CarBody",  [] { return CarBody(); } },
+        { "CarWheel", [] { return CarWheel(); } },
+        { "CarCabin", [] { return CarCabin(); } },
+        { "TruckCab", [] { return TruckCab(); } },
+        { "TruckBed", [] { return TruckBed(); } },
+        { "Tree",     [] { return Tree(); } },
+        { "Rock",     [] { return Rock(); } },
+        { "Grass",    [] { return Grass(); } },
+        { "Bush",     [] { return Bush(); } },
+    };
+    for (const auto& s : kShapes) {
+        if (name == s.name) return registry.Acquire("Shapes::" + name + "()", s.make);
+    }
+    return nullptr;
+}
+
 } // namespace Shapes
+} // namespace gv
@@ -0,0 +1,11 @@
+// ============================================================================
+// GameVoid Engine — Headless Batch Runner Entry Point
+// ============================================================================
+// Standalone executable for build servers.  Equivalent to `GameVoid --batch`.
+// ============================================================================
+
+#include "editor/BatchRunner.h"
+
+int main(int argc, char* argv[]) {
+    return gv::BatchRunner::Main(argc, argv);
+}
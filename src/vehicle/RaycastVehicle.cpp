@@ -0,0 +1,489 @@
+#include "vehicle/RaycastVehicle.h"
+#include "core/GameObject.h"
+#include "physics/Physics.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace gv;
+
+namespace {
+
+constexpr f32 kPi        = 3.14159265358979f;
+constexpr f32 kTwoPi     = 2.0f * kPi;
+constexpr f32 kRadToRPM  = 60.0f / kTwoPi;
+constexpr i32 kWheelSubSteps = 4;
+
+inline f32 Clampf(f32 v, f32 lo, f32 hi) { return v < lo ? lo : (v > hi ? hi : v); }
+inline f32 Signf(f32 v) { return v < 0.0f ? -1.0f : 1.0f; }
+
+inline Quaternion Conjugate(const Quaternion& q) { return { -q.x, -q.y, -q.z, q.w }; }
+
+} // namespace
+
+/* ─── Tuning helpers ───────────────────────────────────────────────────── */
+
+f32 VehicleEngineConfig::SampleTorque(f32 rpm) const {
+    if (torqueCurve.empty()) return 0.0f;
+    if (rpm <= torqueCurve.front().x) return torqueCurve.front().y;
+    if (rpm >= torqueCurve.back().x)  return torqueCurve.back().y;
+    for (size_t i = 1; i < torqueCurve.size(); ++i) {
+        const Vec2& a = torqueCurve[i - 1];
+        const Vec2& b = torqueCurve[i];
+        if (rpm <= b.x) {
+            f32 span = b.x - a.x;
+            f32 t = span > 1e-4f ? (rpm - a.x) / span : 0.0f;
+            return Lerpf(a.y, b.y, t);
+        }
+    }
+    return torqueCurve.back().y;
+}
+
+VehicleConfig VehicleConfig::MakeDefaultCar(f32 halfTrack, f32 halfBase,
+                                            f32 hardpointY, f32 wheelRadius) {
+    VehicleConfig cfg;
+    auto makeWheel = [&](const char* n, f32 x, f32 z, i32 axle) {
+        VehicleWheelConfig w;
+        w.name      = n;
+        w.hardpoint = Vec3(x, hardpointY, z);
+        w.radius    = wheelRadius;
+        w.axle      = axle;
+        w.steerable = (axle == 0);
+        w.handbrake = (axle == 1);
+        cfg.wheels.push_back(w);
+    };
+    makeWheel("front_left_wheel",  -halfTrack,  halfBase, 0);
+    makeWheel("front_right_wheel",  halfTrack,  halfBase, 0);
+    makeWheel("rear_left_wheel",   -halfTrack, -halfBase, 1);
+    makeWheel("rear_right_wheel",   halfTrack, -halfBase, 1);
+    return cfg;
+}
+
+VehicleGroundQuery RaycastVehicle::MakePlaneGround(const Vec3& point, const Vec3& normal, f32 friction) {
+    Vec3 n = normal.Normalized();
+    return [point, n, friction](const Vec3& origin, const Vec3& dir, f32 maxDistance,
+                                VehicleRayHit& out) -> bool {
+        f32 denom = n.Dot(dir);
+        if (denom > -1e-6f) return false;             // parallel or pointing away
+        f32 t = n.Dot(point - origin) / denom;
+        if (t < 0.0f || t > maxDistance) return false;
+        out.point    = origin + dir * t;
+        out.normal   = n;
+        out.distance = t;
+        out.friction = friction;
+        return true;
+    };
+}
+
+/* ─── RaycastVehicle ───────────────────────────────────────────────────── */
+
+void RaycastVehicle::SetConfig(const VehicleConfig& config) {
+    m_Config = config;
+    if (m_Config.wheels.size() > kMaxWheels) {
+        GV_LOG_WARN("RaycastVehicle — " + std::to_string(m_Config.wheels.size()) + " wheels, keeping the first " +
+                    std::to_string(kMaxWheels));
+        m_Config.wheels.resize(kMaxWheels);
+    }
+    m_Wheels.assign(m_Config.wheels.size(), VehicleWheelState{});
+    Reset();
+}
+
+void RaycastVehicle::Reset() {
+    for (auto& w : m_Wheels) w = VehicleWheelState{};
+    m_EngineRPM    = m_Config.engine.idleRPM;
+    m_ForwardSpeed = 0.0f;
+    m_ShiftTimer   = 0.0f;
+    m_Gear         = 1;
+}
+
+Vec3 RaycastVehicle::GetWheelCenter(size_t i, const Vec3& chassisPos,
+                                    const Quaternion& chassisRot) const {
+    if (i >= m_Config.wheels.size()) return chassisPos;
+    const auto& wc = m_Config.wheels[i];
+    Vec3 up = chassisRot.RotateVec3(Vec3::Up());
+    Vec3 hp = chassisPos + chassisRot.RotateVec3(wc.hardpoint);
+    return hp - up * (wc.restLength - m_Wheels[i].compression);
+}
+
+bool RaycastVehicle::CastWheel(const Vec3& origin, const Vec3& dir, f32 maxDist,
+                               VehicleRayHit& hit, const RigidBody* chassis,
+                               const PhysicsWorld* physics) const {
+    if (m_GroundQuery) return m_GroundQuery(origin, dir, maxDist, hit);
+
+    bool found = false;
+    hit.distance = maxDist;
+
+    // Registered collider bodies (the chassis itself is skipped).
+    if (physics) {
+        CollisionInfo ci;
+        if (physics->Raycast(origin, dir, maxDist, ci, chassis)) {
+            f32 d = (ci.contactPoint - origin).Length();
+            if (d <= hit.distance) {
+                hit.point = ci.contactPoint; hit.normal = ci.contactNormal;
+                hit.distance = d; hit.friction = 1.0f;
+                found = true;
+            }
+        }
+    }
+
+    // Implicit Y = 0 floor, matching the PhysicsWorld floor constraint.
+    if (dir.y < -1e-6f && origin.y >= 0.0f) {
+        f32 t = -origin.y / dir.y;
+        if (t <= hit.distance) {
+            hit.point = origin + dir * t; hit.normal = Vec3::Up();
+            hit.distance = t; hit.friction = 1.0f;
+            found = true;
+        }
+    }
+    return found;
+}
+
+f32 RaycastVehicle::GearRatio() const {
+    const auto& gb = m_Config.gearbox;
+    if (m_Gear < 0) return -gb.reverseRatio * gb.finalDrive;
+    if (gb.forwardRatios.empty()) return 0.0f;
+    i32 idx = std::min<i32>(m_Gear, static_cast<i32>(gb.forwardRatios.size())) - 1;
+    return gb.forwardRatios[std::max(idx, 0)] * gb.finalDrive;
+}
+
+void RaycastVehicle::UpdateGearbox(f32 dt, const VehicleInput& input) {
+    const auto& gb = m_Config.gearbox;
+    const i32 topGear = static_cast<i32>(gb.forwardRatios.size());
+    if (m_ShiftTimer > 0.0f) m_ShiftTimer = std::max(0.0f, m_ShiftTimer - dt);
+
+    auto shiftTo = [&](i32 gear) {
+        if (gear == m_Gear) return;
+        m_Gear = gear;
+        m_ShiftTimer = gb.shiftTime;
+    };
+
+    if (!gb.automatic) {
+        if (m_ShiftTimer > 0.0f || input.gearRequest == 0) return;
+        if (input.gearRequest > 0) {
+            if (m_Gear < 0)            shiftTo(1);
+            else if (m_Gear < topGear) shiftTo(m_Gear + 1);
+        } else {
+            if (m_Gear > 1)                                 shiftTo(m_Gear - 1);
+            else if (m_Gear == 1 && m_ForwardSpeed < 1.0f)  shiftTo(-1);
+        }
+        return;
+    }
+
+    // Direction changes only happen near standstill.
+    if (input.reverse && m_Gear > 0 && m_ForwardSpeed < 1.0f)        { shiftTo(-1); return; }
+    if (!input.reverse && m_Gear < 0 && m_ForwardSpeed > -1.0f)      { shiftTo(1);  return; }
+    if (m_Gear < 1 || m_ShiftTimer > 0.0f) return;
+
+    // Shift on road speed rather than wheel speed so wheelspin doesn't
+    // trigger upshifts, and never downshift into a gear that would overrev.
+    f32 radius = m_Config.wheels.empty() ? 0.35f : m_Config.wheels.front().radius;
+    auto roadRPM = [&](i32 gear) {
+        i32 idx = std::clamp(gear, 1, topGear) - 1;
+        return std::fabs(m_ForwardSpeed) / radius * gb.forwardRatios[idx] * gb.finalDrive * kRadToRPM;
+    };
+    if (roadRPM(m_Gear) > gb.shiftUpRPM && m_Gear < topGear)
+        shiftTo(m_Gear + 1);
+    else if (roadRPM(m_Gear) < gb.shiftDownRPM && m_Gear > 1 &&
+             roadRPM(m_Gear - 1) < gb.shiftUpRPM * 0.9f)
+        shiftTo(m_Gear - 1);
+}
+
+void RaycastVehicle::DistributeDriveTorque(f32 wheelTorque) {
+    const auto& diff = m_Config.differential;
+    for (auto& w : m_Wheels) w.driveTorque = 0.0f;
+
+    for (i32 axle = 0; axle < 2; ++axle) {
+        f32 share = (axle == 0) ? diff.frontTorqueShare : (1.0f - diff.frontTorqueShare);
+        if (share <= 0.0f) continue;
+        f32 axleTorque = wheelTorque * share;
+
+        i32 idx[2] = { -1, -1 };
+        i32 count = 0;
+        for (size_t i = 0; i < m_Config.wheels.size(); ++i) {
+            if (m_Config.wheels[i].axle != axle) continue;
+            if (count < 2) idx[count] = static_cast<i32>(i);
+            ++count;
+        }
+        if (count == 0) continue;
+
+        if (count == 2 && diff.type == DifferentialType::LimitedSlip) {
+            // Move torque from the faster wheel to the slower one.
+            f32 half     = axleTorque * 0.5f;
+            f32 delta    = m_Wheels[idx[0]].angularVelocity - m_Wheels[idx[1]].angularVelocity;
+            f32 maxShift = diff.maxBiasRatio * std::fabs(half);
+            f32 transfer = Clampf(diff.limitedSlipBias * delta, -maxShift, maxShift);
+            m_Wheels[idx[0]].driveTorque = half - transfer;
+            m_Wheels[idx[1]].driveTorque = half + transfer;
+            continue;
+        }
+
+        // Open and locked diffs split torque evenly; a locked diff
+        // additionally ties the wheel speeds together after integration.
+        f32 each = axleTorque / static_cast<f32>(count);
+        for (size_t i = 0; i < m_Config.wheels.size(); ++i)
+            if (m_Config.wheels[i].axle == axle) m_Wheels[i].driveTorque = each;
+    }
+}
+
+void RaycastVehicle::Step(f32 dt, RigidBody* chassis, const VehicleInput& input,
+                          const PhysicsWorld* physics) {
+    if (dt <= 0.0f || !chassis || !chassis->GetOwner()) return;
+    if (chassis->bodyType != RigidBodyType::Dynamic) return;
+    if (m_Config.wheels.size() > kMaxWheels) m_Config.wheels.resize(kMaxWheels);   // edited via GetConfig()
+    if (m_Wheels.size() != m_Config.wheels.size())
+        m_Wheels.assign(m_Config.wheels.size(), VehicleWheelState{});
+
+    Transform& xf = chassis->GetOwner()->GetTransform();
+    const Quaternion q   = xf.rotation;
+    const Vec3       pos = xf.position;
+    const Vec3 up    = q.RotateVec3(Vec3::Up());
+    const Vec3 fwd   = q.RotateVec3(Vec3(0, 0, 1));
+    const f32  mass  = chassis->mass > 0.0f ? chassis->mass : 1.0f;
+    const auto& tire = m_Config.tire;
+    const size_t n   = m_Wheels.size();
+
+    m_ForwardSpeed = chassis->velocity.Dot(fwd);
+
+    // ── Steering rack ──────────────────────────────────────────────────
+    constexpr f32 deg2rad = kPi / 180.0f;
+    f32 lock   = m_Config.maxSteerAngle * deg2rad /
+                 (1.0f + std::fabs(m_ForwardSpeed) * m_Config.steerSpeedFactor);
+    f32 target = Clampf(input.steer, -1.0f, 1.0f) * lock;
+    f32 rate   = m_Config.steerSpeed * deg2rad * dt;
+    for (size_t i = 0; i < n; ++i) {
+        if (!m_Config.wheels[i].steerable) continue;
+        f32& a = m_Wheels[i].steerAngle;
+        a += Clampf(target - a, -rate, rate);
+    }
+
+    UpdateGearbox(dt, input);
+
+    // ── Suspension rays ────────────────────────────────────────────────
+    auto& surfaceGrip = m_SurfaceGrip;
+    surfaceGrip.fill(1.0f);
+    i32 groundedCount = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const auto& wc = m_Config.wheels[i];
+        auto& ws = m_Wheels[i];
+        Vec3 origin  = pos + q.RotateVec3(wc.hardpoint);
+        f32  maxDist = wc.restLength + wc.radius;
+
+        VehicleRayHit hit;
+        ws.prevCompression = ws.compression;
+        ws.grounded = CastWheel(origin, -up, maxDist, hit, chassis, physics);
+        if (!ws.grounded) {
+            ws.compression = 0.0f;
+            ws.suspensionForce = 0.0f;
+            continue;
+        }
+        ++groundedCount;
+        surfaceGrip[i] = hit.friction;
+        ws.contactPoint  = hit.point;
+        ws.contactNormal = hit.normal;
+
+        f32 rawCompression = maxDist - hit.distance;
+        ws.compression = Clampf(rawCompression, 0.0f, wc.restLength);
+        f32 compVel = (ws.compression - ws.prevCompression) / dt;
+        f32 damper  = compVel > 0.0f ? wc.damperCompression : wc.damperRebound;
+        f32 force   = wc.springStiffness * ws.compression + damper * compVel;
+        if (rawCompression > wc.restLength)   // bump stop
+            force += wc.springStiffness * 10.0f * (rawCompression - wc.restLength);
+        ws.suspensionForce = std::max(0.0f, force);
+    }
+
+    // ── Anti-roll bars ─────────────────────────────────────────────────
+    for (i32 axle = 0; axle < 2; ++axle) {
+        i32 left = -1, right = -1;
+        for (size_t i = 0; i < n; ++i) {
+            if (m_Config.wheels[i].axle != axle) continue;
+            if (m_Config.wheels[i].hardpoint.x < 0.0f) { if (left  < 0) left  = static_cast<i32>(i); }
+            else                                        { if (right < 0) right = static_cast<i32>(i); }
+        }
+        if (left < 0 || right < 0) continue;
+        f32 k = (axle == 0) ? m_Config.antiRollFront : m_Config.antiRollRear;
+        f32 f = (m_Wheels[left].compression - m_Wheels[right].compression) * k;
+        if (m_Wheels[left].grounded)
+            m_Wheels[left].suspensionForce  = std::max(0.0f, m_Wheels[left].suspensionForce + f);
+        if (m_Wheels[right].grounded)
+            m_Wheels[right].suspensionForce = std::max(0.0f, m_Wheels[right].suspensionForce - f);
+    }
+
+    // ── Engine → gearbox → differential ────────────────────────────────
+    const f32 ratio      = GearRatio();
+    const f32 frontShare = m_Config.differential.frontTorqueShare;
+    auto isDriven = [frontShare](i32 axle) {
+        return (axle == 0 && frontShare > 0.0f) || (axle == 1 && frontShare < 1.0f);
+    };
+    f32 drivenOmega = 0.0f;
+    i32 drivenCount = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (!isDriven(m_Config.wheels[i].axle)) continue;
+        drivenOmega += m_Wheels[i].angularVelocity;
+        ++drivenCount;
+    }
+    if (drivenCount > 0) drivenOmega /= static_cast<f32>(drivenCount);
+    m_EngineRPM = std::max(m_Config.engine.idleRPM, std::fabs(drivenOmega * ratio) * kRadToRPM);
+
+    f32 throttle = Clampf(input.throttle, 0.0f, 1.0f);
+    f32 engineTorque = 0.0f;
+    if (!IsShifting() && m_EngineRPM < m_Config.engine.redlineRPM)
+        engineTorque = m_Config.engine.SampleTorque(m_EngineRPM) * throttle;
+    DistributeDriveTorque(engineTorque * ratio * m_Config.gearbox.efficiency);
+
+    f32 engineBrake = 0.0f;
+    if (throttle < 0.05f && !IsShifting() && drivenCount > 0)
+        engineBrake = m_Config.engine.engineBrakeTorque * std::fabs(ratio) / static_cast<f32>(drivenCount);
+
+    // ── Tyres & wheel spin (implicit sub-steps per wheel) ──────────────
+    auto& frames = m_Frames;
+    frames.fill(ContactFrame{});
+    const f32 massShare = mass / static_cast<f32>(std::max(groundedCount, 1));
+
+    auto longForce = [&](size_t i, f32 omega) -> f32 {
+        const auto& cf = frames[i];
+        f32 denom = std::max(std::fabs(cf.vLong), tire.lowSpeedThreshold);
+        f32 slip  = (omega * m_Config.wheels[i].radius - cf.vLong) / denom;
+        return cf.mu * cf.load * VehicleTireModel::MagicFormula(slip, tire.longB, tire.longC, tire.longE);
+    };
+
+    for (size_t i = 0; i < n; ++i) {
+        auto& ws = m_Wheels[i];
+        auto& cf = frames[i];
+        if (!ws.grounded) continue;
+        Vec3 wheelFwd = Quaternion::FromAxisAngle(up, ws.steerAngle).RotateVec3(fwd);
+        const Vec3& gn = ws.contactNormal;
+        cf.lf = (wheelFwd - gn * wheelFwd.Dot(gn)).Normalized();
+        cf.lr = gn.Cross(cf.lf);
+        Vec3 vp = chassis->velocity + chassis->angularVelocity.Cross(ws.contactPoint - pos);
+        cf.vLong = vp.Dot(cf.lf);
+        cf.vLat  = vp.Dot(cf.lr);
+        cf.mu    = tire.peakFriction * surfaceGrip[i];
+        cf.load  = ws.suspensionForce;
+    }
+
+    const f32 h = dt / static_cast<f32>(kWheelSubSteps);
+    for (i32 s = 0; s < kWheelSubSteps; ++s) {
+        for (size_t i = 0; i < n; ++i) {
+            const auto& wc = m_Config.wheels[i];
+            auto& ws = m_Wheels[i];
+            f32 omega = ws.angularVelocity;
+            f32 inertia = std::max(wc.inertia, 1e-3f);
+
+            // Drive and tyre reaction, linearised so stiff tyres stay stable.
+            // Past the tyre's peak the tangent flattens out, so the secant
+            // back to free rolling bounds it; otherwise a slow wheel jumps
+            // from one side of the peak to the other every sub-step.
+            f32 fx = 0.0f, k = 0.0f;
+            if (ws.grounded) {
+                fx = longForce(i, omega);
+                k  = std::max(0.0f, (longForce(i, omega + 0.01f) - fx) / 0.01f);
+                f32 slipOmega = omega - frames[i].vLong / wc.radius;
+                if (std::fabs(slipOmega) > 1e-4f) k = std::max(k, fx / slipOmega);
+            }
+            f32 netTorque = ws.driveTorque - fx * wc.radius;
+            omega += h * netTorque / (inertia + h * wc.radius * k);
+
+            // Brakes, handbrake, engine braking and rolling resistance only oppose spin.
+            f32 brakeTorque = Clampf(input.brake, 0.0f, 1.0f) * wc.maxBrakeTorque;
+            if (input.handbrake && wc.handbrake) brakeTorque += wc.maxBrakeTorque * 1.5f;
+            if (engineBrake > 0.0f && isDriven(wc.axle)) brakeTorque += engineBrake;
+            if (ws.grounded) brakeTorque += tire.rollingResistance * frames[i].load * wc.radius;
+            f32 brakeDelta = brakeTorque * h / inertia;
+            if (std::fabs(omega) <= brakeDelta) omega = 0.0f;
+            else                                omega -= Signf(omega) * brakeDelta;
+
+            ws.angularVelocity = omega;
+        }
+
+        if (m_Config.differential.type == DifferentialType::Locked) {
+            for (i32 axle = 0; axle < 2; ++axle) {
+                f32 sum = 0.0f; i32 cnt = 0;
+                for (size_t i = 0; i < n; ++i)
+                    if (m_Config.wheels[i].axle == axle) { sum += m_Wheels[i].angularVelocity; ++cnt; }
+                if (cnt < 2) continue;
+                for (size_t i = 0; i < n; ++i)
+                    if (m_Config.wheels[i].axle == axle) m_Wheels[i].angularVelocity = sum / static_cast<f32>(cnt);
+            }
+        }
+    }
+
+    // ── Chassis forces ─────────────────────────────────────────────────
+    // Locked wheels hold the chassis against the gravity the world adds
+    // after this step, not just against the slip they see now.
+    const Vec3 gravityStep = (physics && chassis->useGravity) ? physics->gravity * dt : Vec3(0, 0, 0);
+    i32 lockedCount = 0;
+    for (size_t i = 0; i < n; ++i)
+        if (m_Wheels[i].grounded && m_Wheels[i].angularVelocity == 0.0f) ++lockedCount;
+
+    Vec3 totalForce(0, 0, 0), totalTorque(0, 0, 0);
+    for (size_t i = 0; i < n; ++i) {
+        const auto& wc = m_Config.wheels[i];
+        auto& ws = m_Wheels[i];
+        ws.spinAngle = std::fmod(ws.spinAngle + ws.angularVelocity * dt, kTwoPi);
+        if (!ws.grounded) {
+            ws.longForce = ws.latForce = ws.slipRatio = ws.slipAngle = 0.0f;
+            continue;
+        }
+        const auto& cf = frames[i];
+        f32 surfaceSpeed = ws.angularVelocity * wc.radius;
+        f32 denom = std::max(std::fabs(cf.vLong), tire.lowSpeedThreshold);
+        ws.slipRatio = (surfaceSpeed - cf.vLong) / denom;
+        ws.slipAngle = std::atan2(cf.vLat, denom);
+
+        f32 fx = longForce(i, ws.angularVelocity);
+        f32 fy = -cf.mu * cf.load * VehicleTireModel::MagicFormula(ws.slipAngle, tire.latB, tire.latC, tire.latE);
+
+        // A locked wheel grips like static friction: it takes out its share
+        // of the along-tyre velocity the chassis would have after this step,
+        // up to the sliding grip.  The sideways direction has no implicit
+        // solve, so it never pushes harder than needed to cancel
+        // that slip in one step.
+        if (ws.angularVelocity == 0.0f) {
+            f32 vNext   = cf.vLong + gravityStep.Dot(cf.lf);
+            f32 sliding = cf.mu * cf.load *
+                          std::fabs(VehicleTireModel::MagicFormula(1.0f, tire.longB, tire.longC, tire.longE));
+            fx = Clampf(-mass / static_cast<f32>(lockedCount) * vNext / dt, -sliding, sliding);
+        }
+        f32 maxFy = massShare * std::fabs(cf.vLat) / dt;
+        fy = Clampf(fy, -maxFy, maxFy);
+
+        // Friction circle for combined slip.
+        f32 limit = cf.mu * cf.load;
+        f32 mag   = std::sqrt(fx * fx + fy * fy);
+        if (mag > limit && mag > 1e-6f) { f32 s = limit / mag; fx *= s; fy *= s; }
+        ws.longForce = fx;
+        ws.latForce  = fy;
+
+        Vec3 f = up * ws.suspensionForce + cf.lf * fx + cf.lr * fy;
+        totalForce  += f;
+        totalTorque += (ws.contactPoint - pos).Cross(f);
+    }
+
+    f32 speed = chassis->velocity.Length();
+    totalForce -= chassis->velocity * (m_Config.aeroDrag * speed);
+
+    // Linear: Δv = F/m·dt (gravity is applied by the PhysicsWorld step).
+    chassis->velocity += totalForce * (dt / mass);
+
+    // Angular: resolve the torque in chassis space where the inertia is diagonal.
+    Vec3 invInertia;
+    if (auto* col = chassis->GetOwner()->GetComponent<Collider>()) {
+        invInertia = chassis->GetInverseInertiaTensor(col, xf.scale);
+    } else {
+        f32 w = 0.0f, l = 0.0f;
+        for (const auto& wc : m_Config.wheels) {
+            w = std::max(w, std::fabs(wc.hardpoint.x) * 2.0f);
+            l = std::max(l, std::fabs(wc.hardpoint.z) * 2.0f);
+        }
+        f32 hgt = 0.6f, f = mass / 12.0f;
+        invInertia = Vec3(1.0f / std::max(f * (hgt * hgt + l * l), 1e-3f),
+                          1.0f / std::max(f * (w * w + l * l),     1e-3f),
+                          1.0f / std::max(f * (w * w + hgt * hgt), 1e-3f));
+    }
+    Vec3 localTorque = Conjugate(q).RotateVec3(totalTorque);
+    Vec3 localAccel(localTorque.x * invInertia.x,
+                    localTorque.y * invInertia.y,
+                    localTorque.z * invInertia.z);
+    chassis->angularVelocity += q.RotateVec3(localAccel) * dt;
+
+    m_ForwardSpeed = chassis->velocity.Dot(fwd);
+}
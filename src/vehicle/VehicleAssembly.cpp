@@ -4,6 +4,7 @@
 #include "core/GameObject.h"
 #include "physics/Physics.h"
 #include "renderer/MeshRenderer.h"
+#include <algorithm>
 #include <cmath>
 
 using namespace gv;
@@ -65,10 +66,17 @@ GameObject* VehicleAssembler::Spawn(Scene* scene, const VehicleBlueprint& bluepr
     if (!scene) return nullptr;
 
     GameObject* root = nullptr;
+    std::vector<GameObject*> wheels;
+
+    // Lift the spawn so the lowest wheel rests on the ground instead of
+    // starting inside the bump stops.
+    Vec3 rootPos = blueprint.rootPosition;
+    for (const auto& part : blueprint.parts)
+        if (part.isWheel) rootPos.y = std::max(rootPos.y, part.wheelRadius - part.offset.y);
 
     for (const auto& part : blueprint.parts) {
         auto* obj = scene->CreateGameObject(part.name);
-        Vec3 worldPos = blueprint.rootPosition + part.offset;
+        Vec3 worldPos = rootPos + part.offset;
         obj->GetTransform().SetPosition(worldPos.x, worldPos.y, worldPos.z);
         obj->GetTransform().SetEulerDeg(part.rotationDeg.x, part.rotationDeg.y, part.rotationDeg.z);
         obj->GetTransform().SetScale(part.scale.x, part.scale.y, part.scale.z);
@@ -84,19 +92,62 @@ GameObject* VehicleAssembler::Spawn(Scene* scene, const VehicleBlueprint& bluepr
             rb->drag          = 0.2f;
             auto* col = obj->AddComponent<Collider>();
             col->type = ColliderType::Box;
-            col->boxHalfExtents = Vec3(part.scale.x * 0.5f, part.scale.y * 0.5f, part.scale.z * 0.5f);
+            col->boxHalfExtents = Vec3(0.5f, 0.5f, 0.5f);   // unit cube, scaled by the transform
             if (physics) physics->RegisterBody(rb);
             obj->AddComponent<CarController3D>();
             root = obj;
+        } else if (part.isWheel) {
+            wheels.push_back(obj);
         }
     }
+
+    if (root) AttachWheels(scene, root, blueprint, wheels);
     return root;
 }
 
-void VehicleAssembler::AttachWheels(GameObject* /*carRoot*/, const VehicleBlueprint& /*bp*/) {
-    // Wheel parenting stubbed until hierarchy system is implemented
+void VehicleAssembler::AttachWheels(Scene* scene, GameObject* carRoot, const VehicleBlueprint& bp,
+                                    const std::vector<GameObject*>& wheelObjects) {
+    if (!carRoot) return;
+    auto* ctrl = carRoot->GetComponent<CarController3D>();
+    if (!ctrl) return;
+
+    VehicleConfig cfg = ctrl->GetVehicle().GetConfig();
+    cfg.wheels.clear();
+    ctrl->ClearWheelVisuals();
+
+    size_t wheelCount = 0;
+    for (const auto& part : bp.parts) if (part.isWheel) ++wheelCount;
+    if (wheelCount == 0) return;
+
+    // Place hardpoints so each wheel sits at its authored offset when the
+    // suspension carries its static share of the chassis weight.
+    constexpr f32 deg2rad = 3.14159265358979f / 180.0f;
+    size_t visual = 0;
+    for (const auto& part : bp.parts) {
+        if (!part.isWheel) continue;
+        VehicleWheelConfig w;
+        w.name   = part.name;
+        w.radius = part.wheelRadius > 0.0f ? part.wheelRadius : 0.35f;
+        w.axle   = (part.offset.z >= 0.0f) ? 0 : 1;
+        w.steerable = (w.axle == 0);
+        w.handbrake = (w.axle == 1);
+        f32 staticSag = ctrl->chassisMass * 9.81f / (static_cast<f32>(wheelCount) * w.springStiffness);
+        w.hardpoint = part.offset + Vec3(0, std::max(w.restLength - staticSag, 0.0f), 0);
+
+        size_t index = cfg.wheels.size();
+        cfg.wheels.push_back(w);
+        if (visual < wheelObjects.size()) {
+            Quaternion base = Quaternion::FromEuler(part.rotationDeg * deg2rad);
+            ctrl->BindWheelVisual(index, wheelObjects[visual], base);
+        }
+        ++visual;
+    }
+    ctrl->GetVehicle().SetConfig(cfg);
+    if (scene) ctrl->SyncWheelVisuals(*scene);
 }
 
-void VehicleAssembler::UpdateWheelSpin(GameObject* /*carRoot*/, float /*speed*/, float /*dt*/) {
-    // Wheel visual spin stubbed; implement per-frame transform rotation
+void VehicleAssembler::UpdateWheelSpin(Scene* scene, GameObject* carRoot) {
+    if (!scene || !carRoot) return;
+    if (auto* ctrl = carRoot->GetComponent<CarController3D>())
+        ctrl->SyncWheelVisuals(*scene);
 }
@@ -0,0 +1,116 @@
+// ============================================================================
+// GameVoid Engine — Animation State Machine Tests
+// ============================================================================
+#include "TestHarness.h"
+#include "animation/AnimStateMachine.h"
+#include <string>
+#include <vector>
+
+using namespace gv;
+
+namespace {
+
+/// The locomotion graph from the top of AnimStateMachine.h.
+Shared<const AnimGraph> Locomotion() {
+    AnimGraphDesc desc;
+    desc.AddParameter("speed", AnimParamType::Float);
+    desc.AddParameter("jump", AnimParamType::Trigger);
+    desc.AddState("Idle", 1.0f);
+    desc.AddState("Run", 0.6f);
+    desc.AddState("Jump", 0.5f, false).events.push_back({ 0.0f, "jump_sfx" });
+    desc.AddTransition("Idle", "Run", 0.1f).When("speed", AnimCondition::Greater, 0.1f);
+    desc.AddTransition("Run", "Idle", 0.1f).When("speed", AnimCondition::Less, 0.1f);
+    desc.AddAnyTransition("Jump").When("jump", AnimCondition::If);
+    desc.AddTransition("Jump", "Idle", 0.2f).AfterExitTime(1.0f);
+    std::string error;
+    Shared<const AnimGraph> graph = AnimGraph::Compile(desc, error);
+    GV_CHECK(graph != nullptr && error.empty());
+    return graph;
+}
+
+void Step(AnimStateMachine& m, f32 seconds, f32 dt = 1.0f / 60.0f) {
+    for (f32 t = 0; t < seconds - 1e-6f; t += dt) m.Update(dt);
+}
+
+} // namespace
+
+GV_TEST(ParametersDriveTransitions) {
+    Shared<const AnimGraph> graph = Locomotion();
+    const u32 idle = graph->FindState("Idle"), run = graph->FindState("Run"), jump = graph->FindState("Jump");
+    AnimStateMachine m(graph);
+    GV_CHECK(m.GetState() == idle);
+
+    m.SetFloat("speed", 1.0f);
+    m.Update(1.0f / 60.0f);
+    GV_CHECK(m.IsInTransition() && m.GetNextState() == run);
+    Step(m, 0.2f);
+    GV_CHECK(m.GetState() == run && !m.IsInTransition());
+    GV_CHECK_NEAR(m.GetBlendWeight(), 0.0, 0.0);
+
+    // The trigger fires the any-state jump once, then is consumed.
+    m.SetTrigger("jump");
+    m.Update(1.0f / 60.0f);
+    GV_CHECK(m.GetState() == jump);
+    GV_CHECK(!m.GetBool("jump"));
+    // Events at the entry time fire on the state's first advance, once.
+    auto sfx = [&] {
+        u32 n = 0;
+        for (const auto& hit : m.GetEvents()) n += graph->GetEventName(hit.event) == "jump_sfx";
+        return n;
+    };
+    m.Update(1.0f / 60.0f);
+    GV_CHECK(sfx() == 1);
+    m.Update(1.0f / 60.0f);
+    GV_CHECK(sfx() == 0);
+
+    // The one-shot reaches its end at 0.5 s, then fades back to Idle.
+    m.SetFloat("speed", 0.0f);
+    Step(m, 0.4f);
+    GV_CHECK(m.GetState() == jump);
+    Step(m, 0.4f);
+    GV_CHECK(m.GetState() == idle);
+}
+
+GV_TEST(CompileRejectsBadGraphs) {
+    std::string error;
+    AnimGraphDesc unknown;
+    unknown.AddState("A");
+    unknown.AddTransition("A", "B").When("x", AnimCondition::If);
+    GV_CHECK(AnimGraph::Compile(unknown, error) == nullptr && !error.empty());
+
+    AnimGraphDesc mistyped;
+    mistyped.AddParameter("speed", AnimParamType::Float);
+    mistyped.AddState("A");
+    mistyped.AddState("B");
+    mistyped.AddTransition("A", "B").When("speed", AnimCondition::Equals, 1.0f);
+    GV_CHECK(AnimGraph::Compile(mistyped, error) == nullptr);
+
+    AnimGraphDesc unconditional;
+    unconditional.AddState("A");
+    unconditional.AddState("B");
+    unconditional.AddTransition("A", "B");
+    GV_CHECK(AnimGraph::Compile(unconditional, error) == nullptr);
+}
+
+GV_TEST(BatchUpdatesMatchSerialUpdates) {
+    Shared<const AnimGraph> graph = Locomotion();
+    std::vector<AnimStateMachine> serial(256, AnimStateMachine(graph)), batched(256, AnimStateMachine(graph));
+    for (size_t i = 0; i < serial.size(); ++i) {
+        const f32 speed = (i % 3) ? 1.0f : 0.0f;
+        serial[i].SetFloat("speed", speed);
+        batched[i].SetFloat("speed", speed);
+        if (i % 5 == 0) { serial[i].SetTrigger("jump"); batched[i].SetTrigger("jump"); }
+    }
+    for (int frame = 0; frame < 90; ++frame) {
+        for (auto& m : serial) m.Update(1.0f / 60.0f);
+        AnimStateMachine::UpdateBatch(batched.data(), batched.size(), 1.0f / 60.0f, 4);
+    }
+    bool same = true;
+    for (size_t i = 0; i < serial.size(); ++i)
+        same &= serial[i].GetState() == batched[i].GetState() &&
+                serial[i].GetNormalizedTime() == batched[i].GetNormalizedTime() &&
+                serial[i].GetNextState() == batched[i].GetNextState();
+    GV_CHECK(same);
+}
+
+GV_TEST_MAIN()
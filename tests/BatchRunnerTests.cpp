@@ -0,0 +1,192 @@
+// ============================================================================
+// GameVoid Engine — BatchRunner Tests
+// ============================================================================
+// A saved scene with one falling ball is run in-process, through Main's
+// summary, and in GameVoidBatch worker processes (GV_BATCH_EXE).
+// ============================================================================
+#include "TestHarness.h"
+#include "core/Scene.h"
+#include "core/SceneSerializer.h"
+#include "editor/BatchRunner.h"
+#include "physics/Physics.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace gv;
+namespace fs = std::filesystem;
+
+namespace {
+
+/// Temp directory holding ball.gvs: "Ball" dropped from y = 10.
+struct BallScene {
+    fs::path dir = fs::temp_directory_path() / "gv_batch_tests";
+    std::string path = (dir / "ball.gvs").generic_string();
+
+    BallScene() {
+        std::error_code ec;
+        fs::remove_all(dir, ec);
+        fs::create_directories(dir);
+        Scene scene("ball");
+        GameObject* ball = scene.CreateGameObject("Ball");
+        ball->GetTransform().position = Vec3(0, 10, 0);
+        PhysicsWorld::AddPhysicsComponents(ball, RigidBodyType::Dynamic, ColliderType::Sphere);
+        SceneSerializer::SaveScene(scene, path);
+    }
+    ~BallScene() { std::error_code ec; fs::remove_all(dir, ec); }
+
+    std::string File(const char* name) const { return (dir / name).generic_string(); }
+
+    BatchJob Job(std::initializer_list<const char*> invariants, u32 frames = 60) const {
+        BatchJob job;
+        job.scenePath = path;
+        job.frames = frames;
+        for (const char* text : invariants) {
+            BatchInvariant inv;
+            BatchInvariant::Parse(text, inv);
+            job.invariants.push_back(inv);
+        }
+        return job;
+    }
+};
+
+std::string ReadFile(const std::string& path) {
+    std::ifstream in(path);
+    std::stringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+bool Contains(const std::string& text, const std::string& part) { return text.find(part) != std::string::npos; }
+
+/// BatchRunner::Main with its standard output captured.
+i32 RunMain(std::vector<std::string> args, std::string& out) {
+    std::vector<char*> argv;
+    for (std::string& a : args) argv.push_back(a.data());
+    std::ostringstream captured;
+    std::streambuf* old = std::cout.rdbuf(captured.rdbuf());
+    i32 code = BatchRunner::Main(static_cast<int>(argv.size()), argv.data());
+    std::cout.rdbuf(old);
+    out = captured.str();
+    return code;
+}
+
+/// The value following `flag` in a worker command line.
+std::string ArgAfter(const std::string& cmd, const std::string& flag) {
+    size_t at = cmd.find(flag + " ");
+    if (at == std::string::npos) return {};
+    at += flag.size() + 1;
+    return cmd.substr(at, cmd.find(' ', at) - at);
+}
+
+} // namespace
+
+GV_TEST(WorkerCommandRoundTripsDtExactly) {
+    const f32 steps[] = { 1.0f / 60.0f, 1.0f / 120.0f, 1.0f / 144.0f, 0.1f, 1.0f / 3.0f, 7.0e-5f };
+    for (f32 dt : steps) {
+        BatchJob job;
+        job.scenePath = "scene.gvs";
+        job.dt = dt;
+        std::string cmd = BatchRunner::BuildWorkerCommand(job, "GameVoid", "scene-0.log");
+        std::string text = ArgAfter(cmd, "--dt");
+        GV_CHECK(!text.empty());
+        if (text.empty()) continue;
+        GV_CHECK(std::stof(text) == dt);        // bit-exact, not merely close
+    }
+}
+
+GV_TEST(WorkerCommandRedirectsToTheGivenLog) {
+    BatchJob job;
+    job.scenePath = "levels/a/intro.gvs";
+    std::string cmd = BatchRunner::BuildWorkerCommand(job, "GameVoid", "out/intro-3.log");
+    GV_CHECK(cmd.find("intro-3.log") != std::string::npos);
+    GV_CHECK(cmd.find("levels/a/intro.gvs") != std::string::npos);
+}
+
+GV_TEST(PassingInvariantsRunEveryFrame) {
+    BallScene scene;
+    BatchJob job = scene.Job({ "Ball.y > -5", "*.speed < 50" }, 90);
+    job.tracePath = scene.File("ball.csv");
+    job.traceFormat = BatchTraceFormat::CSV;
+    const BatchResult r = BatchRunner::RunJob(job);
+    GV_CHECK(r.passed && r.exitCode == 0);
+    GV_CHECK(r.framesRun == 90);
+    GV_CHECK(r.failures.empty());
+    GV_CHECK(r.scenePath == scene.path);
+
+    // The ball really moved, and every frame is in the trace.
+    const std::string trace = ReadFile(job.tracePath);
+    GV_CHECK(Contains(trace, "Ball"));
+    u32 lines = 0;
+    for (char c : trace) lines += c == '\n' ? 1u : 0u;
+    GV_CHECK(lines > 90);
+}
+
+GV_TEST(FailingInvariantStopsAtTheFirstViolation) {
+    BallScene scene;
+    // Free fall passes y = 9 after sqrt(2 / 9.81) s, on frame 27 at 60 Hz.
+    const BatchResult r = BatchRunner::RunJob(scene.Job({ "Ball.y > -5", "Ball.y > 9" }));
+    GV_CHECK(!r.passed && r.exitCode == 1);
+    GV_CHECK(r.framesRun >= 26 && r.framesRun <= 29);
+    GV_CHECK(r.failures.size() == 1);
+    if (!r.failures.empty())
+        GV_CHECK(r.failures[0] == "frame " + std::to_string(r.framesRun - 1) + ": Ball.y > 9");
+
+    const BatchResult ghost = BatchRunner::RunJob(scene.Job({ "Ghost.y > 0" }));
+    GV_CHECK(ghost.exitCode == 1 && ghost.framesRun == 1);
+    GV_CHECK(!ghost.failures.empty() && Contains(ghost.failures[0], "(object 'Ghost' not found)"));
+
+    // A scene that does not load never runs a frame.
+    BatchJob missing = scene.Job({});
+    missing.scenePath = scene.File("missing.gvs");
+    const BatchResult m = BatchRunner::RunJob(missing);
+    GV_CHECK(m.exitCode == 2 && m.framesRun == 0);
+}
+
+GV_TEST(WorkerExitCodesReachTheParent) {
+    BallScene scene;
+    BatchJob pass = scene.Job({ "Ball.y > -5" });
+    pass.logPath = scene.File("pass.log");
+    BatchJob fail = scene.Job({ "Ball.y > 9" });
+    fail.logPath = scene.File("fail.log");
+    BatchJob missing = scene.Job({});
+    missing.scenePath = scene.File("missing.gvs");
+    missing.logPath = scene.File("missing.log");
+
+    GV_CHECK(BatchRunner::RunParallel({ pass }, 1, GV_BATCH_EXE) == 0);
+    GV_CHECK(BatchRunner::RunParallel({ pass, fail }, 2, GV_BATCH_EXE) == 1);
+    GV_CHECK(BatchRunner::RunParallel({ pass, fail, missing }, 2, GV_BATCH_EXE) == 2);
+
+    // Each worker wrote its own report to its log.
+    GV_CHECK(Contains(ReadFile(pass.logPath), "[PASS] " + scene.path));
+    GV_CHECK(Contains(ReadFile(fail.logPath), "[FAIL] " + scene.path));
+    GV_CHECK(Contains(ReadFile(fail.logPath), ": Ball.y > 9"));
+}
+
+GV_TEST(MainPrintsASummary) {
+    BallScene scene;
+    std::string out;
+    GV_CHECK(RunMain({ "GameVoidBatch", "--frames", "30", "--assert", "Ball.y > -5", scene.path }, out) == 0);
+    GV_CHECK(Contains(out, "[PASS] " + scene.path + "  (30/30 frames, "));
+
+    GV_CHECK(RunMain({ "GameVoidBatch", "--jobs", "1", "--assert", "Ball.y > 9", scene.path, scene.path }, out) == 1);
+    GV_CHECK(Contains(out, "[FAIL] " + scene.path + "  ("));
+    GV_CHECK(Contains(out, "\n    frame "));                 // the failure, indented under it
+
+    // Several scenes across workers: one line each, then the verdict.  The
+    // trace dir keeps the worker logs out of the working directory.
+    const std::string dir = scene.dir.generic_string();
+    GV_CHECK(RunMain({ GV_BATCH_EXE, "--jobs", "2", "--frames", "30", "--trace-dir", dir, scene.path, scene.path }, out) == 0);
+    GV_CHECK(Contains(out, "Batch finished: all scenes passed"));
+    GV_CHECK(RunMain({ GV_BATCH_EXE, "--jobs", "2", "--assert", "Ball.y > 9", "--trace-dir", dir, scene.path, scene.path }, out) == 1);
+    GV_CHECK(Contains(out, "Batch finished: FAILURES"));
+    GV_CHECK(Contains(out, "exit 1"));
+
+    GV_CHECK(RunMain({ "GameVoidBatch", "--assert", "Ball.q ~ 1", scene.path }, out) == 2);
+    GV_CHECK(RunMain({ "GameVoidBatch" }, out) == 2);
+}
+
+GV_TEST_MAIN()
@@ -0,0 +1,86 @@
+// ============================================================================
+// GameVoid Engine — BehaviorAnalyzer / RingBuffer Tests
+// ============================================================================
+#include "TestHarness.h"
+#include "core/GameObject.h"
+#include "core/RingBuffer.h"
+#include "editor2d/Editor2DTypes.h"
+#include "physics/Physics.h"
+#include "scripting/physics/BehaviorAnalyzer.h"
+
+using namespace gv;
+
+// ── RingBuffer ──────────────────────────────────────────────────────────────
+
+GV_TEST(RingBufferViewIsOldestFirstOnceWrapped) {
+    RingBuffer<f32> ring(4);
+    for (int i = 1; i <= 6; ++i) ring.Push(f32(i));
+    GV_CHECK(ring.Full());
+    ArrayView<f32> view = ring.View();
+    GV_CHECK(view.size == 4);
+    for (size_t i = 0; i < view.size; ++i) GV_CHECK_NEAR(view[i], 3.0 + double(i), 0.0);
+    GV_CHECK_NEAR(ring.Oldest(), 3.0, 0.0);
+    GV_CHECK_NEAR(ring.Newest(), 6.0, 0.0);
+}
+
+GV_TEST(RingBufferPartialFillAndZeroCapacity) {
+    RingBuffer<f32> ring(8);
+    ring.Push(1.0f);
+    ring.Push(2.0f);
+    GV_CHECK(!ring.Full());
+    GV_CHECK(ring.Size() == 2);
+    GV_CHECK_NEAR(ring[0], 1.0, 0.0);
+
+    RingBuffer<f32> none;
+    none.Push(1.0f);
+    GV_CHECK(none.Empty());
+    GV_CHECK(!none.Full());
+}
+
+// ── BehaviorAnalyzer ────────────────────────────────────────────────────────
+
+GV_TEST(AnalyzerFollowsBodyAddedAndRemovedAfterAttach) {
+    GameObject obj("probe");
+    auto* analyzer = obj.AddComponent<BehaviorAnalyzer>();
+
+    analyzer->Update(1.0f / 60.0f);                  // no body yet
+    GV_CHECK_NEAR(analyzer->GetVelocityMagnitude(), 0.0, 0.0);
+
+    auto* rb = obj.AddComponent<RigidBody>();
+    rb->velocity = Vec3(3, 4, 0);
+    analyzer->Update(1.0f / 60.0f);
+    GV_CHECK_NEAR(analyzer->GetVelocityMagnitude(), 5.0, 1e-5);
+
+    GV_CHECK(obj.RemoveComponent<RigidBody>());      // the old pointer is now dangling
+    auto* rb2d = obj.AddComponent<RigidBody2D>();
+    rb2d->velocity = Vec2(0, 2);
+    analyzer->Update(1.0f / 60.0f);
+    GV_CHECK_NEAR(analyzer->GetVelocityMagnitude(), 2.0, 1e-5);
+}
+
+GV_TEST(PercentileTracksTheCurrentWindow) {
+    GameObject obj("probe");
+    auto* analyzer = obj.AddComponent<BehaviorAnalyzer>();
+    analyzer->historyBufferSize = 10;
+    auto* rb = obj.AddComponent<RigidBody>();
+
+    for (int i = 1; i <= 10; ++i) {                 // speeds 1..10
+        rb->velocity = Vec3(f32(i), 0, 0);
+        analyzer->Update(1.0f / 60.0f);
+    }
+    GV_CHECK_NEAR(analyzer->GetPercentile(BehaviorChannel::Velocity, 50), 5.0, 1e-5);
+    GV_CHECK_NEAR(analyzer->GetPercentile(BehaviorChannel::Velocity, 100), 10.0, 1e-5);
+    GV_CHECK_NEAR(analyzer->GetPercentile(BehaviorChannel::Velocity, 0), 1.0, 1e-5);
+    // Cached sort is reused for repeated queries in the same frame.
+    GV_CHECK_NEAR(analyzer->GetPercentile(BehaviorChannel::Velocity, 90), 9.0, 1e-5);
+
+    for (int i = 0; i < 5; ++i) {                   // window becomes 6..10, 20 x5
+        rb->velocity = Vec3(20, 0, 0);
+        analyzer->Update(1.0f / 60.0f);
+    }
+    GV_CHECK_NEAR(analyzer->GetPercentile(BehaviorChannel::Velocity, 0), 6.0, 1e-5);
+    GV_CHECK_NEAR(analyzer->GetPercentile(BehaviorChannel::Velocity, 100), 20.0, 1e-5);
+    GV_CHECK_NEAR(analyzer->GetPercentile(BehaviorChannel::Velocity, 50), 10.0, 1e-5);
+}
+
+GV_TEST_MAIN()
@@ -0,0 +1,220 @@
+// ============================================================================
+// GameVoid Engine — Behavior Tree Tests
+// ============================================================================
+#include "TestHarness.h"
+#include "ai/BehaviorTree.h"
+#include <string>
+#include <vector>
+
+using namespace gv;
+
+namespace {
+
+/// The guard tree from the top of BehaviorTree.h.
+const char* kGuard = R"({
+  "name": "guard",
+  "blackboard": { "health": { "type": "float", "default": 100 },
+                  "target": "object", "alert": "bool" },
+  "root": { "type": "selector", "children": [
+    { "type": "check", "key": "health", "op": "<", "value": 30, "abort": "lower",
+      "child": { "type": "action", "name": "flee" } },
+    { "type": "utility", "children": [
+      { "type": "action", "name": "attack",
+        "utility": [ { "key": "alert", "curve": "linear" } ] },
+      { "type": "action", "name": "patrol", "weight": 0.3 } ] } ] }
+})";
+
+/// Counts what each native leaf was asked to do.  Every action keeps
+/// running, so the tree only moves on when something aborts it.
+struct Leaves {
+    BTRegistry registry;
+    u32 flee = 0, attack = 0, patrol = 0, aborted = 0;
+
+    Leaves() {
+        auto running = [](u32& ticks) { return [&ticks](BTContext&) { ++ticks; return BTStatus::Running; }; };
+        auto onAbort = [this](BTContext&) { ++aborted; };
+        registry.RegisterAction("flee", running(flee), onAbort);
+        registry.RegisterAction("attack", running(attack), onAbort);
+        registry.RegisterAction("patrol", running(patrol), onAbort);
+        registry.RegisterAction("count", [](BTContext& ctx) {
+            ctx.agent.SetInt("steps", ctx.agent.GetInt("steps") + static_cast<i32>(ctx.GetArg("by", 1.0f)));
+            return BTStatus::Success;
+        });
+        registry.RegisterCondition("never", [](BTContext&) { return false; });
+    }
+};
+
+} // namespace
+
+GV_TEST(CompositesRunTheirChildrenInOrder) {
+    Leaves leaves;
+    BehaviorTreeDesc desc;
+    desc.AddKey("steps", BTValueType::Int);
+    desc.AddKey("done", BTValueType::Bool);
+    desc.root = BTNodeDesc::Selector({
+        BTNodeDesc::Sequence({ BTNodeDesc::Condition("never"), BTNodeDesc::Set("done", 1.0f) }),
+        BTNodeDesc::Sequence({
+            BTNodeDesc::Action("count", { { "by", 2.0f, {} } }),
+            BTNodeDesc::Decorate(BTNodeType::Inverter, BTNodeDesc::Action("count")),
+        }),
+        BTNodeDesc::Set("done", 1.0f),
+    });
+    std::string error;
+    Shared<const BehaviorTree> tree = BehaviorTree::Compile(desc, error, leaves.registry);
+    GV_CHECK(tree != nullptr && error.empty());
+    if (!tree) return;
+
+    BTAgent agent(tree);
+    agent.Tick();
+    // The first sequence fails at the condition; the second counts 2 + 1
+    // and fails through the inverter; the selector falls through to Set.
+    GV_CHECK(agent.GetLastStatus() == BTStatus::Success);
+    GV_CHECK(agent.GetInt("steps") == 3);
+    GV_CHECK(agent.GetBool("done"));
+
+    agent.Reset();
+    GV_CHECK(agent.GetInt("steps") == 0 && !agent.GetBool("done"));
+}
+
+GV_TEST(ChecksAbortLowerPriorityBranches) {
+    Leaves leaves;
+    std::string error;
+    Shared<const BehaviorTree> tree = BehaviorTree::LoadJson(kGuard, error, leaves.registry);
+    GV_CHECK(tree != nullptr && error.empty());
+    if (!tree) return;
+    GV_CHECK(tree->GetName() == "guard" && tree->GetKeyCount() == 3);
+    GV_CHECK(tree->FindKey("alert") != BehaviorTree::kNone && tree->FindKey("mood") == BehaviorTree::kNone);
+    GV_CHECK(!tree->NeedsMainThread());
+
+    BTAgent agent(tree);
+    GV_CHECK_NEAR(agent.GetFloat("health"), 100.0, 0.0);
+    agent.Update(0.1f);
+    // Not alert: attack scores 0, so the utility selector patrols.
+    GV_CHECK(leaves.patrol == 1 && leaves.attack == 0 && leaves.flee == 0);
+    GV_CHECK(agent.GetLastStatus() == BTStatus::Running);
+
+    // Becoming alert re-scores the running utility selector.
+    agent.SetBool("alert", true);
+    agent.Update(0.1f);
+    GV_CHECK(leaves.attack == 1 && leaves.aborted == 1);
+
+    // Low health re-tests the guarded check and aborts the attack.
+    agent.SetFloat("health", 10.0f);
+    agent.Update(0.1f);
+    GV_CHECK(leaves.flee == 1 && leaves.aborted == 2);
+    agent.Update(0.1f);
+    GV_CHECK(leaves.flee == 2 && leaves.attack == 1);
+}
+
+GV_TEST(UtilityPrefersTheBestScore) {
+    Leaves leaves;
+    BTConsideration threat;
+    threat.key = "threat";
+    threat.max = 10.0f;
+    BTConsideration calm = threat;
+    calm.invert = true;
+
+    BehaviorTreeDesc desc;
+    desc.AddKey("threat", BTValueType::Float, 2.0f);
+    desc.root = BTNodeDesc::Utility({
+        BTNodeDesc::Action("attack").Scored({ threat }),
+        BTNodeDesc::Action("patrol").Scored({ calm }),
+    }, 0.2f);
+    std::string error;
+    Shared<const BehaviorTree> tree = BehaviorTree::Compile(desc, error, leaves.registry);
+    GV_CHECK(tree != nullptr);
+    if (!tree) return;
+
+    BTAgent agent(tree);
+    agent.Update(0.1f);
+    GV_CHECK(leaves.patrol == 1 && leaves.attack == 0);
+
+    // 0.55 vs 0.45 is inside the hysteresis: keep patrolling.
+    agent.SetFloat("threat", 5.5f);
+    agent.Update(0.1f);
+    GV_CHECK(leaves.patrol == 2 && leaves.attack == 0);
+
+    agent.SetFloat("threat", 9.0f);
+    agent.Update(0.1f);
+    GV_CHECK(leaves.attack == 1 && leaves.aborted == 1);
+}
+
+GV_TEST(CompileRejectsBadTrees) {
+    Leaves leaves;
+    std::string error;
+    BehaviorTreeDesc unknownKey;
+    unknownKey.root = BTNodeDesc::Check("missing", BTCompare::Set);
+    GV_CHECK(BehaviorTree::Compile(unknownKey, error, leaves.registry) == nullptr && !error.empty());
+
+    BehaviorTreeDesc unknownAction;
+    unknownAction.root = BTNodeDesc::Action("dance");
+    GV_CHECK(BehaviorTree::Compile(unknownAction, error, leaves.registry) == nullptr);
+
+    // "lower" aborts only make sense under a selector.
+    BehaviorTreeDesc misplaced;
+    misplaced.AddKey("alert", BTValueType::Bool);
+    misplaced.root = BTNodeDesc::Sequence({
+        BTNodeDesc::Guard("alert", BTCompare::Set, 0.0f, BTAbort::LowerPriority, BTNodeDesc::Action("attack")),
+    });
+    GV_CHECK(BehaviorTree::Compile(misplaced, error, leaves.registry) == nullptr);
+
+    GV_CHECK(BehaviorTree::LoadJson("{ \"root\": ", error, leaves.registry) == nullptr);
+}
+
+GV_TEST(IdleAgentsSleepUntilWoken) {
+    Leaves leaves;
+    BehaviorTreeDesc desc;
+    desc.AddKey("alert", BTValueType::Bool);
+    desc.root = BTNodeDesc::Selector({
+        BTNodeDesc::Guard("alert", BTCompare::Set, 0.0f, BTAbort::LowerPriority, BTNodeDesc::Action("attack")),
+        BTNodeDesc::Wait(1.0f),
+    });
+    std::string error;
+    Shared<const BehaviorTree> tree = BehaviorTree::Compile(desc, error, leaves.registry);
+    GV_CHECK(tree != nullptr);
+    if (!tree) return;
+
+    BTAgent agent(tree);
+    agent.Update(0.1f);
+    GV_CHECK(agent.GetTickCount() == 1 && agent.IsSleeping());
+    for (int i = 0; i < 5; ++i) agent.Update(0.1f);
+    GV_CHECK(agent.GetTickCount() == 1);
+
+    // A blackboard change wakes it on the next update.
+    agent.SetBool("alert", true);
+    GV_CHECK(!agent.IsSleeping());
+    agent.Update(0.1f);
+    GV_CHECK(agent.GetTickCount() == 2 && leaves.attack == 1);
+}
+
+GV_TEST(BatchUpdatesMatchSerialUpdates) {
+    Leaves leaves;
+    std::string error;
+    BehaviorTreeDesc desc;
+    desc.AddKey("steps", BTValueType::Int);
+    desc.AddKey("health", BTValueType::Float, 100.0f);
+    desc.root = BTNodeDesc::Selector({
+        BTNodeDesc::Check("health", BTCompare::Less, 30.0f),
+        BTNodeDesc::Sequence({ BTNodeDesc::Action("count"), BTNodeDesc::Wait(0.25f) }),
+    });
+    Shared<const BehaviorTree> tree = BehaviorTree::Compile(desc, error, leaves.registry);
+    GV_CHECK(tree != nullptr);
+    if (!tree) return;
+
+    std::vector<BTAgent> serial(200, BTAgent(tree)), batched(200, BTAgent(tree));
+    for (size_t i = 0; i < serial.size(); ++i)
+        if (i % 4 == 0) { serial[i].SetFloat("health", 10.0f); batched[i].SetFloat("health", 10.0f); }
+    for (int frame = 0; frame < 60; ++frame) {
+        for (auto& a : serial) a.Update(1.0f / 60.0f);
+        BTAgent::UpdateBatch(batched.data(), batched.size(), 1.0f / 60.0f, 4);
+    }
+    bool same = true;
+    for (size_t i = 0; i < serial.size(); ++i)
+        same &= serial[i].GetInt("steps") == batched[i].GetInt("steps") &&
+                serial[i].GetTickCount() == batched[i].GetTickCount() &&
+                serial[i].GetLastStatus() == batched[i].GetLastStatus();
+    GV_CHECK(same);
+    GV_CHECK(serial[0].GetInt("steps") == 0 && serial[1].GetInt("steps") >= 4);
+}
+
+GV_TEST_MAIN()
@@ -0,0 +1,114 @@
+// ============================================================================
+// GameVoid Engine — Compiled Dialogue Bank Tests
+// ============================================================================
+#include "TestHarness.h"
+#include "editor2d/DialogueBank.h"
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace gv;
+
+namespace {
+
+const char* kShop =
+    ":: greet\n"
+    "Old Man: Looking to buy?\n"
+    "~ visits += 1\n"
+    "* [gold >= 10 and not bought] Buy the map -> buy\n"
+    "* Leave -> END\n"
+    "-> farewell if visits > 2\n"
+    "-> greet\n"
+    ":: buy\n"
+    ": He hands you a map.\n"
+    "~ gold -= 10; bought = true\n"
+    "-> END\n"
+    ":: farewell\n"
+    "Old Man: Come back soon.\n";
+
+std::vector<u8> CompileShop() {
+    std::vector<u8> bytes;
+    std::string error;
+    GV_CHECK(DialogueCompiler::CompileSource(kShop, "shop", bytes, error));
+    GV_CHECK(error.empty());
+    return bytes;
+}
+
+u32 Field(const std::vector<u8>& bytes, size_t at) {
+    u32 v;
+    std::memcpy(&v, bytes.data() + at, sizeof(v));
+    return v;
+}
+
+/// Byte offset of the code section (see the layout in DialogueBank.cpp).
+size_t CodeOffset(const std::vector<u8>& bytes) {
+    const u64 nodes = Field(bytes, 12), choices = Field(bytes, 16), links = Field(bytes, 20);
+    const u64 strings = Field(bytes, 24), vars = Field(bytes, 28);
+    return static_cast<size_t>(48 + nodes * 24 + choices * 12 + links * 8 + strings * 12 + (nodes + vars) * 8 + nodes * 4);
+}
+
+} // namespace
+
+GV_TEST(ConditionsAndActionsRunOverVariables) {
+    DialogueBank bank;
+    GV_CHECK(bank.Load(CompileShop(), "shop"));
+    GV_CHECK(bank.GetNodeCount() == 3);
+    const u32 greet = bank.FindNode("greet"), buy = bank.FindNode("buy");
+    GV_CHECK(greet == bank.GetStartNode() && buy != DialogueBank::kNone);
+    GV_CHECK(bank.GetString(bank.GetNode(greet).speaker) == "Old Man");
+
+    DialogueVariables vars;
+    std::vector<u32> choices;
+    bank.GetAvailableChoices(greet, vars, choices);
+    GV_CHECK(choices.size() == 1);                      // only "Leave"
+
+    vars.Set("gold", 25);
+    bank.GetAvailableChoices(greet, vars, choices);
+    GV_CHECK(choices.size() == 2 && bank.GetChoice(choices[0]).target == buy);
+
+    bank.Run(bank.GetNode(buy).actions, vars);
+    GV_CHECK_NEAR(vars.Get("gold"), 15.0, 0.0);
+    GV_CHECK_NEAR(vars.Get("bought"), 1.0, 0.0);
+    bank.GetAvailableChoices(greet, vars, choices);
+    GV_CHECK(choices.size() == 1);
+
+    for (int i = 0; i < 3; ++i) bank.Run(bank.GetNode(greet).actions, vars);
+    GV_CHECK(bank.GetNextNode(greet, vars) == bank.FindNode("farewell"));
+}
+
+GV_TEST(SourceErrorsNameTheLine) {
+    std::vector<u8> bytes;
+    std::string error;
+    GV_CHECK(!DialogueCompiler::CompileSource(":: a\n* [gold >=] Buy -> a\n", "bad", bytes, error));
+    GV_CHECK(error.rfind("bad:2:", 0) == 0);
+    GV_CHECK(!DialogueCompiler::CompileSource(":: a\n~ = 3\n", "bad", bytes, error));
+    GV_CHECK(!DialogueCompiler::CompileSource(":: a\n-> nowhere\n", "bad", bytes, error));
+}
+
+GV_TEST(MalformedCodeIsRejectedOnLoad) {
+    const std::vector<u8> good = CompileShop();
+    const size_t code = CodeOffset(good);
+    const u32 codeSize = Field(good, 32);
+    GV_CHECK(codeSize > 0 && code + codeSize <= good.size());
+
+    DialogueBank bank;
+    GV_CHECK(bank.Load(good));
+
+    std::vector<u8> unknown = good;
+    unknown[code] = 0xEE;                               // not an opcode
+    GV_CHECK(!bank.Load(unknown));
+
+    std::vector<u8> truncated = good;
+    truncated[code + codeSize - 1] = 1;                 // final OpEnd becomes OpConst, no operand
+    GV_CHECK(!bank.Load(truncated));
+
+    // The first program is "visits += 1": OpLoad visits, ...
+    std::vector<u8> badVar = good;
+    GV_CHECK(badVar[code] == 3);
+    const u16 outOfRange = 0x7FFF;
+    std::memcpy(&badVar[code + 1], &outOfRange, sizeof(outOfRange));
+    GV_CHECK(!bank.Load(badVar));
+    GV_CHECK(!bank.IsOpen());
+}
+
+GV_TEST_MAIN()
@@ -0,0 +1,151 @@
+// ============================================================================
+// GameVoid Engine — Dynamic Resolution Tests
+// ============================================================================
+// The governor is fed a simulated GPU whose frame time follows the pixel
+// count: fixedMs + pixelMs * scale².  A seeded jitter stands in for noise.
+// ============================================================================
+#include "TestHarness.h"
+#include "renderer/DynamicResolution.h"
+#include <cmath>
+#include <random>
+
+using namespace gv;
+
+namespace {
+
+struct SimulatedGpu {
+    f32 fixedMs = 2.0f;
+    f32 pixelMs = 20.0f;     // cost of a full-resolution frame's pixels
+    f32 jitter  = 0.0f;      // ± relative noise
+    std::mt19937 rng{ 7 };
+
+    f32 FrameMs(f32 scale) {
+        f32 ms = fixedMs + pixelMs * scale * scale;
+        if (jitter > 0.0f) ms *= 1.0f + std::uniform_real_distribution<f32>(-jitter, jitter)(rng);
+        return ms;
+    }
+    /// Scale at which a frame costs exactly `targetMs`.
+    f32 IdealScale(f32 targetMs) const { return std::sqrt((targetMs - fixedMs) / pixelMs); }
+};
+
+/// Runs `frames` frames and returns how many changed the scale.
+u32 Run(DynamicResolution& governor, SimulatedGpu& gpu, int frames) {
+    u32 changes = 0;
+    for (int i = 0; i < frames; ++i)
+        changes += governor.Update(0.0f, gpu.FrameMs(governor.GetScale())) ? 1u : 0u;
+    return changes;
+}
+
+} // namespace
+
+GV_TEST(ConvergesOnTheFrameBudget) {
+    DynamicResolution governor;
+    const DynamicResolutionSettings& s = governor.GetSettings();
+    SimulatedGpu gpu;                                   // 22 ms at full scale
+    const f32 ideal = gpu.IdealScale(s.targetMs);       // ~0.854
+    Run(governor, gpu, 600);
+
+    // The applied scale is the largest step that fits, or one under it,
+    // and the frame it renders is inside the budget.
+    GV_CHECK(governor.GetScale() <= ideal + 1e-4f);
+    GV_CHECK(governor.GetScale() >= ideal - 2.0f * s.step);
+    GV_CHECK(gpu.FrameMs(governor.GetScale()) <= s.targetMs);
+    GV_CHECK_NEAR(governor.GetDesiredScale(), ideal, 0.05);
+    GV_CHECK(governor.GetChangeCount() >= 1);
+
+    // Cheaper content: it climbs back to full resolution.
+    gpu.pixelMs = 8.0f;
+    Run(governor, gpu, 600);
+    GV_CHECK_NEAR(governor.GetScale(), s.maxScale, 1e-6);
+}
+
+GV_TEST(StaysInsideTheScaleBounds) {
+    DynamicResolutionSettings settings;
+    settings.minScale = 0.6f;
+    settings.maxScale = 0.9f;
+    DynamicResolution governor(settings);
+    governor.Reset();
+    GV_CHECK_NEAR(governor.GetScale(), 0.9, 1e-6);
+
+    // Far too expensive at any scale: pinned at the floor, never below.
+    SimulatedGpu gpu;
+    gpu.pixelMs = 200.0f;
+    bool inBounds = true;
+    for (int i = 0; i < 400; ++i) {
+        governor.Update(0.0f, gpu.FrameMs(governor.GetScale()));
+        inBounds &= governor.GetScale() >= 0.6f - 1e-6f && governor.GetDesiredScale() >= 0.6f - 1e-6f;
+    }
+    GV_CHECK(inBounds);
+    GV_CHECK_NEAR(governor.GetScale(), 0.6, 1e-6);
+
+    // Nearly free: pinned at the ceiling.
+    gpu.pixelMs = 1.0f;
+    for (int i = 0; i < 400; ++i) {
+        governor.Update(0.0f, gpu.FrameMs(governor.GetScale()));
+        inBounds &= governor.GetScale() <= 0.9f + 1e-6f && governor.GetDesiredScale() <= 0.9f + 1e-6f;
+    }
+    GV_CHECK(inBounds);
+    GV_CHECK_NEAR(governor.GetScale(), 0.9, 1e-6);
+
+    // Bad samples are ignored rather than treated as free frames.
+    const u32 changes = governor.GetChangeCount();
+    GV_CHECK(!governor.Update(0.0f, 0.0f) && !governor.Update(-1.0f, -1.0f));
+    GV_CHECK(!governor.Update(NAN, 0.0f) && !governor.Update(INFINITY, 0.0f));
+    GV_CHECK(governor.GetChangeCount() == changes);
+}
+
+GV_TEST(HoldsStillAtSteadyState) {
+    DynamicResolution governor;
+    SimulatedGpu gpu;
+    gpu.jitter = 0.03f;
+    Run(governor, gpu, 600);
+
+    // Ten more seconds of the same noisy load: the render targets keep
+    // their size, and the controller's own output barely moves.
+    const f32 scale = governor.GetScale();
+    f32 lo = governor.GetDesiredScale(), hi = lo;
+    u32 changes = 0;
+    for (int i = 0; i < 600; ++i) {
+        changes += governor.Update(0.0f, gpu.FrameMs(governor.GetScale())) ? 1u : 0u;
+        lo = std::fmin(lo, governor.GetDesiredScale());
+        hi = std::fmax(hi, governor.GetDesiredScale());
+    }
+    GV_CHECK(changes == 0);
+    GV_CHECK(governor.GetScale() == scale);
+    GV_CHECK(hi - lo < governor.GetSettings().step);
+}
+
+GV_TEST(DropsAtOnceOnASpike) {
+    DynamicResolution governor;
+    const DynamicResolutionSettings& s = governor.GetSettings();
+    SimulatedGpu gpu;
+    gpu.pixelMs = 10.0f;                                // fits at full scale
+    Run(governor, gpu, 120);
+    GV_CHECK_NEAR(governor.GetScale(), 1.0, 1e-6);
+
+    // One frame at 3× budget: no waiting for the filter or the cooldown.
+    GV_CHECK(governor.Update(0.0f, 3.0f * s.targetMs));
+    const f32 dropped = governor.GetScale();
+    GV_CHECK(dropped <= std::sqrt(1.0f / 3.0f) + 1e-4f && dropped >= std::sqrt(1.0f / 3.0f) - s.step);
+    GV_CHECK(dropped >= s.minScale);
+
+    // A merely slow frame doesn't trip it.
+    DynamicResolution calm;
+    GV_CHECK(!calm.Update(0.0f, s.targetMs * (s.panicRatio - 0.1f)));
+    GV_CHECK(calm.GetScale() == s.maxScale);
+
+    // After a one-off spike the load is cheap again and the scale recovers.
+    Run(governor, gpu, 600);
+    GV_CHECK_NEAR(governor.GetScale(), 1.0, 1e-6);
+}
+
+GV_TEST(RenderSizesRoundToWholePixels) {
+    GV_CHECK(DynamicResolution::ScaledSize(1920, 0.5f) == 960);
+    GV_CHECK(DynamicResolution::ScaledSize(1080, 0.75f) == 810);
+    GV_CHECK(DynamicResolution::ScaledSize(3, 0.5f) == 2);
+    GV_CHECK(DynamicResolution::ScaledSize(1, 0.01f) == 1);
+    DynamicResolution governor;
+    GV_CHECK(governor.GetRenderWidth(1920) == 1920 && governor.GetRenderHeight(1080) == 1080);
+}
+
+GV_TEST_MAIN()
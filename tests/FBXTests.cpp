@@ -0,0 +1,246 @@
+// ============================================================================
+// GameVoid Engine — Binary FBX Loader Tests
+// ============================================================================
+// Files are assembled in memory by a small writer below (7.4 and 7.5 record
+// headers, raw and zlib-encoded arrays), so no binary fixtures are needed.
+// ============================================================================
+#include "TestHarness.h"
+#include "assets/FBXLoader.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace gv;
+
+namespace {
+
+// ── Minimal FBX writer ─────────────────────────────────────────────────────
+struct Prop {
+    char             type = 0;
+    i64              i = 0;
+    f64              d = 0;
+    std::string      s;
+    std::vector<u8>  array;      // raw element bytes
+    u32              count = 0;
+    bool             zlib = false;
+};
+
+struct Node {
+    std::string       name;
+    std::vector<Prop> props;
+    std::vector<Node> children;
+};
+
+Prop Typed(char type)         { Prop p; p.type = type; return p; }
+Prop L(i64 v)                { Prop p = Typed('L'); p.i = v; return p; }
+Prop I(i32 v)                { Prop p = Typed('I'); p.i = v; return p; }
+Prop D(f64 v)                { Prop p = Typed('D'); p.d = v; return p; }
+Prop S(const std::string& v) { Prop p = Typed('S'); p.s = v; return p; }
+
+template <typename T>
+Prop Array(char type, const std::vector<T>& v, bool zlib = false) {
+    Prop p = Typed(type);
+    p.count = static_cast<u32>(v.size());
+    p.array.resize(v.size() * sizeof(T));
+    if (!v.empty()) std::memcpy(p.array.data(), v.data(), p.array.size());
+    p.zlib = zlib;
+    return p;
+}
+
+/// zlib stream of stored (uncompressed) deflate blocks.
+std::vector<u8> ZlibStored(const std::vector<u8>& data) {
+    std::vector<u8> out = { 0x78, 0x01 };
+    size_t at = 0;
+    do {
+        const size_t n = std::min<size_t>(data.size() - at, 65535);
+        const bool last = at + n == data.size();
+        out.push_back(last ? 1 : 0);
+        out.push_back(static_cast<u8>(n)); out.push_back(static_cast<u8>(n >> 8));
+        out.push_back(static_cast<u8>(~n)); out.push_back(static_cast<u8>(~n >> 8));
+        out.insert(out.end(), data.begin() + at, data.begin() + at + n);
+        at += n;
+    } while (at < data.size());
+    u32 a = 1, b = 0;
+    for (u8 c : data) { a = (a + c) % 65521; b = (b + a) % 65521; }
+    const u32 adler = (b << 16) | a;
+    for (int k = 3; k >= 0; --k) out.push_back(static_cast<u8>(adler >> (8 * k)));
+    return out;
+}
+
+template <typename T>
+void Put(std::vector<u8>& out, T v) {
+    const size_t at = out.size();
+    out.resize(at + sizeof(T));
+    std::memcpy(out.data() + at, &v, sizeof(T));
+}
+
+void WriteProp(std::vector<u8>& out, const Prop& p) {
+    out.push_back(static_cast<u8>(p.type));
+    switch (p.type) {
+        case 'I': Put<i32>(out, static_cast<i32>(p.i)); break;
+        case 'L': Put<i64>(out, p.i); break;
+        case 'D': Put<f64>(out, p.d); break;
+        case 'S':
+            Put<u32>(out, static_cast<u32>(p.s.size()));
+            out.insert(out.end(), p.s.begin(), p.s.end());
+            break;
+        default: {
+            std::vector<u8> bytes = p.zlib ? ZlibStored(p.array) : p.array;
+            Put<u32>(out, p.count);
+            Put<u32>(out, p.zlib ? 1u : 0u);
+            Put<u32>(out, static_cast<u32>(bytes.size()));
+            out.insert(out.end(), bytes.begin(), bytes.end());
+        }
+    }
+}
+
+void WriteNode(std::vector<u8>& out, const Node& n, bool wide) {
+    const size_t start = out.size();
+    const size_t header = wide ? 25 : 13;
+    out.resize(start + header);
+    out.insert(out.end(), n.name.begin(), n.name.end());
+    const size_t propsStart = out.size();
+    for (const auto& p : n.props) WriteProp(out, p);
+    const size_t propLen = out.size() - propsStart;
+    if (!n.children.empty()) {
+        for (const auto& c : n.children) WriteNode(out, c, wide);
+        out.resize(out.size() + header, 0);                 // null record
+    }
+    auto set = [&](size_t at, u64 v) { std::memcpy(out.data() + at, &v, wide ? 8 : 4); };
+    set(start, out.size());
+    set(start + (wide ? 8 : 4), n.props.size());
+    set(start + (wide ? 16 : 8), propLen);
+    out[start + header - 1] = static_cast<u8>(n.name.size());
+}
+
+std::vector<u8> WriteFBX(const std::vector<Node>& roots, u32 version) {
+    std::vector<u8> out(27, 0);
+    std::memcpy(out.data(), "Kaydara FBX Binary  ", 20);
+    out[21] = 0x1A;
+    std::memcpy(out.data() + 23, &version, 4);
+    for (const auto& r : roots) WriteNode(out, r, version >= 7500);
+    out.resize(out.size() + (version >= 7500 ? 25 : 13), 0);
+    return out;
+}
+
+Node P70(const std::string& name, f64 x, f64 y, f64 z) {
+    return { "P", { S(name), S(name), S(""), S("A"), D(x), D(y), D(z) }, {} };
+}
+
+Node Child(const std::string& name, Prop p) { return { name, { std::move(p) }, {} }; }
+
+/// A quad and a triangle on two materials, owned by a translated model.
+std::vector<Node> QuadAndTriangle(bool zlibArrays) {
+    const std::vector<f64> cps = { 0, 0, 0,  1, 0, 0,  1, 1, 0,  0, 1, 0,  2, 0, 0 };
+    const std::vector<i32> pvi = { 0, 1, 2, ~3,  1, 4, ~2 };   // last index of each polygon is ~i
+    const std::vector<f64> normals = { 0, 0, 1 };
+    const std::vector<i32> mats = { 0, 1 };
+
+    Node geometry{ "Geometry", { L(100), S(std::string("Shape\0\1Geometry", 16)), S("Mesh") }, {
+        Child("Vertices", Array('d', cps, zlibArrays)),
+        Child("PolygonVertexIndex", Array('i', pvi, zlibArrays)),
+        { "LayerElementNormal", { I(0) }, {
+            Child("MappingInformationType", S("AllSame")),
+            Child("ReferenceInformationType", S("Direct")),
+            Child("Normals", Array('d', normals)) } },
+        { "LayerElementMaterial", { I(0) }, {
+            Child("MappingInformationType", S("ByPolygon")),
+            Child("ReferenceInformationType", S("IndexToDirect")),
+            Child("Materials", Array('i', mats)) } },
+    } };
+    Node model{ "Model", { L(200), S(std::string("Panel\0\1Model", 12)), S("Mesh") }, {
+        { "Properties70", {}, { P70("Lcl Translation", 5, 0, 0), P70("Lcl Scaling", 2, 2, 2) } } } };
+    Node red{ "Material", { L(300), S(std::string("Red\0\1Material", 14)), S("") }, {
+        { "Properties70", {}, { P70("DiffuseColor", 1, 0, 0) } } } };
+    Node blue{ "Material", { L(301), S(std::string("Blue\0\1Material", 15)), S("") }, {
+        { "Properties70", {}, { P70("DiffuseColor", 0, 0, 1) } } } };
+
+    Node objects{ "Objects", {}, { geometry, model, red, blue } };
+    Node connections{ "Connections", {}, {
+        { "C", { S("OO"), L(200), L(0) }, {} },
+        { "C", { S("OO"), L(100), L(200) }, {} },
+        { "C", { S("OO"), L(300), L(200) }, {} },
+        { "C", { S("OO"), L(301), L(200) }, {} } } };
+    return { Node{ "FBXHeaderExtension", {}, { Child("FBXVersion", I(7400)) } }, objects, connections };
+}
+
+void CheckQuadAndTriangle(const FBXScene& scene) {
+    GV_CHECK(scene.meshes.size() == 1);
+    GV_CHECK(scene.materials.size() == 2);
+    if (scene.meshes.empty() || scene.materials.size() != 2) return;
+    const FBXMesh& mesh = scene.meshes[0];
+    GV_CHECK(mesh.name == "Panel");
+    GV_CHECK(mesh.vertices.size() == 7);                 // one per polygon vertex
+    GV_CHECK(mesh.indices.size() == 9);                  // quad fans to 2 triangles
+    GV_CHECK(mesh.subMeshes.size() == 2);
+    for (const auto& v : mesh.vertices) GV_CHECK_NEAR(v.normal.z, 1.0, 1e-6);
+    GV_CHECK(scene.materials[0].name == "Red");
+    GV_CHECK_NEAR(scene.materials[1].diffuse.z, 1.0, 0.0);
+    GV_CHECK_NEAR(mesh.worldTransform.m[12], 5.0, 1e-6);
+    GV_CHECK_NEAR(mesh.worldTransform.m[0], 2.0, 1e-6);
+}
+
+} // namespace
+
+GV_TEST(InflatesFixedHuffmanAndStoredBlocks) {
+    // zlib.compress(b"abc" * 10 + b" GameVoid GameVoid GameVoid", 9)
+    const u8 fixed[] = { 0x78, 0xda, 0x4b, 0x4c, 0x4a, 0x4e, 0xc4, 0x8d, 0x14, 0xdc, 0x13, 0x73,
+                         0x53, 0xc3, 0xf2, 0x33, 0x53, 0x30, 0x19, 0x00, 0x69, 0x20, 0x15, 0x01 };
+    std::string expect;
+    for (int i = 0; i < 10; ++i) expect += "abc";
+    expect += " GameVoid GameVoid GameVoid";
+    std::vector<u8> out(expect.size());
+    GV_CHECK(InflateZlib(fixed, sizeof(fixed), out.data(), out.size()));
+    GV_CHECK(std::memcmp(out.data(), expect.data(), expect.size()) == 0);
+
+    // Wrong size and a corrupted checksum are both rejected.
+    std::vector<u8> small(expect.size() - 1);
+    GV_CHECK(!InflateZlib(fixed, sizeof(fixed), small.data(), small.size()));
+    u8 bad[sizeof(fixed)];
+    std::memcpy(bad, fixed, sizeof(fixed));
+    bad[sizeof(bad) - 1] ^= 0xFF;
+    GV_CHECK(!InflateZlib(bad, sizeof(bad), out.data(), out.size()));
+
+    std::vector<u8> data(70000);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<u8>(i * 31 + 7);
+    std::vector<u8> stored = ZlibStored(data), back(data.size());
+    GV_CHECK(InflateZlib(stored.data(), stored.size(), back.data(), back.size()));
+    GV_CHECK(back == data);
+}
+
+GV_TEST(ExtractsGeometryMaterialsAndTransform) {
+    std::vector<u8> file = WriteFBX(QuadAndTriangle(false), 7400);
+    FBXDocument doc;
+    GV_CHECK(doc.Parse(file.data(), file.size()));
+    GV_CHECK(doc.GetVersion() == 7400);
+    FBXScene scene;
+    GV_CHECK(doc.Extract(scene));
+    CheckQuadAndTriangle(scene);
+}
+
+GV_TEST(WideHeadersAndZlibArraysMatch) {
+    std::vector<u8> file = WriteFBX(QuadAndTriangle(true), 7500);
+    FBXDocument doc;
+    GV_CHECK(doc.Parse(file.data(), file.size()));
+    FBXScene scene;
+    GV_CHECK(doc.Extract(scene));
+    CheckQuadAndTriangle(scene);
+}
+
+GV_TEST(CorruptFilesAreRejected) {
+    FBXDocument doc;
+    const u8 text[] = "; FBX 7.4.0 project file";
+    GV_CHECK(!doc.Parse(text, sizeof(text)));
+
+    std::vector<u8> file = WriteFBX(QuadAndTriangle(false), 7400);
+    std::vector<u8> truncated(file.begin(), file.begin() + static_cast<std::ptrdiff_t>(file.size() / 2));
+    FBXDocument cut;
+    GV_CHECK(!cut.Parse(truncated.data(), truncated.size()));
+    GV_CHECK(!cut.GetError().empty());
+
+    std::vector<u8> future = WriteFBX({}, 8100);
+    GV_CHECK(!doc.Parse(future.data(), future.size()));
+}
+
+GV_TEST_MAIN()
@@ -0,0 +1,197 @@
+// ============================================================================
+// GameVoid Engine — Force Field / ForceController Tests
+// ============================================================================
+#include "TestHarness.h"
+#include "core/GameObject.h"
+#include "editor2d/Editor2DTypes.h"
+#include "physics/ForceField.h"
+#include "physics/Physics.h"
+#include "scripting/physics/ForceController.h"
+#include <memory>
+
+using namespace gv;
+
+namespace {
+
+/// A world with no gravity and a list of loose bodies (no Scene needed).
+struct FieldRig {
+    PhysicsWorld world;
+    std::vector<std::unique_ptr<GameObject>> objects;
+
+    FieldRig() {
+        world.Init();
+        world.gravity = Vec3(0, 0, 0);
+    }
+    ~FieldRig() { world.Shutdown(); }
+
+    RigidBody* AddBody(const Vec3& pos, f32 mass = 1.0f) {
+        objects.push_back(std::make_unique<GameObject>("body"));
+        GameObject* obj = objects.back().get();
+        obj->GetTransform().position = pos;
+        auto* rb = obj->AddComponent<RigidBody>();
+        rb->mass = mass;
+        rb->useGravity = false;
+        obj->AddComponent<Collider>();
+        world.RegisterBody(rb);
+        return rb;
+    }
+
+    void Step(i32 steps) {
+        for (i32 i = 0; i < steps; ++i) world.Step(world.fixedTimeStep);
+    }
+};
+
+} // namespace
+
+GV_TEST(DirectionalFieldMovesOnlyBodiesInside) {
+    FieldRig rig;
+    ForceField wind;
+    wind.name = "wind";
+    wind.shape = ForceFieldShape::Sphere;
+    wind.radius = 2.0f;
+    wind.direction = Vec3(1, 0, 0);
+    wind.strength = 6.0f;
+    wind.massIndependent = true;
+    rig.world.AddForceField(wind);
+
+    RigidBody* inside  = rig.AddBody(Vec3(0, 0, 0));
+    RigidBody* outside = rig.AddBody(Vec3(10, 0, 0));
+    rig.Step(30);                                        // 0.5 s
+
+    GV_CHECK_NEAR(inside->velocity.x, 3.0, 0.15);
+    GV_CHECK_NEAR(outside->velocity.x, 0.0, 1e-6);
+
+    GV_CHECK(rig.world.RemoveForceField("wind"));
+    const f32 vx = inside->velocity.x;
+    rig.Step(10);
+    GV_CHECK_NEAR(inside->velocity.x, vx, 0.05);       // only the body's own drag left
+}
+
+GV_TEST(BuoyancyUsesTheBodysCollider) {
+    FieldRig rig;
+    rig.world.gravity = Vec3(0, -9.81f, 0);
+    ForceField water;
+    water.name = "water";
+    water.type = ForceFieldType::Buoyancy;
+    water.shape = ForceFieldShape::Infinite;
+    water.surfaceHeight = 20.0f;                        // well above the ground plane
+    water.linearDrag = 0.0f;
+    rig.world.AddForceField(water);
+
+    // 500 kg in a 0.5 m box: displaces 0.125 m³ (1/4 of its weight) and sinks.
+    RigidBody* box = rig.AddBody(Vec3(0, 10, 0), 500.0f);
+    box->useGravity = true;
+    box->GetOwner()->GetComponent<Collider>()->boxHalfExtents = Vec3(0.25f, 0.25f, 0.25f);
+    rig.Step(6);
+    GV_CHECK(box->velocity.y < -0.5f);
+
+    // Collider removed mid-run: the world falls back to the unit-cube
+    // default (1 m³, twice its weight) on the next step and it rises.
+    GV_CHECK(box->GetOwner()->RemoveComponent<Collider>());
+    box->velocity = Vec3(0, 0, 0);
+    rig.Step(6);
+    GV_CHECK(box->velocity.y > 0.5f);
+}
+
+GV_TEST(LibraryParsesEveryFieldType) {
+    const char* text =
+        "[field]\nname=a\ntype=directional\nshape=infinite\ndirection=1 0 0\n"
+        "[field]\nname=b\ntype=radial\nradius=3\n"
+        "[field]\nname=c\ntype=vortex\ninwardStrength=2\n"
+        "[field]\nname=d\ntype=drag\nlinearDrag=0.25\n"
+        "[field]\nname=e\ntype=buoyancy\nfluidDensity=800\n"
+        "[field]\nname=f\ntype=wind\nshape=box\nhalfExtents=1 2 3\n";
+    std::vector<ForceField> fields = ForceFieldLibrary::ParseString(text);
+    GV_CHECK(fields.size() == 6);
+    if (fields.size() != 6) return;
+    GV_CHECK(fields[0].type == ForceFieldType::Directional && fields[0].shape == ForceFieldShape::Infinite);
+    GV_CHECK_NEAR(fields[1].radius, 3.0, 0.0);
+    GV_CHECK_NEAR(fields[2].inwardStrength, 2.0, 0.0);
+    GV_CHECK_NEAR(fields[3].linearDrag, 0.25, 1e-6);
+    GV_CHECK_NEAR(fields[4].fluidDensity, 800.0, 0.0);
+    GV_CHECK(fields[5].type == ForceFieldType::WindNoise && fields[5].shape == ForceFieldShape::Box);
+    GV_CHECK_NEAR(fields[5].halfExtents.z, 3.0, 0.0);
+}
+
+GV_TEST(TenThousandBodiesMatchAPerBodyReference) {
+    // Every field type over 10k scattered bodies: the grid-sorted batched
+    // pass must give each body the same force as evaluating every field on
+    // that body alone.
+    FieldRig rig;
+    rig.world.gravity = Vec3(0, -9.81f, 0);             // buoyancy reads |g|
+    const char* text =
+        "[field]\nname=river\ntype=directional\nshape=box\ncenter=-20 0 0\nhalfExtents=15 40 50\ndirection=1 0 0\nstrength=12\n"
+        "[field]\nname=blast\ntype=radial\ncenter=10 5 10\nradius=12\nstrength=40\nlinearFalloff=1\n"
+        "[field]\nname=twister\ntype=vortex\ncenter=25 0 -25\nradius=15\ndirection=0 1 0\ninwardStrength=5\n"
+        "[field]\nname=air\ntype=drag\nshape=infinite\nlinearDrag=0.3\nquadraticDrag=0.05\n"
+        "[field]\nname=lake\ntype=buoyancy\nshape=box\ncenter=0 -20 0\nhalfExtents=50 20 50\nsurfaceHeight=-5\n"
+        "[field]\nname=gust\ntype=wind\nshape=sphere\ncenter=-10 10 25\nradius=20\ndirection=0 0 1\n";
+    std::vector<ForceField> fields = ForceFieldLibrary::ParseString(text);
+    GV_CHECK(fields.size() == 6);
+    for (const ForceField& f : fields) rig.world.AddForceField(f);
+
+    const size_t kBodies = 10000;
+    std::vector<RigidBody*> bodies;
+    std::vector<Vec3> start, startVelocity;
+    u32 seed = 2024;
+    auto rand01 = [&seed] { seed = seed * 1664525u + 1013904223u; return f32(seed >> 8) / f32(1u << 24); };
+    for (size_t i = 0; i < kBodies; ++i) {
+        const Vec3 p(rand01() * 100.0f - 50.0f, rand01() * 40.0f - 20.0f, rand01() * 100.0f - 50.0f);
+        RigidBody* rb = rig.AddBody(p, 0.5f + rand01() * 4.5f);
+        rb->GetOwner()->RemoveComponent<Collider>();    // keep the pair-wise collision pass out of it
+        rb->velocity = Vec3(rand01() - 0.5f, rand01() - 0.5f, rand01() - 0.5f) * 4.0f;
+        bodies.push_back(rb);
+        start.push_back(p);
+        startVelocity.push_back(rb->velocity);
+    }
+    rig.Step(1);
+
+    const f32 dt = rig.world.fixedTimeStep;
+    size_t mismatched = 0, pushed = 0;
+    ForceFieldLanes one;
+    one.Resize(1);
+    for (size_t i = 0; i < kBodies; ++i) {
+        one.px[0] = start[i].x; one.py[0] = start[i].y; one.pz[0] = start[i].z;
+        one.vx[0] = startVelocity[i].x; one.vy[0] = startVelocity[i].y; one.vz[0] = startVelocity[i].z;
+        one.mass[0] = bodies[i]->mass;
+        one.halfHeight[0] = 0.5f;
+        one.volume[0] = 1.0f;
+        one.fx[0] = one.fy[0] = one.fz[0] = 0.0f;
+        for (const ForceField& f : fields) EvaluateForceField(f, one, 0, 1, 0.0f, 9.81f);
+        const Vec3 expected = startVelocity[i] + Vec3(one.fx[0], one.fy[0], one.fz[0]) * (dt / bodies[i]->mass);
+        const Vec3 diff = bodies[i]->velocity - expected;
+        if (diff.Length() > 1e-4f * (1.0f + expected.Length())) ++mismatched;
+        if ((expected - startVelocity[i]).Length() > 0.0f) ++pushed;
+    }
+    GV_CHECK(mismatched == 0);
+    GV_CHECK(pushed == kBodies);                        // the drag field reaches everyone
+}
+
+GV_TEST(ForceControllerFollowsItsBody) {
+    GameObject obj("pushed");
+    auto* ctrl = obj.AddComponent<ForceController>();
+    ctrl->ApplyForceVector(Vec3(1, 0, 0));                // no body: ignored
+    GV_CHECK_NEAR(ctrl->GetCurrentForce().x, 0.0, 0.0);
+
+    auto* rb = obj.AddComponent<RigidBody>();
+    rb->mass = 2.0f;
+    ctrl->immediateMode = true;
+    ctrl->ApplyForceVector(Vec3(4, 0, 0));
+    GV_CHECK_NEAR(rb->velocity.x, 2.0, 1e-6);
+
+    GV_CHECK(obj.RemoveComponent<RigidBody>());          // must not touch the freed body
+    ctrl->ApplyForceVector(Vec3(4, 0, 0));
+    ctrl->Update(1.0f / 60.0f);
+    GV_CHECK(ctrl->GetCurrentSpeed() == 0.0f);
+
+    auto* rb2d = obj.AddComponent<RigidBody2D>();
+    rb2d->mass = 4.0f;
+    ctrl->ApplyForceVector(Vec3(0, 8, 0));
+    GV_CHECK_NEAR(rb2d->velocity.y, 2.0, 1e-6);
+    GV_CHECK_NEAR(ctrl->GetCurrentSpeed(), 2.0, 1e-6);
+
+    GV_CHECK(obj.RemoveComponent<ForceController>());    // detached: drops the body
+    GV_CHECK(obj.RemoveComponent<RigidBody2D>());
+}
+
+GV_TEST_MAIN()
@@ -0,0 +1,189 @@
+// ============================================================================
+// GameVoid Engine — glTF Conformance Tests
+// ============================================================================
+// Loads the samples in tests/data/gltf (see make_samples.py there): the same
+// Box as .gltf + .bin, as a data URI and as .glb, a textured box and a
+// two-joint skinned, animated tube.
+// ============================================================================
+#include "TestHarness.h"
+#include "assets/Assets.h"
+#include "assets/GLTFLoader.h"
+#include "core/Scene.h"
+#include <vector>
+
+using namespace gv;
+
+namespace {
+
+std::string Sample(const char* name) { return test::DataPath(std::string("gltf/") + name); }
+
+Vec3 TransformPoint(const Mat4& m, const Vec3& p) {
+    return Vec3(m.m[0] * p.x + m.m[4] * p.y + m.m[8]  * p.z + m.m[12],
+                m.m[1] * p.x + m.m[5] * p.y + m.m[9]  * p.z + m.m[13],
+                m.m[2] * p.x + m.m[6] * p.y + m.m[10] * p.z + m.m[14]);
+}
+
+struct Geometry {
+    std::vector<SkinnedVertex> vertices;
+    std::vector<u32>           indices;
+};
+
+bool ReadFirstPrimitive(const GLTFDocument& doc, Geometry& out) {
+    if (doc.meshes.empty() || doc.meshes[0].primitives.empty()) return false;
+    return doc.ReadPrimitive(doc.meshes[0].primitives[0], out.vertices, out.indices);
+}
+
+/// Checks shared by every encoding of the Box sample.
+void CheckBox(const GLTFDocument& doc) {
+    GV_CHECK(doc.meshes.size() == 1 && doc.nodes.size() == 2);
+    Geometry g;
+    GV_CHECK(ReadFirstPrimitive(doc, g));
+    GV_CHECK(g.vertices.size() == 24);
+    GV_CHECK(g.indices.size() == 36);
+    for (u32 i : g.indices) GV_CHECK(i < 24);
+
+    const GLTFAccessor* pos = doc.GetAccessor(doc.meshes[0].primitives[0].position);
+    GV_CHECK(pos && pos->min.size() == 3 && pos->max.size() == 3);
+    for (const auto& v : g.vertices) {
+        GV_CHECK(std::fabs(v.position.x) <= 0.5f && std::fabs(v.position.y) <= 0.5f &&
+                 std::fabs(v.position.z) <= 0.5f);
+        GV_CHECK_NEAR(v.normal.Length(), 1.0, 1e-5);
+    }
+    // Triangles wind counter-clockwise: the face normal agrees with the
+    // vertex normals.
+    for (size_t t = 0; t < g.indices.size(); t += 3) {
+        const auto& a = g.vertices[g.indices[t]];
+        const auto& b = g.vertices[g.indices[t + 1]];
+        const auto& c = g.vertices[g.indices[t + 2]];
+        Vec3 n = (b.position - a.position).Cross(c.position - a.position);
+        GV_CHECK(n.Dot(a.normal) > 0.0f);
+    }
+
+    // Root node `matrix` (-90 degrees about X) is decomposed into TRS.
+    GV_CHECK(doc.nodes[0].children.size() == 1 && doc.nodes[1].parent == 0);
+    Vec3 up = TransformPoint(doc.GetWorldMatrix(1), Vec3(0, 1, 0));
+    GV_CHECK_NEAR(up.x, 0.0, 1e-5);
+    GV_CHECK_NEAR(up.y, 0.0, 1e-5);
+    GV_CHECK_NEAR(up.z, -1.0, 1e-5);
+
+    GV_CHECK(doc.materials.size() == 1);
+    if (!doc.materials.empty()) GV_CHECK_NEAR(doc.materials[0].metallic, 0.0, 0.0);
+}
+
+} // namespace
+
+GV_TEST(BoxWithExternalBuffer) {
+    GLTFDocument doc;
+    GV_CHECK(doc.Load(Sample("Box.gltf")));
+    CheckBox(doc);
+    GV_CHECK(doc.bufferViews.size() == 2 && doc.bufferViews[1].stride == 12);
+    if (!doc.materials.empty()) GV_CHECK_NEAR(doc.materials[0].baseColor.x, 0.8, 1e-6);
+}
+
+GV_TEST(BoxAsDataUriAndGlbMatchesExternal) {
+    GLTFDocument ref, embedded, glb;
+    GV_CHECK(ref.Load(Sample("Box.gltf")));
+    GV_CHECK(embedded.Load(Sample("BoxEmbedded.gltf")));
+    GV_CHECK(glb.Load(Sample("Box.glb")));
+    CheckBox(embedded);
+    CheckBox(glb);
+
+    Geometry a, b, c;
+    ReadFirstPrimitive(ref, a);
+    ReadFirstPrimitive(embedded, b);
+    ReadFirstPrimitive(glb, c);
+    GV_CHECK(a.indices == b.indices && a.indices == c.indices);
+    bool same = a.vertices.size() == b.vertices.size() && a.vertices.size() == c.vertices.size();
+    for (size_t i = 0; same && i < a.vertices.size(); ++i) {
+        const Vec3 &p = a.vertices[i].position, &q = b.vertices[i].position, &r = c.vertices[i].position;
+        same = p.x == q.x && p.y == q.y && p.z == q.z && p.x == r.x && p.y == r.y && p.z == r.z;
+    }
+    GV_CHECK(same);
+}
+
+GV_TEST(BoxTexturedResolvesItsImage) {
+    GLTFDocument doc;
+    GV_CHECK(doc.Load(Sample("BoxTextured.gltf")));
+    Geometry g;
+    GV_CHECK(ReadFirstPrimitive(doc, g));
+    GV_CHECK(g.vertices.size() == 24);
+    bool uvsInRange = true, hasTangents = true;
+    for (const auto& v : g.vertices) {
+        uvsInRange &= v.texCoord.x >= 0 && v.texCoord.x <= 1 && v.texCoord.y >= 0 && v.texCoord.y <= 1;
+        hasTangents &= v.tangent.Length() > 0.5f;             // generated from the UVs
+    }
+    GV_CHECK(uvsInRange);
+    GV_CHECK(hasTangents);
+
+    GV_CHECK(doc.materials.size() == 1);
+    if (doc.materials.empty()) return;
+    const i32 tex = doc.materials[0].baseColorTexture;
+    GV_CHECK(tex == 0 && doc.textures.size() == 1);
+    if (tex != 0 || doc.textures.empty()) return;
+    const i32 img = doc.textures[tex].source;
+    GV_CHECK(img == 0 && doc.images.size() == 1 && doc.images[0].uri == "checker.png");
+}
+
+GV_TEST(RiggedSimpleSkinAndAnimation) {
+    GLTFDocument doc;
+    GV_CHECK(doc.Load(Sample("RiggedSimple.gltf")));
+    GV_CHECK(doc.skins.size() == 1 && doc.animations.size() == 1);
+    if (doc.skins.empty() || doc.animations.empty()) return;
+    const GLTFSkin& skin = doc.skins[0];
+    GV_CHECK(skin.joints.size() == 2);
+
+    Geometry g;
+    GV_CHECK(ReadFirstPrimitive(doc, g));
+    GV_CHECK(g.vertices.size() == 12 && g.indices.size() == 48);
+    for (const auto& v : g.vertices) {
+        f32 sum = 0;
+        for (int k = 0; k < 4; ++k) {
+            sum += v.boneWeights[k];
+            if (v.boneWeights[k] > 0) GV_CHECK(v.boneIDs[k] == 0 || v.boneIDs[k] == 1);
+        }
+        GV_CHECK_NEAR(sum, 1.0, 1e-5);
+    }
+
+    // At bind pose, joint world * inverse bind is the identity.
+    std::vector<Mat4> ibm(skin.joints.size());
+    GV_CHECK(doc.ReadFloats(skin.inverseBindMatrices, ibm[0].m, 16, sizeof(Mat4)));
+    for (size_t j = 0; j < skin.joints.size(); ++j) {
+        Vec3 p = TransformPoint(doc.GetWorldMatrix(skin.joints[j]) * ibm[j], Vec3(0.3f, 0.7f, -0.2f));
+        GV_CHECK_NEAR(p.x, 0.3, 1e-5);
+        GV_CHECK_NEAR(p.y, 0.7, 1e-5);
+        GV_CHECK_NEAR(p.z, -0.2, 1e-5);
+    }
+
+    const GLTFAnimation& anim = doc.animations[0];
+    GV_CHECK(anim.channels.size() == 1 && anim.samplers.size() == 1);
+    if (anim.channels.empty() || anim.samplers.empty()) return;
+    GV_CHECK(anim.channels[0].path == GLTFAnimationChannel::Rotation);
+    GV_CHECK(anim.channels[0].node == skin.joints[1]);
+    f32 times[3] = {};
+    GV_CHECK(doc.ReadFloats(anim.samplers[0].input, times, 1, sizeof(f32)));
+    GV_CHECK_NEAR(times[2], 2.0, 0.0);
+}
+
+GV_TEST(RiggedSimpleImportsIntoAScene) {
+    Scene scene;
+    GLTFImportResult result;
+    GV_CHECK(ImportGLTFScene(Sample("RiggedSimple.gltf"), scene, result));
+    GV_CHECK(result.root != nullptr);
+    GV_CHECK(result.nodeObjects.size() == 4);
+    GV_CHECK(result.meshObjects == 0);                       // the only mesh is skinned
+    GV_CHECK(result.skinnedObjects == 1);
+    GV_CHECK(result.animationClips == 1);
+}
+
+GV_TEST(MalformedFilesAreRejected) {
+    GLTFDocument doc;
+    GV_CHECK(!doc.Load(Sample("missing.gltf")));
+    GV_CHECK(!doc.GetError().empty());
+
+    const std::string truncated = "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":64,"
+                                  "\"uri\":\"data:application/octet-stream;base64,AAAA\"}]}";
+    GLTFDocument bad;
+    GV_CHECK(!bad.Parse(reinterpret_cast<const u8*>(truncated.data()), truncated.size()));
+}
+
+GV_TEST_MAIN()
@@ -0,0 +1,191 @@
+// ============================================================================
+// GameVoid Engine — Script Hot Reload Tests
+// ============================================================================
+// Scripts are edited in a temp directory and picked up by the engine's
+// FileWatcher, with inotify where available and with stat polling.  The
+// watcher runs on the engine's clock with no debounce, so an edit must be
+// live after the very next Update().
+// ============================================================================
+#include "TestHarness.h"
+#include "core/EventSystem.h"
+#include "scripting/ScriptEngine.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace gv;
+namespace fs = std::filesystem;
+
+namespace {
+
+const f32 kFrame = 1.0f / 60.0f;
+
+const char* kVersion1 =
+    "var hits = 0;\n"
+    "var label = \"first\";\n"
+    "func on_update(dt) { hits = hits + 1; }\n";
+
+const char* kVersion2 =
+    "var hits = 0;\n"
+    "var label = \"second\";\n"
+    "var added = 7;\n"
+    "func on_update(dt) { hits = hits + 10; }\n";
+
+/// A temp directory that is removed again.
+struct TempDir {
+    fs::path path;
+    explicit TempDir(const char* name) : path(fs::temp_directory_path() / name) {
+        std::error_code ec;
+        fs::remove_all(path, ec);
+        fs::create_directories(path);
+    }
+    ~TempDir() { std::error_code ec; fs::remove_all(path, ec); }
+    std::string File(const char* name) const { return (path / name).generic_string(); }
+};
+
+void Write(const std::string& path, const std::string& text) {
+    std::ofstream(path, std::ios::trunc) << text;
+}
+
+/// Saves the way many editors do: write a sibling file, rename it over.
+void WriteByRename(const std::string& path, const std::string& text) {
+    Write(path + ".tmp", text);
+    fs::rename(path + ".tmp", path);
+}
+
+/// Engine with hot reload on and the watcher reporting every edit at once.
+struct Reloading {
+    ScriptEngine engine;
+    std::vector<std::string> reloaded, failed;
+    u32 listener = 0;
+
+    explicit Reloading(bool polling) {
+        engine.Init();
+        FileWatcher& watcher = engine.GetFileWatcher();
+        watcher.ForcePolling(polling);
+        watcher.SetDebounce(0.0);
+        watcher.SetPollInterval(0.0);
+        engine.EnableHotReload(true);
+        listener = EventBus::Instance().Subscribe(EventType::Custom, [this](const Event& e) {
+            if (e.signalName == "script_reloaded") reloaded.push_back(e.signalData);
+            if (e.signalName == "script_reload_failed") failed.push_back(e.signalData);
+        });
+    }
+    ~Reloading() {
+        EventBus::Instance().Unsubscribe(listener);
+        engine.Shutdown();
+    }
+    f64 Number(u32 id, const char* name) const { return engine.GetInstanceVariable(id, name).AsNumber(); }
+};
+
+/// Which version of the script is running: each one stores its own mark.
+f64 VersionOf(ScriptEngine& engine, u32 id) {
+    engine.CallInstance(id, "on_version");
+    return engine.GetInstanceVariable(id, "seen").AsNumber();
+}
+
+void SwapsOnTheNextFrame(bool polling) {
+    TempDir dir(polling ? "gv_hot_reload_poll" : "gv_hot_reload_notify");
+    const std::string path = dir.File("guard.gvs");
+    Write(path, kVersion1);
+
+    Reloading r(polling);
+    const u32 a = r.engine.CreateInstance(path, "", nullptr);
+    const u32 b = r.engine.CreateInstance(path, "", nullptr);
+    GV_CHECK(a != 0 && b != 0);
+    for (int i = 0; i < 3; ++i) r.engine.CallInstance(a, "on_update", kFrame);
+    r.engine.CallInstance(b, "on_update", kFrame);
+    r.engine.Update(kFrame);                            // nothing changed yet
+    GV_CHECK(r.reloaded.empty() && r.failed.empty());
+
+    // One edit, one frame: both instances run the new code and keep their
+    // own counters; the string keeps its value, the new var is defined.
+    Write(path, kVersion2);
+    r.engine.Update(kFrame);
+    GV_CHECK(r.reloaded.size() == 1 && r.failed.empty());
+    GV_CHECK(r.Number(a, "hits") == 3.0 && r.Number(b, "hits") == 1.0);
+    GV_CHECK(r.engine.GetInstanceVariable(a, "label").AsString() == "first");
+    GV_CHECK(r.Number(a, "added") == 7.0);
+    r.engine.CallInstance(a, "on_update", kFrame);
+    r.engine.CallInstance(b, "on_update", kFrame);
+    GV_CHECK(r.Number(a, "hits") == 13.0 && r.Number(b, "hits") == 11.0);
+
+    // Touching the file without changing it is not a reload.
+    Write(path, kVersion2);
+    r.engine.Update(kFrame);
+    GV_CHECK(r.reloaded.size() == 1 && r.failed.empty());
+}
+
+} // namespace
+
+GV_TEST(EditSwapsOnTheNextFrameWithInotify) {
+    SwapsOnTheNextFrame(false);
+}
+
+GV_TEST(EditSwapsOnTheNextFrameWhenPolling) {
+    SwapsOnTheNextFrame(true);
+}
+
+GV_TEST(CompileErrorKeepsTheOldVersion) {
+    TempDir dir("gv_hot_reload_errors");
+    const std::string path = dir.File("door.gvs");
+    Write(path,
+        "var opened = 0;\n"
+        "var seen = 0;\n"
+        "func on_version() { seen = 1; }\n"
+        "func open() { opened = opened + 1; }\n");
+    Reloading r(false);
+    const u32 id = r.engine.CreateInstance(path, "", nullptr);
+    r.engine.CallInstance(id, "open");
+    r.engine.CallInstance(id, "open");
+
+    // A syntax error: reported, and nothing about the instance changes.
+    Write(path, "var opened = 0;\nvar seen = 0;\nfunc on_version() { seen = 2; }\nfunc open() { opened = ; }\n");
+    r.engine.Update(kFrame);
+    GV_CHECK(r.failed.size() == 1 && r.reloaded.empty());
+    GV_CHECK(r.failed[0].find("door.gvs") != std::string::npos);
+    GV_CHECK(r.engine.GetLastError().find("keeping the old version") != std::string::npos);
+    GV_CHECK(VersionOf(r.engine, id) == 1.0);
+    GV_CHECK(r.engine.CallInstance(id, "open"));
+    GV_CHECK(r.Number(id, "opened") == 3.0);
+
+    // A fault in the top-level code (here the sandbox's instruction limit)
+    // rolls back just the same.
+    Write(path, "var opened = 0;\nvar seen = 0;\nfunc on_version() { seen = 3; }\nwhile true { }\n");
+    r.engine.Update(kFrame);
+    GV_CHECK(r.failed.size() == 2 && r.reloaded.empty());
+    GV_CHECK(VersionOf(r.engine, id) == 1.0);
+    GV_CHECK(r.engine.CallInstance(id, "open"));
+    GV_CHECK(r.Number(id, "opened") == 4.0);
+
+    // Fixed, saved by rename: it goes live with the state intact.
+    WriteByRename(path,
+        "var opened = 0;\n"
+        "var seen = 0;\n"
+        "func on_version() { seen = 4; }\n"
+        "func open() { opened = opened + 100; }\n");
+    r.engine.Update(kFrame);
+    GV_CHECK(r.reloaded.size() == 1);
+    GV_CHECK(VersionOf(r.engine, id) == 4.0);
+    r.engine.CallInstance(id, "open");
+    GV_CHECK(r.Number(id, "opened") == 104.0);
+}
+
+GV_TEST(DroppedAndRetypedVarsTakeTheNewVersion) {
+    TempDir dir("gv_hot_reload_types");
+    const std::string path = dir.File("npc.gvs");
+    Write(path, "var mood = 5;\nvar name = \"bob\";\nvar legacy = 1;\nfunc tick() { mood = mood + 1; }\n");
+    Reloading r(false);
+    const u32 id = r.engine.CreateInstance(path, "", nullptr);
+    r.engine.CallInstance(id, "tick");
+
+    Write(path, "var mood = \"calm\";\nvar name = nil;\nfunc tick() { }\n");
+    r.engine.Update(kFrame);
+    GV_CHECK(r.reloaded.size() == 1);
+    GV_CHECK(r.engine.GetInstanceVariable(id, "mood").AsString() == "calm");   // type changed
+    GV_CHECK(r.engine.GetInstanceVariable(id, "name").AsString() == "bob");    // nil keeps the old value
+    GV_CHECK(r.engine.GetInstanceVariable(id, "legacy").IsNil());              // no longer declared
+}
+
+GV_TEST_MAIN()
@@ -0,0 +1,176 @@
+// ============================================================================
+// GameVoid Engine — Impostor Tests
+// ============================================================================
+// The view-direction mappings behind the atlas layout: a direction encoded
+// to a cell and decoded back must be the direction the baker rendered.
+// ============================================================================
+#include "TestHarness.h"
+#include "renderer/Impostor.h"
+#include <cmath>
+#include <vector>
+
+using namespace gv;
+
+namespace {
+
+/// Evenly spread unit directions (Fibonacci sphere), plus the axes and the
+/// octahedron's edges, where the folds are.
+std::vector<Vec3> Directions(u32 count) {
+    std::vector<Vec3> dirs;
+    const f32 golden = 2.39996323f;
+    for (u32 i = 0; i < count; ++i) {
+        const f32 y = 1.0f - 2.0f * (f32(i) + 0.5f) / f32(count);
+        const f32 r = std::sqrt(std::max(0.0f, 1.0f - y * y));
+        dirs.push_back(Vec3(r * std::cos(golden * f32(i)), y, r * std::sin(golden * f32(i))));
+    }
+    for (f32 s : { -1.0f, 1.0f }) {
+        dirs.push_back(Vec3(s, 0, 0));
+        dirs.push_back(Vec3(0, s, 0));
+        dirs.push_back(Vec3(0, 0, s));
+        dirs.push_back(Vec3(s, 0, s).Normalized());
+        dirs.push_back(Vec3(s, 0, -s).Normalized());
+        dirs.push_back(Vec3(s, s, 0).Normalized());
+        dirs.push_back(Vec3(0, s, s).Normalized());
+    }
+    return dirs;
+}
+
+f32 Distance(const Vec3& a, const Vec3& b) { return (a - b).Length(); }
+
+bool InUnitSquare(const Vec2& uv) { return uv.x >= 0.0f && uv.x <= 1.0f && uv.y >= 0.0f && uv.y <= 1.0f; }
+
+} // namespace
+
+GV_TEST(OctahedralRoundTripsTheWholeSphere) {
+    f32 worst = 0.0f;
+    bool inSquare = true;
+    for (const Vec3& d : Directions(4096)) {
+        const Vec2 uv = OctahedralEncode(d);
+        inSquare &= InUnitSquare(uv);
+        worst = std::max(worst, Distance(OctahedralDecode(uv), d));
+    }
+    GV_CHECK(inSquare);
+    GV_CHECK(worst < 1e-5f);
+
+    // Length doesn't matter, and the poles land where the layout says.
+    GV_CHECK(Distance(OctahedralDecode(OctahedralEncode(Vec3(3, 4, -12))), Vec3(3, 4, -12).Normalized()) < 1e-5f);
+    GV_CHECK_NEAR(OctahedralEncode(Vec3(0, 1, 0)).x, 0.5, 1e-6);
+    GV_CHECK_NEAR(OctahedralEncode(Vec3(0, 1, 0)).y, 0.5, 1e-6);
+    GV_CHECK(Distance(OctahedralDecode(Vec2(0.5f, 0.5f)), Vec3(0, 1, 0)) < 1e-6f);
+    // The lower pole folds into all four corners.
+    for (const Vec2 corner : { Vec2(0, 0), Vec2(1, 0), Vec2(0, 1), Vec2(1, 1) })
+        GV_CHECK(Distance(OctahedralDecode(corner), Vec3(0, -1, 0)) < 1e-6f);
+}
+
+GV_TEST(HemiOctahedralRoundTripsTheUpperHalf) {
+    f32 worst = 0.0f, worstClamp = 0.0f;
+    bool inSquare = true;
+    for (const Vec3& d : Directions(4096)) {
+        const Vec2 uv = HemiOctahedralEncode(d);
+        inSquare &= InUnitSquare(uv);
+        const Vec3 back = HemiOctahedralDecode(uv);
+        if (d.y >= 0.0f) {
+            worst = std::max(worst, Distance(back, d));
+        } else if (std::fabs(d.x) + std::fabs(d.z) > 1e-3f) {
+            // Below the horizon: the same heading, on the horizon.
+            worstClamp = std::max(worstClamp, Distance(back, Vec3(d.x, 0, d.z).Normalized()));
+        }
+    }
+    GV_CHECK(inSquare);
+    GV_CHECK(worst < 1e-5f);
+    GV_CHECK(worstClamp < 1e-5f);
+
+    // The zenith is the centre and the horizon's four headings are the
+    // square's corners.
+    GV_CHECK(Distance(HemiOctahedralDecode(Vec2(0.5f, 0.5f)), Vec3(0, 1, 0)) < 1e-6f);
+    const Vec3 corners[4] = { HemiOctahedralDecode(Vec2(0, 0)), HemiOctahedralDecode(Vec2(1, 0)),
+                              HemiOctahedralDecode(Vec2(0, 1)), HemiOctahedralDecode(Vec2(1, 1)) };
+    for (const Vec3& c : corners) GV_CHECK(std::fabs(c.y) < 1e-6f && std::fabs(c.Length() - 1.0f) < 1e-6f);
+    GV_CHECK(Distance(corners[0], Vec3(0, 0, -1)) < 1e-6f && Distance(corners[3], Vec3(0, 0, 1)) < 1e-6f);
+    GV_CHECK(Distance(corners[1], Vec3(1, 0, 0)) < 1e-6f && Distance(corners[2], Vec3(-1, 0, 0)) < 1e-6f);
+}
+
+GV_TEST(FramesMapBackToTheirOwnCell) {
+    for (bool hemisphere : { true, false }) {
+        ImpostorSettings settings;
+        settings.hemisphere = hemisphere;
+        settings.framesPerSide = 9;
+        bool exact = true, own = true;
+        for (u32 y = 0; y < settings.framesPerSide; ++y)
+            for (u32 x = 0; x < settings.framesPerSide; ++x) {
+                // The direction a cell was baked from selects only cells
+                // baked from that same direction.  The whole sphere's border
+                // folds onto itself, so (x, 0) and (N-1-x, 0) are one view.
+                const Vec3 dir = ImpostorFrameDirection(settings, x, y);
+                const ImpostorFrameBlend b = ImpostorFramesForDirection(settings, dir);
+                f32 weight = 0.0f, self = 0.0f;
+                for (int k = 0; k < 4; ++k) {
+                    if (b.weight[k] < 1e-4f) continue;              // rounding leftovers
+                    weight += b.weight[k];
+                    exact &= Distance(ImpostorFrameDirection(settings, b.x[k], b.y[k]), dir) < 1e-5f;
+                    if (b.x[k] == x && b.y[k] == y) self += b.weight[k];
+                }
+                exact &= std::fabs(weight - 1.0f) < 1e-4f;
+                const bool border = x == 0 || y == 0 || x + 1 == settings.framesPerSide || y + 1 == settings.framesPerSide;
+                if (hemisphere || !border) own &= std::fabs(self - 1.0f) < 1e-4f;
+            }
+        GV_CHECK(exact);
+        GV_CHECK(own);
+    }
+}
+
+GV_TEST(BlendsPickTheSurroundingCells) {
+    for (bool hemisphere : { true, false }) {
+        ImpostorSettings settings;
+        settings.hemisphere = hemisphere;
+        settings.framesPerSide = 8;
+        const f32 last = f32(settings.framesPerSide - 1);
+        bool normalised = true, surrounding = true, inGrid = true;
+        for (const Vec3& d : Directions(2048)) {
+            if (hemisphere && d.y < 0.0f) continue;
+            const ImpostorFrameBlend b = ImpostorFramesForDirection(settings, d);
+            f32 sum = 0.0f;
+            Vec2 at(0, 0);
+            for (int k = 0; k < 4; ++k) {
+                inGrid &= b.x[k] < settings.framesPerSide && b.y[k] < settings.framesPerSide && b.weight[k] >= 0.0f;
+                sum += b.weight[k];
+                at = at + Vec2(f32(b.x[k]), f32(b.y[k])) * b.weight[k];
+            }
+            normalised &= std::fabs(sum - 1.0f) < 1e-5f;
+            // The weights interpolate the cell grid back to the encoded uv.
+            const Vec2 uv = hemisphere ? HemiOctahedralEncode(d) : OctahedralEncode(d);
+            surrounding &= std::fabs(at.x - uv.x * last) < 1e-3f && std::fabs(at.y - uv.y * last) < 1e-3f;
+        }
+        GV_CHECK(inGrid);
+        GV_CHECK(normalised);
+        GV_CHECK(surrounding);
+    }
+
+    // One frame: everything uses cell 0, which looks straight down on it.
+    ImpostorSettings single;
+    single.framesPerSide = 1;
+    const ImpostorFrameBlend b = ImpostorFramesForDirection(single, Vec3(1, 0, 0));
+    GV_CHECK(b.x[0] == 0 && b.y[0] == 0 && b.weight[0] == 1.0f);
+    GV_CHECK(Distance(ImpostorFrameDirection(single, 0, 0), Vec3(0, 1, 0)) < 1e-6f);
+}
+
+GV_TEST(BasisIsOrthonormalFacingTheViewer) {
+    bool orthonormal = true;
+    for (const Vec3& d : Directions(512)) {
+        Vec3 right, up;
+        ImpostorBasis(d, right, up);
+        orthonormal &= std::fabs(right.Length() - 1.0f) < 1e-4f && std::fabs(up.Length() - 1.0f) < 1e-4f;
+        orthonormal &= std::fabs(right.Dot(up)) < 1e-4f && std::fabs(right.Dot(d)) < 1e-4f && std::fabs(up.Dot(d)) < 1e-4f;
+        // Right-handed: right × up points at the viewer.
+        orthonormal &= Distance(right.Cross(up), d) < 1e-4f;
+    }
+    GV_CHECK(orthonormal);
+
+    Vec3 right, up;
+    ImpostorBasis(Vec3(0, 0, 1), right, up);
+    GV_CHECK(Distance(up, Vec3(0, 1, 0)) < 1e-6f && Distance(right, Vec3(1, 0, 0)) < 1e-6f);
+    ImpostorBasis(Vec3(0, 1, 0), right, up);
+    GV_CHECK(Distance(up, Vec3(0, 0, -1)) < 1e-6f);
+}
+
+GV_TEST_MAIN()
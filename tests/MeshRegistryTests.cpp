@@ -0,0 +1,142 @@
+// ============================================================================
+// GameVoid Engine — Shared Mesh Registry Tests
+// ============================================================================
+// Runs against NullMeshBufferBackend, which hands out buffer names without a
+// GL context and counts how many meshes have live GPU buffers.
+// ============================================================================
+#include "TestHarness.h"
+#include "assets/MeshRegistry.h"
+#include "core/Scene.h"
+#include "geometry/MeshBuilder.h"
+#include "renderer/MeshRenderer.h"
+#include "shapes/ShapeLibrary.h"
+
+using namespace gv;
+
+namespace {
+
+/// Installs a null backend for the lifetime of one test.  Declare it before
+/// anything that owns meshes so it outlives them.
+struct NullBuffers {
+    NullMeshBufferBackend backend;
+    NullBuffers()  { Mesh::SetBufferBackend(&backend); }
+    ~NullBuffers() { Mesh::SetBufferBackend(nullptr); }
+};
+
+MeshData Crate() {
+    return MeshBuilder()
+        .AddPrimitive(Primitives::Box(0.5f, 0.5f, 0.5f), Vec3(0, 0.5f, 0))
+        .AddPrimitive(Primitives::Box(0.55f, 0.05f, 0.55f), Vec3(0, 1.0f, 0))
+        .Build("Crate");
+}
+
+} // namespace
+
+GV_TEST(IdenticalObjectsShareOneGpuMesh) {
+    NullBuffers gpu;
+    MeshRegistry registry;
+    Scene scene;
+    const u32 kObjects = 5000;
+    const MeshData crate = Crate();
+    for (u32 i = 0; i < kObjects; ++i) {
+        auto* mr = scene.CreateGameObject("crate")->AddComponent<MeshRenderer>();
+        mr->SetMeshData(crate, registry);
+        auto* marker = scene.CreateGameObject("marker")->AddComponent<MeshRenderer>();
+        marker->SetPrimitive(PrimitiveType::Cube, registry);
+    }
+    GV_CHECK(gpu.backend.GetLiveMeshes() == 2);
+    GV_CHECK(gpu.backend.GetUploads() == 2);
+
+    MeshRegistryStats stats = registry.GetStats();
+    GV_CHECK(stats.entries == 2 && stats.referenced == 2);
+    GV_CHECK(stats.misses == 2);
+    GV_CHECK(stats.hits == 2 * (kObjects - 1));
+    GV_CHECK(stats.gpuBytes == gpu.backend.GetLiveBytes());
+    GV_CHECK(registry.GetRefCount("Mesh::CreateCube()") == static_cast<i32>(kObjects));
+
+    // Any other route to the same primitive lands on the same mesh.
+    GV_CHECK(registry.Primitive(PrimitiveType::Cube) == registry.Cube());
+    GV_CHECK(registry.Primitive(PrimitiveType::None) == nullptr);
+    GV_CHECK(gpu.backend.GetLiveMeshes() == 2);
+}
+
+GV_TEST(GeneratedShapesAreKeyedByParameters) {
+    NullBuffers gpu;
+    MeshRegistry registry;
+    Shared<Mesh> a = registry.Generate("Primitives::Box", &Primitives::Box, 0.5, 0.5, 0.5, 0);
+    Shared<Mesh> b = registry.Generate("Primitives::Box", &Primitives::Box, 0.5f, 0.5f, 0.5f, 0);
+    Shared<Mesh> c = registry.Generate("Primitives::Box", &Primitives::Box, 0.5f, 1.0f, 0.5f, 0);
+    GV_CHECK(a && a == b);                 // 0.5 and 0.5f convert to the same key
+    GV_CHECK(c && c != a);
+
+    Shared<Mesh> chair = Shapes::Acquire(registry, "Chair");
+    GV_CHECK(chair && chair == Shapes::Acquire(registry, "Chair"));
+    GV_CHECK(Shapes::Acquire(registry, "NoSuchShape") == nullptr);
+
+    // Same geometry from a builder under another name is still one mesh;
+    // different geometry is not.
+    MeshBuilder builder;
+    builder.AddPrimitive(Primitives::Box(0.5f, 0.5f, 0.5f), Vec3(0, 0.5f, 0))
+           .AddPrimitive(Primitives::Box(0.55f, 0.05f, 0.55f), Vec3(0, 1.0f, 0));
+    Shared<Mesh> crate = registry.AcquireData(Crate());
+    GV_CHECK(registry.AcquireBuilt(builder, "OtherName") == crate);
+    MeshData moved = Crate();
+    moved.vertices[0].position.x += 0.001f;
+    GV_CHECK(registry.AcquireData(moved) != crate);
+
+    GV_CHECK(gpu.backend.GetLiveMeshes() == 5);
+}
+
+GV_TEST(ReleasedMeshesStayCachedUntilEvicted) {
+    NullBuffers gpu;
+    MeshRegistry registry;
+    Scene scene;
+    std::vector<GameObject*> objects;
+    for (int i = 0; i < 10; ++i) {
+        GameObject* obj = scene.CreateGameObject("wall");
+        obj->AddComponent<MeshRenderer>()->SetPrimitive(PrimitiveType::Plane, registry);
+        objects.push_back(obj);
+    }
+    const std::string key = MeshRegistry::MakeKey("Mesh::CreatePlane", 1.0f, 1.0f);
+    GV_CHECK(registry.GetRefCount(key) == 10);
+
+    objects[0]->GetComponent<MeshRenderer>()->ReleaseMesh();
+    GV_CHECK(registry.GetRefCount(key) == 9);
+    for (GameObject* obj : objects) scene.DestroyGameObject(obj);
+    scene.FlushDestroyQueue();
+    GV_CHECK(registry.GetRefCount(key) == 0);
+
+    // Unreferenced but within budget: kept, buffers still alive.
+    GV_CHECK(gpu.backend.GetLiveMeshes() == 1);
+    GV_CHECK(registry.GetStats().cachedBytes > 0);
+    Shared<Mesh> again = registry.Primitive(PrimitiveType::Plane);
+    GV_CHECK(gpu.backend.GetUploads() == 1);
+    again.reset();
+
+    GV_CHECK(registry.EvictUnreferenced() == 1);
+    GV_CHECK(gpu.backend.GetLiveMeshes() == 0);
+    GV_CHECK(gpu.backend.GetReleases() == 1);
+    GV_CHECK(registry.GetRefCount(key) == -1);
+}
+
+GV_TEST(BudgetTrimsLeastRecentlyUsedFirst) {
+    NullBuffers gpu;
+    MeshRegistry registry;
+    registry.SetCacheBudget(0);
+    Shared<Mesh> held = registry.Cube();
+    registry.Sphere(8, 4);                 // dropped as soon as it is unreferenced
+    registry.Triangle();                   // inserting trims the sphere
+    GV_CHECK(registry.Contains("Mesh::CreateCube()"));
+    GV_CHECK(!registry.Contains(MeshRegistry::MakeKey("Mesh::CreateSphere", 8u, 4u)));
+    GV_CHECK(registry.Trim() == 1);        // the triangle
+    GV_CHECK(gpu.backend.GetLiveMeshes() == 1);
+    GV_CHECK(registry.GetStats().evictions == 2);
+
+    // Clear() forgets entries; meshes held elsewhere keep their buffers.
+    registry.Clear();
+    GV_CHECK(gpu.backend.GetLiveMeshes() == 1);
+    held.reset();
+    GV_CHECK(gpu.backend.GetLiveMeshes() == 0);
+}
+
+GV_TEST_MAIN()
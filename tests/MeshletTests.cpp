@@ -0,0 +1,151 @@
+// ============================================================================
+// GameVoid Engine — Meshlet Build and Culling Tests
+// ============================================================================
+#include "TestHarness.h"
+#include "assets/Assets.h"
+#include "assets/Meshlet.h"
+#include "geometry/Primitives.h"
+#include "renderer/MeshletCulling.h"
+#include <algorithm>
+#include <array>
+#include <vector>
+
+using namespace gv;
+
+namespace {
+
+struct Built {
+    MeshData         mesh;
+    MeshletData      meshlets;
+    std::vector<u32> indices;
+};
+
+Built Build(MeshData mesh, const MeshletBuildSettings& settings = MeshletBuildSettings()) {
+    Built b;
+    b.mesh = std::move(mesh);
+    BuildMeshlets(b.mesh.indices, &b.mesh.vertices[0].position.x, b.mesh.vertices.size(),
+                  sizeof(Vertex3D), b.meshlets, b.indices, settings);
+    return b;
+}
+
+std::vector<std::array<u32, 3>> SortedTriangles(const std::vector<u32>& indices) {
+    std::vector<std::array<u32, 3>> tris;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        std::array<u32, 3> t = { indices[i], indices[i + 1], indices[i + 2] };
+        std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());   // keep winding
+        tris.push_back(t);
+    }
+    std::sort(tris.begin(), tris.end());
+    return tris;
+}
+
+/// Primitives::Plane winds clockwise seen from +Y; flip it to match its
+/// normals.
+MeshData Floor(int segments) {
+    MeshData floor = Primitives::Plane(10.0f, 10.0f, segments, segments);
+    for (size_t i = 0; i + 2 < floor.indices.size(); i += 3) std::swap(floor.indices[i + 1], floor.indices[i + 2]);
+    return floor;
+}
+
+Frustum Camera(const Vec3& eye, const Vec3& target) {
+    Frustum f;
+    f.ExtractFromVP(Mat4::Perspective(1.0f, 1.0f, 0.1f, 100.0f) * Mat4::LookAt(eye, target, Vec3(0, 1, 0)));
+    return f;
+}
+
+} // namespace
+
+GV_TEST(MeshletsCoverEveryTriangleOnce) {
+    MeshletBuildSettings settings;
+    settings.maxVertices = 32;
+    settings.maxTriangles = 40;
+    Built b = Build(Primitives::Sphere(1.0f, 24, 24), settings);
+    GV_CHECK(b.meshlets.meshlets.size() > 1);
+    GV_CHECK(SortedTriangles(b.indices) == SortedTriangles(b.mesh.indices));
+
+    bool consistent = true, bounded = true;
+    u32 next = 0;
+    for (const Meshlet& m : b.meshlets.meshlets) {
+        consistent &= m.vertexCount <= 32 && m.triangleCount <= 40 && m.triangleCount > 0;
+        consistent &= m.firstIndex == next && m.indexCount == m.triangleCount * 3;
+        next += m.indexCount;
+        for (u32 t = 0; t < m.triangleCount; ++t)
+            for (u32 k = 0; k < 3; ++k) {
+                const u8 local = b.meshlets.triangles[(m.triangleOffset + t) * 3 + k];
+                const u32 vertex = b.meshlets.vertices[m.vertexOffset + local];
+                consistent &= local < m.vertexCount && b.indices[m.firstIndex + t * 3 + k] == vertex;
+                bounded &= (b.mesh.vertices[vertex].position - m.center).Length() <= m.radius + 1e-4f;
+            }
+    }
+    GV_CHECK(consistent);
+    GV_CHECK(bounded);
+    GV_CHECK(next == b.indices.size());
+}
+
+GV_TEST(OutOfRangeTrianglesAreDropped) {
+    MeshData quad = Primitives::Plane(1.0f, 1.0f, 1, 1);
+    const size_t good = quad.indices.size();
+    quad.indices.insert(quad.indices.end(), { 0, 1, 999 });
+    Built b = Build(quad);
+    GV_CHECK(b.indices.size() == good);
+    GV_CHECK(b.meshlets.meshlets.size() == 1);
+}
+
+GV_TEST(CullingRejectsHiddenAndBackfacingMeshlets) {
+    // A flat, finely divided floor facing +Y: every meshlet has a tight cone.
+    Built floor = Build(Floor(32));
+    const Mat4 identity = Mat4::Identity();
+    MeshletDrawList list;
+    MeshletCullStats stats;
+    const u32 total = static_cast<u32>(floor.meshlets.meshlets.size());
+
+    u32 visible = CullMeshlets(floor.meshlets, identity, Camera(Vec3(0, 10, 0.01f), Vec3(0, 0, 0)),
+                               Vec3(0, 10, 0.01f), list, MeshletCullSettings(), &stats);
+    GV_CHECK(visible == total);
+    GV_CHECK(list.counts.size() == 1);                  // everything merges into one range
+    GV_CHECK(stats.indicesDrawn == floor.indices.size());
+
+    visible = CullMeshlets(floor.meshlets, identity, Camera(Vec3(0, -10, 0.01f), Vec3(0, 0, 0)),
+                           Vec3(0, -10, 0.01f), list, MeshletCullSettings(), &stats);
+    GV_CHECK(visible == 0 && list.Empty());
+    GV_CHECK(stats.backfaceCulled == total);
+
+    // Looking away: frustum culled; an occlusion callback hides the rest.
+    stats.Reset();
+    visible = CullMeshlets(floor.meshlets, identity, Camera(Vec3(0, 10, 0), Vec3(0, 20, 0.01f)),
+                           Vec3(0, 10, 0), list, MeshletCullSettings(), &stats);
+    GV_CHECK(visible == 0 && stats.frustumCulled == total);
+
+    MeshletCullSettings occluded;
+    occluded.occlusion = [](const Vec3& center, f32) { return center.x < 0.0f; };
+    stats.Reset();
+    visible = CullMeshlets(floor.meshlets, identity, Camera(Vec3(0, 10, 0.01f), Vec3(0, 0, 0)),
+                           Vec3(0, 10, 0.01f), list, occluded, &stats);
+    GV_CHECK(visible > 0 && visible < total);
+    GV_CHECK(stats.occlusionCulled + visible == total);
+}
+
+GV_TEST(MeshesWoundAgainstTheirNormalsAreNeverBackfaceCulled) {
+    NullMeshBufferBackend gpu;
+    Mesh::SetBufferBackend(&gpu);
+    const u32 minTriangles = Mesh::GetMeshletMinTriangles();
+    Mesh::SetMeshletMinTriangles(1);
+    auto cullable = [](const MeshData& data) {
+        std::vector<Vertex> vertices(data.vertices.size());
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            vertices[i].position = data.vertices[i].position;
+            vertices[i].normal   = data.vertices[i].normal;
+        }
+        Mesh mesh;
+        mesh.Build(vertices, data.indices);
+        u32 count = 0;
+        for (const Meshlet& m : mesh.GetMeshlets().meshlets) count += m.coneCutoff < 1.0f;
+        return count;
+    };
+    GV_CHECK(cullable(Floor(16)) > 0);
+    GV_CHECK(cullable(Primitives::Plane(10.0f, 10.0f, 16, 16)) == 0);
+    Mesh::SetMeshletMinTriangles(minTriangles);
+    Mesh::SetBufferBackend(nullptr);
+}
+
+GV_TEST_MAIN()
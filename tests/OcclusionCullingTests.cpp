@@ -0,0 +1,225 @@
+// ============================================================================
+// GameVoid Engine — Occlusion Culling Tests
+// ============================================================================
+// Synthetic scenes of box occluders.  Every box the buffer reports hidden is
+// re-checked by casting rays through its screen rectangle against the
+// occluders themselves, so a wrong cull fails the test.
+// ============================================================================
+#include "TestHarness.h"
+#include "renderer/OcclusionCulling.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace gv;
+
+namespace {
+
+struct Box { Vec3 min, max; };
+
+/// A pinhole camera matching the buffer's projection.
+struct Camera {
+    Vec3 eye, forward, right, up;
+    f32  fov = 1.0f, aspect = 2.0f, nearZ = 0.1f, farZ = 500.0f;
+
+    Camera(const Vec3& from, const Vec3& to) : eye(from) {
+        forward = (to - from).Normalized();
+        right   = forward.Cross(Vec3(0, 1, 0)).Normalized();
+        up      = right.Cross(forward);
+    }
+    Mat4 ViewProj() const {
+        return Mat4::Perspective(fov, aspect, nearZ, farZ) * Mat4::LookAt(eye, eye + forward, Vec3(0, 1, 0));
+    }
+    f32 Depth(const Vec3& p) const { return (p - eye).Dot(forward); }
+};
+
+/// Distance along `dir` to the first hit of an occluder, or infinity.
+f32 CastRay(const Vec3& origin, const Vec3& dir, const std::vector<Box>& occluders) {
+    f32 best = INFINITY;
+    for (const Box& b : occluders) {
+        f32 t0 = 0.0f, t1 = best;
+        const f32 o[3] = { origin.x, origin.y, origin.z }, d[3] = { dir.x, dir.y, dir.z };
+        const f32 lo[3] = { b.min.x, b.min.y, b.min.z }, hi[3] = { b.max.x, b.max.y, b.max.z };
+        for (int a = 0; a < 3 && t0 <= t1; ++a) {
+            if (std::fabs(d[a]) < 1e-12f) {
+                if (o[a] < lo[a] || o[a] > hi[a]) t0 = INFINITY;
+                continue;
+            }
+            f32 n = (lo[a] - o[a]) / d[a], f = (hi[a] - o[a]) / d[a];
+            if (n > f) std::swap(n, f);
+            t0 = std::max(t0, n);
+            t1 = std::min(t1, f);
+        }
+        if (t0 <= t1) best = t0;
+    }
+    return best;
+}
+
+/// True if rays through a 4×4 grid per pixel of the box's screen rectangle
+/// all hit an occluder in front of the box's nearest point.
+bool ReallyHidden(const Camera& cam, const OcclusionBuffer& buffer, const Box& box, const std::vector<Box>& occluders) {
+    const Mat4 vp = cam.ViewProj();
+    const f32 hw = 0.5f * f32(buffer.GetLevelWidth(0)), hh = 0.5f * f32(buffer.GetLevelHeight(0));
+    f32 xMin = 1e30f, yMin = 1e30f, xMax = -1e30f, yMax = -1e30f, nearest = 1e30f;
+    for (u32 c = 0; c < 8; ++c) {
+        const Vec3 p((c & 1) ? box.max.x : box.min.x, (c & 2) ? box.max.y : box.min.y, (c & 4) ? box.max.z : box.min.z);
+        if (cam.Depth(p) <= cam.nearZ) return false;
+        const Vec3 ndc = vp.TransformPoint(p);
+        xMin = std::min(xMin, (ndc.x + 1.0f) * hw); xMax = std::max(xMax, (ndc.x + 1.0f) * hw);
+        yMin = std::min(yMin, (ndc.y + 1.0f) * hh); yMax = std::max(yMax, (ndc.y + 1.0f) * hh);
+        nearest = std::min(nearest, cam.Depth(p));
+    }
+    xMin = std::max(xMin, 0.0f); xMax = std::min(xMax, 2.0f * hw);
+    yMin = std::max(yMin, 0.0f); yMax = std::min(yMax, 2.0f * hh);
+    const f32 tanHalf = std::tan(0.5f * cam.fov);
+    for (f32 sy = std::floor(yMin) + 0.125f; sy < yMax; sy += 0.25f)
+        for (f32 sx = std::floor(xMin) + 0.125f; sx < xMax; sx += 0.25f) {
+            const f32 nx = sx / hw - 1.0f, ny = sy / hh - 1.0f;
+            const Vec3 dir = cam.forward + cam.right * (nx * tanHalf * cam.aspect) + cam.up * (ny * tanHalf);
+            if (!(CastRay(cam.eye, dir, occluders) < nearest)) return false;   // depth along dir is t
+        }
+    return true;
+}
+
+/// City blocks on a grid with props scattered through the streets.
+struct City {
+    std::vector<Box> buildings, props;
+
+    explicit City(u32 seed, int blocks = 12, u32 propCount = 3000) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<f32> height(6.0f, 40.0f), unit(0.0f, 1.0f);
+        const f32 pitch = 20.0f, size = 14.0f;        // 6 m streets
+        for (int i = 0; i < blocks; ++i)
+            for (int j = 0; j < blocks; ++j) {
+                const Vec3 lo(f32(i) * pitch, 0.0f, -f32(j) * pitch - size);
+                buildings.push_back({ lo, lo + Vec3(size, height(rng), size) });
+            }
+        const f32 extent = f32(blocks) * pitch;
+        while (props.size() < propCount) {
+            const Vec3 at(unit(rng) * extent, 0.0f, -unit(rng) * extent);
+            const f32 s = 0.3f + 1.5f * unit(rng);
+            Box b{ at, at + Vec3(s, s, s) };
+            bool inside = false;
+            for (const Box& o : buildings)
+                inside |= b.max.x > o.min.x && b.min.x < o.max.x && b.max.z > o.min.z && b.min.z < o.max.z;
+            if (!inside) props.push_back(b);
+        }
+    }
+};
+
+/// Rasterizes `occluders` and tests every prop.  Returns the hidden flags.
+std::vector<bool> Cull(OcclusionBuffer& buffer, const Camera& cam, const std::vector<Box>& occluders,
+                       const std::vector<Box>& props) {
+    buffer.BeginFrame(cam.ViewProj());
+    for (const Box& b : occluders) buffer.AddOccluderBox(b.min, b.max, Mat4::Identity());
+    buffer.Rasterize();
+    std::vector<bool> hidden;
+    for (const Box& b : props) hidden.push_back(buffer.IsBoxOccluded(b.min, b.max, Mat4::Identity()));
+    return hidden;
+}
+
+} // namespace
+
+GV_TEST(WallHidesWhatIsWhollyBehindIt) {
+    const Camera cam(Vec3(0, 2, 0), Vec3(0, 2, -1));
+    const std::vector<Box> wall = { { Vec3(-5, 0, -10.5f), Vec3(5, 5, -10) } };
+    const std::vector<Box> props = {
+        { Vec3(-1, 1, -21), Vec3(1, 3, -19) },            // 0 behind the middle
+        { Vec3(7, 1, -21), Vec3(9, 3, -19) },             // 1 beside it
+        { Vec3(-1, 1, -6), Vec3(1, 3, -4) },              // 2 in front
+        { Vec3(-12, 0, -31), Vec3(12, 8, -29) },          // 3 behind, but wider than it
+        { Vec3(-1, 1, -0.5f), Vec3(1, 3, 0.5f) },         // 4 across the near plane
+        { Vec3(-1, 1, -10.4f), Vec3(1, 3, -9.9f) },       // 5 poking out of its face
+        { Vec3(-1, 9, -21), Vec3(1, 10, -19) },           // 6 behind, above the top edge
+    };
+    OcclusionBuffer buffer;
+    const std::vector<bool> hidden = Cull(buffer, cam, wall, props);
+    GV_CHECK(hidden[0]);
+    GV_CHECK(!hidden[1] && !hidden[2] && !hidden[3] && !hidden[4] && !hidden[5]);
+    GV_CHECK(!hidden[6]);
+    GV_CHECK(ReallyHidden(cam, buffer, props[0], wall));
+
+    const OcclusionStats& stats = buffer.GetStats();
+    GV_CHECK(stats.occluders == 1 && stats.tested == 7 && stats.occluded == 1);
+    GV_CHECK(stats.trianglesIn == 12 && stats.trianglesRasterized > 0 && stats.trianglesRasterized <= 6);
+    GV_CHECK(buffer.IsSphereOccluded(Vec3(0, 2, -30), 1.0f));
+    GV_CHECK(!buffer.IsSphereOccluded(Vec3(0, 2, -30), 8.0f));
+}
+
+GV_TEST(SlitsBetweenOccludersStayOpen) {
+    const Camera cam(Vec3(0, 2, 0), Vec3(0, 2, -1));
+    // Two walls a few centimetres apart, far less than a buffer pixel.
+    const std::vector<Box> walls = { { Vec3(-6, 0, -10.5f), Vec3(-0.02f, 5, -10) },
+                                     { Vec3(0.02f, 0, -10.5f), Vec3(6, 5, -10) } };
+    const std::vector<Box> props = { { Vec3(-0.01f, 1, -40), Vec3(0.01f, 3, -39.9f) },
+                                     { Vec3(-3, 1, -40), Vec3(-2, 3, -39) } };
+    OcclusionBuffer buffer;
+    const std::vector<bool> hidden = Cull(buffer, cam, walls, props);
+    GV_CHECK(!hidden[0]);
+    GV_CHECK(hidden[1]);
+
+    // Within one occluder a shared edge leaves no crack: the wall's front
+    // diagonal runs straight across the pole.
+    const std::vector<Box> whole = { { Vec3(-6, 0, -10.5f), Vec3(6, 4, -10) } };
+    GV_CHECK(Cull(buffer, cam, whole, props)[0]);
+}
+
+GV_TEST(CityCullsAreConservativeAndDeterministic) {
+    const City city(11);
+    const Camera views[] = {
+        Camera(Vec3(17, 1.7f, 3), Vec3(17, 1.7f, -100)),           // down a street
+        Camera(Vec3(-5, 1.7f, 5), Vec3(120, 1.7f, -120)),          // across the blocks
+        Camera(Vec3(60, 60, 20), Vec3(120, 0, -120)),              // from above
+    };
+    OcclusionSettings single;
+    single.threads = 1;
+    OcclusionSettings banded;
+    banded.threads = 4;
+    OcclusionBuffer one(single), four(banded);
+
+    u32 hiddenTotal = 0;
+    bool conservative = true, sameAcrossThreads = true, repeatable = true;
+    for (const Camera& cam : views) {
+        const std::vector<bool> hidden = Cull(one, cam, city.buildings, city.props);
+        for (size_t i = 0; i < hidden.size(); ++i)
+            if (hidden[i]) { ++hiddenTotal; conservative &= ReallyHidden(cam, one, city.props[i], city.buildings); }
+
+        sameAcrossThreads &= Cull(four, cam, city.buildings, city.props) == hidden;
+        for (u32 level = 0; level < one.GetLevelCount(); ++level)
+            sameAcrossThreads &= one.GetDepth(level) == four.GetDepth(level);
+        const std::vector<f32> depth = one.GetDepth(0);
+        repeatable &= Cull(one, cam, city.buildings, city.props) == hidden && one.GetDepth(0) == depth;
+    }
+    GV_CHECK(conservative);
+    GV_CHECK(sameAcrossThreads);
+    GV_CHECK(repeatable);
+    GV_CHECK(hiddenTotal > city.props.size());        // street level hides most of a city
+}
+
+GV_TEST(CityBenchmark) {
+    const City city(5, 16, 10000);
+    OcclusionBuffer buffer;
+    const int frames = 30;
+    u64 tested = 0, occluded = 0;
+    f32 rasterMs = 0.0f;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; ++f) {
+        // Walking down a street, panning across the blocks.
+        const f32 z = -4.0f * f32(f), yaw = 0.03f * f32(f);
+        const Camera cam(Vec3(17, 1.7f, z), Vec3(17 + 100.0f * std::sin(yaw), 1.7f, z - 100.0f * std::cos(yaw)));
+        Cull(buffer, cam, city.buildings, city.props);
+        tested   += buffer.GetStats().tested;
+        occluded += buffer.GetStats().occluded;
+        rasterMs += buffer.GetStats().rasterMs;
+    }
+    const f32 ms = std::chrono::duration<f32, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    const f32 culled = f32(occluded) / f32(tested);
+    std::printf("  %zu occluders, %zu occludees: culled %.1f%%, %.3f ms/frame (raster %.3f ms)\n",
+                city.buildings.size(), city.props.size(), 100.0 * culled, ms / frames, rasterMs / frames);
+    GV_CHECK(tested == u64(frames) * city.props.size());
+    GV_CHECK(culled > 0.5f);
+}
+
+GV_TEST_MAIN()
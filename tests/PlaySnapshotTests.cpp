@@ -0,0 +1,244 @@
+// ============================================================================
+// GameVoid Engine — Play Mode (BeginPlay / StopPlay) Round-Trip Tests
+// ============================================================================
+// Everything a play session changes — scripts, physics, engine-driven
+// controllers, spawns, destroys and component changes — must be undone by
+// StopPlay, at a cost that follows what changed rather than the scene size.
+// ============================================================================
+#include "TestHarness.h"
+#include "core/Scene.h"
+#include "physics/Physics.h"
+#include "scripting/ScriptEngine.h"
+#include "vehicle/CarController3D.h"
+#include "vehicle/VehicleAssembly.h"
+#include <chrono>
+#include <cstdio>
+
+using namespace gv;
+
+namespace {
+
+bool SamePosition(const Vec3& a, const Vec3& b) { return a.x == b.x && a.y == b.y && a.z == b.z; }
+
+/// A component with no play-mode state of its own.
+class Tag : public Component {
+public:
+    explicit Tag(int v = 0) : value(v) {}
+    int value;
+    bool UpdatesOwner() const override { return false; }
+};
+
+/// Seconds for `rounds` play sessions that each move the first `moved`
+/// objects of `scene`.
+f64 TimePlaySessions(Scene& scene, size_t moved, int rounds) {
+    const auto& objects = scene.GetAllObjects();
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        scene.BeginPlay();
+        for (size_t i = 0; i < moved; ++i) {
+            scene.TouchForPlay(objects[i].get());
+            objects[i]->GetTransform().position.y += 1.0f;
+        }
+        scene.StopPlay();
+    }
+    return std::chrono::duration<f64>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+GV_TEST(ScriptNativesAreUndoneByStopPlay) {
+    Scene scene;
+    GameObject* self  = scene.CreateGameObject("self");
+    GameObject* other = scene.CreateGameObject("other");      // no components: never auto-touched
+    other->GetTransform().position = Vec3(1, 2, 3);
+
+    ScriptEngine script;
+    GV_CHECK(script.Init());
+    script.BindSceneAPI(scene);
+    script.BindGameObjectAPI();
+    script.SetSelfObject(self);
+
+    scene.BeginPlay();
+    const std::string id = std::to_string(other->GetID());
+    GV_CHECK(script.Execute(
+        "set_position(" + id + ", 5, 6, 7)\n"
+        "set_scale(" + id + ", 3)\n"
+        "set_position(9, 9, 9)\n"
+        "set_rotation(0, 90, 0)\n"
+        "set_name(\"renamed\")\n"));
+    GV_CHECK_NEAR(other->GetTransform().position.x, 5.0, 0.0);
+    GV_CHECK(self->GetName() == "renamed");
+    scene.StopPlay();
+
+    GameObject* restoredOther = scene.FindByID(other->GetID());
+    GameObject* restoredSelf  = scene.FindByID(self->GetID());
+    GV_CHECK(restoredOther && restoredSelf);
+    if (!restoredOther || !restoredSelf) return;
+    GV_CHECK(SamePosition(restoredOther->GetTransform().position, Vec3(1, 2, 3)));
+    GV_CHECK(SamePosition(restoredOther->GetTransform().scale, Vec3(1, 1, 1)));
+    GV_CHECK(SamePosition(restoredSelf->GetTransform().position, Vec3(0, 0, 0)));
+    GV_CHECK_NEAR(restoredSelf->GetTransform().rotation.w, 1.0, 1e-6);
+    GV_CHECK(restoredSelf->GetName() == "self");
+    script.Shutdown();
+}
+
+GV_TEST(PhysicsSpawnsAndDestroysAreUndone) {
+    PhysicsWorld physics;
+    physics.Init();
+    Scene scene;
+    scene.SetPhysicsWorld(&physics);
+
+    GameObject* ball = scene.CreateGameObject("ball");
+    ball->GetTransform().position = Vec3(0, 10, 0);
+    PhysicsWorld::AddPhysicsComponents(ball, RigidBodyType::Dynamic, ColliderType::Sphere);
+    physics.RegisterBody(ball->GetComponent<RigidBody>());
+    GameObject* doomed = scene.CreateGameObject("doomed");
+    const u32 ballID = ball->GetID(), doomedID = doomed->GetID();
+
+    scene.BeginPlay();
+    for (int i = 0; i < 30; ++i) physics.Step(1.0f / 60.0f);
+    GV_CHECK(ball->GetTransform().position.y < 10.0f);
+    scene.CreateGameObject("spawned");
+    scene.DestroyGameObject(doomed);
+    scene.FlushDestroyQueue();
+    GV_CHECK(scene.FindByID(doomedID) == nullptr);
+    scene.StopPlay();
+
+    GV_CHECK(scene.GetAllObjects().size() == 2);
+    GV_CHECK(scene.FindByName("spawned") == nullptr);
+    GV_CHECK(scene.FindByID(doomedID) != nullptr);
+    GameObject* restored = scene.FindByID(ballID);
+    GV_CHECK(restored && SamePosition(restored->GetTransform().position, Vec3(0, 10, 0)));
+    if (restored) GV_CHECK_NEAR(restored->GetComponent<RigidBody>()->velocity.y, 0.0, 0.0);
+    physics.Shutdown();
+}
+
+GV_TEST(CarWheelVisualsAreUndoneByStopPlay) {
+    PhysicsWorld physics;
+    physics.Init();
+    Scene scene;
+    scene.SetPhysicsWorld(&physics);
+    GameObject* root = VehicleAssembler::Spawn(&scene, VehicleBlueprint::MakeSedanTemplate(), &physics);
+    GV_CHECK(root != nullptr);
+    if (!root) return;
+    auto* car  = root->GetComponent<CarController3D>();
+    auto* body = root->GetComponent<RigidBody>();
+    GameObject* wheel = scene.FindByName("front_left_wheel");
+    GV_CHECK(car && body && wheel);
+    if (!car || !body || !wheel) return;
+    const u32 wheelID = wheel->GetID();
+    const Vec3 wheelPos = wheel->GetTransform().position;
+    const Quaternion wheelRot = wheel->GetTransform().rotation;
+
+    scene.BeginPlay();
+    for (int i = 0; i < 120; ++i) {
+        car->inputForward = 1.0f;
+        car->inputTurn = 0.5f;
+        scene.TouchForPlay(root);             // as Engine::Run does for the driven car
+        car->UpdateController(1.0f / 60.0f, body, &physics, &scene);
+        physics.Step(1.0f / 60.0f);
+    }
+    GV_CHECK(!SamePosition(wheel->GetTransform().position, wheelPos));
+    scene.StopPlay();
+
+    GameObject* restored = scene.FindByID(wheelID);
+    GV_CHECK(restored != nullptr);
+    if (!restored) return;
+    GV_CHECK(SamePosition(restored->GetTransform().position, wheelPos));
+    GV_CHECK(restored->GetTransform().rotation.w == wheelRot.w &&
+             restored->GetTransform().rotation.x == wheelRot.x);
+    physics.Shutdown();
+}
+
+GV_TEST(ComponentChangesAreUndoneByStopPlay) {
+    PhysicsWorld physics;
+    physics.Init();
+    Scene scene;
+    scene.SetPhysicsWorld(&physics);
+
+    GameObject* crate = scene.CreateGameObject("crate");
+    crate->GetTransform().position = Vec3(0, 10, 0);
+    PhysicsWorld::AddPhysicsComponents(crate, RigidBodyType::Dynamic, ColliderType::Box);
+    crate->AddComponent<Tag>(1);
+    physics.RegisterBody(crate->GetComponent<RigidBody>());
+    GameObject* marker = scene.CreateGameObject("marker");
+    Tag* original = marker->AddComponent<Tag>(2);
+    GameObject* plain = scene.CreateGameObject("plain");
+    std::vector<Component*> crateBefore;
+    for (auto& c : crate->GetComponents()) crateBefore.push_back(c.get());
+
+    scene.BeginPlay();
+    for (int i = 0; i < 30; ++i) physics.Step(1.0f / 60.0f);
+    RigidBody* body = crate->GetComponent<RigidBody>();
+    GV_CHECK(body->velocity.y < 0.0f);
+    physics.UnregisterBody(body);                       // as gameplay code would
+    GV_CHECK(crate->RemoveComponent<RigidBody>());
+    GV_CHECK(marker->RemoveComponent<Tag>());
+    marker->AddComponent<Tag>(3);
+    scene.CreateGameObject("spawned")->AddComponent<Tag>(4);   // goes with its object
+    GV_CHECK(scene.GetPlaySnapshot().GetComponentChangeCount() == 3);
+    // Added and removed again during play: nothing left to undo.
+    plain->AddComponent<Tag>(5);
+    GV_CHECK(plain->RemoveComponent<Tag>());
+    GV_CHECK(scene.GetPlaySnapshot().GetComponentChangeCount() == 3);
+    scene.StopPlay();
+
+    // The crate has its body back, in its old slot, with its state at
+    // BeginPlay, and registered again: it falls from the start.
+    std::vector<Component*> crateAfter;
+    for (auto& c : crate->GetComponents()) crateAfter.push_back(c.get());
+    GV_CHECK(crateAfter == crateBefore);
+    GV_CHECK(crate->GetComponent<Tag>() && crate->GetComponent<Tag>()->value == 1);
+    body = crate->GetComponent<RigidBody>();
+    GV_CHECK(body && body->GetOwner() == crate);
+    if (!body) return;
+    GV_CHECK(SamePosition(crate->GetTransform().position, Vec3(0, 10, 0)));
+    GV_CHECK_NEAR(body->velocity.y, 0.0, 0.0);
+    physics.Step(1.0f / 60.0f);
+    GV_CHECK(body->velocity.y < 0.0f);
+
+    // The marker has exactly its original tag again.
+    GV_CHECK(marker->GetComponents().size() == 1);
+    GV_CHECK(marker->GetComponent<Tag>() == original && original->value == 2);
+    GV_CHECK(plain->GetComponents().empty());
+
+    // Outside play mode component changes stick.
+    marker->AddComponent<Tag>(6);
+    GV_CHECK(marker->GetComponents().size() == 2);
+    GV_CHECK(scene.GetPlaySnapshot().GetComponentChangeCount() == 0);
+    physics.Shutdown();
+}
+
+GV_TEST(LargeSceneBenchmark) {
+    // Entering and leaving play costs what the session changed, not what
+    // the scene holds: 100 moved objects in a small and a large scene,
+    // against every object moved in the large one.
+    const u32 small = 1000, large = 50000;
+    const size_t moved = 100;
+    const int rounds = 50;
+    auto build = [](Scene& scene, u32 count) {
+        for (u32 id = 1; id <= count; ++id)
+            scene.CreateGameObjectWithID(id, "object")->AddComponent<Tag>(int(id));
+    };
+    Scene smallScene, largeScene;
+    build(smallScene, small);
+    build(largeScene, large);
+
+    const f64 fewSmall = TimePlaySessions(smallScene, moved, rounds) / rounds;
+    const f64 fewLarge = TimePlaySessions(largeScene, moved, rounds) / rounds;
+    const f64 allLarge = TimePlaySessions(largeScene, large, 2) / 2;
+    std::printf("  play session, %zu objects moved: %.1f us in %u objects, %.1f us in %u; all %u moved: %.1f us\n",
+                moved, fewSmall * 1e6, small, fewLarge * 1e6, large, large, allLarge * 1e6);
+
+    // Everything is back where it started.
+    bool restored = true;
+    for (auto& o : largeScene.GetAllObjects()) restored &= o->GetTransform().position.y == 0.0f;
+    GV_CHECK(restored);
+    GV_CHECK(largeScene.GetAllObjects().size() == large && largeScene.GetNextID() == large + 1);
+
+    // Loose: 50x the objects must not cost anywhere near 50x.
+    GV_CHECK(fewLarge < fewSmall * 10.0 + 1e-4);
+    GV_CHECK(fewLarge < allLarge);
+}
+
+GV_TEST_MAIN()
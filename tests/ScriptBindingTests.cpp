@@ -0,0 +1,169 @@
+// ============================================================================
+// GameVoid Engine — GVScript Native Binding Tests
+// ============================================================================
+// How script values become C++ parameters through ScriptType<T>, what gets
+// refused and how, and what a bound call costs next to the other ways of
+// exposing a native.
+// ============================================================================
+#include "TestHarness.h"
+#include "core/GameObject.h"
+#include "scripting/ScriptBinding.h"
+#include "scripting/ScriptEngine.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+using namespace gv;
+
+namespace {
+
+template <typename T>
+bool Accepts(f64 d) { return ScriptType<T>::Is(VMValue::Number(d)); }
+
+/// Runs `source`; on failure returns the error, else "".
+std::string Fails(ScriptEngine& engine, const std::string& source) {
+    return engine.Execute(source) ? std::string() : engine.GetVM().GetLastError();
+}
+
+bool Contains(const std::string& text, const std::string& part) { return text.find(part) != std::string::npos; }
+
+} // namespace
+
+GV_TEST(HeaderExamplesBindAndRun) {
+    ScriptEngine engine;
+    GV_CHECK(engine.Init());
+    engine.Bind("lerp", [](f64 a, f64 b, f64 t) { return a + (b - a) * t; });
+    engine.Bind("is_even", [](i64 n) { return n % 2 == 0; });
+    engine.BindMethod<GameObject>("set_active", &GameObject::SetActive);
+
+    GV_CHECK(engine.Execute("var l = lerp(2, 4, 0.25);\nvar e = is_even(6);\nvar o = is_even(7);\n"));
+    ScriptVM& vm = engine.GetVM();
+    GV_CHECK_NEAR(vm.GetGlobal("l").ToNumber(), 2.5, 0.0);
+    GV_CHECK(vm.GetGlobal("e").IsBool() && vm.GetGlobal("e").AsBool());
+    GV_CHECK(vm.GetGlobal("o").IsBool() && !vm.GetGlobal("o").AsBool());
+
+    // A method needs an object: without one it is an error, not a crash…
+    GV_CHECK(Contains(Fails(engine, "set_active(true);"), "set_active: no object to call the method on"));
+    // …and an instance calls it on its own.
+    GameObject door("Door");
+    const u32 id = engine.CreateInstance("", "func close() { set_active(false); }\n", &door);
+    GV_CHECK(door.IsActive());
+    GV_CHECK(engine.CallInstance(id, "close"));
+    GV_CHECK(!door.IsActive());
+    engine.Shutdown();
+}
+
+GV_TEST(IntegersMustBeWholeAndInRange) {
+    const f64 two63 = std::ldexp(1.0, 63), two64 = std::ldexp(1.0, 64);
+
+    // The bounds are exact: max() itself rounds up to 2^63 / 2^64 as a
+    // double, which must not pass.
+    GV_CHECK(Accepts<i64>(-two63) && !Accepts<i64>(two63));
+    GV_CHECK(Accepts<i64>(two63 - 1024.0));            // the largest double below
+    GV_CHECK(Accepts<u64>(two63) && !Accepts<u64>(two64) && !Accepts<u64>(-1.0));
+    GV_CHECK(Accepts<i32>(2147483647.0) && !Accepts<i32>(2147483648.0));
+    GV_CHECK(Accepts<i32>(-2147483648.0) && !Accepts<i32>(-2147483649.0));
+    GV_CHECK(Accepts<u32>(4294967295.0) && !Accepts<u32>(4294967296.0));
+    GV_CHECK(Accepts<u8>(255.0) && !Accepts<u8>(256.0) && !Accepts<u8>(-1.0));
+    GV_CHECK(Accepts<i8>(-128.0) && !Accepts<i8>(128.0) && !Accepts<i8>(-129.0));
+    GV_CHECK(Accepts<u16>(0.0) && Accepts<u16>(-0.0));
+
+    // Fractions and non-finite values are never integers.
+    GV_CHECK(!Accepts<i32>(1.5) && !Accepts<i64>(-0.25));
+    GV_CHECK(!Accepts<i64>(NAN) && !Accepts<i64>(INFINITY) && !Accepts<i64>(-INFINITY));
+    GV_CHECK(!Accepts<u64>(INFINITY));
+    // Floating-point parameters take any number, nothing else.
+    GV_CHECK(Accepts<f32>(1e300) && Accepts<f64>(NAN));
+    GV_CHECK(!ScriptType<f64>::Is(VMValue::Bool(true)) && !ScriptType<i32>::Is(VMValue()));
+
+    // Through a call: the refusal names the native, argument and types.
+    ScriptEngine engine;
+    GV_CHECK(engine.Init());
+    engine.Bind("id64", [](i64 n) { return n; });
+    engine.Bind("idu8", [](u8 n) { return n; });
+    GV_CHECK(engine.Execute("var big = id64(9007199254740992);\nvar small = idu8(255);\n"));
+    GV_CHECK_NEAR(engine.GetVM().GetGlobal("big").ToNumber(), 9007199254740992.0, 0.0);
+    GV_CHECK_NEAR(engine.GetVM().GetGlobal("small").ToNumber(), 255.0, 0.0);
+    GV_CHECK(Contains(Fails(engine, "id64(9223372036854775808);"), "id64: argument 1: expected integer, got number"));
+    GV_CHECK(Contains(Fails(engine, "idu8(256);"), "idu8: argument 1: expected integer, got number"));
+    GV_CHECK(Contains(Fails(engine, "idu8(\"1\");"), "idu8: argument 1: expected integer, got string"));
+    engine.Shutdown();
+}
+
+GV_TEST(OtherParameterTypes) {
+    ScriptEngine engine;
+    GV_CHECK(engine.Init());
+    ScriptVM& vm = engine.GetVM();
+    engine.Bind("truth", [](bool b) { return b; });
+    engine.Bind("len", [](std::string_view s) { return static_cast<f64>(s.size()); });
+    engine.Bind("twice", [](const std::string& s) { return s + s; });
+    engine.Bind("kind", [](VMValue v) { return std::string(ScriptVM::TypeName(v)); });
+    engine.Bind("half", [](f32 x) { return x * 0.5f; });
+    f64 sink = 0.0;
+    engine.Bind("store", [&sink](f64 x) { sink = x; });
+
+    // bool takes anything, by truthiness.
+    GV_CHECK(engine.Execute(
+        "var t = [truth(1), truth(0), truth(nil), truth(\"\"), truth(\"x\"), truth(false)];\n"
+        "var n = len(\"four\");\nvar w = twice(\"ab\");\nvar k = kind(nil);\nvar h = half(3);\n"
+        "var v = store(42);\n"));
+    GV_CHECK(vm.ToString(vm.GetGlobal("t")) == "[true, false, false, false, true, false]");
+    GV_CHECK_NEAR(vm.GetGlobal("n").ToNumber(), 4.0, 0.0);
+    GV_CHECK(vm.ToString(vm.GetGlobal("w")) == "abab");
+    GV_CHECK(vm.ToString(vm.GetGlobal("k")) == "nil");
+    GV_CHECK_NEAR(vm.GetGlobal("h").ToNumber(), 1.5, 0.0);
+    GV_CHECK(vm.GetGlobal("v").IsNil() && sink == 42.0);   // void returns nil
+
+    GV_CHECK(Contains(Fails(engine, "len(4);"), "len: argument 1: expected string, got number"));
+    GV_CHECK(Contains(Fails(engine, "half(\"x\");"), "half: argument 1: expected number, got string"));
+    GV_CHECK(Contains(Fails(engine, "twice();"), "twice: expected 1 argument, got 0"));
+    GV_CHECK(Contains(Fails(engine, "len(\"a\", \"b\");"), "len: expected 1 argument, got 2"));
+    // A later argument is named by position; nothing runs on a bad call.
+    sink = 0.0;
+    engine.Bind("store2", [&sink](f64 x, i32 y) { sink = x + y; });
+    GV_CHECK(Contains(Fails(engine, "store2(1, 0.5);"), "store2: argument 2: expected integer, got number"));
+    GV_CHECK(sink == 0.0);
+    engine.Shutdown();
+}
+
+GV_TEST(BindingBenchmark) {
+    // The same two-argument native exposed three ways, called from a loop.
+    ScriptEngine engine;
+    GV_CHECK(engine.Init());
+    engine.GetVM().SetLimits(VMLimits::Unlimited());
+    engine.RegisterNative("add_raw", [](ScriptVM&, ScriptArgs a) -> VMValue {
+        return VMValue::Number(a.Number(0) + a.Number(1));
+    });
+    engine.Bind("add_bound", [](f64 a, i32 b) { return a + b; });
+    engine.RegisterFunction("add_boxed", [](const std::vector<ScriptValue>& a) {
+        return ScriptValue(a[0].AsNumber() + a[1].AsNumber());
+    });
+    GV_CHECK(engine.Execute(
+        "func loop_raw(n)   { var s = 0; var i = 0; while i < n { s = add_raw(s, 1); i = i + 1; } return s; }\n"
+        "func loop_bound(n) { var s = 0; var i = 0; while i < n { s = add_bound(s, 1); i = i + 1; } return s; }\n"
+        "func loop_boxed(n) { var s = 0; var i = 0; while i < n { s = add_boxed(s, 1); i = i + 1; } return s; }\n"
+        "func loop_empty(n) { var s = 0; var i = 0; while i < n { s = s + 1; i = i + 1; } return s; }\n"));
+
+    const u32 calls = 200000;
+    auto time = [&](const char* fn) {
+        const VMValue arg = VMValue::Number(calls);
+        VMValue out;
+        const auto start = std::chrono::steady_clock::now();
+        const bool ok = engine.GetVM().CallFunction(fn, { &arg, 1 }, &out);
+        const f64 ns = std::chrono::duration<f64, std::nano>(std::chrono::steady_clock::now() - start).count();
+        GV_CHECK(ok && out.ToNumber() == calls);
+        return ns / calls;
+    };
+    const f64 empty = time("loop_empty");
+    const f64 raw = time("loop_raw"), bound = time("loop_bound"), boxed = time("loop_boxed");
+    std::printf("  per call, loop overhead %.0f ns removed: raw %.0f ns, Bind %.0f ns, RegisterFunction %.0f ns\n",
+                empty, raw - empty, bound - empty, boxed - empty);
+
+    // Checking and converting arguments in place stays well under the
+    // cost of boxing them into a vector of ScriptValues.
+    GV_CHECK(bound < boxed);
+    engine.Shutdown();
+}
+
+GV_TEST_MAIN()
@@ -0,0 +1,203 @@
+// ============================================================================
+// GameVoid Engine — GVScript Debugger and Profiler Tests
+// ============================================================================
+// The debugger is driven the way a developer would: a client attaches over
+// loopback TCP while the script runs on its own thread, since the server
+// holds the VM inside the stopped frame until told to go on.
+// ============================================================================
+#include "TestHarness.h"
+#include "scripting/ScriptDebugger.h"
+#include "scripting/ScriptProfiler.h"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace gv;
+
+namespace {
+
+const char* kLoop =
+    "func add(a, b) {\n"            // 1
+    "    var sum = a + b;\n"        // 2
+    "    return sum;\n"             // 3
+    "}\n"                           // 4
+    "func run(n) {\n"               // 5
+    "    var total = 0;\n"          // 6
+    "    var i = 0;\n"              // 7
+    "    while i < n {\n"           // 8
+    "        total = add(total, i);\n" // 9
+    "        i = i + 1;\n"          // 10
+    "    }\n"                       // 11
+    "    return total;\n"           // 12
+    "}\n";                          // 13
+
+/// The engine side: serves the debugger until told to run `run(n)`.
+struct Target {
+    ScriptVM vm;
+    ScriptDebugger debugger{ vm };
+    std::atomic<bool> go{ false }, done{ false };
+    f64 result = -1.0;
+    std::thread thread;
+
+    explicit Target(f64 n) {
+        vm.Execute(kLoop, "scripts/loop.gvs");
+        debugger.Listen("0");
+        thread = std::thread([this, n] {
+            while (!go) {
+                debugger.Poll();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            const VMValue arg = VMValue::Number(n);
+            VMValue out;
+            if (vm.CallFunction("run", { &arg, 1 }, &out)) result = out.ToNumber();
+            done = true;
+            while (debugger.IsAttached()) {           // serve detach
+                debugger.Poll();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+    }
+    ~Target() {
+        go = true;
+        debugger.Close();
+        if (thread.joinable()) thread.join();
+    }
+};
+
+/// Sends a command and returns its reply, the final "ok…"/"err…" line last.
+std::vector<std::string> Ask(ScriptDebugClient& client, const std::string& command) {
+    std::vector<std::string> reply;
+    if (!client.Command(command, reply)) reply.push_back("err " + client.GetLastError());
+    return reply;
+}
+
+bool Has(const std::vector<std::string>& lines, const std::string& line) {
+    for (const std::string& l : lines) if (l == line) return true;
+    return false;
+}
+
+std::string NextEvent(ScriptDebugClient& client) {
+    std::string event;
+    return client.WaitEvent(event, 5000.0) ? event : "timeout";
+}
+
+} // namespace
+
+GV_TEST(AttachBreakStepAndInspect) {
+    Target target(3);
+    GV_CHECK(target.debugger.IsListening() && target.debugger.GetPort() != 0);
+    ScriptDebugClient client;
+    GV_CHECK(client.Connect(std::to_string(target.debugger.GetPort())));
+    GV_CHECK(NextEvent(client) == "hello gvscript-debug 1");
+
+    // A breakpoint by path suffix, set before anything runs.
+    GV_CHECK(Ask(client, "break loop.gvs:9").back() == "ok 1");
+    GV_CHECK(Ask(client, "status").back() == "ok running");
+    GV_CHECK(Ask(client, "locals").back() == "err not stopped");
+    target.go = true;
+
+    // First pass through the loop body.
+    GV_CHECK(NextEvent(client) == "stopped breakpoint run scripts/loop.gvs:9");
+    std::vector<std::string> locals = Ask(client, "locals");
+    GV_CHECK(locals.back() == "ok");
+    GV_CHECK(Has(locals, "var local n number 3"));
+    GV_CHECK(Has(locals, "var local total number 0"));
+    GV_CHECK(Has(locals, "var local i number 0"));
+
+    // Step into add(): a new frame on top, its arguments readable.
+    GV_CHECK(Ask(client, "step").back() == "ok");
+    GV_CHECK(NextEvent(client) == "resumed");
+    GV_CHECK(NextEvent(client) == "stopped step add scripts/loop.gvs:2");
+    const std::vector<std::string> stack = Ask(client, "stack");
+    GV_CHECK(stack.size() == 3);
+    GV_CHECK(Has(stack, "frame 0 add scripts/loop.gvs:2"));
+    GV_CHECK(Has(stack, "frame 1 run scripts/loop.gvs:9"));
+    GV_CHECK(Ask(client, "print b")[0] == "value number 0");
+    GV_CHECK(Ask(client, "print n 1")[0] == "value number 3");     // the caller's frame
+    GV_CHECK(Ask(client, "print nope").back() == "err no variable 'nope'");
+
+    // Step over the next line: sum is now live.
+    Ask(client, "next");
+    GV_CHECK(NextEvent(client) == "resumed");
+    GV_CHECK(NextEvent(client) == "stopped step add scripts/loop.gvs:3");
+    GV_CHECK(Ask(client, "print sum")[0] == "value number 0");
+
+    // Out to the caller, which still has to store the result, then over to
+    // the next line of the loop.
+    Ask(client, "finish");
+    GV_CHECK(NextEvent(client) == "resumed");
+    GV_CHECK(NextEvent(client) == "stopped step run scripts/loop.gvs:9");
+    Ask(client, "next");
+    GV_CHECK(NextEvent(client) == "resumed");
+    GV_CHECK(NextEvent(client) == "stopped step run scripts/loop.gvs:10");
+    GV_CHECK(Ask(client, "print i")[0] == "value number 0");
+
+    // The breakpoint fires again on the next pass, with the new values.
+    Ask(client, "continue");
+    GV_CHECK(NextEvent(client) == "resumed");
+    GV_CHECK(NextEvent(client) == "stopped breakpoint run scripts/loop.gvs:9");
+    GV_CHECK(Ask(client, "print i")[0] == "value number 1");
+
+    // Cleared: the script runs to the end with the right answer.
+    GV_CHECK(Ask(client, "delete 1").back() == "ok");
+    Ask(client, "continue");
+    GV_CHECK(NextEvent(client) == "resumed");
+    for (int i = 0; i < 5000 && !target.done; ++i) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    GV_CHECK(target.done);
+    GV_CHECK(target.result == 3.0);                    // 0 + 1 + 2
+    GV_CHECK(Ask(client, "detach").back() == "ok");
+}
+
+GV_TEST(OnlyOneClientAndLoopbackOnly) {
+    Target target(1);
+    ScriptDebugClient first, second;
+    GV_CHECK(first.Connect(std::to_string(target.debugger.GetPort())));
+    GV_CHECK(NextEvent(first) == "hello gvscript-debug 1");
+    GV_CHECK(second.Connect(std::to_string(target.debugger.GetPort())));
+    std::vector<std::string> reply;
+    GV_CHECK(!second.Command("status", reply, 2000.0) || reply.back() == "err another client is attached");
+    GV_CHECK(Ask(first, "detach").back() == "ok");
+
+    ScriptVM vm;
+    ScriptDebugger remote(vm);
+    GV_CHECK(!remote.Listen("192.0.2.1:4711"));
+    GV_CHECK(!remote.IsListening());
+}
+
+GV_TEST(ProfilerCountsCallsAndLines) {
+    ScriptVM vm;
+    GV_CHECK(vm.Execute(kLoop, "scripts/loop.gvs"));
+    ScriptProfiler profiler(vm);
+    profiler.Start();
+    const VMValue arg = VMValue::Number(10);
+    VMValue out;
+    GV_CHECK(vm.CallFunction("run", { &arg, 1 }, &out));
+    profiler.Stop();
+    GV_CHECK(out.ToNumber() == 45.0);
+
+    const ScriptProfiler::FunctionStats* add = nullptr;
+    const ScriptProfiler::FunctionStats* run = nullptr;
+    const std::vector<ScriptProfiler::FunctionStats> functions = profiler.GetFunctions();
+    for (const auto& f : functions) {
+        if (f.name == "add") add = &f;
+        if (f.name == "run") run = &f;
+    }
+    GV_CHECK(add && run);
+    if (!add || !run) return;
+    GV_CHECK(add->calls == 10 && run->calls == 1);
+    GV_CHECK(add->line == 2 && run->line == 6);         // first line of code
+    GV_CHECK(run->lines.count(9) && run->lines.at(9).hits == 10);
+    GV_CHECK(run->lines.count(12) && run->lines.at(12).hits == 1);
+    GV_CHECK(run->totalNs >= run->selfNs && run->totalNs >= add->totalNs);
+    const std::string folded = profiler.FoldedStacks();
+    GV_CHECK(folded.find("run (scripts/loop.gvs:6);add (scripts/loop.gvs:2) ") != std::string::npos);
+
+    // Stopped: nothing more is counted.
+    vm.CallFunction("run", { &arg, 1 }, &out);
+    for (const auto& f : profiler.GetFunctions())
+        if (f.name == "add") GV_CHECK(f.calls == 10);
+}
+
+GV_TEST_MAIN()
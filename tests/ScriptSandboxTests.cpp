@@ -0,0 +1,88 @@
+// ============================================================================
+// GameVoid Engine — GVScript Sandbox and Binding Tests
+// ============================================================================
+#include "TestHarness.h"
+#include "scripting/ScriptEngine.h"
+#include <string>
+
+using namespace gv;
+
+GV_TEST(DefaultLimitsStopRunawayCode) {
+    ScriptVM vm;
+    GV_CHECK(vm.GetLimits().instructions > 0 && vm.GetLimits().callDepth > 0 && vm.GetLimits().memoryBytes > 0);
+    GV_CHECK(vm.GetLimits().timeMs == 0);               // machine speed must not decide
+    GV_CHECK(vm.Execute(
+        "func spin() { while true { } }\n"
+        "func dive(n) { return dive(n + 1); }\n"
+        "func grow() { var s = \"0123456789abcdef\"; while true { s = s + s; } }\n"));
+
+    GV_CHECK(!vm.CallFunction("spin"));
+    GV_CHECK(vm.GetLastFault() == VMFault::Instructions);
+    GV_CHECK(!vm.CallFunction("dive"));
+    GV_CHECK(vm.GetLastFault() == VMFault::CallDepth);
+    GV_CHECK(vm.GetLastError().find("call depth 200") != std::string::npos);
+    GV_CHECK(!vm.CallFunction("grow"));
+    GV_CHECK(vm.GetLastFault() == VMFault::Memory);
+}
+
+GV_TEST(WallClockLimitIsOptIn) {
+    ScriptVM vm;
+    VMLimits limits;
+    limits.instructions = 0;
+    limits.timeMs = 2;
+    vm.SetLimits(limits);
+    GV_CHECK(vm.Execute("func spin() { while true { } }\n"));
+    GV_CHECK(!vm.CallFunction("spin"));
+    GV_CHECK(vm.GetLastFault() == VMFault::Time);
+}
+
+GV_TEST(UnlimitedIsAnExplicitOptOut) {
+    ScriptVM vm;
+    vm.SetLimits(VMLimits::Unlimited());
+    GV_CHECK(vm.Execute(
+        "func down(n) { if n == 0 { return 0; } return 1 + down(n - 1); }\n"
+        "var depth = down(240);\n"));
+    GV_CHECK_NEAR(vm.GetGlobal("depth").ToNumber(), 240.0, 0.0);
+    // Only the VM's own frame limit is left.
+    GV_CHECK(!vm.Execute("down(1000);"));
+    GV_CHECK(vm.GetLastError().find("call depth 256") != std::string::npos);
+}
+
+GV_TEST(InstancesAreSandboxedByDefault) {
+    ScriptEngine engine;
+    GV_CHECK(engine.Init());
+    const std::string runaway = "func on_update(dt) { while true { } }\n";
+    u32 id = engine.CreateInstance("", runaway, nullptr);
+    GV_CHECK(id != 0);
+    GV_CHECK(!engine.CallInstance(id, "on_update", 0.016f));
+    GV_CHECK(engine.IsInstanceTerminated(id));
+
+    // A trusted instance can opt out; it then runs until its own code ends.
+    ScriptSandbox trusted;
+    trusted.limits = VMLimits::Unlimited();
+    u32 deep = engine.CreateInstance("", "func go(n) { if n == 0 { return 0; } return go(n - 1); }\n"
+                                         "func on_update(dt) { go(220); }\n", nullptr);
+    GV_CHECK(engine.SetInstanceSandbox(deep, trusted));
+    GV_CHECK(engine.CallInstance(deep, "on_update", 0.016f));
+    GV_CHECK(!engine.IsInstanceTerminated(deep));
+    engine.Shutdown();
+}
+
+GV_TEST(BoundFunctionsCheckTheirArguments) {
+    ScriptEngine engine;
+    GV_CHECK(engine.Init());
+    engine.Bind("scale", [](f64 x, i32 k) { return x * k; });
+    engine.Bind("greet", [](const std::string& who) { return "hi " + who; });
+    GV_CHECK(engine.Execute("var a = scale(1.5, 4);\nvar g = greet(\"gv\");\n"));
+    ScriptVM& vm = engine.GetVM();
+    GV_CHECK_NEAR(vm.GetGlobal("a").ToNumber(), 6.0, 0.0);
+    GV_CHECK(vm.ToString(vm.GetGlobal("g")) == "hi gv");
+
+    GV_CHECK(!engine.Execute("scale(\"x\", 2);"));
+    GV_CHECK(vm.GetLastError().find("scale: argument 1: expected number, got string") != std::string::npos);
+    GV_CHECK(!engine.Execute("scale(1, 2.5);"));
+    GV_CHECK(!engine.Execute("greet();"));
+    engine.Shutdown();
+}
+
+GV_TEST_MAIN()
@@ -0,0 +1,259 @@
+// ============================================================================
+// GameVoid Engine — GVScript Scheduler and Timer Wheel Tests
+// ============================================================================
+// Everything runs on the simulated clock, so wake-ups are exact: a sleeper
+// must fire on its expiry tick, not a tick early or late, however many
+// levels it cascades through.
+// ============================================================================
+#include "TestHarness.h"
+#include "scripting/ScriptScheduler.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace gv;
+
+namespace {
+
+/// A VM with a scheduler and a record(x) native collecting what scripts
+/// report, in order.
+struct Scripted {
+    ScriptVM vm;
+    ScriptScheduler scheduler{ vm };
+    std::vector<f64> log;
+
+    explicit Scripted(const char* source) {
+        scheduler.RegisterNatives();
+        vm.RegisterNative("record", [this](ScriptVM&, ScriptArgs a) -> VMValue {
+            log.push_back(a.Number(0));
+            return VMValue();
+        });
+        vm.Execute(source);
+    }
+    ScriptScheduler::CoroutineID Start(const char* func, std::vector<VMValue> args = {}) {
+        return scheduler.Start(vm.String(func), { args.data(), static_cast<u32>(args.size()) });
+    }
+};
+
+VMValue Num(f64 v) { return VMValue::Number(v); }
+
+} // namespace
+
+GV_TEST(WheelFiresOnTheExpiryTick) {
+    // One timer per level boundary and either side of it, plus two past the
+    // top level's horizon (64^4 ticks), which park and come round again.
+    const u64 horizon = 1ull << 24;
+    const std::vector<u64> expiries = { 1, 2, 63, 64, 65, 127, 128, 4095, 4096, 4097, 70000, 262143, 262144,
+                                        262145, 1000000, horizon - 1, horizon, horizon + 12345, horizon + 262144 };
+    TimerWheel wheel;
+    for (size_t i = 0; i < expiries.size(); ++i) wheel.Add(expiries[i], i);
+    GV_CHECK(wheel.GetCount() == expiries.size());
+
+    std::vector<TimerWheel::Expired> fired;
+    bool exact = true;
+    for (size_t i = 0; i < expiries.size(); ++i) {
+        wheel.Advance(expiries[i] - 1, fired);
+        exact &= fired.empty();                         // not a tick early
+        wheel.Advance(expiries[i], fired);
+        exact &= fired.size() == 1 && fired[0].payload == i && fired[0].expiry == expiries[i];
+        fired.clear();
+    }
+    GV_CHECK(exact);
+    GV_CHECK(wheel.GetCount() == 0 && wheel.GetNow() == expiries.back());
+
+    // Added mid-revolution, after the clock has moved: still exact.
+    wheel.Clear(1000);
+    const u64 at[] = { 1001, 1063, 1064, 1000 + 5000, 1000 + 300000 };
+    for (u64 e : at) wheel.Add(e, e);
+    wheel.Advance(1000 + 400000, fired);
+    GV_CHECK(fired.size() == 5);
+    bool inOrder = true;
+    for (size_t i = 0; i < fired.size(); ++i) inOrder &= fired[i].expiry == at[i] && fired[i].payload == at[i];
+    GV_CHECK(inOrder);
+
+    // A timer in the past fires on the next tick.
+    wheel.Add(5, 5);
+    wheel.Advance(wheel.GetNow() + 1, fired);
+    GV_CHECK(fired.size() == 6 && fired.back().expiry == 1000 + 400001);
+}
+
+GV_TEST(WheelCancelsAndReusesHandles) {
+    TimerWheel wheel;
+    std::vector<u32> handles;
+    for (u64 i = 0; i < 1000; ++i) handles.push_back(wheel.Add(1 + i * 37, i));
+    for (size_t i = 0; i < handles.size(); i += 2) wheel.Cancel(handles[i]);
+    wheel.Cancel(handles[0]);                           // twice is harmless
+    wheel.Cancel(TimerWheel::kInvalid);
+    GV_CHECK(wheel.GetCount() == 500);
+
+    // The freed nodes are reused before the pool grows.
+    const u32 reused = wheel.Add(10, 9999);
+    GV_CHECK(reused == handles[handles.size() - 2]);
+    wheel.Cancel(reused);
+
+    std::vector<TimerWheel::Expired> fired;
+    wheel.Advance(40000, fired);
+    bool oddOnly = fired.size() == 500;
+    for (const auto& e : fired) oddOnly &= e.payload % 2 == 1;
+    GV_CHECK(oddOnly);
+    GV_CHECK(wheel.GetCount() == 0);
+}
+
+GV_TEST(SleepersWakeOnTheirFrame) {
+    Scripted s(
+        "func sleeper(id, seconds) { wait(seconds); record(id); record(sim_time()); }\n");
+    s.Start("sleeper", { Num(1), Num(0.25) });
+    s.Start("sleeper", { Num(2), Num(0.5) });
+    s.Start("sleeper", { Num(3), Num(0.016) });
+
+    // 60 Hz frames: each sleeper resumes on the first frame at or past its
+    // wake tick, even though 0.25 s is 15 frames of accumulated rounding.
+    std::vector<int> wokeAt(4, -1);
+    for (int frame = 0; frame <= 40; ++frame) {
+        const size_t before = s.log.size();
+        s.scheduler.Update(frame == 0 ? 0.0 : 1.0 / 60.0);
+        for (size_t i = before; i < s.log.size(); i += 2) wokeAt[static_cast<int>(s.log[i])] = frame;
+    }
+    GV_CHECK(wokeAt[3] == 1);
+    GV_CHECK(wokeAt[1] == 15);
+    GV_CHECK(wokeAt[2] == 30);
+    GV_CHECK(s.scheduler.GetStats().live == 0);
+
+    // Waits round to the nearest tick and never wake before that tick.
+    Scripted fine("func f() { wait(0.0004); record(1); wait(0.0006); record(2); }\n");
+    fine.scheduler.SetTickRate(1000.0);
+    fine.Start("f");
+    fine.scheduler.Update(0.0);                         // 0.4 ms rounds to 0: sleeps one tick
+    fine.scheduler.Update(0.001);
+    GV_CHECK(fine.log.size() == 1);
+    fine.scheduler.Update(0.0005);
+    GV_CHECK(fine.log.size() == 1);
+    fine.scheduler.Update(0.0005);
+    GV_CHECK(fine.log.size() == 2);
+}
+
+GV_TEST(SameTickWakesInWaitOrder) {
+    Scripted s("func sleeper(id, seconds) { wait(seconds); record(id); }\n");
+    // Started 1..6: three share a wake tick, and an earlier tick beats an
+    // earlier wait.
+    s.Start("sleeper", { Num(1), Num(0.5) });
+    s.Start("sleeper", { Num(2), Num(0.2) });
+    s.Start("sleeper", { Num(3), Num(0.5) });
+    s.Start("sleeper", { Num(4), Num(0.5) });
+    s.Start("sleeper", { Num(5), Num(0.3) });
+    s.Start("sleeper", { Num(6), Num(0.2) });
+    s.scheduler.Update(0.0);
+    GV_CHECK(s.scheduler.GetStats().sleeping == 6);
+    s.scheduler.Update(1.0);                            // all due in one step
+    GV_CHECK(s.log == (std::vector<f64>{ 2, 6, 5, 1, 3, 4 }));
+
+    // The same run twice gives the same order.
+    Scripted again("func sleeper(id, seconds) { wait(seconds); record(id); }\n");
+    for (int i = 1; i <= 6; ++i) again.Start("sleeper", { Num(i), Num(i % 2 ? 0.5 : 0.25) });
+    again.scheduler.Update(0.0);
+    for (int i = 0; i < 60; ++i) again.scheduler.Update(1.0 / 60.0);
+    GV_CHECK(again.log == (std::vector<f64>{ 2, 4, 6, 1, 3, 5 }));
+}
+
+GV_TEST(LongSleepsCascadeAndCrossTheHorizon) {
+    Scripted s("func sleeper(id, seconds) { wait(seconds); record(id); record(sim_time()); }\n");
+    s.scheduler.SetTickRate(100.0);
+    // 64^4 ticks at 100 Hz is about 46.6 hours; the last two sleep past it.
+    const f64 horizon = 16777216.0 / 100.0;
+    const f64 sleeps[] = { 0.64, 40.96, 2621.44, horizon - 0.01, horizon + 0.5, 2.5 * horizon };
+    for (int i = 0; i < 6; ++i) s.Start("sleeper", { Num(i), Num(sleeps[i]) });
+    s.scheduler.Update(0.0);
+    GV_CHECK(s.scheduler.GetStats().sleeping == 6);
+
+    // Ten-minute steps, then single ticks around each wake.
+    bool exact = true;
+    for (int i = 0; i < 6; ++i) {
+        const f64 due = sleeps[i];
+        while (s.scheduler.GetTime() + 600.0 < due - 0.05) s.scheduler.Update(600.0);
+        while (s.scheduler.GetTime() < due - 0.015) s.scheduler.Update(0.01);
+        exact &= s.log.size() == static_cast<size_t>(i) * 2;
+        s.scheduler.Update(0.01);
+        s.scheduler.Update(0.01);
+        exact &= s.log.size() == static_cast<size_t>(i + 1) * 2 && s.log[i * 2] == i;
+        // Woke within a tick of the wait, on the frame that crossed it.
+        exact &= s.log[i * 2 + 1] >= due - 1e-6 && s.log[i * 2 + 1] <= due + 0.0201;
+    }
+    GV_CHECK(exact);
+    GV_CHECK(s.scheduler.GetStats().sleeping == 0 && s.scheduler.GetStats().live == 0);
+}
+
+GV_TEST(StoppedSleepersNeverWake) {
+    Scripted s(
+        "func sleeper(id) { wait(1); record(id); }\n"
+        "func stopper(victim) { wait(0.5); record(stop_coroutine(victim)); }\n");
+    const auto a = s.Start("sleeper", { Num(1) });
+    const auto b = s.Start("sleeper", { Num(2) });
+    const auto c = s.Start("sleeper", { Num(3) });
+    s.Start("stopper", { Num(static_cast<f64>(c)) });
+    s.scheduler.Update(0.0);
+    GV_CHECK(s.scheduler.GetStats().sleeping == 4);
+
+    GV_CHECK(s.scheduler.Stop(a));
+    GV_CHECK(!s.scheduler.Stop(a));                    // already gone
+    GV_CHECK(!s.scheduler.IsRunning(a) && s.scheduler.IsRunning(b));
+    GV_CHECK(s.scheduler.GetStats().sleeping == 3);
+
+    s.scheduler.Update(0.6);                            // the script stops c
+    GV_CHECK(s.log == (std::vector<f64>{ 1 }));
+    GV_CHECK(s.scheduler.GetStats().sleeping == 1);
+    s.scheduler.Update(1.0);
+    GV_CHECK(s.log == (std::vector<f64>{ 1, 2 }));
+
+    // A recycled slot gets a new id; the stale one stays dead.
+    const auto d = s.Start("sleeper", { Num(4) });
+    GV_CHECK(d != a && !s.scheduler.IsRunning(a) && s.scheduler.IsRunning(d));
+    s.scheduler.StopAll();
+    s.scheduler.Update(5.0);
+    GV_CHECK(s.log.size() == 2 && s.scheduler.GetStats().live == 0);
+}
+
+GV_TEST(HundredThousandSleepersBenchmark) {
+    Scripted s("func sleeper(seconds) { while true { wait(seconds); } }\n");
+    s.scheduler.SetTickRate(600.0);                     // ten ticks a frame
+    const u32 count = 100000;
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> frames(1, 600);   // 1/60 s to 10 s
+    u64 expected = 0;
+    const int simulated = 600;                          // 10 s at 60 Hz
+    for (u32 i = 0; i < count; ++i) {
+        const int period = frames(rng);
+        expected += simulated / period;
+        s.Start("sleeper", { Num(period / 60.0) });
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    s.scheduler.Update(0.0);                            // everyone reaches its first wait
+    const f64 startMs = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    const u64 startResumes = s.scheduler.GetStats().resumes;
+    GV_CHECK(s.scheduler.GetStats().sleeping == count);
+
+    t0 = std::chrono::steady_clock::now();
+    for (int f = 0; f < simulated; ++f) s.scheduler.Update(1.0 / 60.0);
+    const f64 ms = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    const u64 resumes = s.scheduler.GetStats().resumes - startResumes;
+    std::printf("  %u sleepers: start %.1f ms, %.3f ms/frame, %.0f ns per wake (%llu wakes)\n",
+                count, startMs, ms / simulated, ms * 1e6 / static_cast<f64>(resumes),
+                static_cast<unsigned long long>(resumes));
+
+    // Every period divides into whole ticks, so each sleeper woke exactly
+    // once per period, and all of them are still asleep.
+    GV_CHECK(resumes == expected);
+    GV_CHECK(s.scheduler.GetStats().sleeping == count);
+    // A frame in which nothing is due doesn't visit the sleepers.
+    Scripted idle("func sleeper() { wait(3600); }\n");
+    for (u32 i = 0; i < count; ++i) idle.Start("sleeper");
+    idle.scheduler.Update(0.0);
+    t0 = std::chrono::steady_clock::now();
+    for (int f = 0; f < simulated; ++f) idle.scheduler.Update(1.0 / 60.0);
+    const f64 idleMs = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    std::printf("  %u idle sleepers: %.4f ms/frame\n", count, idleMs / simulated);
+    GV_CHECK(idleMs / simulated < 1.0);
+}
+
+GV_TEST_MAIN()
@@ -0,0 +1,252 @@
+// ============================================================================
+// GameVoid Engine — GVScript VM, Heap and Coroutine Tests
+// ============================================================================
+// Global operator new is replaced below so tests can count the C++
+// allocations a script call makes.
+// ============================================================================
+#include "TestHarness.h"
+#include "scripting/ScriptEngine.h"
+#include "scripting/ScriptVM.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace gv;
+
+namespace {
+
+u64 s_Allocations = 0;
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    ++s_Allocations;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+/// C++ allocations made by `fn`, per call, over `calls` calls.
+template <typename Fn>
+f64 AllocationsPerCall(u32 calls, Fn&& fn) {
+    const u64 before = s_Allocations;
+    for (u32 i = 0; i < calls; ++i) fn();
+    return f64(s_Allocations - before) / calls;
+}
+
+size_t CountLines(const std::string& text) {
+    size_t n = text.empty() ? 0 : 1;
+    for (char c : text) n += c == '\n';
+    return n;
+}
+
+} // namespace
+
+GV_TEST(RunsFunctionsAndClosures) {
+    ScriptVM vm;
+    GV_CHECK(vm.Execute(
+        "func add(a, b) { return a + b; }\n"
+        "func counter() {\n"
+        "    var n = 0;\n"
+        "    return func () { n = n + 1; return n; };\n"
+        "}\n"
+        "var next = counter();\n"
+        "next(); next();\n"
+        "var third = next();\n"));
+    VMValue args[] = { VMValue::Number(2), VMValue::Number(3) };
+    VMValue r;
+    GV_CHECK(vm.CallFunction("add", { args, 2 }, &r));
+    GV_CHECK_NEAR(r.ToNumber(), 5.0, 0.0);
+    GV_CHECK_NEAR(vm.GetGlobal("third").ToNumber(), 3.0, 0.0);
+    GV_CHECK(!vm.CallFunction("missing"));
+}
+
+GV_TEST(NativesAreCalledWithTheirArguments) {
+    ScriptVM vm;
+    std::vector<f64> seen;
+    vm.RegisterNative("record", [&](ScriptVM&, ScriptArgs args) -> VMValue {
+        for (u32 i = 0; i < args.Count(); ++i) seen.push_back(args.Number(i));
+        return VMValue::Number(args.Count());
+    });
+    vm.RegisterNative("fail", [](ScriptVM&, ScriptArgs) -> VMValue {
+        throw std::runtime_error("bad input");
+    });
+    GV_CHECK(vm.Execute("var n = record(1, 2, 3);"));
+    GV_CHECK(seen.size() == 3 && seen[2] == 3.0);
+    GV_CHECK_NEAR(vm.GetGlobal("n").ToNumber(), 3.0, 0.0);
+
+    GV_CHECK(!vm.Execute("fail();"));
+    GV_CHECK(vm.GetLastError().find("fail: bad input") != std::string::npos);
+    // A later successful call doesn't leave the old error behind.
+    GV_CHECK(vm.Execute("record(4);"));
+    GV_CHECK(vm.GetLastError().empty());
+}
+
+GV_TEST(HeapChargesEachObjectItsOwnSize) {
+    ScriptVM vm;
+    VMHeap& heap = vm.GetHeap();
+    heap.Pause();
+    u64 before = heap.GetBytesAllocated();
+    heap.Intern("a fresh string");
+    GV_CHECK(heap.GetBytesAllocated() - before == sizeof(VMString) + 15);
+
+    before = heap.GetBytesAllocated();
+    VMArray* array = heap.NewArray(10);
+    GV_CHECK(heap.GetBytesAllocated() - before == sizeof(VMArray) + array->items.capacity() * sizeof(VMValue));
+
+    before = heap.GetBytesAllocated();
+    VMFiber fiber;
+    fiber.stack.resize(4);
+    heap.NewUpvalue(&fiber.stack, 0);
+    GV_CHECK(heap.GetBytesAllocated() - before == sizeof(VMUpvalue));
+
+    before = heap.GetBytesAllocated();
+    heap.NewClosure(heap.NewFunction());
+    GV_CHECK(heap.GetBytesAllocated() - before == sizeof(VMFunction) + sizeof(VMClosure));
+    heap.Resume();
+}
+
+GV_TEST(CollectorFreesGarbageAndKeepsGlobals) {
+    ScriptVM vm;
+    GV_CHECK(vm.Execute(
+        "var kept = [1, 2, 3];\n"
+        "func churn() {\n"
+        "    var i = 0;\n"
+        "    while i < 2000 { var t = [i, i + 1]; var m = { a: t }; i = i + 1; }\n"
+        "}\n"));
+    vm.FullCollect();
+    const u64 baseline = vm.GetHeap().GetStats().objectCount;
+    GV_CHECK(vm.CallFunction("churn"));
+    vm.FullCollect();
+    VMHeapStats stats = vm.GetHeap().GetStats();
+    GV_CHECK(stats.objectCount <= baseline + 2);
+    GV_CHECK(stats.freed >= 4000);
+    VMValue kept = vm.GetGlobal("kept");
+    GV_CHECK(kept.IsObject() && vm.ToString(kept) == "[1, 2, 3]");
+}
+
+GV_TEST(CoroutinesSuspendAndResume) {
+    ScriptVM vm;
+    std::vector<f64> steps;
+    vm.RegisterNative("step", [&](ScriptVM&, ScriptArgs args) -> VMValue { steps.push_back(args.Number(0)); return VMValue(); });
+    GV_CHECK(vm.Execute(
+        "func walk(n) {\n"
+        "    step(n); yield;\n"
+        "    step(n + 1); yield;\n"
+        "    return n + 2;\n"
+        "}\n"));
+    VMFiber fiber;
+    const u32 root = vm.AddRootMarker([&](VMHeap& heap) { ScriptVM::MarkFiber(heap, fiber); });
+    VMValue arg = VMValue::Number(10);
+    GV_CHECK(vm.PrepareFiber(fiber, vm.String("walk"), { &arg, 1 }));
+    GV_CHECK(vm.Resume(fiber) == VMResumeResult::Suspended);
+    vm.FullCollect();                                   // the suspended frames stay rooted
+    GV_CHECK(vm.Resume(fiber) == VMResumeResult::Suspended);
+    VMValue result;
+    GV_CHECK(vm.Resume(fiber, {}, &result) == VMResumeResult::Finished);
+    GV_CHECK_NEAR(result.ToNumber(), 12.0, 0.0);
+    GV_CHECK(steps.size() == 2 && steps[0] == 10.0 && steps[1] == 11.0);
+    GV_CHECK(vm.Resume(fiber) == VMResumeResult::Error);   // finished
+    vm.RemoveRootMarker(root);
+
+    GV_CHECK(!vm.Execute("yield;"));
+    GV_CHECK(vm.GetLastError().find("yield outside a coroutine") != std::string::npos);
+}
+
+GV_TEST(StackOverflowTracebackIsElided) {
+    ScriptVM vm;
+    GV_CHECK(vm.Execute("func dive(n) { return dive(n + 1); }\nfunc ok() { return 1; }\n"));
+    GV_CHECK(!vm.CallFunction("dive"));
+    GV_CHECK(vm.GetLastFault() == VMFault::CallDepth);
+    const std::string& error = vm.GetLastError();
+    GV_CHECK(error.find("stack overflow") != std::string::npos);
+    GV_CHECK(error.find("more frames") != std::string::npos);
+    GV_CHECK(CountLines(error) == 33);                 // error + 15 frames, elision, 16 frames
+
+    GV_CHECK(vm.CallFunction("ok"));
+    GV_CHECK(vm.GetLastError().empty());
+    GV_CHECK(vm.GetLastFault() == VMFault::None);
+}
+
+GV_TEST(CallsDoNotAllocate) {
+    ScriptVM vm;
+    vm.RegisterNative("clamp01", [](ScriptVM&, ScriptArgs a) -> VMValue {
+        const f64 x = a.Number(0);
+        return VMValue::Number(x < 0.0 ? 0.0 : x > 1.0 ? 1.0 : x);
+    });
+    GV_CHECK(vm.Execute(
+        "var scale = 0.5;\n"
+        "var label = \"steady\";\n"
+        "func ease(t) { return t * t * (3 - 2 * t); }\n"
+        "func step(x, dt) {\n"
+        "    var v = clamp01(x + dt * scale);\n"
+        "    if label == \"steady\" { v = ease(v); }\n"
+        "    return v;\n"
+        "}\n"));
+    VMValue args[] = { VMValue::Number(0.25), VMValue::Number(1.0 / 60.0) };
+    VMValue out;
+    vm.CallFunction("step", { args, 2 }, &out);         // warm up stacks and tables
+
+    // Numbers, bools and interned strings live in the 8-byte value itself or
+    // are already on the heap: a call allocates nothing, on either side.
+    const u64 heapBefore = vm.GetHeap().GetBytesAllocated();
+    const f64 perCall = AllocationsPerCall(1000, [&] { vm.CallFunction("step", { args, 2 }, &out); });
+    GV_CHECK(perCall == 0.0);
+    GV_CHECK(vm.GetHeap().GetBytesAllocated() == heapBefore);
+    GV_CHECK(out.IsNumber() && out.ToNumber() > 0.0 && out.ToNumber() < 1.0);
+
+    // The legacy ScriptValue path boxes every argument list into a vector.
+    ScriptEngine engine;
+    GV_CHECK(engine.Init());
+    engine.RegisterFunction("clamp_boxed", [](const std::vector<ScriptValue>& a) {
+        const f64 x = a[0].AsNumber();
+        return ScriptValue(x < 0.0 ? 0.0 : x > 1.0 ? 1.0 : x);
+    });
+    GV_CHECK(engine.Execute("func boxed(x) { return clamp_boxed(x); }\n"));
+    engine.GetVM().CallFunction("boxed", { args, 1 }, &out);
+    const f64 boxedPerCall = AllocationsPerCall(1000, [&] { engine.GetVM().CallFunction("boxed", { args, 1 }, &out); });
+    GV_CHECK(boxedPerCall >= 1.0);
+    engine.Shutdown();
+}
+
+GV_TEST(ValueRepresentationBenchmark) {
+    // What the old interpreter did on every native call, copy the arguments
+    // into a vector of ScriptValues, against reading the caller's 8-byte
+    // slots in place.
+    std::printf("  sizeof: VMValue %zu bytes, ScriptValue %zu bytes\n", sizeof(VMValue), sizeof(ScriptValue));
+    GV_CHECK(sizeof(VMValue) == 8 && sizeof(VMValue) < sizeof(ScriptValue));
+
+    const u32 calls = 1000000;
+    const VMValue slots[] = { VMValue::Number(1), VMValue::Number(2), VMValue::Number(3), VMValue::Bool(true) };
+    const std::vector<ScriptValue> boxed = { ScriptValue(1.0), ScriptValue(2.0), ScriptValue(3.0), ScriptValue(true) };
+    auto viewed = [](ScriptArgs a) { return a.Number(0) + a.Number(1) + a.Number(2) + (a[3].Truthy() ? 1.0 : 0.0); };
+    auto copied = [](std::vector<ScriptValue> a) { return a[0].AsNumber() + a[1].AsNumber() + a[2].AsNumber() + (a[3].AsBool() ? 1.0 : 0.0); };
+
+    f64 sumNew = 0.0, sumOld = 0.0;
+    u64 allocations = s_Allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < calls; ++i) sumNew += viewed({ slots, 4 });
+    const f64 nsNew = std::chrono::duration<f64, std::nano>(std::chrono::steady_clock::now() - start).count() / calls;
+    const u64 allocNew = s_Allocations - allocations;
+
+    allocations = s_Allocations;
+    start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < calls; ++i) sumOld += copied(boxed);
+    const f64 nsOld = std::chrono::duration<f64, std::nano>(std::chrono::steady_clock::now() - start).count() / calls;
+    const u64 allocOld = s_Allocations - allocations;
+
+    std::printf("  4 arguments per call: VMValue view %.1f ns, %.2f allocations; ScriptValue copy %.1f ns, %.2f allocations\n",
+                nsNew, f64(allocNew) / calls, nsOld, f64(allocOld) / calls);
+    GV_CHECK(sumNew == sumOld && sumNew == 7.0 * calls);
+    GV_CHECK(allocNew == 0 && allocOld >= calls);
+    GV_CHECK(nsNew < nsOld);
+}
+
+GV_TEST_MAIN()
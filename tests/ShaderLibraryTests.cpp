@@ -0,0 +1,163 @@
+// ============================================================================
+// GameVoid Engine — Shader Preprocessor Tests
+// ============================================================================
+// ShaderPreprocessor needs no GL context: every case runs on in-memory
+// sources, plus one search path on disk.
+// ============================================================================
+#include "TestHarness.h"
+#include "renderer/ShaderLibrary.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace gv;
+namespace fs = std::filesystem;
+
+namespace {
+
+size_t Count(const std::string& text, const std::string& what) {
+    size_t n = 0;
+    for (size_t at = text.find(what); at != std::string::npos; at = text.find(what, at + 1)) ++n;
+    return n;
+}
+
+/// Where a line of preprocessed output came from, following #line the way
+/// the GLSL compiler does: "#line N F" makes the next line N of file F.
+struct Origin { u32 file = 0, line = 0; };
+
+Origin Locate(const std::string& source, const std::string& marker) {
+    std::istringstream in(source);
+    std::string line;
+    Origin at;
+    while (std::getline(in, line)) {
+        if (line.rfind("#line ", 0) == 0) {
+            std::istringstream args(line.substr(6));
+            u32 next = 0, file = 0;
+            args >> next >> file;
+            at = { file, next };
+            continue;
+        }
+        if (line.find(marker) != std::string::npos) return at;
+        ++at.line;
+    }
+    return { ~0u, ~0u };
+}
+
+} // namespace
+
+GV_TEST(IncludesExpandAndPragmaOnceHolds) {
+    ShaderPreprocessor pre;
+    pre.RegisterSource("shaders/lit.frag",
+        "#version 330 core\n"
+        "#include \"lib/common.glsl\"\n"
+        "#include <lib/common.glsl>\n"
+        "#include \"lib/lights.glsl\"\n"
+        "void main() {}\n");
+    pre.RegisterSource("shaders/lib/common.glsl", "#pragma once\nconst float PI = 3.14159;\n");
+    pre.RegisterSource("shaders/lib/lights.glsl", "#include \"common.glsl\"\nuniform vec3 uLight;\n");
+    pre.RegisterSource("lib/common.glsl", "#pragma once\nconst float PI = 3.14159;\n");
+
+    PreprocessedShader out = pre.Process("shaders/lit.frag", {});
+    GV_CHECK(out.ok && out.error.empty());
+    GV_CHECK(out.source.rfind("#version 330 core\n", 0) == 0);
+    GV_CHECK(Count(out.source, "#version") == 1);
+    GV_CHECK(Count(out.source, "uniform vec3 uLight;") == 1);
+    // "..." resolves next to the includer, <...> by name: two different
+    // files, each guarded by its own #pragma once.
+    GV_CHECK(Count(out.source, "const float PI") == 2);
+    GV_CHECK(out.files.size() == 4);
+    GV_CHECK(out.files[0] == "shaders/lit.frag");
+
+    // A file on a search path overrides the registered source of that name.
+    const fs::path dir = fs::temp_directory_path() / "gv_shader_tests";
+    fs::create_directories(dir / "lib");
+    std::ofstream(dir / "lib" / "lights.glsl") << "uniform vec3 uDiskLight;\n";
+    pre.AddSearchPath(dir.generic_string());
+    out = pre.Process("shaders/lit.frag", {});
+    GV_CHECK(out.ok);
+    GV_CHECK(Count(out.source, "uDiskLight") == 1 && Count(out.source, "uLight;") == 0);
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+}
+
+GV_TEST(IncludeErrorsNameTheFileAndLine) {
+    ShaderPreprocessor pre;
+    pre.RegisterSource("a.glsl", "// a\n#include \"b.glsl\"\n");
+    pre.RegisterSource("b.glsl", "// b\n// b\n#include \"a.glsl\"\n");
+    PreprocessedShader out = pre.Process("a.glsl", {});
+    GV_CHECK(!out.ok && out.source.empty());
+    GV_CHECK(out.error.rfind("b.glsl:3: recursive include", 0) == 0);
+
+    pre.RegisterSource("self.glsl", "#include \"self.glsl\"\n");
+    GV_CHECK(pre.Process("self.glsl", {}).error.rfind("self.glsl:1: recursive include", 0) == 0);
+
+    pre.RegisterSource("missing.glsl", "\n\n#include \"nowhere.glsl\"\n");
+    out = pre.Process("missing.glsl", {});
+    GV_CHECK(out.error == "missing.glsl:3: cannot find include 'nowhere.glsl'");
+
+    pre.RegisterSource("bad.glsl", "#include nowhere.glsl\n");
+    GV_CHECK(pre.Process("bad.glsl", {}).error == "bad.glsl:1: malformed #include");
+    GV_CHECK(!pre.Process("absent.frag", {}).ok);
+}
+
+GV_TEST(LineDirectivesMapBackToTheSource) {
+    ShaderPreprocessor pre;
+    pre.RegisterSource("main.vert",
+        "// header comment\n"
+        "#version 330 core\n"
+        "in vec3 aPos;\n"
+        "#include \"skin.glsl\"\n"
+        "MAIN_LINE_5\n"
+        "#include \"skin.glsl\"\n"
+        "MAIN_LINE_7\n");
+    pre.RegisterSource("skin.glsl", "#pragma once\n\nSKIN_LINE_3\n");
+
+    PreprocessedShader out = pre.Process("main.vert", { "SKINNED", "BONES=64" });
+    GV_CHECK(out.ok);
+    // The injected defines sit between #version and the first #line, so
+    // they don't shift the numbering.
+    Origin o = Locate(out.source, "in vec3 aPos;");
+    GV_CHECK(o.file == 0 && o.line == 3);
+    o = Locate(out.source, "SKIN_LINE_3");
+    GV_CHECK(o.file == 1 && o.line == 3);
+    o = Locate(out.source, "MAIN_LINE_5");
+    GV_CHECK(o.file == 0 && o.line == 5);
+    o = Locate(out.source, "MAIN_LINE_7");                // after a skipped #pragma once include
+    GV_CHECK(o.file == 0 && o.line == 7);
+    GV_CHECK(out.files.size() == 2 && out.files[1] == "skin.glsl");
+
+    // Without #version the root starts at line 1 of file 0.
+    pre.RegisterSource("plain.glsl", "FIRST\nSECOND\n");
+    out = pre.Process("plain.glsl", {});
+    o = Locate(out.source, "SECOND");
+    GV_CHECK(o.file == 0 && o.line == 2);
+}
+
+GV_TEST(PermutationsAreCanonicalAndHashesStable) {
+    using List = std::vector<std::string>;
+    GV_CHECK(ShaderPermutation::Canonical({ " SHADOWS", "SKINNED", "", "SHADOWS ", "MAX_LIGHTS=8" }) ==
+             (List{ "MAX_LIGHTS=8", "SHADOWS", "SKINNED" }));
+    GV_CHECK(ShaderPermutation::ToString({ "A", "B=2" }) == "A;B=2");
+    GV_CHECK(ShaderPermutation::ToString({}).empty());
+
+    ShaderPreprocessor pre;
+    pre.RegisterSource("s.frag", "#version 330 core\nvoid main() {}\n");
+    PreprocessedShader a = pre.Process("s.frag", { "SKINNED", "MAX_LIGHTS = 8" });
+    PreprocessedShader b = pre.Process("s.frag", { "MAX_LIGHTS = 8", "SKINNED", "SKINNED" });
+    PreprocessedShader c = pre.Process("s.frag", { "SKINNED" });
+    GV_CHECK(a.ok && b.ok && c.ok);
+    GV_CHECK(a.source == b.source && a.hash == b.hash);
+    GV_CHECK(a.hash != c.hash);
+    GV_CHECK(a.source.rfind("#version 330 core\n#define MAX_LIGHTS 8\n#define SKINNED 1\n#line 2 0\n", 0) == 0);
+    GV_CHECK(a.hash == ShaderPreprocessor::Hash(a.source));
+
+    // FNV-1a 64: the hash keys the on-disk binary cache, so it must not
+    // change between runs or builds.
+    GV_CHECK(ShaderPreprocessor::Hash("") == 0xcbf29ce484222325ull);
+    GV_CHECK(ShaderPreprocessor::Hash("a") == 0xaf63dc4c8601ec8cull);
+    GV_CHECK(ShaderPreprocessor::Hash("foobar") == 0x85944171f73967e8ull);
+}
+
+GV_TEST_MAIN()
@@ -0,0 +1,79 @@
+// ============================================================================
+// GameVoid Engine — Minimal Test Harness
+// ============================================================================
+// Each tests/*Tests.cpp is its own executable: GV_TEST cases register
+// themselves, GV_TEST_MAIN runs them all (or those whose name contains
+// argv[1]) and returns non-zero if any check failed.
+// ============================================================================
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace gv::test {
+
+struct Case {
+    const char*           name;
+    std::function<void()> fn;
+};
+
+inline std::vector<Case>& Registry() { static std::vector<Case> cases; return cases; }
+inline int& Failures() { static int failures = 0; return failures; }
+
+struct Registrar {
+    Registrar(const char* name, std::function<void()> fn) { Registry().push_back({ name, std::move(fn) }); }
+};
+
+inline void Fail(const char* file, int line, const std::string& what) {
+    std::printf("  FAILED %s:%d: %s\n", file, line, what.c_str());
+    ++Failures();
+}
+
+inline int RunAll(int argc, char** argv) {
+    int ran = 0;
+    for (const auto& c : Registry()) {
+        if (argc > 1 && !std::strstr(c.name, argv[1])) continue;
+        int before = Failures();
+        c.fn();
+        std::printf("[%s] %s\n", Failures() == before ? " OK " : "FAIL", c.name);
+        ++ran;
+    }
+    std::printf("%d case(s), %d failed check(s)\n", ran, Failures());
+    return Failures() == 0 && ran > 0 ? 0 : 1;
+}
+
+/// Directory holding tests/data (set by CMake).
+inline std::string DataPath(const std::string& rel) {
+#ifdef GV_TEST_DATA_DIR
+    return std::string(GV_TEST_DATA_DIR) + "/" + rel;
+#else
+    return "tests/data/" + rel;
+#endif
+}
+
+} // namespace gv::test
+
+#define GV_TEST_CAT2(a, b) a##b
+#define GV_TEST_CAT(a, b) GV_TEST_CAT2(a, b)
+#define GV_TEST(name)                                                                     \
+    static void GV_TEST_CAT(GvTest_, name)();                                             \
+    static ::gv::test::Registrar GV_TEST_CAT(GvTestReg_, name)(#name, &GV_TEST_CAT(GvTest_, name)); \
+    static void GV_TEST_CAT(GvTest_, name)()
+
+#define GV_CHECK(cond)                                                                    \
+    do { if (!(cond)) ::gv::test::Fail(__FILE__, __LINE__, #cond); } while (0)
+
+#define GV_CHECK_NEAR(a, b, eps)                                                          \
+    do {                                                                                  \
+        double gvA_ = static_cast<double>(a), gvB_ = static_cast<double>(b);              \
+        if (!(std::fabs(gvA_ - gvB_) <= (eps)))                                           \
+            ::gv::test::Fail(__FILE__, __LINE__, std::string(#a " ~ " #b ": ") +          \
+                             std::to_string(gvA_) + " vs " + std::to_string(gvB_));       \
+    } while (0)
+
+#define GV_TEST_MAIN() \
+    int main(int argc, char** argv) { return ::gv::test::RunAll(argc, argv); }
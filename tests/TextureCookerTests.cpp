@@ -0,0 +1,136 @@
+// ============================================================================
+// GameVoid Engine — Texture Cooker Tests
+// ============================================================================
+// Every encoder is checked through its own CPU decoder: a smooth gradient
+// must survive compression above a PSNR floor, flat blocks to the format's
+// precision.
+// ============================================================================
+#include "TestHarness.h"
+#include "assets/TextureCooker.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+using namespace gv;
+
+namespace {
+
+/// Smooth colour ramps with a soft alpha edge — typical albedo content.
+ImageRGBA8 Gradient(u32 w, u32 h) {
+    ImageRGBA8 img(w, h);
+    for (u32 y = 0; y < h; ++y)
+        for (u32 x = 0; x < w; ++x) {
+            u8* p = img.At(x, y);
+            p[0] = static_cast<u8>(255 * x / (w - 1));
+            p[1] = static_cast<u8>(255 * y / (h - 1));
+            p[2] = static_cast<u8>(128 + 100 * std::sin(0.1 * (x + y)));
+            p[3] = static_cast<u8>(x < w / 2 ? 255 : 255 - 200 * (x - w / 2) / (w / 2));
+        }
+    return img;
+}
+
+ImageRGBA8 Crop(const ImageRGBA8& src, u32 w, u32 h) {
+    ImageRGBA8 out(w, h);
+    for (u32 y = 0; y < h; ++y) std::copy(src.At(0, y), src.At(0, y) + w * 4, out.At(0, y));
+    return out;
+}
+
+ImageRGBA8 RoundTrip(const ImageRGBA8& img, TextureFormat fmt) {
+    std::vector<u8> data = TextureCooker::Encode(img, fmt, 2);
+    ImageRGBA8 out;
+    GV_CHECK(data.size() == TextureCooker::EncodedSize(img.width, img.height, fmt));
+    GV_CHECK(TextureCooker::Decode(data.data(), data.size(), img.width, img.height, fmt, out));
+    return out;
+}
+
+} // namespace
+
+GV_TEST(BlockEncodersMeetQualityFloors) {
+    const ImageRGBA8 img = Gradient(64, 64);
+    GV_CHECK(TextureCooker::PSNR(img, RoundTrip(img, TextureFormat::BC1)) > 32.0);
+    GV_CHECK(TextureCooker::PSNR(img, RoundTrip(img, TextureFormat::BC3), 0xF) > 32.0);
+    GV_CHECK(TextureCooker::PSNR(img, RoundTrip(img, TextureFormat::BC7), 0xF) > 38.0);
+    GV_CHECK(TextureCooker::PSNR(img, RoundTrip(img, TextureFormat::BC4), 0x1) > 40.0);
+    GV_CHECK(TextureCooker::PSNR(img, RoundTrip(img, TextureFormat::BC5), 0x3) > 40.0);
+    GV_CHECK(std::isinf(TextureCooker::PSNR(img, RoundTrip(img, TextureFormat::RGBA8), 0xF)));
+}
+
+GV_TEST(FlatBlocksKeepTheirColour) {
+    // Mode 6 shares one p-bit across an endpoint's channels, so a flat
+    // colour is exact when its channels agree in parity, else off by one.
+    auto flat = [](u8 r, u8 g, u8 b, u8 a, int tolerance) {
+        u8 block[64], bc7[16], back[64];
+        for (int i = 0; i < 16; ++i) { block[i * 4] = r; block[i * 4 + 1] = g; block[i * 4 + 2] = b; block[i * 4 + 3] = a; }
+        TextureCooker::EncodeBlockBC7(block, bc7);
+        if (!TextureCooker::DecodeBlockBC7(bc7, back)) return false;
+        for (int i = 0; i < 64; ++i)
+            if (std::abs(back[i] - block[i]) > tolerance) return false;
+        return true;
+    };
+    GV_CHECK(flat(200, 40, 90, 254, 0));
+    GV_CHECK(flat(201, 41, 91, 255, 0));
+    GV_CHECK(flat(200, 41, 90, 255, 1));
+
+    u8 values[16], bc4[8], decoded[16];
+    for (int i = 0; i < 16; ++i) values[i] = 77;
+    TextureCooker::EncodeBlockBC4(values, bc4);
+    TextureCooker::DecodeBlockBC4(bc4, decoded);
+    bool exact = true;
+    for (int i = 0; i < 16; ++i) exact &= decoded[i] == 77;
+    GV_CHECK(exact);
+
+    // Reserved BC7 modes are rejected.
+    const u8 reserved[16] = {};
+    u8 back[64];
+    GV_CHECK(!TextureCooker::DecodeBlockBC7(reserved, back));
+}
+
+GV_TEST(PartialEdgeBlocksAndMipChains) {
+    const ImageRGBA8 odd = Crop(Gradient(64, 64), 13, 7);
+    GV_CHECK(TextureCooker::EncodedSize(13, 7, TextureFormat::BC1) == 4 * 2 * 8);
+    GV_CHECK(TextureCooker::PSNR(odd, RoundTrip(odd, TextureFormat::BC7), 0xF) > 32.0);
+
+    TextureCookSettings settings;
+    std::vector<ImageRGBA8> chain = TextureCooker::BuildMipChain(Gradient(64, 16), settings);
+    GV_CHECK(chain.size() == 7);
+    GV_CHECK(chain.back().width == 1 && chain.back().height == 1);
+    GV_CHECK(chain[3].width == 8 && chain[3].height == 2);
+}
+
+GV_TEST(CookedContainerRoundTrips) {
+    TextureCookSettings settings;
+    settings.format = TextureFormat::BC3;
+    settings.threads = 2;
+    CookedTexture cooked;
+    GV_CHECK(TextureCooker::Cook(Gradient(32, 32), settings, cooked));
+    GV_CHECK(cooked.levels.size() == 6);
+    GV_CHECK((cooked.flags & CookedTexture::kFlagHasAlpha) && (cooked.flags & CookedTexture::kFlagSRGB));
+
+    const std::string path = (std::filesystem::temp_directory_path() / "gv_cooker_test.gvtx").string();
+    GV_CHECK(cooked.Save(path));
+    {
+        CookedTextureView view;
+        GV_CHECK(view.Open(path));
+        GV_CHECK(view.GetFormat() == TextureFormat::BC3 && view.GetWidth() == 32 && view.GetLevelCount() == 6);
+        bool same = view.GetLevelCount() == cooked.levels.size();
+        for (u32 i = 0; same && i < view.GetLevelCount(); ++i) {
+            const auto& level = view.GetLevel(i);
+            same = level.size == cooked.levels[i].data.size() &&
+                   std::equal(level.data, level.data + level.size, cooked.levels[i].data.begin()) &&
+                   reinterpret_cast<uintptr_t>(level.data) % 16 == 0;
+        }
+        GV_CHECK(same);
+    }
+    std::remove(path.c_str());
+
+    const u8 junk[64] = { 'n', 'o', 't' };
+    CookedTextureView bad;
+    GV_CHECK(!bad.Parse(junk, sizeof(junk)));
+    GV_CHECK(TextureCooker::PickFormat(Gradient(8, 8), false) == TextureFormat::BC3);
+    GV_CHECK(TextureCooker::LooksLikeNormalMap("rock_nrm.png"));
+}
+
+GV_TEST_MAIN()
@@ -0,0 +1,182 @@
+// ============================================================================
+// GameVoid Engine — Texture Streaming Tests
+// ============================================================================
+// Synthetic textures against RecordingTextureStreamBackend: the backend's
+// allocation total is what VRAM would hold.
+// ============================================================================
+#include "TestHarness.h"
+#include "assets/TextureStreaming.h"
+#include <algorithm>
+#include <vector>
+
+using namespace gv;
+
+namespace {
+
+TextureStreamSettings Inline(size_t budget) {
+    TextureStreamSettings s;
+    s.budgetBytes   = budget;
+    s.workerThreads = 0;                                // loads land on the next Update
+    return s;
+}
+
+/// Bytes of mip levels [first, last) of a `width`×`height` chain.
+size_t ChainBytes(u32 width, u32 height, TextureFormat fmt, u32 first, u32 last = ~0u) {
+    size_t total = 0;
+    u32 level = 0;
+    for (u32 w = width, h = height; level < last; w = std::max(1u, w / 2), h = std::max(1u, h / 2), ++level) {
+        if (level >= first) total += TextureCooker::EncodedSize(w, h, fmt);
+        if (w == 1 && h == 1) break;
+    }
+    return total;
+}
+
+/// Width of the last upload the backend saw for `handle` (what's bound).
+u32 BoundWidth(const RecordingTextureStreamBackend& gpu, u32 handle) {
+    const auto& ops = gpu.GetOps();
+    for (auto it = ops.rbegin(); it != ops.rend(); ++it)
+        if (it->handle == handle && it->type == RecordingTextureStreamBackend::Op::Upload) return it->topWidth;
+    return 0;
+}
+
+void Frames(TextureStreamer& s, u32 handle, f32 pixels, int frames) {
+    for (int i = 0; i < frames; ++i) { s.Request(handle, pixels); s.Update(); }
+}
+
+} // namespace
+
+GV_TEST(CameraPathNeverExceedsTheBudget) {
+    // A row of 1k textures and a camera flying past them, then back.
+    const size_t budget = 3u << 20;
+    RecordingTextureStreamBackend gpu;
+    TextureStreamer streamer(&gpu, Inline(budget));
+    std::vector<u32> handles;
+    std::vector<Vec3> centres;
+    for (int i = 0; i < 48; ++i) {
+        handles.push_back(streamer.RegisterSynthetic("crate", TextureFormat::BC1, 1024, 1024));
+        centres.push_back(Vec3(f32(i % 2 ? 3 : -3), 0, f32(i) * 4.0f));
+    }
+
+    bool withinBudget = true, accounted = true;
+    u64 frames = 0;
+    for (int pass = 0; pass < 2; ++pass)
+        for (int step = 0; step <= 240; ++step, ++frames) {
+            const f32 z = (pass == 0 ? f32(step) : f32(240 - step)) * 0.8f;
+            const Vec3 eye(0, 1, z);
+            for (size_t i = 0; i < handles.size(); ++i)
+                if (std::abs(centres[i].z - z) < 30.0f)
+                    streamer.Request(handles[i], TextureStreamer::ProjectedSize(centres[i], 1.0f, eye, 60.0f, 1080.0f));
+            streamer.Update();
+            const TextureStreamStats stats = streamer.GetStats();
+            withinBudget &= gpu.GetAllocatedBytes() <= budget && stats.residentBytes + stats.pendingBytes <= budget;
+            accounted &= gpu.GetAllocatedBytes() == stats.residentBytes;
+        }
+    GV_CHECK(withinBudget);
+    GV_CHECK(accounted);
+    const TextureStreamStats stats = streamer.GetStats();
+    GV_CHECK(stats.loadsApplied > 48 && stats.evictions > 0);
+
+    // Nearby textures did get their full resolution at some point.
+    bool sawFull = false;
+    for (const auto& op : gpu.GetOps()) sawFull |= op.type == RecordingTextureStreamBackend::Op::Upload && op.topWidth == 1024;
+    GV_CHECK(sawFull);
+}
+
+GV_TEST(EvictionTakesTheLeastRecentlySeenFirst) {
+    const TextureFormat fmt = TextureFormat::RGBA8;
+    const size_t full = ChainBytes(256, 256, fmt, 0);
+    const size_t tail = ChainBytes(256, 256, fmt, 2);    // 64 and below
+    RecordingTextureStreamBackend gpu;
+    TextureStreamer streamer(&gpu, Inline(2 * full + tail + 1024));
+    const u32 a = streamer.RegisterSynthetic("a", fmt, 256, 256);
+    const u32 b = streamer.RegisterSynthetic("b", fmt, 256, 256);
+    const u32 c = streamer.RegisterSynthetic("c", fmt, 256, 256);
+    GV_CHECK(streamer.GetResidentLevel(a) == 2);
+
+    Frames(streamer, a, 512.0f, 3);
+    Frames(streamer, b, 512.0f, 3);
+    GV_CHECK(streamer.GetResidentLevel(a) == 0 && streamer.GetResidentLevel(b) == 0);
+
+    // C needs room: A was seen longest ago, so A gives its mips back.
+    Frames(streamer, c, 512.0f, 3);
+    GV_CHECK(streamer.GetResidentLevel(c) == 0);
+    GV_CHECK(streamer.GetResidentLevel(a) == 2);
+    GV_CHECK(streamer.GetResidentLevel(b) == 0);
+    GV_CHECK(streamer.GetStats().evictions == 1);
+
+    // Two requests competing for one slot: the larger on screen wins.
+    const u32 d = streamer.RegisterSynthetic("d", fmt, 256, 256);
+    streamer.SetBudget(full + 4 * tail + 1024);
+    for (int i = 0; i < 3; ++i) {
+        streamer.Request(a, 300.0f);
+        streamer.Request(d, 600.0f);
+        streamer.Update();
+    }
+    GV_CHECK(streamer.GetResidentLevel(d) == 0);
+    GV_CHECK(streamer.GetResidentLevel(a) > 0);
+    GV_CHECK(streamer.GetStats().deferred > 0);
+    GV_CHECK(gpu.GetAllocatedBytes() <= full + 4 * tail + 1024);
+}
+
+GV_TEST(TheTailIsBoundWhileLoadsArePending) {
+    RecordingTextureStreamBackend gpu;
+    TextureStreamer streamer(&gpu, Inline(64u << 20));
+    const u32 tex = streamer.RegisterSynthetic("rock", TextureFormat::BC7, 2048, 1024);
+    GV_CHECK(tex != 0 && streamer.GetLevelCount(tex) == 12);
+    GV_CHECK(BoundWidth(gpu, tex) == 64);               // tailSize: 64×32 and below
+
+    streamer.Request(tex, 2048.0f);
+    streamer.Update();
+    GV_CHECK(streamer.IsLoading(tex));
+    GV_CHECK(streamer.GetWantedLevel(tex) == 0);
+    GV_CHECK(streamer.GetResidentLevel(tex) == 5);
+    GV_CHECK(BoundWidth(gpu, tex) == 64);               // still sampling the fallback
+    GV_CHECK(streamer.GetStats().pendingBytes == ChainBytes(2048, 1024, TextureFormat::BC7, 0, 5));
+
+    streamer.Request(tex, 2048.0f);
+    streamer.Update();
+    GV_CHECK(!streamer.IsLoading(tex));
+    GV_CHECK(streamer.GetResidentLevel(tex) == 0 && BoundWidth(gpu, tex) == 2048);
+
+    // Out of view it keeps its mips until the budget needs them.
+    streamer.Update();
+    GV_CHECK(streamer.GetResidentLevel(tex) == 0 && streamer.GetWantedLevel(tex) == 5);
+    streamer.SetBudget(0);
+    streamer.Update();
+    GV_CHECK(streamer.GetResidentLevel(tex) == 5 && BoundWidth(gpu, tex) == 64);
+}
+
+GV_TEST(ClearWaitsForWorkerLoads) {
+    RecordingTextureStreamBackend gpu;
+    TextureStreamSettings settings = Inline(256u << 20);
+    settings.workerThreads = 2;
+    TextureStreamer streamer(&gpu, settings);
+    std::vector<u32> handles;
+    for (int i = 0; i < 64; ++i) handles.push_back(streamer.RegisterSynthetic("t", TextureFormat::BC3, 512, 512));
+    for (u32 h : handles) streamer.Request(h, 512.0f);
+    streamer.Update();
+    GV_CHECK(streamer.GetStats().loadsIssued == 64);
+
+    streamer.Clear();
+    const TextureStreamStats stats = streamer.GetStats();
+    GV_CHECK(stats.textures == 0 && stats.residentBytes == 0 && stats.pendingBytes == 0);
+    GV_CHECK(gpu.GetAllocatedBytes() == 0);
+    gpu.ClearOps();
+    streamer.Update();
+    streamer.Update();
+    GV_CHECK(gpu.GetOps().empty());
+    GV_CHECK(streamer.GetStats().loadsApplied == 0);
+}
+
+GV_TEST(DesiredLevelFollowsScreenSize) {
+    GV_CHECK(TextureStreamer::DesiredLevel(1024, 1024, 1024.0f, 0.0f, 10) == 0);
+    GV_CHECK(TextureStreamer::DesiredLevel(1024, 1024, 256.0f, 0.0f, 10) == 2);
+    GV_CHECK(TextureStreamer::DesiredLevel(1024, 1024, 256.0f, 1.0f, 10) == 3);
+    GV_CHECK(TextureStreamer::DesiredLevel(1024, 1024, 1.0f, 0.0f, 4) == 4);
+    GV_CHECK(TextureStreamer::DesiredLevel(1024, 1024, 0.0f, 0.0f, 4) == 4);
+    const f32 near = TextureStreamer::ProjectedSize(Vec3(0, 0, 10), 1.0f, Vec3(), 60.0f, 1080.0f);
+    const f32 far  = TextureStreamer::ProjectedSize(Vec3(0, 0, 20), 1.0f, Vec3(), 60.0f, 1080.0f);
+    GV_CHECK_NEAR(near, 2.0f * far, 1e-3);
+}
+
+GV_TEST_MAIN()
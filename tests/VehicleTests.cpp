@@ -0,0 +1,226 @@
+// ============================================================================
+// GameVoid Engine — RaycastVehicle / CarController3D tests
+// ============================================================================
+#include "TestHarness.h"
+#include "vehicle/VehicleAssembly.h"
+#include "vehicle/CarController3D.h"
+#include "core/Scene.h"
+
+using namespace gv;
+
+namespace {
+
+constexpr f32 kDt = 1.0f / 60.0f;
+constexpr f32 kDegToRad = 3.14159265f / 180.0f;
+
+struct CarRig {
+    Scene            scene;
+    PhysicsWorld     physics;
+    GameObject*      root = nullptr;
+    CarController3D* car  = nullptr;
+    RigidBody*       body = nullptr;
+
+    CarRig() {
+        physics.Init();
+        root = VehicleAssembler::Spawn(&scene, VehicleBlueprint::MakeSedanTemplate(), &physics);
+        car  = root ? root->GetComponent<CarController3D>() : nullptr;
+        body = root ? root->GetComponent<RigidBody>() : nullptr;
+    }
+
+    void Drive(f32 forward, f32 turn, i32 steps) {
+        for (i32 i = 0; i < steps; ++i) {
+            car->inputForward = forward;
+            car->inputTurn    = turn;
+            car->UpdateController(kDt, body, &physics, &scene);
+            physics.Step(kDt);
+        }
+    }
+
+    Vec3 Position() const { return root->GetTransform().position; }
+
+    /// Move the car onto an infinite plane `degrees` steep, rising toward
+    /// +Z (the car's forward), well above the physics world's floor.
+    void PlaceOnSlope(f32 degrees, f32 height = 20.0f) {
+        const f32 rad = degrees * kDegToRad;
+        const Vec3 normal(0.0f, std::cos(rad), -std::sin(rad));
+        car->GetVehicle().SetGroundQuery(RaycastVehicle::MakePlaneGround(Vec3(0, height, 0), normal));
+        root->GetTransform().position = Vec3(0, height, 0) + normal * 0.9f;
+        root->GetTransform().rotation = Quaternion::FromAxisAngle(Vec3::Right(), -rad);
+        body->velocity = Vec3(0, 0, 0);
+        body->angularVelocity = Vec3(0, 0, 0);
+        car->ResetVehicle();
+    }
+
+    /// Full brakes until the car stops; the distance covered, or -1 if it
+    /// is still rolling after `maxSteps`.
+    f32 BrakeToStop(i32 maxSteps = 1200) {
+        const Vec3 start = Position();
+        for (i32 i = 0; i < maxSteps; ++i) {
+            if (car->currentSpeed < 0.05f) return (Position() - start).Length();
+            // Below walking pace full back-stick would select reverse.
+            Drive(car->currentSpeed > 0.6f ? -1.0f : 0.0f, 0.0f, 1);
+        }
+        return -1.0f;
+    }
+
+    /// The shortest stop physics allows from `v0` on a slope rising
+    /// `degrees` ahead: peak tyre grip plus everything else that slows the
+    /// car (body drag, aero drag, rolling resistance), integrated over speed.
+    f32 GripLimitedStop(f32 v0, f32 degrees) const {
+        const VehicleConfig& cfg = car->GetVehicle().GetConfig();
+        const f32 rad = degrees * kDegToRad, g = 9.81f;
+        const f32 constant = g * (cfg.tire.peakFriction * std::cos(rad) + std::sin(rad)) +
+                             g * cfg.tire.rollingResistance;
+        f32 distance = 0.0f;
+        const f32 dv = v0 / 2000.0f;
+        for (f32 v = dv * 0.5f; v < v0; v += dv)
+            distance += v * dv / (constant + body->drag * v + cfg.aeroDrag * v * v / body->mass);
+        return distance;
+    }
+};
+
+} // namespace
+
+GV_TEST(SpawnedCarSettlesOnItsSuspension) {
+    CarRig rig;
+    GV_CHECK(rig.car && rig.body);
+    if (!rig.car) return;
+    rig.Drive(0.0f, 0.0f, 120);
+    i32 grounded = 0;
+    for (const auto& w : rig.car->GetVehicle().GetWheelStates()) grounded += w.grounded ? 1 : 0;
+    GV_CHECK(grounded == 4);
+    GV_CHECK_NEAR(rig.car->currentSpeed, 0.0, 0.1);
+}
+
+GV_TEST(ThrottleAcceleratesAndMaxSpeedCapsIt) {
+    CarRig rig;
+    if (!rig.car) { GV_CHECK(false); return; }
+    rig.car->maxSpeed = 10.0f;
+    rig.Drive(0.0f, 0.0f, 30);
+    rig.Drive(1.0f, 0.0f, 120);
+    GV_CHECK(rig.car->currentSpeed > 3.0f);
+    rig.Drive(1.0f, 0.0f, 900);
+    GV_CHECK(rig.car->currentSpeed < 11.0f);
+    GV_CHECK(rig.car->currentSpeed > 8.0f);
+}
+
+GV_TEST(BrakingStopsAndReverseSpeedCapsReverse) {
+    CarRig rig;
+    if (!rig.car) { GV_CHECK(false); return; }
+    rig.car->reverseSpeed = 3.0f;
+    rig.Drive(1.0f, 0.0f, 240);
+    const f32 v0 = rig.car->currentSpeed;
+    GV_CHECK(v0 > 10.0f);
+
+    // Never shorter than the tyres allow, and using most of their grip.
+    const f32 ideal = rig.GripLimitedStop(v0, 0.0f);
+    const f32 distance = rig.BrakeToStop();
+    GV_CHECK(distance >= ideal);
+    GV_CHECK(distance < ideal * 1.15f);
+
+    rig.Drive(-1.0f, 0.0f, 900);
+    GV_CHECK(rig.car->GetVehicle().GetGear() < 0);
+    GV_CHECK(rig.car->currentSpeed < -1.0f);
+    GV_CHECK(rig.car->currentSpeed > -3.6f);
+}
+
+GV_TEST(SettlesSquareOnASlope) {
+    for (f32 degrees : { -12.0f, 6.0f, 12.0f }) {
+        CarRig rig;
+        if (!rig.car) { GV_CHECK(false); return; }
+        rig.PlaceOnSlope(degrees);
+        rig.car->inputHandbrake = true;
+        rig.Drive(0.0f, 0.0f, 120);
+        i32 grounded = 0;
+        for (const auto& w : rig.car->GetVehicle().GetWheelStates()) grounded += w.grounded ? 1 : 0;
+        GV_CHECK(grounded == 4);
+        const f32 rad = degrees * kDegToRad;
+        const Vec3 up = rig.root->GetTransform().rotation.RotateVec3(Vec3::Up());
+        GV_CHECK(up.Dot(Vec3(0.0f, std::cos(rad), -std::sin(rad))) > 0.999f);
+    }
+}
+
+GV_TEST(HandbrakeHoldsOnASlope) {
+    for (f32 degrees : { -10.0f, 10.0f }) {
+        CarRig rig;
+        if (!rig.car) { GV_CHECK(false); return; }
+        rig.PlaceOnSlope(degrees);
+        rig.car->inputHandbrake = true;
+        rig.Drive(0.0f, 0.0f, 120);
+        const Vec3 parked = rig.Position();
+        rig.Drive(0.0f, 0.0f, 600);                    // ten seconds
+        GV_CHECK((rig.Position() - parked).Length() < 0.03f);
+        GV_CHECK(std::fabs(rig.car->currentSpeed) < 0.02f);
+    }
+}
+
+GV_TEST(SlopesChangeClimbingAndStopping) {
+    f32 speed[3], stop[3], ideal[3];
+    const f32 slopes[3] = { -8.0f, 0.0f, 8.0f };
+    for (int i = 0; i < 3; ++i) {
+        CarRig rig;
+        if (!rig.car) { GV_CHECK(false); return; }
+        rig.PlaceOnSlope(slopes[i]);
+        rig.Drive(0.0f, 0.0f, 60);
+        rig.Drive(1.0f, 0.0f, 240);
+        speed[i] = rig.car->currentSpeed;
+        ideal[i] = rig.GripLimitedStop(speed[i], slopes[i]);
+        stop[i]  = rig.BrakeToStop();
+    }
+    // Gravity helps downhill and holds the car back uphill.
+    GV_CHECK(speed[0] > speed[1] + 1.0f && speed[1] > speed[2] + 1.0f);
+    // Every stop is bounded by the grip the slope leaves, and uses most of it.
+    for (int i = 0; i < 3; ++i) {
+        GV_CHECK(stop[i] >= ideal[i]);
+        GV_CHECK(stop[i] < ideal[i] * 1.15f);
+    }
+    // From the same speed a downhill stop is longer than a flat one.
+    CarRig down;
+    GV_CHECK(down.GripLimitedStop(15.0f, -8.0f) > down.GripLimitedStop(15.0f, 0.0f) * 1.1f);
+}
+
+GV_TEST(SteeringTurnsTheCar) {
+    CarRig rig;
+    if (!rig.car) { GV_CHECK(false); return; }
+    rig.Drive(1.0f, 0.0f, 180);
+    f32 heading = rig.car->heading;
+    rig.Drive(0.5f, 1.0f, 120);
+    GV_CHECK(std::fabs(rig.car->heading - heading) > 10.0f);
+}
+
+GV_TEST(ChassisMassIsAppliedOnceNotEveryStep) {
+    CarRig rig;
+    if (!rig.car) { GV_CHECK(false); return; }
+    GV_CHECK_NEAR(rig.body->mass, rig.car->chassisMass, 1e-3);
+    rig.body->mass = 900.0f;
+    rig.Drive(1.0f, 0.0f, 10);
+    GV_CHECK_NEAR(rig.body->mass, 900.0, 1e-3);
+    rig.car->chassisMass = 1500.0f;
+    rig.car->ResetVehicle();
+    GV_CHECK_NEAR(rig.body->mass, 1500.0, 1e-3);
+}
+
+GV_TEST(WheelVisualsFollowAndSurviveDestroyedWheels) {
+    CarRig rig;
+    if (!rig.car) { GV_CHECK(false); return; }
+    rig.Drive(1.0f, 0.0f, 120);
+    GameObject* wheel = rig.scene.FindByName("front_left_wheel");
+    GV_CHECK(wheel != nullptr);
+    if (!wheel) return;
+    Vec3 d = wheel->GetTransform().position - rig.root->GetTransform().position;
+    GV_CHECK(d.Length() < 3.0f);
+
+    rig.scene.DestroyGameObject(wheel);
+    rig.scene.FlushDestroyQueue();
+    rig.Drive(1.0f, 0.0f, 30);            // must not touch the destroyed object
+    GV_CHECK(rig.scene.FindByName("front_left_wheel") == nullptr);
+}
+
+GV_TEST(WheelCountIsClampedToFixedScratch) {
+    VehicleConfig cfg = VehicleConfig::MakeDefaultCar();
+    while (cfg.wheels.size() < RaycastVehicle::kMaxWheels + 4) cfg.wheels.push_back(cfg.wheels[0]);
+    RaycastVehicle v(cfg);
+    GV_CHECK(v.GetConfig().wheels.size() == RaycastVehicle::kMaxWheels);
+}
+
+GV_TEST_MAIN()
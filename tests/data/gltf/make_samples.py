@@ -0,0 +1,259 @@
+#!/usr/bin/env python3
+"""Regenerate the glTF conformance samples in this directory.
+
+These are stand-ins for the Khronos glTF-Sample-Models Box, BoxTextured and
+RiggedSimple. They follow the same structure as the originals:
+
+- Box: a node `matrix`, an external .bin, and an interleaved,
+  byteStride'd buffer view.
+- Box.glb and BoxEmbedded.gltf: the same Box, stored as a GLB BIN chunk
+  and as a base64 data URI.
+- BoxTextured: TEXCOORD_0, a sampler, and an image file.
+- RiggedSimple: a two-joint skin with unsigned-short JOINTS_0,
+  inverseBindMatrices, and a rotation animation.
+
+The geometry and image are generated here rather than copied, so the
+values the tests check are easy to derive: a unit cube, and a 2x2
+checker texture.
+
+Usage: python3 make_samples.py   (writes next to this script)
+"""
+import base64
+import json
+import math
+import os
+import struct
+import zlib
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+FLOAT, USHORT = 5126, 5123
+ARRAY_BUFFER, ELEMENT_ARRAY_BUFFER = 34962, 34963
+
+# The 24-vertex unit cube: 6 faces, 4 corners each, outward normals.
+FACES = [
+    ((1, 0, 0),  (0, 1, 0), (0, 0, 1)),
+    ((-1, 0, 0), (0, 1, 0), (0, 0, -1)),
+    ((0, 1, 0),  (0, 0, 1), (1, 0, 0)),
+    ((0, -1, 0), (0, 0, 1), (-1, 0, 0)),
+    ((0, 0, 1),  (1, 0, 0), (0, 1, 0)),
+    ((0, 0, -1), (-1, 0, 0), (0, 1, 0)),
+]
+
+
+def cube():
+    pos, nrm, uv, idx = [], [], [], []
+    for n, u, v in FACES:
+        base = len(pos)
+        for su, sv in ((-1, -1), (1, -1), (1, 1), (-1, 1)):
+            pos.append(tuple(0.5 * (n[k] + su * u[k] + sv * v[k]) for k in range(3)))
+            nrm.append(n)
+            uv.append(((su + 1) / 2, (1 - sv) / 2))
+        # Wind counter-clockwise seen from outside (u x v == n).
+        idx += [base, base + 1, base + 2, base, base + 2, base + 3]
+    return pos, nrm, uv, idx
+
+
+def pack(fmt, rows):
+    return b"".join(struct.pack("<" + fmt, *r) for r in rows)
+
+
+def pad4(b, fill=b"\0"):
+    return b + fill * (-len(b) % 4)
+
+
+def bounds(rows):
+    return [min(r[k] for r in rows) for k in range(len(rows[0]))], \
+           [max(r[k] for r in rows) for k in range(len(rows[0]))]
+
+
+def box_document(textured=False):
+    """Box: indices, then normals+positions (+uvs) in one strided view."""
+    pos, nrm, uv, idx = cube()
+    indices = pad4(pack("H", [(i,) for i in idx]))
+    attrib = pack("3f", nrm) + pack("3f", pos)
+    views = [
+        {"buffer": 0, "byteOffset": 0, "byteLength": len(idx) * 2, "target": ELEMENT_ARRAY_BUFFER},
+        {"buffer": 0, "byteOffset": len(indices), "byteLength": len(attrib), "byteStride": 12,
+         "target": ARRAY_BUFFER},
+    ]
+    pmin, pmax = bounds(pos)
+    nmin, nmax = bounds(nrm)
+    accessors = [
+        {"bufferView": 0, "componentType": USHORT, "count": len(idx), "type": "SCALAR",
+         "min": [0], "max": [len(pos) - 1]},
+        {"bufferView": 1, "byteOffset": 0, "componentType": FLOAT, "count": len(nrm), "type": "VEC3",
+         "min": nmin, "max": nmax},
+        {"bufferView": 1, "byteOffset": len(nrm) * 12, "componentType": FLOAT, "count": len(pos),
+         "type": "VEC3", "min": pmin, "max": pmax},
+    ]
+    blob = indices + attrib
+    attributes = {"NORMAL": 1, "POSITION": 2}
+    material = {"name": "Red", "pbrMetallicRoughness": {"baseColorFactor": [0.8, 0.0, 0.0, 1.0],
+                                                        "metallicFactor": 0.0}}
+    doc = {}
+    if textured:
+        uvs = pack("2f", uv)
+        views.append({"buffer": 0, "byteOffset": len(blob), "byteLength": len(uvs), "byteStride": 8,
+                      "target": ARRAY_BUFFER})
+        umin, umax = bounds(uv)
+        accessors.append({"bufferView": 2, "componentType": FLOAT, "count": len(uv), "type": "VEC2",
+                          "min": umin, "max": umax})
+        blob += uvs
+        attributes["TEXCOORD_0"] = 3
+        material = {"name": "Texture", "pbrMetallicRoughness": {"baseColorTexture": {"index": 0},
+                                                                "metallicFactor": 0.0}}
+        doc["samplers"] = [{"magFilter": 9729, "minFilter": 9986, "wrapS": 10497, "wrapT": 10497}]
+        doc["textures"] = [{"sampler": 0, "source": 0}]
+        doc["images"] = [{"uri": "checker.png"}]
+
+    doc.update({
+        "asset": {"version": "2.0", "generator": "GameVoid make_samples.py"},
+        "scene": 0,
+        "scenes": [{"nodes": [0]}],
+        # Root converts Y-up content authored Z-up: -90 degrees about X.
+        "nodes": [
+            {"children": [1], "matrix": [1, 0, 0, 0, 0, 0, -1, 0, 0, 1, 0, 0, 0, 0, 0, 1]},
+            {"mesh": 0},
+        ],
+        "meshes": [{"name": "Mesh", "primitives": [{"attributes": attributes, "indices": 0,
+                                                    "mode": 4, "material": 0}]}],
+        "materials": [material],
+        "accessors": accessors,
+        "bufferViews": views,
+    })
+    return doc, blob
+
+
+def write_gltf(name, doc, blob, bin_name):
+    doc = dict(doc)
+    doc["buffers"] = [{"byteLength": len(blob), "uri": bin_name}]
+    with open(os.path.join(HERE, bin_name), "wb") as f:
+        f.write(blob)
+    with open(os.path.join(HERE, name), "w") as f:
+        json.dump(doc, f, indent=2)
+        f.write("\n")
+
+
+def write_embedded(name, doc, blob):
+    doc = dict(doc)
+    uri = "data:application/octet-stream;base64," + base64.b64encode(blob).decode()
+    doc["buffers"] = [{"byteLength": len(blob), "uri": uri}]
+    with open(os.path.join(HERE, name), "w") as f:
+        json.dump(doc, f, indent=2)
+        f.write("\n")
+
+
+def write_glb(name, doc, blob):
+    doc = dict(doc)
+    doc["buffers"] = [{"byteLength": len(blob)}]
+    js = pad4(json.dumps(doc, separators=(",", ":")).encode(), b" ")
+    bn = pad4(blob)
+    total = 12 + 8 + len(js) + 8 + len(bn)
+    with open(os.path.join(HERE, name), "wb") as f:
+        f.write(struct.pack("<4sII", b"glTF", 2, total))
+        f.write(struct.pack("<I4s", len(js), b"JSON") + js)
+        f.write(struct.pack("<I4s", len(bn), b"BIN\0") + bn)
+
+
+def write_png(name, w, h, rgba):
+    def chunk(tag, data):
+        return struct.pack(">I", len(data)) + tag + data + struct.pack(">I", zlib.crc32(tag + data))
+    raw = b"".join(b"\0" + bytes(rgba[y * w * 4:(y + 1) * w * 4]) for y in range(h))
+    png = b"\x89PNG\r\n\x1a\n" + chunk(b"IHDR", struct.pack(">IIBBBBB", w, h, 8, 6, 0, 0, 0)) \
+        + chunk(b"IDAT", zlib.compress(raw)) + chunk(b"IEND", b"")
+    with open(os.path.join(HERE, name), "wb") as f:
+        f.write(png)
+
+
+def rigged_simple():
+    """A 4-sided tube along +Y, 3 rings; joint 0 at y=0, joint 1 at y=1."""
+    rings, sides = 3, 4
+    pos, nrm, joints, weights = [], [], [], []
+    for r in range(rings):
+        y = float(r)
+        for s in range(sides):
+            a = 2 * math.pi * s / sides
+            pos.append((0.25 * math.cos(a), y, 0.25 * math.sin(a)))
+            nrm.append((math.cos(a), 0.0, math.sin(a)))
+            w1 = min(max(y - 0.5, 0.0), 1.0)          # blend across the middle ring
+            joints.append((0, 1, 0, 0))
+            weights.append((1.0 - w1, w1, 0.0, 0.0))
+    idx = []
+    for r in range(rings - 1):
+        for s in range(sides):
+            a, b = r * sides + s, r * sides + (s + 1) % sides
+            c, d = a + sides, b + sides
+            idx += [a, c, b, b, c, d]   # outward (counter-clockwise from outside)
+    ibm = [  # inverse bind: joint 0 at origin, joint 1 at (0, 1, 0)
+        (1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1),
+        (1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, -1, 0, 1),
+    ]
+    times = [(0.0,), (1.0,), (2.0,)]
+    half = math.sin(math.radians(45) / 2), math.cos(math.radians(45) / 2)
+    rots = [(0, 0, 0, 1), (0, 0, half[0], half[1]), (0, 0, 0, 1)]
+
+    parts = [
+        ("indices", pad4(pack("H", [(i,) for i in idx])), ELEMENT_ARRAY_BUFFER,
+         {"componentType": USHORT, "count": len(idx), "type": "SCALAR"}),
+        ("position", pack("3f", pos), ARRAY_BUFFER,
+         dict(zip(("min", "max"), bounds(pos)), componentType=FLOAT, count=len(pos), type="VEC3")),
+        ("normal", pack("3f", nrm), ARRAY_BUFFER,
+         {"componentType": FLOAT, "count": len(nrm), "type": "VEC3"}),
+        ("joints", pack("4H", joints), ARRAY_BUFFER,
+         {"componentType": USHORT, "count": len(joints), "type": "VEC4"}),
+        ("weights", pack("4f", weights), ARRAY_BUFFER,
+         {"componentType": FLOAT, "count": len(weights), "type": "VEC4"}),
+        ("ibm", pack("16f", ibm), None, {"componentType": FLOAT, "count": 2, "type": "MAT4"}),
+        ("times", pack("f", times), None,
+         {"componentType": FLOAT, "count": 3, "type": "SCALAR", "min": [0.0], "max": [2.0]}),
+        ("rotations", pack("4f", rots), None, {"componentType": FLOAT, "count": 3, "type": "VEC4"}),
+    ]
+    blob, views, accessors = b"", [], []
+    for i, (_, data, target, acc) in enumerate(parts):
+        view = {"buffer": 0, "byteOffset": len(blob), "byteLength": len(data)}
+        if target:
+            view["target"] = target
+        views.append(view)
+        accessors.append(dict(acc, bufferView=i))
+        blob += pad4(data)
+
+    doc = {
+        "asset": {"version": "2.0", "generator": "GameVoid make_samples.py"},
+        "scene": 0,
+        "scenes": [{"nodes": [0]}],
+        "nodes": [
+            {"name": "Rig", "children": [1, 2]},
+            {"name": "Tube", "mesh": 0, "skin": 0},
+            {"name": "Root", "children": [3]},
+            {"name": "Tip", "translation": [0, 1, 0]},
+        ],
+        "meshes": [{"name": "Tube", "primitives": [{
+            "attributes": {"POSITION": 1, "NORMAL": 2, "JOINTS_0": 3, "WEIGHTS_0": 4}, "indices": 0}]}],
+        "skins": [{"name": "Armature", "inverseBindMatrices": 5, "joints": [2, 3], "skeleton": 2}],
+        "animations": [{"name": "Bend",
+                        "samplers": [{"input": 6, "output": 7, "interpolation": "LINEAR"}],
+                        "channels": [{"sampler": 0, "target": {"node": 3, "path": "rotation"}}]}],
+        "accessors": accessors,
+        "bufferViews": views,
+    }
+    return doc, blob
+
+
+def main():
+    box, box_bin = box_document()
+    write_gltf("Box.gltf", box, box_bin, "Box0.bin")
+    write_embedded("BoxEmbedded.gltf", box, box_bin)
+    write_glb("Box.glb", box, box_bin)
+
+    textured, textured_bin = box_document(textured=True)
+    write_gltf("BoxTextured.gltf", textured, textured_bin, "BoxTextured0.bin")
+    white, blue = (255, 255, 255, 255), (40, 80, 200, 255)
+    write_png("checker.png", 2, 2, [c for px in (white, blue, blue, white) for c in px])
+
+    rig, rig_bin = rigged_simple()
+    write_gltf("RiggedSimple.gltf", rig, rig_bin, "RiggedSimple0.bin")
+
+
+if __name__ == "__main__":
+    main()